@@ -0,0 +1,139 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBucketPriorityQueue_h
+#define itkBucketPriorityQueue_h
+
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+
+#include <vector>
+#include <utility>
+
+namespace itk
+{
+/** \class BucketPriorityQueue
+ * \brief Monotone priority queue which stores its elements in buckets of
+ * priorities.
+ *
+ * The priorities are quantized to buckets of a given width, and the
+ * elements of a bucket are popped in the order in which they have been
+ * pushed. Pushing and popping an element take a constant time, instead of
+ * the logarithmic time of a binary heap, and the elements of a bucket are
+ * stored contiguously.
+ *
+ * The queue is monotone: the elements pushed after the first pop must have
+ * a priority greater than or equal to the one of the last popped element,
+ * as in Dijkstra's algorithm, the fast marching or the flooding of a
+ * watershed. An element pushed with a lower priority is put in the current
+ * bucket.
+ *
+ * With a width of 1 and integer priorities, the elements are popped in the
+ * exact order of their priorities, and in the order of insertion for equal
+ * priorities, like with a std::map of std::queue indexed by the
+ * priorities. With real priorities, elements whose priorities differ by
+ * less than the width may be popped in any order.
+ *
+ * Only a window of buckets, of the given number of buckets, is kept. The
+ * elements beyond the window are stored apart, and are moved to the
+ * buckets when the elements of the window have been popped.
+ *
+ * \ingroup ITKCommon
+ */
+template< typename TElement, typename TPriority >
+class ITK_TEMPLATE_EXPORT BucketPriorityQueue
+{
+public:
+  typedef BucketPriorityQueue Self;
+  typedef TElement            ElementType;
+  typedef TPriority           PriorityType;
+
+  /** Create a queue with buckets of the given width. */
+  BucketPriorityQueue(double bucketWidth = 1.0, SizeValueType numberOfBuckets = 4096);
+
+  /** Set/Get the width of the buckets. Must be called on an empty queue. */
+  void SetBucketWidth(double bucketWidth);
+  double GetBucketWidth() const
+  {
+    return m_BucketWidth;
+  }
+
+  /** Set/Get the number of buckets of the window. Must be called on an
+   * empty queue. */
+  void SetNumberOfBuckets(SizeValueType numberOfBuckets);
+  SizeValueType GetNumberOfBuckets() const
+  {
+    return static_cast< SizeValueType >( m_Buckets.size() );
+  }
+
+  /** Add an element with its priority. */
+  void Push(const ElementType & element, const PriorityType & priority);
+
+  /** Get the first element of the lowest bucket. The queue must not be
+   * empty. */
+  const ElementType & Front();
+
+  /** The lower priority of the bucket of the first element, that is its
+   * priority when the width is 1 and the priorities are integers. The
+   * queue must not be empty. */
+  PriorityType GetFrontPriority();
+
+  /** Remove the first element of the lowest bucket. */
+  void Pop();
+
+  bool Empty() const
+  {
+    return m_Size == 0;
+  }
+
+  SizeValueType Size() const
+  {
+    return m_Size;
+  }
+
+  /** Remove all the elements, and forget the priorities already popped. */
+  void Clear();
+
+private:
+  typedef std::vector< ElementType >                        BucketType;
+  typedef std::pair< ElementType, PriorityType >            PendingElementType;
+  typedef std::vector< PendingElementType >                 PendingContainerType;
+
+  /** Move to the first non empty bucket, moving the pending elements to
+   * the buckets if needed. */
+  void MoveToFront();
+
+  /** Move the pending elements to the buckets, with the window starting
+   * at the lowest pending priority. */
+  void Rebase();
+
+  std::vector< BucketType > m_Buckets;
+  PendingContainerType      m_Pending;
+
+  double        m_BucketWidth;
+  double        m_Origin;
+  SizeValueType m_CurrentBucket;
+  SizeValueType m_CurrentPosition;
+  SizeValueType m_Size;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkBucketPriorityQueue.hxx"
+#endif
+
+#endif
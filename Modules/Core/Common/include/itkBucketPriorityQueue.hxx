@@ -0,0 +1,219 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkBucketPriorityQueue_hxx
+#define itkBucketPriorityQueue_hxx
+
+#include "itkBucketPriorityQueue.h"
+
+namespace itk
+{
+template< typename TElement, typename TPriority >
+BucketPriorityQueue< TElement, TPriority >
+::BucketPriorityQueue(double bucketWidth, SizeValueType numberOfBuckets) :
+  m_BucketWidth(1.0),
+  m_Origin(0.0),
+  m_CurrentBucket(0),
+  m_CurrentPosition(0),
+  m_Size(0)
+{
+  this->SetBucketWidth(bucketWidth);
+  this->SetNumberOfBuckets(numberOfBuckets);
+}
+
+template< typename TElement, typename TPriority >
+void
+BucketPriorityQueue< TElement, TPriority >
+::SetBucketWidth(double bucketWidth)
+{
+  if ( !( bucketWidth > 0.0 ) )
+    {
+    itkGenericExceptionMacro(<< "The width of the buckets must be positive, not " << bucketWidth);
+    }
+  if ( !this->Empty() )
+    {
+    itkGenericExceptionMacro(<< "The width of the buckets can't be changed while the queue is not empty");
+    }
+  m_BucketWidth = bucketWidth;
+}
+
+template< typename TElement, typename TPriority >
+void
+BucketPriorityQueue< TElement, TPriority >
+::SetNumberOfBuckets(SizeValueType numberOfBuckets)
+{
+  if ( numberOfBuckets == 0 )
+    {
+    itkGenericExceptionMacro(<< "The queue needs at least one bucket");
+    }
+  if ( !this->Empty() )
+    {
+    itkGenericExceptionMacro(<< "The number of buckets can't be changed while the queue is not empty");
+    }
+  m_Buckets.resize(numberOfBuckets);
+  this->Clear();
+}
+
+template< typename TElement, typename TPriority >
+void
+BucketPriorityQueue< TElement, TPriority >
+::Push(const ElementType & element, const PriorityType & priority)
+{
+  ++m_Size;
+
+  const SizeValueType numberOfBuckets = m_Buckets.size();
+  if ( m_CurrentBucket >= numberOfBuckets )
+    {
+    // no window yet: the window will start at the lowest priority
+    m_Pending.push_back( PendingElementType(element, priority) );
+    return;
+    }
+
+  const double position = ( static_cast< double >( priority ) - m_Origin ) / m_BucketWidth;
+  if ( !( position >= static_cast< double >( m_CurrentBucket ) ) )
+    {
+    // a priority lower than the current one: pop it as soon as possible
+    m_Buckets[m_CurrentBucket].push_back(element);
+    }
+  else if ( position >= static_cast< double >( numberOfBuckets ) )
+    {
+    m_Pending.push_back( PendingElementType(element, priority) );
+    }
+  else
+    {
+    m_Buckets[static_cast< SizeValueType >( position )].push_back(element);
+    }
+}
+
+template< typename TElement, typename TPriority >
+const typename BucketPriorityQueue< TElement, TPriority >::ElementType &
+BucketPriorityQueue< TElement, TPriority >
+::Front()
+{
+  this->MoveToFront();
+  return m_Buckets[m_CurrentBucket][m_CurrentPosition];
+}
+
+template< typename TElement, typename TPriority >
+typename BucketPriorityQueue< TElement, TPriority >::PriorityType
+BucketPriorityQueue< TElement, TPriority >
+::GetFrontPriority()
+{
+  this->MoveToFront();
+  return static_cast< PriorityType >( m_Origin + static_cast< double >( m_CurrentBucket ) * m_BucketWidth );
+}
+
+template< typename TElement, typename TPriority >
+void
+BucketPriorityQueue< TElement, TPriority >
+::Pop()
+{
+  if ( this->Empty() )
+    {
+    return;
+    }
+  this->MoveToFront();
+  ++m_CurrentPosition;
+  --m_Size;
+}
+
+template< typename TElement, typename TPriority >
+void
+BucketPriorityQueue< TElement, TPriority >
+::Clear()
+{
+  for ( SizeValueType b = 0; b < m_Buckets.size(); ++b )
+    {
+    m_Buckets[b].clear();
+    }
+  m_Pending.clear();
+  m_Origin = 0.0;
+  m_CurrentBucket = m_Buckets.size();
+  m_CurrentPosition = 0;
+  m_Size = 0;
+}
+
+template< typename TElement, typename TPriority >
+void
+BucketPriorityQueue< TElement, TPriority >
+::MoveToFront()
+{
+  const SizeValueType numberOfBuckets = m_Buckets.size();
+  while ( true )
+    {
+    if ( m_CurrentBucket >= numberOfBuckets )
+      {
+      this->Rebase();
+      }
+    BucketType & bucket = m_Buckets[m_CurrentBucket];
+    if ( m_CurrentPosition < bucket.size() )
+      {
+      return;
+      }
+    // the bucket has been popped: keep its memory for the next elements
+    bucket.clear();
+    ++m_CurrentBucket;
+    m_CurrentPosition = 0;
+    }
+}
+
+template< typename TElement, typename TPriority >
+void
+BucketPriorityQueue< TElement, TPriority >
+::Rebase()
+{
+  if ( m_Pending.empty() )
+    {
+    itkGenericExceptionMacro(<< "The queue is empty");
+    }
+
+  // the window starts at the lowest priority which can be compared
+  double origin = static_cast< double >( m_Pending[0].second );
+  for ( SizeValueType i = 1; i < m_Pending.size(); ++i )
+    {
+    const double priority = static_cast< double >( m_Pending[i].second );
+    if ( priority < origin || origin != origin )
+      {
+      origin = priority;
+      }
+    }
+  m_Origin = origin;
+  m_CurrentBucket = 0;
+  m_CurrentPosition = 0;
+
+  // move the elements of the new window to the buckets, in the order in
+  // which they have been pushed, and keep the other ones pending
+  const double  numberOfBuckets = static_cast< double >( m_Buckets.size() );
+  SizeValueType kept = 0;
+  for ( SizeValueType i = 0; i < m_Pending.size(); ++i )
+    {
+    const double position = ( static_cast< double >( m_Pending[i].second ) - m_Origin ) / m_BucketWidth;
+    if ( !( position >= numberOfBuckets ) )
+      {
+      // the priorities which can't be compared go to the first bucket
+      m_Buckets[position > 0.0 ? static_cast< SizeValueType >( position ) : 0].push_back(m_Pending[i].first);
+      }
+    else
+      {
+      m_Pending[kept++] = m_Pending[i];
+      }
+    }
+  m_Pending.erase( m_Pending.begin() + kept, m_Pending.end() );
+}
+} // end namespace itk
+
+#endif
@@ -30,6 +30,8 @@
 
 #include "itkProcessObject.h"
 #include "itkImage.h"
+#include "itkImageRegionSplitterBase.h"
+#include "itkImageSourceCommon.h"
 
 namespace itk
 {
@@ -206,6 +208,13 @@ protected:
    * a ThreadedGenerateData() method and NOT a GenerateData() method. */
   virtual void AfterThreadedGenerateData() {}
 
+  /** Get the image splitter to split the input for multi-threading. The
+   * subclasses which divide their input with a splitter, like the
+   * StreamingReductionImageFilter, use this one. It is the global default
+   * splitter, unless this method is overridden.
+   * \sa ImageSource::GetImageRegionSplitter */
+  virtual const ImageRegionSplitterBase* GetImageRegionSplitter() const;
+
   /** Split the input's RequestedRegion into "num" pieces, returning
    * region "i" as "splitRegion". This method is called "num" times. The
    * regions must not overlap. The method returns the number of pieces that
@@ -194,6 +194,15 @@ ImageTransformer< TInputImage >
     }
 }
 
+//----------------------------------------------------------------------------
+template< typename TInputImage >
+const ImageRegionSplitterBase*
+ImageTransformer< TInputImage >
+::GetImageRegionSplitter() const
+{
+  return ImageSourceCommon::GetGlobalDefaultSplitter();
+}
+
 //----------------------------------------------------------------------------
 template< typename TInputImage >
 unsigned int
@@ -376,6 +376,8 @@ PriorityQueueContainer< TElementWrapper, TElementWrapperInterface,
 Push( ElementWrapperType element)
 {
   this->push_back(element);
+  // UpdateUpTree does not set the location of an element without parent
+  this->SetElementAtLocation( this->Size() - 1, element );
   this->UpdateUpTree( this->Size() - 1);
 }
 // -----------------------------------------------------------------------------
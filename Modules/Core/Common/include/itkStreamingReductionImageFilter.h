@@ -0,0 +1,182 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkStreamingReductionImageFilter_h
+#define itkStreamingReductionImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkImageRegionSplitterBase.h"
+
+namespace itk
+{
+/** \class StreamingReductionImageFilter
+ * \brief Base class for the filters which reduce their input images to a
+ * few values, and can stream their inputs.
+ *
+ * A reduction, like the statistics or the histogram of an image, is
+ * computed in three steps implemented by the subclasses:
+ * BeforeStreamedGenerateData() initializes the accumulators,
+ * ThreadedStreamedGenerateData() accumulates a region of the inputs in the
+ * accumulators of a thread, and AfterStreamedGenerateData() combines the
+ * accumulators of the threads to produce the outputs.
+ *
+ * By default, the filter requests the largest possible region of its
+ * inputs and accumulates it at once, like a filter which needs all of its
+ * input. When the number of stream divisions is greater than 1, the filter
+ * drives the upstream pipeline itself, like the StreamingImageFilter: the
+ * largest possible region of the first input is divided by the region
+ * splitter, the same piece of all the image inputs is requested, updated
+ * and accumulated, and so on for the next pieces. An ImageFileReader with
+ * an ImageIO which supports streaming then reads only one piece of the
+ * file at a time, and the memory used is bounded by the size of a piece.
+ *
+ * A reduction which needs the result of a first pass over the inputs to
+ * accumulate the second one, like a histogram with a range computed from
+ * the values of the pixels, returns the number of passes with
+ * GetNumberOfPasses(). The three steps are run for each pass.
+ *
+ * The filter can be used on top of an ImageToImageFilter, the default,
+ * or another filter which takes images as inputs, like the
+ * ImageTransformer. The outputs of the superclass are allocated with
+ * AllocateOutputs() only when the input is not streamed: when it is
+ * streamed, an image output only holds the information of the input, not
+ * its pixels.
+ *
+ * \sa StreamingImageFilter
+ * \ingroup ITKSystemObjects
+ * \ingroup DataProcessing
+ * \ingroup ITKCommon
+ */
+template< typename TInputImage,
+          typename TParentFilter = ImageToImageFilter< TInputImage, TInputImage > >
+class ITK_TEMPLATE_EXPORT StreamingReductionImageFilter:public TParentFilter
+{
+public:
+  /** Standard class typedefs. */
+  typedef StreamingReductionImageFilter Self;
+  typedef TParentFilter                 Superclass;
+  typedef SmartPointer< Self >          Pointer;
+  typedef SmartPointer< const Self >    ConstPointer;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(StreamingReductionImageFilter, TParentFilter);
+
+  /** Some typedefs for the input. */
+  typedef TInputImage                         InputImageType;
+  typedef typename InputImageType::RegionType InputImageRegionType;
+
+  /** Dimension of input image. */
+  itkStaticConstMacro(InputImageDimension, unsigned int,
+                      InputImageType::ImageDimension);
+
+  /** SmartPointer to a region splitting object */
+  typedef ImageRegionSplitterBase        SplitterType;
+  typedef typename SplitterType::Pointer RegionSplitterPointer;
+
+  /** Set the number of pieces to divide the input.  The upstream pipeline
+   * will be executed this many times for each pass. Defaults to 1: the
+   * whole input is requested at once. */
+  itkSetClampMacro(NumberOfStreamDivisions, unsigned int, 1, NumericTraits< unsigned int >::max());
+
+  /** Get the number of pieces to divide the input. */
+  itkGetConstReferenceMacro(NumberOfStreamDivisions, unsigned int);
+
+  /** Get/Set the helper class for dividing the input into pieces. */
+  itkSetObjectMacro(RegionSplitter, SplitterType);
+  itkGetModifiableObjectMacro(RegionSplitter, SplitterType);
+
+  /** Override UpdateOutputData() from ProcessObject to divide the upstream
+   * updates into pieces when the input is streamed. */
+  virtual void UpdateOutputData(DataObject *output) ITK_OVERRIDE;
+
+  /** Override PropagateRequestedRegion() from ProcessObject. When the
+   * input is streamed, the requested regions of the inputs are managed in
+   * UpdateOutputData(), piece by piece. */
+  virtual void PropagateRequestedRegion(DataObject *output) ITK_OVERRIDE;
+
+protected:
+  StreamingReductionImageFilter();
+  virtual ~StreamingReductionImageFilter() {}
+  void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
+
+  /** Request the largest possible region of all the image inputs. */
+  virtual void GenerateInputRequestedRegion() ITK_OVERRIDE;
+
+  /** The reduction covers the whole input, so it produces all of its
+   * outputs. */
+  virtual void EnlargeOutputRequestedRegion(DataObject *data) ITK_OVERRIDE;
+
+  /** Accumulate the whole requested region of the input, for each pass.
+   * Used when the input is not streamed. */
+  virtual void GenerateData() ITK_OVERRIDE;
+
+  /** The number of passes over the inputs. Defaults to 1. */
+  virtual unsigned int GetNumberOfPasses() const
+  {
+    return 1;
+  }
+
+  /** The pass being accumulated, from 0 to GetNumberOfPasses() - 1. */
+  itkGetConstMacro(CurrentPass, unsigned int);
+
+  /** Initialize the accumulators, before the first piece of a pass. */
+  virtual void BeforeStreamedGenerateData() {}
+
+  /** Accumulate the pixels of regionForThread in the accumulators of the
+   * thread threadId. Called several times per thread when the input is
+   * streamed. */
+  virtual void ThreadedStreamedGenerateData(const InputImageRegionType & regionForThread,
+                                            ThreadIdType threadId) = 0;
+
+  /** Combine the accumulators of the threads, after the last piece of a
+   * pass. */
+  virtual void AfterStreamedGenerateData() {}
+
+  /** The progress of the filter when the current piece starts, and the
+   * part of the progress covered by a piece, to be given to the
+   * ProgressReporter of ThreadedStreamedGenerateData(). */
+  float GetPieceInitialProgress() const;
+  float GetPieceProgressWeight() const;
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(StreamingReductionImageFilter);
+
+  /** Accumulate a piece of the inputs with the threads of the filter. */
+  void ThreadedStreamedGeneratePiece(const InputImageRegionType & pieceRegion);
+
+  struct PieceThreadStruct
+  {
+    Self *               Filter;
+    InputImageRegionType Region;
+  };
+
+  static ITK_THREAD_RETURN_TYPE PieceThreaderCallback(void *arg);
+
+  unsigned int          m_NumberOfStreamDivisions;
+  RegionSplitterPointer m_RegionSplitter;
+
+  unsigned int m_CurrentPass;
+  unsigned int m_CurrentPiece;
+  unsigned int m_NumberOfPieces;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkStreamingReductionImageFilter.hxx"
+#endif
+
+#endif
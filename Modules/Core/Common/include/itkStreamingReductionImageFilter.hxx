@@ -0,0 +1,337 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkStreamingReductionImageFilter_hxx
+#define itkStreamingReductionImageFilter_hxx
+#include "itkStreamingReductionImageFilter.h"
+
+#include "itkImageRegionSplitterSlowDimension.h"
+
+namespace itk
+{
+template< typename TInputImage, typename TParentFilter >
+StreamingReductionImageFilter< TInputImage, TParentFilter >
+::StreamingReductionImageFilter() :
+  m_NumberOfStreamDivisions(1),
+  m_CurrentPass(0),
+  m_CurrentPiece(0),
+  m_NumberOfPieces(1)
+{
+  // create default region splitter
+  m_RegionSplitter = ImageRegionSplitterSlowDimension::New();
+}
+
+template< typename TInputImage, typename TParentFilter >
+void
+StreamingReductionImageFilter< TInputImage, TParentFilter >
+::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  // the reduction needs the whole inputs
+  typedef ImageBase< InputImageDimension > ImageBaseType;
+  ProcessObject::DataObjectPointerArray inputs = this->GetInputs();
+  for ( unsigned int i = 0; i < inputs.size(); ++i )
+    {
+    ImageBaseType *input = dynamic_cast< ImageBaseType * >( inputs[i].GetPointer() );
+    if ( input )
+      {
+      input->SetRequestedRegionToLargestPossibleRegion();
+      }
+    }
+}
+
+template< typename TInputImage, typename TParentFilter >
+void
+StreamingReductionImageFilter< TInputImage, TParentFilter >
+::EnlargeOutputRequestedRegion(DataObject *data)
+{
+  Superclass::EnlargeOutputRequestedRegion(data);
+  data->SetRequestedRegionToLargestPossibleRegion();
+}
+
+template< typename TInputImage, typename TParentFilter >
+void
+StreamingReductionImageFilter< TInputImage, TParentFilter >
+::PropagateRequestedRegion(DataObject *output)
+{
+  if ( m_NumberOfStreamDivisions <= 1 )
+    {
+    Superclass::PropagateRequestedRegion(output);
+    return;
+    }
+
+  /**
+   * check flag to avoid executing forever if there is a loop
+   */
+  if ( this->m_Updating )
+    {
+    return;
+    }
+
+  this->EnlargeOutputRequestedRegion(output);
+  this->GenerateOutputRequestedRegion(output);
+
+  // we don't call GenerateInputRequestedRegion nor the inputs
+  // PropagateRequestedRegion since the requested regions are managed
+  // piece by piece in UpdateOutputData
+}
+
+template< typename TInputImage, typename TParentFilter >
+void
+StreamingReductionImageFilter< TInputImage, TParentFilter >
+::UpdateOutputData(DataObject *output)
+{
+  if ( m_NumberOfStreamDivisions <= 1 )
+    {
+    Superclass::UpdateOutputData(output);
+    return;
+    }
+
+  /**
+   * prevent chasing our tail
+   */
+  if ( this->m_Updating )
+    {
+    return;
+    }
+
+  /**
+   * Prepare all the outputs. This may deallocate previous bulk data.
+   */
+  this->PrepareOutputs();
+
+  /**
+   * Make sure we have the necessary inputs
+   */
+  const ProcessObject::DataObjectPointerArraySizeType ninputs = this->GetNumberOfValidRequiredInputs();
+  if ( ninputs < this->GetNumberOfRequiredInputs() )
+    {
+    itkExceptionMacro(
+      << "At least " << static_cast< unsigned int >( this->GetNumberOfRequiredInputs() )
+      << " inputs are required but only " << ninputs << " are specified.");
+    }
+
+  /**
+   * Tell all Observers that the filter is starting, before emiting
+   * the 0.0 Progress event
+   */
+  this->InvokeEvent( StartEvent() );
+
+  this->SetAbortGenerateData(0);
+  this->UpdateProgress(0.0);
+  this->m_Updating = true;
+
+  /**
+   * Determine of number of pieces to divide the input.  This will be the
+   * minimum of what the user specified via SetNumberOfStreamDivisions()
+   * and what the Splitter thinks is a reasonable value.
+   */
+  InputImageType *inputPtr = const_cast< InputImageType * >( this->GetInput() );
+  const InputImageRegionType largestRegion = inputPtr->GetLargestPossibleRegion();
+  m_NumberOfPieces = std::min( m_NumberOfStreamDivisions,
+                               m_RegionSplitter->GetNumberOfSplits(largestRegion, m_NumberOfStreamDivisions) );
+
+  typedef ImageBase< InputImageDimension > ImageBaseType;
+  ProcessObject::DataObjectPointerArray inputs = this->GetInputs();
+
+  try
+    {
+    for ( m_CurrentPass = 0; m_CurrentPass < this->GetNumberOfPasses() && !this->GetAbortGenerateData(); ++m_CurrentPass )
+      {
+      this->BeforeStreamedGenerateData();
+
+      /**
+       * Loop over the number of pieces, execute the upstream pipeline on
+       * each piece, and accumulate it.
+       */
+      for ( m_CurrentPiece = 0; m_CurrentPiece < m_NumberOfPieces && !this->GetAbortGenerateData(); ++m_CurrentPiece )
+        {
+        InputImageRegionType streamRegion = largestRegion;
+        m_RegionSplitter->GetSplit(m_CurrentPiece, m_NumberOfPieces, streamRegion);
+
+        // request the same piece of all the image inputs
+        for ( unsigned int i = 0; i < inputs.size(); ++i )
+          {
+          if ( inputs[i].IsNull() )
+            {
+            continue;
+            }
+          ImageBaseType *image = dynamic_cast< ImageBaseType * >( inputs[i].GetPointer() );
+          if ( image )
+            {
+            image->SetRequestedRegion(streamRegion);
+            }
+          inputs[i]->PropagateRequestedRegion();
+          inputs[i]->UpdateOutputData();
+          }
+
+        this->ThreadedStreamedGeneratePiece(streamRegion);
+
+        this->UpdateProgress( this->GetPieceInitialProgress() + this->GetPieceProgressWeight() );
+        }
+
+      if ( !this->GetAbortGenerateData() )
+        {
+        this->AfterStreamedGenerateData();
+        }
+      }
+    }
+  catch ( ProcessAborted & )
+    {
+    this->InvokeEvent( AbortEvent() );
+    this->ResetPipeline();
+    throw;
+    }
+  catch ( ... )
+    {
+    this->ResetPipeline();
+    throw;
+    }
+
+  /**
+   * If we ended due to aborting, push the progress up to 1.0 (since
+   * it probably didn't end there)
+   */
+  if ( this->GetAbortGenerateData() )
+    {
+    this->UpdateProgress(1.0);
+    }
+
+  // Notify end event observers
+  this->InvokeEvent( EndEvent() );
+
+  /**
+   * Now we have to mark the data as up to data.
+   */
+  ProcessObject::DataObjectPointerArray outputs = this->GetOutputs();
+  for ( unsigned int i = 0; i < outputs.size(); ++i )
+    {
+    if ( outputs[i] )
+      {
+      outputs[i]->DataHasBeenGenerated();
+      }
+    }
+
+  /**
+   * Release any inputs if marked for release
+   */
+  this->ReleaseInputs();
+
+  // Mark that we are no longer updating the data in this filter
+  this->m_Updating = false;
+}
+
+template< typename TInputImage, typename TParentFilter >
+void
+StreamingReductionImageFilter< TInputImage, TParentFilter >
+::GenerateData()
+{
+  // Call a method that can be overriden by a subclass to allocate
+  // memory for the filter's outputs
+  this->AllocateOutputs();
+
+  const InputImageRegionType requestedRegion = this->GetInput()->GetRequestedRegion();
+
+  m_NumberOfPieces = 1;
+  m_CurrentPiece = 0;
+  for ( m_CurrentPass = 0; m_CurrentPass < this->GetNumberOfPasses(); ++m_CurrentPass )
+    {
+    this->BeforeStreamedGenerateData();
+    this->ThreadedStreamedGeneratePiece(requestedRegion);
+    this->AfterStreamedGenerateData();
+    }
+}
+
+template< typename TInputImage, typename TParentFilter >
+void
+StreamingReductionImageFilter< TInputImage, TParentFilter >
+::ThreadedStreamedGeneratePiece(const InputImageRegionType & pieceRegion)
+{
+  PieceThreadStruct str;
+  str.Filter = this;
+  str.Region = pieceRegion;
+
+  this->GetMultiThreader()->SetNumberOfThreads( this->GetNumberOfThreads() );
+  this->GetMultiThreader()->SetSingleMethod(this->PieceThreaderCallback, &str);
+
+  // multithread the execution
+  this->GetMultiThreader()->SingleMethodExecute();
+}
+
+// Callback routine used by the threading library. This routine just calls
+// the ThreadedStreamedGenerateData method after setting the correct region
+// of the piece for this thread.
+template< typename TInputImage, typename TParentFilter >
+ITK_THREAD_RETURN_TYPE
+StreamingReductionImageFilter< TInputImage, TParentFilter >
+::PieceThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  PieceThreadStruct *              str = static_cast< PieceThreadStruct * >( info->UserData );
+  const ThreadIdType               threadId = info->ThreadID;
+
+  const ImageRegionSplitterBase *splitter = str->Filter->GetImageRegionSplitter();
+  InputImageRegionType           splitRegion = str->Region;
+  const unsigned int             total = splitter->GetNumberOfSplits(splitRegion, info->NumberOfThreads);
+
+  if ( threadId < total )
+    {
+    splitter->GetSplit(threadId, total, splitRegion);
+    str->Filter->ThreadedStreamedGenerateData(splitRegion, threadId);
+    }
+  // else
+  //   {
+  //   otherwise don't use this thread. Sometimes the threads dont
+  //   break up very well and it is just as efficient to leave a
+  //   few threads idle.
+  //   }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< typename TInputImage, typename TParentFilter >
+float
+StreamingReductionImageFilter< TInputImage, TParentFilter >
+::GetPieceProgressWeight() const
+{
+  return 1.0f / static_cast< float >( this->GetNumberOfPasses() * m_NumberOfPieces );
+}
+
+template< typename TInputImage, typename TParentFilter >
+float
+StreamingReductionImageFilter< TInputImage, TParentFilter >
+::GetPieceInitialProgress() const
+{
+  return static_cast< float >( m_CurrentPass * m_NumberOfPieces + m_CurrentPiece ) * this->GetPieceProgressWeight();
+}
+
+template< typename TInputImage, typename TParentFilter >
+void
+StreamingReductionImageFilter< TInputImage, TParentFilter >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Number of stream divisions: " << m_NumberOfStreamDivisions
+     << std::endl;
+
+  itkPrintSelfObjectMacro( RegionSplitter );
+}
+} // end namespace itk
+
+#endif
@@ -84,10 +84,25 @@ bool EquivalencyTable::AddAndFlatten(unsigned long a, unsigned long b)
 void EquivalencyTable::Flatten()
 {
   Iterator it = this->Begin();
+  Iterator next;
+  Iterator hashEnd = this->End();
 
-  while ( it != this->End() )
+  while ( it != hashEnd )
     {
-    ( *it ).second = this->RecursiveLookup( ( *it ).second );
+    const unsigned long ans = this->RecursiveLookup( ( *it ).second );
+
+    // Compress the path to ans, so that the other entries of the same
+    // chain are resolved with a single lookup.
+    if ( m_HashMap.find(ans) == hashEnd )
+      {
+      unsigned long a = ( *it ).second;
+      while ( a != ans && ( next = m_HashMap.find(a) ) != hashEnd )
+        {
+        a = ( *next ).second;
+        ( *next ).second = ans;
+        }
+      }
+    ( *it ).second = ans;
     it++;
     }
 }
@@ -0,0 +1,108 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkBucketPriorityQueue.h"
+#include "itkTestingMacros.h"
+#include <map>
+#include <queue>
+
+int itkBucketPriorityQueueTest( int, char * [] )
+{
+  // integer priorities: the same order as a map of queues, with the
+  // elements pushed below the current priority popped first
+  typedef itk::BucketPriorityQueue< unsigned int, short > QueueType;
+  QueueType queue( 1.0, 100 );
+  std::map< short, std::queue< unsigned int > > reference;
+
+  TEST_EXPECT_TRUE( queue.Empty() );
+  TEST_EXPECT_EQUAL( queue.GetNumberOfBuckets(), 100 );
+
+  unsigned int seed = 5;
+  unsigned int element = 0;
+  for ( ; element < 200; ++element )
+    {
+    seed = seed * 1103515245u + 12345u;
+    const short priority = static_cast< short >( ( seed >> 16 ) % 500 ) - 250;
+    queue.Push( element, priority );
+    reference[priority].push( element );
+    }
+  TEST_EXPECT_EQUAL( queue.Size(), 200 );
+
+  short current = 0;
+  while ( !queue.Empty() )
+    {
+    while ( reference.begin()->second.empty() )
+      {
+      reference.erase( reference.begin() );
+      }
+    current = reference.begin()->first;
+    TEST_EXPECT_EQUAL( queue.GetFrontPriority(), current );
+    TEST_EXPECT_EQUAL( queue.Front(), reference.begin()->second.front() );
+    queue.Pop();
+    reference.begin()->second.pop();
+
+    // push some elements while popping, some of them below the current
+    // priority and beyond the window of buckets
+    if ( element < 1000 )
+      {
+      seed = seed * 1103515245u + 12345u;
+      const short priority = static_cast< short >( current + static_cast< short >( ( seed >> 16 ) % 300 ) - 20 );
+      queue.Push( element, priority );
+      reference[std::max( priority, current )].push( element );
+      ++element;
+      }
+    }
+  TEST_EXPECT_EQUAL( queue.Size(), 0 );
+  TEST_EXPECT_EQUAL( element, 1000 );
+
+  // real priorities: the priorities are popped in buckets of the width
+  typedef itk::BucketPriorityQueue< int, double > RealQueueType;
+  RealQueueType realQueue( 0.25, 8 );
+  TEST_EXPECT_EQUAL( realQueue.GetBucketWidth(), 0.25 );
+  const double priorities[] = { 3.1, 0.5, 2.0, 0.6, 10.0, 0.55, 7.3, 0.9 };
+  for ( int i = 0; i < 8; ++i )
+    {
+    realQueue.Push( i, priorities[i] );
+    }
+  double last = -1.0;
+  while ( !realQueue.Empty() )
+    {
+    const double priority = priorities[realQueue.Front()];
+    TEST_EXPECT_TRUE( priority > last - realQueue.GetBucketWidth() );
+    TEST_EXPECT_TRUE( realQueue.GetFrontPriority() <= priority );
+    TEST_EXPECT_TRUE( priority < realQueue.GetFrontPriority() + realQueue.GetBucketWidth() );
+    last = std::max( last, priority );
+    realQueue.Pop();
+    }
+
+  // the queue can be reused after being cleared
+  realQueue.Push( 1, 5.0 );
+  realQueue.Push( 2, 4.0 );
+  realQueue.Clear();
+  TEST_EXPECT_TRUE( realQueue.Empty() );
+  realQueue.Push( 3, -2.0 );
+  TEST_EXPECT_EQUAL( realQueue.Front(), 3 );
+
+  TRY_EXPECT_EXCEPTION( realQueue.SetBucketWidth( 1.0 ) );
+  realQueue.Pop();
+  TRY_EXPECT_EXCEPTION( realQueue.SetBucketWidth( 0.0 ) );
+  TRY_EXPECT_EXCEPTION( realQueue.SetNumberOfBuckets( 0 ) );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
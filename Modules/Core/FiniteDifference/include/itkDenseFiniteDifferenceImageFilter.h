@@ -54,6 +54,20 @@ namespace itk
  * This is an image to image filter.  The specific types of the images are not
  * fixed at this level in the hierarchy.
  *
+ * \par Active tiles
+ * When UseActiveTiles is on, the requested region of the output is
+ * partitioned into tiles of TileSize pixels per dimension, and the change is
+ * only calculated and applied over the active tiles.  All the tiles are
+ * active in the first iteration.  A tile stays active in the next iteration
+ * if the maximum change of one of its pixels, or of a pixel of one of its
+ * neighbor tiles, was larger than the ActiveTileTolerance.  The update
+ * buffer of an inactive tile is set to zero, and the time step is zero
+ * when no tile is active.  With a zero tolerance, the
+ * result only differs from the one of the dense iteration if the
+ * FiniteDifferenceFunction depends on values computed over the whole image
+ * at each iteration.  The tiles are at least as large as the radius of the
+ * FiniteDifferenceFunction.
+ *
  * \par How to use this class
  * This filter is only one layer in a branch the finite difference solver
  * hierarchy.  It does not define the function used in the CalculateChange() and
@@ -101,6 +115,26 @@ public:
   /** The container type for the update buffer. */
   typedef OutputImageType UpdateBufferType;
 
+  /** Set/Get whether the change is only calculated and applied over the
+   * tiles of the output that are still changing.  Off by default. */
+  itkSetMacro(UseActiveTiles, bool);
+  itkGetConstMacro(UseActiveTiles, bool);
+  itkBooleanMacro(UseActiveTiles);
+
+  /** Set/Get the size of the tiles along each dimension.  Defaults to 16. */
+  itkSetClampMacro(TileSize, SizeValueType, 1, NumericTraits< SizeValueType >::max());
+  itkGetConstMacro(TileSize, SizeValueType);
+
+  /** Set/Get the maximum change of the pixels of a tile, and of its neighbor
+   * tiles, below which the tile is skipped in the next iteration.  Defaults
+   * to 0. */
+  itkSetMacro(ActiveTileTolerance, double);
+  itkGetConstMacro(ActiveTileTolerance, double);
+
+  /** Get the number of tiles processed in the last iteration, when
+   * UseActiveTiles is on. */
+  itkGetConstMacro(NumberOfActiveTiles, SizeValueType);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro( OutputTimesDoubleCheck,
@@ -115,8 +149,16 @@ public:
 #endif
 
 protected:
-  DenseFiniteDifferenceImageFilter()
-  { m_UpdateBuffer = UpdateBufferType::New(); }
+  DenseFiniteDifferenceImageFilter():
+    m_UseActiveTiles( false ),
+    m_TileSize( 16 ),
+    m_ActiveTileTolerance( 0.0 ),
+    m_NumberOfActiveTiles( 0 )
+  {
+    m_UpdateBuffer = UpdateBufferType::New();
+    m_TileGridSize.Fill( 0 );
+    m_EffectiveTileSize.Fill( 0 );
+  }
   ~DenseFiniteDifferenceImageFilter() {}
   void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
 
@@ -164,6 +206,13 @@ protected:
   TimeStepType ThreadedCalculateChange(const ThreadRegionType & regionToProcess,
                                        ThreadIdType threadId);
 
+  /** Partition the requested region of the output into tiles, all active.
+   * It is called from CalculateChange() before the first iteration. */
+  virtual void InitializeActiveTiles();
+
+  /** Get the region of the output covered by a tile. */
+  ThreadRegionType GetTileRegion(SizeValueType tile) const;
+
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(DenseFiniteDifferenceImageFilter);
 
@@ -184,8 +233,43 @@ private:
    * which it then passes to ThreadedCalculateChange for processing. */
   static ITK_THREAD_RETURN_TYPE CalculateChangeThreaderCallback(void *arg);
 
+  /** Calculate the change over the active tiles assigned to a thread, and
+   * return the smallest time step of these tiles. */
+  TimeStepType ThreadedCalculateChangeOnActiveTiles(ThreadIdType threadId,
+                                                    ThreadIdType threadCount,
+                                                    bool & valid);
+
+  /** Apply the update over the active tiles assigned to a thread, and
+   * record the maximum change of each tile. */
+  void ThreadedApplyUpdateOnActiveTiles(const TimeStepType & dt,
+                                        ThreadIdType threadId,
+                                        ThreadIdType threadCount);
+
+  /** Activate the tiles which changed more than the tolerance, and their
+   * neighbors, for the next iteration. */
+  void UpdateActiveTiles();
+
+  typedef typename OutputImageType::SizeType SizeType;
+
   /** The buffer that holds the updates for an iteration of the algorithm. */
   typename UpdateBufferType::Pointer m_UpdateBuffer;
+
+  bool          m_UseActiveTiles;
+  SizeValueType m_TileSize;
+  double        m_ActiveTileTolerance;
+  SizeValueType m_NumberOfActiveTiles;
+
+  /** The tiled region, the number of tiles along each dimension and the
+   * size of the tiles. */
+  ThreadRegionType m_TiledRegion;
+  SizeType         m_TileGridSize;
+  SizeType         m_EffectiveTileSize;
+
+  /** For each tile, whether it is processed in the current iteration,
+   * whether its update buffer holds values, and its maximum change. */
+  std::vector< unsigned char > m_ActiveTiles;
+  std::vector< unsigned char > m_BufferedTiles;
+  std::vector< double >        m_TileChanges;
 };
 } // end namespace itk
 
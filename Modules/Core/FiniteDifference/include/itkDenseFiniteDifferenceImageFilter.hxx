@@ -21,6 +21,7 @@
 
 #include <list>
 #include "itkImageRegionIterator.h"
+#include "itkDefaultConvertPixelTraits.h"
 #include "itkNumericTraits.h"
 #include "itkNeighborhoodAlgorithm.h"
 
@@ -96,6 +97,11 @@ DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
   // Multithread the execution
   this->GetMultiThreader()->SingleMethodExecute();
 
+  if ( m_UseActiveTiles )
+    {
+    this->UpdateActiveTiles();
+    }
+
   // Explicitely call Modified on GetOutput here
   // since ThreadedApplyUpdate changes this buffer
   // through iterators which do not increment the
@@ -114,6 +120,12 @@ DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
   DenseFDThreadStruct* str = (DenseFDThreadStruct *)
       ( ( (MultiThreader::ThreadInfoStruct *)( arg ) )->UserData );
 
+  if ( str->Filter->m_UseActiveTiles )
+    {
+    str->Filter->ThreadedApplyUpdateOnActiveTiles(str->TimeStep, threadId, threadCount);
+    return ITK_THREAD_RETURN_VALUE;
+    }
+
   // Execute the actual method with appropriate output region
   // first find out how many pieces extent can be split into.
   // Using the SplitRequestedRegion method from itk::ImageSource.
@@ -135,6 +147,12 @@ DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >::TimeStepType
 DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
 ::CalculateChange()
 {
+  if ( m_UseActiveTiles &&
+       ( this->GetElapsedIterations() == 0 || m_ActiveTiles.empty() ) )
+    {
+    this->InitializeActiveTiles();
+    }
+
   // Set up for multithreaded processing.
   DenseFDThreadStruct str;
 
@@ -159,9 +177,14 @@ DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
   // Multithread the execution
   this->GetMultiThreader()->SingleMethodExecute();
 
-  // Resolve the single value time step to return
-  TimeStepType dt = this->ResolveTimeStep( str.TimeStepList,
-                                           str.ValidTimeStepList );
+  // Resolve the single value time step to return. No thread has a valid
+  // time step when all the tiles are inactive: nothing changes then.
+  TimeStepType dt = NumericTraits< TimeStepType >::ZeroValue();
+  if ( !m_UseActiveTiles || m_NumberOfActiveTiles > 0 )
+    {
+    dt = this->ResolveTimeStep( str.TimeStepList,
+                                str.ValidTimeStepList );
+    }
 
   // Explicitely call Modified on m_UpdateBuffer here
   // since ThreadedCalculateChange changes this buffer
@@ -183,6 +206,15 @@ DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
   DenseFDThreadStruct * str = (DenseFDThreadStruct *)
       ( ( (MultiThreader::ThreadInfoStruct *)( arg ) )->UserData );
 
+  if ( str->Filter->m_UseActiveTiles )
+    {
+    bool valid = false;
+    str->TimeStepList[threadId] =
+      str->Filter->ThreadedCalculateChangeOnActiveTiles(threadId, threadCount, valid);
+    str->ValidTimeStepList[threadId] = valid;
+    return ITK_THREAD_RETURN_VALUE;
+    }
+
   // Execute the actual method with appropriate output region
   // first find out how many pieces extent can be split into.
   // Using the SplitRequestedRegion method from itk::ImageSource.
@@ -300,12 +332,219 @@ DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
   return timeStep;
 }
 
+template< typename TInputImage, typename TOutputImage >
+void
+DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
+::InitializeActiveTiles()
+{
+  // The tiles are at least as large as the radius of the function, so that
+  // a change in a tile only affects the tile and its neighbors in the next
+  // iteration.
+  const typename FiniteDifferenceFunctionType::RadiusType radius =
+    this->GetDifferenceFunction()->GetRadius();
+
+  m_TiledRegion = this->GetOutput()->GetRequestedRegion();
+
+  SizeValueType numberOfTiles = 1;
+  for ( unsigned int d = 0; d < ImageDimension; ++d )
+    {
+    m_EffectiveTileSize[d] = std::max( m_TileSize, static_cast< SizeValueType >( radius[d] ) );
+    m_TileGridSize[d] = ( m_TiledRegion.GetSize(d) + m_EffectiveTileSize[d] - 1 ) / m_EffectiveTileSize[d];
+    numberOfTiles *= m_TileGridSize[d];
+    }
+
+  m_ActiveTiles.assign( numberOfTiles, 1 );
+  m_BufferedTiles.assign( numberOfTiles, 0 );
+  m_TileChanges.assign( numberOfTiles, 0.0 );
+  m_NumberOfActiveTiles = numberOfTiles;
+}
+
+template< typename TInputImage, typename TOutputImage >
+typename
+DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >::ThreadRegionType
+DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
+::GetTileRegion(SizeValueType tile) const
+{
+  typename ThreadRegionType::IndexType index;
+  SizeType                             size;
+  for ( unsigned int d = 0; d < ImageDimension; ++d )
+    {
+    const SizeValueType position = ( tile % m_TileGridSize[d] ) * m_EffectiveTileSize[d];
+    tile /= m_TileGridSize[d];
+
+    index[d] = m_TiledRegion.GetIndex(d) + static_cast< IndexValueType >( position );
+    size[d] = std::min( m_EffectiveTileSize[d], m_TiledRegion.GetSize(d) - position );
+    }
+  return ThreadRegionType( index, size );
+}
+
+template< typename TInputImage, typename TOutputImage >
+typename
+DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >::TimeStepType
+DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
+::ThreadedCalculateChangeOnActiveTiles(ThreadIdType threadId,
+                                       ThreadIdType threadCount,
+                                       bool & valid)
+{
+  TimeStepType timeStep = NumericTraits< TimeStepType >::ZeroValue();
+  valid = false;
+
+  // The tiles are interleaved among the threads to balance the active ones.
+  const SizeValueType numberOfTiles = m_ActiveTiles.size();
+  for ( SizeValueType tile = threadId; tile < numberOfTiles; tile += threadCount )
+    {
+    if ( m_ActiveTiles[tile] )
+      {
+      const TimeStepType tileTimeStep =
+        this->ThreadedCalculateChange(this->GetTileRegion(tile), threadId);
+      if ( !valid || tileTimeStep < timeStep )
+        {
+        timeStep = tileTimeStep;
+        }
+      valid = true;
+      m_BufferedTiles[tile] = 1;
+      }
+    else if ( m_BufferedTiles[tile] )
+      {
+      // An inactive tile does not change.
+      ImageRegionIterator< UpdateBufferType > u(m_UpdateBuffer, this->GetTileRegion(tile));
+      while ( !u.IsAtEnd() )
+        {
+        u.Set( NumericTraits< PixelType >::ZeroValue() );
+        ++u;
+        }
+      m_BufferedTiles[tile] = 0;
+      }
+    }
+
+  return timeStep;
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
+::ThreadedApplyUpdateOnActiveTiles(const TimeStepType & dt,
+                                   ThreadIdType threadId,
+                                   ThreadIdType threadCount)
+{
+  typedef DefaultConvertPixelTraits< PixelType > PixelConvertType;
+
+  const double absoluteTimeStep = std::fabs( static_cast< double >( dt ) );
+
+  const SizeValueType numberOfTiles = m_ActiveTiles.size();
+  for ( SizeValueType tile = threadId; tile < numberOfTiles; tile += threadCount )
+    {
+    if ( !m_ActiveTiles[tile] )
+      {
+      continue;
+      }
+    const ThreadRegionType tileRegion = this->GetTileRegion(tile);
+
+    // The maximum change of a tile is the largest component of its update.
+    double maximumUpdate = 0.0;
+    ImageRegionConstIterator< UpdateBufferType > u(m_UpdateBuffer, tileRegion);
+    while ( !u.IsAtEnd() )
+      {
+      const PixelType    update = u.Get();
+      const unsigned int numberOfComponents = PixelConvertType::GetNumberOfComponents(update);
+      for ( unsigned int c = 0; c < numberOfComponents; ++c )
+        {
+        const double value =
+          std::fabs( static_cast< double >( PixelConvertType::GetNthComponent(c, update) ) );
+        if ( value > maximumUpdate )
+          {
+          maximumUpdate = value;
+          }
+        }
+      ++u;
+      }
+    m_TileChanges[tile] = maximumUpdate * absoluteTimeStep;
+
+    this->ThreadedApplyUpdate(dt, tileRegion, threadId);
+    }
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
+::UpdateActiveTiles()
+{
+  const SizeValueType numberOfTiles = m_ActiveTiles.size();
+
+  std::vector< unsigned char > changedTiles( numberOfTiles, 0 );
+  for ( SizeValueType tile = 0; tile < numberOfTiles; ++tile )
+    {
+    changedTiles[tile] = m_ActiveTiles[tile] && m_TileChanges[tile] > m_ActiveTileTolerance;
+    }
+
+  // Activate the changed tiles and all their neighbors.
+  SizeValueType numberOfNeighbors = 1;
+  for ( unsigned int d = 0; d < ImageDimension; ++d )
+    {
+    numberOfNeighbors *= 3;
+    }
+
+  m_ActiveTiles.assign( numberOfTiles, 0 );
+  for ( SizeValueType tile = 0; tile < numberOfTiles; ++tile )
+    {
+    if ( !changedTiles[tile] )
+      {
+      continue;
+      }
+
+    IndexValueType position[ImageDimension];
+    SizeValueType  remainder = tile;
+    for ( unsigned int d = 0; d < ImageDimension; ++d )
+      {
+      position[d] = static_cast< IndexValueType >( remainder % m_TileGridSize[d] );
+      remainder /= m_TileGridSize[d];
+      }
+
+    for ( SizeValueType neighbor = 0; neighbor < numberOfNeighbors; ++neighbor )
+      {
+      SizeValueType offsets = neighbor;
+      SizeValueType neighborTile = 0;
+      SizeValueType stride = 1;
+      bool          inside = true;
+      for ( unsigned int d = 0; d < ImageDimension; ++d )
+        {
+        const IndexValueType neighborPosition =
+          position[d] + static_cast< IndexValueType >( offsets % 3 ) - 1;
+        offsets /= 3;
+        if ( neighborPosition < 0 ||
+             neighborPosition >= static_cast< IndexValueType >( m_TileGridSize[d] ) )
+          {
+          inside = false;
+          break;
+          }
+        neighborTile += static_cast< SizeValueType >( neighborPosition ) * stride;
+        stride *= m_TileGridSize[d];
+        }
+      if ( inside )
+        {
+        m_ActiveTiles[neighborTile] = 1;
+        }
+      }
+    }
+
+  m_NumberOfActiveTiles = 0;
+  for ( SizeValueType tile = 0; tile < numberOfTiles; ++tile )
+    {
+    m_NumberOfActiveTiles += m_ActiveTiles[tile];
+    }
+}
+
 template< typename TInputImage, typename TOutputImage >
 void
 DenseFiniteDifferenceImageFilter< TInputImage, TOutputImage >
 ::PrintSelf(std::ostream & os, Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+
+  os << indent << "UseActiveTiles: " << m_UseActiveTiles << std::endl;
+  os << indent << "TileSize: " << m_TileSize << std::endl;
+  os << indent << "ActiveTileTolerance: " << m_ActiveTileTolerance << std::endl;
+  os << indent << "NumberOfActiveTiles: " << m_NumberOfActiveTiles << std::endl;
 }
 } // end namespace itk
 
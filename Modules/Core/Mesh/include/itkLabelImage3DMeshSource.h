@@ -0,0 +1,204 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLabelImage3DMeshSource_h
+#define itkLabelImage3DMeshSource_h
+
+#include "itkImageToMeshFilter.h"
+#include "itkMarchingCubesCaseTable.h"
+#include <vector>
+
+namespace itk
+{
+/** \class LabelImage3DMeshSource
+ * \brief Extract the surfaces of the labels of a 3D image with marching cubes.
+ *
+ * \par
+ * The output of index i is the surface of the i-th label of GetOutputLabels().
+ * These are the labels set with SetLabels(), or, when they are not set, all
+ * the values of the input but the BackgroundValue, in increasing order.
+ * The surfaces of all the labels are extracted by one pass over the image.
+ *
+ * \par
+ * The points of a surface are at the middle of the edges between a voxel
+ * of the label and a voxel of another value, and the triangles of a cube
+ * of voxels come from MarchingCubesCaseTable. The voxels outside of the
+ * image are not part of any label, so the surfaces are closed, and the
+ * normals of their triangles point out of the labels. Where two labels
+ * touch each other, their surfaces lie at the same positions, each one
+ * with its own points.
+ *
+ * \par
+ * The image is split in slabs of voxels along z, one per thread, and each
+ * thread reuses the points of the edges shared by the cubes of its slab
+ * through caches of the edges of two planes of voxels. The points of the
+ * planes between two slabs are then merged, and the result does not depend
+ * on the number of threads. The cells of the output meshes are set with
+ * SetCellsArrays() rather than one cell object per triangle, which lets a
+ * QuadEdgeMesh build its faces directly.
+ *
+ * \par REFERENCE
+ * W. Lorensen and H. Cline, "Marching Cubes: A High Resolution 3D Surface Construction Algorithm",
+ * Computer Graphics 21, pp. 163-169, 1987.
+ *
+ * \sa BinaryMask3DMeshSource
+ *
+ * \ingroup ITKMesh
+ */
+template< typename TInputImage, typename TOutputMesh >
+class ITK_TEMPLATE_EXPORT LabelImage3DMeshSource:public ImageToMeshFilter< TInputImage, TOutputMesh >
+{
+public:
+  /** Standard "Self" typedef. */
+  typedef LabelImage3DMeshSource                        Self;
+  typedef ImageToMeshFilter< TInputImage, TOutputMesh > Superclass;
+  typedef SmartPointer< Self >                          Pointer;
+  typedef SmartPointer< const Self >                    ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(LabelImage3DMeshSource, ImageToMeshFilter);
+
+  /** Hold on to the type information specified by the template parameters. */
+  typedef TOutputMesh                                        OutputMeshType;
+  typedef typename OutputMeshType::Pointer                   OutputMeshPointer;
+  typedef typename OutputMeshType::PointType                 OutputPointType;
+  typedef typename OutputMeshType::PointIdentifier           PointIdentifier;
+  typedef typename OutputMeshType::CellIdentifier            CellIdentifier;
+  typedef typename OutputMeshType::PointsContainer           PointsContainer;
+  typedef typename OutputMeshType::CellType                  CellType;
+  typedef typename OutputMeshType::CellTypesContainer        CellTypesContainer;
+  typedef typename OutputMeshType::CellOffsetsContainer      CellOffsetsContainer;
+  typedef typename OutputMeshType::CellConnectivityContainer CellConnectivityContainer;
+
+  /** Input Image Type Definition. */
+  typedef TInputImage                           InputImageType;
+  typedef typename InputImageType::ConstPointer InputImageConstPointer;
+  typedef typename InputImageType::PixelType    InputPixelType;
+  typedef typename InputImageType::RegionType   RegionType;
+  typedef typename InputImageType::IndexType    IndexType;
+  typedef typename InputImageType::SizeType     SizeType;
+
+  typedef std::vector< InputPixelType > LabelVectorType;
+
+  /** Set/Get the value of the voxels which are not part of a label, when
+   * the labels are not set. 0 by default. */
+  itkSetMacro(BackgroundValue, InputPixelType);
+  itkGetConstMacro(BackgroundValue, InputPixelType);
+
+  /** Set/Get the labels whose surfaces are extracted, which must be
+   * different. When empty, which is the default, the labels are all the
+   * values of the input but the background value. */
+  void SetLabels(const LabelVectorType & labels)
+  {
+    if ( labels != m_Labels )
+      {
+      m_Labels = labels;
+      this->Modified();
+      }
+  }
+  itkGetConstReferenceMacro(Labels, LabelVectorType);
+
+  /** Get the labels of the outputs of the last update. */
+  itkGetConstReferenceMacro(OutputLabels, LabelVectorType);
+
+  /** Get the surface of the label of index idx of GetOutputLabels(). */
+  using Superclass::GetOutput;
+  OutputMeshType * GetOutput(unsigned int idx);
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  // Begin concept checking
+  itkConceptMacro( ImageDimensionCheck,
+                   ( Concept::SameDimension< InputImageType::ImageDimension, 3 > ) );
+  itkConceptMacro( MeshDimensionCheck,
+                   ( Concept::SameDimension< OutputMeshType::PointDimension, 3 > ) );
+  // End concept checking
+#endif
+
+protected:
+  LabelImage3DMeshSource();
+  ~LabelImage3DMeshSource() {}
+  void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
+
+  void GenerateData() ITK_OVERRIDE;
+
+  /** The whole input is needed. */
+  void GenerateInputRequestedRegion() ITK_OVERRIDE;
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(LabelImage3DMeshSource);
+
+  typedef unsigned int LocalIdentifier;
+
+  /** The points and triangles of the cubes of a slab, the identifiers of
+   * the points being local to the slab. */
+  struct SlabSurfaces
+    {
+    std::vector< OutputPointType >                 Points;
+    std::vector< unsigned int >                    PointLabels;
+    std::vector< std::vector< LocalIdentifier > >  Triangles;
+    // the points of the edges of the first and last planes of voxels
+    std::vector< LocalIdentifier >                 FirstPlane;
+    std::vector< LocalIdentifier >                 LastPlane;
+    std::vector< InputPixelType >                  Labels;
+    };
+
+  /** Internal structure used for passing the slabs to the threads. */
+  struct ThreadStruct
+    {
+    Self *                      Filter;
+    SizeValueType               NumberOfPlanes;
+    std::vector< SlabSurfaces > Slabs;
+    };
+
+  /** Find the labels of the voxels of the slab [begin, end) along z. */
+  void FindLabels(SizeValueType begin, SizeValueType end, LabelVectorType & labels) const;
+
+  /** Extract the points and the triangles of the layers of cubes
+   * [begin, end) along z. */
+  void ExtractSlab(SizeValueType begin, SizeValueType end, SlabSurfaces & slab) const;
+
+  /** Find the indices of the labels of the voxels of the plane z, -1 being
+   * the plane before the image. */
+  void ComputePlaneLabels(OffsetValueType z, std::vector< int > & planeLabels) const;
+
+  /** Static functions used as "callbacks" by the MultiThreader. */
+  static ITK_THREAD_RETURN_TYPE FindLabelsThreaderCallback(void *arg);
+  static ITK_THREAD_RETURN_TYPE ExtractSlabThreaderCallback(void *arg);
+
+  /** Contiguous range of planes [begin, end) of a thread. */
+  static void SplitPlanes(SizeValueType numberOfPlanes, ThreadIdType threadId, ThreadIdType numberOfThreads,
+                          SizeValueType & begin, SizeValueType & end);
+
+  InputPixelType  m_BackgroundValue;
+  LabelVectorType m_Labels;
+  LabelVectorType m_OutputLabels;
+
+  /** The input and its sorted labels during an update. */
+  const InputImageType *                                   m_InputImage;
+  std::vector< std::pair< InputPixelType, unsigned int > > m_SortedLabels;
+  bool                                                     m_FlipTriangles;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkLabelImage3DMeshSource.hxx"
+#endif
+
+#endif
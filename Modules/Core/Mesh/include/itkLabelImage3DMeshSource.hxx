@@ -0,0 +1,492 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLabelImage3DMeshSource_hxx
+#define itkLabelImage3DMeshSource_hxx
+
+#include "itkLabelImage3DMeshSource.h"
+#include "itkContinuousIndex.h"
+#include "itkNumericTraits.h"
+#include "vnl/algo/vnl_determinant.h"
+#include <algorithm>
+
+namespace itk
+{
+template< typename TInputImage, typename TOutputMesh >
+LabelImage3DMeshSource< TInputImage, TOutputMesh >
+::LabelImage3DMeshSource() :
+  m_BackgroundValue(NumericTraits< InputPixelType >::ZeroValue()),
+  m_InputImage(ITK_NULLPTR),
+  m_FlipTriangles(false)
+{
+}
+
+template< typename TInputImage, typename TOutputMesh >
+typename LabelImage3DMeshSource< TInputImage, TOutputMesh >::OutputMeshType *
+LabelImage3DMeshSource< TInputImage, TOutputMesh >
+::GetOutput(unsigned int idx)
+{
+  return dynamic_cast< OutputMeshType * >( this->ProcessObject::GetOutput(idx) );
+}
+
+template< typename TInputImage, typename TOutputMesh >
+void
+LabelImage3DMeshSource< TInputImage, TOutputMesh >
+::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType *input = const_cast< InputImageType * >( this->GetInput() );
+  if ( input )
+    {
+    input->SetRequestedRegionToLargestPossibleRegion();
+    }
+}
+
+template< typename TInputImage, typename TOutputMesh >
+void
+LabelImage3DMeshSource< TInputImage, TOutputMesh >
+::SplitPlanes(SizeValueType numberOfPlanes, ThreadIdType threadId, ThreadIdType numberOfThreads,
+              SizeValueType & begin, SizeValueType & end)
+{
+  begin = numberOfPlanes * threadId / numberOfThreads;
+  end = numberOfPlanes * ( threadId + 1 ) / numberOfThreads;
+}
+
+/** Generate the data */
+template< typename TInputImage, typename TOutputMesh >
+void
+LabelImage3DMeshSource< TInputImage, TOutputMesh >
+::GenerateData()
+{
+  m_InputImage = this->GetInput();
+  const SizeType size = m_InputImage->GetBufferedRegion().GetSize();
+
+  ThreadStruct str;
+  str.Filter = this;
+
+  // the labels
+  if ( m_Labels.empty() )
+    {
+    str.NumberOfPlanes = size[2];
+    this->GetMultiThreader()->SetNumberOfThreads( std::min( this->GetNumberOfThreads(),
+                                                            static_cast< ThreadIdType >( std::max( size[2],
+                                                                                         SizeValueType(1) ) ) ) );
+    str.Slabs.resize( this->GetMultiThreader()->GetNumberOfThreads() );
+    this->GetMultiThreader()->SetSingleMethod( this->FindLabelsThreaderCallback, &str );
+    this->GetMultiThreader()->SingleMethodExecute();
+
+    m_OutputLabels.clear();
+    for ( size_t s = 0; s < str.Slabs.size(); ++s )
+      {
+      m_OutputLabels.insert( m_OutputLabels.end(), str.Slabs[s].Labels.begin(), str.Slabs[s].Labels.end() );
+      }
+    std::sort( m_OutputLabels.begin(), m_OutputLabels.end() );
+    m_OutputLabels.erase( std::unique( m_OutputLabels.begin(), m_OutputLabels.end() ), m_OutputLabels.end() );
+    m_OutputLabels.erase( std::remove( m_OutputLabels.begin(), m_OutputLabels.end(), m_BackgroundValue ),
+                          m_OutputLabels.end() );
+    }
+  else
+    {
+    m_OutputLabels = m_Labels;
+    }
+
+  const unsigned int numberOfLabels = static_cast< unsigned int >( m_OutputLabels.size() );
+  m_SortedLabels.clear();
+  for ( unsigned int i = 0; i < numberOfLabels; ++i )
+    {
+    m_SortedLabels.push_back( std::make_pair( m_OutputLabels[i], i ) );
+    }
+  std::sort( m_SortedLabels.begin(), m_SortedLabels.end() );
+  for ( unsigned int i = 1; i < numberOfLabels; ++i )
+    {
+    if ( m_SortedLabels[i].first == m_SortedLabels[i - 1].first )
+      {
+      itkExceptionMacro( "The label " << static_cast< typename NumericTraits< InputPixelType >::PrintType >(
+                           m_SortedLabels[i].first ) << " is set twice." );
+      }
+    }
+
+  // one output per label
+  this->SetNumberOfIndexedOutputs( std::max( numberOfLabels, 1u ) );
+  for ( unsigned int i = 1; i < numberOfLabels; ++i )
+    {
+    if ( !this->GetOutput(i) )
+      {
+      this->SetNthOutput( i, this->MakeOutput(i) );
+      }
+    }
+  this->GetOutput(0)->Initialize();
+  if ( numberOfLabels == 0 )
+    {
+    return;
+    }
+
+  // the orientation of the triangles in the physical space
+  m_FlipTriangles = vnl_determinant( m_InputImage->GetDirection().GetVnlMatrix() ) < 0.0;
+
+  // the slabs, of layers of cubes between two planes of voxels, the planes
+  // before and after the image being included
+  str.NumberOfPlanes = size[2] + 1;
+  this->GetMultiThreader()->SetNumberOfThreads( std::min( this->GetNumberOfThreads(),
+                                                          static_cast< ThreadIdType >( str.NumberOfPlanes ) ) );
+  str.Slabs.clear();
+  str.Slabs.resize( this->GetMultiThreader()->GetNumberOfThreads() );
+  this->GetMultiThreader()->SetSingleMethod( this->ExtractSlabThreaderCallback, &str );
+  this->GetMultiThreader()->SingleMethodExecute();
+
+  // Number the points of each label in the order of the slabs, the points
+  // of the first plane of a slab being the ones of the last plane of the
+  // previous slab.
+  const LocalIdentifier invalid = NumericTraits< LocalIdentifier >::max();
+  const PointIdentifier invalidPoint = NumericTraits< PointIdentifier >::max();
+
+  std::vector< PointIdentifier >                numberOfPoints(numberOfLabels, 0);
+  std::vector< std::vector< PointIdentifier > > pointIds( str.Slabs.size() );
+  for ( size_t s = 0; s < str.Slabs.size(); ++s )
+    {
+    const SlabSurfaces &            slab = str.Slabs[s];
+    std::vector< PointIdentifier > & ids = pointIds[s];
+    ids.assign(slab.Points.size(), invalidPoint);
+    if ( s > 0 )
+      {
+      const std::vector< LocalIdentifier > & previousPlane = str.Slabs[s - 1].LastPlane;
+      for ( size_t i = 0; i < slab.FirstPlane.size(); ++i )
+        {
+        if ( slab.FirstPlane[i] != invalid && previousPlane[i] != invalid )
+          {
+          ids[slab.FirstPlane[i]] = pointIds[s - 1][previousPlane[i]];
+          }
+        }
+      }
+    for ( size_t i = 0; i < ids.size(); ++i )
+      {
+      if ( ids[i] == invalidPoint )
+        {
+        ids[i] = numberOfPoints[slab.PointLabels[i]]++;
+        }
+      }
+    }
+
+  std::vector< typename PointsContainer::Pointer > points(numberOfLabels);
+  for ( unsigned int l = 0; l < numberOfLabels; ++l )
+    {
+    points[l] = PointsContainer::New();
+    points[l]->Reserve(numberOfPoints[l]);
+    }
+  for ( size_t s = 0; s < str.Slabs.size(); ++s )
+    {
+    const SlabSurfaces & slab = str.Slabs[s];
+    for ( size_t i = 0; i < slab.Points.size(); ++i )
+      {
+      points[slab.PointLabels[i]]->SetElement(pointIds[s][i], slab.Points[i]);
+      }
+    }
+
+  for ( unsigned int l = 0; l < numberOfLabels; ++l )
+    {
+    typename CellTypesContainer::Pointer        types = CellTypesContainer::New();
+    typename CellOffsetsContainer::Pointer      offsets = CellOffsetsContainer::New();
+    typename CellConnectivityContainer::Pointer connectivity = CellConnectivityContainer::New();
+
+    typename CellConnectivityContainer::STLContainerType & cellPoints = connectivity->CastToSTLContainer();
+    for ( size_t s = 0; s < str.Slabs.size(); ++s )
+      {
+      const std::vector< LocalIdentifier > & triangles = str.Slabs[s].Triangles[l];
+      for ( size_t i = 0; i < triangles.size(); ++i )
+        {
+        cellPoints.push_back( pointIds[s][triangles[i]] );
+        }
+      }
+    const CellIdentifier numberOfTriangles = cellPoints.size() / 3;
+    types->CastToSTLContainer().assign( numberOfTriangles, static_cast< unsigned char >( CellType::TRIANGLE_CELL ) );
+    typename CellOffsetsContainer::STLContainerType & cellOffsets = offsets->CastToSTLContainer();
+    cellOffsets.resize(numberOfTriangles + 1);
+    for ( CellIdentifier i = 0; i <= numberOfTriangles; ++i )
+      {
+      cellOffsets[i] = 3 * i;
+      }
+
+    OutputMeshType *mesh = this->GetOutput(l);
+    mesh->Initialize();
+    mesh->SetPoints(points[l]);
+    mesh->SetCellsArrays(types, offsets, connectivity);
+    }
+
+  m_InputImage = ITK_NULLPTR;
+  m_SortedLabels.clear();
+}
+
+template< typename TInputImage, typename TOutputMesh >
+void
+LabelImage3DMeshSource< TInputImage, TOutputMesh >
+::FindLabels(SizeValueType begin, SizeValueType end, LabelVectorType & labels) const
+{
+  const SizeType        size = m_InputImage->GetBufferedRegion().GetSize();
+  const SizeValueType   planeSize = size[0] * size[1];
+  const InputPixelType *it = m_InputImage->GetBufferPointer() + begin * planeSize;
+  const InputPixelType *last = m_InputImage->GetBufferPointer() + end * planeSize;
+
+  labels.clear();
+  for ( ; it != last; ++it )
+    {
+    // The labels are mostly found in runs of voxels, and the last one
+    // found is kept at the end.
+    if ( labels.empty() || *it != labels.back() )
+      {
+      typename LabelVectorType::iterator found = std::find( labels.begin(), labels.end(), *it );
+      if ( found == labels.end() )
+        {
+        labels.push_back(*it);
+        }
+      else
+        {
+        std::swap( *found, labels.back() );
+        }
+      }
+    }
+}
+
+template< typename TInputImage, typename TOutputMesh >
+ITK_THREAD_RETURN_TYPE
+LabelImage3DMeshSource< TInputImage, TOutputMesh >
+::FindLabelsThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  ThreadStruct *                   str = static_cast< ThreadStruct * >( info->UserData );
+
+  SizeValueType begin;
+  SizeValueType end;
+  SplitPlanes(str->NumberOfPlanes, info->ThreadID, info->NumberOfThreads, begin, end);
+  str->Filter->FindLabels( begin, end, str->Slabs[info->ThreadID].Labels );
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< typename TInputImage, typename TOutputMesh >
+void
+LabelImage3DMeshSource< TInputImage, TOutputMesh >
+::ComputePlaneLabels(OffsetValueType z, std::vector< int > & planeLabels) const
+{
+  const SizeType      size = m_InputImage->GetBufferedRegion().GetSize();
+  const SizeValueType width = size[0] + 2;
+
+  planeLabels.assign( width * ( size[1] + 2 ), -1 );
+  if ( z < 0 || z >= static_cast< OffsetValueType >( size[2] ) )
+    {
+    return;
+    }
+
+  const InputPixelType *it = m_InputImage->GetBufferPointer() + z * size[0] * size[1];
+  InputPixelType        lastValue = NumericTraits< InputPixelType >::ZeroValue();
+  int                   lastLabel = -1;
+  bool                  lastFound = false;
+  for ( SizeValueType y = 0; y < size[1]; ++y )
+    {
+    int *labels = &planeLabels[( y + 1 ) * width + 1];
+    for ( SizeValueType x = 0; x < size[0]; ++x, ++it )
+      {
+      if ( !lastFound || *it != lastValue )
+        {
+        typename std::vector< std::pair< InputPixelType, unsigned int > >::const_iterator found =
+          std::lower_bound( m_SortedLabels.begin(), m_SortedLabels.end(), std::make_pair(*it, 0u) );
+        lastValue = *it;
+        lastLabel = ( found != m_SortedLabels.end() && found->first == *it ) ? static_cast< int >( found->second ) : -1;
+        lastFound = true;
+        }
+      labels[x] = lastLabel;
+      }
+    }
+}
+
+template< typename TInputImage, typename TOutputMesh >
+void
+LabelImage3DMeshSource< TInputImage, TOutputMesh >
+::ExtractSlab(SizeValueType begin, SizeValueType end, SlabSurfaces & slab) const
+{
+  typedef MarchingCubesCaseTable TableType;
+
+  const SizeType        size = m_InputImage->GetBufferedRegion().GetSize();
+  const IndexType       start = m_InputImage->GetBufferedRegion().GetIndex();
+  const SizeValueType   width = size[0] + 2;
+  const SizeValueType   planeSize = width * ( size[1] + 2 );
+  const LocalIdentifier invalid = NumericTraits< LocalIdentifier >::max();
+
+  slab.Triangles.assign( m_SortedLabels.size(), std::vector< LocalIdentifier >() );
+
+  // The labels of the voxels of the planes below and above the layer of
+  // cubes, with one voxel out of the image on each side, and the points of
+  // the edges of these planes, along x then along y, and the ones of the
+  // edges between them, two per edge: the first one for the label of the
+  // voxel of lower coordinates.
+  std::vector< int >             bottomLabels;
+  std::vector< int >             topLabels;
+  std::vector< LocalIdentifier > bottomEdges(4 * planeSize, invalid);
+  std::vector< LocalIdentifier > topEdges(4 * planeSize, invalid);
+  std::vector< LocalIdentifier > zEdges(2 * planeSize, invalid);
+
+  // the layer z is between the planes z - 1 and z
+  this->ComputePlaneLabels(static_cast< OffsetValueType >( begin ) - 1, bottomLabels);
+  for ( SizeValueType z = begin; z < end; ++z )
+    {
+    this->ComputePlaneLabels(static_cast< OffsetValueType >( z ), topLabels);
+    std::fill(topEdges.begin(), topEdges.end(), invalid);
+    std::fill(zEdges.begin(), zEdges.end(), invalid);
+
+    for ( SizeValueType y = 0; y + 1 < size[1] + 2; ++y )
+      {
+      for ( SizeValueType x = 0; x + 1 < width; ++x )
+        {
+        const SizeValueType pos = y * width + x;
+
+        int corners[8];
+        corners[0] = bottomLabels[pos];
+        corners[1] = bottomLabels[pos + 1];
+        corners[2] = bottomLabels[pos + width];
+        corners[3] = bottomLabels[pos + width + 1];
+        corners[4] = topLabels[pos];
+        corners[5] = topLabels[pos + 1];
+        corners[6] = topLabels[pos + width];
+        corners[7] = topLabels[pos + width + 1];
+
+        unsigned int c = 1;
+        while ( c < 8 && corners[c] == corners[0] )
+          {
+          ++c;
+          }
+        if ( c == 8 )
+          {
+          continue;
+          }
+
+        // the surface of each label of the cube
+        for ( c = 0; c < 8; ++c )
+          {
+          const int label = corners[c];
+          if ( label < 0 || std::find(corners, corners + c, label) != corners + c )
+            {
+            continue;
+            }
+          unsigned int caseIndex = 0;
+          for ( unsigned int i = 0; i < 8; ++i )
+            {
+            if ( corners[i] == label )
+              {
+              caseIndex |= 1u << i;
+              }
+            }
+
+          std::vector< LocalIdentifier > & triangles = slab.Triangles[label];
+          for ( const signed char *edge = TableType::GetTriangles(caseIndex); *edge >= 0; edge += 3 )
+            {
+            LocalIdentifier ids[3];
+            for ( unsigned int v = 0; v < 3; ++v )
+              {
+              const unsigned int corner = TableType::GetEdgeCorner(edge[v], 0);
+              const unsigned int axis = TableType::GetEdgeAxis(edge[v]);
+              const unsigned int side = ( corners[corner] == label ) ? 0 : 1;
+              const SizeValueType cornerPos = pos + ( corner & 1 ) + ( ( corner >> 1 ) & 1 ) * width;
+
+              LocalIdentifier *id;
+              if ( axis == 2 )
+                {
+                id = &zEdges[2 * cornerPos + side];
+                }
+              else
+                {
+                std::vector< LocalIdentifier > & planeEdges = ( corner & 4 ) ? topEdges : bottomEdges;
+                id = &planeEdges[2 * ( axis * planeSize + cornerPos ) + side];
+                }
+
+              if ( *id == invalid )
+                {
+                // the middle of the edge, the voxels of the planes being
+                // shifted by one
+                ContinuousIndex< double, 3 > index;
+                index[0] = start[0] + static_cast< double >( x + ( corner & 1 ) ) - 1.0;
+                index[1] = start[1] + static_cast< double >( y + ( ( corner >> 1 ) & 1 ) ) - 1.0;
+                index[2] = start[2] + static_cast< double >( z + ( ( corner >> 2 ) & 1 ) ) - 1.0;
+                index[axis] += 0.5;
+
+                Point< double, 3 > point;
+                m_InputImage->TransformContinuousIndexToPhysicalPoint(index, point);
+                OutputPointType outputPoint;
+                for ( unsigned int d = 0; d < 3; ++d )
+                  {
+                  outputPoint[d] = static_cast< typename OutputPointType::ValueType >( point[d] );
+                  }
+
+                *id = static_cast< LocalIdentifier >( slab.Points.size() );
+                slab.Points.push_back(outputPoint);
+                slab.PointLabels.push_back(label);
+                }
+              ids[v] = *id;
+              }
+
+            if ( m_FlipTriangles )
+              {
+              std::swap(ids[1], ids[2]);
+              }
+            triangles.insert(triangles.end(), ids, ids + 3);
+            }
+          }
+        }
+      }
+
+    if ( z == begin )
+      {
+      slab.FirstPlane = bottomEdges;
+      }
+    if ( z + 1 == end )
+      {
+      slab.LastPlane = topEdges;
+      }
+    bottomLabels.swap(topLabels);
+    bottomEdges.swap(topEdges);
+    }
+}
+
+template< typename TInputImage, typename TOutputMesh >
+ITK_THREAD_RETURN_TYPE
+LabelImage3DMeshSource< TInputImage, TOutputMesh >
+::ExtractSlabThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  ThreadStruct *                   str = static_cast< ThreadStruct * >( info->UserData );
+
+  SizeValueType begin;
+  SizeValueType end;
+  SplitPlanes(str->NumberOfPlanes, info->ThreadID, info->NumberOfThreads, begin, end);
+  str->Filter->ExtractSlab( begin, end, str->Slabs[info->ThreadID] );
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< typename TInputImage, typename TOutputMesh >
+void
+LabelImage3DMeshSource< TInputImage, TOutputMesh >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "BackgroundValue: "
+     << static_cast< typename NumericTraits< InputPixelType >::PrintType >( m_BackgroundValue ) << std::endl;
+  os << indent << "Labels: " << m_Labels.size() << std::endl;
+  os << indent << "OutputLabels: " << m_OutputLabels.size() << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -0,0 +1,77 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMarchingCubesCaseTable_h
+#define itkMarchingCubesCaseTable_h
+
+#include "itkMacro.h"
+#include "ITKMeshExport.h"
+
+namespace itk
+{
+/**
+ * \class MarchingCubesCaseTable
+ * \brief Triangles of the surface crossing a cube, for each of the 256
+ * configurations of its corners.
+ *
+ * The corner \f$ x + 2y + 4z \f$ of a cube is at the offset \f$ (x, y, z) \f$
+ * of its first corner, and the bit of the same number of a case is set when
+ * the corner is inside. The edges 0 to 3 are along x, 4 to 7 along y, and
+ * 8 to 11 along z; each one goes from its corner of lower coordinates to the
+ * other one.
+ *
+ * The triangles are oriented so that their normals, in a right-handed index
+ * space, point to the outside. On a face of the cube with two opposite
+ * inside corners, the surface separates these corners, which gives the same
+ * segments to the two cubes of the face, and closed surfaces. No triangle
+ * joins two points of the same face which are not joined on that face.
+ *
+ * \ingroup ITKMesh
+ */
+class ITKMesh_EXPORT MarchingCubesCaseTable
+{
+public:
+  /** Maximum number of triangles of a case. */
+  itkStaticConstMacro(MaximumNumberOfTriangles, unsigned int, 5);
+
+  /** The edges of the points of the triangles of a case, three by three, and
+   * terminated by -1. */
+  static const signed char * GetTriangles(unsigned int caseIndex)
+  {
+    return m_Triangles[caseIndex];
+  }
+
+  /** The corner of lower coordinates of an edge if end is 0, else the other
+   * one. */
+  static unsigned int GetEdgeCorner(unsigned int edge, unsigned int end)
+  {
+    return m_EdgeCorners[edge][end];
+  }
+
+  /** The axis of an edge. */
+  static unsigned int GetEdgeAxis(unsigned int edge)
+  {
+    return edge / 4;
+  }
+
+private:
+  static const signed char   m_Triangles[256][16];
+  static const unsigned char m_EdgeCorners[12][2];
+};
+} // end namespace itk
+
+#endif
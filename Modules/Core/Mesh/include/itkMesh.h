@@ -34,6 +34,7 @@
 #include "itkBoundingBox.h"
 #include "itkCellInterface.h"
 #include "itkMapContainer.h"
+#include "itkVectorContainer.h"
 #include <vector>
 #include <set>
 
@@ -250,6 +251,49 @@ public:
   typedef std::vector< BoundaryAssignmentsContainerPointer >
   BoundaryAssignmentsContainerVector;
 
+  /** Containers of the flat storage of the cells: the type of each cell
+   * (a CellGeometry value), the position of the first point identifier of
+   * each cell in the connectivity, followed by the size of the
+   * connectivity, and the point identifiers of all the cells. */
+  typedef VectorContainer< CellIdentifier, unsigned char >   CellTypesContainer;
+  typedef VectorContainer< CellIdentifier, CellIdentifier >  CellOffsetsContainer;
+  typedef VectorContainer< CellIdentifier, PointIdentifier > CellConnectivityContainer;
+  typedef typename CellTypesContainer::Pointer               CellTypesContainerPointer;
+  typedef typename CellOffsetsContainer::Pointer             CellOffsetsContainerPointer;
+  typedef typename CellConnectivityContainer::Pointer        CellConnectivityContainerPointer;
+
+  /** \class CellView
+   *  A lightweight view of the type and the point identifiers of a cell,
+   *  which does not own them.  It remains valid as long as the cell is not
+   *  modified or removed from the mesh.
+   * \ingroup ITKMesh
+   */
+  class CellView
+  {
+public:
+    typedef typename CellType::CellGeometry CellGeometry;
+
+    CellView():
+      m_Type(CellType::VERTEX_CELL), m_NumberOfPoints(0), m_PointIds(ITK_NULLPTR) {}
+    CellView(CellGeometry type, unsigned int numberOfPoints, const PointIdentifier *pointIds):
+      m_Type(type), m_NumberOfPoints(numberOfPoints), m_PointIds(pointIds) {}
+
+    CellGeometry GetType() const { return m_Type; }
+
+    unsigned int GetNumberOfPoints() const { return m_NumberOfPoints; }
+
+    const PointIdentifier * PointIdsBegin() const { return m_PointIds; }
+
+    const PointIdentifier * PointIdsEnd() const { return m_PointIds + m_NumberOfPoints; }
+
+    PointIdentifier GetPointId(unsigned int i) const { return m_PointIds[i]; }
+
+private:
+    CellGeometry           m_Type;
+    unsigned int           m_NumberOfPoints;
+    const PointIdentifier *m_PointIds;
+  }; // End Class: Mesh::CellView
+
 protected:
 
   /** Holds cells used by the mesh.  Individual cells are accessed
@@ -278,6 +322,12 @@ protected:
    *  containers in the BoundaryData vector.  */
   BoundaryAssignmentsContainerVector m_BoundaryAssignmentsContainers;
 
+  /** The flat storage of the cells, or ITK_NULLPTR when the cells are
+   *  stored in m_CellsContainer. */
+  CellTypesContainerPointer        m_CellTypesContainer;
+  CellOffsetsContainerPointer      m_CellOffsetsContainer;
+  CellConnectivityContainerPointer m_CellConnectivityContainer;
+
 public:
   /** Mesh-level operation interface. */
   CellIdentifier GetNumberOfCells() const;
@@ -306,7 +356,11 @@ public:
   const CellLinksContainer * GetCellLinks() const;
 
   /** Access m_CellsContainer, which holds cells used by the mesh.
-   *  Individual cells are accessed through cell identifiers.  */
+   *  Individual cells are accessed through cell identifiers.  If the
+   *  cells are stored in flat arrays, GetCells() first moves them to
+   *  the cells container, as ConvertCellsArraysToCells() does; the const
+   *  version does so as well, and must then not be called by several
+   *  threads at once.  */
   void SetCells(CellsContainer *);
 
   CellsContainer * GetCells();
@@ -323,6 +377,43 @@ public:
 
   const CellDataContainer * GetCellData() const;
 
+  /** Store the cells in flat arrays instead of the cells container, as
+   *  in vtkCellArray.  The types and the offsets give the type and the
+   *  first point identifier of the cell of each identifier, from 0 to the
+   *  number of cells - 1, and the offsets end with the size of the
+   *  connectivity.  The cell objects of the cells container are released,
+   *  and the cells container is left empty.  GetCell() creates a cell
+   *  object owned by the caller, GetCellView() gives access to the point
+   *  identifiers without any allocation, and GetCells() and SetCell()
+   *  move the cells back to the cells container.  The boundary
+   *  assignments and the neighbor searches require the cells container. */
+  void SetCellsArrays(CellTypesContainer *types, CellOffsetsContainer *offsets,
+                      CellConnectivityContainer *connectivity);
+
+  /** Get the containers of the flat storage of the cells, ITK_NULLPTR if
+   *  the cells are stored in the cells container. */
+  itkGetModifiableObjectMacro(CellTypesContainer, CellTypesContainer);
+  itkGetModifiableObjectMacro(CellOffsetsContainer, CellOffsetsContainer);
+  itkGetModifiableObjectMacro(CellConnectivityContainer, CellConnectivityContainer);
+
+  /** Whether the cells are stored in flat arrays. */
+  bool HasCellsArrays() const
+  { return m_CellTypesContainer.IsNotNull(); }
+
+  /** Move the cells of the cells container to flat arrays, renumbering
+   *  them from 0 in the order of the container, and release the cell
+   *  objects. */
+  void ConvertCellsToArrays();
+
+  /** Move the cells stored in flat arrays to cell objects of the cells
+   *  container, allocated cell by cell. */
+  void ConvertCellsArraysToCells();
+
+  /** Get a view of the type and the point identifiers of a cell, with
+   *  either storage of the cells.  Returns false if the cell does not
+   *  exist. */
+  bool GetCellView(CellIdentifier, CellView &) const;
+
 #if !defined( ITK_WRAPPING_PARSER )
   /**
    * Set/get the BoundaryAssignmentsContainer for a given dimension.
@@ -445,6 +536,10 @@ protected:
       SetCellsAllocationMethod()   */
   void ReleaseCellsMemory();
 
+  /** Create a cell object of the type of a cell view, owned by the
+   *  cell pointer. */
+  void CreateCell(const CellView & view, CellAutoPointer & cellPointer) const;
+
   /** The bounding box (xmin,xmax, ymin,ymax, ...) of the mesh. The
    * bounding box is used for searching, picking, display, etc. */
   BoundingBoxPointer m_BoundingBox;
@@ -452,6 +547,10 @@ protected:
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(Mesh);
 
+  /** Move the cells stored in flat arrays to cell objects of a new cells
+   *  container, without modifying the mesh. */
+  void MoveCellsArraysToCellsContainer();
+
   CellsAllocationMethodType m_CellsAllocationMethod;
 }; // End Class: Mesh
 } // end namespace itk
@@ -30,6 +30,15 @@
 
 #include "itkMesh.h"
 #include "itkProcessObject.h"
+#include "itkVertexCell.h"
+#include "itkLineCell.h"
+#include "itkTriangleCell.h"
+#include "itkQuadrilateralCell.h"
+#include "itkPolygonCell.h"
+#include "itkTetrahedronCell.h"
+#include "itkHexahedronCell.h"
+#include "itkQuadraticEdgeCell.h"
+#include "itkQuadraticTriangleCell.h"
 #include <algorithm>
 #include <iterator>
 
@@ -45,8 +54,9 @@ Mesh< TPixelType, VDimension, TMeshTraits >
      << ( ( this->m_PointsContainer.GetPointer() ) ?  this->m_PointsContainer->Size() : 0 ) << std::endl;
   os << indent << "Number Of Cell Links: "
      << ( ( m_CellLinksContainer ) ?  m_CellLinksContainer->Size() : 0 ) << std::endl;
-  os << indent << "Number Of Cells: "
-     << ( ( m_CellsContainer ) ?  m_CellsContainer->Size() : 0 ) << std::endl;
+  os << indent << "Number Of Cells: " << this->GetNumberOfCells() << std::endl;
+  os << indent << "Cells Stored In Arrays: "
+     << ( this->HasCellsArrays() ? "true" : "false" ) << std::endl;
   os << indent << "Cell Data Container pointer: "
      << ( ( m_CellDataContainer ) ?  m_CellDataContainer.GetPointer() : ITK_NULLPTR ) << std::endl;
   os << indent << "Size of Cell Data Container: "
@@ -121,6 +131,10 @@ typename Mesh< TPixelType, VDimension, TMeshTraits >::CellsContainer *
 Mesh< TPixelType, VDimension, TMeshTraits >
 ::GetCells()
 {
+  if ( this->HasCellsArrays() )
+    {
+    this->MoveCellsArraysToCellsContainer();
+    }
   itkDebugMacro("returning Cells container of " << m_CellsContainer);
   return m_CellsContainer;
 }
@@ -130,6 +144,13 @@ const typename Mesh< TPixelType, VDimension, TMeshTraits >::CellsContainer *
 Mesh< TPixelType, VDimension, TMeshTraits >
 ::GetCells() const
 {
+  /**
+   * The cells are the same, only their storage changes.
+   */
+  if ( this->HasCellsArrays() )
+    {
+    const_cast< Self * >( this )->MoveCellsArraysToCellsContainer();
+    }
   itkDebugMacro("returning Cells container of " << m_CellsContainer);
   return m_CellsContainer;
 }
@@ -242,6 +263,14 @@ void
 Mesh< TPixelType, VDimension, TMeshTraits >
 ::SetCell(CellIdentifier cellId, CellAutoPointer & cellPointer)
 {
+  /**
+   * Move the cells stored in arrays to the cells container.
+   */
+  if ( this->HasCellsArrays() )
+    {
+    this->ConvertCellsArraysToCells();
+    }
+
   /**
    * Make sure a cells container exists.
    */
@@ -268,6 +297,21 @@ bool
 Mesh< TPixelType, VDimension, TMeshTraits >
 ::GetCell(CellIdentifier cellId, CellAutoPointer & cellPointer) const
 {
+  /**
+   * A cell stored in arrays is created for the caller.
+   */
+  if ( this->HasCellsArrays() )
+    {
+    CellView view;
+    if ( !this->GetCellView(cellId, view) )
+      {
+      cellPointer.Reset();
+      return false;
+      }
+    this->CreateCell(view, cellPointer);
+    return true;
+    }
+
   /**
    * If the cells container doesn't exist, then the cell doesn't exist.
    */
@@ -458,16 +502,15 @@ Mesh< TPixelType, VDimension, TMeshTraits >
 ::GetNumberOfCellBoundaryFeatures(int dimension, CellIdentifier cellId) const
 {
   /**
-   * Make sure the cell container exists and contains the given cell Id.
+   * Make sure the cell exists.
    */
-  if ( !m_CellsContainer ) { return 0; }
-  if ( !m_CellsContainer->IndexExists(cellId) ) { return 0; }
+  CellAutoPointer cell;
+  if ( !this->GetCell(cellId, cell) ) { return 0; }
 
   /**
    * Ask the cell for its boundary count of the given dimension.
    */
-  return m_CellsContainer->GetElement(cellId)->
-         GetNumberOfBoundaryFeatures(dimension);
+  return cell->GetNumberOfBoundaryFeatures(dimension);
 }
 
 /**
@@ -490,6 +533,10 @@ typename Mesh< TPixelType, VDimension, TMeshTraits >::CellIdentifier
 Mesh< TPixelType, VDimension, TMeshTraits >
 ::GetNumberOfCells() const
 {
+  if ( this->HasCellsArrays() )
+    {
+    return m_CellTypesContainer->Size();
+    }
   if ( !m_CellsContainer )
     {
     return 0;
@@ -517,6 +564,9 @@ Mesh< TPixelType, VDimension, TMeshTraits >
   m_CellsContainer = ITK_NULLPTR;
   m_CellDataContainer = ITK_NULLPTR;
   m_CellLinksContainer = ITK_NULLPTR;
+  m_CellTypesContainer = ITK_NULLPTR;
+  m_CellOffsetsContainer = ITK_NULLPTR;
+  m_CellConnectivityContainer = ITK_NULLPTR;
 }
 
 /**
@@ -548,10 +598,9 @@ Mesh< TPixelType, VDimension, TMeshTraits >
    * This will be a geometric copy of the actual boundary feature, not
    * a pointer to an actual cell in the mesh.
    */
-  if ( ( !m_CellsContainer.IsNull() ) && m_CellsContainer->IndexExists(cellId) )
+  CellAutoPointer thecell;
+  if ( this->GetCell(cellId, thecell) )
     {
-    // Don't take ownership
-    CellType *thecell = m_CellsContainer->GetElement(cellId);
     if ( thecell->GetBoundaryFeature(dimension, featureId, boundary) )
       {
       return true;
@@ -936,6 +985,20 @@ void
 Mesh< TPixelType, VDimension, TMeshTraits >
 ::Accept(CellMultiVisitorType *mv) const
 {
+  if ( this->HasCellsArrays() )
+    {
+    const CellIdentifier numberOfCells = this->GetNumberOfCells();
+    CellView             view;
+    CellAutoPointer      cell;
+    for ( CellIdentifier cellId = 0; cellId < numberOfCells; ++cellId )
+      {
+      this->GetCellView(cellId, view);
+      this->CreateCell(view, cell);
+      cell->Accept(cellId, mv);
+      }
+    return;
+    }
+
   if ( !this->m_CellsContainer )
     {
     return;
@@ -969,7 +1032,7 @@ Mesh< TPixelType, VDimension, TMeshTraits >
   /**
    * Make sure we have a cells and a points container.
    */
-  if ( !this->m_PointsContainer || !m_CellsContainer )
+  if ( !this->m_PointsContainer || ( !m_CellsContainer && !this->HasCellsArrays() ) )
     {
     /**
      * TODO: Throw EXCEPTION here?
@@ -989,6 +1052,22 @@ Mesh< TPixelType, VDimension, TMeshTraits >
    * Loop through each cell, and add its identifier to the CellLinks of each
    * of its points.
    */
+  if ( this->HasCellsArrays() )
+    {
+    const CellIdentifier numberOfCells = this->GetNumberOfCells();
+    CellView             view;
+    for ( CellIdentifier cellId = 0; cellId < numberOfCells; ++cellId )
+      {
+      this->GetCellView(cellId, view);
+      for ( const PointIdentifier *pointId = view.PointIdsBegin();
+            pointId != view.PointIdsEnd(); ++pointId )
+        {
+        ( m_CellLinksContainer->CreateElementAt(*pointId) ).insert(cellId);
+        }
+      }
+    return;
+    }
+
   for ( CellsContainerIterator cellItr = m_CellsContainer->Begin();
         cellItr != m_CellsContainer->End(); ++cellItr )
     {
@@ -1007,6 +1086,284 @@ Mesh< TPixelType, VDimension, TMeshTraits >
     }
 }
 
+/**
+ * Store the cells in flat arrays, releasing the cell objects.
+ */
+template< typename TPixelType, unsigned int VDimension, typename TMeshTraits >
+void
+Mesh< TPixelType, VDimension, TMeshTraits >
+::SetCellsArrays(CellTypesContainer *types, CellOffsetsContainer *offsets,
+                 CellConnectivityContainer *connectivity)
+{
+  if ( !types || !offsets || !connectivity )
+    {
+    itkExceptionMacro(<< "The containers of the cells arrays must not be ITK_NULLPTR");
+    }
+
+  const CellIdentifier numberOfCells = types->Size();
+  if ( offsets->Size() != numberOfCells + 1
+       || offsets->GetElement(numberOfCells) != connectivity->Size() )
+    {
+    itkExceptionMacro(<< "The offsets of the cells arrays must have one element per cell, "
+                      << "followed by the size of the connectivity");
+    }
+
+  // Check the number of points of each cell, so that the cells can be
+  // accessed without any check.
+  for ( CellIdentifier cellId = 0; cellId < numberOfCells; ++cellId )
+    {
+    const CellIdentifier offset = offsets->GetElement(cellId);
+    const CellIdentifier nextOffset = offsets->GetElement(cellId + 1);
+    if ( nextOffset < offset )
+      {
+      itkExceptionMacro(<< "The offsets of the cells arrays decrease at cell " << cellId);
+      }
+    const CellIdentifier numberOfPoints = nextOffset - offset;
+    unsigned int         expectedNumberOfPoints = 0;
+    switch ( types->GetElement(cellId) )
+      {
+      case CellType::VERTEX_CELL:
+        expectedNumberOfPoints = VertexCell< CellType >::NumberOfPoints;
+        break;
+      case CellType::LINE_CELL:
+        expectedNumberOfPoints = LineCell< CellType >::NumberOfPoints;
+        break;
+      case CellType::TRIANGLE_CELL:
+        expectedNumberOfPoints = TriangleCell< CellType >::NumberOfPoints;
+        break;
+      case CellType::QUADRILATERAL_CELL:
+        expectedNumberOfPoints = QuadrilateralCell< CellType >::NumberOfPoints;
+        break;
+      case CellType::POLYGON_CELL:
+        // any number of points
+        expectedNumberOfPoints = numberOfPoints;
+        break;
+      case CellType::TETRAHEDRON_CELL:
+        expectedNumberOfPoints = TetrahedronCell< CellType >::NumberOfPoints;
+        break;
+      case CellType::HEXAHEDRON_CELL:
+        expectedNumberOfPoints = HexahedronCell< CellType >::NumberOfPoints;
+        break;
+      case CellType::QUADRATIC_EDGE_CELL:
+        expectedNumberOfPoints = QuadraticEdgeCell< CellType >::NumberOfPoints;
+        break;
+      case CellType::QUADRATIC_TRIANGLE_CELL:
+        expectedNumberOfPoints = QuadraticTriangleCell< CellType >::NumberOfPoints;
+        break;
+      default:
+        itkExceptionMacro(<< "Unknown type of cell " << cellId << ": "
+                          << static_cast< int >( types->GetElement(cellId) ));
+      }
+    if ( numberOfPoints != expectedNumberOfPoints )
+      {
+      itkExceptionMacro(<< "Invalid number of points of cell " << cellId << ": " << numberOfPoints);
+      }
+    }
+
+  this->ReleaseCellsMemory();
+  m_CellsContainer = CellsContainer::New();
+  m_CellTypesContainer = types;
+  m_CellOffsetsContainer = offsets;
+  m_CellConnectivityContainer = connectivity;
+  this->Modified();
+}
+
+/**
+ * Move the cells of the cells container to flat arrays.
+ */
+template< typename TPixelType, unsigned int VDimension, typename TMeshTraits >
+void
+Mesh< TPixelType, VDimension, TMeshTraits >
+::ConvertCellsToArrays()
+{
+  if ( this->HasCellsArrays() )
+    {
+    return;
+    }
+
+  CellTypesContainerPointer        types = CellTypesContainer::New();
+  CellOffsetsContainerPointer      offsets = CellOffsetsContainer::New();
+  CellConnectivityContainerPointer connectivity = CellConnectivityContainer::New();
+  CellDataContainerPointer         cellData = CellDataContainer::New();
+
+  const CellIdentifier numberOfCells = this->GetNumberOfCells();
+  types->CastToSTLContainer().reserve(numberOfCells);
+  offsets->CastToSTLContainer().reserve(numberOfCells + 1);
+
+  if ( m_CellsContainer )
+    {
+    CellIdentifier newCellId = 0;
+    for ( CellsContainerIterator cellItr = m_CellsContainer->Begin();
+          cellItr != m_CellsContainer->End(); ++cellItr )
+      {
+      // a vector container may hold unset identifiers
+      const CellType *cell = cellItr->Value();
+      if ( !cell )
+        {
+        continue;
+        }
+      types->CastToSTLContainer().push_back( static_cast< unsigned char >( cell->GetType() ) );
+      offsets->CastToSTLContainer().push_back( connectivity->Size() );
+      for ( typename CellType::PointIdConstIterator pointId = cell->PointIdsBegin();
+            pointId != cell->PointIdsEnd(); ++pointId )
+        {
+        connectivity->CastToSTLContainer().push_back(*pointId);
+        }
+
+      // the cells are renumbered from 0
+      CellPixelType data;
+      if ( m_CellDataContainer && m_CellDataContainer->GetElementIfIndexExists(cellItr->Index(), &data) )
+        {
+        cellData->InsertElement(newCellId, data);
+        }
+      ++newCellId;
+      }
+    }
+  offsets->CastToSTLContainer().push_back( connectivity->Size() );
+
+  if ( m_CellDataContainer )
+    {
+    m_CellDataContainer = cellData;
+    }
+  if ( m_CellLinksContainer )
+    {
+    m_CellLinksContainer->Initialize();
+    }
+  this->SetCellsArrays(types, offsets, connectivity);
+}
+
+/**
+ * Move the cells stored in flat arrays to the cells container.
+ */
+template< typename TPixelType, unsigned int VDimension, typename TMeshTraits >
+void
+Mesh< TPixelType, VDimension, TMeshTraits >
+::ConvertCellsArraysToCells()
+{
+  if ( !this->HasCellsArrays() )
+    {
+    return;
+    }
+
+  this->MoveCellsArraysToCellsContainer();
+  this->Modified();
+}
+
+/**
+ * Move the cells stored in flat arrays to the cells container, without
+ * modifying the mesh.
+ */
+template< typename TPixelType, unsigned int VDimension, typename TMeshTraits >
+void
+Mesh< TPixelType, VDimension, TMeshTraits >
+::MoveCellsArraysToCellsContainer()
+{
+  const CellIdentifier  numberOfCells = this->GetNumberOfCells();
+  CellsContainerPointer cells = CellsContainer::New();
+  CellView              view;
+  CellAutoPointer       cell;
+  for ( CellIdentifier cellId = 0; cellId < numberOfCells; ++cellId )
+    {
+    this->GetCellView(cellId, view);
+    this->CreateCell(view, cell);
+    cells->InsertElement( cellId, cell.ReleaseOwnership() );
+    }
+
+  m_CellTypesContainer = ITK_NULLPTR;
+  m_CellOffsetsContainer = ITK_NULLPTR;
+  m_CellConnectivityContainer = ITK_NULLPTR;
+
+  // The current cells container is empty, and may be shared by a grafted
+  // mesh.
+  m_CellsContainer = cells;
+  m_CellsAllocationMethod = CellsAllocatedDynamicallyCellByCell;
+}
+
+/**
+ * Get a view of the type and the point identifiers of a cell.
+ */
+template< typename TPixelType, unsigned int VDimension, typename TMeshTraits >
+bool
+Mesh< TPixelType, VDimension, TMeshTraits >
+::GetCellView(CellIdentifier cellId, CellView & view) const
+{
+  if ( this->HasCellsArrays() )
+    {
+    if ( cellId >= m_CellTypesContainer->Size() )
+      {
+      return false;
+      }
+    const CellIdentifier offset = m_CellOffsetsContainer->GetElement(cellId);
+    const CellIdentifier numberOfPoints = m_CellOffsetsContainer->GetElement(cellId + 1) - offset;
+    view = CellView( static_cast< typename CellView::CellGeometry >( m_CellTypesContainer->GetElement(cellId) ),
+                     numberOfPoints,
+                     numberOfPoints ? &m_CellConnectivityContainer->ElementAt(offset) : ITK_NULLPTR );
+    return true;
+    }
+
+  if ( m_CellsContainer.IsNull() )
+    {
+    return false;
+    }
+
+  CellType *cellptr = ITK_NULLPTR;
+  if ( !m_CellsContainer->GetElementIfIndexExists(cellId, &cellptr) || !cellptr )
+    {
+    return false;
+    }
+
+  // Some cells compute their point identifiers in PointIdsBegin().
+  const CellType *              cell = cellptr;
+  const PointIdentifier * const begin = cell->PointIdsBegin();
+  view = CellView( cell->GetType(), static_cast< unsigned int >( cell->PointIdsEnd() - begin ), begin );
+  return true;
+}
+
+/**
+ * Create a cell object of the type of a cell view.
+ */
+template< typename TPixelType, unsigned int VDimension, typename TMeshTraits >
+void
+Mesh< TPixelType, VDimension, TMeshTraits >
+::CreateCell(const CellView & view, CellAutoPointer & cellPointer) const
+{
+  CellType *cell = ITK_NULLPTR;
+  switch ( view.GetType() )
+    {
+    case CellType::VERTEX_CELL:
+      cell = new VertexCell< CellType >;
+      break;
+    case CellType::LINE_CELL:
+      cell = new LineCell< CellType >;
+      break;
+    case CellType::TRIANGLE_CELL:
+      cell = new TriangleCell< CellType >;
+      break;
+    case CellType::QUADRILATERAL_CELL:
+      cell = new QuadrilateralCell< CellType >;
+      break;
+    case CellType::POLYGON_CELL:
+      cell = new PolygonCell< CellType >;
+      break;
+    case CellType::TETRAHEDRON_CELL:
+      cell = new TetrahedronCell< CellType >;
+      break;
+    case CellType::HEXAHEDRON_CELL:
+      cell = new HexahedronCell< CellType >;
+      break;
+    case CellType::QUADRATIC_EDGE_CELL:
+      cell = new QuadraticEdgeCell< CellType >;
+      break;
+    case CellType::QUADRATIC_TRIANGLE_CELL:
+      cell = new QuadraticTriangleCell< CellType >;
+      break;
+    default:
+      itkExceptionMacro(<< "Unknown type of cell: " << static_cast< int >( view.GetType() ));
+    }
+  cell->SetPointIds( view.PointIdsBegin(), view.PointIdsEnd() );
+  cellPointer.TakeOwnership(cell);
+}
+
 /******************************************************************************
  * PROTECTED METHOD DEFINITIONS
  *****************************************************************************/
@@ -1173,6 +1530,9 @@ Mesh< TPixelType, VDimension, TMeshTraits >
   this->m_CellDataContainer  = mesh->m_CellDataContainer;
   this->m_CellLinksContainer = mesh->m_CellLinksContainer;
   this->m_BoundaryAssignmentsContainers = mesh->m_BoundaryAssignmentsContainers;
+  this->m_CellTypesContainer = mesh->m_CellTypesContainer;
+  this->m_CellOffsetsContainer = mesh->m_CellOffsetsContainer;
+  this->m_CellConnectivityContainer = mesh->m_CellConnectivityContainer;
 
   // The cell allocation method must be maintained. The reference count
   // test on the container will prevent premature deletion of cells.
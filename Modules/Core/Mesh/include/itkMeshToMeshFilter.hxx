@@ -195,6 +195,26 @@ MeshToMeshFilter< TInputMesh, TOutputMesh >
 
   outputMesh->SetCellsAllocationMethod(OutputMeshType::CellsAllocatedDynamicallyCellByCell);
 
+  // Cells stored in arrays are copied as arrays.
+  if ( inputMesh->HasCellsArrays() )
+    {
+    typename TOutputMesh::CellTypesContainerPointer types = TOutputMesh::CellTypesContainer::New();
+    typename TOutputMesh::CellOffsetsContainerPointer offsets = TOutputMesh::CellOffsetsContainer::New();
+    typename TOutputMesh::CellConnectivityContainerPointer connectivity =
+      TOutputMesh::CellConnectivityContainer::New();
+    types->CastToSTLContainer().assign(
+      inputMesh->GetCellTypesContainer()->CastToSTLConstContainer().begin(),
+      inputMesh->GetCellTypesContainer()->CastToSTLConstContainer().end() );
+    offsets->CastToSTLContainer().assign(
+      inputMesh->GetCellOffsetsContainer()->CastToSTLConstContainer().begin(),
+      inputMesh->GetCellOffsetsContainer()->CastToSTLConstContainer().end() );
+    connectivity->CastToSTLContainer().assign(
+      inputMesh->GetCellConnectivityContainer()->CastToSTLConstContainer().begin(),
+      inputMesh->GetCellConnectivityContainer()->CastToSTLConstContainer().end() );
+    outputMesh->SetCellsArrays(types, offsets, connectivity);
+    return;
+    }
+
   typename OutputCellsContainer::Pointer outputCells = OutputCellsContainer::New();
   const InputCellsContainer *inputCells = inputMesh->GetCells();
 
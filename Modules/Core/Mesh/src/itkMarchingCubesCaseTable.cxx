@@ -0,0 +1,288 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMarchingCubesCaseTable.h"
+
+namespace itk
+{
+const unsigned char MarchingCubesCaseTable::m_EdgeCorners[12][2] = {
+  { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 },
+  { 0, 2 }, { 1, 3 }, { 4, 6 }, { 5, 7 },
+  { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 }
+};
+
+// Built by joining the points of the edges of the cube along its faces,
+// each face separating its inside corners, and triangulating the polygons.
+const signed char MarchingCubesCaseTable::m_Triangles[256][16] = {
+  { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9,  5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  4,  8,  9,  4,  9,  5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  1, 10,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  1, 10,  0, 10,  8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9,  5,  1, 10,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  1, 10,  8,  1,  8,  9,  1,  9,  5, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  5, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  8,  1,  5, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9, 11,  0, 11,  1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  4,  8,  1,  8,  9,  1,  9, 11, -1, -1, -1, -1, -1, -1, -1 },
+  {  4,  5, 11,  4, 11, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  5, 11,  0, 11, 10,  0, 10,  8, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9, 11,  0, 11, 10,  0, 10,  4, -1, -1, -1, -1, -1, -1, -1 },
+  {  8,  9, 11,  8, 11, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  8,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  6,  0,  6,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9,  5,  2,  8,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  9,  5,  2,  5,  4,  2,  4,  6, -1, -1, -1, -1, -1, -1, -1 },
+  {  1, 10,  4,  2,  8,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  1, 10,  0, 10,  6,  0,  6,  2, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9,  5,  1, 10,  4,  2,  8,  6, -1, -1, -1, -1, -1, -1, -1 },
+  {  1, 10,  6,  1,  6,  2,  1,  2,  9,  1,  9,  5, -1, -1, -1, -1 },
+  {  1,  5, 11,  2,  8,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  6,  0,  6,  2,  1,  5, 11, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9, 11,  0, 11,  1,  2,  8,  6, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  4,  6,  1,  6,  2,  1,  2,  9,  1,  9, 11, -1, -1, -1, -1 },
+  {  2,  8,  6,  4,  5, 11,  4, 11, 10, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  5, 11,  0, 11, 10,  0, 10,  6,  0,  6,  2, -1, -1, -1, -1 },
+  {  0,  9, 11,  0, 11, 10,  0, 10,  4,  2,  8,  6, -1, -1, -1, -1 },
+  {  2,  9, 11,  2, 11, 10,  2, 10,  6, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  7,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  8,  2,  7,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  2,  7,  0,  7,  5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  7,  5,  2,  5,  4,  2,  4,  8, -1, -1, -1, -1, -1, -1, -1 },
+  {  1, 10,  4,  2,  7,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  1, 10,  0, 10,  8,  2,  7,  9, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  2,  7,  0,  7,  5,  1, 10,  4, -1, -1, -1, -1, -1, -1, -1 },
+  {  1, 10,  8,  1,  8,  2,  1,  2,  7,  1,  7,  5, -1, -1, -1, -1 },
+  {  1,  5, 11,  2,  7,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  8,  1,  5, 11,  2,  7,  9, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  2,  7,  0,  7, 11,  0, 11,  1, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  4,  8,  1,  8,  2,  1,  2,  7,  1,  7, 11, -1, -1, -1, -1 },
+  {  2,  7,  9,  4,  5, 11,  4, 11, 10, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  5, 11,  0, 11, 10,  0, 10,  8,  2,  7,  9, -1, -1, -1, -1 },
+  {  0,  2,  7,  0,  7, 11,  0, 11, 10,  0, 10,  4, -1, -1, -1, -1 },
+  {  2,  7, 11,  2, 11, 10,  2, 10,  8, -1, -1, -1, -1, -1, -1, -1 },
+  {  6,  7,  9,  6,  9,  8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  6,  0,  6,  7,  0,  7,  9, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  8,  6,  0,  6,  7,  0,  7,  5, -1, -1, -1, -1, -1, -1, -1 },
+  {  4,  6,  7,  4,  7,  5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  1, 10,  4,  6,  7,  9,  6,  9,  8, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  1, 10,  0, 10,  6,  0,  6,  7,  0,  7,  9, -1, -1, -1, -1 },
+  {  0,  8,  6,  0,  6,  7,  0,  7,  5,  1, 10,  4, -1, -1, -1, -1 },
+  {  1, 10,  6,  1,  6,  7,  1,  7,  5, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  5, 11,  6,  7,  9,  6,  9,  8, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  6,  0,  6,  7,  0,  7,  9,  1,  5, 11, -1, -1, -1, -1 },
+  {  0,  8,  6,  0,  6,  7,  0,  7, 11,  0, 11,  1, -1, -1, -1, -1 },
+  {  1,  4,  6,  1,  6,  7,  1,  7, 11, -1, -1, -1, -1, -1, -1, -1 },
+  {  4,  5, 11,  4, 11, 10,  6,  7,  9,  6,  9,  8, -1, -1, -1, -1 },
+  {  0,  5, 11,  0, 11, 10,  0, 10,  6,  0,  6,  7,  0,  7,  9, -1 },
+  {  0,  8,  6,  0,  6,  7,  0,  7, 11,  0, 11, 10,  0, 10,  4, -1 },
+  {  6,  7, 11,  6, 11, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  3,  6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  8,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9,  5,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  3,  6, 10,  4,  8,  9,  4,  9,  5, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  3,  6,  1,  6,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  1,  3,  0,  3,  6,  0,  6,  8, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9,  5,  1,  3,  6,  1,  6,  4, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  3,  6,  1,  6,  8,  1,  8,  9,  1,  9,  5, -1, -1, -1, -1 },
+  {  1,  5, 11,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  8,  1,  5, 11,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9, 11,  0, 11,  1,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  4,  8,  1,  8,  9,  1,  9, 11,  3,  6, 10, -1, -1, -1, -1 },
+  {  3,  6,  4,  3,  4,  5,  3,  5, 11, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  5, 11,  0, 11,  3,  0,  3,  6,  0,  6,  8, -1, -1, -1, -1 },
+  {  0,  9, 11,  0, 11,  3,  0,  3,  6,  0,  6,  4, -1, -1, -1, -1 },
+  {  3,  6,  8,  3,  8,  9,  3,  9, 11, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  8, 10,  2, 10,  3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4, 10,  0, 10,  3,  0,  3,  2, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9,  5,  2,  8, 10,  2, 10,  3, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  9,  5,  2,  5,  4,  2,  4, 10,  2, 10,  3, -1, -1, -1, -1 },
+  {  1,  3,  2,  1,  2,  8,  1,  8,  4, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  1,  3,  0,  3,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9,  5,  1,  3,  2,  1,  2,  8,  1,  8,  4, -1, -1, -1, -1 },
+  {  1,  3,  2,  1,  2,  9,  1,  9,  5, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  5, 11,  2,  8, 10,  2, 10,  3, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4, 10,  0, 10,  3,  0,  3,  2,  1,  5, 11, -1, -1, -1, -1 },
+  {  0,  9, 11,  0, 11,  1,  2,  8, 10,  2, 10,  3, -1, -1, -1, -1 },
+  {  4, 10,  3,  4,  3,  2,  4,  2,  9,  4,  9, 11,  4, 11,  1, -1 },
+  {  2,  8,  4,  2,  4,  5,  2,  5, 11,  2, 11,  3, -1, -1, -1, -1 },
+  {  0,  5, 11,  0, 11,  3,  0,  3,  2, -1, -1, -1, -1, -1, -1, -1 },
+  { 11,  3,  2, 11,  2,  8, 11,  8,  4, 11,  4,  0, 11,  0,  9, -1 },
+  {  2,  9, 11,  2, 11,  3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  7,  9,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  8,  2,  7,  9,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  2,  7,  0,  7,  5,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  7,  5,  2,  5,  4,  2,  4,  8,  3,  6, 10, -1, -1, -1, -1 },
+  {  1,  3,  6,  1,  6,  4,  2,  7,  9, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  1,  3,  0,  3,  6,  0,  6,  8,  2,  7,  9, -1, -1, -1, -1 },
+  {  0,  2,  7,  0,  7,  5,  1,  3,  6,  1,  6,  4, -1, -1, -1, -1 },
+  {  1,  3,  6,  1,  6,  8,  1,  8,  2,  1,  2,  7,  1,  7,  5, -1 },
+  {  1,  5, 11,  2,  7,  9,  3,  6, 10, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  8,  1,  5, 11,  2,  7,  9,  3,  6, 10, -1, -1, -1, -1 },
+  {  0,  2,  7,  0,  7, 11,  0, 11,  1,  3,  6, 10, -1, -1, -1, -1 },
+  {  1,  4,  8,  1,  8,  2,  1,  2,  7,  1,  7, 11,  3,  6, 10, -1 },
+  {  2,  7,  9,  3,  6,  4,  3,  4,  5,  3,  5, 11, -1, -1, -1, -1 },
+  {  0,  5, 11,  0, 11,  3,  0,  3,  6,  0,  6,  8,  2,  7,  9, -1 },
+  {  0,  2,  7,  0,  7, 11,  0, 11,  3,  0,  3,  6,  0,  6,  4, -1 },
+  { 11,  3,  6, 11,  6,  8, 11,  8,  2, 11,  2,  7, -1, -1, -1, -1 },
+  {  3,  7,  9,  3,  9,  8,  3,  8, 10, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4, 10,  0, 10,  3,  0,  3,  7,  0,  7,  9, -1, -1, -1, -1 },
+  {  0,  8, 10,  0, 10,  3,  0,  3,  7,  0,  7,  5, -1, -1, -1, -1 },
+  {  3,  7,  5,  3,  5,  4,  3,  4, 10, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  3,  7,  1,  7,  9,  1,  9,  8,  1,  8,  4, -1, -1, -1, -1 },
+  {  0,  1,  3,  0,  3,  7,  0,  7,  9, -1, -1, -1, -1, -1, -1, -1 },
+  {  8,  4,  1,  8,  1,  3,  8,  3,  7,  8,  7,  5,  8,  5,  0, -1 },
+  {  1,  3,  7,  1,  7,  5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  5, 11,  3,  7,  9,  3,  9,  8,  3,  8, 10, -1, -1, -1, -1 },
+  {  0,  4, 10,  0, 10,  3,  0,  3,  7,  0,  7,  9,  1,  5, 11, -1 },
+  {  0,  8, 10,  0, 10,  3,  0,  3,  7,  0,  7, 11,  0, 11,  1, -1 },
+  {  4, 10,  3,  4,  3,  7,  4,  7, 11,  4, 11,  1, -1, -1, -1, -1 },
+  {  3,  7,  9,  3,  9,  8,  3,  8,  4,  3,  4,  5,  3,  5, 11, -1 },
+  {  0,  5, 11,  0, 11,  3,  0,  3,  7,  0,  7,  9, -1, -1, -1, -1 },
+  {  0,  8,  4,  3,  7, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  3,  7, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  3, 11,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  8,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9,  5,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  3, 11,  7,  4,  8,  9,  4,  9,  5, -1, -1, -1, -1, -1, -1, -1 },
+  {  1, 10,  4,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  1, 10,  0, 10,  8,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9,  5,  1, 10,  4,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1 },
+  {  1, 10,  8,  1,  8,  9,  1,  9,  5,  3, 11,  7, -1, -1, -1, -1 },
+  {  1,  5,  7,  1,  7,  3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  8,  1,  5,  7,  1,  7,  3, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9,  7,  0,  7,  3,  0,  3,  1, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  4,  8,  1,  8,  9,  1,  9,  7,  1,  7,  3, -1, -1, -1, -1 },
+  {  3, 10,  4,  3,  4,  5,  3,  5,  7, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  5,  7,  0,  7,  3,  0,  3, 10,  0, 10,  8, -1, -1, -1, -1 },
+  {  0,  9,  7,  0,  7,  3,  0,  3, 10,  0, 10,  4, -1, -1, -1, -1 },
+  {  3, 10,  8,  3,  8,  9,  3,  9,  7, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  8,  6,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  6,  0,  6,  2,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9,  5,  2,  8,  6,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  9,  5,  2,  5,  4,  2,  4,  6,  3, 11,  7, -1, -1, -1, -1 },
+  {  1, 10,  4,  2,  8,  6,  3, 11,  7, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  1, 10,  0, 10,  6,  0,  6,  2,  3, 11,  7, -1, -1, -1, -1 },
+  {  0,  9,  5,  1, 10,  4,  2,  8,  6,  3, 11,  7, -1, -1, -1, -1 },
+  {  1, 10,  6,  1,  6,  2,  1,  2,  9,  1,  9,  5,  3, 11,  7, -1 },
+  {  1,  5,  7,  1,  7,  3,  2,  8,  6, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  6,  0,  6,  2,  1,  5,  7,  1,  7,  3, -1, -1, -1, -1 },
+  {  0,  9,  7,  0,  7,  3,  0,  3,  1,  2,  8,  6, -1, -1, -1, -1 },
+  {  1,  4,  6,  1,  6,  2,  1,  2,  9,  1,  9,  7,  1,  7,  3, -1 },
+  {  2,  8,  6,  3, 10,  4,  3,  4,  5,  3,  5,  7, -1, -1, -1, -1 },
+  {  0,  5,  7,  0,  7,  3,  0,  3, 10,  0, 10,  6,  0,  6,  2, -1 },
+  {  0,  9,  7,  0,  7,  3,  0,  3, 10,  0, 10,  4,  2,  8,  6, -1 },
+  {  9,  7,  3,  9,  3, 10,  9, 10,  6,  9,  6,  2, -1, -1, -1, -1 },
+  {  2,  3, 11,  2, 11,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  8,  2,  3, 11,  2, 11,  9, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  2,  3,  0,  3, 11,  0, 11,  5, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  3, 11,  2, 11,  5,  2,  5,  4,  2,  4,  8, -1, -1, -1, -1 },
+  {  1, 10,  4,  2,  3, 11,  2, 11,  9, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  1, 10,  0, 10,  8,  2,  3, 11,  2, 11,  9, -1, -1, -1, -1 },
+  {  0,  2,  3,  0,  3, 11,  0, 11,  5,  1, 10,  4, -1, -1, -1, -1 },
+  {  8,  2,  3,  8,  3, 11,  8, 11,  5,  8,  5,  1,  8,  1, 10, -1 },
+  {  1,  5,  9,  1,  9,  2,  1,  2,  3, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  8,  1,  5,  9,  1,  9,  2,  1,  2,  3, -1, -1, -1, -1 },
+  {  0,  2,  3,  0,  3,  1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  4,  8,  1,  8,  2,  1,  2,  3, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  3, 10,  2, 10,  4,  2,  4,  5,  2,  5,  9, -1, -1, -1, -1 },
+  {  5,  9,  2,  5,  2,  3,  5,  3, 10,  5, 10,  8,  5,  8,  0, -1 },
+  {  0,  2,  3,  0,  3, 10,  0, 10,  4, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  3, 10,  2, 10,  8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  3, 11,  9,  3,  9,  8,  3,  8,  6, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  6,  0,  6,  3,  0,  3, 11,  0, 11,  9, -1, -1, -1, -1 },
+  {  0,  8,  6,  0,  6,  3,  0,  3, 11,  0, 11,  5, -1, -1, -1, -1 },
+  {  3, 11,  5,  3,  5,  4,  3,  4,  6, -1, -1, -1, -1, -1, -1, -1 },
+  {  1, 10,  4,  3, 11,  9,  3,  9,  8,  3,  8,  6, -1, -1, -1, -1 },
+  {  0,  1, 10,  0, 10,  6,  0,  6,  3,  0,  3, 11,  0, 11,  9, -1 },
+  {  0,  8,  6,  0,  6,  3,  0,  3, 11,  0, 11,  5,  1, 10,  4, -1 },
+  {  6,  3, 11,  6, 11,  5,  6,  5,  1,  6,  1, 10, -1, -1, -1, -1 },
+  {  1,  5,  9,  1,  9,  8,  1,  8,  6,  1,  6,  3, -1, -1, -1, -1 },
+  {  6,  3,  1,  6,  1,  5,  6,  5,  9,  6,  9,  0,  6,  0,  4, -1 },
+  {  0,  8,  6,  0,  6,  3,  0,  3,  1, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  4,  6,  1,  6,  3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  3, 10,  4,  3,  4,  5,  3,  5,  9,  3,  9,  8,  3,  8,  6, -1 },
+  {  0,  5,  9,  3, 10,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  8,  6,  0,  6,  3,  0,  3, 10,  0, 10,  4, -1, -1, -1, -1 },
+  {  3, 10,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  6, 10, 11,  6, 11,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  8,  6, 10, 11,  6, 11,  7, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9,  5,  6, 10, 11,  6, 11,  7, -1, -1, -1, -1, -1, -1, -1 },
+  {  4,  8,  9,  4,  9,  5,  6, 10, 11,  6, 11,  7, -1, -1, -1, -1 },
+  {  1, 11,  7,  1,  7,  6,  1,  6,  4, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  1, 11,  0, 11,  7,  0,  7,  6,  0,  6,  8, -1, -1, -1, -1 },
+  {  0,  9,  5,  1, 11,  7,  1,  7,  6,  1,  6,  4, -1, -1, -1, -1 },
+  {  1, 11,  7,  1,  7,  6,  1,  6,  8,  1,  8,  9,  1,  9,  5, -1 },
+  {  1,  5,  7,  1,  7,  6,  1,  6, 10, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  8,  1,  5,  7,  1,  7,  6,  1,  6, 10, -1, -1, -1, -1 },
+  {  0,  9,  7,  0,  7,  6,  0,  6, 10,  0, 10,  1, -1, -1, -1, -1 },
+  {  1,  4,  8,  1,  8,  9,  1,  9,  7,  1,  7,  6,  1,  6, 10, -1 },
+  {  4,  5,  7,  4,  7,  6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  5,  7,  0,  7,  6,  0,  6,  8, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9,  7,  0,  7,  6,  0,  6,  4, -1, -1, -1, -1, -1, -1, -1 },
+  {  6,  8,  9,  6,  9,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  8, 10,  2, 10, 11,  2, 11,  7, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4, 10,  0, 10, 11,  0, 11,  7,  0,  7,  2, -1, -1, -1, -1 },
+  {  0,  9,  5,  2,  8, 10,  2, 10, 11,  2, 11,  7, -1, -1, -1, -1 },
+  {  2,  9,  5,  2,  5,  4,  2,  4, 10,  2, 10, 11,  2, 11,  7, -1 },
+  {  1, 11,  7,  1,  7,  2,  1,  2,  8,  1,  8,  4, -1, -1, -1, -1 },
+  {  0,  1, 11,  0, 11,  7,  0,  7,  2, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  9,  5,  1, 11,  7,  1,  7,  2,  1,  2,  8,  1,  8,  4, -1 },
+  {  1, 11,  7,  1,  7,  2,  1,  2,  9,  1,  9,  5, -1, -1, -1, -1 },
+  {  1,  5,  7,  1,  7,  2,  1,  2,  8,  1,  8, 10, -1, -1, -1, -1 },
+  { 10,  1,  5, 10,  5,  7, 10,  7,  2, 10,  2,  0, 10,  0,  4, -1 },
+  {  7,  2,  8,  7,  8, 10,  7, 10,  1,  7,  1,  0,  7,  0,  9, -1 },
+  {  1,  4, 10,  2,  9,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  8,  4,  2,  4,  5,  2,  5,  7, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  5,  7,  0,  7,  2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  7,  2,  8,  7,  8,  4,  7,  4,  0,  7,  0,  9, -1, -1, -1, -1 },
+  {  2,  9,  7, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  6, 10,  2, 10, 11,  2, 11,  9, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4,  8,  2,  6, 10,  2, 10, 11,  2, 11,  9, -1, -1, -1, -1 },
+  {  0,  2,  6,  0,  6, 10,  0, 10, 11,  0, 11,  5, -1, -1, -1, -1 },
+  {  2,  6, 10,  2, 10, 11,  2, 11,  5,  2,  5,  4,  2,  4,  8, -1 },
+  {  1, 11,  9,  1,  9,  2,  1,  2,  6,  1,  6,  4, -1, -1, -1, -1 },
+  {  1, 11,  9,  1,  9,  2,  1,  2,  6,  1,  6,  8,  1,  8,  0, -1 },
+  {  2,  6,  4,  2,  4,  1,  2,  1, 11,  2, 11,  5,  2,  5,  0, -1 },
+  {  1, 11,  5,  2,  6,  8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  5,  9,  1,  9,  2,  1,  2,  6,  1,  6, 10, -1, -1, -1, -1 },
+  {  0,  4,  8,  1,  5,  9,  1,  9,  2,  1,  2,  6,  1,  6, 10, -1 },
+  {  0,  2,  6,  0,  6, 10,  0, 10,  1, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  4,  8,  1,  8,  2,  1,  2,  6,  1,  6, 10, -1, -1, -1, -1 },
+  {  2,  6,  4,  2,  4,  5,  2,  5,  9, -1, -1, -1, -1, -1, -1, -1 },
+  {  5,  9,  2,  5,  2,  6,  5,  6,  8,  5,  8,  0, -1, -1, -1, -1 },
+  {  0,  2,  6,  0,  6,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  2,  6,  8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  8, 10, 11,  8, 11,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  4, 10,  0, 10, 11,  0, 11,  9, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  8, 10,  0, 10, 11,  0, 11,  5, -1, -1, -1, -1, -1, -1, -1 },
+  {  4, 10, 11,  4, 11,  5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  1, 11,  9,  1,  9,  8,  1,  8,  4, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  1, 11,  0, 11,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  8,  4,  1,  8,  1, 11,  8, 11,  5,  8,  5,  0, -1, -1, -1, -1 },
+  {  1, 11,  5, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  5,  9,  1,  9,  8,  1,  8, 10, -1, -1, -1, -1, -1, -1, -1 },
+  { 10,  1,  5, 10,  5,  9, 10,  9,  0, 10,  0,  4, -1, -1, -1, -1 },
+  {  0,  8, 10,  0, 10,  1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  1,  4, 10, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  4,  5,  9,  4,  9,  8, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  5,  9, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  {  0,  8,  4, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+  { -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 }
+};
+} // end namespace itk
@@ -0,0 +1,212 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkLabelImage3DMeshSource.h"
+#include "itkMesh.h"
+#include "itkImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+#include <map>
+
+namespace
+{
+typedef itk::Image< unsigned char, 3 > ImageType;
+typedef itk::Mesh< double, 3 >         MeshType;
+
+typedef itk::LabelImage3DMeshSource< ImageType, MeshType > SourceType;
+
+// A ball of label 1, a box of label 2 touching it, and a box of label 3 at
+// a corner of the image.
+ImageType::Pointer
+CreateImage()
+{
+  ImageType::SizeType size;
+  size[0] = 24;
+  size[1] = 20;
+  size[2] = 18;
+  ImageType::IndexType start;
+  start[0] = 3;
+  start[1] = -2;
+  start[2] = 5;
+  ImageType::SpacingType spacing;
+  spacing[0] = 0.5;
+  spacing[1] = 1.0;
+  spacing[2] = 1.5;
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( ImageType::RegionType( start, size ) );
+  image->SetSpacing( spacing );
+  image->Allocate( true );
+
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetBufferedRegion() );
+  for( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType index = it.GetIndex();
+    const double x = index[0] - start[0] - 10.0;
+    const double y = index[1] - start[1] - 9.0;
+    const double z = index[2] - start[2] - 8.0;
+    if( x * x + y * y + z * z < 36.0 )
+      {
+      it.Set( 1 );
+      }
+    else if( x > 5.0 && x < 12.0 && y > -3.0 && y < 4.0 && z > -3.0 && z < 3.0 )
+      {
+      it.Set( 2 );
+      }
+    else if( index[0] - start[0] < 3 && index[1] - start[1] < 4 && index[2] - start[2] < 2 )
+      {
+      it.Set( 3 );
+      }
+    }
+  return image;
+}
+
+// Check that the triangles make a closed surface of genus 0 whose normals
+// point to the outside, and return its volume.
+template< typename TMesh >
+bool
+CheckSurface( const TMesh * mesh, double & volume )
+{
+  typedef typename TMesh::PointIdentifier PointIdentifier;
+  std::map< std::pair< PointIdentifier, PointIdentifier >, unsigned int > edges;
+
+  volume = 0.0;
+  typename TMesh::CellView view;
+  const typename TMesh::CellIdentifier numberOfCells = mesh->GetNumberOfCells();
+  for( typename TMesh::CellIdentifier cellId = 0; cellId < numberOfCells; ++cellId )
+    {
+    if( !mesh->GetCellView( cellId, view ) || view.GetNumberOfPoints() != 3 )
+      {
+      std::cerr << "Wrong cell " << cellId << std::endl;
+      return false;
+      }
+    typename TMesh::PointType p[3];
+    for( unsigned int i = 0; i < 3; ++i )
+      {
+      ++edges[std::make_pair( view.GetPointId( i ), view.GetPointId( ( i + 1 ) % 3 ) )];
+      p[i] = mesh->GetPoint( view.GetPointId( i ) );
+      }
+    volume += itk::CrossProduct( p[1].GetVectorFromOrigin(), p[2].GetVectorFromOrigin() )
+              * p[0].GetVectorFromOrigin() / 6.0;
+    }
+
+  typename std::map< std::pair< PointIdentifier, PointIdentifier >, unsigned int >::const_iterator it;
+  for( it = edges.begin(); it != edges.end(); ++it )
+    {
+    if( it->second != 1 || edges.count( std::make_pair( it->first.second, it->first.first ) ) != 1 )
+      {
+      std::cerr << "The edge " << it->first.first << " " << it->first.second << " is not shared by two triangles"
+                << std::endl;
+      return false;
+      }
+    }
+  const long eulerCharacteristic = static_cast< long >( mesh->GetNumberOfPoints() )
+    - static_cast< long >( edges.size() / 2 ) + static_cast< long >( numberOfCells );
+  std::cout << mesh->GetNumberOfPoints() << " points, " << numberOfCells << " triangles, volume " << volume
+            << std::endl;
+  return eulerCharacteristic == 2 && volume > 0.0;
+}
+
+bool
+SameMeshes( const MeshType * mesh1, const MeshType * mesh2 )
+{
+  if( mesh1->GetNumberOfPoints() != mesh2->GetNumberOfPoints()
+      || mesh1->GetCellConnectivityContainer()->CastToSTLConstContainer()
+         != mesh2->GetCellConnectivityContainer()->CastToSTLConstContainer() )
+    {
+    return false;
+    }
+  for( MeshType::PointIdentifier i = 0; i < mesh1->GetNumberOfPoints(); ++i )
+    {
+    if( mesh1->GetPoint( i ) != mesh2->GetPoint( i ) )
+      {
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+// Extract the surfaces of the labels of an image, with one and several
+// threads, and check that they are closed and oriented to the outside.
+int itkLabelImage3DMeshSourceTest( int, char* [] )
+{
+  ImageType::Pointer image = CreateImage();
+
+  SourceType::Pointer source = SourceType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( source, LabelImage3DMeshSource, ImageToMeshFilter );
+  source->SetInput( image );
+  source->SetNumberOfThreads( 1 );
+  TRY_EXPECT_NO_EXCEPTION( source->Update() );
+
+  TEST_EXPECT_EQUAL( 3, source->GetOutputLabels().size() );
+  TEST_EXPECT_EQUAL( 3, source->GetNumberOfIndexedOutputs() );
+  std::vector< double > volumes( 3 );
+  std::vector< MeshType::Pointer > meshes( 3 );
+  for( unsigned int i = 0; i < 3; ++i )
+    {
+    TEST_EXPECT_EQUAL( i + 1, source->GetOutputLabels()[i] );
+    meshes[i] = source->GetOutput( i );
+    meshes[i]->DisconnectPipeline();
+    TEST_EXPECT_TRUE( meshes[i]->HasCellsArrays() );
+    TEST_EXPECT_TRUE( CheckSurface( meshes[i].GetPointer(), volumes[i] ) );
+    }
+
+  // the box of 3x4x2 voxels at the corner of the image is closed by the
+  // outside, and its edges and corners are cut at the middle of the voxels
+  const double voxelVolume = 0.5 * 1.0 * 1.5;
+  const double boxVolume = 3 * 4 * 2 - ( 3 + 4 + 2 ) / 2.0 + 3.0 / 2.0 - 5.0 / 6.0;
+  TEST_EXPECT_TRUE( itk::Math::abs( volumes[2] - boxVolume * voxelVolume ) < 1e-6 );
+
+  // the same surfaces with several threads
+  SourceType::Pointer threaded = SourceType::New();
+  threaded->SetInput( image );
+  threaded->SetNumberOfThreads( 4 );
+  threaded->Update();
+  for( unsigned int i = 0; i < 3; ++i )
+    {
+    TEST_EXPECT_TRUE( SameMeshes( meshes[i], threaded->GetOutput( i ) ) );
+    }
+
+  // some labels, in the order of the outputs
+  SourceType::LabelVectorType labels;
+  labels.push_back( 3 );
+  labels.push_back( 1 );
+  threaded->SetLabels( labels );
+  threaded->Update();
+  TEST_EXPECT_EQUAL( 2, threaded->GetNumberOfIndexedOutputs() );
+  TEST_EXPECT_TRUE( SameMeshes( meshes[2], threaded->GetOutput( 0 ) ) );
+  TEST_EXPECT_TRUE( SameMeshes( meshes[0], threaded->GetOutput( 1 ) ) );
+
+  labels.push_back( 3 );
+  threaded->SetLabels( labels );
+  TRY_EXPECT_EXCEPTION( threaded->Update() );
+
+  // the normals still point to the outside in a flipped physical space
+  ImageType::DirectionType direction = image->GetDirection();
+  direction[0][0] = -1.0;
+  image->SetDirection( direction );
+  source->Update();
+  double volume;
+  TEST_EXPECT_TRUE( CheckSurface( source->GetOutput( 0 ), volume ) );
+  TEST_EXPECT_TRUE( itk::Math::abs( volume - volumes[0] ) < 1e-6 * volumes[0] );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,249 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMesh.h"
+#include "itkConnectedRegionsMeshFilter.h"
+#include "itkTransformMeshFilter.h"
+#include "itkIdentityTransform.h"
+#include "itkTriangleCell.h"
+#include "itkQuadrilateralCell.h"
+#include "itkLineCell.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+typedef itk::Mesh< float, 3 > MeshType;
+
+typedef MeshType::CellType                  CellType;
+typedef MeshType::CellAutoPointer           CellAutoPointer;
+typedef MeshType::CellView                  CellViewType;
+typedef MeshType::CellTypesContainer        CellTypesContainer;
+typedef MeshType::CellOffsetsContainer      CellOffsetsContainer;
+typedef MeshType::CellConnectivityContainer CellConnectivityContainer;
+
+// A grid of points with a triangle, a quadrilateral, a polygon and a line.
+void
+FillMesh( MeshType * mesh )
+{
+  for( unsigned int i = 0; i < 12; ++i )
+    {
+    MeshType::PointType point;
+    point[0] = i % 4;
+    point[1] = i / 4;
+    point[2] = 0.0;
+    mesh->SetPoint( i, point );
+    }
+}
+
+void
+CreateArrays( CellTypesContainer::Pointer & types, CellOffsetsContainer::Pointer & offsets,
+              CellConnectivityContainer::Pointer & connectivity )
+{
+  const unsigned char cellTypes[] = { CellType::TRIANGLE_CELL, CellType::QUADRILATERAL_CELL,
+                                      CellType::POLYGON_CELL, CellType::LINE_CELL };
+  const MeshType::CellIdentifier cellOffsets[] = { 0, 3, 7, 12, 14 };
+  const MeshType::PointIdentifier cellPoints[] = { 0, 1, 4, 1, 2, 6, 5, 2, 3, 7, 11, 10, 8, 9 };
+
+  types = CellTypesContainer::New();
+  offsets = CellOffsetsContainer::New();
+  connectivity = CellConnectivityContainer::New();
+  types->CastToSTLContainer().assign( cellTypes, cellTypes + 4 );
+  offsets->CastToSTLContainer().assign( cellOffsets, cellOffsets + 5 );
+  connectivity->CastToSTLContainer().assign( cellPoints, cellPoints + 14 );
+}
+
+// Compare the cells of a mesh to the arrays, through the views and the cell
+// objects.
+bool
+CheckCells( const MeshType * mesh, const CellTypesContainer * types, const CellOffsetsContainer * offsets,
+            const CellConnectivityContainer * connectivity )
+{
+  if( mesh->GetNumberOfCells() != types->Size() )
+    {
+    std::cerr << "Wrong number of cells: " << mesh->GetNumberOfCells() << std::endl;
+    return false;
+    }
+  for( MeshType::CellIdentifier cellId = 0; cellId < types->Size(); ++cellId )
+    {
+    const unsigned int numberOfPoints = offsets->ElementAt( cellId + 1 ) - offsets->ElementAt( cellId );
+
+    CellViewType view;
+    CellAutoPointer cell;
+    if( !mesh->GetCellView( cellId, view ) || !mesh->GetCell( cellId, cell ) )
+      {
+      std::cerr << "Cell " << cellId << " not found" << std::endl;
+      return false;
+      }
+    if( view.GetType() != types->ElementAt( cellId ) || cell->GetType() != types->ElementAt( cellId )
+        || view.GetNumberOfPoints() != numberOfPoints || cell->GetNumberOfPoints() != numberOfPoints )
+      {
+      std::cerr << "Wrong type or number of points of the cell " << cellId << std::endl;
+      return false;
+      }
+    for( unsigned int i = 0; i < numberOfPoints; ++i )
+      {
+      const MeshType::PointIdentifier pointId = connectivity->ElementAt( offsets->ElementAt( cellId ) + i );
+      if( view.GetPointId( i ) != pointId || cell->GetPointIds()[i] != pointId )
+        {
+        std::cerr << "Wrong point " << i << " of the cell " << cellId << std::endl;
+        return false;
+        }
+      }
+    }
+  CellViewType view;
+  return !mesh->GetCellView( types->Size(), view );
+}
+}
+
+// Store the cells of a mesh in flat arrays, and check the access to the
+// cells, the conversions between the two storages, and the copy of the
+// arrays by the mesh filters.
+int itkMeshCellsArraysTest( int, char* [] )
+{
+  CellTypesContainer::Pointer        types;
+  CellOffsetsContainer::Pointer      offsets;
+  CellConnectivityContainer::Pointer connectivity;
+  CreateArrays( types, offsets, connectivity );
+
+  MeshType::Pointer mesh = MeshType::New();
+  FillMesh( mesh );
+  TEST_EXPECT_TRUE( !mesh->HasCellsArrays() );
+
+  // a cell object is released when the arrays are set
+  CellAutoPointer line;
+  line.TakeOwnership( new itk::LineCell< CellType > );
+  line->SetPointId( 0, 0 );
+  line->SetPointId( 1, 1 );
+  mesh->SetCell( 0, line );
+
+  mesh->SetCellsArrays( types, offsets, connectivity );
+  TEST_EXPECT_TRUE( mesh->HasCellsArrays() );
+  TEST_EXPECT_TRUE( mesh->GetCellTypesContainer() == types.GetPointer() );
+  TEST_EXPECT_TRUE( CheckCells( mesh, types, offsets, connectivity ) );
+
+  // the cell links
+  mesh->BuildCellLinks();
+  TEST_EXPECT_EQUAL( 2, mesh->GetCellLinks()->ElementAt( 1 ).size() );
+  TEST_EXPECT_EQUAL( 1, mesh->GetCellLinks()->ElementAt( 9 ).count( 3 ) );
+
+  // the number of boundary features, through the cell objects
+  TEST_EXPECT_EQUAL( 4, mesh->GetNumberOfCellBoundaryFeatures( 1, 1 ) );
+
+  // invalid arrays
+  CellTypesContainer::Pointer        badTypes;
+  CellOffsetsContainer::Pointer      badOffsets;
+  CellConnectivityContainer::Pointer badConnectivity;
+  CreateArrays( badTypes, badOffsets, badConnectivity );
+  badOffsets->ElementAt( 4 ) = 13;
+  TRY_EXPECT_EXCEPTION( mesh->SetCellsArrays( badTypes, badOffsets, badConnectivity ) );
+  CreateArrays( badTypes, badOffsets, badConnectivity );
+  badTypes->ElementAt( 0 ) = CellType::QUADRILATERAL_CELL;
+  TRY_EXPECT_EXCEPTION( mesh->SetCellsArrays( badTypes, badOffsets, badConnectivity ) );
+  CreateArrays( badTypes, badOffsets, badConnectivity );
+  badOffsets->ElementAt( 2 ) = 2;
+  TRY_EXPECT_EXCEPTION( mesh->SetCellsArrays( badTypes, badOffsets, badConnectivity ) );
+  TEST_EXPECT_TRUE( CheckCells( mesh, types, offsets, connectivity ) );
+
+  // the mesh filters copy the arrays
+  typedef itk::TransformMeshFilter< MeshType, MeshType, itk::IdentityTransform< float, 3 > > FilterType;
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( mesh );
+  filter->SetTransform( itk::IdentityTransform< float, 3 >::New() );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  MeshType::Pointer copy = filter->GetOutput();
+  TEST_EXPECT_TRUE( copy->HasCellsArrays() );
+  TEST_EXPECT_TRUE( copy->GetCellTypesContainer() != types.GetPointer() );
+  TEST_EXPECT_TRUE( CheckCells( copy, types, offsets, connectivity ) );
+
+  MeshType::Pointer graft = MeshType::New();
+  graft->Graft( mesh );
+  TEST_EXPECT_TRUE( graft->HasCellsArrays() );
+  TEST_EXPECT_TRUE( CheckCells( graft, types, offsets, connectivity ) );
+
+  // GetCells moves the cells to the cells container, without modifying the
+  // mesh
+  const MeshType *            constGraft = graft;
+  const itk::ModifiedTimeType graftTime = graft->GetMTime();
+  TEST_EXPECT_EQUAL( 4, constGraft->GetCells()->Size() );
+  TEST_EXPECT_TRUE( !graft->HasCellsArrays() );
+  TEST_EXPECT_EQUAL( graftTime, graft->GetMTime() );
+  TEST_EXPECT_TRUE( CheckCells( graft, types, offsets, connectivity ) );
+  TEST_EXPECT_TRUE( mesh->HasCellsArrays() );
+
+  // the filters which iterate on the cells container see all the cells: the
+  // line is not connected to the largest region
+  MeshType::Pointer regionsInput = MeshType::New();
+  FillMesh( regionsInput );
+  regionsInput->SetCellsArrays( types, offsets, connectivity );
+  typedef itk::ConnectedRegionsMeshFilter< MeshType, MeshType > RegionsFilterType;
+  RegionsFilterType::Pointer regions = RegionsFilterType::New();
+  regions->SetInput( regionsInput );
+  regions->SetExtractionModeToLargestRegion();
+  TRY_EXPECT_NO_EXCEPTION( regions->Update() );
+  TEST_EXPECT_EQUAL( 3, regions->GetOutput()->GetNumberOfCells() );
+
+  // from the arrays to the cells container
+  mesh->ConvertCellsArraysToCells();
+  TEST_EXPECT_TRUE( !mesh->HasCellsArrays() );
+  TEST_EXPECT_EQUAL( 4, mesh->GetCells()->Size() );
+  TEST_EXPECT_TRUE( CheckCells( mesh, types, offsets, connectivity ) );
+
+  // SetCell moves the cells back to the cells container
+  copy->DisconnectPipeline();
+  line.TakeOwnership( new itk::LineCell< CellType > );
+  line->SetPointId( 0, 0 );
+  line->SetPointId( 1, 1 );
+  copy->SetCell( 4, line );
+  TEST_EXPECT_TRUE( !copy->HasCellsArrays() );
+  TEST_EXPECT_EQUAL( 5, copy->GetCells()->Size() );
+
+  // from the cells container to the arrays, the cell identifiers are
+  // renumbered in order
+  MeshType::Pointer sparse = MeshType::New();
+  FillMesh( sparse );
+  CellAutoPointer triangle;
+  triangle.TakeOwnership( new itk::TriangleCell< CellType > );
+  triangle->SetPointId( 0, 4 );
+  triangle->SetPointId( 1, 5 );
+  triangle->SetPointId( 2, 8 );
+  sparse->SetCell( 10, triangle );
+  sparse->SetCellData( 10, 2.5f );
+  CellAutoPointer quadrilateral;
+  quadrilateral.TakeOwnership( new itk::QuadrilateralCell< CellType > );
+  for( unsigned int i = 0; i < 4; ++i )
+    {
+    quadrilateral->SetPointId( i, i + 6 );
+    }
+  sparse->SetCell( 20, quadrilateral );
+  sparse->SetCellData( 20, 4.0f );
+  sparse->ConvertCellsToArrays();
+  TEST_EXPECT_TRUE( sparse->HasCellsArrays() );
+  TEST_EXPECT_EQUAL( 2, sparse->GetNumberOfCells() );
+  TEST_EXPECT_EQUAL( 7, sparse->GetCellConnectivityContainer()->Size() );
+  float cellData = 0.0f;
+  TEST_EXPECT_TRUE( sparse->GetCellData( 1, &cellData ) );
+  TEST_EXPECT_EQUAL( 4.0f, cellData );
+
+  CellViewType view;
+  TEST_EXPECT_TRUE( sparse->GetCellView( 1, view ) );
+  TEST_EXPECT_EQUAL( CellType::QUADRILATERAL_CELL, view.GetType() );
+  TEST_EXPECT_EQUAL( 9, view.GetPointId( 3 ) );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
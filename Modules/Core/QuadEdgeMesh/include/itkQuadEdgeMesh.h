@@ -202,6 +202,11 @@ public:
   typedef typename Superclass::BoundaryAssignmentsContainerVector
   BoundaryAssignmentsContainerVector;
 
+  // Cells arrays section:
+  typedef typename Superclass::CellTypesContainer        CellTypesContainer;
+  typedef typename Superclass::CellOffsetsContainer      CellOffsetsContainer;
+  typedef typename Superclass::CellConnectivityContainer CellConnectivityContainer;
+
   // Miscellaneous section:
   typedef typename Superclass::BoundingBoxPointer BoundingBoxPointer;
   typedef typename Superclass::BoundingBoxType    BoundingBoxType;
@@ -224,6 +229,7 @@ public:
   /** Possible specialized cell types. */
   typedef QuadEdgeMeshLineCell< CellType >    EdgeCellType;
   typedef QuadEdgeMeshPolygonCell< CellType > PolygonCellType;
+  typedef typename EdgeCellType::QuadEdgeStoreType EdgeStoreType;
 
   /** Free insertion indexes. */
   typedef std::queue< PointIdentifier > FreePointIndexesType;
@@ -393,6 +399,28 @@ public:
   /** overloaded method for backward compatibility */
   void SetCell(CellIdentifier cId, CellAutoPointer & cell);
 
+  /** Add the edges and the faces of cells stored in arrays, as SetCell()
+   * does for each cell: the arrays are not kept, since the quad-edge
+   * structure is the storage of the cells. */
+  void SetCellsArrays(CellTypesContainer *types,
+                      CellOffsetsContainer *offsets,
+                      CellConnectivityContainer *connectivity);
+
+  /** The cells of a QuadEdgeMesh cannot be stored in arrays: this method
+   * throws an exception. */
+  void ConvertCellsToArrays();
+
+  /** Allocate the quad-edges of the new edges in blocks, which are reused
+   * when edges are deleted, instead of one by one. This speeds up the
+   * construction and the modification of large meshes. Off by default. */
+  itkSetMacro(UsePooledEdges, bool);
+  itkGetConstMacro(UsePooledEdges, bool);
+  itkBooleanMacro(UsePooledEdges);
+
+  /** Create a new edge cell, with its quad-edges borrowed from the store of
+   * the mesh if UsePooledEdges is on. */
+  virtual EdgeCellType * CreateEdgeCell();
+
   /** Methods to simplify point/edge insertion/search. */
   virtual PointIdentifier FindFirstUnusedPointIndex();
 
@@ -513,6 +541,9 @@ private:
   CellIdentifier m_NumberOfFaces;
   CellIdentifier m_NumberOfEdges;
 
+  bool                             m_UsePooledEdges;
+  typename EdgeStoreType::Pointer  m_EdgeStore;
+
 protected:
   FreePointIndexesType m_FreePointIndexes;
   FreeCellIndexesType  m_FreeCellIndexes;
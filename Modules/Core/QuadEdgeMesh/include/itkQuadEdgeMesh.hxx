@@ -419,6 +419,87 @@ void QuadEdgeMesh< TPixel, VDimension, TTraits >
     }
 }
 
+/**
+ */
+template< typename TPixel, unsigned int VDimension, typename TTraits >
+void
+QuadEdgeMesh< TPixel, VDimension, TTraits >
+::SetCellsArrays(CellTypesContainer *types,
+                 CellOffsetsContainer *offsets,
+                 CellConnectivityContainer *connectivity)
+{
+  if ( !types || !offsets || !connectivity )
+    {
+    itkExceptionMacro("The cells arrays are not set.");
+    }
+  const CellIdentifier numberOfCells = types->Size();
+  if ( offsets->Size() != numberOfCells + 1
+       || offsets->ElementAt(numberOfCells) != connectivity->Size() )
+    {
+    itkExceptionMacro("The cells offsets do not match the cells arrays.");
+    }
+
+  PointIdList points;
+  for ( CellIdentifier cellId = 0; cellId < numberOfCells; ++cellId )
+    {
+    const CellIdentifier begin = offsets->ElementAt(cellId);
+    const CellIdentifier end = offsets->ElementAt(cellId + 1);
+    if ( end < begin )
+      {
+      itkExceptionMacro("The cells offsets are not sorted.");
+      }
+    // Edge
+    if ( end - begin == 2 )
+      {
+      this->AddEdge( connectivity->ElementAt(begin + 1),
+                     connectivity->ElementAt(begin) );
+      continue;
+      }
+    // polygons
+    switch ( types->ElementAt(cellId) )
+      {
+      case CellType::TRIANGLE_CELL:
+      case CellType::QUADRILATERAL_CELL:
+      case CellType::POLYGON_CELL:
+      case CellType::QUADRATIC_TRIANGLE_CELL:
+        points.assign( connectivity->CastToSTLConstContainer().begin() + begin,
+                       connectivity->CastToSTLConstContainer().begin() + end );
+        this->AddFace(points);
+        break;
+      default:
+        break;
+      }
+    }
+}
+
+/**
+ */
+template< typename TPixel, unsigned int VDimension, typename TTraits >
+void
+QuadEdgeMesh< TPixel, VDimension, TTraits >
+::ConvertCellsToArrays()
+{
+  itkExceptionMacro("The cells of a QuadEdgeMesh cannot be stored in arrays.");
+}
+
+/**
+ */
+template< typename TPixel, unsigned int VDimension, typename TTraits >
+typename QuadEdgeMesh< TPixel, VDimension, TTraits >::EdgeCellType *
+QuadEdgeMesh< TPixel, VDimension, TTraits >
+::CreateEdgeCell()
+{
+  if ( !m_UsePooledEdges )
+    {
+    return new EdgeCellType;
+    }
+  if ( m_EdgeStore.IsNull() )
+    {
+    m_EdgeStore = EdgeStoreType::New();
+    }
+  return new EdgeCellType(m_EdgeStore);
+}
+
 /**
  */
 template< typename TPixel, unsigned int VDimension, typename TTraits >
@@ -721,7 +802,7 @@ QuadEdgeMesh< TPixel, VDimension, TTraits >
   QEPrimal *eDestination  = pDestination.GetEdge();
 
   // Ok, there's room and the points exist
-  EdgeCellType *newEdge = new EdgeCellType();
+  EdgeCellType *newEdge = this->CreateEdgeCell();
   QEPrimal *    newEdgeGeom = newEdge->GetQEGeom();
 
   newEdgeGeom->SetOrigin (orgPid);
@@ -1409,7 +1490,7 @@ QuadEdgeMesh< TPixel, VDimension, TTraits >
  */
 template< typename TPixel, unsigned int VDimension, typename TTraits >
 QuadEdgeMesh< TPixel, VDimension, TTraits >
-::QuadEdgeMesh():m_NumberOfFaces(0), m_NumberOfEdges(0)
+::QuadEdgeMesh():m_NumberOfFaces(0), m_NumberOfEdges(0), m_UsePooledEdges(false)
 {
   m_EdgeCellsContainer = CellsContainer::New();
 }
@@ -20,6 +20,7 @@
 
 #include "itkAutoPointer.h"
 #include "itkGeometricalQuadEdge.h"
+#include "itkObjectStore.h"
 
 namespace itk
 {
@@ -31,6 +32,10 @@ namespace itk
  * \param TCellInterface Basic type for the itk*Cell.
  *        This usually comes from the MeshTraits.
  *
+ * The four quad-edges of the edge are allocated one by one, or together
+ * in a block borrowed from a QuadEdgeStoreType, which allocates the blocks
+ * of many edges at once and reuses the blocks of the deleted edges.
+ *
  * \author  Eric Boix, Alex Gouaillard, Leonardo Florez
  *
  * \ingroup ITKQuadEdgeMesh
@@ -89,6 +94,15 @@ public:
   typedef typename QEType::DualDataType      DualDataType;
   typedef typename QEType::DualType          QEDual;
 
+  /** The four quad-edges of an edge, allocated together. */
+  struct QuadEdgeBlock
+  {
+    QEType Primal[2];
+    QEDual Dual[2];
+  };
+  typedef ObjectStore< QuadEdgeBlock >          QuadEdgeStoreType;
+  typedef typename QuadEdgeStoreType::Pointer QuadEdgeStorePointer;
+
 public:
   /** Standard part of every itk Object. */
   itkTypeMacro(QuadEdgeMeshLineCell, TCellInterface);
@@ -99,6 +113,9 @@ public:
 public:
   /** Object memory management methods. */
   QuadEdgeMeshLineCell();
+  /** Borrow the quad-edges from a store, which is kept alive until the
+   * cell is deleted. */
+  QuadEdgeMeshLineCell(QuadEdgeStoreType *store);
   virtual ~QuadEdgeMeshLineCell();
 
   /** Accessors for m_Identifier. */
@@ -207,6 +224,13 @@ private:
   CellIdentifier          m_Identifier;
   QEType *                m_QuadEdgeGeom;
   mutable PointIdentifier m_PointIds[2];
+
+  /** The store and the block of the quad-edges, if they were borrowed. */
+  QuadEdgeStorePointer m_QuadEdgeStore;
+  QuadEdgeBlock *      m_QuadEdgeBlock;
+
+  /** Connect the quad-edges of the edge. */
+  void ConnectQuadEdges(QEType *e0, QEDual *e1, QEType *e2, QEDual *e3);
 };
 } // end namespace itk
 
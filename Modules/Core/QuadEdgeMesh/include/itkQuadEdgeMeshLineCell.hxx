@@ -29,16 +29,42 @@ QuadEdgeMeshLineCell< TCellInterface >
 ::QuadEdgeMeshLineCell()
 {
   m_Identifier = 0;
+  m_QuadEdgeBlock = ITK_NULLPTR;
   m_QuadEdgeGeom = new QEType;
 
   QEType *e2 = new QEType;
   QEDual *e1 = new QEDual;
   QEDual *e3 = new QEDual;
-  this->m_QuadEdgeGeom->SetRot(e1);
+  this->ConnectQuadEdges(this->m_QuadEdgeGeom, e1, e2, e3);
+}
+
+// ---------------------------------------------------------------------
+template< typename TCellInterface >
+QuadEdgeMeshLineCell< TCellInterface >
+::QuadEdgeMeshLineCell(QuadEdgeStoreType *store)
+{
+  m_Identifier = 0;
+  m_QuadEdgeStore = store;
+  m_QuadEdgeBlock = store->Borrow();
+
+  // The block may have been used by a deleted edge.
+  *m_QuadEdgeBlock = QuadEdgeBlock();
+  m_QuadEdgeGeom = &m_QuadEdgeBlock->Primal[0];
+  this->ConnectQuadEdges(m_QuadEdgeGeom, &m_QuadEdgeBlock->Dual[0],
+                         &m_QuadEdgeBlock->Primal[1], &m_QuadEdgeBlock->Dual[1]);
+}
+
+// ---------------------------------------------------------------------
+template< typename TCellInterface >
+void
+QuadEdgeMeshLineCell< TCellInterface >
+::ConnectQuadEdges(QEType *e0, QEDual *e1, QEType *e2, QEDual *e3)
+{
+  e0->SetRot(e1);
   e1->SetRot(e2);
   e2->SetRot(e3);
-  e3->SetRot(this->m_QuadEdgeGeom);
-  this->m_QuadEdgeGeom->SetOnext(this->m_QuadEdgeGeom);
+  e3->SetRot(e0);
+  e0->SetOnext(e0);
   e1->SetOnext(e3);
   e2->SetOnext(e2);
   e3->SetOnext(e1);
@@ -57,6 +83,12 @@ QuadEdgeMeshLineCell< TCellInterface >
   //  m_QuadEdgeGeom->Disconnect( );
   //  }
 
+  if ( m_QuadEdgeBlock )
+    {
+    m_QuadEdgeStore->Return(m_QuadEdgeBlock);
+    return;
+    }
+
   bool FoundNullPointer = false;
 
   if ( m_QuadEdgeGeom )
@@ -0,0 +1,179 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkQuadEdgeMesh.h"
+#include "itkQuadEdgeMeshEulerOperatorSplitFacetFunction.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+typedef itk::QuadEdgeMesh< double, 3 > MeshType;
+
+const unsigned int GridSize = 12;
+
+// The cells of a grid of points: a quadrilateral, or two triangles, in each
+// square, and a line along the first row.
+void
+CreateGrid( MeshType * mesh )
+{
+  for( unsigned int i = 0; i < GridSize * GridSize; ++i )
+    {
+    MeshType::PointType point;
+    point[0] = i % GridSize;
+    point[1] = i / GridSize;
+    point[2] = 0.0;
+    mesh->SetPoint( i, point );
+    }
+
+  MeshType::CellTypesContainer::Pointer        types = MeshType::CellTypesContainer::New();
+  MeshType::CellOffsetsContainer::Pointer      offsets = MeshType::CellOffsetsContainer::New();
+  MeshType::CellConnectivityContainer::Pointer connectivity = MeshType::CellConnectivityContainer::New();
+  MeshType::CellTypesContainer::STLContainerType &        cellTypes = types->CastToSTLContainer();
+  MeshType::CellOffsetsContainer::STLContainerType &      cellOffsets = offsets->CastToSTLContainer();
+  MeshType::CellConnectivityContainer::STLContainerType & cellPoints = connectivity->CastToSTLContainer();
+  for( unsigned int y = 0; y + 1 < GridSize; ++y )
+    {
+    for( unsigned int x = 0; x + 1 < GridSize; ++x )
+      {
+      const MeshType::PointIdentifier p = y * GridSize + x;
+      if( ( x + y ) % 2 )
+        {
+        cellTypes.push_back( MeshType::CellType::QUADRILATERAL_CELL );
+        cellOffsets.push_back( cellPoints.size() );
+        cellPoints.push_back( p );
+        cellPoints.push_back( p + 1 );
+        cellPoints.push_back( p + GridSize + 1 );
+        cellPoints.push_back( p + GridSize );
+        }
+      else
+        {
+        cellTypes.push_back( MeshType::CellType::TRIANGLE_CELL );
+        cellOffsets.push_back( cellPoints.size() );
+        cellPoints.push_back( p );
+        cellPoints.push_back( p + 1 );
+        cellPoints.push_back( p + GridSize + 1 );
+        cellTypes.push_back( MeshType::CellType::TRIANGLE_CELL );
+        cellOffsets.push_back( cellPoints.size() );
+        cellPoints.push_back( p );
+        cellPoints.push_back( p + GridSize + 1 );
+        cellPoints.push_back( p + GridSize );
+        }
+      }
+    }
+  cellTypes.push_back( MeshType::CellType::LINE_CELL );
+  cellOffsets.push_back( cellPoints.size() );
+  cellPoints.push_back( 0 );
+  cellPoints.push_back( 1 );
+  cellOffsets.push_back( cellPoints.size() );
+
+  mesh->SetCellsArrays( types, offsets, connectivity );
+}
+
+// Build the grid, split and delete some faces, and return the number of
+// faces and edges.
+bool
+EditGrid( bool usePooledEdges, MeshType::CellIdentifier & numberOfFaces, MeshType::CellIdentifier & numberOfEdges )
+{
+  MeshType::Pointer mesh = MeshType::New();
+  mesh->SetUsePooledEdges( usePooledEdges );
+  CreateGrid( mesh );
+  std::cout << ( usePooledEdges ? "Pooled edges: " : "Edges allocated one by one: " ) << mesh->GetNumberOfFaces()
+            << " faces, " << mesh->GetNumberOfEdges() << " edges" << std::endl;
+
+  // split the quadrilaterals along a diagonal
+  typedef itk::QuadEdgeMeshEulerOperatorSplitFacetFunction< MeshType, MeshType::QEType > SplitFacetType;
+  SplitFacetType::Pointer splitFacet = SplitFacetType::New();
+  splitFacet->SetInput( mesh );
+  for( unsigned int y = 0; y + 1 < GridSize; ++y )
+    {
+    for( unsigned int x = 0; x + 1 < GridSize; ++x )
+      {
+      if( ( x + y ) % 2 )
+        {
+        const MeshType::PointIdentifier p = y * GridSize + x;
+        MeshType::QEType *              h = mesh->FindEdge( p, p + 1 );
+        MeshType::QEType *              g = mesh->FindEdge( p + GridSize + 1, p + GridSize );
+        if( !h || !g || !splitFacet->Evaluate( h, g ) )
+          {
+          std::cerr << "Cannot split the face at " << p << std::endl;
+          return false;
+          }
+        }
+      }
+    }
+
+  // delete the diagonals of the last row of squares, and the blocks of
+  // their quad-edges are reused by the new edges
+  std::vector< std::pair< MeshType::PointIdentifier, MeshType::PointIdentifier > > diagonals;
+  for( unsigned int x = 0; x + 1 < GridSize; ++x )
+    {
+    const unsigned int              y = GridSize - 2;
+    const MeshType::PointIdentifier p = y * GridSize + x;
+    if( ( x + y ) % 2 )
+      {
+      diagonals.push_back( std::make_pair( p + 1, p + GridSize ) );
+      }
+    else
+      {
+      diagonals.push_back( std::make_pair( p, p + GridSize + 1 ) );
+      }
+    mesh->LightWeightDeleteEdge( mesh->FindEdge( diagonals.back().first, diagonals.back().second ) );
+    }
+  for( size_t i = 0; i < diagonals.size(); ++i )
+    {
+    if( !mesh->AddEdge( diagonals[i].first, diagonals[i].second ) )
+      {
+      std::cerr << "Cannot add the edge " << diagonals[i].first << " " << diagonals[i].second << std::endl;
+      return false;
+      }
+    }
+
+  numberOfFaces = mesh->GetNumberOfFaces();
+  numberOfEdges = mesh->GetNumberOfEdges();
+  return numberOfFaces == mesh->ComputeNumberOfFaces() && numberOfEdges == mesh->ComputeNumberOfEdges();
+}
+}
+
+// Build and edit a mesh with the quad-edges of the edges allocated one by
+// one, and in blocks, and compare the results.
+int itkQuadEdgeMeshPooledEdgesTest( int, char* [] )
+{
+  MeshType::Pointer mesh = MeshType::New();
+  TEST_SET_GET_BOOLEAN( mesh, UsePooledEdges, false );
+  TRY_EXPECT_EXCEPTION( mesh->ConvertCellsToArrays() );
+
+  CreateGrid( mesh );
+  TEST_EXPECT_TRUE( !mesh->HasCellsArrays() );
+  const MeshType::CellIdentifier numberOfSquares = ( GridSize - 1 ) * ( GridSize - 1 );
+  const MeshType::CellIdentifier numberOfSplitSquares = ( numberOfSquares + 1 ) / 2;
+  TEST_EXPECT_EQUAL( numberOfSquares + numberOfSplitSquares, mesh->GetNumberOfFaces() );
+  TEST_EXPECT_EQUAL( 2 * GridSize * ( GridSize - 1 ) + numberOfSplitSquares, mesh->GetNumberOfEdges() );
+
+  MeshType::CellIdentifier numberOfFaces = 0;
+  MeshType::CellIdentifier numberOfEdges = 0;
+  TEST_EXPECT_TRUE( EditGrid( false, numberOfFaces, numberOfEdges ) );
+  MeshType::CellIdentifier numberOfPooledFaces = 0;
+  MeshType::CellIdentifier numberOfPooledEdges = 0;
+  TEST_EXPECT_TRUE( EditGrid( true, numberOfPooledFaces, numberOfPooledEdges ) );
+  TEST_EXPECT_EQUAL( numberOfFaces, numberOfPooledFaces );
+  TEST_EXPECT_EQUAL( numberOfEdges, numberOfPooledEdges );
+  TEST_EXPECT_EQUAL( 2 * numberOfSquares - 2 * ( GridSize - 1 ), numberOfFaces );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
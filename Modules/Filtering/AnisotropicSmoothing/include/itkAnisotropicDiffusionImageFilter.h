@@ -98,6 +98,9 @@ public:
   typedef typename Superclass::PixelType    PixelType;
   typedef typename Superclass::TimeStepType TimeStepType;
 
+  /** The type of the function of the filter. */
+  typedef AnisotropicDiffusionFunction< UpdateBufferType > AnisotropicDiffusionFunctionType;
+
   /** Set/Get the time step for each iteration */
   itkSetMacro(TimeStep, TimeStepType);
   itkGetConstMacro(TimeStep, TimeStepType);
@@ -145,6 +148,12 @@ protected:
   /** Prepare for the iteration process. */
   virtual void InitializeIteration() ITK_OVERRIDE;
 
+  /** Compute the average gradient magnitude squared of the output, which
+   * scales the conductance of the function.  It is called by
+   * InitializeIteration() every ConductanceScalingUpdateInterval iterations,
+   * unless the average gradient magnitude is fixed. */
+  virtual void CalculateAverageGradientMagnitudeSquared(AnisotropicDiffusionFunctionType *f);
+
   bool m_GradientMagnitudeIsFixed;
 
 private:
@@ -44,8 +44,8 @@ void
 AnisotropicDiffusionImageFilter< TInputImage, TOutputImage >
 ::InitializeIteration()
 {
-  AnisotropicDiffusionFunction< UpdateBufferType > *f =
-    dynamic_cast< AnisotropicDiffusionFunction< UpdateBufferType > * >
+  AnisotropicDiffusionFunctionType *f =
+    dynamic_cast< AnisotropicDiffusionFunctionType * >
     ( this->GetDifferenceFunction().GetPointer() );
   if ( !f )
     {
@@ -86,7 +86,7 @@ AnisotropicDiffusionImageFilter< TInputImage, TOutputImage >
     {
     if ( ( this->GetElapsedIterations() % m_ConductanceScalingUpdateInterval ) == 0 )
       {
-      f->CalculateAverageGradientMagnitudeSquared( this->GetOutput() );
+      this->CalculateAverageGradientMagnitudeSquared(f);
       }
     }
   else
@@ -108,6 +108,14 @@ AnisotropicDiffusionImageFilter< TInputImage, TOutputImage >
     }
 }
 
+template< typename TInputImage, typename TOutputImage >
+void
+AnisotropicDiffusionImageFilter< TInputImage, TOutputImage >
+::CalculateAverageGradientMagnitudeSquared(AnisotropicDiffusionFunctionType *f)
+{
+  f->CalculateAverageGradientMagnitudeSquared( this->GetOutput() );
+}
+
 template< typename TInputImage, typename TOutputImage >
 void
 AnisotropicDiffusionImageFilter< TInputImage, TOutputImage >
@@ -39,6 +39,14 @@ namespace itk
  * Please see the description of parameters given in
  * itkAnisotropicDiffusionImageFilter.
  *
+ * \par Fused iterations
+ * When UseFusedIteration is on, the change over the pixels away from the
+ * boundary is computed along scanlines from direct offsets in the output
+ * buffer, with the real type of the pixels (float for float images), and the
+ * average gradient magnitude needed by the next iteration is accumulated
+ * while the update is applied, instead of in a separate pass over the
+ * output.  The result only differs from the default by rounding.
+ *
  * \sa AnisotropicDiffusionImageFilter
  * \sa AnisotropicDiffusionFunction
  * \sa GradientAnisotropicDiffusionFunction
@@ -66,11 +74,24 @@ public:
                AnisotropicDiffusionImageFilter);
 
   /** Extract information from the superclass. */
-  typedef typename Superclass::UpdateBufferType UpdateBufferType;
+  typedef typename Superclass::UpdateBufferType                 UpdateBufferType;
+  typedef typename Superclass::PixelType                        PixelType;
+  typedef typename Superclass::TimeStepType                     TimeStepType;
+  typedef typename Superclass::AnisotropicDiffusionFunctionType AnisotropicDiffusionFunctionType;
+
+  /** The type of the function of the filter. */
+  typedef GradientNDAnisotropicDiffusionFunction< UpdateBufferType > GradientFunctionType;
 
   /** Extract information from the superclass. */
   itkStaticConstMacro(ImageDimension, unsigned int, Superclass::ImageDimension);
 
+  /** Set/Get whether the iterations compute the change along scanlines and
+   * accumulate the average gradient magnitude while applying the update.
+   * Off by default. */
+  itkSetMacro(UseFusedIteration, bool);
+  itkGetConstMacro(UseFusedIteration, bool);
+  itkBooleanMacro(UseFusedIteration);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro( UpdateBufferHasNumericTraitsCheck,
@@ -79,18 +100,61 @@ public:
 #endif
 
 protected:
-  GradientAnisotropicDiffusionImageFilter()
-  {
-    typename GradientNDAnisotropicDiffusionFunction< UpdateBufferType >::Pointer p =
-      GradientNDAnisotropicDiffusionFunction< UpdateBufferType >::New();
-    this->SetDifferenceFunction(p);
-  }
-
+  GradientAnisotropicDiffusionImageFilter();
   ~GradientAnisotropicDiffusionImageFilter() {}
+  void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
+
+  typedef typename Superclass::ThreadRegionType ThreadRegionType;
+
+  /** Compute the change along scanlines when UseFusedIteration is on. */
+  virtual TimeStepType ThreadedCalculateChange(const ThreadRegionType & regionToProcess,
+                                               ThreadIdType threadId) ITK_OVERRIDE;
+
+  /** Accumulate the average gradient magnitude of the updated output when
+   * UseFusedIteration is on and the next iteration needs it. */
+  virtual void ApplyUpdate(const TimeStepType & dt) ITK_OVERRIDE;
+
+  /** Apply the update one slice at a time, accumulating the gradient
+   * magnitude of the slices whose neighbors are updated by the same
+   * thread. */
+  virtual void ThreadedApplyUpdate(const TimeStepType & dt,
+                                   const ThreadRegionType & regionToProcess,
+                                   ThreadIdType threadId) ITK_OVERRIDE;
+
+  /** Use the average gradient magnitude accumulated by the last update,
+   * when available. */
+  virtual void CalculateAverageGradientMagnitudeSquared(AnisotropicDiffusionFunctionType *f) ITK_OVERRIDE;
+
+  /** Add the squared gradient magnitudes of the output over a region. */
+  void AccumulateGradientMagnitudeSquared(const ThreadRegionType & region,
+                                          double & sum,
+                                          SizeValueType & count);
 
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(GradientAnisotropicDiffusionImageFilter);
+
+  /** The function of the filter, or ITK_NULLPTR if it has been replaced. */
+  GradientFunctionType * GetGradientFunction();
+
+  bool m_UseFusedIteration;
+
+  /** The state of the accumulation of the gradient magnitude during the
+   * update: the sums and counts of each thread, and the regions left to
+   * accumulate once all the threads are done. */
+  bool                                           m_AccumulateGradientMagnitude;
+  std::vector< double >                          m_GradientMagnitudeSums;
+  std::vector< SizeValueType >                   m_GradientMagnitudeCounts;
+  std::vector< std::vector< ThreadRegionType > > m_DeferredGradientMagnitudeRegions;
+
+  /** The average gradient magnitude squared of the output after the last
+   * update, and the iteration it was computed for. */
+  double         m_AverageGradientMagnitudeSquared;
+  IdentifierType m_AverageGradientMagnitudeSquaredIteration;
 };
 } // end namspace itk
 
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkGradientAnisotropicDiffusionImageFilter.hxx"
+#endif
+
 #endif
@@ -0,0 +1,308 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkGradientAnisotropicDiffusionImageFilter_hxx
+#define itkGradientAnisotropicDiffusionImageFilter_hxx
+
+#include "itkGradientAnisotropicDiffusionImageFilter.h"
+#include "itkImageScanlineIterator.h"
+#include "itkNeighborhoodAlgorithm.h"
+
+namespace itk
+{
+template< typename TInputImage, typename TOutputImage >
+GradientAnisotropicDiffusionImageFilter< TInputImage, TOutputImage >
+::GradientAnisotropicDiffusionImageFilter() :
+  m_UseFusedIteration( false ),
+  m_AccumulateGradientMagnitude( false ),
+  m_AverageGradientMagnitudeSquared( 0.0 ),
+  m_AverageGradientMagnitudeSquaredIteration( 0 )
+{
+  typename GradientFunctionType::Pointer p = GradientFunctionType::New();
+  this->SetDifferenceFunction(p);
+}
+
+template< typename TInputImage, typename TOutputImage >
+typename GradientAnisotropicDiffusionImageFilter< TInputImage, TOutputImage >::GradientFunctionType *
+GradientAnisotropicDiffusionImageFilter< TInputImage, TOutputImage >
+::GetGradientFunction()
+{
+  return dynamic_cast< GradientFunctionType * >( this->GetDifferenceFunction().GetPointer() );
+}
+
+template< typename TInputImage, typename TOutputImage >
+typename GradientAnisotropicDiffusionImageFilter< TInputImage, TOutputImage >::TimeStepType
+GradientAnisotropicDiffusionImageFilter< TInputImage, TOutputImage >
+::ThreadedCalculateChange(const ThreadRegionType & regionToProcess, ThreadIdType threadId)
+{
+  GradientFunctionType *f = this->GetGradientFunction();
+  if ( !m_UseFusedIteration || !f )
+    {
+    return Superclass::ThreadedCalculateChange(regionToProcess, threadId);
+    }
+
+  typedef NeighborhoodAlgorithm::ImageBoundaryFacesCalculator< UpdateBufferType > FaceCalculatorType;
+  typedef typename FaceCalculatorType::FaceListType                               FaceListType;
+
+  UpdateBufferType *output = this->GetOutput();
+  UpdateBufferType *update = this->GetUpdateBuffer();
+
+  FaceCalculatorType faceCalculator;
+  FaceListType       faceList = faceCalculator(output, regionToProcess, f->GetRadius());
+
+  typename FaceListType::iterator fIt = faceList.begin();
+
+  // The pixels away from the boundary are processed along scanlines.  The
+  // update buffer has the same buffered region as the output.
+  const PixelType *outputBuffer = output->GetBufferPointer();
+  PixelType       *updateBuffer = update->GetBufferPointer();
+
+  OffsetValueType offsets[ImageDimension];
+  for ( unsigned int i = 0; i < ImageDimension; ++i )
+    {
+    offsets[i] = output->GetOffsetTable()[i];
+    }
+
+  if ( fIt->GetNumberOfPixels() > 0 )
+    {
+    const SizeValueType lineLength = fIt->GetSize(0);
+
+    ImageScanlineConstIterator< UpdateBufferType > it(output, *fIt);
+    while ( !it.IsAtEnd() )
+      {
+      const PixelType *center = &it.Value();
+      f->ComputeUpdateAlongScanline( center, offsets, lineLength,
+                                     updateBuffer + ( center - outputBuffer ) );
+      it.NextLine();
+      }
+    }
+
+  // The boundary faces go through the neighborhood iterators.
+  for ( ++fIt; fIt != faceList.end(); ++fIt )
+    {
+    Superclass::ThreadedCalculateChange(*fIt, threadId);
+    }
+
+  void *globalData = f->GetGlobalDataPointer();
+  const TimeStepType timeStep = f->ComputeGlobalTimeStep(globalData);
+  f->ReleaseGlobalDataPointer(globalData);
+
+  return timeStep;
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+GradientAnisotropicDiffusionImageFilter< TInputImage, TOutputImage >
+::ApplyUpdate(const TimeStepType & dt)
+{
+  m_AverageGradientMagnitudeSquaredIteration = 0;
+
+  // The average gradient magnitude is only accumulated when the next
+  // iteration, if any, scales the conductance with it.
+  const IdentifierType nextIteration = this->GetElapsedIterations() + 1;
+  m_AccumulateGradientMagnitude = m_UseFusedIteration
+                                  && this->GetGradientFunction() != ITK_NULLPTR
+                                  && !this->GetUseActiveTiles()
+                                  && !this->m_GradientMagnitudeIsFixed
+                                  && nextIteration < this->GetNumberOfIterations()
+                                  && ( nextIteration % this->GetConductanceScalingUpdateInterval() ) == 0;
+
+  if ( m_AccumulateGradientMagnitude )
+    {
+    const ThreadIdType numberOfThreads = this->GetNumberOfThreads();
+    m_GradientMagnitudeSums.assign( numberOfThreads, 0.0 );
+    m_GradientMagnitudeCounts.assign( numberOfThreads, 0 );
+    m_DeferredGradientMagnitudeRegions.assign( numberOfThreads, std::vector< ThreadRegionType >() );
+    }
+
+  Superclass::ApplyUpdate(dt);
+
+  if ( m_AccumulateGradientMagnitude )
+    {
+    double        sum = 0.0;
+    SizeValueType count = 0;
+    for ( size_t t = 0; t < m_GradientMagnitudeSums.size(); ++t )
+      {
+      sum += m_GradientMagnitudeSums[t];
+      count += m_GradientMagnitudeCounts[t];
+      for ( size_t r = 0; r < m_DeferredGradientMagnitudeRegions[t].size(); ++r )
+        {
+        this->AccumulateGradientMagnitudeSquared(m_DeferredGradientMagnitudeRegions[t][r], sum, count);
+        }
+      }
+    if ( count > 0 )
+      {
+      m_AverageGradientMagnitudeSquared = sum / count;
+      m_AverageGradientMagnitudeSquaredIteration = nextIteration;
+      }
+    m_AccumulateGradientMagnitude = false;
+    }
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+GradientAnisotropicDiffusionImageFilter< TInputImage, TOutputImage >
+::ThreadedApplyUpdate(const TimeStepType & dt,
+                      const ThreadRegionType & regionToProcess,
+                      ThreadIdType threadId)
+{
+  if ( !m_AccumulateGradientMagnitude )
+    {
+    Superclass::ThreadedApplyUpdate(dt, regionToProcess, threadId);
+    return;
+    }
+
+  const ThreadRegionType & bufferedRegion = this->GetOutput()->GetBufferedRegion();
+
+  // The slices are taken along the slowest dimension of the buffer.  The
+  // gradient of a slice can only be accumulated here if the thread updates
+  // the whole slice and the neighbor slices.
+  unsigned int sliceDimension = ImageDimension - 1;
+  while ( sliceDimension > 0 && bufferedRegion.GetSize(sliceDimension) == 1 )
+    {
+    --sliceDimension;
+    }
+  for ( unsigned int d = 0; d < ImageDimension; ++d )
+    {
+    if ( d != sliceDimension
+         && ( regionToProcess.GetIndex(d) != bufferedRegion.GetIndex(d)
+              || regionToProcess.GetSize(d) != bufferedRegion.GetSize(d) ) )
+      {
+      Superclass::ThreadedApplyUpdate(dt, regionToProcess, threadId);
+      m_DeferredGradientMagnitudeRegions[threadId].push_back(regionToProcess);
+      return;
+      }
+    }
+
+  const IndexValueType first = regionToProcess.GetIndex(sliceDimension);
+  const IndexValueType last = first + static_cast< IndexValueType >( regionToProcess.GetSize(sliceDimension) ) - 1;
+  const IndexValueType bufferedFirst = bufferedRegion.GetIndex(sliceDimension);
+  const IndexValueType bufferedLast =
+    bufferedFirst + static_cast< IndexValueType >( bufferedRegion.GetSize(sliceDimension) ) - 1;
+
+  ThreadRegionType slice = regionToProcess;
+  slice.SetSize(sliceDimension, 1);
+
+  double &        sum = m_GradientMagnitudeSums[threadId];
+  SizeValueType & count = m_GradientMagnitudeCounts[threadId];
+
+  // Each slice is accumulated right after the next one is updated.
+  for ( IndexValueType z = first; z <= last + 1; ++z )
+    {
+    if ( z <= last )
+      {
+      slice.SetIndex(sliceDimension, z);
+      Superclass::ThreadedApplyUpdate(dt, slice, threadId);
+      }
+
+    const IndexValueType previous = z - 1;
+    if ( previous < first )
+      {
+      continue;
+      }
+    slice.SetIndex(sliceDimension, previous);
+    if ( ( previous == bufferedFirst || previous > first )
+         && ( previous == bufferedLast || previous < last ) )
+      {
+      this->AccumulateGradientMagnitudeSquared(slice, sum, count);
+      }
+    else
+      {
+      m_DeferredGradientMagnitudeRegions[threadId].push_back(slice);
+      }
+    }
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+GradientAnisotropicDiffusionImageFilter< TInputImage, TOutputImage >
+::AccumulateGradientMagnitudeSquared(const ThreadRegionType & region,
+                                     double & sum,
+                                     SizeValueType & count)
+{
+  typedef typename GradientFunctionType::PixelRealType PixelRealType;
+
+  const UpdateBufferType *output = this->GetOutput();
+  const ThreadRegionType &bufferedRegion = output->GetBufferedRegion();
+  const PixelType *       outputBuffer = output->GetBufferPointer();
+
+  // Same central differences and zero flux boundary condition as
+  // ScalarAnisotropicDiffusionFunction::CalculateAverageGradientMagnitudeSquared
+  PixelRealType scales[ImageDimension];
+  this->GetGradientFunction()->GetScaleCoefficients(scales);
+
+  OffsetValueType offsets[ImageDimension];
+  IndexValueType  starts[ImageDimension];
+  IndexValueType  ends[ImageDimension];
+  for ( unsigned int i = 0; i < ImageDimension; ++i )
+    {
+    offsets[i] = output->GetOffsetTable()[i];
+    starts[i] = bufferedRegion.GetIndex(i);
+    ends[i] = starts[i] + static_cast< IndexValueType >( bufferedRegion.GetSize(i) ) - 1;
+    }
+
+  const SizeValueType lineLength = region.GetSize(0);
+
+  ImageScanlineConstIterator< UpdateBufferType > it(output, region);
+  while ( !it.IsAtEnd() )
+    {
+    typename UpdateBufferType::IndexType index = it.GetIndex();
+    const PixelType *center = outputBuffer + output->ComputeOffset(index);
+    for ( SizeValueType n = 0; n < lineLength; ++n, ++index[0], ++center )
+      {
+      for ( unsigned int i = 0; i < ImageDimension; ++i )
+        {
+        const OffsetValueType forward = index[i] < ends[i] ? offsets[i] : 0;
+        const OffsetValueType backward = index[i] > starts[i] ? offsets[i] : 0;
+        const PixelRealType   val = ( static_cast< PixelRealType >( center[forward] )
+                                      - static_cast< PixelRealType >( center[-backward] ) ) / -2.0f
+                                    * scales[i];
+        sum += val * val;
+        }
+      }
+    count += lineLength;
+    it.NextLine();
+    }
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+GradientAnisotropicDiffusionImageFilter< TInputImage, TOutputImage >
+::CalculateAverageGradientMagnitudeSquared(AnisotropicDiffusionFunctionType *f)
+{
+  if ( m_AverageGradientMagnitudeSquaredIteration > 0
+       && m_AverageGradientMagnitudeSquaredIteration == this->GetElapsedIterations() )
+    {
+    f->SetAverageGradientMagnitudeSquared(m_AverageGradientMagnitudeSquared);
+    }
+  else
+    {
+    Superclass::CalculateAverageGradientMagnitudeSquared(f);
+    }
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+GradientAnisotropicDiffusionImageFilter< TInputImage, TOutputImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "UseFusedIteration: " << m_UseFusedIteration << std::endl;
+}
+} // end namespace itk
+
+#endif
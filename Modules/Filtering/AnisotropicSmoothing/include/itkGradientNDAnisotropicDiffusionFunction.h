@@ -95,6 +95,18 @@ public:
                                   const FloatOffsetType & offset = FloatOffsetType(0.0)
                                   ) ITK_OVERRIDE;
 
+  /** Compute the updates of \a length consecutive pixels along the first
+   * dimension, from direct offsets to the pixel \a center of the image
+   * buffer.  \a offsets holds the offset to the next pixel along each
+   * dimension, and the pixels and all their neighbors must be inside the
+   * buffer.  The computation is equivalent to ComputeUpdate(), but is done
+   * with the real type of the pixels (float for float images) and without
+   * neighborhood iterator. */
+  void ComputeUpdateAlongScanline(const PixelType *center,
+                                  const OffsetValueType offsets[],
+                                  SizeValueType length,
+                                  PixelType *update) const;
+
   /** This method is called prior to each iteration of the solver. */
   virtual void InitializeIteration() ITK_OVERRIDE
   {
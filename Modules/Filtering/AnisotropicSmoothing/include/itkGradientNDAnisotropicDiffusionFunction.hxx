@@ -159,6 +159,86 @@ GradientNDAnisotropicDiffusionFunction< TImage >
 
   return static_cast< PixelType >( delta );
 }
+
+template< typename TImage >
+void
+GradientNDAnisotropicDiffusionFunction< TImage >
+::ComputeUpdateAlongScanline(const PixelType *center,
+                             const OffsetValueType offsets[],
+                             SizeValueType length,
+                             PixelType *update) const
+{
+  typedef typename NumericTraits< PixelType >::FloatType RealType;
+
+  const RealType half = static_cast< RealType >( 0.5 );
+  const RealType quarter = static_cast< RealType >( 0.25 );
+  const RealType K = static_cast< RealType >( m_K );
+
+  RealType scales[ImageDimension];
+  for ( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    scales[i] = static_cast< RealType >( this->m_ScaleCoefficients[i] );
+    }
+
+  for ( SizeValueType n = 0; n < length; ++n )
+    {
+    const PixelType *p = center + n;
+    const RealType   value = static_cast< RealType >( *p );
+
+    // Centralized derivatives.
+    RealType dx[ImageDimension];
+    for ( unsigned int i = 0; i < ImageDimension; i++ )
+      {
+      dx[i] = ( static_cast< RealType >( p[offsets[i]] ) - static_cast< RealType >( p[-offsets[i]] ) )
+              * half * scales[i];
+      }
+
+    RealType delta = NumericTraits< RealType >::ZeroValue();
+    for ( unsigned int i = 0; i < ImageDimension; i++ )
+      {
+      const PixelType *forward = p + offsets[i];
+      const PixelType *backward = p - offsets[i];
+
+      // "Half" directional derivatives
+      RealType dx_forward = ( static_cast< RealType >( *forward ) - value ) * scales[i];
+      RealType dx_backward = ( value - static_cast< RealType >( *backward ) ) * scales[i];
+
+      RealType accum = NumericTraits< RealType >::ZeroValue();
+      RealType accum_d = NumericTraits< RealType >::ZeroValue();
+      for ( unsigned int j = 0; j < ImageDimension; j++ )
+        {
+        if ( j != i )
+          {
+          const RealType dx_aug =
+            ( static_cast< RealType >( forward[offsets[j]] ) - static_cast< RealType >( forward[-offsets[j]] ) )
+            * half * scales[j];
+          const RealType dx_dim =
+            ( static_cast< RealType >( backward[offsets[j]] ) - static_cast< RealType >( backward[-offsets[j]] ) )
+            * half * scales[j];
+          accum += quarter * ( dx[j] + dx_aug ) * ( dx[j] + dx_aug );
+          accum_d += quarter * ( dx[j] + dx_dim ) * ( dx[j] + dx_dim );
+          }
+        }
+
+      // Conductance modified first order derivatives.
+      if ( K == NumericTraits< RealType >::ZeroValue() )
+        {
+        dx_forward = NumericTraits< RealType >::ZeroValue();
+        dx_backward = NumericTraits< RealType >::ZeroValue();
+        }
+      else
+        {
+        dx_forward *= std::exp( ( dx_forward * dx_forward + accum ) / K );
+        dx_backward *= std::exp( ( dx_backward * dx_backward + accum_d ) / K );
+        }
+
+      // Conductance modified second order derivative.
+      delta += dx_forward - dx_backward;
+      }
+
+    update[n] = static_cast< PixelType >( delta );
+    }
+}
 } // end namespace itk
 
 #endif
@@ -0,0 +1,131 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGradientAnisotropicDiffusionImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+template< typename TImage >
+typename TImage::Pointer
+CreateImage( const typename TImage::SizeType & size )
+{
+  typename TImage::Pointer image = TImage::New();
+  image->SetRegions( size );
+  image->Allocate();
+
+  // Blocks of several intensities, with some noise.
+  unsigned int seed = 11;
+  itk::ImageRegionIteratorWithIndex< TImage > it( image, image->GetLargestPossibleRegion() );
+  for( ; !it.IsAtEnd(); ++it )
+    {
+    seed = seed * 1103515245u + 12345u;
+    float value = static_cast< float >( ( seed >> 16 ) % 100 ) / 10.0f;
+    for( unsigned int d = 0; d < TImage::ImageDimension; ++d )
+      {
+      value += 30.0f * ( ( it.GetIndex()[d] / 7 ) % 2 );
+      }
+    it.Set( value );
+    }
+  return image;
+}
+
+template< typename TImage >
+typename TImage::Pointer
+Diffuse( const TImage * input, bool fused, itk::ThreadIdType numberOfThreads,
+         unsigned int scalingUpdateInterval )
+{
+  typedef itk::GradientAnisotropicDiffusionImageFilter< TImage, TImage > FilterType;
+
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( input );
+  filter->SetNumberOfIterations( 5 );
+  filter->SetTimeStep( 0.05 );
+  filter->SetConductanceParameter( 1.5 );
+  filter->SetConductanceScalingUpdateInterval( scalingUpdateInterval );
+  filter->SetUseFusedIteration( fused );
+  filter->SetNumberOfThreads( numberOfThreads );
+  filter->Update();
+
+  typename TImage::Pointer output = filter->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+
+template< typename TImage >
+bool
+CheckFused( const typename TImage::SizeType & size )
+{
+  typename TImage::Pointer input = CreateImage< TImage >( size );
+
+  const itk::ThreadIdType numberOfThreads[] = { 1, 3, 8 };
+  const unsigned int      intervals[] = { 1, 2 };
+  for( unsigned int i = 0; i < 2; ++i )
+    {
+    typename TImage::Pointer reference = Diffuse< TImage >( input, false, 1, intervals[i] );
+    for( unsigned int t = 0; t < 3; ++t )
+      {
+      typename TImage::Pointer fused = Diffuse< TImage >( input, true, numberOfThreads[t], intervals[i] );
+
+      itk::ImageRegionConstIterator< TImage > rIt( reference, reference->GetLargestPossibleRegion() );
+      itk::ImageRegionConstIterator< TImage > fIt( fused, fused->GetLargestPossibleRegion() );
+      // The values stay below 100, where a float is rounded to 7.6e-6: the
+      // fused iterations differ from the default ones by rounding only.
+      for( ; !rIt.IsAtEnd(); ++rIt, ++fIt )
+        {
+        if( std::fabs( rIt.Get() - fIt.Get() ) > 1e-5f )
+          {
+          std::cerr << "Dimension " << TImage::ImageDimension << ", " << numberOfThreads[t]
+                    << " threads, scaling update interval " << intervals[i]
+                    << ": the fused iteration differs at " << rIt.GetIndex() << ": "
+                    << rIt.Get() << " and " << fIt.Get() << std::endl;
+          return false;
+          }
+        }
+      }
+    }
+  return true;
+}
+}
+
+// Compare the fused iterations of the gradient anisotropic diffusion to the
+// default ones, in 2D and 3D, with several numbers of threads.
+int itkGradientAnisotropicDiffusionImageFilterFusedTest( int, char * [] )
+{
+  typedef itk::Image< float, 2 > ImageType2D;
+  typedef itk::Image< float, 3 > ImageType3D;
+
+  typedef itk::GradientAnisotropicDiffusionImageFilter< ImageType2D, ImageType2D > FilterType;
+  FilterType::Pointer filter = FilterType::New();
+  TEST_SET_GET_BOOLEAN( filter, UseFusedIteration, true );
+
+  ImageType2D::SizeType size2D;
+  size2D[0] = 61;
+  size2D[1] = 47;
+  TEST_EXPECT_TRUE( CheckFused< ImageType2D >( size2D ) );
+
+  ImageType3D::SizeType size3D;
+  size3D[0] = 23;
+  size3D[1] = 19;
+  size3D[2] = 17;
+  TEST_EXPECT_TRUE( CheckFused< ImageType3D >( size3D ) );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
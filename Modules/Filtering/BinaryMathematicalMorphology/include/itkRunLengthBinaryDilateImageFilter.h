@@ -0,0 +1,83 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRunLengthBinaryDilateImageFilter_h
+#define itkRunLengthBinaryDilateImageFilter_h
+
+#include "itkRunLengthBinaryMorphologyImageFilter.h"
+
+namespace itk
+{
+/**
+ * \class RunLengthBinaryDilateImageFilter
+ * \brief Binary dilation computed on run-length encoded lines
+ *
+ * RunLengthBinaryDilateImageFilter computes the same binary dilation as
+ * BinaryDilateImageFilter, on the run-length encoding of the foreground of
+ * the input. Each line of the output is the union of the runs of the input
+ * lines, shifted and widened by the runs of the structuring element, so the
+ * cost of the dilation grows with the number of runs instead of the number
+ * of pixels. This is much faster on large images with a sparse foreground,
+ * such as organ masks, and with large structuring elements such as balls.
+ *
+ * As for BinaryDilateImageFilter, BoundaryToForeground defaults to false,
+ * the pixels which are not foreground in the input keep their value unless
+ * they are covered by the dilation, and the foreground pixels which are not
+ * covered receive the BackgroundValue.
+ *
+ * \sa RunLengthBinaryMorphologyImageFilter BinaryDilateImageFilter RunLengthBinaryErodeImageFilter
+ * \ingroup ITKBinaryMathematicalMorphology
+ */
+template< typename TInputImage, typename TOutputImage, typename TKernel >
+class ITK_TEMPLATE_EXPORT RunLengthBinaryDilateImageFilter:
+  public RunLengthBinaryMorphologyImageFilter< TInputImage, TOutputImage, TKernel >
+{
+public:
+  /** Standard class typedefs. */
+  typedef RunLengthBinaryDilateImageFilter                                           Self;
+  typedef RunLengthBinaryMorphologyImageFilter< TInputImage, TOutputImage, TKernel > Superclass;
+  typedef SmartPointer< Self >                                                       Pointer;
+  typedef SmartPointer< const Self >                                                 ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(RunLengthBinaryDilateImageFilter, RunLengthBinaryMorphologyImageFilter);
+
+  typedef typename Superclass::IndexType        IndexType;
+  typedef typename Superclass::IndexValueType   IndexValueType;
+  typedef typename Superclass::RunType          RunType;
+  typedef typename Superclass::RunContainerType RunContainerType;
+
+protected:
+  RunLengthBinaryDilateImageFilter();
+  virtual ~RunLengthBinaryDilateImageFilter() {}
+
+  void ComputeLineRuns(const IndexType & lineIndex, RunContainerType & runs,
+                       RunContainerType & work, RunContainerType & buffer) const ITK_OVERRIDE;
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(RunLengthBinaryDilateImageFilter);
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkRunLengthBinaryDilateImageFilter.hxx"
+#endif
+
+#endif
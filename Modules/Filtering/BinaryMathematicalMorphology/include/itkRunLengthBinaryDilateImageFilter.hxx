@@ -0,0 +1,78 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRunLengthBinaryDilateImageFilter_hxx
+#define itkRunLengthBinaryDilateImageFilter_hxx
+
+#include "itkRunLengthBinaryDilateImageFilter.h"
+#include <algorithm>
+
+namespace itk
+{
+template< typename TInputImage, typename TOutputImage, typename TKernel >
+RunLengthBinaryDilateImageFilter< TInputImage, TOutputImage, TKernel >
+::RunLengthBinaryDilateImageFilter()
+{
+  this->SetBoundaryToForeground(false);
+}
+
+template< typename TInputImage, typename TOutputImage, typename TKernel >
+void
+RunLengthBinaryDilateImageFilter< TInputImage, TOutputImage, TKernel >
+::ComputeLineRuns(const IndexType & lineIndex, RunContainerType & runs,
+                  RunContainerType & work, RunContainerType & itkNotUsed(buffer)) const
+{
+  runs.clear();
+
+  // A pixel x of the output line is on if x - k is on in the input line at
+  // lineIndex - offset, for some element k of a kernel run: each input run
+  // [a,b] produces the run [a + begin, b + end].
+  typedef typename Superclass::KernelRunContainerType KernelRunContainerType;
+  const KernelRunContainerType & kernelRuns = this->GetKernelRuns();
+  for ( typename KernelRunContainerType::const_iterator kit = kernelRuns.begin(); kit != kernelRuns.end(); ++kit )
+    {
+    this->GetInputLineRuns(lineIndex - kit->m_Offset, work);
+    for ( typename RunContainerType::const_iterator rit = work.begin(); rit != work.end(); ++rit )
+      {
+      runs.push_back( RunType(rit->first + kit->m_Begin, rit->second + kit->m_End) );
+      }
+    }
+
+  if ( runs.empty() )
+    {
+    return;
+    }
+
+  // Merge the overlapping and touching runs
+  std::sort( runs.begin(), runs.end() );
+  typename RunContainerType::iterator last = runs.begin();
+  for ( typename RunContainerType::iterator rit = runs.begin() + 1; rit != runs.end(); ++rit )
+    {
+    if ( rit->first <= last->second + 1 )
+      {
+      last->second = std::max(last->second, rit->second);
+      }
+    else
+      {
+      *( ++last ) = *rit;
+      }
+    }
+  runs.erase( last + 1, runs.end() );
+}
+} // end namespace itk
+
+#endif
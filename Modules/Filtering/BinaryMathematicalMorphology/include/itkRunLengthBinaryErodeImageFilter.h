@@ -0,0 +1,82 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRunLengthBinaryErodeImageFilter_h
+#define itkRunLengthBinaryErodeImageFilter_h
+
+#include "itkRunLengthBinaryMorphologyImageFilter.h"
+
+namespace itk
+{
+/**
+ * \class RunLengthBinaryErodeImageFilter
+ * \brief Binary erosion computed on run-length encoded lines
+ *
+ * RunLengthBinaryErodeImageFilter computes the same binary erosion as
+ * BinaryErodeImageFilter, on the run-length encoding of the foreground of
+ * the input. Each line of the output is the intersection of the runs of the
+ * input lines, shifted and shrunk by the runs of the structuring element,
+ * so the cost of the erosion grows with the number of runs instead of the
+ * number of pixels. Lines far from the foreground are discarded as soon as
+ * one of the intersected sets is empty.
+ *
+ * As for BinaryErodeImageFilter, BoundaryToForeground defaults to true, the
+ * eroded pixels receive the BackgroundValue and the pixels which are not
+ * foreground in the input are copied to the output.
+ *
+ * \sa RunLengthBinaryMorphologyImageFilter BinaryErodeImageFilter RunLengthBinaryDilateImageFilter
+ * \ingroup ITKBinaryMathematicalMorphology
+ */
+template< typename TInputImage, typename TOutputImage, typename TKernel >
+class ITK_TEMPLATE_EXPORT RunLengthBinaryErodeImageFilter:
+  public RunLengthBinaryMorphologyImageFilter< TInputImage, TOutputImage, TKernel >
+{
+public:
+  /** Standard class typedefs. */
+  typedef RunLengthBinaryErodeImageFilter                                            Self;
+  typedef RunLengthBinaryMorphologyImageFilter< TInputImage, TOutputImage, TKernel > Superclass;
+  typedef SmartPointer< Self >                                                       Pointer;
+  typedef SmartPointer< const Self >                                                 ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(RunLengthBinaryErodeImageFilter, RunLengthBinaryMorphologyImageFilter);
+
+  typedef typename Superclass::IndexType        IndexType;
+  typedef typename Superclass::IndexValueType   IndexValueType;
+  typedef typename Superclass::RunType          RunType;
+  typedef typename Superclass::RunContainerType RunContainerType;
+
+protected:
+  RunLengthBinaryErodeImageFilter();
+  virtual ~RunLengthBinaryErodeImageFilter() {}
+
+  void ComputeLineRuns(const IndexType & lineIndex, RunContainerType & runs,
+                       RunContainerType & work, RunContainerType & buffer) const ITK_OVERRIDE;
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(RunLengthBinaryErodeImageFilter);
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkRunLengthBinaryErodeImageFilter.hxx"
+#endif
+
+#endif
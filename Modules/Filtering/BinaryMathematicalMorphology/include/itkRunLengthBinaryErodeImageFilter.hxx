@@ -0,0 +1,92 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRunLengthBinaryErodeImageFilter_hxx
+#define itkRunLengthBinaryErodeImageFilter_hxx
+
+#include "itkRunLengthBinaryErodeImageFilter.h"
+#include <algorithm>
+
+namespace itk
+{
+template< typename TInputImage, typename TOutputImage, typename TKernel >
+RunLengthBinaryErodeImageFilter< TInputImage, TOutputImage, TKernel >
+::RunLengthBinaryErodeImageFilter()
+{
+  this->SetBoundaryToForeground(true);
+}
+
+template< typename TInputImage, typename TOutputImage, typename TKernel >
+void
+RunLengthBinaryErodeImageFilter< TInputImage, TOutputImage, TKernel >
+::ComputeLineRuns(const IndexType & lineIndex, RunContainerType & runs,
+                  RunContainerType & work, RunContainerType & buffer) const
+{
+  // Start from the whole line
+  runs.clear();
+  runs.push_back( RunType( NumericTraits< IndexValueType >::NonpositiveMin(),
+                           NumericTraits< IndexValueType >::max() ) );
+
+  // A pixel x of the output line is on if x - k is on in the input line
+  // at lineIndex - offset, for all the elements k of a kernel run: each
+  // input run [a,b] which is long enough produces the run
+  // [a + end, b + begin].
+  typedef typename Superclass::KernelRunContainerType KernelRunContainerType;
+  const KernelRunContainerType & kernelRuns = this->GetKernelRuns();
+  for ( typename KernelRunContainerType::const_iterator kit = kernelRuns.begin();
+        kit != kernelRuns.end() && !runs.empty(); ++kit )
+    {
+    this->GetInputLineRuns(lineIndex - kit->m_Offset, work);
+
+    const IndexValueType extent = kit->m_End - kit->m_Begin;
+    typename RunContainerType::iterator eroded = work.begin();
+    for ( typename RunContainerType::const_iterator rit = work.begin(); rit != work.end(); ++rit )
+      {
+      if ( rit->second - rit->first >= extent )
+        {
+        *eroded++ = RunType(rit->first + kit->m_End, rit->second + kit->m_Begin);
+        }
+      }
+    work.erase( eroded, work.end() );
+
+    // Intersect the two sorted lists of disjoint runs
+    buffer.clear();
+    typename RunContainerType::const_iterator it1 = runs.begin();
+    typename RunContainerType::const_iterator it2 = work.begin();
+    while ( it1 != runs.end() && it2 != work.end() )
+      {
+      const IndexValueType first = std::max(it1->first, it2->first);
+      const IndexValueType last = std::min(it1->second, it2->second);
+      if ( first <= last )
+        {
+        buffer.push_back( RunType(first, last) );
+        }
+      if ( it1->second < it2->second )
+        {
+        ++it1;
+        }
+      else
+        {
+        ++it2;
+        }
+      }
+    runs.swap(buffer);
+    }
+}
+} // end namespace itk
+
+#endif
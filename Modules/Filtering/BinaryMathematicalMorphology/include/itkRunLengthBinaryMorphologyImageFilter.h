@@ -0,0 +1,185 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRunLengthBinaryMorphologyImageFilter_h
+#define itkRunLengthBinaryMorphologyImageFilter_h
+
+#include <vector>
+#include <utility>
+#include "itkKernelImageFilter.h"
+#include "itkLabelObjectLine.h"
+
+namespace itk
+{
+/**
+ * \class RunLengthBinaryMorphologyImageFilter
+ * \brief Base class for binary dilation and erosion computed on run-length
+ * encoded lines
+ *
+ * The foreground of the input image is encoded once, in
+ * BeforeThreadedGenerateData(), as a set of LabelObjectLine runs along the
+ * first dimension of the image, the same representation used by LabelMap.
+ * The structuring element is encoded the same way. The morphological
+ * operation is then computed, independently for each line of the output,
+ * as a combination of the runs of the input lines shifted by the runs of
+ * the structuring element, so that its cost is proportional to the number
+ * of runs rather than to the number of pixels in the image and in the
+ * kernel. The image is only touched when the input is encoded and when the
+ * output lines are painted.
+ *
+ * This makes these filters much faster than BinaryDilateImageFilter and
+ * BinaryErodeImageFilter on large and sparse masks, or with large
+ * structuring elements. The definitions of the operations, of the
+ * ForegroundValue, BackgroundValue and BoundaryToForeground parameters,
+ * and the produced images are the same as for those filters.
+ *
+ * The computation of a line of the output is provided by the subclasses in
+ * ComputeLineRuns().
+ *
+ * \sa RunLengthBinaryDilateImageFilter RunLengthBinaryErodeImageFilter
+ * \sa BinaryMorphologyImageFilter LabelObjectLine
+ * \ingroup ITKBinaryMathematicalMorphology
+ */
+template< typename TInputImage, typename TOutputImage, typename TKernel >
+class ITK_TEMPLATE_EXPORT RunLengthBinaryMorphologyImageFilter:
+  public KernelImageFilter< TInputImage, TOutputImage, TKernel >
+{
+public:
+  /** Standard class typedefs. */
+  typedef RunLengthBinaryMorphologyImageFilter                    Self;
+  typedef KernelImageFilter< TInputImage, TOutputImage, TKernel > Superclass;
+  typedef SmartPointer< Self >                                    Pointer;
+  typedef SmartPointer< const Self >                              ConstPointer;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(RunLengthBinaryMorphologyImageFilter, KernelImageFilter);
+
+  /** Extract dimension from input and output image. */
+  itkStaticConstMacro(InputImageDimension, unsigned int,
+                      TInputImage::ImageDimension);
+  itkStaticConstMacro(OutputImageDimension, unsigned int,
+                      TOutputImage::ImageDimension);
+
+  /** Convenient typedefs for simplifying declarations. */
+  typedef TInputImage  InputImageType;
+  typedef TOutputImage OutputImageType;
+  typedef TKernel      KernelType;
+
+  /** Image typedef support. */
+  typedef typename InputImageType::PixelType      InputPixelType;
+  typedef typename OutputImageType::PixelType     OutputPixelType;
+  typedef typename InputImageType::OffsetType     OffsetType;
+  typedef typename InputImageType::IndexType      IndexType;
+  typedef typename InputImageType::IndexValueType IndexValueType;
+  typedef typename InputImageType::RegionType     InputImageRegionType;
+  typedef typename OutputImageType::RegionType    OutputImageRegionType;
+
+  /** Run-length encoding of a line of the input. */
+  typedef LabelObjectLine< itkGetStaticConstMacro(InputImageDimension) > LineType;
+  typedef std::vector< LineType >                                         LineContainerType;
+
+  /** Input and output images must be the same dimension. */
+  itkConceptMacro( ImageDimensionCheck,
+                   ( Concept::SameDimension< itkGetStaticConstMacro(InputImageDimension),
+                                             itkGetStaticConstMacro(OutputImageDimension) > ) );
+
+  /** Set/Get the value in the image to consider as "foreground". Defaults to
+   * maximum value of PixelType. */
+  itkSetMacro(ForegroundValue, InputPixelType);
+  itkGetConstMacro(ForegroundValue, InputPixelType);
+
+  /** Set/Get the value given to the foreground pixels of the input which
+   * are not in the result of the operation. The other pixels of the input
+   * are copied to the output. */
+  itkSetMacro(BackgroundValue, OutputPixelType);
+  itkGetConstMacro(BackgroundValue, OutputPixelType);
+
+  /** Get/Set the borders as foreground (true) or background (false). */
+  itkSetMacro(BoundaryToForeground, bool);
+  itkGetConstReferenceMacro(BoundaryToForeground, bool);
+  itkBooleanMacro(BoundaryToForeground);
+
+protected:
+  RunLengthBinaryMorphologyImageFilter();
+  virtual ~RunLengthBinaryMorphologyImageFilter() {}
+  void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
+
+  /** A run of pixels along the first dimension, as the indices of its
+   * first and last pixels. */
+  typedef std::pair< IndexValueType, IndexValueType > RunType;
+  typedef std::vector< RunType >                      RunContainerType;
+
+  /** A run of "on" elements of the kernel. m_Offset is the offset of the
+   * kernel line, with a null first component. */
+  struct KernelRunType {
+    OffsetType     m_Offset;
+    IndexValueType m_Begin;
+    IndexValueType m_End;
+  };
+  typedef std::vector< KernelRunType > KernelRunContainerType;
+
+  /** Encode the kernel and the foreground of the input. */
+  void BeforeThreadedGenerateData() ITK_OVERRIDE;
+
+  /** Compute and paint the lines of the output region. */
+  void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                            ThreadIdType threadId) ITK_OVERRIDE;
+
+  /** Release the encoded input. */
+  void AfterThreadedGenerateData() ITK_OVERRIDE;
+
+  /** Compute the sorted, disjoint foreground runs of the output line
+   * starting at lineIndex. The runs may extend beyond the image; they are
+   * cropped when the line is painted. "work" and "buffer" are scratch
+   * containers owned by the calling thread. */
+  virtual void ComputeLineRuns(const IndexType & lineIndex, RunContainerType & runs,
+                               RunContainerType & work, RunContainerType & buffer) const = 0;
+
+  /** Get the foreground runs of the input line starting at lineIndex, with
+   * consecutive runs merged. When BoundaryToForeground is on, the pixels
+   * outside of the input image are reported as foreground up to a distance
+   * larger than the kernel radius. */
+  void GetInputLineRuns(const IndexType & lineIndex, RunContainerType & runs) const;
+
+  /** Get the runs of "on" elements of the kernel. */
+  const KernelRunContainerType & GetKernelRuns() const
+  { return m_KernelRuns; }
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(RunLengthBinaryMorphologyImageFilter);
+
+  InputPixelType  m_ForegroundValue;
+  OutputPixelType m_BackgroundValue;
+  bool            m_BoundaryToForeground;
+
+  /** Runs of the kernel, grouped by kernel line. */
+  KernelRunContainerType m_KernelRuns;
+
+  /** Foreground runs of the input, stored line after line. The runs of
+   * the input line number l are in [m_LineOffsets[l], m_LineOffsets[l+1]). */
+  LineContainerType            m_InputLines;
+  std::vector< SizeValueType > m_LineOffsets;
+  InputImageRegionType         m_InputRegion;
+  IndexValueType               m_BoundaryPadding;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkRunLengthBinaryMorphologyImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,292 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkRunLengthBinaryMorphologyImageFilter_hxx
+#define itkRunLengthBinaryMorphologyImageFilter_hxx
+
+#include "itkRunLengthBinaryMorphologyImageFilter.h"
+#include "itkImageLinearIteratorWithIndex.h"
+#include "itkProgressReporter.h"
+#include "itkMath.h"
+
+namespace itk
+{
+template< typename TInputImage, typename TOutputImage, typename TKernel >
+RunLengthBinaryMorphologyImageFilter< TInputImage, TOutputImage, TKernel >
+::RunLengthBinaryMorphologyImageFilter() :
+  m_ForegroundValue( NumericTraits< InputPixelType >::max() ),
+  m_BackgroundValue( NumericTraits< OutputPixelType >::NonpositiveMin() ),
+  m_BoundaryToForeground( false ),
+  m_BoundaryPadding( 1 )
+{
+}
+
+template< typename TInputImage, typename TOutputImage, typename TKernel >
+void
+RunLengthBinaryMorphologyImageFilter< TInputImage, TOutputImage, TKernel >
+::BeforeThreadedGenerateData()
+{
+  const InputImageType * input = this->GetInput();
+
+  // Encode the kernel: the "on" elements are visited with the first
+  // dimension varying fastest, so that the elements of a run are visited
+  // one after the other.
+  const KernelType & kernel = this->GetKernel();
+  m_KernelRuns.clear();
+  unsigned int i = 0;
+  for ( typename KernelType::ConstIterator kit = kernel.Begin(); kit != kernel.End(); ++kit, ++i )
+    {
+    if ( *kit )
+      {
+      OffsetType           offset = kernel.GetOffset(i);
+      const IndexValueType x = offset[0];
+      offset[0] = 0;
+      if ( !m_KernelRuns.empty()
+           && m_KernelRuns.back().m_Offset == offset
+           && m_KernelRuns.back().m_End + 1 == x )
+        {
+        m_KernelRuns.back().m_End = x;
+        }
+      else
+        {
+        KernelRunType run;
+        run.m_Offset = offset;
+        run.m_Begin = x;
+        run.m_End = x;
+        m_KernelRuns.push_back(run);
+        }
+      }
+    }
+  m_BoundaryPadding = static_cast< IndexValueType >( kernel.GetRadius(0) ) + 1;
+
+  // Encode the foreground of the input, line after line
+  m_InputRegion = input->GetBufferedRegion();
+  m_InputLines.clear();
+  m_LineOffsets.clear();
+  m_LineOffsets.push_back(0);
+  if ( m_InputRegion.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+  m_LineOffsets.reserve( m_InputRegion.GetNumberOfPixels() / m_InputRegion.GetSize(0) + 1 );
+
+  ImageLinearConstIteratorWithIndex< InputImageType > it(input, m_InputRegion);
+  it.SetDirection(0);
+  it.GoToBegin();
+  while ( !it.IsAtEnd() )
+    {
+    bool                          inRun = false;
+    IndexType                     runIndex;
+    typename LineType::LengthType runLength = 0;
+    while ( !it.IsAtEndOfLine() )
+      {
+      if ( Math::ExactlyEquals(it.Get(), m_ForegroundValue) )
+        {
+        if ( inRun )
+          {
+          ++runLength;
+          }
+        else
+          {
+          runIndex = it.GetIndex();
+          runLength = 1;
+          inRun = true;
+          }
+        }
+      else if ( inRun )
+        {
+        m_InputLines.push_back( LineType(runIndex, runLength) );
+        inRun = false;
+        }
+      ++it;
+      }
+    if ( inRun )
+      {
+      m_InputLines.push_back( LineType(runIndex, runLength) );
+      }
+    m_LineOffsets.push_back( m_InputLines.size() );
+    it.NextLine();
+    }
+}
+
+template< typename TInputImage, typename TOutputImage, typename TKernel >
+void
+RunLengthBinaryMorphologyImageFilter< TInputImage, TOutputImage, TKernel >
+::GetInputLineRuns(const IndexType & lineIndex, RunContainerType & runs) const
+{
+  runs.clear();
+  if ( m_InputRegion.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  const IndexValueType begin = m_InputRegion.GetIndex(0);
+  const IndexValueType end = begin + static_cast< IndexValueType >( m_InputRegion.GetSize(0) ) - 1;
+
+  // Find the number of the line in the input region
+  bool          inside = true;
+  SizeValueType line = 0;
+  SizeValueType stride = 1;
+  for ( unsigned int d = 1; d < InputImageDimension; ++d )
+    {
+    const IndexValueType position = lineIndex[d] - m_InputRegion.GetIndex(d);
+    if ( position < 0 || position >= static_cast< IndexValueType >( m_InputRegion.GetSize(d) ) )
+      {
+      inside = false;
+      break;
+      }
+    line += static_cast< SizeValueType >( position ) * stride;
+    stride *= m_InputRegion.GetSize(d);
+    }
+
+  if ( !inside )
+    {
+    if ( m_BoundaryToForeground )
+      {
+      runs.push_back( RunType(begin - m_BoundaryPadding, end + m_BoundaryPadding) );
+      }
+    return;
+    }
+
+  if ( m_BoundaryToForeground )
+    {
+    runs.push_back( RunType(begin - m_BoundaryPadding, begin - 1) );
+    }
+  for ( SizeValueType l = m_LineOffsets[line]; l < m_LineOffsets[line + 1]; ++l )
+    {
+    const IndexValueType first = m_InputLines[l].GetIndex()[0];
+    const IndexValueType last = first + static_cast< IndexValueType >( m_InputLines[l].GetLength() ) - 1;
+    if ( !runs.empty() && runs.back().second + 1 >= first )
+      {
+      runs.back().second = last;
+      }
+    else
+      {
+      runs.push_back( RunType(first, last) );
+      }
+    }
+  if ( m_BoundaryToForeground )
+    {
+    if ( runs.back().second == end )
+      {
+      runs.back().second = end + m_BoundaryPadding;
+      }
+    else
+      {
+      runs.push_back( RunType(end + 1, end + m_BoundaryPadding) );
+      }
+    }
+}
+
+template< typename TInputImage, typename TOutputImage, typename TKernel >
+void
+RunLengthBinaryMorphologyImageFilter< TInputImage, TOutputImage, TKernel >
+::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                       ThreadIdType threadId)
+{
+  const InputImageType * input = this->GetInput();
+  OutputImageType *      output = this->GetOutput();
+
+  if ( outputRegionForThread.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  ImageLinearConstIteratorWithIndex< InputImageType > inIt(input, outputRegionForThread);
+  ImageLinearIteratorWithIndex< OutputImageType >     outIt(output, outputRegionForThread);
+  inIt.SetDirection(0);
+  outIt.SetDirection(0);
+  inIt.GoToBegin();
+  outIt.GoToBegin();
+
+  const OutputPixelType foregroundValue = static_cast< OutputPixelType >( m_ForegroundValue );
+
+  ProgressReporter progress( this, threadId,
+                             outputRegionForThread.GetNumberOfPixels() / outputRegionForThread.GetSize(0) );
+
+  RunContainerType runs;
+  RunContainerType work;
+  RunContainerType buffer;
+
+  while ( !outIt.IsAtEnd() )
+    {
+    const IndexType lineIndex = outIt.GetIndex();
+    this->ComputeLineRuns(lineIndex, runs, work, buffer);
+
+    // Paint the line: the pixels in the runs get the foreground value, the
+    // other foreground pixels of the input are removed and the remaining
+    // ones are copied.
+    typename RunContainerType::const_iterator runIt = runs.begin();
+    IndexValueType                            x = lineIndex[0];
+    while ( !outIt.IsAtEndOfLine() )
+      {
+      while ( runIt != runs.end() && runIt->second < x )
+        {
+        ++runIt;
+        }
+      if ( runIt != runs.end() && runIt->first <= x )
+        {
+        outIt.Set(foregroundValue);
+        }
+      else
+        {
+        const InputPixelType value = inIt.Get();
+        if ( Math::ExactlyEquals(value, m_ForegroundValue) )
+          {
+          outIt.Set(m_BackgroundValue);
+          }
+        else
+          {
+          outIt.Set( static_cast< OutputPixelType >( value ) );
+          }
+        }
+      ++inIt;
+      ++outIt;
+      ++x;
+      }
+    inIt.NextLine();
+    outIt.NextLine();
+    progress.CompletedPixel();
+    }
+}
+
+template< typename TInputImage, typename TOutputImage, typename TKernel >
+void
+RunLengthBinaryMorphologyImageFilter< TInputImage, TOutputImage, TKernel >
+::AfterThreadedGenerateData()
+{
+  LineContainerType().swap(m_InputLines);
+  std::vector< SizeValueType >().swap(m_LineOffsets);
+}
+
+template< typename TInputImage, typename TOutputImage, typename TKernel >
+void
+RunLengthBinaryMorphologyImageFilter< TInputImage, TOutputImage, TKernel >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "ForegroundValue: "
+     << static_cast< typename NumericTraits< InputPixelType >::PrintType >( m_ForegroundValue ) << std::endl;
+  os << indent << "BackgroundValue: "
+     << static_cast< typename NumericTraits< OutputPixelType >::PrintType >( m_BackgroundValue ) << std::endl;
+  os << indent << "BoundaryToForeground: " << m_BoundaryToForeground << std::endl;
+  os << indent << "Number of kernel runs: " << m_KernelRuns.size() << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -0,0 +1,178 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkRunLengthBinaryDilateImageFilter.h"
+#include "itkRunLengthBinaryErodeImageFilter.h"
+#include "itkBinaryDilateImageFilter.h"
+#include "itkBinaryErodeImageFilter.h"
+#include "itkBinaryBallStructuringElement.h"
+#include "itkImageRegionIterator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+template< typename TImage >
+bool
+SameImages(const TImage * image1, const TImage * image2, const char * name)
+{
+  itk::ImageRegionConstIterator< TImage > it1( image1, image1->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< TImage > it2( image2, image2->GetLargestPossibleRegion() );
+  for ( ; !it1.IsAtEnd(); ++it1, ++it2 )
+    {
+    if ( it1.Get() != it2.Get() )
+      {
+      std::cerr << name << ": mismatch at " << it1.GetIndex() << ": "
+                << static_cast< int >( it1.Get() ) << " != " << static_cast< int >( it2.Get() ) << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+}
+
+int itkRunLengthBinaryMorphologyImageFilterTest(int, char* [] )
+{
+  const unsigned int Dimension = 3;
+
+  typedef unsigned char                                           PixelType;
+  typedef itk::Image< PixelType, Dimension >                      ImageType;
+  typedef itk::BinaryBallStructuringElement< PixelType, Dimension > KernelType;
+
+  typedef itk::RunLengthBinaryDilateImageFilter< ImageType, ImageType, KernelType > RunLengthDilateType;
+  typedef itk::RunLengthBinaryErodeImageFilter< ImageType, ImageType, KernelType >  RunLengthErodeType;
+  typedef itk::BinaryDilateImageFilter< ImageType, ImageType, KernelType >          DilateType;
+  typedef itk::BinaryErodeImageFilter< ImageType, ImageType, KernelType >           ErodeType;
+
+  // A sparse mask made of random boxes, some of them crossing the image
+  // border, plus a few pixels with another value which must be preserved.
+  ImageType::SizeType size;
+  size[0] = 41;
+  size[1] = 33;
+  size[2] = 19;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  image->FillBuffer( 0 );
+
+  unsigned int seed = 12345;
+  for ( unsigned int b = 0; b < 12; ++b )
+    {
+    ImageType::IndexType start;
+    ImageType::SizeType  boxSize;
+    for ( unsigned int d = 0; d < Dimension; ++d )
+      {
+      seed = seed * 1103515245u + 12345u;
+      start[d] = static_cast< itk::IndexValueType >( ( seed >> 8 ) % size[d] );
+      seed = seed * 1103515245u + 12345u;
+      boxSize[d] = 1 + ( seed >> 8 ) % 9;
+      }
+    ImageType::RegionType box( start, boxSize );
+    box.Crop( image->GetLargestPossibleRegion() );
+    itk::ImageRegionIterator< ImageType > it( image, box );
+    for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+      {
+      it.Set( 255 );
+      }
+    }
+  ImageType::IndexType other = { { 3, 30, 2 } };
+  image->SetPixel( other, 100 );
+
+  // A symmetric and an asymmetric structuring element
+  KernelType::SizeType radius;
+  radius[0] = 3;
+  radius[1] = 2;
+  radius[2] = 1;
+  KernelType ball;
+  ball.SetRadius( radius );
+  ball.CreateStructuringElement();
+
+  KernelType asymmetric = ball;
+  for ( unsigned int i = 0; i < asymmetric.Size(); ++i )
+    {
+    if ( asymmetric.GetOffset( i )[0] < 0 && asymmetric.GetOffset( i )[1] != 0 )
+      {
+      asymmetric[i] = 0;
+      }
+    }
+  asymmetric[asymmetric.GetCenterNeighborhoodIndex()] = 0;
+
+  const KernelType kernels[2] = { ball, asymmetric };
+
+  RunLengthDilateType::Pointer runLengthDilate = RunLengthDilateType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( runLengthDilate, RunLengthBinaryDilateImageFilter,
+                                 RunLengthBinaryMorphologyImageFilter );
+  TEST_SET_GET_VALUE( false, runLengthDilate->GetBoundaryToForeground() );
+
+  RunLengthErodeType::Pointer runLengthErode = RunLengthErodeType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( runLengthErode, RunLengthBinaryErodeImageFilter,
+                                 RunLengthBinaryMorphologyImageFilter );
+  TEST_SET_GET_VALUE( true, runLengthErode->GetBoundaryToForeground() );
+
+  for ( unsigned int k = 0; k < 2; ++k )
+    {
+    for ( unsigned int boundary = 0; boundary < 2; ++boundary )
+      {
+      DilateType::Pointer dilate = DilateType::New();
+      dilate->SetInput( image );
+      dilate->SetKernel( kernels[k] );
+      dilate->SetForegroundValue( 255 );
+      dilate->SetBackgroundValue( 0 );
+      dilate->SetBoundaryToForeground( boundary != 0 );
+      TRY_EXPECT_NO_EXCEPTION( dilate->Update() );
+
+      runLengthDilate->SetInput( image );
+      runLengthDilate->SetKernel( kernels[k] );
+      runLengthDilate->SetForegroundValue( 255 );
+      runLengthDilate->SetBackgroundValue( 0 );
+      runLengthDilate->SetBoundaryToForeground( boundary != 0 );
+      TRY_EXPECT_NO_EXCEPTION( runLengthDilate->Update() );
+
+      if ( !SameImages< ImageType >( runLengthDilate->GetOutput(), dilate->GetOutput(), "Dilate" ) )
+        {
+        std::cerr << "Kernel " << k << ", BoundaryToForeground " << boundary << std::endl;
+        return EXIT_FAILURE;
+        }
+
+      ErodeType::Pointer erode = ErodeType::New();
+      erode->SetInput( image );
+      erode->SetKernel( kernels[k] );
+      erode->SetForegroundValue( 255 );
+      erode->SetBackgroundValue( 0 );
+      erode->SetBoundaryToForeground( boundary != 0 );
+      TRY_EXPECT_NO_EXCEPTION( erode->Update() );
+
+      runLengthErode->SetInput( image );
+      runLengthErode->SetKernel( kernels[k] );
+      runLengthErode->SetForegroundValue( 255 );
+      runLengthErode->SetBackgroundValue( 0 );
+      runLengthErode->SetBoundaryToForeground( boundary != 0 );
+      TRY_EXPECT_NO_EXCEPTION( runLengthErode->Update() );
+
+      if ( !SameImages< ImageType >( runLengthErode->GetOutput(), erode->GetOutput(), "Erode" ) )
+        {
+        std::cerr << "Kernel " << k << ", BoundaryToForeground " << boundary << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,134 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkCurvatureFlowImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+const unsigned int Dimension = 2;
+
+typedef float                              PixelType;
+typedef itk::Image< PixelType, Dimension > ImageType;
+
+typedef itk::CurvatureFlowImageFilter< ImageType, ImageType > FilterType;
+
+ImageType::Pointer
+Smooth( const ImageType * input, bool useActiveTiles, double tolerance,
+        itk::ThreadIdType numberOfThreads, itk::SizeValueType & numberOfActiveTiles )
+{
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( input );
+  filter->SetNumberOfIterations( 20 );
+  filter->SetTimeStep( 0.1 );
+  filter->SetUseActiveTiles( useActiveTiles );
+  filter->SetTileSize( 8 );
+  filter->SetActiveTileTolerance( tolerance );
+  filter->SetNumberOfThreads( numberOfThreads );
+  filter->Update();
+
+  numberOfActiveTiles = filter->GetNumberOfActiveTiles();
+
+  ImageType::Pointer output = filter->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+
+double
+MaximumDifference( const ImageType * image1, const ImageType * image2 )
+{
+  double difference = 0.0;
+  itk::ImageRegionConstIterator< ImageType > it1( image1, image1->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< ImageType > it2( image2, image2->GetLargestPossibleRegion() );
+  for( ; !it1.IsAtEnd(); ++it1, ++it2 )
+    {
+    difference = std::max( difference,
+                           std::fabs( static_cast< double >( it1.Get() ) - static_cast< double >( it2.Get() ) ) );
+    }
+  return difference;
+}
+}
+
+// Compare the curvature flow over the active tiles to the dense one, on an
+// image which is constant but around a small disk, then on a constant
+// image.
+int itkCurvatureFlowActiveTilesTest( int, char * [] )
+{
+  ImageType::SizeType size;
+  size[0] = 100;
+  size[1] = 75;
+  ImageType::Pointer input = ImageType::New();
+  input->SetRegions( size );
+  input->Allocate();
+  itk::ImageRegionIteratorWithIndex< ImageType > it( input, input->GetLargestPossibleRegion() );
+  for( ; !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType & index = it.GetIndex();
+    const double dx = index[0] - 30.0;
+    const double dy = index[1] - 40.0;
+    it.Set( dx * dx + dy * dy < 49.0 ? 100.0f : 0.0f );
+    }
+
+  FilterType::Pointer filter = FilterType::New();
+  TEST_SET_GET_VALUE( false, filter->GetUseActiveTiles() );
+  TEST_SET_GET_VALUE( 16, filter->GetTileSize() );
+  TEST_SET_GET_VALUE( 0.0, filter->GetActiveTileTolerance() );
+
+  itk::SizeValueType numberOfActiveTiles = 0;
+  ImageType::Pointer dense = Smooth( input, false, 0.0, 1, numberOfActiveTiles );
+
+  // The flow is zero where the image is locally constant, so that skipping
+  // the tiles which did not change gives the dense result.
+  const itk::ThreadIdType numberOfThreads[] = { 1, 3 };
+  for( unsigned int t = 0; t < 2; ++t )
+    {
+    ImageType::Pointer tiled = Smooth( input, true, 0.0, numberOfThreads[t], numberOfActiveTiles );
+    std::cout << numberOfThreads[t] << " threads: " << numberOfActiveTiles
+              << " active tiles out of 130" << std::endl;
+    TEST_EXPECT_EQUAL( MaximumDifference( dense, tiled ), 0.0 );
+    TEST_EXPECT_TRUE( numberOfActiveTiles > 0 && numberOfActiveTiles < 130 );
+    }
+
+  // A positive tolerance skips more tiles, with a bounded difference.
+  itk::SizeValueType numberOfExactActiveTiles = numberOfActiveTiles;
+  ImageType::Pointer tolerant = Smooth( input, true, 1e-3, 1, numberOfActiveTiles );
+  std::cout << "Tolerance 1e-3: " << numberOfActiveTiles << " active tiles" << std::endl;
+  TEST_EXPECT_TRUE( numberOfActiveTiles <= numberOfExactActiveTiles );
+  TEST_EXPECT_TRUE( MaximumDifference( dense, tolerant ) < 0.1 );
+
+  // A constant image does not change, so that all the tiles become
+  // inactive after the first iteration.
+  ImageType::Pointer constant = ImageType::New();
+  size.Fill( 64 );
+  constant->SetRegions( size );
+  constant->Allocate();
+  constant->FillBuffer( 10.0f );
+
+  filter->SetInput( constant );
+  filter->SetNumberOfIterations( 5 );
+  filter->SetTimeStep( 0.1 );
+  filter->SetUseActiveTiles( true );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  TEST_EXPECT_EQUAL( filter->GetElapsedIterations(), 5u );
+  TEST_EXPECT_EQUAL( filter->GetNumberOfActiveTiles(), 0u );
+  TEST_EXPECT_EQUAL( MaximumDifference( constant, filter->GetOutput() ), 0.0 );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
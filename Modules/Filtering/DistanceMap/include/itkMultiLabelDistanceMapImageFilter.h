@@ -0,0 +1,263 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMultiLabelDistanceMapImageFilter_h
+#define itkMultiLabelDistanceMapImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkAtomicInt.h"
+#include <vector>
+#include <map>
+
+namespace itk
+{
+/** \class MultiLabelDistanceMapImageFilter
+ *
+ * \brief Compute, for all the labels of a label image at once, the distance
+ * of each pixel to the nearest pixel with a different label.
+ *
+ * The input is a label image, where every pixel value, including the
+ * background value, is a label. The filter produces two images:
+ *
+ * \li a <b>distance map</b> (GetDistanceMap(), the first output) giving for
+ * each pixel the Euclidean distance to the nearest pixel whose label is
+ * different from its own label. The distance between two pixels is measured
+ * between their centers, so that a pixel which touches a pixel of another
+ * label along a face is at one pixel (or one spacing) from it;
+ * \li a <b>nearest label map</b> (GetNearestLabelMap(), the second output)
+ * giving the label of that pixel.
+ *
+ * Both are computed with a single set of separable passes, one per
+ * dimension, like in SignedMaurerDistanceMapImageFilter. Each pass keeps,
+ * for each pixel, the two nearest feature pixels with distinct labels,
+ * which is enough to get the nearest pixel of a different label for all the
+ * labels at once. The lines of a pass are processed in parallel. If the
+ * image contains a single label, the distance is the maximum value of the
+ * output pixel type and the nearest label is the pixel's own label.
+ *
+ * When ComputeLabelDistanceMaps is on, the filter also computes, for each
+ * label other than the BackgroundValue, a signed distance map of that label
+ * restricted to its bounding box enlarged by LabelDistanceMapPadding, of
+ * at least one pixel. The values are the ones
+ * SignedMaurerDistanceMapImageFilter produces on the whole binary image of
+ * the label (with the same UseImageSpacing, SquaredDistance and
+ * InsideIsPositive settings), but each map only covers the neighborhood of
+ * its label, and the labels are processed in parallel.
+ * They can be retrieved with GetLabelDistanceMap() after the update.
+ *
+ * \sa SignedMaurerDistanceMapImageFilter DanielssonDistanceMapImageFilter
+ *
+ * \ingroup ImageFeatureExtraction
+ * \ingroup ITKDistanceMap
+ */
+template< typename TInputImage, typename TOutputImage >
+class ITK_TEMPLATE_EXPORT MultiLabelDistanceMapImageFilter:
+  public ImageToImageFilter< TInputImage, TOutputImage >
+{
+public:
+  /** Standard class typedefs. */
+  typedef MultiLabelDistanceMapImageFilter                Self;
+  typedef ImageToImageFilter< TInputImage, TOutputImage > Superclass;
+  typedef SmartPointer< Self >                            Pointer;
+  typedef SmartPointer< const Self >                      ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(MultiLabelDistanceMapImageFilter, ImageToImageFilter);
+
+  /** Extract dimension from input and output image. */
+  itkStaticConstMacro(ImageDimension, unsigned int,
+                      TOutputImage::ImageDimension);
+
+  /** Convenient typedefs for simplifying declarations. */
+  typedef TInputImage                             InputImageType;
+  typedef typename InputImageType::PixelType      InputPixelType;
+  typedef TOutputImage                            OutputImageType;
+  typedef typename OutputImageType::Pointer       OutputImagePointer;
+  typedef typename OutputImageType::PixelType     OutputPixelType;
+  typedef typename OutputImageType::RegionType    OutputImageRegionType;
+  typedef typename OutputImageType::IndexType     IndexType;
+  typedef typename OutputImageType::SizeType      SizeType;
+  typedef typename OutputImageType::SpacingType   SpacingType;
+
+  /** The nearest label map has the type of the input. */
+  typedef InputImageType  LabelImageType;
+  typedef InputPixelType  LabelType;
+
+  typedef std::vector< LabelType > LabelVectorType;
+
+  /** The type used for the squared distances during the computation. */
+  typedef typename NumericTraits< OutputPixelType >::FloatType DistanceType;
+
+  typedef ProcessObject::DataObjectPointerArraySizeType DataObjectPointerArraySizeType;
+
+  /** Set/Get whether the image spacing is used in computing the distances.
+   * Defaults to true. */
+  itkSetMacro(UseImageSpacing, bool);
+  itkGetConstReferenceMacro(UseImageSpacing, bool);
+  itkBooleanMacro(UseImageSpacing);
+
+  /** Set/Get whether the squared distances are produced. Defaults to
+   * false. */
+  itkSetMacro(SquaredDistance, bool);
+  itkGetConstReferenceMacro(SquaredDistance, bool);
+  itkBooleanMacro(SquaredDistance);
+
+  /** Set/Get whether the inside of the labels has positive values in the
+   * label distance maps. Defaults to false. */
+  itkSetMacro(InsideIsPositive, bool);
+  itkGetConstReferenceMacro(InsideIsPositive, bool);
+  itkBooleanMacro(InsideIsPositive);
+
+  /** Set/Get the background value, which doesn't get a label distance map.
+   * Defaults to zero. */
+  itkSetMacro(BackgroundValue, LabelType);
+  itkGetConstReferenceMacro(BackgroundValue, LabelType);
+
+  /** Set/Get whether the signed distance map of each label is computed in
+   * its bounding box. Defaults to false. */
+  itkSetMacro(ComputeLabelDistanceMaps, bool);
+  itkGetConstReferenceMacro(ComputeLabelDistanceMaps, bool);
+  itkBooleanMacro(ComputeLabelDistanceMaps);
+
+  /** Set/Get the number of pixels added on each side of the bounding box of
+   * a label to get the region of its distance map. Defaults to 1. A padding
+   * of 0 is used as 1, since the distance map of a label only matches the
+   * one of the whole image when the box has a border of pixels outside of
+   * the label, or is cropped by the image. */
+  itkSetMacro(LabelDistanceMapPadding, SizeType);
+  itkGetConstReferenceMacro(LabelDistanceMapPadding, SizeType);
+
+  /** Get the distance map, the first output. */
+  OutputImageType * GetDistanceMap();
+
+  /** Get the nearest label map, the second output. */
+  LabelImageType * GetNearestLabelMap();
+
+  /** Get the labels which have a label distance map, sorted in increasing
+   * order. */
+  const LabelVectorType & GetLabels() const
+  { return m_Labels; }
+
+  /** Get the signed distance map of a label, or ITK_NULLPTR if the label
+   * has no distance map. */
+  const OutputImageType * GetLabelDistanceMap(const LabelType & label) const;
+
+  using Superclass::MakeOutput;
+  virtual DataObject::Pointer MakeOutput(DataObjectPointerArraySizeType idx) ITK_OVERRIDE;
+
+#ifdef ITK_USE_CONCEPT_CHECKING
+  // Begin concept checking
+  itkConceptMacro( SameDimensionCheck,
+                   ( Concept::SameDimension< InputImageType::ImageDimension, OutputImageType::ImageDimension > ) );
+  itkConceptMacro( InputComparableCheck,
+                   ( Concept::EqualityComparable< InputPixelType > ) );
+  // End concept checking
+#endif
+
+protected:
+  MultiLabelDistanceMapImageFilter();
+  virtual ~MultiLabelDistanceMapImageFilter() {}
+
+  virtual void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
+
+  /** The whole input is needed to compute any part of the output. */
+  virtual void GenerateInputRequestedRegion() ITK_OVERRIDE;
+
+  virtual void EnlargeOutputRequestedRegion(DataObject *data) ITK_OVERRIDE;
+
+  virtual void GenerateData() ITK_OVERRIDE;
+
+  /** Split the requested region without splitting the dimension of the
+   * current pass. */
+  virtual unsigned int SplitRequestedRegion(unsigned int i, unsigned int num,
+                                            OutputImageRegionType & splitRegion) ITK_OVERRIDE;
+
+  /** Compute the current pass on the lines of the region. */
+  virtual void ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                                    ThreadIdType threadId) ITK_OVERRIDE;
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(MultiLabelDistanceMapImageFilter);
+
+  /** The two nearest feature pixels with distinct labels found so far for
+   * a pixel, as their squared distances and labels. m_Distance[0] is
+   * smaller than or equal to m_Distance[1]; a missing feature has the
+   * maximum distance. */
+  struct FeatureType {
+    DistanceType m_Distance[2];
+    LabelType    m_Label[2];
+  };
+
+  /** Scratch buffers of a thread for the computation of a line. */
+  struct LineScratchType {
+    std::vector< FeatureType >   m_Input;
+    std::vector< FeatureType >   m_Output;
+    std::vector< DistanceType >  m_Position;
+    std::vector< DistanceType >  m_Height;
+    std::vector< LabelType >     m_Label;
+    std::vector< SizeValueType > m_Site;
+    std::vector< SizeValueType > m_Envelope;
+    std::vector< DistanceType >  m_Boundary;
+  };
+
+  /** Compute the two nearest features with distinct labels of the pixels of
+   * a line from the features of the previous pass. */
+  void ComputeLine(SizeValueType length, LineScratchType & scratch) const;
+
+  /** Evaluate, on the pixels [begin, end) of the line, the lower envelope
+   * of the parabolas whose sites, heights and labels are in the first
+   * numberOfSites elements of the scratch buffers, and store it in feature
+   * number k of the output features. */
+  void EvaluateLowerEnvelope(SizeValueType numberOfSites, SizeValueType begin, SizeValueType end,
+                             unsigned int k, LineScratchType & scratch) const;
+
+  static ITK_THREAD_RETURN_TYPE LabelDistanceMapsThreaderCallback(void *arg);
+
+  /** Compute the distance map of the label number i of m_Labels. */
+  void ComputeLabelDistanceMap(SizeValueType i);
+
+  bool      m_UseImageSpacing;
+  bool      m_SquaredDistance;
+  bool      m_InsideIsPositive;
+  LabelType m_BackgroundValue;
+  bool      m_ComputeLabelDistanceMaps;
+  SizeType  m_LabelDistanceMapPadding;
+
+  unsigned int               m_CurrentDimension;
+  std::vector< FeatureType > m_Features;
+
+  /** Bounding boxes of the labels found by each thread in the first pass,
+   * as the pairs of their minimum and maximum indices. */
+  typedef std::pair< IndexType, IndexType >       BoundingBoxType;
+  typedef std::map< LabelType, BoundingBoxType >  BoundingBoxMapType;
+  std::vector< BoundingBoxMapType > m_ThreadBoundingBoxes;
+
+  LabelVectorType                   m_Labels;
+  std::vector< BoundingBoxType >    m_BoundingBoxes;
+  std::vector< OutputImagePointer > m_LabelDistanceMaps;
+  AtomicInt< SizeValueType >        m_NextLabel;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkMultiLabelDistanceMapImageFilter.hxx"
+#endif
+
+#endif
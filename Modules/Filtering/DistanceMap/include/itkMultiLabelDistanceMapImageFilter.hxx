@@ -0,0 +1,655 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMultiLabelDistanceMapImageFilter_hxx
+#define itkMultiLabelDistanceMapImageFilter_hxx
+
+#include "itkMultiLabelDistanceMapImageFilter.h"
+#include "itkSignedMaurerDistanceMapImageFilter.h"
+#include "itkImageLinearIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkProgressReporter.h"
+#include "itkMath.h"
+#include <algorithm>
+
+namespace itk
+{
+template< typename TInputImage, typename TOutputImage >
+MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >
+::MultiLabelDistanceMapImageFilter():
+  m_UseImageSpacing(true),
+  m_SquaredDistance(false),
+  m_InsideIsPositive(false),
+  m_BackgroundValue( NumericTraits< LabelType >::ZeroValue() ),
+  m_ComputeLabelDistanceMaps(false),
+  m_CurrentDimension(0)
+{
+  m_LabelDistanceMapPadding.Fill(1);
+
+  this->SetNumberOfRequiredOutputs(2);
+  this->SetNthOutput( 1, this->MakeOutput( 1 ) );
+}
+
+template< typename TInputImage, typename TOutputImage >
+DataObject::Pointer
+MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >
+::MakeOutput(DataObjectPointerArraySizeType idx)
+{
+  if ( idx == 1 )
+    {
+    return LabelImageType::New().GetPointer();
+    }
+  return Superclass::MakeOutput( idx );
+}
+
+template< typename TInputImage, typename TOutputImage >
+typename MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >::OutputImageType *
+MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >
+::GetDistanceMap()
+{
+  return dynamic_cast< OutputImageType * >( this->ProcessObject::GetOutput(0) );
+}
+
+template< typename TInputImage, typename TOutputImage >
+typename MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >::LabelImageType *
+MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >
+::GetNearestLabelMap()
+{
+  return dynamic_cast< LabelImageType * >( this->ProcessObject::GetOutput(1) );
+}
+
+template< typename TInputImage, typename TOutputImage >
+const typename MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >::OutputImageType *
+MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >
+::GetLabelDistanceMap(const LabelType & label) const
+{
+  typename LabelVectorType::const_iterator it = std::lower_bound(m_Labels.begin(), m_Labels.end(), label);
+  if ( it == m_Labels.end() || *it != label )
+    {
+    return ITK_NULLPTR;
+    }
+  return m_LabelDistanceMaps[it - m_Labels.begin()].GetPointer();
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >
+::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  if ( this->GetInput() )
+    {
+    InputImageType *input = const_cast< InputImageType * >( this->GetInput() );
+    input->SetRequestedRegionToLargestPossibleRegion();
+    }
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >
+::EnlargeOutputRequestedRegion(DataObject *data)
+{
+  Superclass::EnlargeOutputRequestedRegion(data);
+  data->SetRequestedRegionToLargestPossibleRegion();
+}
+
+template< typename TInputImage, typename TOutputImage >
+unsigned int
+MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >
+::SplitRequestedRegion(unsigned int i, unsigned int num,
+                       OutputImageRegionType & splitRegion)
+{
+  splitRegion = this->GetOutput()->GetRequestedRegion();
+
+  const SizeType & requestedRegionSize = splitRegion.GetSize();
+
+  IndexType splitIndex = splitRegion.GetIndex();
+  SizeType  splitSize = splitRegion.GetSize();
+
+  // split on the outermost dimension available
+  // and avoid the current dimension
+  int splitAxis = static_cast< int >( ImageDimension ) - 1;
+  while ( ( requestedRegionSize[splitAxis] == 1 ) ||
+          ( splitAxis == static_cast< int >( m_CurrentDimension ) ) )
+    {
+    --splitAxis;
+    if ( splitAxis < 0 )
+      { // cannot split
+      itkDebugMacro("Cannot Split");
+      return 1;
+      }
+    }
+
+  // determine the actual number of pieces that will be generated
+  const SizeValueType range = requestedRegionSize[splitAxis];
+  const SizeValueType valuesPerThread = ( range + num - 1 ) / num;
+  const unsigned int  maxThreadIdUsed =
+    static_cast< unsigned int >( ( range + valuesPerThread - 1 ) / valuesPerThread ) - 1;
+
+  // Split the region
+  if ( i < maxThreadIdUsed )
+    {
+    splitIndex[splitAxis] += i * valuesPerThread;
+    splitSize[splitAxis] = valuesPerThread;
+    }
+  if ( i == maxThreadIdUsed )
+    {
+    splitIndex[splitAxis] += i * valuesPerThread;
+    // last thread needs to process the "rest" dimension being split
+    splitSize[splitAxis] = splitSize[splitAxis] - i * valuesPerThread;
+    }
+
+  splitRegion.SetIndex(splitIndex);
+  splitRegion.SetSize(splitSize);
+
+  itkDebugMacro("Split Piece: " << splitRegion);
+
+  return maxThreadIdUsed + 1;
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >
+::GenerateData()
+{
+  this->AllocateOutputs();
+
+  const OutputImageRegionType region = this->GetDistanceMap()->GetRequestedRegion();
+  const ThreadIdType          numberOfThreads = this->GetNumberOfThreads();
+
+  m_Labels.clear();
+  m_BoundingBoxes.clear();
+  m_LabelDistanceMaps.clear();
+  m_ThreadBoundingBoxes.assign( numberOfThreads, BoundingBoxMapType() );
+  std::vector< FeatureType >( region.GetNumberOfPixels() ).swap(m_Features);
+
+  // Set up the multithreaded processing
+  typename ImageSource< OutputImageType >::ThreadStruct str;
+  str.Filter = this;
+
+  MultiThreader *multithreader = this->GetMultiThreader();
+  multithreader->SetNumberOfThreads( numberOfThreads );
+  multithreader->SetSingleMethod(this->ThreaderCallback, &str);
+
+  // one pass per dimension
+  for ( unsigned int d = 0; d < ImageDimension; d++ )
+    {
+    m_CurrentDimension = d;
+    multithreader->SingleMethodExecute();
+    }
+  std::vector< FeatureType >().swap(m_Features);
+
+  if ( m_ComputeLabelDistanceMaps )
+    {
+    // merge the bounding boxes found by the threads
+    BoundingBoxMapType boxes;
+    for ( ThreadIdType t = 0; t < m_ThreadBoundingBoxes.size(); t++ )
+      {
+      for ( typename BoundingBoxMapType::const_iterator it = m_ThreadBoundingBoxes[t].begin();
+            it != m_ThreadBoundingBoxes[t].end(); ++it )
+        {
+        typename BoundingBoxMapType::iterator boxIt = boxes.find(it->first);
+        if ( boxIt == boxes.end() )
+          {
+          boxes.insert(*it);
+          }
+        else
+          {
+          for ( unsigned int d = 0; d < ImageDimension; d++ )
+            {
+            boxIt->second.first[d] = std::min( boxIt->second.first[d], it->second.first[d] );
+            boxIt->second.second[d] = std::max( boxIt->second.second[d], it->second.second[d] );
+            }
+          }
+        }
+      }
+    for ( typename BoundingBoxMapType::const_iterator it = boxes.begin(); it != boxes.end(); ++it )
+      {
+      if ( it->first != m_BackgroundValue )
+        {
+        m_Labels.push_back(it->first);
+        m_BoundingBoxes.push_back(it->second);
+        }
+      }
+    m_LabelDistanceMaps.resize( m_Labels.size() );
+
+    // the labels are dispatched to the threads one at a time, as their
+    // sizes may be very different
+    m_NextLabel = 0;
+    multithreader->SetSingleMethod(this->LabelDistanceMapsThreaderCallback, this);
+    multithreader->SingleMethodExecute();
+    }
+  m_ThreadBoundingBoxes.clear();
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >
+::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
+                       ThreadIdType threadId)
+{
+  const unsigned int d = m_CurrentDimension;
+  const bool         firstPass = ( d == 0 );
+  const bool         lastPass = ( d == ImageDimension - 1 );
+
+  const InputImageType *input = this->GetInput();
+  OutputImageType *     distanceMap = this->GetDistanceMap();
+  LabelImageType *      nearestLabelMap = this->GetNearestLabelMap();
+
+  const SizeValueType   length = outputRegionForThread.GetSize()[d];
+  const OffsetValueType stride = distanceMap->GetOffsetTable()[d];
+  const DistanceType    maximumDistance = NumericTraits< DistanceType >::max();
+
+  // The scratch buffers of this thread, allocated once for all its lines
+  LineScratchType scratch;
+  scratch.m_Input.resize(length);
+  scratch.m_Output.resize(length);
+  scratch.m_Position.resize(length);
+  scratch.m_Height.resize(length);
+  scratch.m_Label.resize(length);
+  scratch.m_Site.resize(length);
+  scratch.m_Envelope.resize(length);
+  scratch.m_Boundary.resize(length + 1);
+
+  DistanceType spacing = NumericTraits< DistanceType >::OneValue();
+  if ( m_UseImageSpacing )
+    {
+    spacing = static_cast< DistanceType >( distanceMap->GetSpacing()[d] );
+    }
+  for ( SizeValueType i = 0; i < length; i++ )
+    {
+    scratch.m_Position[i] = static_cast< DistanceType >( i ) * spacing;
+    }
+
+  FeatureType *       features = &m_Features[0];
+  BoundingBoxMapType &boxes = m_ThreadBoundingBoxes[threadId];
+
+  const float progressPerDimension = ( m_ComputeLabelDistanceMaps ? 0.8f : 1.0f ) / ImageDimension;
+  ProgressReporter progress(this, threadId,
+                            outputRegionForThread.GetNumberOfPixels() / length, 100,
+                            d * progressPerDimension, progressPerDimension);
+
+  ImageLinearConstIteratorWithIndex< InputImageType > inputIt(input, outputRegionForThread);
+  ImageLinearIteratorWithIndex< OutputImageType >     distanceIt(distanceMap, outputRegionForThread);
+  ImageLinearIteratorWithIndex< LabelImageType >      labelIt(nearestLabelMap, outputRegionForThread);
+  inputIt.SetDirection(d);
+  distanceIt.SetDirection(d);
+  labelIt.SetDirection(d);
+  inputIt.GoToBegin();
+  distanceIt.GoToBegin();
+  labelIt.GoToBegin();
+
+  while ( !inputIt.IsAtEnd() )
+    {
+    FeatureType *line = features + distanceMap->ComputeOffset( inputIt.GetIndex() );
+
+    if ( firstPass )
+      {
+      // each pixel is its own nearest feature
+      typename BoundingBoxMapType::iterator boxIt = boxes.end();
+      for ( SizeValueType i = 0; !inputIt.IsAtEndOfLine(); ++inputIt, ++i )
+        {
+        const LabelType label = inputIt.Get();
+        FeatureType &   feature = scratch.m_Input[i];
+        feature.m_Distance[0] = NumericTraits< DistanceType >::ZeroValue();
+        feature.m_Distance[1] = maximumDistance;
+        feature.m_Label[0] = label;
+        feature.m_Label[1] = label;
+
+        if ( m_ComputeLabelDistanceMaps )
+          {
+          const IndexType & index = inputIt.GetIndex();
+          if ( boxIt == boxes.end() || boxIt->first != label )
+            {
+            boxIt = boxes.find(label);
+            if ( boxIt == boxes.end() )
+              {
+              boxIt = boxes.insert( std::make_pair( label, BoundingBoxType(index, index) ) ).first;
+              }
+            }
+          for ( unsigned int k = 0; k < ImageDimension; k++ )
+            {
+            boxIt->second.first[k] = std::min( boxIt->second.first[k], index[k] );
+            boxIt->second.second[k] = std::max( boxIt->second.second[k], index[k] );
+            }
+          }
+        }
+      if ( lastPass )
+        {
+        inputIt.GoToBeginOfLine();
+        }
+      }
+    else
+      {
+      for ( SizeValueType i = 0; i < length; i++ )
+        {
+        scratch.m_Input[i] = line[static_cast< OffsetValueType >( i ) * stride];
+        }
+      }
+
+    this->ComputeLine(length, scratch);
+
+    if ( lastPass )
+      {
+      // keep the nearest feature whose label is not the one of the pixel
+      for ( SizeValueType i = 0; !inputIt.IsAtEndOfLine(); ++inputIt, ++distanceIt, ++labelIt, ++i )
+        {
+        const LabelType     label = inputIt.Get();
+        const FeatureType & feature = scratch.m_Output[i];
+        unsigned int        k = 1;
+        if ( feature.m_Distance[0] < maximumDistance && feature.m_Label[0] != label )
+          {
+          k = 0;
+          }
+        if ( feature.m_Distance[k] < maximumDistance )
+          {
+          DistanceType distance = feature.m_Distance[k];
+          if ( !m_SquaredDistance )
+            {
+            distance = std::sqrt(distance);
+            }
+          distanceIt.Set( static_cast< OutputPixelType >( distance ) );
+          labelIt.Set( feature.m_Label[k] );
+          }
+        else
+          {
+          distanceIt.Set( NumericTraits< OutputPixelType >::max() );
+          labelIt.Set( label );
+          }
+        }
+      }
+    else
+      {
+      for ( SizeValueType i = 0; i < length; i++ )
+        {
+        line[static_cast< OffsetValueType >( i ) * stride] = scratch.m_Output[i];
+        }
+      }
+
+    inputIt.NextLine();
+    distanceIt.NextLine();
+    labelIt.NextLine();
+    progress.CompletedPixel();
+    }
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >
+::ComputeLine(SizeValueType length, LineScratchType & scratch) const
+{
+  const DistanceType  maximumDistance = NumericTraits< DistanceType >::max();
+  const FeatureType * input = &scratch.m_Input[0];
+  FeatureType *       output = &scratch.m_Output[0];
+
+  for ( SizeValueType i = 0; i < length; i++ )
+    {
+    output[i].m_Distance[0] = maximumDistance;
+    output[i].m_Distance[1] = maximumDistance;
+    output[i].m_Label[0] = input[i].m_Label[0];
+    output[i].m_Label[1] = input[i].m_Label[0];
+    }
+
+  // The nearest feature: the lower envelope of the parabolas of the
+  // nearest features of the pixels of the line.
+  SizeValueType numberOfSites = 0;
+  for ( SizeValueType i = 0; i < length; i++ )
+    {
+    if ( input[i].m_Distance[0] < maximumDistance )
+      {
+      scratch.m_Site[numberOfSites] = i;
+      scratch.m_Height[numberOfSites] = input[i].m_Distance[0];
+      scratch.m_Label[numberOfSites] = input[i].m_Label[0];
+      ++numberOfSites;
+      }
+    }
+  if ( numberOfSites == 0 )
+    {
+    return;
+    }
+  this->EvaluateLowerEnvelope(numberOfSites, 0, length, 0, scratch);
+
+  // The nearest feature with another label: on each run of pixels whose
+  // nearest feature has the same label, the lower envelope of the features
+  // with a different label of the pixels of the line. The square root of
+  // that envelope is 1-Lipschitz, and the pixels just before and after the
+  // run have a nearest feature with a different label, so they bound the
+  // distances over the run, and only the sites within these bounds are
+  // needed. The cost of a line is then linear in its length instead of
+  // growing with the number of runs.
+  const DistanceType *position = &scratch.m_Position[0];
+  SizeValueType       begin = 0;
+  while ( begin < length )
+    {
+    const LabelType label = output[begin].m_Label[0];
+    SizeValueType   end = begin + 1;
+    while ( end < length && output[end].m_Label[0] == label )
+      {
+      ++end;
+      }
+
+    bool         bounded = false;
+    DistanceType lower = NumericTraits< DistanceType >::ZeroValue();
+    DistanceType upper = NumericTraits< DistanceType >::ZeroValue();
+    if ( begin > 0 && output[begin - 1].m_Distance[0] < maximumDistance )
+      {
+      const DistanceType radius = std::sqrt( output[begin - 1].m_Distance[0] );
+      lower = position[begin - 1] - radius;
+      upper = 2 * position[end - 1] - position[begin - 1] + radius;
+      bounded = true;
+      }
+    if ( end < length && output[end].m_Distance[0] < maximumDistance )
+      {
+      const DistanceType radius = std::sqrt( output[end].m_Distance[0] );
+      const DistanceType endLower = 2 * position[begin] - position[end] - radius;
+      const DistanceType endUpper = position[end] + radius;
+      lower = bounded ? std::max( lower, endLower ) : endLower;
+      upper = bounded ? std::min( upper, endUpper ) : endUpper;
+      bounded = true;
+      }
+    SizeValueType first = 0;
+    SizeValueType last = length;
+    if ( bounded )
+      {
+      first = begin;
+      while ( first > 0 && position[first - 1] >= lower )
+        {
+        --first;
+        }
+      last = end;
+      while ( last < length && position[last] <= upper )
+        {
+        ++last;
+        }
+      // one more pixel on each side for the rounding of the square roots
+      first = ( first > 0 ) ? first - 1 : 0;
+      last = ( last < length ) ? last + 1 : length;
+      }
+
+    numberOfSites = 0;
+    for ( SizeValueType i = first; i < last; i++ )
+      {
+      const FeatureType & feature = input[i];
+      unsigned int        k = 0;
+      if ( feature.m_Label[0] == label )
+        {
+        k = 1;
+        }
+      if ( feature.m_Distance[k] < maximumDistance )
+        {
+        scratch.m_Site[numberOfSites] = i;
+        scratch.m_Height[numberOfSites] = feature.m_Distance[k];
+        scratch.m_Label[numberOfSites] = feature.m_Label[k];
+        ++numberOfSites;
+        }
+      }
+    if ( numberOfSites > 0 )
+      {
+      this->EvaluateLowerEnvelope(numberOfSites, begin, end, 1, scratch);
+      }
+    begin = end;
+    }
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >
+::EvaluateLowerEnvelope(SizeValueType numberOfSites, SizeValueType begin, SizeValueType end,
+                        unsigned int k, LineScratchType & scratch) const
+{
+  const DistanceType *  position = &scratch.m_Position[0];
+  const SizeValueType * site = &scratch.m_Site[0];
+  const DistanceType *  height = &scratch.m_Height[0];
+  SizeValueType *       envelope = &scratch.m_Envelope[0];
+  DistanceType *        boundary = &scratch.m_Boundary[0];
+
+  // Felzenszwalb and Huttenlocher's construction of the lower envelope of
+  // the parabolas. boundary[j] is the position where parabola j of the
+  // envelope starts to be the lowest one.
+  SizeValueType last = 0;
+  envelope[0] = 0;
+  for ( SizeValueType c = 1; c < numberOfSites; c++ )
+    {
+    const DistanceType pc = position[site[c]];
+    const DistanceType fc = height[c] + pc * pc;
+    DistanceType       s;
+    while ( true )
+      {
+      const SizeValueType v = envelope[last];
+      const DistanceType  pv = position[site[v]];
+      s = ( fc - ( height[v] + pv * pv ) ) / ( 2 * ( pc - pv ) );
+      if ( last > 0 && s <= boundary[last] )
+        {
+        --last;
+        }
+      else
+        {
+        break;
+        }
+      }
+    ++last;
+    envelope[last] = c;
+    boundary[last] = s;
+    }
+
+  SizeValueType j = 0;
+  for ( SizeValueType i = begin; i < end; i++ )
+    {
+    const DistanceType x = position[i];
+    while ( j < last && boundary[j + 1] < x )
+      {
+      ++j;
+      }
+    const SizeValueType v = envelope[j];
+    const DistanceType  dx = x - position[site[v]];
+    scratch.m_Output[i].m_Distance[k] = height[v] + dx * dx;
+    scratch.m_Output[i].m_Label[k] = scratch.m_Label[v];
+    }
+}
+
+template< typename TInputImage, typename TOutputImage >
+ITK_THREAD_RETURN_TYPE
+MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >
+::LabelDistanceMapsThreaderCallback(void *arg)
+{
+  Self *filter = static_cast< Self * >(
+    static_cast< MultiThreader::ThreadInfoStruct * >( arg )->UserData );
+
+  const SizeValueType numberOfLabels = filter->m_Labels.size();
+  while ( true )
+    {
+    const SizeValueType i = ( filter->m_NextLabel++ );
+    if ( i >= numberOfLabels )
+      {
+      break;
+      }
+    filter->ComputeLabelDistanceMap(i);
+    }
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >
+::ComputeLabelDistanceMap(SizeValueType i)
+{
+  typedef Image< unsigned char, ImageDimension >                              BinaryImageType;
+  typedef SignedMaurerDistanceMapImageFilter< BinaryImageType, OutputImageType > DistanceFilterType;
+
+  const InputImageType * input = this->GetInput();
+  const LabelType        label = m_Labels[i];
+
+  // the bounding box of the label, padded and cropped to the image; at
+  // least one pixel of padding is needed for the pixels outside of the
+  // label at the border of the box to get their distance in the whole image
+  IndexType index;
+  SizeType  size;
+  for ( unsigned int d = 0; d < ImageDimension; d++ )
+    {
+    const SizeValueType padding = std::max( m_LabelDistanceMapPadding[d], NumericTraits< SizeValueType >::OneValue() );
+    index[d] = m_BoundingBoxes[i].first[d] - static_cast< IndexValueType >( padding );
+    size[d] = static_cast< SizeValueType >( m_BoundingBoxes[i].second[d] - m_BoundingBoxes[i].first[d] + 1 )
+              + 2 * padding;
+    }
+  OutputImageRegionType region(index, size);
+  region.Crop( input->GetLargestPossibleRegion() );
+
+  typename BinaryImageType::Pointer binary = BinaryImageType::New();
+  binary->CopyInformation(input);
+  binary->SetRegions(region);
+  binary->Allocate();
+
+  ImageRegionConstIterator< InputImageType > inputIt(input, region);
+  ImageRegionIterator< BinaryImageType >     binaryIt(binary, region);
+  for ( ; !inputIt.IsAtEnd(); ++inputIt, ++binaryIt )
+    {
+    binaryIt.Set( inputIt.Get() == label ? 1 : 0 );
+    }
+
+  typename DistanceFilterType::Pointer distance = DistanceFilterType::New();
+  distance->SetInput(binary);
+  distance->SetBackgroundValue(0);
+  distance->SetUseImageSpacing(m_UseImageSpacing);
+  distance->SetSquaredDistance(m_SquaredDistance);
+  distance->SetInsideIsPositive(m_InsideIsPositive);
+  distance->SetNumberOfThreads(1);
+  distance->Update();
+
+  OutputImagePointer labelDistanceMap = distance->GetOutput();
+  labelDistanceMap->DisconnectPipeline();
+  m_LabelDistanceMaps[i] = labelDistanceMap;
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+MultiLabelDistanceMapImageFilter< TInputImage, TOutputImage >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "UseImageSpacing: " << m_UseImageSpacing << std::endl;
+  os << indent << "SquaredDistance: " << m_SquaredDistance << std::endl;
+  os << indent << "InsideIsPositive: " << m_InsideIsPositive << std::endl;
+  os << indent << "BackgroundValue: "
+     << static_cast< typename NumericTraits< LabelType >::PrintType >( m_BackgroundValue ) << std::endl;
+  os << indent << "ComputeLabelDistanceMaps: " << m_ComputeLabelDistanceMaps << std::endl;
+  os << indent << "LabelDistanceMapPadding: " << m_LabelDistanceMapPadding << std::endl;
+  os << indent << "Number of label distance maps: " << m_LabelDistanceMaps.size() << std::endl;
+}
+} // end namespace itk
+
+#endif
@@ -19,6 +19,7 @@
 #define itkSignedMaurerDistanceMapImageFilter_h
 
 #include "itkImageToImageFilter.h"
+#include "itkMath.h"
 
 namespace itk
 {
@@ -154,6 +155,19 @@ public:
   itkSetMacro(BackgroundValue, InputPixelType);
   itkGetConstReferenceMacro(BackgroundValue, InputPixelType);
 
+  /**
+   * Set/Get the maximum distance of interest, in physical units when
+   * UseImageSpacing is on and in pixels otherwise. The distances are only
+   * propagated up to this value: the pixels which are farther from the
+   * object boundary get the maximum distance (or its square when
+   * SquaredDistance is on), with the usual sign, and the lines without any
+   * pixel within that distance are skipped. The other pixels get the exact
+   * distance. Defaults to the maximum value of the output pixel type, which
+   * doesn't limit the distances.
+   */
+  itkSetMacro(MaximumDistance, OutputPixelType);
+  itkGetConstReferenceMacro(MaximumDistance, OutputPixelType);
+
 protected:
   SignedMaurerDistanceMapImageFilter();
   virtual ~SignedMaurerDistanceMapImageFilter();
@@ -171,7 +185,12 @@ protected:
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(SignedMaurerDistanceMapImageFilter);
 
-  void Voronoi(unsigned int, OutputIndexType idx, OutputImageType *output );
+  /** Compute the distances along the line of nd pixels of dimension d
+   * starting at idx, stored contiguously in line. g and h are scratch
+   * buffers of nd values. Return false when the line has no feature point
+   * and was left unchanged. */
+  bool Voronoi(unsigned int d, OutputSizeValueType nd, OutputIndexType idx,
+               OutputPixelType *line, OutputPixelType *g, OutputPixelType *h);
   bool Remove(OutputPixelType, OutputPixelType, OutputPixelType,
               OutputPixelType, OutputPixelType, OutputPixelType);
 
@@ -184,6 +203,14 @@ private:
   bool m_UseImageSpacing;
   bool m_SquaredDistance;
 
+  OutputPixelType m_MaximumDistance;
+  OutputPixelType m_MaximumSquaredDistance;
+
+  bool IsBandLimited() const
+  {
+    return Math::NotExactlyEquals( m_MaximumSquaredDistance, NumericTraits< OutputPixelType >::max() );
+  }
+
   const InputImageType *m_InputCache;
 };
 } // end namespace itk
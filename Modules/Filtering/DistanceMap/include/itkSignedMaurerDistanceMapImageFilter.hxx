@@ -20,13 +20,13 @@
 
 #include "itkSignedMaurerDistanceMapImageFilter.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageLinearIteratorWithIndex.h"
 #include "itkBinaryThresholdImageFilter.h"
 #include "itkBinaryContourImageFilter.h"
 #include "itkProgressReporter.h"
 #include "itkProgressAccumulator.h"
 #include "itkMath.h"
-#include "vnl/vnl_vector.h"
-#include "itkMath.h"
+#include <vector>
 
 namespace itk
 {
@@ -39,6 +39,8 @@ SignedMaurerDistanceMapImageFilter< TInputImage, TOutputImage >
   m_InsideIsPositive(false),
   m_UseImageSpacing(true),
   m_SquaredDistance(false),
+  m_MaximumDistance( NumericTraits< OutputPixelType >::max() ),
+  m_MaximumSquaredDistance( NumericTraits< OutputPixelType >::max() ),
   m_InputCache(ITK_NULLPTR)
 {}
 
@@ -123,6 +125,21 @@ SignedMaurerDistanceMapImageFilter< TInputImage, TOutputImage >
   this->AllocateOutputs();
   this->m_Spacing = outputPtr->GetSpacing();
 
+  // The distances are propagated as squared distances. A maximum distance
+  // whose square can't be represented in the output pixel type doesn't
+  // limit anything.
+  const double maximumDistance = static_cast< double >( this->m_MaximumDistance );
+  const double maximumSquaredDistance = maximumDistance * maximumDistance;
+  if ( maximumDistance >= 0.0
+       && maximumSquaredDistance < static_cast< double >( NumericTraits< OutputPixelType >::max() ) )
+    {
+    this->m_MaximumSquaredDistance = static_cast< OutputPixelType >( maximumSquaredDistance );
+    }
+  else
+    {
+    this->m_MaximumSquaredDistance = NumericTraits< OutputPixelType >::max();
+    }
+
   // store the binary image in an image with a pixel type as small as possible
   // instead of keeping the native input pixel type to avoid using too much
   // memory.
@@ -184,87 +201,94 @@ SignedMaurerDistanceMapImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread,
                        ThreadIdType threadId)
 {
-  OutputImageType      *outputImage = this->GetOutput();
-
-  InputRegionType region = outputRegionForThread;
-  InputSizeType   size   = region.GetSize();
-  InputIndexType  startIndex = outputRegionForThread.GetIndex();
-
   OutputImageType      *outputPtr = this->GetOutput();
 
-  // compute the number of rows first, so we can setup a progress reporter
-  std::vector< InputSizeValueType > NumberOfRows;
-  for ( unsigned int i = 0; i < InputImageDimension; i++ )
-    {
-    NumberOfRows.push_back(1);
-    for ( unsigned int d = 0; d < InputImageDimension; d++ )
-      {
-      if ( d != i )
-        {
-        NumberOfRows[i] *= size[d];
-        }
-      }
-    }
+  const unsigned int        d = m_CurrentDimension;
+  const OutputSizeValueType nd = outputRegionForThread.GetSize()[d];
 
   // set the progress reporter. Use a pointer to be able to destroy it before
   // the creation of progress2
   // so it won't set wrong progress at the end of ThreadedGenerateData()
+  const bool finalPass = !this->m_SquaredDistance || this->IsBandLimited();
   float progressPerDimension = 0.67f / static_cast< float >( ImageDimension );
-  if ( !this->m_SquaredDistance )
+  if ( finalPass )
     {
     progressPerDimension = 0.67f / ( static_cast< float >( ImageDimension ) + 1 );
     }
   ProgressReporter *progress =
       new ProgressReporter(this,
                            threadId,
-                           NumberOfRows[m_CurrentDimension],
+                           outputRegionForThread.GetNumberOfPixels() / nd,
                            30,
                            0.33f + static_cast< float >( m_CurrentDimension * progressPerDimension ),
                            progressPerDimension);
 
-  // This variable provides the amount by which to divide the dimensionless index in order to get the index for each dimension.
-  vnl_vector< unsigned int > k(InputImageDimension - 1);
-  unsigned int count = 0;
-  k[count] = 1;
-  for ( unsigned int d = m_CurrentDimension + InputImageDimension - 1;
-         d > m_CurrentDimension + 1;
-         d-- )
-    {
-    k[count+1] = k[count] * size[d % InputImageDimension];
-    count++;
-    }
-  k.flip();
-
-  // The index is defined as the dimensionless index into the pixel.
-  // It must be divided by each dimension size in order to get the index for that dimension.
-  // The result of this division is the offsetIndex, which is the index offset relative to the region of this thread.
-  // The true pixel location (idx) is provided by the sum of the offsetIndex and the startIndex.
-  InputSizeValueType index;
-  OutputIndexType offsetIndex;
-  offsetIndex.Fill(0);
-  InputSizeValueType tempRow = NumberOfRows[m_CurrentDimension];
-  OutputIndexType idx;
-  idx.Fill(0);
-
-  for ( InputSizeValueType n = 0; n < tempRow; n++ )
+  // The scratch buffers of this thread, allocated once for all the lines of
+  // the pass. Lines along the current dimension which are adjacent in memory
+  // are processed together, so that each of their pixels can be gathered
+  // from, and scattered back to, a contiguous run of the output buffer
+  // instead of being accessed with a large stride one line at a time.
+  const SizeValueType maximumNumberOfLanes = 16;
+
+  std::vector< OutputPixelType > lines( nd * maximumNumberOfLanes );
+  std::vector< OutputPixelType > g( nd );
+  std::vector< OutputPixelType > h( nd );
+  std::vector< OutputIndexType > laneIndex( maximumNumberOfLanes );
+
+  OutputPixelType *     buffer = outputPtr->GetBufferPointer();
+  const OffsetValueType stride = outputPtr->GetOffsetTable()[d];
+
+  ImageLinearConstIteratorWithIndex< OutputImageType > lineIt(outputPtr, outputRegionForThread);
+  lineIt.SetDirection(d);
+  lineIt.GoToBegin();
+
+  while ( !lineIt.IsAtEnd() )
     {
-    index = n;
-    count = 0;
-    for ( unsigned int d = m_CurrentDimension + 1;
-         d < m_CurrentDimension + InputImageDimension; d++ )
+    laneIndex[0] = lineIt.GetIndex();
+    OutputPixelType *start = buffer + outputPtr->ComputeOffset(laneIndex[0]);
+    SizeValueType    numberOfLanes = 1;
+    lineIt.NextLine();
+    while ( numberOfLanes < maximumNumberOfLanes && !lineIt.IsAtEnd()
+            && buffer + outputPtr->ComputeOffset( lineIt.GetIndex() ) == start + numberOfLanes )
+      {
+      laneIndex[numberOfLanes++] = lineIt.GetIndex();
+      lineIt.NextLine();
+      }
+
+    for ( OutputSizeValueType i = 0; i < nd; i++ )
+      {
+      const OutputPixelType *pixel = start + static_cast< OffsetValueType >( i ) * stride;
+      for ( SizeValueType b = 0; b < numberOfLanes; b++ )
+        {
+        lines[b * nd + i] = pixel[b];
+        }
+      }
+
+    bool modified = false;
+    for ( SizeValueType b = 0; b < numberOfLanes; b++ )
       {
-      offsetIndex[d % InputImageDimension] = static_cast< OutputIndexValueType >( static_cast< double >( index ) / static_cast< double >( k[count] ) );
-      idx[d % InputImageDimension] = offsetIndex[d % InputImageDimension] + static_cast< OutputIndexValueType >( startIndex[d % InputImageDimension] );
+      if ( this->Voronoi(d, nd, laneIndex[b], &lines[b * nd], &g[0], &h[0]) )
+        {
+        modified = true;
+        }
+      progress->CompletedPixel();
+      }
 
-      index %= k[count];
-      count++;
+    if ( modified )
+      {
+      for ( OutputSizeValueType i = 0; i < nd; i++ )
+        {
+        OutputPixelType *pixel = start + static_cast< OffsetValueType >( i ) * stride;
+        for ( SizeValueType b = 0; b < numberOfLanes; b++ )
+          {
+          pixel[b] = lines[b * nd + i];
+          }
+        }
       }
-    this->Voronoi(m_CurrentDimension, idx,outputImage);
-    progress->CompletedPixel();
     }
   delete progress;
 
-  if ( m_CurrentDimension == ImageDimension - 1 && !this->m_SquaredDistance )
+  if ( m_CurrentDimension == ImageDimension - 1 && finalPass )
     {
     typedef ImageRegionIterator< OutputImageType >      OutputIterator;
     typedef ImageRegionConstIterator< InputImageType  > InputIterator;
@@ -286,10 +310,17 @@ SignedMaurerDistanceMapImageFilter< TInputImage, TOutputImage >
 
     while ( !Ot.IsAtEnd() )
       {
-      // cast to a real type is required on some platforms
-      const OutputPixelType outputValue =
-        static_cast< OutputPixelType >(
-          std::sqrt( static_cast< OutputRealType >( itk::Math::abs( Ot.Get() ) ) ) );
+      OutputPixelType outputValue = itk::Math::abs( Ot.Get() );
+      if ( outputValue > m_MaximumSquaredDistance )
+        {
+        outputValue = m_MaximumSquaredDistance;
+        }
+      if ( !this->m_SquaredDistance )
+        {
+        // cast to a real type is required on some platforms
+        outputValue = static_cast< OutputPixelType >(
+          std::sqrt( static_cast< OutputRealType >( outputValue ) ) );
+        }
 
       if ( Math::NotExactlyEquals( It.Get(), this->m_BackgroundValue ) )
         {
@@ -322,19 +353,14 @@ SignedMaurerDistanceMapImageFilter< TInputImage, TOutputImage >
 }
 
 template< typename TInputImage, typename TOutputImage >
-void
+bool
 SignedMaurerDistanceMapImageFilter< TInputImage, TOutputImage >
-::Voronoi(unsigned int d, OutputIndexType idx, OutputImageType *output)
+::Voronoi(unsigned int d, OutputSizeValueType nd, OutputIndexType idx,
+          OutputPixelType *line, OutputPixelType *g, OutputPixelType *h)
 {
-  OutputRegionType      oRegion = output->GetRequestedRegion();
-  OutputSizeValueType   nd = oRegion.GetSize()[d];
-
-  vnl_vector< OutputPixelType > g(nd, 0 );
-  vnl_vector< OutputPixelType > h(nd, 0 );
-
-
-  InputRegionType iRegion = m_InputCache->GetRequestedRegion();
-  InputIndexType startIndex = iRegion.GetIndex();
+  const OutputIndexValueType startIndex = idx[d];
+  const OutputPixelType      maximumValue = NumericTraits< OutputPixelType >::max();
+  const bool                 bandLimited = this->IsBandLimited();
 
   OutputPixelType di;
 
@@ -342,9 +368,7 @@ SignedMaurerDistanceMapImageFilter< TInputImage, TOutputImage >
 
   for ( unsigned int i = 0; i < nd; i++ )
     {
-    idx[d] = i + startIndex[d];
-
-    di = output->GetPixel(idx);
+    di = line[i];
 
     OutputPixelType iw;
 
@@ -358,31 +382,35 @@ SignedMaurerDistanceMapImageFilter< TInputImage, TOutputImage >
       iw  = static_cast< OutputPixelType >( i );
       }
 
-    if ( Math::NotExactlyEquals( di, NumericTraits< OutputPixelType >::max() ) )
+    // In band limited mode, the pixels farther than the maximum distance
+    // from the object boundary can't be closer than that to any pixel of
+    // the line, and are not feature points.
+    if ( Math::NotExactlyEquals( di, maximumValue )
+         && ( !bandLimited || itk::Math::abs( di ) <= m_MaximumSquaredDistance ) )
       {
       if ( l < 1 )
         {
         l++;
-        g(l) = di;
-        h(l) = iw;
+        g[l] = di;
+        h[l] = iw;
         }
       else
         {
         while ( ( l >= 1 )
-                && this->Remove(g(l - 1), g(l), di, h(l - 1), h(l), iw) )
+                && this->Remove(g[l - 1], g[l], di, h[l - 1], h[l], iw) )
           {
           l--;
           }
         l++;
-        g(l) = di;
-        h(l) = iw;
+        g[l] = di;
+        h[l] = iw;
         }
       }
     }
 
   if ( l == -1 )
     {
-    return;
+    return false;
     }
 
   int ns = l;
@@ -402,12 +430,12 @@ SignedMaurerDistanceMapImageFilter< TInputImage, TOutputImage >
       iw = static_cast< OutputPixelType >( i );
       }
 
-    OutputPixelType d1 = itk::Math::abs( g(l) ) + ( h(l) - iw ) * ( h(l) - iw );
+    OutputPixelType d1 = itk::Math::abs( g[l] ) + ( h[l] - iw ) * ( h[l] - iw );
 
     while ( l < ns )
       {
       // be sure to compute d2 *only* if l < ns
-      OutputPixelType d2 = itk::Math::abs( g(l + 1) ) + ( h(l + 1) - iw ) * ( h(l + 1) - iw );
+      OutputPixelType d2 = itk::Math::abs( g[l + 1] ) + ( h[l + 1] - iw ) * ( h[l + 1] - iw );
       // then compare d1 and d2
       if ( d1 <= d2 )
         {
@@ -416,31 +444,40 @@ SignedMaurerDistanceMapImageFilter< TInputImage, TOutputImage >
       l++;
       d1 = d2;
       }
-    idx[d] = i + startIndex[d];
+
+    if ( bandLimited && d1 > m_MaximumSquaredDistance )
+      {
+      // the sign is restored after the last pass
+      line[i] = maximumValue;
+      continue;
+      }
+
+    idx[d] = i + startIndex;
 
     if ( Math::NotExactlyEquals( m_InputCache->GetPixel(idx), this->m_BackgroundValue ) )
       {
       if ( this->m_InsideIsPositive )
         {
-        output->SetPixel(idx,  d1);
+        line[i] = d1;
         }
       else
         {
-        output->SetPixel(idx, -d1);
+        line[i] = -d1;
         }
       }
     else
       {
       if ( this->m_InsideIsPositive )
         {
-        output->SetPixel(idx, -d1);
+        line[i] = -d1;
         }
       else
         {
-        output->SetPixel(idx,  d1);
+        line[i] = d1;
         }
       }
     }
+  return true;
 }
 
 template< typename TInputImage, typename TOutputImage >
@@ -479,6 +516,9 @@ SignedMaurerDistanceMapImageFilter< TInputImage, TOutputImage >
      << this->m_UseImageSpacing << std::endl;
   os << indent << "Squared distance: "
      << this->m_SquaredDistance << std::endl;
+  os << indent << "Maximum distance: "
+     << static_cast< typename NumericTraits< OutputPixelType >::PrintType >( this->m_MaximumDistance )
+     << std::endl;
 }
 } // end namespace itk
 
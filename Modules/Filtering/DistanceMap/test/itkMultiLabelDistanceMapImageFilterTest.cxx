@@ -0,0 +1,236 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMultiLabelDistanceMapImageFilter.h"
+#include "itkSignedMaurerDistanceMapImageFilter.h"
+#include "itkBinaryThresholdImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+const unsigned int Dimension = 3;
+
+typedef itk::Image< unsigned short, Dimension > LabelImageType;
+typedef itk::Image< float, Dimension >          DistanceImageType;
+
+typedef itk::MultiLabelDistanceMapImageFilter< LabelImageType, DistanceImageType > FilterType;
+
+// Brute force distance to the nearest pixel of another label
+bool
+CheckDistanceMap( FilterType * filter, const LabelImageType * image )
+{
+  const DistanceImageType *        distanceMap = filter->GetDistanceMap();
+  const LabelImageType *           nearestLabelMap = filter->GetNearestLabelMap();
+  const LabelImageType::RegionType region = image->GetLargestPossibleRegion();
+  const LabelImageType::SpacingType spacing = image->GetSpacing();
+  itk::ImageRegionConstIteratorWithIndex< LabelImageType > it( image, region );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const LabelImageType::IndexType index = it.GetIndex();
+    double nearest = itk::NumericTraits< double >::max();
+    double nearestWithLabel = itk::NumericTraits< double >::max();
+    itk::ImageRegionConstIteratorWithIndex< LabelImageType > other( image, region );
+    for ( other.GoToBegin(); !other.IsAtEnd(); ++other )
+      {
+      if ( other.Get() == it.Get() )
+        {
+        continue;
+        }
+      double distance = 0.0;
+      for ( unsigned int d = 0; d < Dimension; ++d )
+        {
+        const double delta = ( other.GetIndex()[d] - index[d] ) * spacing[d];
+        distance += delta * delta;
+        }
+      nearest = std::min( nearest, distance );
+      if ( other.Get() == nearestLabelMap->GetPixel( index ) )
+        {
+        nearestWithLabel = std::min( nearestWithLabel, distance );
+        }
+      }
+    nearest = std::sqrt( nearest );
+    nearestWithLabel = std::sqrt( nearestWithLabel );
+    if ( itk::Math::abs( distanceMap->GetPixel( index ) - nearest ) > 1e-4
+         || itk::Math::abs( nearestWithLabel - nearest ) > 1e-4 )
+      {
+      std::cerr << "Mismatch at " << index << ": distance " << distanceMap->GetPixel( index )
+                << " to label " << nearestLabelMap->GetPixel( index ) << " instead of "
+                << nearest << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// Compare the label distance maps with the signed Maurer distance maps of
+// the whole image.
+bool
+CheckLabelDistanceMaps( FilterType * filter, const LabelImageType * image )
+{
+  typedef itk::BinaryThresholdImageFilter< LabelImageType, LabelImageType >            ThresholdType;
+  typedef itk::SignedMaurerDistanceMapImageFilter< LabelImageType, DistanceImageType > MaurerType;
+  const FilterType::LabelVectorType & labels = filter->GetLabels();
+  if ( labels.empty() || labels.front() == 0 )
+    {
+    std::cerr << "Wrong labels" << std::endl;
+    return false;
+    }
+  for ( unsigned int i = 0; i < labels.size(); ++i )
+    {
+    ThresholdType::Pointer threshold = ThresholdType::New();
+    threshold->SetInput( image );
+    threshold->SetLowerThreshold( labels[i] );
+    threshold->SetUpperThreshold( labels[i] );
+    MaurerType::Pointer maurer = MaurerType::New();
+    maurer->SetInput( threshold->GetOutput() );
+    maurer->Update();
+
+    const DistanceImageType * labelDistanceMap = filter->GetLabelDistanceMap( labels[i] );
+    if ( labelDistanceMap == ITK_NULLPTR )
+      {
+      std::cerr << "Missing distance map for label " << labels[i] << std::endl;
+      return false;
+      }
+    itk::ImageRegionConstIteratorWithIndex< DistanceImageType >
+      lit( labelDistanceMap, labelDistanceMap->GetBufferedRegion() );
+    for ( lit.GoToBegin(); !lit.IsAtEnd(); ++lit )
+      {
+      if ( itk::Math::abs( lit.Get() - maurer->GetOutput()->GetPixel( lit.GetIndex() ) ) > 1e-4 )
+        {
+        std::cerr << "Label " << labels[i] << " mismatch at " << lit.GetIndex() << ": "
+                  << lit.Get() << " instead of " << maurer->GetOutput()->GetPixel( lit.GetIndex() )
+                  << std::endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+// Compare the multi-label distance map with a brute force computation of
+// the distance to the nearest pixel of another label, and the label
+// distance maps with the signed Maurer distance map of each label, on an
+// image of boxes and on a fragmented image.
+int itkMultiLabelDistanceMapImageFilterTest(int, char* [] )
+{
+  // A label image made of overlapping boxes
+  LabelImageType::SizeType size;
+  size[0] = 15;
+  size[1] = 13;
+  size[2] = 11;
+  LabelImageType::Pointer image = LabelImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  image->FillBuffer( 0 );
+
+  LabelImageType::SpacingType spacing;
+  spacing[0] = 1.0;
+  spacing[1] = 0.7;
+  spacing[2] = 1.9;
+  image->SetSpacing( spacing );
+
+  unsigned int seed = 2718;
+  for ( unsigned short label = 1; label <= 7; ++label )
+    {
+    LabelImageType::IndexType start;
+    LabelImageType::SizeType  boxSize;
+    for ( unsigned int d = 0; d < Dimension; ++d )
+      {
+      seed = seed * 1103515245u + 12345u;
+      start[d] = static_cast< itk::IndexValueType >( ( seed >> 8 ) % size[d] );
+      seed = seed * 1103515245u + 12345u;
+      boxSize[d] = 1 + ( seed >> 8 ) % 6;
+      }
+    LabelImageType::RegionType box( start, boxSize );
+    box.Crop( image->GetLargestPossibleRegion() );
+    itk::ImageRegionIterator< LabelImageType > it( image, box );
+    for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+      {
+      it.Set( label );
+      }
+    }
+
+  FilterType::Pointer filter = FilterType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( filter, MultiLabelDistanceMapImageFilter, ImageToImageFilter );
+  TEST_SET_GET_BOOLEAN( filter, UseImageSpacing, true );
+  TEST_SET_GET_BOOLEAN( filter, SquaredDistance, false );
+  TEST_SET_GET_BOOLEAN( filter, InsideIsPositive, false );
+  TEST_SET_GET_BOOLEAN( filter, ComputeLabelDistanceMaps, true );
+
+  filter->SetInput( image );
+  filter->SetNumberOfThreads( 3 );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  TEST_EXPECT_TRUE( CheckDistanceMap( filter, image ) );
+  TEST_EXPECT_TRUE( CheckLabelDistanceMaps( filter, image ) );
+  if ( filter->GetLabelDistanceMap( 1000 ) != ITK_NULLPTR )
+    {
+    std::cerr << "Unexpected distance map" << std::endl;
+    return EXIT_FAILURE;
+    }
+
+  // without padding, the label distance maps are still the ones of the
+  // whole image
+  FilterType::SizeType padding;
+  padding.Fill( 0 );
+  filter->SetLabelDistanceMapPadding( padding );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  TEST_EXPECT_TRUE( CheckLabelDistanceMaps( filter, image ) );
+
+  // A fragmented image, with short runs of labels along all the lines, and
+  // large regions of a single label
+  const LabelImageType::RegionType region = image->GetLargestPossibleRegion();
+  itk::ImageRegionIteratorWithIndex< LabelImageType > fit( image, region );
+  for ( fit.GoToBegin(); !fit.IsAtEnd(); ++fit )
+    {
+    seed = seed * 1103515245u + 12345u;
+    const LabelImageType::IndexType index = fit.GetIndex();
+    if ( index[0] < 5 && index[2] > 3 )
+      {
+      fit.Set( 9 );
+      }
+    else
+      {
+      fit.Set( static_cast< unsigned short >( ( seed >> 8 ) % 4 ) );
+      }
+    }
+  image->Modified();
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  TEST_EXPECT_TRUE( CheckDistanceMap( filter, image ) );
+  TEST_EXPECT_TRUE( CheckLabelDistanceMaps( filter, image ) );
+
+  // An image with a single label
+  image->FillBuffer( 3 );
+  filter->SetComputeLabelDistanceMaps( false );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  itk::ImageRegionConstIterator< DistanceImageType > dit( filter->GetDistanceMap(), region );
+  itk::ImageRegionConstIterator< LabelImageType >    nit( filter->GetNearestLabelMap(), region );
+  for ( ; !dit.IsAtEnd(); ++dit, ++nit )
+    {
+    if ( dit.Get() != itk::NumericTraits< float >::max() || nit.Get() != 3 )
+      {
+      std::cerr << "Single label image: " << dit.Get() << " " << nit.Get() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
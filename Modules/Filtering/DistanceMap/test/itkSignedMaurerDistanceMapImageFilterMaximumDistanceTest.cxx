@@ -0,0 +1,169 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkSignedMaurerDistanceMapImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+// Check that the band limited distance map is the full distance map
+// clamped to the maximum distance.
+template< typename TInputImage, typename TOutputImage >
+bool
+CheckMaximumDistance(TInputImage * image, double maximumDistance, bool squaredDistance,
+                     bool insideIsPositive, double tolerance)
+{
+  typedef itk::SignedMaurerDistanceMapImageFilter< TInputImage, TOutputImage > FilterType;
+  typedef typename TOutputImage::PixelType                                     OutputPixelType;
+
+  typename FilterType::Pointer full = FilterType::New();
+  full->SetInput( image );
+  full->SetSquaredDistance( squaredDistance );
+  full->SetInsideIsPositive( insideIsPositive );
+  full->Update();
+
+  typename FilterType::Pointer band = FilterType::New();
+  band->SetInput( image );
+  band->SetSquaredDistance( squaredDistance );
+  band->SetInsideIsPositive( insideIsPositive );
+  band->SetMaximumDistance( static_cast< OutputPixelType >( maximumDistance ) );
+  band->Update();
+
+  const double limit = squaredDistance ? maximumDistance * maximumDistance : maximumDistance;
+
+  itk::ImageRegionConstIterator< TOutputImage > fit( full->GetOutput(), image->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< TOutputImage > bit( band->GetOutput(), image->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< TInputImage >  iit( image, image->GetLargestPossibleRegion() );
+  for ( ; !fit.IsAtEnd(); ++fit, ++bit, ++iit )
+    {
+    const bool   inside = iit.Get() != 0;
+    const double sign = ( inside == insideIsPositive ) ? 1.0 : -1.0;
+    const double fullValue = static_cast< double >( fit.Get() );
+    const double expected = sign * std::min( itk::Math::abs( fullValue ), limit );
+    if ( itk::Math::abs( static_cast< double >( bit.Get() ) - expected ) > tolerance )
+      {
+      std::cerr << "Mismatch at " << fit.GetIndex() << ": " << static_cast< double >( bit.Get() )
+                << " instead of " << expected << " (full distance " << fullValue
+                << ", maximum distance " << maximumDistance << ", squared " << squaredDistance
+                << ")" << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+}
+
+int itkSignedMaurerDistanceMapImageFilterMaximumDistanceTest(int, char* [] )
+{
+  const unsigned int Dimension = 3;
+
+  typedef itk::Image< unsigned char, Dimension > InputImageType;
+  typedef itk::Image< float, Dimension >         FloatImageType;
+  typedef itk::Image< int, Dimension >           IntImageType;
+
+  typedef itk::SignedMaurerDistanceMapImageFilter< InputImageType, FloatImageType > FilterType;
+
+  FilterType::Pointer filter = FilterType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( filter, SignedMaurerDistanceMapImageFilter, ImageToImageFilter );
+  TEST_SET_GET_VALUE( itk::NumericTraits< float >::max(), filter->GetMaximumDistance() );
+
+  // A few boxes in an image with an anisotropic spacing, and odd sizes so
+  // that the lines can't all be processed in full batches.
+  InputImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 29;
+  size[2] = 23;
+  InputImageType::Pointer image = InputImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  image->FillBuffer( 0 );
+
+  InputImageType::SpacingType spacing;
+  spacing[0] = 0.8;
+  spacing[1] = 1.0;
+  spacing[2] = 2.5;
+  image->SetSpacing( spacing );
+
+  unsigned int seed = 4321;
+  for ( unsigned int b = 0; b < 6; ++b )
+    {
+    InputImageType::IndexType start;
+    InputImageType::SizeType  boxSize;
+    for ( unsigned int d = 0; d < Dimension; ++d )
+      {
+      seed = seed * 1103515245u + 12345u;
+      start[d] = static_cast< itk::IndexValueType >( ( seed >> 8 ) % size[d] );
+      seed = seed * 1103515245u + 12345u;
+      boxSize[d] = 1 + ( seed >> 8 ) % 8;
+      }
+    InputImageType::RegionType box( start, boxSize );
+    box.Crop( image->GetLargestPossibleRegion() );
+    itk::ImageRegionIterator< InputImageType > it( image, box );
+    for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+      {
+      it.Set( 1 );
+      }
+    }
+
+  const double maximumDistances[3] = { 1.5, 4.0, 10.0 };
+  for ( unsigned int m = 0; m < 3; ++m )
+    {
+    for ( unsigned int inside = 0; inside < 2; ++inside )
+      {
+      if ( !CheckMaximumDistance< InputImageType, FloatImageType >( image, maximumDistances[m],
+                                                                    false, inside != 0, 1e-4 ) )
+        {
+        return EXIT_FAILURE;
+        }
+      if ( !CheckMaximumDistance< InputImageType, FloatImageType >( image, maximumDistances[m],
+                                                                    true, inside != 0, 1e-3 ) )
+        {
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // Integer squared distances, in pixels
+  image->SetSpacing( 1.0 );
+  if ( !CheckMaximumDistance< InputImageType, IntImageType >( image, 5.0, true, false, 0.0 ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // An empty image: all the pixels are beyond the maximum distance
+  image->FillBuffer( 0 );
+  filter->SetInput( image );
+  filter->SetMaximumDistance( 3.0 );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  itk::ImageRegionConstIterator< FloatImageType > oit( filter->GetOutput(), image->GetLargestPossibleRegion() );
+  for ( oit.GoToBegin(); !oit.IsAtEnd(); ++oit )
+    {
+    if ( itk::Math::NotExactlyEquals( oit.Get(), 3.0f ) )
+      {
+      std::cerr << "Empty image: " << oit.Get() << " at " << oit.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
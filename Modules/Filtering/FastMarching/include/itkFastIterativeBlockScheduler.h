@@ -0,0 +1,162 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkFastIterativeBlockScheduler_h
+#define itkFastIterativeBlockScheduler_h
+
+#include "itkMultiThreader.h"
+#include "itkAtomicInt.h"
+#include "itkOffset.h"
+#include "itkSize.h"
+
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class FastIterativeBlockScheduler
+ * \brief Schedule the parallel updates of the blocks of a region with the
+ * block based Fast Iterative Method.
+ *
+ * The region is divided in blocks of BlockSize nodes along each axis. Run()
+ * updates the active blocks with a solver, in 2^VDimension groups, or
+ * colors, such that two blocks of a color never share a face: the blocks of
+ * a color are updated at the same time by the threads. A block whose values
+ * changed on a face activates the block on the other side of that face. The
+ * blocks activated by a color are updated with the next colors of the same
+ * iteration, and Run() returns when no block is active. The result does not
+ * depend on the number of threads.
+ *
+ * The solver given to Run() provides two methods:
+ * - unsigned int UpdateBlock( SizeValueType block ) updates the nodes of a
+ *   block until their values no longer decrease, and returns the faces of the
+ *   block whose values changed, as bits 2 * axis for the lower face and
+ *   2 * axis + 1 for the upper one. It is called by several threads at once,
+ *   for the blocks of a color.
+ * - void BlockActivated( SizeValueType block ) is called by Run(), before
+ *   the block is updated, when a block which was not active is activated by
+ *   a neighbor.
+ *
+ * Based on W.-K. Jeong and R. T. Whitaker, "A Fast Iterative Method for
+ * Eikonal Equations", SIAM Journal on Scientific Computing, 30(5),
+ * 2512-2534, 2008.
+ *
+ * \sa FastIterativeImageFilterBase
+ *
+ * \ingroup ITKFastMarching
+ */
+template< unsigned int VDimension >
+class ITK_TEMPLATE_EXPORT FastIterativeBlockScheduler
+{
+public:
+  typedef FastIterativeBlockScheduler Self;
+
+  typedef Size< VDimension >   SizeType;
+  typedef Offset< VDimension > OffsetType;
+
+  itkStaticConstMacro( Dimension, unsigned int, VDimension );
+
+  FastIterativeBlockScheduler();
+  ~FastIterativeBlockScheduler() {}
+
+  /** Divide a region of the given size in blocks of blockSize nodes along
+   * each axis. No block is active. */
+  void Initialize( const SizeType & size, unsigned int blockSize );
+
+  /** Release the lists of blocks. The grid of blocks is kept. */
+  void Clear();
+
+  /** Get the number of nodes of the blocks along each axis. */
+  unsigned int GetBlockSize() const
+  {
+    return m_BlockSize;
+  }
+
+  /** Get the number of blocks of the region. */
+  SizeValueType GetNumberOfBlocks() const
+  {
+    SizeValueType numberOfBlocks = 1;
+    for( unsigned int j = 0; j < VDimension; j++ )
+      {
+      numberOfBlocks *= m_NumberOfBlocks[j];
+      }
+    return numberOfBlocks;
+  }
+
+  /** Get the number of blocks along an axis, and the difference between
+   * the numbers of two neighbor blocks along that axis. */
+  SizeValueType GetNumberOfBlocks( unsigned int axis ) const
+  {
+    return m_NumberOfBlocks[axis];
+  }
+  SizeValueType GetBlockStride( unsigned int axis ) const
+  {
+    return m_BlockStrides[axis];
+  }
+
+  /** Get the position of a block along an axis, in blocks. */
+  SizeValueType GetBlockPosition( SizeValueType block, unsigned int axis ) const
+  {
+    return ( block / m_BlockStrides[axis] ) % m_NumberOfBlocks[axis];
+  }
+
+  /** Get the block of a node, from its offset to the first node of the
+   * region. */
+  SizeValueType GetBlock( const OffsetType & position ) const;
+
+  /** Activate a block, and return true if it was not active. */
+  bool ActivateBlock( SizeValueType block );
+
+  /** Update the active blocks until no block is active, with the threads
+   * of the given multithreader, and return the number of iterations. */
+  template< typename TBlockSolver >
+  SizeValueType Run( TBlockSolver * solver, MultiThreader * multithreader, ThreadIdType numberOfThreads );
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(FastIterativeBlockScheduler);
+
+  template< typename TBlockSolver >
+  struct ThreadStruct
+  {
+    Self *         Scheduler;
+    TBlockSolver * Solver;
+  };
+
+  template< typename TBlockSolver >
+  static ITK_THREAD_RETURN_TYPE UpdateBlocksThreaderCallback( void *arg );
+
+  unsigned int  m_BlockSize;
+  SizeValueType m_NumberOfBlocks[VDimension];
+  SizeValueType m_BlockStrides[VDimension];
+
+  // the blocks to update, and whether a block is in the list
+  std::vector< SizeValueType > m_ActiveBlocks;
+  std::vector< unsigned char > m_IsActive;
+
+  // the blocks updated by the threads and the faces they changed
+  std::vector< SizeValueType > m_ColorBlocks;
+  std::vector< unsigned int >  m_ChangedFaces;
+  AtomicInt< SizeValueType >   m_NextBlock;
+};
+}
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkFastIterativeBlockScheduler.hxx"
+#endif
+
+#endif // itkFastIterativeBlockScheduler_h
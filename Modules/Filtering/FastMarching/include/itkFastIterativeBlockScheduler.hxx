@@ -0,0 +1,219 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkFastIterativeBlockScheduler_hxx
+#define itkFastIterativeBlockScheduler_hxx
+
+#include "itkFastIterativeBlockScheduler.h"
+
+#include <algorithm>
+
+namespace itk
+{
+// -----------------------------------------------------------------------------
+template< unsigned int VDimension >
+FastIterativeBlockScheduler< VDimension >::
+FastIterativeBlockScheduler() :
+  m_BlockSize( 1 )
+  {
+  for( unsigned int j = 0; j < VDimension; j++ )
+    {
+    m_NumberOfBlocks[j] = 0;
+    m_BlockStrides[j] = 0;
+    }
+  m_NextBlock = 0;
+  }
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template< unsigned int VDimension >
+void
+FastIterativeBlockScheduler< VDimension >::
+Initialize( const SizeType & size, unsigned int blockSize )
+  {
+  m_BlockSize = blockSize;
+  SizeValueType numberOfBlocks = 1;
+  for( unsigned int j = 0; j < VDimension; j++ )
+    {
+    m_NumberOfBlocks[j] = ( size[j] + m_BlockSize - 1 ) / m_BlockSize;
+    m_BlockStrides[j] = numberOfBlocks;
+    numberOfBlocks *= m_NumberOfBlocks[j];
+    }
+
+  m_ActiveBlocks.clear();
+  m_IsActive.assign( numberOfBlocks, 0 );
+  }
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template< unsigned int VDimension >
+void
+FastIterativeBlockScheduler< VDimension >::
+Clear()
+  {
+  m_ActiveBlocks.clear();
+  m_IsActive.clear();
+  m_ColorBlocks.clear();
+  m_ChangedFaces.clear();
+  }
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template< unsigned int VDimension >
+SizeValueType
+FastIterativeBlockScheduler< VDimension >::
+GetBlock( const OffsetType & position ) const
+  {
+  SizeValueType block = 0;
+  for( unsigned int j = 0; j < VDimension; j++ )
+    {
+    block += ( static_cast< SizeValueType >( position[j] ) / m_BlockSize ) * m_BlockStrides[j];
+    }
+  return block;
+  }
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template< unsigned int VDimension >
+bool
+FastIterativeBlockScheduler< VDimension >::
+ActivateBlock( SizeValueType block )
+  {
+  if( m_IsActive[block] )
+    {
+    return false;
+    }
+  m_IsActive[block] = 1;
+  m_ActiveBlocks.push_back( block );
+  return true;
+  }
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template< unsigned int VDimension >
+template< typename TBlockSolver >
+SizeValueType
+FastIterativeBlockScheduler< VDimension >::
+Run( TBlockSolver * solver, MultiThreader * multithreader, ThreadIdType numberOfThreads )
+  {
+  ThreadStruct< TBlockSolver > str;
+  str.Scheduler = this;
+  str.Solver = solver;
+
+  const unsigned int           numberOfColors = 1 << VDimension;
+  std::vector< SizeValueType > otherBlocks;
+  SizeValueType                numberOfIterations = 0;
+  while( !m_ActiveBlocks.empty() )
+    {
+    // The blocks of a color don't share any face, so that they can be
+    // updated at the same time. The blocks activated by a color are
+    // updated with the next colors of the same iteration.
+    for( unsigned int color = 0; color < numberOfColors; color++ )
+      {
+      m_ColorBlocks.clear();
+      otherBlocks.clear();
+      for( SizeValueType i = 0; i < m_ActiveBlocks.size(); i++ )
+        {
+        const SizeValueType block = m_ActiveBlocks[i];
+        unsigned int        blockColor = 0;
+        for( unsigned int j = 0; j < VDimension; j++ )
+          {
+          blockColor |= static_cast< unsigned int >( this->GetBlockPosition( block, j ) & 1 ) << j;
+          }
+        if( blockColor == color )
+          {
+          m_ColorBlocks.push_back( block );
+          m_IsActive[block] = 0;
+          }
+        else
+          {
+          otherBlocks.push_back( block );
+          }
+        }
+      m_ActiveBlocks.swap( otherBlocks );
+      if( m_ColorBlocks.empty() )
+        {
+        continue;
+        }
+
+      m_ChangedFaces.assign( m_ColorBlocks.size(), 0 );
+      m_NextBlock = 0;
+      multithreader->SetNumberOfThreads( std::min( numberOfThreads,
+        static_cast< ThreadIdType >( m_ColorBlocks.size() ) ) );
+      multithreader->SetSingleMethod( &Self::template UpdateBlocksThreaderCallback< TBlockSolver >, &str );
+      multithreader->SingleMethodExecute();
+
+      // activate the neighbors of the faces which changed
+      for( SizeValueType i = 0; i < m_ColorBlocks.size(); i++ )
+        {
+        const SizeValueType block = m_ColorBlocks[i];
+        for( unsigned int j = 0; j < VDimension; j++ )
+          {
+          const SizeValueType b = this->GetBlockPosition( block, j );
+          if( ( m_ChangedFaces[i] & ( 1u << ( 2 * j ) ) ) && b > 0 &&
+              this->ActivateBlock( block - m_BlockStrides[j] ) )
+            {
+            solver->BlockActivated( block - m_BlockStrides[j] );
+            }
+          if( ( m_ChangedFaces[i] & ( 1u << ( 2 * j + 1 ) ) ) && b + 1 < m_NumberOfBlocks[j] &&
+              this->ActivateBlock( block + m_BlockStrides[j] ) )
+            {
+            solver->BlockActivated( block + m_BlockStrides[j] );
+            }
+          }
+        }
+      }
+    ++numberOfIterations;
+    }
+
+  m_ColorBlocks.clear();
+  m_ChangedFaces.clear();
+  return numberOfIterations;
+  }
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template< unsigned int VDimension >
+template< typename TBlockSolver >
+ITK_THREAD_RETURN_TYPE
+FastIterativeBlockScheduler< VDimension >::
+UpdateBlocksThreaderCallback( void *arg )
+  {
+  ThreadStruct< TBlockSolver > *str = static_cast< ThreadStruct< TBlockSolver > * >(
+    static_cast< MultiThreader::ThreadInfoStruct * >( arg )->UserData );
+  Self *scheduler = str->Scheduler;
+
+  // the blocks are dispatched one at a time, as some may converge much
+  // faster than others
+  const SizeValueType numberOfBlocks = scheduler->m_ColorBlocks.size();
+  while( true )
+    {
+    const SizeValueType i = ( scheduler->m_NextBlock++ );
+    if( i >= numberOfBlocks )
+      {
+      break;
+      }
+    scheduler->m_ChangedFaces[i] = str->Solver->UpdateBlock( scheduler->m_ColorBlocks[i] );
+    }
+  return ITK_THREAD_RETURN_VALUE;
+  }
+// -----------------------------------------------------------------------------
+
+} // end of namespace itk
+
+#endif
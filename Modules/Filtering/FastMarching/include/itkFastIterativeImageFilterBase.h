@@ -0,0 +1,173 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkFastIterativeImageFilterBase_h
+#define itkFastIterativeImageFilterBase_h
+
+#include "itkFastMarchingImageFilterBase.h"
+#include "itkFastMarchingThresholdStoppingCriterion.h"
+#include "itkFastIterativeBlockScheduler.h"
+
+#include <vector>
+
+namespace itk
+{
+/**
+ * \class FastIterativeImageFilterBase
+ * \brief Parallel solver of the Eikonal equation on an image with the block
+ * based Fast Iterative Method.
+ *
+ * This filter computes the same arrival times as FastMarchingImageFilterBase,
+ * with the same inputs: alive, trial and forbidden points, speed image or
+ * speed constant, and stopping criterion. It can be used instead of it when
+ * the output is large and several threads are available.
+ *
+ * Instead of fixing the nodes one at a time in the order of their values,
+ * the image is divided in blocks of BlockSize nodes along each axis. The
+ * active blocks are updated in parallel with Gauss-Seidel sweeps in
+ * alternating directions, using the same upwind scheme as fast marching,
+ * until their values no longer decrease. A block whose values changed on a
+ * face activates the block on the other side of that face, and the solver
+ * stops when no block is active. The blocks are processed in
+ * 2^ImageDimension groups, such that two blocks of a group never share a
+ * face: the result does not depend on the number of threads. The blocks are
+ * scheduled by a FastIterativeBlockScheduler.
+ *
+ * The iterations converge to the solution of the discrete equations solved
+ * by fast marching, so that both outputs are equal up to the rounding
+ * errors. The stopping criterion is then evaluated on the nodes in the
+ * order of their values, as fast marching does: the nodes after the one
+ * satisfying the criterion get the values fast marching gives to its trial
+ * nodes, or the large value. When the stopping criterion is a
+ * FastMarchingThresholdStoppingCriterion, the blocks are not activated by
+ * the values above the threshold.
+ *
+ * Topology checks are not supported in parallel: when TopologyCheck is not
+ * Nothing, the filter runs the fast marching of its superclass.
+ *
+ * Based on W.-K. Jeong and R. T. Whitaker, "A Fast Iterative Method for
+ * Eikonal Equations", SIAM Journal on Scientific Computing, 30(5),
+ * 2512-2534, 2008.
+ *
+ * \sa FastMarchingImageFilterBase, FastIterativeBlockScheduler
+ *
+ * \ingroup ITKFastMarching
+ */
+template< typename TInput, typename TOutput >
+class ITK_TEMPLATE_EXPORT FastIterativeImageFilterBase :
+    public FastMarchingImageFilterBase< TInput, TOutput >
+  {
+public:
+  typedef FastIterativeImageFilterBase                    Self;
+  typedef FastMarchingImageFilterBase< TInput, TOutput >  Superclass;
+  typedef SmartPointer< Self >                            Pointer;
+  typedef SmartPointer< const Self >                      ConstPointer;
+  typedef typename Superclass::Traits                     Traits;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(FastIterativeImageFilterBase, FastMarchingImageFilterBase);
+
+  typedef typename Superclass::OutputImageType      OutputImageType;
+  typedef typename Superclass::OutputPixelType      OutputPixelType;
+  typedef typename Superclass::OutputRegionType     OutputRegionType;
+  typedef typename Superclass::OutputSizeType       OutputSizeType;
+  typedef typename Superclass::NodeType             NodeType;
+  typedef typename Superclass::NodePairType         NodePairType;
+  typedef typename Superclass::LabelImageType       LabelImageType;
+
+  typedef typename Superclass::InternalNodeStructure      InternalNodeStructure;
+  typedef typename Superclass::InternalNodeStructureArray InternalNodeStructureArray;
+
+  itkStaticConstMacro( ImageDimension, unsigned int, Traits::ImageDimension );
+
+  /** Set/Get the number of nodes of the blocks along each axis. Defaults
+   * to 8. */
+  itkSetClampMacro( BlockSize, unsigned int, 1, NumericTraits< unsigned int >::max() );
+  itkGetConstMacro( BlockSize, unsigned int );
+
+  /** Get the number of times the active blocks have been updated by the
+   * last run. */
+  itkGetConstMacro( NumberOfIterations, SizeValueType );
+
+protected:
+
+  FastIterativeImageFilterBase();
+  virtual ~FastIterativeImageFilterBase() {}
+
+  void GenerateData() ITK_OVERRIDE;
+
+  void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(FastIterativeImageFilterBase);
+
+  typedef FastMarchingThresholdStoppingCriterion< TInput, TOutput > ThresholdStoppingCriterionType;
+  typedef typename OutputImageType::OffsetValueType                 OffsetValueType;
+  typedef std::vector< NodePairType >                               NodePairVectorType;
+
+  /** Solve the equations on the whole image with the active blocks. */
+  void SolveBlocks();
+
+  /** Fix the nodes in the order of their values until the stopping
+   * criterion is satisfied. */
+  void ApplyStoppingCriterion( OutputImageType* oImage );
+
+  typedef FastIterativeBlockScheduler< ImageDimension > SchedulerType;
+  friend class FastIterativeBlockScheduler< ImageDimension >;
+
+  /** Update the nodes of a block until their values no longer decrease,
+   * and return the faces of the block whose values changed, as bits
+   * 2 * axis for the lower face and 2 * axis + 1 for the upper one. */
+  unsigned int UpdateBlock( SizeValueType block );
+
+  /** The blocks have nothing to prepare before their first update. */
+  void BlockActivated( SizeValueType itkNotUsed( block ) ) {}
+
+  /** Update the value of a node from its neighbors, and return true if
+   * it decreased. */
+  bool UpdateNode( const NodeType & node, OffsetValueType offset );
+
+  /** Get the region of a block. */
+  OutputRegionType GetBlockRegion( SizeValueType block ) const;
+
+  unsigned int  m_BlockSize;
+  SizeValueType m_NumberOfIterations;
+
+  // the blocks of the image and their state
+  SchedulerType                      m_Scheduler;
+
+  // cached buffers of the output and label images
+  OutputImageType *                  m_OutputCache;
+  OutputPixelType *                  m_OutputBuffer;
+  typename LabelImageType::PixelType *m_LabelBuffer;
+  OffsetValueType                    m_OffsetTable[ImageDimension + 1];
+
+  // the values above the threshold of the stopping criterion, if any, do
+  // not activate the blocks
+  OutputPixelType                    m_MaximumChangedValue;
+  };
+}
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkFastIterativeImageFilterBase.hxx"
+#endif
+
+#endif // itkFastIterativeImageFilterBase_h
@@ -0,0 +1,420 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkFastIterativeImageFilterBase_hxx
+#define itkFastIterativeImageFilterBase_hxx
+
+#include "itkFastIterativeImageFilterBase.h"
+
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkProgressReporter.h"
+#include <algorithm>
+
+namespace itk
+{
+// -----------------------------------------------------------------------------
+template< typename TInput, typename TOutput >
+FastIterativeImageFilterBase< TInput, TOutput >::
+FastIterativeImageFilterBase() :
+  m_BlockSize( 8 ),
+  m_NumberOfIterations( 0 ),
+  m_OutputCache( ITK_NULLPTR ),
+  m_OutputBuffer( ITK_NULLPTR ),
+  m_LabelBuffer( ITK_NULLPTR ),
+  m_MaximumChangedValue( NumericTraits< OutputPixelType >::max() )
+  {
+  for( unsigned int j = 0; j <= ImageDimension; j++ )
+    {
+    m_OffsetTable[j] = 0;
+    }
+  }
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template< typename TInput, typename TOutput >
+void
+FastIterativeImageFilterBase< TInput, TOutput >::
+GenerateData()
+  {
+  if( this->m_TopologyCheck != Superclass::Nothing )
+    {
+    // the topology checks depend on the order in which the nodes are fixed
+    Superclass::GenerateData();
+    return;
+    }
+
+  OutputImageType* output = this->GetOutput();
+
+  this->Initialize( output );
+
+  // the trial points are read from the output and the label image
+  while( !this->m_Heap.empty() )
+    {
+    this->m_Heap.pop();
+    }
+  this->m_BucketHeap.Clear();
+
+  this->m_StoppingCriterion->Reinitialize();
+
+  m_MaximumChangedValue = this->m_LargeValue;
+  ThresholdStoppingCriterionType * threshold =
+    dynamic_cast< ThresholdStoppingCriterionType * >( this->m_StoppingCriterion.GetPointer() );
+  if( threshold )
+    {
+    m_MaximumChangedValue = std::min( this->m_LargeValue, threshold->GetThreshold() );
+    }
+
+  m_OutputCache = output;
+  m_OutputBuffer = output->GetBufferPointer();
+  m_LabelBuffer = this->m_LabelImage->GetBufferPointer();
+  std::copy( output->GetOffsetTable(), output->GetOffsetTable() + ImageDimension + 1, m_OffsetTable );
+
+  this->SolveBlocks();
+  this->ApplyStoppingCriterion( output );
+
+  // let's release some useless memory...
+  while( !this->m_Heap.empty() )
+    {
+    this->m_Heap.pop();
+    }
+  m_Scheduler.Clear();
+  m_OutputCache = ITK_NULLPTR;
+  m_OutputBuffer = ITK_NULLPTR;
+  m_LabelBuffer = ITK_NULLPTR;
+  }
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template< typename TInput, typename TOutput >
+void
+FastIterativeImageFilterBase< TInput, TOutput >::
+SolveBlocks()
+  {
+  const NodeType start = this->m_BufferedRegion.GetIndex();
+
+  m_Scheduler.Initialize( this->m_BufferedRegion.GetSize(), m_BlockSize );
+
+  // activate the blocks of the alive and trial points, and their neighbors
+  typename Superclass::NodePairContainerType * seeds[2] =
+    { this->m_AlivePoints.GetPointer(), this->m_TrialPoints.GetPointer() };
+  for( unsigned int s = 0; s < 2; s++ )
+    {
+    if( !seeds[s] )
+      {
+      continue;
+      }
+    typename Superclass::NodePairContainerConstIterator pointsIter = seeds[s]->Begin();
+    for( ; pointsIter != seeds[s]->End(); ++pointsIter )
+      {
+      const NodeType node = pointsIter->Value().GetNode();
+      if( !this->m_BufferedRegion.IsInside( node ) )
+        {
+        continue;
+        }
+      const SizeValueType block = m_Scheduler.GetBlock( node - start );
+      m_Scheduler.ActivateBlock( block );
+      for( unsigned int j = 0; j < ImageDimension; j++ )
+        {
+        const SizeValueType b = m_Scheduler.GetBlockPosition( block, j );
+        if( b > 0 )
+          {
+          m_Scheduler.ActivateBlock( block - m_Scheduler.GetBlockStride( j ) );
+          }
+        if( b + 1 < m_Scheduler.GetNumberOfBlocks( j ) )
+          {
+          m_Scheduler.ActivateBlock( block + m_Scheduler.GetBlockStride( j ) );
+          }
+        }
+      }
+    }
+
+  m_NumberOfIterations = m_Scheduler.Run( this, this->GetMultiThreader(), this->GetNumberOfThreads() );
+  }
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template< typename TInput, typename TOutput >
+typename FastIterativeImageFilterBase< TInput, TOutput >::OutputRegionType
+FastIterativeImageFilterBase< TInput, TOutput >::
+GetBlockRegion( SizeValueType block ) const
+  {
+  const OutputSizeType size = this->m_BufferedRegion.GetSize();
+  NodeType             index = this->m_BufferedRegion.GetIndex();
+  OutputSizeType       blockSize;
+  for( unsigned int j = 0; j < ImageDimension; j++ )
+    {
+    const SizeValueType first = m_Scheduler.GetBlockPosition( block, j ) * m_BlockSize;
+    index[j] += first;
+    blockSize[j] = std::min( static_cast< SizeValueType >( m_BlockSize ), size[j] - first );
+    }
+  return OutputRegionType( index, blockSize );
+  }
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template< typename TInput, typename TOutput >
+unsigned int
+FastIterativeImageFilterBase< TInput, TOutput >::
+UpdateBlock( SizeValueType block )
+  {
+  const OutputRegionType region = this->GetBlockRegion( block );
+  const NodeType         start = this->m_BufferedRegion.GetIndex();
+  NodeType               first = region.GetIndex();
+  NodeType               last = first + region.GetSize();
+  for( unsigned int j = 0; j < ImageDimension; j++ )
+    {
+    --last[j];
+    }
+
+  unsigned int changedFaces = 0;
+  unsigned int sweep = 0;
+  bool         changed = true;
+  while( changed )
+    {
+    changed = false;
+
+    // each sweep goes through the block in one of the 2^ImageDimension
+    // directions
+    NodeType node;
+    for( unsigned int j = 0; j < ImageDimension; j++ )
+      {
+      node[j] = ( ( sweep >> j ) & 1 ) ? last[j] : first[j];
+      }
+
+    unsigned int axis = 0;
+    while( axis < ImageDimension )
+      {
+      OffsetValueType offset = 0;
+      for( unsigned int j = 0; j < ImageDimension; j++ )
+        {
+        offset += ( node[j] - start[j] ) * m_OffsetTable[j];
+        }
+      if( this->UpdateNode( node, offset ) && m_OutputBuffer[offset] < m_MaximumChangedValue )
+        {
+        changed = true;
+        for( unsigned int j = 0; j < ImageDimension; j++ )
+          {
+          if( node[j] == first[j] )
+            {
+            changedFaces |= 1u << ( 2 * j );
+            }
+          if( node[j] == last[j] )
+            {
+            changedFaces |= 1u << ( 2 * j + 1 );
+            }
+          }
+        }
+
+      // next node in the direction of the sweep
+      for( axis = 0; axis < ImageDimension; axis++ )
+        {
+        if( ( sweep >> axis ) & 1 )
+          {
+          if( node[axis] > first[axis] )
+            {
+            --node[axis];
+            break;
+            }
+          node[axis] = last[axis];
+          }
+        else
+          {
+          if( node[axis] < last[axis] )
+            {
+            ++node[axis];
+            break;
+            }
+          node[axis] = first[axis];
+          }
+        }
+      }
+    ++sweep;
+    }
+
+  return changedFaces;
+  }
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template< typename TInput, typename TOutput >
+bool
+FastIterativeImageFilterBase< TInput, TOutput >::
+UpdateNode( const NodeType & node, OffsetValueType offset )
+  {
+  const unsigned char label = m_LabelBuffer[offset];
+  if( ( label == Traits::Alive ) ||
+      ( label == Traits::InitialTrial ) ||
+      ( label == Traits::Forbidden ) )
+    {
+    return false;
+    }
+
+  // the smallest neighbor along each axis, as in GetInternalNodesUsed()
+  // but with the values which are not final yet
+  InternalNodeStructureArray nodesUsed;
+  bool isReached = false;
+  for( unsigned int j = 0; j < ImageDimension; j++ )
+    {
+    InternalNodeStructure & nodeUsed = nodesUsed[j];
+    nodeUsed.m_Node = node;
+    nodeUsed.m_Value = this->m_LargeValue;
+    nodeUsed.m_Axis = j;
+
+    const OffsetValueType stride = m_OffsetTable[j];
+    if( node[j] > this->m_StartIndex[j] )
+      {
+      const OffsetValueType neighbor = offset - stride;
+      if( m_LabelBuffer[neighbor] != Traits::Forbidden && m_OutputBuffer[neighbor] < nodeUsed.m_Value )
+        {
+        nodeUsed.m_Value = m_OutputBuffer[neighbor];
+        }
+      }
+    if( node[j] < this->m_LastIndex[j] )
+      {
+      const OffsetValueType neighbor = offset + stride;
+      if( m_LabelBuffer[neighbor] != Traits::Forbidden && m_OutputBuffer[neighbor] < nodeUsed.m_Value )
+        {
+        nodeUsed.m_Value = m_OutputBuffer[neighbor];
+        }
+      }
+    if( nodeUsed.m_Value < this->m_LargeValue )
+      {
+      isReached = true;
+      }
+    }
+  if( !isReached )
+    {
+    return false;
+    }
+
+  const OutputPixelType value =
+    static_cast< OutputPixelType >( this->Solve( m_OutputCache, node, nodesUsed ) );
+  if( value < m_OutputBuffer[offset] )
+    {
+    m_OutputBuffer[offset] = value;
+    return true;
+    }
+  return false;
+  }
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template< typename TInput, typename TOutput >
+void
+FastIterativeImageFilterBase< TInput, TOutput >::
+ApplyStoppingCriterion( OutputImageType* oImage )
+  {
+  // the nodes fast marching would have fixed, in the order of their values
+  NodePairVectorType nodes;
+  ImageRegionConstIteratorWithIndex< LabelImageType > labelIt( this->m_LabelImage, this->m_BufferedRegion );
+  for( OffsetValueType offset = 0; !labelIt.IsAtEnd(); ++labelIt, ++offset )
+    {
+    const unsigned char label = labelIt.Get();
+    const OutputPixelType value = m_OutputBuffer[offset];
+    if( ( label == Traits::InitialTrial ) ||
+        ( label == Traits::Far && value < this->m_LargeValue ) )
+      {
+      nodes.push_back( NodePairType( labelIt.GetIndex(), value ) );
+      }
+    }
+  std::stable_sort( nodes.begin(), nodes.end() );
+
+  ProgressReporter progress( this, 0, nodes.size() );
+
+  OutputPixelType current_value = 0.;
+  typename NodePairVectorType::const_iterator nodeIt = nodes.begin();
+  for( ; nodeIt != nodes.end(); ++nodeIt )
+    {
+    current_value = nodeIt->GetValue();
+
+    this->m_StoppingCriterion->SetCurrentNodePair( *nodeIt );
+    if( this->m_StoppingCriterion->IsSatisfied() )
+      {
+      break;
+      }
+
+    if( this->m_CollectPoints )
+      {
+      this->m_ProcessedPoints->push_back( *nodeIt );
+      }
+    this->SetLabelValueForGivenNode( nodeIt->GetNode(), Traits::Alive );
+    progress.CompletedPixel();
+    }
+
+  this->m_TargetReachedValue = current_value;
+
+  if( nodeIt == nodes.end() )
+    {
+    return;
+    }
+
+  // The nodes which have not been fixed get the values fast marching gives
+  // to its trial nodes, computed from their alive neighbors only.
+  typename NodePairVectorType::const_iterator remainingIt = nodeIt;
+  for( ; remainingIt != nodes.end(); ++remainingIt )
+    {
+    if( this->GetLabelValueForGivenNode( remainingIt->GetNode() ) == Traits::Far )
+      {
+      this->SetOutputValue( oImage, remainingIt->GetNode(), this->m_LargeValue );
+      }
+    }
+  for( remainingIt = nodeIt; remainingIt != nodes.end(); ++remainingIt )
+    {
+    const NodeType & node = remainingIt->GetNode();
+    if( this->GetLabelValueForGivenNode( node ) != Traits::Far )
+      {
+      continue;
+      }
+    bool hasAliveNeighbor = false;
+    NodeType neighbor = node;
+    for( unsigned int j = 0; j < ImageDimension && !hasAliveNeighbor; j++ )
+      {
+      for( int s = -1; s < 2; s += 2 )
+        {
+        neighbor[j] = node[j] + s;
+        if( this->m_BufferedRegion.IsInside( neighbor ) &&
+            this->GetLabelValueForGivenNode( neighbor ) == Traits::Alive )
+          {
+          hasAliveNeighbor = true;
+          }
+        }
+      neighbor[j] = node[j];
+      }
+    if( hasAliveNeighbor )
+      {
+      this->UpdateValue( oImage, node );
+      }
+    }
+  }
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template< typename TInput, typename TOutput >
+void
+FastIterativeImageFilterBase< TInput, TOutput >::
+PrintSelf( std::ostream & os, Indent indent ) const
+  {
+  Superclass::PrintSelf( os, indent );
+  os << indent << "Block Size: " << m_BlockSize << std::endl;
+  os << indent << "Number Of Iterations: " << m_NumberOfIterations << std::endl;
+  }
+// -----------------------------------------------------------------------------
+
+} // end of namespace itk
+
+#endif
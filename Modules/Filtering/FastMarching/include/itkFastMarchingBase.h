@@ -22,6 +22,7 @@
 #include "itkIntTypes.h"
 #include "itkFastMarchingStoppingCriterionBase.h"
 #include "itkFastMarchingTraits.h"
+#include "itkBucketPriorityQueue.h"
 
 #include <queue>
 #include <functional>
@@ -43,6 +44,12 @@ namespace itk
  * uses a std::priority_queue to locate the next proper node to
  * update.
  *
+ * When a tolerance on the values of the trial nodes is given with
+ * SetPriorityQueueTolerance(), the trial nodes are stored instead in a
+ * BucketPriorityQueue, with buckets of the width of the tolerance: a node
+ * is pushed and popped in a constant time, but the nodes whose values
+ * differ by less than the tolerance may be processed in any order.
+ *
  * Fast Marching sweeps through N points in (N log N) steps to obtain
  * the arrival time value as the front propagates through the domain.
  *
@@ -192,6 +199,14 @@ public:
   itkGetMacro( NormalizationFactor, double );
   itkSetMacro( NormalizationFactor, double );
 
+  /** \brief Set/Get the tolerance on the values of the trial nodes for
+   * their ordering. When 0, the default, the trial nodes are processed in
+   * the exact order of their values. When positive, the trial nodes are
+   * stored in buckets of this width, and processed in any order within a
+   * bucket. */
+  itkSetClampMacro( PriorityQueueTolerance, double, 0.0, NumericTraits< double >::max() );
+  itkGetConstMacro( PriorityQueueTolerance, double );
+
   /** \brief Get the value reached by the front when it stops propagating */
   itkGetMacro( TargetReachedValue, OutputPixelType );
 
@@ -242,6 +257,19 @@ protected:
 
   PriorityQueueType m_Heap;
 
+  /** The trial nodes when the priority queue tolerance is positive. */
+  typedef BucketPriorityQueue< NodePairType, OutputPixelType > BucketPriorityQueueType;
+  BucketPriorityQueueType m_BucketHeap;
+
+  double m_PriorityQueueTolerance;
+
+  /** \brief Add a trial node to the priority queue */
+  void PushNodePair( const NodePairType & iNodePair );
+
+  /** \brief Remove the trial node with the lowest value from the priority
+   * queue. */
+  NodePairType PopNodePair();
+
   TopologyCheckType m_TopologyCheck;
 
   /** \brief Get the total number of nodes in the domain */
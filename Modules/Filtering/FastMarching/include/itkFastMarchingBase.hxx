@@ -48,6 +48,7 @@ FastMarchingBase()
   m_LargeValue = NumericTraits< OutputPixelType >::max();
   m_TopologyValue = m_LargeValue;
   m_CollectPoints = false;
+  m_PriorityQueueTolerance = 0.;
   }
 // -----------------------------------------------------------------------------
 
@@ -69,6 +70,44 @@ PrintSelf( std::ostream & os, Indent indent ) const
   os << indent << "Speed constant: " << m_SpeedConstant << std::endl;
   os << indent << "Topology check: " << m_TopologyCheck << std::endl;
   os << indent << "Normalization Factor: " << m_NormalizationFactor << std::endl;
+  os << indent << "Priority Queue Tolerance: " << m_PriorityQueueTolerance << std::endl;
+  }
+
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template< typename TInput, typename TOutput >
+void
+FastMarchingBase< TInput, TOutput >::
+PushNodePair( const NodePairType & iNodePair )
+  {
+  if( m_PriorityQueueTolerance > 0. )
+    {
+    m_BucketHeap.Push( iNodePair, iNodePair.GetValue() );
+    }
+  else
+    {
+    m_Heap.push( iNodePair );
+    }
+  }
+
+// -----------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------
+template< typename TInput, typename TOutput >
+typename FastMarchingBase< TInput, TOutput >::NodePairType
+FastMarchingBase< TInput, TOutput >::
+PopNodePair()
+  {
+  if( m_PriorityQueueTolerance > 0. )
+    {
+    NodePairType node_pair = m_BucketHeap.Front();
+    m_BucketHeap.Pop();
+    return node_pair;
+    }
+  NodePairType node_pair = m_Heap.top();
+  m_Heap.pop();
+  return node_pair;
   }
 
 // -----------------------------------------------------------------------------
@@ -108,6 +147,11 @@ Initialize( OutputDomainType* oDomain )
     {
     m_Heap.pop();
     }
+  m_BucketHeap.Clear();
+  if( m_PriorityQueueTolerance > 0. )
+    {
+    m_BucketHeap.SetBucketWidth( m_PriorityQueueTolerance );
+    }
   /*
   while ( !m_Heap->Empty() )
     {
@@ -142,7 +186,7 @@ GenerateData()
   try
     {
     //while( !m_Heap->Empty() )
-    while( !m_Heap.empty() )
+    while( !m_Heap.empty() || !m_BucketHeap.Empty() )
       {
       //PriorityQueueElementType element = m_Heap->Peek();
       //m_Heap->Pop();
@@ -151,8 +195,7 @@ GenerateData()
       //OutputPixelType current_value = element.m_Priority;
 
 
-      NodePairType current_node_pair = m_Heap.top();
-      m_Heap.pop();
+      NodePairType current_node_pair = this->PopNodePair();
 
       NodeType current_node = current_node_pair.GetNode();
       current_value = this->GetOutputValue( output, current_node );
@@ -199,6 +242,7 @@ GenerateData()
       {
       m_Heap.pop();
       }
+    m_BucketHeap.Clear();
     /*while( !m_Heap->Empty() )
       {
       m_Heap->Pop();
@@ -214,6 +258,7 @@ GenerateData()
     {
     m_Heap.pop();
     }
+  m_BucketHeap.Clear();
   /*while( !m_Heap->Empty() )
     {
     m_Heap->Pop();
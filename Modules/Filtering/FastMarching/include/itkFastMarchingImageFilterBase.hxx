@@ -244,7 +244,7 @@ UpdateValue( OutputImageType* oImage, const NodeType& iNode )
     this->SetLabelValueForGivenNode( iNode, Traits::Trial );
 
     // insert point into trial heap
-    this->m_Heap.push( NodePairType( iNode, outputPixel ) );
+    this->PushNodePair( NodePairType( iNode, outputPixel ) );
     }
   }
 // -----------------------------------------------------------------------------
@@ -639,7 +639,7 @@ InitializeOutput( OutputImageType* oImage )
         this->SetOutputValue( oImage, idx, outputPixel );
 
         //this->m_Heap->Push( PriorityQueueElementType( idx, pointsIter->second ) );
-        this->m_Heap.push( pointsIter->Value() );
+        this->PushNodePair( pointsIter->Value() );
         }
       ++pointsIter;
       }
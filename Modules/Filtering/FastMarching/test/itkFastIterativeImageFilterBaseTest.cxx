@@ -0,0 +1,181 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFastIterativeImageFilterBase.h"
+#include "itkFastMarchingNumberOfElementsStoppingCriterion.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+const unsigned int Dimension = 3;
+
+typedef float                                 PixelType;
+typedef itk::Image< PixelType, Dimension >    ImageType;
+
+typedef itk::FastMarchingImageFilterBase< ImageType, ImageType >            FastMarchingType;
+typedef itk::FastIterativeImageFilterBase< ImageType, ImageType >           FastIterativeType;
+typedef itk::FastMarchingThresholdStoppingCriterion< ImageType, ImageType > ThresholdCriterionType;
+typedef itk::FastMarchingNumberOfElementsStoppingCriterion< ImageType, ImageType >
+                                                                            NumberOfElementsCriterionType;
+typedef FastMarchingType::NodePairType                                      NodePairType;
+typedef FastMarchingType::NodePairContainerType                             NodePairContainerType;
+
+void
+SetPoints( FastMarchingType * filter, const ImageType * speed )
+{
+  NodePairContainerType::Pointer trial = NodePairContainerType::New();
+  ImageType::IndexType index;
+  index[0] = 3;
+  index[1] = 4;
+  index[2] = 5;
+  trial->push_back( NodePairType( index, 0. ) );
+  index[0] = 30;
+  index[1] = 20;
+  index[2] = 2;
+  trial->push_back( NodePairType( index, 2. ) );
+
+  // a wall with a hole
+  NodePairContainerType::Pointer forbidden = NodePairContainerType::New();
+  for( index[1] = 0; index[1] < 28; ++index[1] )
+    {
+    for( index[2] = 0; index[2] < 12; ++index[2] )
+      {
+      index[0] = 15;
+      if( index[1] != 20 || index[2] != 6 )
+        {
+        forbidden->push_back( NodePairType( index, 0. ) );
+        }
+      }
+    }
+
+  filter->SetInput( speed );
+  filter->SetTrialPoints( trial );
+  filter->SetForbiddenPoints( forbidden );
+}
+
+bool
+CompareOutputs( const ImageType * image1, const ImageType * image2, double tolerance )
+{
+  itk::ImageRegionConstIterator< ImageType > it1( image1, image1->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< ImageType > it2( image2, image2->GetLargestPossibleRegion() );
+  for( ; !it1.IsAtEnd(); ++it1, ++it2 )
+    {
+    if( std::fabs( static_cast< double >( it1.Get() ) - static_cast< double >( it2.Get() ) ) > tolerance )
+      {
+      std::cerr << "The outputs differ at " << it1.GetIndex() << ": "
+                << it1.Get() << " and " << it2.Get() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+// Compare the arrival times of the fast iterative method to the ones of
+// fast marching, with several stopping criteria and numbers of threads.
+int itkFastIterativeImageFilterBaseTest( int, char * [] )
+{
+  ImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 28;
+  size[2] = 12;
+  ImageType::Pointer speed = ImageType::New();
+  speed->SetRegions( size );
+  speed->Allocate();
+  itk::ImageRegionIterator< ImageType > it( speed, speed->GetLargestPossibleRegion() );
+  for( ; !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType & index = it.GetIndex();
+    it.Set( 1.0f + 0.5f * ( ( index[0] / 5 + index[1] / 3 + index[2] / 4 ) % 3 ) );
+    }
+
+  FastIterativeType::Pointer fastIterative = FastIterativeType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( fastIterative, FastIterativeImageFilterBase, FastMarchingImageFilterBase );
+  TEST_SET_GET_VALUE( 8, fastIterative->GetBlockSize() );
+
+  // with a threshold
+  ThresholdCriterionType::Pointer threshold = ThresholdCriterionType::New();
+  threshold->SetThreshold( 20. );
+
+  FastMarchingType::Pointer fastMarching = FastMarchingType::New();
+  SetPoints( fastMarching, speed );
+  fastMarching->SetStoppingCriterion( threshold );
+  TRY_EXPECT_NO_EXCEPTION( fastMarching->Update() );
+
+  const unsigned int blockSizes[] = { 1, 5, 8 };
+  const unsigned int numberOfThreads[] = { 1, 3, 8 };
+  ImageType::Pointer firstOutput;
+  for( unsigned int b = 0; b < 3; ++b )
+    {
+    for( unsigned int t = 0; t < 3; ++t )
+      {
+      fastIterative = FastIterativeType::New();
+      SetPoints( fastIterative, speed );
+      fastIterative->SetStoppingCriterion( threshold );
+      fastIterative->SetBlockSize( blockSizes[b] );
+      fastIterative->SetNumberOfThreads( numberOfThreads[t] );
+      TRY_EXPECT_NO_EXCEPTION( fastIterative->Update() );
+      std::cout << "Block size " << blockSizes[b] << ", " << numberOfThreads[t] << " threads: "
+                << fastIterative->GetNumberOfIterations() << " iterations" << std::endl;
+
+      if( !CompareOutputs( fastMarching->GetOutput(), fastIterative->GetOutput(), 1e-4 ) )
+        {
+        return EXIT_FAILURE;
+        }
+      TEST_EXPECT_TRUE( itk::Math::FloatAlmostEqual( fastMarching->GetTargetReachedValue(),
+                                                     fastIterative->GetTargetReachedValue(), 4, 1e-4f ) );
+
+      // the result does not depend on the number of threads
+      if( t == 0 )
+        {
+        firstOutput = fastIterative->GetOutput();
+        firstOutput->DisconnectPipeline();
+        }
+      else if( !CompareOutputs( firstOutput, fastIterative->GetOutput(), 0. ) )
+        {
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // with a number of elements, collecting the points
+  NumberOfElementsCriterionType::Pointer numberOfElements = NumberOfElementsCriterionType::New();
+  numberOfElements->SetTargetNumberOfElements( 2000 );
+
+  fastMarching = FastMarchingType::New();
+  SetPoints( fastMarching, speed );
+  fastMarching->SetStoppingCriterion( numberOfElements );
+  fastMarching->CollectPointsOn();
+  TRY_EXPECT_NO_EXCEPTION( fastMarching->Update() );
+
+  fastIterative = FastIterativeType::New();
+  SetPoints( fastIterative, speed );
+  fastIterative->SetStoppingCriterion( numberOfElements );
+  fastIterative->CollectPointsOn();
+  TRY_EXPECT_NO_EXCEPTION( fastIterative->Update() );
+
+  TEST_EXPECT_EQUAL( fastMarching->GetProcessedPoints()->Size(), fastIterative->GetProcessedPoints()->Size() );
+  if( !CompareOutputs( fastMarching->GetOutput(), fastIterative->GetOutput(), 1e-4 ) )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -22,7 +22,9 @@
 #include "itkObjectFactory.h"
 #include "itkImageLinearIteratorWithIndex.h"
 #include "itkProgressReporter.h"
+#include "itkDefaultConvertPixelTraits.h"
 #include <new>
+#include <vector>
 
 namespace itk
 {
@@ -50,6 +52,7 @@ RecursiveSeparableImageFilter< TInputImage, TOutputImage >
   m_BM3( 0.0 ),
   m_BM4( 0.0 ),
   m_Direction( 0 ),
+  m_NumberOfLinesPerBatch( 8 ),
   m_ImageRegionSplitter(ImageRegionSplitterDirection::New())
 {
   this->SetNumberOfRequiredOutputs(1);
@@ -170,6 +173,138 @@ RecursiveSeparableImageFilter< TInputImage, TOutputImage >
     }
 }
 
+/**
+ * Apply Recursive Filter to a batch of interleaved lines
+ */
+template< typename TInputImage, typename TOutputImage >
+void
+RecursiveSeparableImageFilter< TInputImage, TOutputImage >
+::FilterDataArrayBatch(ScalarRealType *outs, const ScalarRealType *data,
+                       ScalarRealType *scratch, SizeValueType ln,
+                       SizeValueType numberOfLanes)
+{
+  // Local copies of the coefficients, so that the compiler does not have
+  // to reload them from the object after each store in the inner loops.
+  const ScalarRealType n0 = m_N0;
+  const ScalarRealType n1 = m_N1;
+  const ScalarRealType n2 = m_N2;
+  const ScalarRealType n3 = m_N3;
+  const ScalarRealType d1 = m_D1;
+  const ScalarRealType d2 = m_D2;
+  const ScalarRealType d3 = m_D3;
+  const ScalarRealType d4 = m_D4;
+  const ScalarRealType m1 = m_M1;
+  const ScalarRealType m2 = m_M2;
+  const ScalarRealType m3 = m_M3;
+  const ScalarRealType m4 = m_M4;
+
+  const SizeValueType L = numberOfLanes;
+
+  /**
+   * Causal direction pass, initialize borders. The first value of each
+   * lane is assumed to exist from the border to infinity.
+   */
+  for ( SizeValueType k = 0; k < L; ++k )
+    {
+    const ScalarRealType v = data[k];
+    const ScalarRealType x1 = data[L + k];
+    const ScalarRealType x2 = data[2 * L + k];
+    const ScalarRealType x3 = data[3 * L + k];
+
+    ScalarRealType y0 = v  * n0 + v  * n1 + v  * n2 + v * n3;
+    ScalarRealType y1 = x1 * n0 + v  * n1 + v  * n2 + v * n3;
+    ScalarRealType y2 = x2 * n0 + x1 * n1 + v  * n2 + v * n3;
+    ScalarRealType y3 = x3 * n0 + x2 * n1 + x1 * n2 + v * n3;
+
+    y0 -= v  * m_BN1 + v  * m_BN2 + v  * m_BN3 + v * m_BN4;
+    y1 -= y0 * d1    + v  * m_BN2 + v  * m_BN3 + v * m_BN4;
+    y2 -= y1 * d1    + y0 * d2    + v  * m_BN3 + v * m_BN4;
+    y3 -= y2 * d1    + y1 * d2    + y0 * d3    + v * m_BN4;
+
+    outs[k] = y0;
+    outs[L + k] = y1;
+    outs[2 * L + k] = y2;
+    outs[3 * L + k] = y3;
+    }
+
+  /**
+   * Recursively filter the rest, all lanes of a sample at once
+   */
+  for ( SizeValueType i = 4; i < ln; ++i )
+    {
+    const ScalarRealType *x0 = data + i * L;
+    const ScalarRealType *x1 = x0 - L;
+    const ScalarRealType *x2 = x1 - L;
+    const ScalarRealType *x3 = x2 - L;
+    const ScalarRealType *y1 = outs + ( i - 1 ) * L;
+    const ScalarRealType *y2 = y1 - L;
+    const ScalarRealType *y3 = y2 - L;
+    const ScalarRealType *y4 = y3 - L;
+    ScalarRealType       *y0 = outs + i * L;
+    for ( SizeValueType k = 0; k < L; ++k )
+      {
+      y0[k] = ( x0[k] * n0 + x1[k] * n1 + x2[k] * n2 + x3[k] * n3 )
+              - ( y1[k] * d1 + y2[k] * d2 + y3[k] * d3 + y4[k] * d4 );
+      }
+    }
+
+  /**
+   * AntiCausal direction pass, initialize borders. The last value of each
+   * lane is assumed to exist from the border to infinity.
+   */
+  for ( SizeValueType k = 0; k < L; ++k )
+    {
+    const ScalarRealType v = data[( ln - 1 ) * L + k];
+    const ScalarRealType x1 = data[( ln - 2 ) * L + k];
+    const ScalarRealType x2 = data[( ln - 3 ) * L + k];
+
+    ScalarRealType y0 = v  * m1 + v  * m2 + v  * m3 + v * m4;
+    ScalarRealType y1 = v  * m1 + v  * m2 + v  * m3 + v * m4;
+    ScalarRealType y2 = x1 * m1 + v  * m2 + v  * m3 + v * m4;
+    ScalarRealType y3 = x2 * m1 + x1 * m2 + v  * m3 + v * m4;
+
+    y0 -= v  * m_BM1 + v  * m_BM2 + v  * m_BM3 + v * m_BM4;
+    y1 -= y0 * d1    + v  * m_BM2 + v  * m_BM3 + v * m_BM4;
+    y2 -= y1 * d1    + y0 * d2    + v  * m_BM3 + v * m_BM4;
+    y3 -= y2 * d1    + y1 * d2    + y0 * d3    + v * m_BM4;
+
+    scratch[( ln - 1 ) * L + k] = y0;
+    scratch[( ln - 2 ) * L + k] = y1;
+    scratch[( ln - 3 ) * L + k] = y2;
+    scratch[( ln - 4 ) * L + k] = y3;
+    }
+
+  /**
+   * Recursively filter the rest
+   */
+  for ( SizeValueType i = ln - 4; i > 0; --i )
+    {
+    const ScalarRealType *x0 = data + i * L;
+    const ScalarRealType *x1 = x0 + L;
+    const ScalarRealType *x2 = x1 + L;
+    const ScalarRealType *x3 = x2 + L;
+    const ScalarRealType *y1 = scratch + i * L;
+    const ScalarRealType *y2 = y1 + L;
+    const ScalarRealType *y3 = y2 + L;
+    const ScalarRealType *y4 = y3 + L;
+    ScalarRealType       *y0 = scratch + ( i - 1 ) * L;
+    for ( SizeValueType k = 0; k < L; ++k )
+      {
+      y0[k] = ( x0[k] * m1 + x1[k] * m2 + x2[k] * m3 + x3[k] * m4 )
+              - ( y1[k] * d1 + y2[k] * d2 + y3[k] * d3 + y4[k] * d4 );
+      }
+    }
+
+  /**
+   * Roll the antiCausal part into the output
+   */
+  const SizeValueType numberOfValues = ln * L;
+  for ( SizeValueType i = 0; i < numberOfValues; ++i )
+    {
+    outs[i] += scratch[i];
+    }
+}
+
 //
 // we need all of the image in just the "Direction" we are separated into
 //
@@ -255,6 +390,12 @@ void
 RecursiveSeparableImageFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, ThreadIdType threadId)
 {
+  if ( this->m_NumberOfLinesPerBatch > 1 )
+    {
+    this->BatchedGenerateData(outputRegionForThread, threadId);
+    return;
+    }
+
   typedef typename TOutputImage::PixelType OutputPixelType;
 
   typedef ImageLinearConstIteratorWithIndex< TInputImage > InputConstIteratorType;
@@ -337,6 +478,116 @@ RecursiveSeparableImageFilter< TInputImage, TOutputImage >
   delete[] scratch;
 }
 
+/**
+ * Compute Recursive filter
+ * several lines at a time in one of the dimensions
+ */
+template< typename TInputImage, typename TOutputImage >
+void
+RecursiveSeparableImageFilter< TInputImage, TOutputImage >
+::BatchedGenerateData(const OutputImageRegionType & outputRegionForThread, ThreadIdType threadId)
+{
+  typedef typename TOutputImage::PixelType OutputPixelType;
+
+  typedef DefaultConvertPixelTraits< InputPixelType >  InputPixelTraitsType;
+  typedef DefaultConvertPixelTraits< OutputPixelType > OutputPixelTraitsType;
+  typedef typename OutputPixelTraitsType::ComponentType OutputComponentType;
+
+  typedef ImageLinearConstIteratorWithIndex< TInputImage > InputConstIteratorType;
+  typedef ImageLinearIteratorWithIndex< TOutputImage >     OutputIteratorType;
+
+  typename TInputImage::ConstPointer inputImage( this->GetInputImage () );
+  typename TOutputImage::Pointer     outputImage( this->GetOutput() );
+
+  if ( outputRegionForThread.GetNumberOfPixels() == 0 )
+    {
+    return;
+    }
+
+  InputConstIteratorType inputIterator(inputImage,  outputRegionForThread);
+  OutputIteratorType     outputIterator(outputImage, outputRegionForThread);
+
+  inputIterator.SetDirection(this->m_Direction);
+  outputIterator.SetDirection(this->m_Direction);
+
+  inputIterator.GoToBegin();
+  outputIterator.GoToBegin();
+
+  const SizeValueType ln = outputRegionForThread.GetSize(this->m_Direction);
+  const unsigned int  numberOfComponents = NumericTraits< InputPixelType >::GetLength( inputIterator.Get() );
+  const unsigned int  maximumNumberOfLines = this->m_NumberOfLinesPerBatch;
+
+  // All the buffers are allocated once per thread: the samples of the
+  // lines of a batch are interleaved, so that the values of all the lines
+  // and components at one position along the direction are contiguous.
+  const SizeValueType bufferSize = ln * maximumNumberOfLines * numberOfComponents;
+  std::vector< ScalarRealType > inps( bufferSize );
+  std::vector< ScalarRealType > outs( bufferSize );
+  std::vector< ScalarRealType > scratch( bufferSize );
+
+  std::vector< InputConstIteratorType > inputLines( maximumNumberOfLines, inputIterator );
+  std::vector< OutputIteratorType >     outputLines( maximumNumberOfLines, outputIterator );
+
+  OutputPixelType outputPixel;
+  NumericTraits< OutputPixelType >::SetLength( outputPixel, numberOfComponents );
+
+  const SizeValueType numberOfLinesToProcess = outputRegionForThread.GetNumberOfPixels() / ln;
+  ProgressReporter    progress(this, threadId, numberOfLinesToProcess, 10);
+
+  while ( !inputIterator.IsAtEnd() && !outputIterator.IsAtEnd() )
+    {
+    unsigned int numberOfLines = 0;
+    while ( numberOfLines < maximumNumberOfLines && !inputIterator.IsAtEnd() && !outputIterator.IsAtEnd() )
+      {
+      inputLines[numberOfLines] = inputIterator;
+      outputLines[numberOfLines] = outputIterator;
+      ++numberOfLines;
+      inputIterator.NextLine();
+      outputIterator.NextLine();
+      }
+
+    const SizeValueType numberOfLanes = numberOfLines * numberOfComponents;
+
+    // Gather the batch, visiting the lines in lock step so that
+    // neighboring lines are read together.
+    ScalarRealType *sample = &inps[0];
+    for ( SizeValueType i = 0; i < ln; ++i )
+      {
+      for ( unsigned int line = 0; line < numberOfLines; ++line )
+        {
+        const InputPixelType & value = inputLines[line].Get();
+        for ( unsigned int c = 0; c < numberOfComponents; ++c )
+          {
+          *sample++ = static_cast< ScalarRealType >( InputPixelTraitsType::GetNthComponent(c, value) );
+          }
+        ++inputLines[line];
+        }
+      }
+
+    this->FilterDataArrayBatch(&outs[0], &inps[0], &scratch[0], ln, numberOfLanes);
+
+    // Scatter the filtered batch back to the output lines.
+    const ScalarRealType *result = &outs[0];
+    for ( SizeValueType i = 0; i < ln; ++i )
+      {
+      for ( unsigned int line = 0; line < numberOfLines; ++line )
+        {
+        for ( unsigned int c = 0; c < numberOfComponents; ++c )
+          {
+          OutputPixelTraitsType::SetNthComponent( c, outputPixel, static_cast< OutputComponentType >( *result++ ) );
+          }
+        outputLines[line].Set( outputPixel );
+        ++outputLines[line];
+        }
+      }
+
+    for ( unsigned int line = 0; line < numberOfLines; ++line )
+      {
+      progress.CompletedPixel();
+      }
+    }
+}
+
 template< typename TInputImage, typename TOutputImage >
 void
 RecursiveSeparableImageFilter< TInputImage, TOutputImage >
@@ -345,6 +596,7 @@ RecursiveSeparableImageFilter< TInputImage, TOutputImage >
   Superclass::PrintSelf(os, indent);
 
   os << indent << "Direction: " << m_Direction << std::endl;
+  os << indent << "NumberOfLinesPerBatch: " << m_NumberOfLinesPerBatch << std::endl;
 }
 } // end namespace itk
 
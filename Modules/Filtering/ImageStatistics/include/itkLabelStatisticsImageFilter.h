@@ -18,12 +18,14 @@
 #ifndef itkLabelStatisticsImageFilter_h
 #define itkLabelStatisticsImageFilter_h
 
-#include "itkImageToImageFilter.h"
+#include "itkStreamingReductionImageFilter.h"
 #include "itkNumericTraits.h"
 #include "itkSimpleDataObjectDecorator.h"
 #include "itksys/hash_map.hxx"
 #include "itkHistogram.h"
 #include "itkFastMutexLock.h"
+#include "itkMultiThreader.h"
+#include <limits>
 #include <vector>
 
 namespace itk
@@ -47,8 +49,19 @@ namespace itk
  *
  * The filter passes its intensity input through unmodified.  The filter is
  * threaded. It computes statistics in each thread then combines them in
- * its AfterThreadedGenerate method.
+ * its AfterStreamedGenerateData method.
  *
+ * The statistics are updated once per run of pixels with the same label
+ * along the first dimension. For the label types with at most 16 bits,
+ * like unsigned char and unsigned short, the statistics of a label are
+ * found with a table indexed by the label instead of the hash map. The
+ * statistics of the threads are merged two by two, in parallel.
+ *
+ * With SetNumberOfStreamDivisions(), the filter reads the same pieces of
+ * its intensity and label inputs one after the other, instead of all at
+ * once. The intensity input is then not passed through.
+ *
+ * \sa StreamingReductionImageFilter
  * \ingroup MathematicalStatisticsImageFilters
  * \ingroup ITKImageStatistics
  *
@@ -58,20 +71,20 @@ namespace itk
  */
 template< typename TInputImage, typename TLabelImage >
 class ITK_TEMPLATE_EXPORT LabelStatisticsImageFilter:
-  public ImageToImageFilter< TInputImage, TInputImage >
+  public StreamingReductionImageFilter< TInputImage >
 {
 public:
   /** Standard Self typedef */
-  typedef LabelStatisticsImageFilter                     Self;
-  typedef ImageToImageFilter< TInputImage, TInputImage > Superclass;
-  typedef SmartPointer< Self >                           Pointer;
-  typedef SmartPointer< const Self >                     ConstPointer;
+  typedef LabelStatisticsImageFilter                    Self;
+  typedef StreamingReductionImageFilter< TInputImage > Superclass;
+  typedef SmartPointer< Self >                          Pointer;
+  typedef SmartPointer< const Self >                    ConstPointer;
 
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
   /** Runtime information support. */
-  itkTypeMacro(LabelStatisticsImageFilter, ImageToImageFilter);
+  itkTypeMacro(LabelStatisticsImageFilter, StreamingReductionImageFilter);
 
   /** Image related typedefs. */
   typedef typename TInputImage::Pointer    InputImagePointer;
@@ -335,23 +348,46 @@ protected:
   void AllocateOutputs() ITK_OVERRIDE;
 
   /** Initialize some accumulators before the threads run. */
-  void BeforeThreadedGenerateData() ITK_OVERRIDE;
+  void BeforeStreamedGenerateData() ITK_OVERRIDE;
 
   /** Do final mean and variance computation from data accumulated in threads.
     */
-  void AfterThreadedGenerateData() ITK_OVERRIDE;
+  void AfterStreamedGenerateData() ITK_OVERRIDE;
 
-  /** Multi-thread version GenerateData. */
-  void  ThreadedGenerateData(const RegionType &
-                             outputRegionForThread,
-                             ThreadIdType threadId) ITK_OVERRIDE;
-
-  // Override since the filter produces all of its output
-  void EnlargeOutputRequestedRegion(DataObject *data) ITK_OVERRIDE;
+  /** Accumulate a region of the inputs in the statistics of a thread. */
+  void  ThreadedStreamedGenerateData(const RegionType &
+                                     regionForThread,
+                                     ThreadIdType threadId) ITK_OVERRIDE;
 
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(LabelStatisticsImageFilter);
 
+  /** Whether the statistics of the labels can be found with a table
+   * indexed by the label, and the size of that table. */
+  static bool UseLabelTable()
+  {
+    return std::numeric_limits< LabelPixelType >::is_integer && sizeof( LabelPixelType ) <= 2;
+  }
+  static SizeValueType GetLabelTableSize()
+  {
+    return static_cast< SizeValueType >( 1 ) << ( 8 * sizeof( LabelPixelType ) );
+  }
+
+  /** Create the statistics of a new label in map. */
+  MapIterator InsertLabel(MapType & map, const LabelPixelType & label) const;
+
+  /** Add the statistics of source in target. */
+  void MergeLabelStatistics(MapType & target, const MapType & source) const;
+
+  struct MergeThreadStruct
+  {
+    Self *       Filter;
+    ThreadIdType Step;
+    ThreadIdType NumberOfMerges;
+  };
+
+  static ITK_THREAD_RETURN_TYPE MergeThreaderCallback(void *arg);
+
   std::vector< MapType >        m_LabelStatisticsPerThread;
   MapType                       m_LabelStatistics;
   ValidLabelValuesContainerType m_ValidLabelValues;
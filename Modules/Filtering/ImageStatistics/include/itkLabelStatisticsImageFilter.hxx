@@ -38,15 +38,6 @@ LabelStatisticsImageFilter< TInputImage, TLabelImage >
   m_ValidLabelValues.clear();
 }
 
-template< typename TInputImage, typename TLabelImage >
-void
-LabelStatisticsImageFilter< TInputImage, TLabelImage >
-::EnlargeOutputRequestedRegion(DataObject *data)
-{
-  Superclass::EnlargeOutputRequestedRegion(data);
-  data->SetRequestedRegionToLargestPossibleRegion();
-}
-
 template< typename TInputImage, typename TLabelImage >
 void
 LabelStatisticsImageFilter< TInputImage, TLabelImage >
@@ -75,7 +66,7 @@ LabelStatisticsImageFilter< TInputImage, TLabelImage >
 template< typename TInputImage, typename TLabelImage >
 void
 LabelStatisticsImageFilter< TInputImage, TLabelImage >
-::BeforeThreadedGenerateData()
+::BeforeStreamedGenerateData()
 {
   ThreadIdType numberOfThreads = this->GetNumberOfThreads();
 
@@ -92,87 +83,126 @@ LabelStatisticsImageFilter< TInputImage, TLabelImage >
   m_LabelStatistics.clear();
 }
 
+template< typename TInputImage, typename TLabelImage >
+typename LabelStatisticsImageFilter< TInputImage, TLabelImage >::MapIterator
+LabelStatisticsImageFilter< TInputImage, TLabelImage >
+::InsertLabel(MapType & map, const LabelPixelType & label) const
+{
+  // create a new statistics object
+  typedef typename MapType::value_type MapValueType;
+  if ( m_UseHistograms )
+    {
+    return map.insert( MapValueType( label, LabelStatistics(m_NumBins[0], m_LowerBound, m_UpperBound) ) ).first;
+    }
+  return map.insert( MapValueType( label, LabelStatistics() ) ).first;
+}
+
 template< typename TInputImage, typename TLabelImage >
 void
 LabelStatisticsImageFilter< TInputImage, TLabelImage >
-::AfterThreadedGenerateData()
+::MergeLabelStatistics(MapType & target, const MapType & source) const
 {
-  MapIterator      mapIt;
-  MapConstIterator threadIt;
-  ThreadIdType     i;
-  ThreadIdType     numberOfThreads = this->GetNumberOfThreads();
-
-  // Run through the map for each thread and accumulate the count,
-  // sum, and sumofsquares
-  for ( i = 0; i < numberOfThreads; i++ )
-    {
-    // iterate over the map for this thread
-    for ( threadIt = m_LabelStatisticsPerThread[i].begin();
-          threadIt != m_LabelStatisticsPerThread[i].end();
-          ++threadIt )
+  for ( MapConstIterator threadIt = source.begin(); threadIt != source.end(); ++threadIt )
+    {
+    // does this label exist in the cumulative structure yet?
+    MapIterator mapIt = target.find( ( *threadIt ).first );
+    if ( mapIt == target.end() )
       {
-      // does this label exist in the cumulative structure yet?
-      mapIt = m_LabelStatistics.find( ( *threadIt ).first );
-      if ( mapIt == m_LabelStatistics.end() )
-        {
-        // create a new entry
-        typedef typename MapType::value_type MapValueType;
-        if ( m_UseHistograms )
-          {
-          mapIt = m_LabelStatistics.insert( MapValueType( ( *threadIt ).first,
-                                                          LabelStatistics(m_NumBins[0], m_LowerBound,
-                                                                          m_UpperBound) ) ).first;
-          }
-        else
-          {
-          mapIt = m_LabelStatistics.insert( MapValueType( ( *threadIt ).first,
-                                                          LabelStatistics() ) ).first;
-          }
-        }
+      // simply take the statistics of the source
+      target.insert( *threadIt );
+      continue;
+      }
 
+    typename MapType::mapped_type &labelStats = ( *mapIt ).second;
 
-      typename MapType::mapped_type &labelStats = ( *mapIt ).second;
+    // accumulate the information from this thread
+    labelStats.m_Count += ( *threadIt ).second.m_Count;
+    labelStats.m_Sum += ( *threadIt ).second.m_Sum;
+    labelStats.m_SumOfSquares += ( *threadIt ).second.m_SumOfSquares;
 
-      // accumulate the information from this thread
-      labelStats.m_Count += ( *threadIt ).second.m_Count;
-      labelStats.m_Sum += ( *threadIt ).second.m_Sum;
-      labelStats.m_SumOfSquares += ( *threadIt ).second.m_SumOfSquares;
+    if ( labelStats.m_Minimum > ( *threadIt ).second.m_Minimum )
+      {
+      labelStats.m_Minimum = ( *threadIt ).second.m_Minimum;
+      }
+    if ( labelStats.m_Maximum < ( *threadIt ).second.m_Maximum )
+      {
+      labelStats.m_Maximum = ( *threadIt ).second.m_Maximum;
+      }
 
-      if ( labelStats.m_Minimum > ( *threadIt ).second.m_Minimum )
+    //bounding box is min,max pairs
+    for ( unsigned int ii = 0; ii < ( ImageDimension * 2 ); ii += 2 )
+      {
+      if ( labelStats.m_BoundingBox[ii] > ( *threadIt ).second.m_BoundingBox[ii] )
         {
-        labelStats.m_Minimum = ( *threadIt ).second.m_Minimum;
+        labelStats.m_BoundingBox[ii] = ( *threadIt ).second.m_BoundingBox[ii];
         }
-      if ( labelStats.m_Maximum < ( *threadIt ).second.m_Maximum )
+      if ( labelStats.m_BoundingBox[ii + 1] < ( *threadIt ).second.m_BoundingBox[ii + 1] )
         {
-        labelStats.m_Maximum = ( *threadIt ).second.m_Maximum;
+        labelStats.m_BoundingBox[ii + 1] = ( *threadIt ).second.m_BoundingBox[ii + 1];
         }
+      }
 
-      //bounding box is min,max pairs
-      for ( unsigned int ii = 0; ii < ( ImageDimension * 2 ); ii += 2 )
+    // if enabled, update the histogram for this label
+    if ( m_UseHistograms )
+      {
+      for ( unsigned int bin = 0; bin < m_NumBins[0]; bin++ )
         {
-        if ( labelStats.m_BoundingBox[ii] > ( *threadIt ).second.m_BoundingBox[ii] )
-          {
-          labelStats.m_BoundingBox[ii] = ( *threadIt ).second.m_BoundingBox[ii];
-          }
-        if ( labelStats.m_BoundingBox[ii + 1] < ( *threadIt ).second.m_BoundingBox[ii + 1] )
-          {
-          labelStats.m_BoundingBox[ii + 1] = ( *threadIt ).second.m_BoundingBox[ii + 1];
-          }
+        labelStats.m_Histogram->IncreaseFrequency( bin, ( *threadIt ).second.m_Histogram->GetFrequency(bin) );
         }
+      }
+    }
+}
 
-      // if enabled, update the histogram for this label
-      if ( m_UseHistograms )
-        {
-        typename HistogramType::IndexType index;
-        index.SetSize(1);
-        for ( unsigned int bin = 0; bin < m_NumBins[0]; bin++ )
-          {
-          index[0] = bin;
-          labelStats.m_Histogram->IncreaseFrequency( bin, ( *threadIt ).second.m_Histogram->GetFrequency(bin) );
-          }
-        }
-      } // end of thread map iterator loop
-    }   // end of thread loop
+template< typename TInputImage, typename TLabelImage >
+ITK_THREAD_RETURN_TYPE
+LabelStatisticsImageFilter< TInputImage, TLabelImage >
+::MergeThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  MergeThreadStruct *              str = static_cast< MergeThreadStruct * >( info->UserData );
+  Self *                           filter = str->Filter;
+
+  // merge the map number i + step in the map number i
+  for ( ThreadIdType merge = info->ThreadID; merge < str->NumberOfMerges; merge += info->NumberOfThreads )
+    {
+    const ThreadIdType i = 2 * str->Step * merge;
+    filter->MergeLabelStatistics( filter->m_LabelStatisticsPerThread[i],
+                                  filter->m_LabelStatisticsPerThread[i + str->Step] );
+    filter->m_LabelStatisticsPerThread[i + str->Step].clear();
+    }
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< typename TInputImage, typename TLabelImage >
+void
+LabelStatisticsImageFilter< TInputImage, TLabelImage >
+::AfterStreamedGenerateData()
+{
+  MapIterator        mapIt;
+  const ThreadIdType numberOfThreads = static_cast< ThreadIdType >( m_LabelStatisticsPerThread.size() );
+
+  // Merge the maps of the threads two by two, in parallel, until all the
+  // statistics are in the map of the first thread
+  for ( ThreadIdType step = 1; step < numberOfThreads; step *= 2 )
+    {
+    MergeThreadStruct str;
+    str.Filter = this;
+    str.Step = step;
+    str.NumberOfMerges = ( numberOfThreads - step + 2 * step - 1 ) / ( 2 * step );
+    if ( str.NumberOfMerges == 1 )
+      {
+      this->MergeLabelStatistics(m_LabelStatisticsPerThread[0], m_LabelStatisticsPerThread[step]);
+      m_LabelStatisticsPerThread[step].clear();
+      }
+    else
+      {
+      this->GetMultiThreader()->SetNumberOfThreads(str.NumberOfMerges);
+      this->GetMultiThreader()->SetSingleMethod(this->MergeThreaderCallback, &str);
+      this->GetMultiThreader()->SingleMethodExecute();
+      }
+    }
+  m_LabelStatistics.swap(m_LabelStatisticsPerThread[0]);
+  m_LabelStatisticsPerThread[0].clear();
 
   // compute the remainder of the statistics
   for ( mapIt = m_LabelStatistics.begin();
@@ -220,100 +250,136 @@ LabelStatisticsImageFilter< TInputImage, TLabelImage >
 template< typename TInputImage, typename TLabelImage >
 void
 LabelStatisticsImageFilter< TInputImage, TLabelImage >
-::ThreadedGenerateData(const RegionType & outputRegionForThread,
-                       ThreadIdType threadId)
+::ThreadedStreamedGenerateData(const RegionType & regionForThread,
+                               ThreadIdType threadId)
 {
 
   typename HistogramType::IndexType histogramIndex(1);
   typename HistogramType::MeasurementVectorType histogramMeasurement(1);
 
-  const SizeValueType size0 = outputRegionForThread.GetSize(0);
+  const SizeValueType size0 = regionForThread.GetSize(0);
   if( size0 == 0)
     {
     return;
     }
 
   ImageLinearConstIteratorWithIndex< TInputImage > it (this->GetInput(),
-                                                       outputRegionForThread);
+                                                       regionForThread);
 
   ImageScanlineConstIterator< TLabelImage > labelIt (this->GetLabelInput(),
-                                                     outputRegionForThread);
+                                                     regionForThread);
 
-  MapIterator mapIt;
+  MapType & labelStatisticsMap = m_LabelStatisticsPerThread[threadId];
+
+  // the statistics of the labels, indexed by label, for the small label types
+  const bool                       useLabelTable = UseLabelTable();
+  std::vector< LabelStatistics * > labelTable;
+  if ( useLabelTable )
+    {
+    labelTable.resize( GetLabelTableSize(), ITK_NULLPTR );
+    }
+  const OffsetValueType labelTableOffset =
+    static_cast< OffsetValueType >( std::numeric_limits< LabelPixelType >::min() );
 
   // support progress methods/callbacks
-  const size_t numberOfLinesToProcess = outputRegionForThread.GetNumberOfPixels() / size0;
-  ProgressReporter progress( this, threadId, static_cast<SizeValueType>( numberOfLinesToProcess ) );
+  const size_t numberOfLinesToProcess = regionForThread.GetNumberOfPixels() / size0;
+  ProgressReporter progress( this, threadId, static_cast<SizeValueType>( numberOfLinesToProcess ), 100,
+                             this->GetPieceInitialProgress(), this->GetPieceProgressWeight() );
 
   // do the work
   while ( !it.IsAtEnd() )
     {
     while ( !it.IsAtEndOfLine() )
       {
-      const RealType & value = static_cast< RealType >( it.Get() );
-
-      const LabelPixelType & label = labelIt.Get();
+      const LabelPixelType label = labelIt.Get();
 
-      // is the label already in this thread?
-      mapIt = m_LabelStatisticsPerThread[threadId].find(label);
-      if ( mapIt == m_LabelStatisticsPerThread[threadId].end() )
+      // find the statistics of the label once for the whole run of pixels
+      // with that label
+      LabelStatistics * labelStatsPointer;
+      if ( useLabelTable )
         {
-        // create a new statistics object
-        typedef typename MapType::value_type MapValueType;
-        if ( m_UseHistograms )
+        LabelStatistics * & entry =
+          labelTable[static_cast< OffsetValueType >( label ) - labelTableOffset];
+        if ( entry == ITK_NULLPTR )
           {
-          mapIt = m_LabelStatisticsPerThread[threadId].insert( MapValueType( label,
-                                                                             LabelStatistics(m_NumBins[0], m_LowerBound,
-                                                                                             m_UpperBound) ) ).first;
+          MapIterator mapIt = labelStatisticsMap.find(label);
+          if ( mapIt == labelStatisticsMap.end() )
+            {
+            mapIt = this->InsertLabel(labelStatisticsMap, label);
+            }
+          entry = &( ( *mapIt ).second );
           }
-        else
+        labelStatsPointer = entry;
+        }
+      else
+        {
+        // is the label already in this thread?
+        MapIterator mapIt = labelStatisticsMap.find(label);
+        if ( mapIt == labelStatisticsMap.end() )
           {
-          mapIt = m_LabelStatisticsPerThread[threadId].insert( MapValueType( label,
-                                                                             LabelStatistics() ) ).first;
+          mapIt = this->InsertLabel(labelStatisticsMap, label);
           }
+        labelStatsPointer = &( ( *mapIt ).second );
         }
 
-      typename MapType::mapped_type &labelStats = ( *mapIt ).second;
+      typename MapType::mapped_type &labelStats = *labelStatsPointer;
 
-      // update the values for this label and this thread
-      if ( value < labelStats.m_Minimum )
-        {
-        labelStats.m_Minimum = value;
-        }
-      if ( value > labelStats.m_Maximum )
-        {
-        labelStats.m_Maximum = value;
-        }
+      const IndexType runIndex = it.GetIndex();
+      IndexValueType  runEnd = runIndex[0];
 
-      // bounding box is min,max pairs
-      for ( unsigned int i = 0; i < ( 2 * TInputImage::ImageDimension ); i += 2 )
+      do
         {
-        const IndexType & index = it.GetIndex();
-        if ( labelStats.m_BoundingBox[i] > index[i / 2] )
+        const RealType & value = static_cast< RealType >( it.Get() );
+
+        // update the values for this label and this thread
+        if ( value < labelStats.m_Minimum )
           {
-          labelStats.m_BoundingBox[i] = index[i / 2];
+          labelStats.m_Minimum = value;
           }
-        if ( labelStats.m_BoundingBox[i + 1] < index[i / 2] )
+        if ( value > labelStats.m_Maximum )
           {
-          labelStats.m_BoundingBox[i + 1] = index[i / 2];
+          labelStats.m_Maximum = value;
           }
-        }
 
-      labelStats.m_Sum += value;
-      labelStats.m_SumOfSquares += ( value * value );
-      labelStats.m_Count++;
+        labelStats.m_Sum += value;
+        labelStats.m_SumOfSquares += ( value * value );
+        labelStats.m_Count++;
 
-      // if enabled, update the histogram for this label
-      if ( m_UseHistograms )
-        {
-        histogramMeasurement[0] = value;
-        labelStats.m_Histogram->GetIndex(histogramMeasurement, histogramIndex);
-        labelStats.m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, 1);
-        }
+        // if enabled, update the histogram for this label
+        if ( m_UseHistograms )
+          {
+          histogramMeasurement[0] = value;
+          labelStats.m_Histogram->GetIndex(histogramMeasurement, histogramIndex);
+          labelStats.m_Histogram->IncreaseFrequencyOfIndex(histogramIndex, 1);
+          }
 
+        ++labelIt;
+        ++it;
+        ++runEnd;
+        }
+      while ( !labelIt.IsAtEndOfLine() && labelIt.Get() == label );
 
-      ++labelIt;
-      ++it;
+      // bounding box is min,max pairs - the run covers [runIndex[0], runEnd)
+      // along the first dimension
+      if ( labelStats.m_BoundingBox[0] > runIndex[0] )
+        {
+        labelStats.m_BoundingBox[0] = runIndex[0];
+        }
+      if ( labelStats.m_BoundingBox[1] < runEnd - 1 )
+        {
+        labelStats.m_BoundingBox[1] = runEnd - 1;
+        }
+      for ( unsigned int i = 2; i < ( 2 * TInputImage::ImageDimension ); i += 2 )
+        {
+        if ( labelStats.m_BoundingBox[i] > runIndex[i / 2] )
+          {
+          labelStats.m_BoundingBox[i] = runIndex[i / 2];
+          }
+        if ( labelStats.m_BoundingBox[i + 1] < runIndex[i / 2] )
+          {
+          labelStats.m_BoundingBox[i + 1] = runIndex[i / 2];
+          }
+        }
       }
     labelIt.NextLine();
     it.NextLine();
@@ -18,7 +18,7 @@
 #ifndef itkMinimumMaximumImageFilter_h
 #define itkMinimumMaximumImageFilter_h
 
-#include "itkImageToImageFilter.h"
+#include "itkStreamingReductionImageFilter.h"
 #include "itkSimpleDataObjectDecorator.h"
 
 #include <vector>
@@ -36,13 +36,16 @@ namespace itk
  * be included within the pipeline. The implementation uses the
  * StatisticsImageFilter.
  *
+ * With SetNumberOfStreamDivisions(), the filter reads its input piece by
+ * piece instead of all at once. The input is then not passed through.
+ *
  * \ingroup Operators
- * \sa StatisticsImageFilter
+ * \sa StatisticsImageFilter, StreamingReductionImageFilter
  * \ingroup ITKImageStatistics
  */
 template< typename TInputImage >
 class ITK_TEMPLATE_EXPORT MinimumMaximumImageFilter:
-  public ImageToImageFilter< TInputImage, TInputImage >
+  public StreamingReductionImageFilter< TInputImage >
 {
 public:
   /** Extract dimension from input image. */
@@ -52,10 +55,10 @@ public:
                       TInputImage::ImageDimension);
 
   /** Standard class typedefs. */
-  typedef MinimumMaximumImageFilter                      Self;
-  typedef ImageToImageFilter< TInputImage, TInputImage > Superclass;
-  typedef SmartPointer< Self >                           Pointer;
-  typedef SmartPointer< const Self >                     ConstPointer;
+  typedef MinimumMaximumImageFilter                     Self;
+  typedef StreamingReductionImageFilter< TInputImage > Superclass;
+  typedef SmartPointer< Self >                          Pointer;
+  typedef SmartPointer< const Self >                    ConstPointer;
 
   /** Image related typedefs. */
   typedef typename TInputImage::Pointer InputImagePointer;
@@ -72,7 +75,7 @@ public:
   itkNewMacro(Self);
 
   /** Run-time type information (and related methods). */
-  itkTypeMacro(MinimumMaximumImageFilter, ImageToImageFilter);
+  itkTypeMacro(MinimumMaximumImageFilter, StreamingReductionImageFilter);
 
   /** Image typedef support. */
   typedef TInputImage InputImageType;
@@ -121,22 +124,16 @@ protected:
   void AllocateOutputs() ITK_OVERRIDE;
 
   /** Initialize some accumulators before the threads run. */
-  void BeforeThreadedGenerateData() ITK_OVERRIDE;
+  void BeforeStreamedGenerateData() ITK_OVERRIDE;
 
   /** Do final mean and variance computation from data accumulated in threads.
     */
-  void AfterThreadedGenerateData() ITK_OVERRIDE;
-
-  /** Multi-thread version GenerateData. */
-  void  ThreadedGenerateData(const RegionType &
-                             outputRegionForThread,
-                             ThreadIdType threadId) ITK_OVERRIDE;
-
-  // Override since the filter needs all the data for the algorithm
-  void GenerateInputRequestedRegion() ITK_OVERRIDE;
+  void AfterStreamedGenerateData() ITK_OVERRIDE;
 
-  // Override since the filter produces all of its output
-  void EnlargeOutputRequestedRegion(DataObject *data) ITK_OVERRIDE;
+  /** Accumulate a region of the input in the accumulators of a thread. */
+  void  ThreadedStreamedGenerateData(const RegionType &
+                                     regionForThread,
+                                     ThreadIdType threadId) ITK_OVERRIDE;
 
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(MinimumMaximumImageFilter);
@@ -100,29 +100,6 @@ MinimumMaximumImageFilter< TInputImage >
   return static_cast< const PixelObjectType * >( this->ProcessObject::GetOutput(2) );
 }
 
-template< typename TInputImage >
-void
-MinimumMaximumImageFilter< TInputImage >
-::GenerateInputRequestedRegion()
-{
-  Superclass::GenerateInputRequestedRegion();
-  if ( this->GetInput() )
-    {
-    InputImagePointer image =
-      const_cast< typename Superclass::InputImageType * >( this->GetInput() );
-    image->SetRequestedRegionToLargestPossibleRegion();
-    }
-}
-
-template< typename TInputImage >
-void
-MinimumMaximumImageFilter< TInputImage >
-::EnlargeOutputRequestedRegion(DataObject *data)
-{
-  Superclass::EnlargeOutputRequestedRegion(data);
-  data->SetRequestedRegionToLargestPossibleRegion();
-}
-
 template< typename TInputImage >
 void
 MinimumMaximumImageFilter< TInputImage >
@@ -140,7 +117,7 @@ MinimumMaximumImageFilter< TInputImage >
 template< typename TInputImage >
 void
 MinimumMaximumImageFilter< TInputImage >
-::BeforeThreadedGenerateData()
+::BeforeStreamedGenerateData()
 {
   ThreadIdType numberOfThreads = this->GetNumberOfThreads();
 
@@ -154,7 +131,7 @@ MinimumMaximumImageFilter< TInputImage >
 template< typename TInputImage >
 void
 MinimumMaximumImageFilter< TInputImage >
-::AfterThreadedGenerateData()
+::AfterStreamedGenerateData()
 {
   ThreadIdType i;
   ThreadIdType numberOfThreads = this->GetNumberOfThreads();
@@ -184,25 +161,28 @@ MinimumMaximumImageFilter< TInputImage >
 template< typename TInputImage >
 void
 MinimumMaximumImageFilter< TInputImage >
-::ThreadedGenerateData(const RegionType & outputRegionForThread,
-                       ThreadIdType threadId)
+::ThreadedStreamedGenerateData(const RegionType & regionForThread,
+                               ThreadIdType threadId)
 {
-  if ( outputRegionForThread.GetNumberOfPixels() == 0 )
+  if ( regionForThread.GetNumberOfPixels() == 0 )
     return;
 
+  // continue the accumulation of the previous pieces of the input
   PixelType localMin = m_ThreadMin[threadId];
   PixelType localMax = m_ThreadMax[threadId];
 
-  ImageRegionConstIterator< TInputImage > it (this->GetInput(), outputRegionForThread);
+  ImageRegionConstIterator< TInputImage > it (this->GetInput(), regionForThread);
 
   // support progress methods/callbacks
-  ProgressReporter progress( this, threadId, outputRegionForThread.GetNumberOfPixels()/2 );
+  ProgressReporter progress( this, threadId, regionForThread.GetNumberOfPixels()/2, 100,
+                             this->GetPieceInitialProgress(), this->GetPieceProgressWeight() );
 
   // Handle the odd pixel separately
-  if ( outputRegionForThread.GetNumberOfPixels()%2 == 1 )
+  if ( regionForThread.GetNumberOfPixels()%2 == 1 )
     {
     const PixelType value = it.Get();
-    localMin = localMax = value;
+    localMin = std::min(value,localMin);
+    localMax = std::max(value,localMax);
     ++it;
     }
 
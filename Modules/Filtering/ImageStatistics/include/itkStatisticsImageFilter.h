@@ -18,7 +18,7 @@
 #ifndef itkStatisticsImageFilter_h
 #define itkStatisticsImageFilter_h
 
-#include "itkImageToImageFilter.h"
+#include "itkStreamingReductionImageFilter.h"
 #include "itkNumericTraits.h"
 #include "itkArray.h"
 #include "itkSimpleDataObjectDecorator.h"
@@ -36,7 +36,12 @@ namespace itk
  *
  * The filter passes its input through unmodified.  The filter is
  * threaded. It computes statistics in each thread then combines them in
- * its AfterThreadedGenerate method.
+ * its AfterStreamedGenerateData method.
+ *
+ * With SetNumberOfStreamDivisions(), the filter reads its input piece by
+ * piece instead of all at once. The input is then not passed through.
+ *
+ * \sa StreamingReductionImageFilter
  *
  * \ingroup MathematicalStatisticsImageFilters
  * \ingroup ITKImageStatistics
@@ -47,20 +52,20 @@ namespace itk
  */
 template< typename TInputImage >
 class ITK_TEMPLATE_EXPORT StatisticsImageFilter:
-  public ImageToImageFilter< TInputImage, TInputImage >
+  public StreamingReductionImageFilter< TInputImage >
 {
 public:
   /** Standard Self typedef */
-  typedef StatisticsImageFilter                          Self;
-  typedef ImageToImageFilter< TInputImage, TInputImage > Superclass;
-  typedef SmartPointer< Self >                           Pointer;
-  typedef SmartPointer< const Self >                     ConstPointer;
+  typedef StatisticsImageFilter                         Self;
+  typedef StreamingReductionImageFilter< TInputImage > Superclass;
+  typedef SmartPointer< Self >                          Pointer;
+  typedef SmartPointer< const Self >                    ConstPointer;
 
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
   /** Runtime information support. */
-  itkTypeMacro(StatisticsImageFilter, ImageToImageFilter);
+  itkTypeMacro(StatisticsImageFilter, StreamingReductionImageFilter);
 
   /** Image related typedefs. */
   typedef typename TInputImage::Pointer InputImagePointer;
@@ -150,22 +155,16 @@ protected:
   void AllocateOutputs() ITK_OVERRIDE;
 
   /** Initialize some accumulators before the threads run. */
-  void BeforeThreadedGenerateData() ITK_OVERRIDE;
+  void BeforeStreamedGenerateData() ITK_OVERRIDE;
 
   /** Do final mean and variance computation from data accumulated in threads.
    */
-  void AfterThreadedGenerateData() ITK_OVERRIDE;
-
-  /** Multi-thread version GenerateData. */
-  void  ThreadedGenerateData(const RegionType &
-                             outputRegionForThread,
-                             ThreadIdType threadId) ITK_OVERRIDE;
-
-  // Override since the filter needs all the data for the algorithm
-  void GenerateInputRequestedRegion() ITK_OVERRIDE;
+  void AfterStreamedGenerateData() ITK_OVERRIDE;
 
-  // Override since the filter produces all of its output
-  void EnlargeOutputRequestedRegion(DataObject *data) ITK_OVERRIDE;
+  /** Accumulate a region of the input in the accumulators of a thread. */
+  void  ThreadedStreamedGenerateData(const RegionType &
+                                     regionForThread,
+                                     ThreadIdType threadId) ITK_OVERRIDE;
 
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(StatisticsImageFilter);
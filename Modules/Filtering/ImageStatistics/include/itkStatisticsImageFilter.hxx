@@ -182,29 +182,6 @@ StatisticsImageFilter< TInputImage >
   return static_cast< const RealObjectType * >( this->ProcessObject::GetOutput(6) );
 }
 
-template< typename TInputImage >
-void
-StatisticsImageFilter< TInputImage >
-::GenerateInputRequestedRegion()
-{
-  Superclass::GenerateInputRequestedRegion();
-  if ( this->GetInput() )
-    {
-    InputImagePointer image =
-      const_cast< typename Superclass::InputImageType * >( this->GetInput() );
-    image->SetRequestedRegionToLargestPossibleRegion();
-    }
-}
-
-template< typename TInputImage >
-void
-StatisticsImageFilter< TInputImage >
-::EnlargeOutputRequestedRegion(DataObject *data)
-{
-  Superclass::EnlargeOutputRequestedRegion(data);
-  data->SetRequestedRegionToLargestPossibleRegion();
-}
-
 template< typename TInputImage >
 void
 StatisticsImageFilter< TInputImage >
@@ -222,7 +199,7 @@ StatisticsImageFilter< TInputImage >
 template< typename TInputImage >
 void
 StatisticsImageFilter< TInputImage >
-::BeforeThreadedGenerateData()
+::BeforeStreamedGenerateData()
 {
   ThreadIdType numberOfThreads = this->GetNumberOfThreads();
 
@@ -244,7 +221,7 @@ StatisticsImageFilter< TInputImage >
 template< typename TInputImage >
 void
 StatisticsImageFilter< TInputImage >
-::AfterThreadedGenerateData()
+::AfterStreamedGenerateData()
 {
   ThreadIdType    i;
   SizeValueType   count;
@@ -301,10 +278,10 @@ StatisticsImageFilter< TInputImage >
 template< typename TInputImage >
 void
 StatisticsImageFilter< TInputImage >
-::ThreadedGenerateData(const RegionType & outputRegionForThread,
-                       ThreadIdType threadId)
+::ThreadedStreamedGenerateData(const RegionType & regionForThread,
+                               ThreadIdType threadId)
 {
-  const SizeValueType size0 = outputRegionForThread.GetSize(0);
+  const SizeValueType size0 = regionForThread.GetSize(0);
   if( size0 == 0)
     {
     return;
@@ -312,17 +289,19 @@ StatisticsImageFilter< TInputImage >
   RealType  realValue;
   PixelType value;
 
-  RealType sum = NumericTraits< RealType >::ZeroValue();
-  RealType sumOfSquares = NumericTraits< RealType >::ZeroValue();
-  SizeValueType count = NumericTraits< SizeValueType >::ZeroValue();
-  PixelType min = NumericTraits< PixelType >::max();
-  PixelType max = NumericTraits< PixelType >::NonpositiveMin();
+  // continue the accumulation of the previous pieces of the input
+  RealType sum = m_ThreadSum[threadId];
+  RealType sumOfSquares = m_SumOfSquares[threadId];
+  SizeValueType count = m_Count[threadId];
+  PixelType min = m_ThreadMin[threadId];
+  PixelType max = m_ThreadMax[threadId];
 
-  ImageScanlineConstIterator< TInputImage > it (this->GetInput(),  outputRegionForThread);
+  ImageScanlineConstIterator< TInputImage > it (this->GetInput(),  regionForThread);
 
   // support progress methods/callbacks
-  const size_t numberOfLinesToProcess = outputRegionForThread.GetNumberOfPixels() / size0;
-  ProgressReporter progress( this, threadId, static_cast<itk::SizeValueType>( numberOfLinesToProcess ) );
+  const size_t numberOfLinesToProcess = regionForThread.GetNumberOfPixels() / size0;
+  ProgressReporter progress( this, threadId, static_cast<itk::SizeValueType>( numberOfLinesToProcess ), 100,
+                             this->GetPieceInitialProgress(), this->GetPieceProgressWeight() );
 
   // do the work
   while ( !it.IsAtEnd() )
@@ -0,0 +1,182 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageToHistogramFilter.h"
+#include "itkMaskedImageToHistogramFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+// Compare the frequencies of a histogram to the ones obtained by adding the
+// pixels one by one with Histogram::GetIndex()
+template< typename TImage, typename THistogram >
+int
+CheckHistogram( const TImage * image, const THistogram * histogram, const TImage * mask )
+{
+  std::vector< itk::SizeValueType > reference( histogram->Size(), 0 );
+
+  typename THistogram::MeasurementVectorType m( 1 );
+  typename THistogram::IndexType             index;
+  itk::ImageRegionConstIterator< TImage > it( image, image->GetLargestPossibleRegion() );
+  for ( ; !it.IsAtEnd(); ++it )
+    {
+    if ( mask && mask->GetPixel( it.GetIndex() ) == 0 )
+      {
+      continue;
+      }
+    m[0] = it.Get();
+    if ( histogram->GetIndex( m, index ) )
+      {
+      reference[ index[0] ]++;
+      }
+    }
+
+  for ( unsigned int bin = 0; bin < histogram->Size(); ++bin )
+    {
+    if ( histogram->GetFrequency( bin ) != reference[bin] )
+      {
+      std::cerr << "Bin " << bin << ": frequency " << histogram->GetFrequency( bin )
+                << " instead of " << reference[bin] << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+  return EXIT_SUCCESS;
+}
+
+// Compute the histogram of an image with random values, with bins computed
+// automatically and with a given range which clips some of the values
+template< typename TPixel >
+int
+ImageToHistogramFilterTest5( unsigned int edge, double minimum, double maximum )
+{
+  const unsigned int Dimension = 3;
+
+  typedef itk::Image< TPixel, Dimension >                          ImageType;
+  typedef itk::Statistics::ImageToHistogramFilter< ImageType >     FilterType;
+  typedef itk::Statistics::MaskedImageToHistogramFilter< ImageType, ImageType >
+                                                                   MaskedFilterType;
+  typedef typename FilterType::HistogramType                       HistogramType;
+
+  typename ImageType::SizeType size;
+  size.Fill( edge );
+  typename ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  typename ImageType::Pointer mask = ImageType::New();
+  mask->SetRegions( size );
+  mask->Allocate();
+
+  unsigned int seed = 4321;
+  itk::ImageRegionIterator< ImageType > it( image, image->GetLargestPossibleRegion() );
+  itk::ImageRegionIterator< ImageType > mit( mask, mask->GetLargestPossibleRegion() );
+  for ( ; !it.IsAtEnd(); ++it, ++mit )
+    {
+    seed = seed * 1103515245u + 12345u;
+    it.Set( static_cast< TPixel >( minimum + ( maximum - minimum ) * ( ( seed >> 8 ) % 100003 ) / 100002.0 ) );
+    mit.Set( static_cast< TPixel >( ( seed >> 20 ) % 2 ) );
+    }
+
+  typename FilterType::HistogramSizeType histogramSize( 1 );
+  histogramSize[0] = 37;
+
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  filter->SetHistogramSize( histogramSize );
+  filter->SetAutoMinimumMaximum( true );
+  filter->SetNumberOfThreads( 3 );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  const HistogramType * histogram = filter->GetOutput();
+  TEST_EXPECT_EQUAL( histogram->GetTotalFrequency(), image->GetLargestPossibleRegion().GetNumberOfPixels() );
+  if ( CheckHistogram< ImageType, HistogramType >( image, histogram, ITK_NULLPTR ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  // the values outside of the range of the bins are clipped
+  typename FilterType::HistogramMeasurementVectorType binMinimum( 1 );
+  binMinimum[0] = minimum + 0.3 * ( maximum - minimum );
+  typename FilterType::HistogramMeasurementVectorType binMaximum( 1 );
+  binMaximum[0] = maximum - 0.2 * ( maximum - minimum );
+  filter->SetAutoMinimumMaximum( false );
+  filter->SetHistogramBinMinimum( binMinimum );
+  filter->SetHistogramBinMaximum( binMaximum );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+  TEST_EXPECT_TRUE( histogram->GetTotalFrequency() < image->GetLargestPossibleRegion().GetNumberOfPixels() );
+  if ( CheckHistogram< ImageType, HistogramType >( image, histogram, ITK_NULLPTR ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  typename MaskedFilterType::Pointer maskedFilter = MaskedFilterType::New();
+  maskedFilter->SetInput( image );
+  maskedFilter->SetMaskImage( mask );
+  maskedFilter->SetMaskValue( itk::NumericTraits< TPixel >::ZeroValue() );
+  maskedFilter->SetHistogramSize( histogramSize );
+  maskedFilter->SetAutoMinimumMaximum( false );
+  maskedFilter->SetHistogramBinMinimum( binMinimum );
+  maskedFilter->SetHistogramBinMaximum( binMaximum );
+  maskedFilter->SetNumberOfThreads( 3 );
+  TRY_EXPECT_NO_EXCEPTION( maskedFilter->Update() );
+  // the reference counts the pixels where the mask is not 0, so use the
+  // complement of the mask
+  for ( mit.GoToBegin(); !mit.IsAtEnd(); ++mit )
+    {
+    mit.Set( mit.Get() == 0 ? 1 : 0 );
+    }
+  if ( CheckHistogram< ImageType, HistogramType >( image, maskedFilter->GetOutput(), mask ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  return EXIT_SUCCESS;
+}
+
+}
+
+// Check that the bins of the pixels of scalar images, found by their values
+// or in a table of the values, are the same as with Histogram::GetIndex().
+int itkImageToHistogramFilterTest5(int, char* [] )
+{
+  // binned with a table of the values
+  if ( ImageToHistogramFilterTest5< unsigned char >( 20, 0, 255 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  if ( ImageToHistogramFilterTest5< short >( 42, -3000, 3000 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  // binned with the values
+  if ( ImageToHistogramFilterTest5< short >( 20, -3000, 3000 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  if ( ImageToHistogramFilterTest5< int >( 20, -100000, 300000 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  if ( ImageToHistogramFilterTest5< float >( 20, -1.5, 2.5 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
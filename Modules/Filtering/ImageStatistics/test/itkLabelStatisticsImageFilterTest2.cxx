@@ -0,0 +1,164 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkLabelStatisticsImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+#include <map>
+
+namespace
+{
+
+// The statistics of a label computed pixel by pixel
+template< typename TRealType, typename TIndex >
+struct LabelReference
+{
+  itk::SizeValueType m_Count;
+  TRealType          m_Sum;
+  TRealType          m_Minimum;
+  TRealType          m_Maximum;
+  TIndex             m_Min;
+  TIndex             m_Max;
+};
+
+// Compare the statistics computed with several threads to the ones computed
+// pixel by pixel, for a label type which uses a table indexed by the labels
+// or the hash map.
+template< typename TLabelPixel >
+int
+LabelStatisticsImageFilterTest2(TLabelPixel firstLabel)
+{
+  const unsigned int Dimension = 3;
+
+  typedef short                                PixelType;
+  typedef itk::Image< PixelType, Dimension >   ImageType;
+  typedef itk::Image< TLabelPixel, Dimension > LabelImageType;
+
+  typedef itk::LabelStatisticsImageFilter< ImageType, LabelImageType > FilterType;
+  typedef typename FilterType::RealType                                RealType;
+
+  typename ImageType::SizeType size;
+  size[0] = 45;
+  size[1] = 21;
+  size[2] = 13;
+  typename ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  typename LabelImageType::Pointer labelImage = LabelImageType::New();
+  labelImage->SetRegions( size );
+  labelImage->Allocate();
+
+  // runs of labels of random lengths
+  typedef LabelReference< RealType, typename ImageType::IndexType > Reference;
+  std::map< TLabelPixel, Reference > references;
+
+  unsigned int seed = 1234;
+  TLabelPixel  label = firstLabel;
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetLargestPossibleRegion() );
+  itk::ImageRegionIterator< LabelImageType >     lit( labelImage, labelImage->GetLargestPossibleRegion() );
+  for ( ; !it.IsAtEnd(); ++it, ++lit )
+    {
+    seed = seed * 1103515245u + 12345u;
+    if ( ( seed >> 16 ) % 7 == 0 )
+      {
+      label = static_cast< TLabelPixel >( firstLabel + static_cast< TLabelPixel >( ( seed >> 8 ) % 40 ) );
+      }
+    seed = seed * 1103515245u + 12345u;
+    const PixelType value = static_cast< PixelType >( ( seed >> 16 ) % 1000 ) - 500;
+    it.Set( value );
+    lit.Set( label );
+
+    const typename ImageType::IndexType & idx = it.GetIndex();
+    if ( references.find( label ) == references.end() )
+      {
+      Reference reference;
+      reference.m_Count = 0;
+      reference.m_Sum = 0;
+      reference.m_Minimum = value;
+      reference.m_Maximum = value;
+      reference.m_Min = idx;
+      reference.m_Max = idx;
+      references[label] = reference;
+      }
+    Reference & reference = references[label];
+    reference.m_Count++;
+    reference.m_Sum += value;
+    reference.m_Minimum = std::min( reference.m_Minimum, static_cast< RealType >( value ) );
+    reference.m_Maximum = std::max( reference.m_Maximum, static_cast< RealType >( value ) );
+    for ( unsigned int d = 0; d < Dimension; ++d )
+      {
+      reference.m_Min[d] = std::min( reference.m_Min[d], idx[d] );
+      reference.m_Max[d] = std::max( reference.m_Max[d], idx[d] );
+      }
+    }
+
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  filter->SetLabelInput( labelImage );
+  filter->SetHistogramParameters( 10, -500, 500 );
+  filter->SetNumberOfThreads( 7 );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+
+  TEST_EXPECT_EQUAL( filter->GetNumberOfLabels(), references.size() );
+  for ( typename std::map< TLabelPixel, Reference >::const_iterator rit = references.begin();
+        rit != references.end(); ++rit )
+    {
+    const TLabelPixel l = rit->first;
+    const Reference & reference = rit->second;
+    TEST_EXPECT_TRUE( filter->HasLabel( l ) );
+    TEST_EXPECT_EQUAL( filter->GetCount( l ), reference.m_Count );
+    TEST_EXPECT_TRUE( itk::Math::FloatAlmostEqual( filter->GetSum( l ), reference.m_Sum ) );
+    TEST_EXPECT_EQUAL( filter->GetMinimum( l ), reference.m_Minimum );
+    TEST_EXPECT_EQUAL( filter->GetMaximum( l ), reference.m_Maximum );
+
+    const typename FilterType::BoundingBoxType box = filter->GetBoundingBox( l );
+    for ( unsigned int d = 0; d < Dimension; ++d )
+      {
+      TEST_EXPECT_EQUAL( box[2 * d], reference.m_Min[d] );
+      TEST_EXPECT_EQUAL( box[2 * d + 1], reference.m_Max[d] );
+      }
+    TEST_EXPECT_EQUAL( filter->GetHistogram( l )->GetTotalFrequency(), reference.m_Count );
+    }
+  TEST_EXPECT_TRUE( !filter->HasLabel( static_cast< TLabelPixel >( firstLabel + 40 ) ) );
+
+  return EXIT_SUCCESS;
+}
+
+}
+
+int itkLabelStatisticsImageFilterTest2(int, char* [] )
+{
+  // uses a table indexed by the labels
+  if ( LabelStatisticsImageFilterTest2< unsigned short >( 65000 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  if ( LabelStatisticsImageFilterTest2< signed char >( -20 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+  // uses the hash map
+  if ( LabelStatisticsImageFilterTest2< int >( -20 ) != EXIT_SUCCESS )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
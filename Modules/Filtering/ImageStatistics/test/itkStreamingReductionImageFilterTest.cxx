@@ -0,0 +1,234 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkStatisticsImageFilter.h"
+#include "itkMinimumMaximumImageFilter.h"
+#include "itkLabelStatisticsImageFilter.h"
+#include "itkImageToHistogramFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionSplitterSlowDimension.h"
+#include "itkAtomicInt.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// A splitter which counts the regions it splits.
+class CountingSplitter:public itk::ImageRegionSplitterSlowDimension
+{
+public:
+  typedef CountingSplitter                       Self;
+  typedef itk::ImageRegionSplitterSlowDimension  Superclass;
+  typedef itk::SmartPointer< Self >              Pointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(CountingSplitter, ImageRegionSplitterSlowDimension);
+
+  mutable itk::AtomicInt< int > m_NumberOfSplits;
+
+protected:
+  CountingSplitter() { m_NumberOfSplits = 0; }
+
+  virtual unsigned int GetSplitInternal( unsigned int dim, unsigned int i, unsigned int numberOfPieces,
+                                         itk::IndexValueType regionIndex[],
+                                         itk::SizeValueType regionSize[] ) const ITK_OVERRIDE
+  {
+    ++m_NumberOfSplits;
+    return Superclass::GetSplitInternal( dim, i, numberOfPieces, regionIndex, regionSize );
+  }
+};
+
+// A StatisticsImageFilter which splits the pieces among its threads with
+// its own splitter.
+template< typename TImage >
+class SplitterStatisticsImageFilter:public itk::StatisticsImageFilter< TImage >
+{
+public:
+  typedef SplitterStatisticsImageFilter        Self;
+  typedef itk::StatisticsImageFilter< TImage > Superclass;
+  typedef itk::SmartPointer< Self >            Pointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(SplitterStatisticsImageFilter, StatisticsImageFilter);
+
+  CountingSplitter::Pointer m_Splitter;
+
+protected:
+  SplitterStatisticsImageFilter() : m_Splitter( CountingSplitter::New() ) {}
+
+  virtual const itk::ImageRegionSplitterBase * GetImageRegionSplitter() const ITK_OVERRIDE
+  {
+    return m_Splitter;
+  }
+};
+}
+
+// Compute the reductions with their inputs streamed in pieces through an
+// upstream filter, and compare them to the ones computed at once.
+int itkStreamingReductionImageFilterTest(int, char* [] )
+{
+  const unsigned int Dimension = 3;
+
+  typedef short                                   PixelType;
+  typedef unsigned char                           LabelPixelType;
+  typedef itk::Image< PixelType, Dimension >      ImageType;
+  typedef itk::Image< LabelPixelType, Dimension > LabelImageType;
+
+  typedef itk::CastImageFilter< ImageType, ImageType >                 SourceType;
+  typedef itk::CastImageFilter< LabelImageType, LabelImageType >       LabelSourceType;
+  typedef itk::StatisticsImageFilter< ImageType >                      StatisticsType;
+  typedef itk::MinimumMaximumImageFilter< ImageType >                  MinimumMaximumType;
+  typedef itk::LabelStatisticsImageFilter< ImageType, LabelImageType > LabelStatisticsType;
+  typedef itk::Statistics::ImageToHistogramFilter< ImageType >         HistogramFilterType;
+
+  ImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 23;
+  size[2] = 20;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  LabelImageType::Pointer labelImage = LabelImageType::New();
+  labelImage->SetRegions( size );
+  labelImage->Allocate();
+
+  unsigned int seed = 1789;
+  itk::ImageRegionIterator< ImageType >      it( image, image->GetLargestPossibleRegion() );
+  itk::ImageRegionIterator< LabelImageType > lit( labelImage, labelImage->GetLargestPossibleRegion() );
+  for ( ; !it.IsAtEnd(); ++it, ++lit )
+    {
+    seed = seed * 1103515245u + 12345u;
+    it.Set( static_cast< PixelType >( ( seed >> 16 ) % 2000 ) - 1000 );
+    seed = seed * 1103515245u + 12345u;
+    lit.Set( static_cast< LabelPixelType >( ( seed >> 16 ) % 5 ) );
+    }
+
+  const unsigned int       numberOfStreamDivisions = 5;
+  const itk::SizeValueType numberOfPixelsPerPiece =
+    image->GetLargestPossibleRegion().GetNumberOfPixels() / numberOfStreamDivisions;
+
+  // the upstream filters which produce the pieces
+  SourceType::Pointer source = SourceType::New();
+  source->SetInput( image );
+  source->InPlaceOff();
+  LabelSourceType::Pointer labelSource = LabelSourceType::New();
+  labelSource->SetInput( labelImage );
+  labelSource->InPlaceOff();
+
+  // StatisticsImageFilter
+  StatisticsType::Pointer statistics = StatisticsType::New();
+  statistics->SetInput( image );
+  TRY_EXPECT_NO_EXCEPTION( statistics->Update() );
+
+  StatisticsType::Pointer streamedStatistics = StatisticsType::New();
+  TEST_SET_GET_VALUE( 1, streamedStatistics->GetNumberOfStreamDivisions() );
+  streamedStatistics->SetInput( source->GetOutput() );
+  streamedStatistics->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  TEST_SET_GET_VALUE( numberOfStreamDivisions, streamedStatistics->GetNumberOfStreamDivisions() );
+  TRY_EXPECT_NO_EXCEPTION( streamedStatistics->Update() );
+  streamedStatistics->Print( std::cout );
+
+  TEST_EXPECT_EQUAL( source->GetOutput()->GetBufferedRegion().GetNumberOfPixels(), numberOfPixelsPerPiece );
+  TEST_EXPECT_EQUAL( statistics->GetMinimum(), streamedStatistics->GetMinimum() );
+  TEST_EXPECT_EQUAL( statistics->GetMaximum(), streamedStatistics->GetMaximum() );
+  TEST_EXPECT_EQUAL( statistics->GetSum(), streamedStatistics->GetSum() );
+  TEST_EXPECT_TRUE( itk::Math::FloatAlmostEqual( statistics->GetMean(), streamedStatistics->GetMean() ) );
+  TEST_EXPECT_TRUE( itk::Math::FloatAlmostEqual( statistics->GetVariance(), streamedStatistics->GetVariance(), 4, 1e-9 ) );
+
+  // the pieces are split among the threads by the splitter of the filter
+  typedef SplitterStatisticsImageFilter< ImageType > SplitterStatisticsType;
+  SplitterStatisticsType::Pointer splitterStatistics = SplitterStatisticsType::New();
+  splitterStatistics->SetInput( source->GetOutput() );
+  splitterStatistics->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  TRY_EXPECT_NO_EXCEPTION( splitterStatistics->Update() );
+  TEST_EXPECT_TRUE( splitterStatistics->m_Splitter->m_NumberOfSplits >= static_cast< int >( numberOfStreamDivisions ) );
+  TEST_EXPECT_EQUAL( statistics->GetSum(), splitterStatistics->GetSum() );
+
+  // MinimumMaximumImageFilter
+  MinimumMaximumType::Pointer minimumMaximum = MinimumMaximumType::New();
+  minimumMaximum->SetInput( source->GetOutput() );
+  minimumMaximum->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  TRY_EXPECT_NO_EXCEPTION( minimumMaximum->Update() );
+
+  TEST_EXPECT_EQUAL( source->GetOutput()->GetBufferedRegion().GetNumberOfPixels(), numberOfPixelsPerPiece );
+  TEST_EXPECT_EQUAL( statistics->GetMinimum(), minimumMaximum->GetMinimum() );
+  TEST_EXPECT_EQUAL( statistics->GetMaximum(), minimumMaximum->GetMaximum() );
+
+  // LabelStatisticsImageFilter, with the same pieces of both inputs
+  LabelStatisticsType::Pointer labelStatistics = LabelStatisticsType::New();
+  labelStatistics->SetInput( image );
+  labelStatistics->SetLabelInput( labelImage );
+  labelStatistics->SetHistogramParameters( 20, -1000, 1000 );
+  TRY_EXPECT_NO_EXCEPTION( labelStatistics->Update() );
+
+  LabelStatisticsType::Pointer streamedLabelStatistics = LabelStatisticsType::New();
+  streamedLabelStatistics->SetInput( source->GetOutput() );
+  streamedLabelStatistics->SetLabelInput( labelSource->GetOutput() );
+  streamedLabelStatistics->SetHistogramParameters( 20, -1000, 1000 );
+  streamedLabelStatistics->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  TRY_EXPECT_NO_EXCEPTION( streamedLabelStatistics->Update() );
+
+  TEST_EXPECT_EQUAL( source->GetOutput()->GetBufferedRegion().GetNumberOfPixels(), numberOfPixelsPerPiece );
+  TEST_EXPECT_EQUAL( labelSource->GetOutput()->GetBufferedRegion().GetNumberOfPixels(), numberOfPixelsPerPiece );
+  TEST_EXPECT_EQUAL( labelStatistics->GetNumberOfLabels(), streamedLabelStatistics->GetNumberOfLabels() );
+  for ( LabelPixelType label = 0; label < 5; ++label )
+    {
+    TEST_EXPECT_EQUAL( labelStatistics->GetCount( label ), streamedLabelStatistics->GetCount( label ) );
+    TEST_EXPECT_EQUAL( labelStatistics->GetSum( label ), streamedLabelStatistics->GetSum( label ) );
+    TEST_EXPECT_EQUAL( labelStatistics->GetMinimum( label ), streamedLabelStatistics->GetMinimum( label ) );
+    TEST_EXPECT_EQUAL( labelStatistics->GetMaximum( label ), streamedLabelStatistics->GetMaximum( label ) );
+    TEST_EXPECT_TRUE( labelStatistics->GetBoundingBox( label ) == streamedLabelStatistics->GetBoundingBox( label ) );
+    for ( unsigned int bin = 0; bin < 20; ++bin )
+      {
+      TEST_EXPECT_EQUAL( labelStatistics->GetHistogram( label )->GetFrequency( bin ),
+                         streamedLabelStatistics->GetHistogram( label )->GetFrequency( bin ) );
+      }
+    }
+
+  // ImageToHistogramFilter, with the range of the histogram computed in a
+  // first pass over the pieces
+  HistogramFilterType::HistogramSizeType histogramSize( 1 );
+  histogramSize[0] = 50;
+
+  HistogramFilterType::Pointer histogramFilter = HistogramFilterType::New();
+  histogramFilter->SetInput( image );
+  histogramFilter->SetHistogramSize( histogramSize );
+  histogramFilter->SetAutoMinimumMaximum( true );
+  TRY_EXPECT_NO_EXCEPTION( histogramFilter->Update() );
+
+  HistogramFilterType::Pointer streamedHistogramFilter = HistogramFilterType::New();
+  streamedHistogramFilter->SetInput( source->GetOutput() );
+  streamedHistogramFilter->SetHistogramSize( histogramSize );
+  streamedHistogramFilter->SetAutoMinimumMaximum( true );
+  streamedHistogramFilter->SetNumberOfStreamDivisions( numberOfStreamDivisions );
+  TRY_EXPECT_NO_EXCEPTION( streamedHistogramFilter->Update() );
+
+  TEST_EXPECT_EQUAL( source->GetOutput()->GetBufferedRegion().GetNumberOfPixels(), numberOfPixelsPerPiece );
+  const HistogramFilterType::HistogramType * histogram = histogramFilter->GetOutput();
+  const HistogramFilterType::HistogramType * streamedHistogram = streamedHistogramFilter->GetOutput();
+  TEST_EXPECT_EQUAL( histogram->Size(), streamedHistogram->Size() );
+  TEST_EXPECT_EQUAL( histogram->GetTotalFrequency(), size[0] * size[1] * size[2] );
+  for ( unsigned int bin = 0; bin < histogram->Size(); ++bin )
+    {
+    TEST_EXPECT_EQUAL( histogram->GetFrequency( bin ), streamedHistogram->GetFrequency( bin ) );
+    TEST_EXPECT_EQUAL( histogram->GetBinMin( 0, bin ), streamedHistogram->GetBinMin( 0, bin ) );
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
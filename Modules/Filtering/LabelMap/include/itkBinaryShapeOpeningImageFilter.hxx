@@ -88,7 +88,9 @@ BinaryShapeOpeningImageFilter< TInputImage >
     {
     valuator->SetComputePerimeter(false);
     }
-  if ( m_Attribute == LabelObjectType::FERET_DIAMETER )
+  if ( m_Attribute == LabelObjectType::FERET_DIAMETER
+       || m_Attribute == LabelObjectType::MINIMUM_FERET_DIAMETER
+       || m_Attribute == LabelObjectType::CONVEX_HULL_PHYSICAL_SIZE )
     {
     valuator->SetComputeFeretDiameter(true);
     }
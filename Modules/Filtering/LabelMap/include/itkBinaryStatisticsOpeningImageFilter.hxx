@@ -91,7 +91,9 @@ BinaryStatisticsOpeningImageFilter< TInputImage, TFeatureImage >
     {
     valuator->SetComputePerimeter(false);
     }
-  if ( m_Attribute == LabelObjectType::FERET_DIAMETER )
+  if ( m_Attribute == LabelObjectType::FERET_DIAMETER
+       || m_Attribute == LabelObjectType::MINIMUM_FERET_DIAMETER
+       || m_Attribute == LabelObjectType::CONVEX_HULL_PHYSICAL_SIZE )
     {
     valuator->SetComputeFeretDiameter(true);
     }
@@ -20,6 +20,7 @@
 
 #include "itkObject.h"
 #include "ITKLabelMapExport.h"
+#include <vector>
 
 namespace itk
 {
@@ -51,6 +52,29 @@ public:
 
   static double HyperSphereRadiusFromVolume(const int dim, const double volume);
 
+  /** Compute the maximum and the minimum Feret diameters and the size of
+   * the convex hull of a set of points with integer coordinates, like the
+   * indices of the pixels of an object. The coordinates are stored point
+   * after point in "points", and are scaled by "spacing" to get the
+   * physical positions. The points may be repeated.
+   *
+   * The convex hull is built with a monotone chain in 2D and with a
+   * quickhull in 3D, with exact integer predicates, so only its vertices
+   * are used to compute the diameters. The minimum Feret diameter (the
+   * width of the set) is computed with the rotating calipers in 2D. In 3D,
+   * it is the smallest width in the directions normal to the faces of the
+   * hull and to the pairs of antipodal edges, which costs a time quadratic
+   * in the number of edges. The size of the hull is its length in 1D, its area in 2D
+   * and its volume in 3D; it is null for degenerated (flat) sets. In higher
+   * dimensions, only the maximum Feret diameter is computed, by comparing
+   * all the pairs of points, and the other values are set to 0. */
+  static void ConvexHullFeretDiameters(const unsigned int dim,
+                                       const std::vector< OffsetValueType > & points,
+                                       const double *spacing,
+                                       double & maximumFeretDiameter,
+                                       double & minimumFeretDiameter,
+                                       double & convexHullSize);
+
 };
 
 }
@@ -30,6 +30,11 @@ namespace itk
  * LabelImageToLabelMapFilter converts a label image to a label collection image.
  * The labels are the same in the input and the output image.
  *
+ * Each thread encodes its part of the input in a flat array of runs, which
+ * is then sorted by label. The label objects are created once all the runs
+ * are known, so that the lines of each object are allocated in a single
+ * block and the label map is filled in label order.
+ *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
  * This implementation was taken from the Insight Journal paper:
@@ -72,6 +77,7 @@ public:
   typedef typename OutputImageType::PixelType       OutputImagePixelType;
   typedef typename OutputImageType::LabelObjectType LabelObjectType;
   typedef typename LabelObjectType::LengthType      LengthType;
+  typedef typename LabelObjectType::LineType        LineType;
 
   /** ImageDimension constants */
   itkStaticConstMacro(InputImageDimension, unsigned int,
@@ -122,7 +128,22 @@ private:
 
   OutputImagePixelType m_BackgroundValue;
 
-  typename std::vector< OutputImagePointer > m_TemporaryImages;
+  /** A run of pixels of the input, with its label. */
+  struct RunType
+  {
+    LineType             m_Line;
+    OutputImagePixelType m_Label;
+  };
+  typedef std::vector< RunType > RunContainerType;
+
+  /** Order the runs by label, and keep the order of the lines. */
+  static bool RunLabelLess(const RunType & run1, const RunType & run2)
+  {
+    return run1.m_Label < run2.m_Label;
+  }
+
+  /** The runs found by each thread, sorted by label. */
+  std::vector< RunContainerType > m_TemporaryRuns;
 }; // end of class
 } // end namespace itk
 
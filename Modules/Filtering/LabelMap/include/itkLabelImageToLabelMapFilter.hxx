@@ -22,6 +22,7 @@
 #include "itkNumericTraits.h"
 #include "itkProgressReporter.h"
 #include "itkImageLinearConstIteratorWithIndex.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -62,25 +63,12 @@ void
 LabelImageToLabelMapFilter< TInputImage, TOutputImage >
 ::BeforeThreadedGenerateData()
 {
-  // init the temp images - one per thread
-  m_TemporaryImages.resize( this->GetNumberOfThreads() );
+  // init the run containers - one per thread
+  m_TemporaryRuns.clear();
+  m_TemporaryRuns.resize( this->GetNumberOfThreads() );
 
-  for ( ThreadIdType i = 0; i < this->GetNumberOfThreads(); i++ )
-    {
-    if ( i == 0 )
-      {
-      // the first one is the output image
-      m_TemporaryImages[0] = this->GetOutput();
-      }
-    else
-      {
-      // the other must be created
-      m_TemporaryImages[i] = OutputImageType::New();
-      }
-
-    // set the minimum data needed to create the objects properly
-    m_TemporaryImages[i]->SetBackgroundValue(m_BackgroundValue);
-    }
+  // set the minimum data needed to create the objects properly
+  this->GetOutput()->SetBackgroundValue(m_BackgroundValue);
 }
 
 template< typename TInputImage, typename TOutputImage >
@@ -90,6 +78,8 @@ LabelImageToLabelMapFilter< TInputImage, TOutputImage >
 {
   ProgressReporter progress( this, threadId, regionForThread.GetNumberOfPixels() );
 
+  RunContainerType & runs = m_TemporaryRuns[threadId];
+
   typedef ImageLinearConstIteratorWithIndex< InputImageType > InputLineIteratorType;
   InputLineIteratorType it(this->GetInput(), regionForThread);
   it.SetDirection(0);
@@ -115,7 +105,10 @@ LabelImageToLabelMapFilter< TInputImage, TOutputImage >
           ++it;
           }
         // create the run length object to go in the vector
-        m_TemporaryImages[threadId]->SetLine(idx, length, value);
+        RunType run;
+        run.m_Line = LineType(idx, length);
+        run.m_Label = static_cast< OutputImagePixelType >( value );
+        runs.push_back(run);
         }
       else
         {
@@ -124,6 +117,9 @@ LabelImageToLabelMapFilter< TInputImage, TOutputImage >
         }
       }
     }
+
+  // group the runs of the same label, in the order of the lines
+  std::stable_sort(runs.begin(), runs.end(), RunLabelLess);
 }
 
 template< typename TInputImage, typename TOutputImage >
@@ -133,36 +129,61 @@ LabelImageToLabelMapFilter< TInputImage, TOutputImage >
 {
   OutputImageType *output = this->GetOutput();
 
-  // merge the lines from the temporary images in the output image
-  // don't use the first image - that's the output image
-  for ( ThreadIdType i = 1; i < this->GetNumberOfThreads(); i++ )
+  // merge the sorted runs of the threads, label after label. The threads
+  // have processed the regions in order, so the lines of an object are
+  // kept in the order of the image.
+  const ThreadIdType numberOfThreads = static_cast< ThreadIdType >( m_TemporaryRuns.size() );
+  std::vector< SizeValueType > positions(numberOfThreads, 0);
+  std::vector< SizeValueType > ends(numberOfThreads, 0);
+
+  for ( ;; )
     {
-    for ( typename OutputImageType::Iterator it( m_TemporaryImages[i] );
-          ! it.IsAtEnd();
-          ++it )
+    // find the next label
+    bool                 found = false;
+    OutputImagePixelType label = m_BackgroundValue;
+    for ( ThreadIdType i = 0; i < numberOfThreads; i++ )
       {
-      LabelObjectType *labelObject = it.GetLabelObject();
-      if ( output->HasLabel( labelObject->GetLabel() ) )
+      if ( positions[i] < m_TemporaryRuns[i].size()
+           && ( !found || m_TemporaryRuns[i][positions[i]].m_Label < label ) )
         {
-        // merge the lines in the output's object
-        LabelObjectType * lo = output->GetLabelObject( labelObject->GetLabel() );
-        typename LabelObjectType::ConstLineIterator lit( labelObject );
-        while( ! lit.IsAtEnd() )
-          {
-          lo->AddLine( lit.GetLine() );
-          ++lit;
-          }
+        label = m_TemporaryRuns[i][positions[i]].m_Label;
+        found = true;
         }
-      else
+      }
+    if ( !found )
+      {
+      break;
+      }
+
+    // count its lines in all the threads
+    SizeValueType numberOfLines = 0;
+    for ( ThreadIdType i = 0; i < numberOfThreads; i++ )
+      {
+      const RunContainerType & runs = m_TemporaryRuns[i];
+      ends[i] = positions[i];
+      while ( ends[i] < runs.size() && !( label < runs[ends[i]].m_Label ) )
+        {
+        ++ends[i];
+        }
+      numberOfLines += ends[i] - positions[i];
+      }
+
+    // and create the object with all its lines at once
+    typename LabelObjectType::Pointer labelObject = LabelObjectType::New();
+    labelObject->SetLabel(label);
+    labelObject->ReserveLines(numberOfLines);
+    for ( ThreadIdType i = 0; i < numberOfThreads; i++ )
+      {
+      for ( ; positions[i] < ends[i]; positions[i]++ )
         {
-        // simply take the object
-        output->AddLabelObject(labelObject);
+        labelObject->AddLine( m_TemporaryRuns[i][positions[i]].m_Line );
         }
       }
+    output->AddLabelObject(labelObject);
     }
 
-  // release the data in the temp images
-  m_TemporaryImages.clear();
+  // release the runs
+  m_TemporaryRuns.clear();
 }
 
 template< typename TInputImage, typename TOutputImage >
@@ -43,6 +43,12 @@ namespace itk
  * L is the number of lines in the image (imageSize[1] * imageSize[2] for a 3D
  * image).
  *
+ * The label objects are kept in a std::map, and each of them stores its lines
+ * in a contiguous array.  There is no flat representation with a single run
+ * array shared by all the labels: the LabelMap filters hold LabelObject
+ * pointers and modify the objects in place, so such a representation would
+ * need its own versions of these filters.
+ *
  * To iterate over the LabelObjects in the map, use:
  * \code
  * for(unsigned int i = 0; i < filter->GetOutput()->GetNumberOfLabelObjects(); ++i)
@@ -42,6 +42,11 @@ namespace itk
  * With that class, the developer doesn't need to take care of iterating over all the objects in
  * the image, or to manage by hand the threads.
  *
+ * The threads grab the label objects by batches, to avoid locking the
+ * container of the label objects for each one of them. The size of the
+ * batches decreases with the number of objects left, so the work stays
+ * balanced among the threads until the end.
+ *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
  * This implementation was taken from the Insight Journal paper:
@@ -29,6 +29,8 @@
 #define itkLabelMapFilter_hxx
 #include "itkLabelMapFilter.h"
 #include "itkMutexLockHolder.h"
+#include <algorithm>
+#include <vector>
 
 namespace itk
 {
@@ -108,9 +110,12 @@ void
 LabelMapFilter< TInputImage, TOutputImage >
 ::ThreadedGenerateData( const OutputImageRegionType &, ThreadIdType threadId )
 {
+  const SizeValueType numberOfLabelObjects = this->GetLabelMap()->GetNumberOfLabelObjects();
+  const SizeValueType numberOfThreads = std::max( this->GetNumberOfThreads(), 1u );
+
+  std::vector< LabelObjectType * > batch;
   while ( true )
     {
-    LabelObjectType *labelObject;
     // begin mutex lock
     {
     MutexLockHolder< FastMutexLock > lock(*m_LabelObjectContainerLock );
@@ -121,38 +126,52 @@ LabelMapFilter< TInputImage, TOutputImage >
       return;
       }
 
-    // get the label object
-    labelObject = m_LabelObjectIterator.GetLabelObject();
+    // Grab a batch of label objects, so the lock is not taken for each
+    // object. The size of the batches decreases with the number of remaining
+    // objects, so the last ones are still shared among the threads.
+    SizeValueType batchSize = 1;
+    if ( numberOfLabelObjects > m_NumberOfLabelObjectsProcessed )
+      {
+      batchSize = std::max( ( numberOfLabelObjects - m_NumberOfLabelObjectsProcessed ) / ( 2 * numberOfThreads ),
+                            static_cast< SizeValueType >( 1 ) );
+      }
+    batch.clear();
+    while ( batch.size() < batchSize && !m_LabelObjectIterator.IsAtEnd() )
+      {
+      // get the label object
+      batch.push_back( m_LabelObjectIterator.GetLabelObject() );
 
-    // increment the iterator now, so it will not be invalidated if the object
-    // is destroyed
-    ++m_LabelObjectIterator;
-    ++m_NumberOfLabelObjectsProcessed;
+      // increment the iterator now, so it will not be invalidated if the
+      // object is destroyed
+      ++m_LabelObjectIterator;
+      ++m_NumberOfLabelObjectsProcessed;
+      }
 
     // unlock the mutex, so the other threads can get an object
     }
     // end mutex lock
 
-
-    // and run the user defined method for that object
-    this->ThreadedProcessLabelObject(labelObject);
-
-    if (threadId==0)
+    for ( typename std::vector< LabelObjectType * >::const_iterator it = batch.begin(); it != batch.end(); ++it )
       {
-      const float progress = m_InverseNumberOfLabelObjects*m_NumberOfLabelObjectsProcessed;
-      this->UpdateProgress(progress);
+      // and run the user defined method for that object
+      this->ThreadedProcessLabelObject(*it);
+
+      if (threadId==0)
+        {
+        const float progress = m_InverseNumberOfLabelObjects*m_NumberOfLabelObjectsProcessed;
+        this->UpdateProgress(progress);
+        }
+
+      // all threads needs to check the abort flag
+      if ( this->GetAbortGenerateData() )
+        {
+        std::string    msg;
+        ProcessAborted e(__FILE__, __LINE__);
+        msg += "Object " + std::string(this->GetNameOfClass() ) + ": AbortGenerateDataOn";
+        e.SetDescription(msg);
+        throw e;
+        }
       }
-
-    // all threads needs to check the abort flag
-    if ( this->GetAbortGenerateData() )
-      {
-      std::string    msg;
-      ProcessAborted e(__FILE__, __LINE__);
-      msg += "Object " + std::string(this->GetNameOfClass() ) + ": AbortGenerateDataOn";
-      e.SetDescription(msg);
-      throw e;
-      }
-
     }
 }
 
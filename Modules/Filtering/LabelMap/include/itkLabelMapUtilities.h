@@ -71,6 +71,20 @@
       this->TemplatedGenerateData(accessor); \
       break; \
       } \
+    case LabelObjectType::MINIMUM_FERET_DIAMETER: \
+      { \
+      typedef typename Functor::MinimumFeretDiameterLabelObjectAccessor< LabelObjectType > AccessorType; \
+      AccessorType accessor; \
+      this->TemplatedGenerateData(accessor); \
+      break; \
+      } \
+    case LabelObjectType::CONVEX_HULL_PHYSICAL_SIZE: \
+      { \
+      typedef typename Functor::ConvexHullPhysicalSizeLabelObjectAccessor< LabelObjectType > AccessorType; \
+      AccessorType accessor; \
+      this->TemplatedGenerateData(accessor); \
+      break; \
+      } \
     case LabelObjectType::ELONGATION: \
       { \
       typedef typename Functor::ElongationLabelObjectAccessor< LabelObjectType > AccessorType; \
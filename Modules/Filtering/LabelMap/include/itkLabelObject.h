@@ -18,7 +18,7 @@
 #ifndef itkLabelObject_h
 #define itkLabelObject_h
 
-#include <deque>
+#include <vector>
 #include "itkLightObject.h"
 #include "itkLabelObjectLine.h"
 #include "itkWeakPointer.h"
@@ -33,7 +33,7 @@ namespace itk
  * It should be used associated with the LabelMap.
  *
  * LabelObject store mainly 2 things: the label of the object, and a set of lines
- * which are part of the object.
+ * which are part of the object. The lines are stored contiguously in memory.
  * No attribute is available in that class, so this class can be used as a base class
  * to implement a label object with attribute, or when no attribute is needed (see the
  * reconstruction filters for an example. If a simple attribute is needed,
@@ -130,6 +130,13 @@ public:
    */
   void AddLine(const LineType & line);
 
+  /**
+   * Reserve the memory for the given number of lines. The lines are stored
+   * contiguously, so reserving the memory avoids the reallocations when the
+   * number of lines to add is known in advance.
+   */
+  void ReserveLines(SizeValueType numberOfLines);
+
   SizeValueType GetNumberOfLines() const;
 
   const LineType & GetLine(SizeValueType i) const;
@@ -250,7 +257,7 @@ public:
     }
 
   private:
-    typedef typename std::deque< LineType >            LineContainerType;
+    typedef typename std::vector< LineType >           LineContainerType;
     typedef typename LineContainerType::const_iterator InternalIteratorType;
     InternalIteratorType m_Iterator;
     InternalIteratorType m_Begin;
@@ -345,7 +352,7 @@ public:
 
   private:
 
-    typedef typename std::deque< LineType >            LineContainerType;
+    typedef typename std::vector< LineType >           LineContainerType;
     typedef typename LineContainerType::const_iterator InternalIteratorType;
     void NextValidLine()
     {
@@ -373,7 +380,7 @@ protected:
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(LabelObject);
 
-  typedef typename std::deque< LineType >    LineContainerType;
+  typedef typename std::vector< LineType >   LineContainerType;
 
   LineContainerType m_LineContainer;
   LabelType         m_Label;
@@ -200,6 +200,14 @@ LabelObject< TLabel, VImageDimension >
   m_LineContainer.push_back(line);
 }
 
+template< typename TLabel, unsigned int VImageDimension >
+void
+LabelObject< TLabel, VImageDimension >
+::ReserveLines(SizeValueType numberOfLines)
+{
+  m_LineContainer.reserve(numberOfLines);
+}
+
 template< typename TLabel, unsigned int VImageDimension >
 typename LabelObject< TLabel, VImageDimension >::SizeValueType
 LabelObject< TLabel, VImageDimension >
@@ -288,6 +296,7 @@ LabelObject< TLabel, VImageDimension >
   itkAssertOrThrowMacro ( ( src != ITK_NULLPTR ), "Null Pointer" );
   // clear original lines and copy lines
   m_LineContainer.clear();
+  m_LineContainer.reserve( src->GetNumberOfLines() );
   for( size_t i = 0; i < src->GetNumberOfLines(); ++i )
     {
     this->AddLine( src->GetLine( static_cast< SizeValueType >( i ) ) );
@@ -330,26 +339,20 @@ LabelObject< TLabel, VImageDimension >
 {
   if ( !m_LineContainer.empty() )
     {
-    // first copy the lines in another container and clear the current one
-    LineContainerType lineContainer = m_LineContainer;
-    m_LineContainer.clear();
-
     // reorder the lines
     typename Functor::LabelObjectLineComparator< LineType > comparator;
-    std::sort(lineContainer.begin(), lineContainer.end(), comparator);
+    std::sort(m_LineContainer.begin(), m_LineContainer.end(), comparator);
 
-    // then check the lines consistancy
+    // then check the lines consistancy and merge them in place
     // we'll proceed line index by line index
-    IndexType currentIdx = lineContainer.begin()->GetIndex();
-    LengthType  currentLength = lineContainer.begin()->GetLength();
-
-    typename LineContainerType::const_iterator it = lineContainer.begin();
+    typename LineContainerType::iterator current = m_LineContainer.begin();
+    typename LineContainerType::iterator it = current;
+    ++it;
 
-    while ( it != lineContainer.end() )
+    while ( it != m_LineContainer.end() )
       {
-      const LineType & line = *it;
-      IndexType        idx = line.GetIndex();
-      LengthType    length = line.GetLength();
+      const IndexType & currentIdx = current->GetIndex();
+      const IndexType & idx = it->GetIndex();
 
       // check the index to be sure that we are still in the same line idx
       bool sameIdx = true;
@@ -362,26 +365,25 @@ LabelObject< TLabel, VImageDimension >
         }
 
       // try to extend the current line idx, or create a new line
-      if ( sameIdx && currentIdx[0] + (OffsetValueType)currentLength >= idx[0] )
+      if ( sameIdx && currentIdx[0] + (OffsetValueType)current->GetLength() >= idx[0] )
         {
         // we may expand the line
-        LengthType newLength = idx[0] + (OffsetValueType)length - currentIdx[0];
-        currentLength = std::max(newLength, currentLength);
+        LengthType newLength = idx[0] + (OffsetValueType)it->GetLength() - currentIdx[0];
+        current->SetLength( std::max( newLength, current->GetLength() ) );
         }
       else
         {
-        // add the previous line to the new line container and use the new line
-        // index and size
-        this->AddLine(currentIdx, currentLength);
-        currentIdx = idx;
-        currentLength = length;
+        // keep the previous line and use the new line index and size
+        ++current;
+        *current = *it;
         }
 
       it++;
       }
 
-    // complete the last line
-    this->AddLine(currentIdx, currentLength);
+    // remove the lines merged in the previous ones
+    ++current;
+    m_LineContainer.erase( current, m_LineContainer.end() );
     }
 }
 
@@ -19,6 +19,9 @@
 #define itkShapeLabelMapFilter_h
 
 #include "itkInPlaceLabelMapFilter.h"
+#include "itkContinuousIndex.h"
+#include "itkMultiThreader.h"
+#include <vector>
 
 namespace itk
 {
@@ -28,15 +31,24 @@ namespace itk
  * ShapeLabelMapFilter can be used to set the attributes values of the
  * ShapeLabelObject in a LabelMap.
  *
- * ShapeLabelMapFilter takes an optional parameter, used only to
- * optimize the computation time and the memory usage when the
- * perimeter or the feret diameter is used: the exact copy of the
- * input LabelMap is stored in an Image.
- * It can be set with SetLabelImage(). It is cleared at the end of the
- * computation, so must be reset before running Update() again. It is
- * not part of the pipeline management design, to let the subclasses
- * of ShapeLabelMapFilter use the pipeline design to specify truly
- * required inputs.
+ * ShapeLabelMapFilter takes an optional parameter, the exact copy of the
+ * input LabelMap stored in an Image, which can be set with SetLabelImage().
+ * It is not used anymore by the computation of the attributes, and is only
+ * kept for backward compatibility.
+ *
+ * The Feret diameters and the size of the convex hull are computed from
+ * the convex hull of the ends of the lines of the objects, with
+ * GeometryUtilities::ConvexHullFeretDiameters(), without the quadratic
+ * search over the pixels of the border of the objects.
+ *
+ * The label objects are processed in parallel, each one by a single thread,
+ * except the ones with at least MinimumNumberOfLinesToSplit lines: the
+ * lines of these objects are split among all the threads, and the partial
+ * moments computed by the threads are reduced afterwards, so that a few
+ * very large objects don't leave all the threads but one idle. The split
+ * objects are processed after the other ones. Their attributes may differ
+ * from the ones computed by a single thread by the rounding errors of the
+ * sums.
  *
  * \author Gaetan Lehmann. Biologie du Developpement et de la Reproduction, INRA de Jouy-en-Josas, France.
  *
@@ -101,7 +113,8 @@ public:
 
   /**
    * Set/Get whether the maximum Feret diameter should be computed or not.
-   * Default value is false because of the high computation time required.
+   * The minimum Feret diameter and the size of the convex hull are computed
+   * at the same time. Default value is false.
    */
   itkSetMacro(ComputeFeretDiameter, bool);
   itkGetConstReferenceMacro(ComputeFeretDiameter, bool);
@@ -124,6 +137,14 @@ public:
   itkGetConstReferenceMacro(ComputeOrientedBoundingBox, bool);
   itkBooleanMacro(ComputeOrientedBoundingBox);
 
+  /**
+   * Set/Get the number of lines from which the lines of a label object are
+   * split among the threads to compute its attributes. Default value is
+   * 16384.
+   */
+  itkSetMacro(MinimumNumberOfLinesToSplit, SizeValueType);
+  itkGetConstReferenceMacro(MinimumNumberOfLinesToSplit, SizeValueType);
+
   /** Set the label image */
   void SetLabelImage(const TLabelImage *input)
   {
@@ -138,18 +159,80 @@ protected:
 
   virtual void BeforeThreadedGenerateData() ITK_OVERRIDE;
 
+  /** Process the split label objects, with all the threads. */
   virtual void AfterThreadedGenerateData() ITK_OVERRIDE;
 
   void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
 
+  /** Whether the attributes of the label object are computed by all the
+   * threads together. Such objects must be skipped by
+   * ThreadedProcessLabelObject(). */
+  bool IsSplitLabelObject(const LabelObjectType *labelObject) const
+  {
+    return m_NumberOfSplitThreads > 1 && labelObject->GetNumberOfLines() >= m_MinimumNumberOfLinesToSplit;
+  }
+
+  /** The number of split label objects and the number of threads used to
+   * process them. They are set in BeforeThreadedGenerateData(). */
+  SizeValueType GetNumberOfSplitLabelObjects() const
+  {
+    return m_SplitLabelObjects.size();
+  }
+  ThreadIdType GetNumberOfSplitThreads() const
+  {
+    return m_NumberOfSplitThreads;
+  }
+
+  /** Accumulate the lines [beginLine, endLine) of the split label object
+   * number splitIndex in the partial results of the thread threadId. */
+  virtual void ThreadedProcessSplitLabelObjectLines(SizeValueType splitIndex, LabelObjectType *labelObject,
+                                                    SizeValueType beginLine, SizeValueType endLine,
+                                                    ThreadIdType threadId);
+
+  /** Reduce the partial results of the threads and set the attributes of
+   * the split label object number splitIndex. */
+  virtual void ThreadedFinalizeSplitLabelObject(SizeValueType splitIndex, LabelObjectType *labelObject);
+
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(ShapeLabelMapFilter);
 
+  /** The sums accumulated over the lines of a label object. */
+  struct ShapeMomentsType
+  {
+    SizeValueType                             m_NumberOfPixels;
+    ContinuousIndex< double, ImageDimension > m_Centroid;
+    IndexType                                 m_Mins;
+    IndexType                                 m_Maxs;
+    SizeValueType                             m_NumberOfPixelsOnBorder;
+    double                                    m_PerimeterOnBorder;
+    MatrixType                                m_CentralMoments;
+
+    ShapeMomentsType();
+    void Merge(const ShapeMomentsType & other);
+  };
+
+  struct SplitThreadStruct
+  {
+    Self *       Filter;
+    unsigned int Pass;
+  };
+
+  static ITK_THREAD_RETURN_TYPE SplitLabelObjectsThreaderCallback(void *arg);
+
+  void AccumulateShapeMoments(const LabelObjectType *labelObject, SizeValueType beginLine,
+                              SizeValueType endLine, ShapeMomentsType & moments) const;
+  void SetShapeAttributes(LabelObjectType *labelObject, const ShapeMomentsType & moments);
+
   bool                   m_ComputeFeretDiameter;
   bool                   m_ComputePerimeter;
   bool                   m_ComputeOrientedBoundingBox;
   LabelImageConstPointer m_LabelImage;
 
+  SizeValueType                    m_MinimumNumberOfLinesToSplit;
+  ThreadIdType                     m_NumberOfSplitThreads;
+  std::vector< LabelObjectType * > m_SplitLabelObjects;
+  std::vector< ShapeMomentsType >  m_SplitShapeMoments;
+
   void ComputeFeretDiameter(LabelObjectType *labelObject);
   void ComputePerimeter(LabelObjectType *labelObject);
   void ComputeOrientedBoundingBox(LabelObjectType *labelObject);
@@ -34,6 +34,36 @@
 
 namespace itk
 {
+template< typename TImage, typename TLabelImage >
+ShapeLabelMapFilter< TImage, TLabelImage >
+::ShapeMomentsType::ShapeMomentsType() :
+  m_NumberOfPixels(0),
+  m_NumberOfPixelsOnBorder(0),
+  m_PerimeterOnBorder(0)
+{
+  m_Centroid.Fill(0);
+  m_Mins.Fill( NumericTraits< IndexValueType >::max() );
+  m_Maxs.Fill( NumericTraits< IndexValueType >::NonpositiveMin() );
+  m_CentralMoments.Fill(0);
+}
+
+template< typename TImage, typename TLabelImage >
+void
+ShapeLabelMapFilter< TImage, TLabelImage >
+::ShapeMomentsType::Merge(const ShapeMomentsType & other)
+{
+  m_NumberOfPixels += other.m_NumberOfPixels;
+  m_NumberOfPixelsOnBorder += other.m_NumberOfPixelsOnBorder;
+  m_PerimeterOnBorder += other.m_PerimeterOnBorder;
+  for ( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    m_Centroid[i] += other.m_Centroid[i];
+    m_Mins[i] = std::min(m_Mins[i], other.m_Mins[i]);
+    m_Maxs[i] = std::max(m_Maxs[i], other.m_Maxs[i]);
+    }
+  m_CentralMoments += other.m_CentralMoments;
+}
+
 template< typename TImage, typename TLabelImage >
 ShapeLabelMapFilter< TImage, TLabelImage >
 ::ShapeLabelMapFilter()
@@ -41,6 +71,8 @@ ShapeLabelMapFilter< TImage, TLabelImage >
   m_ComputeFeretDiameter = false;
   m_ComputePerimeter = true;
   m_ComputeOrientedBoundingBox = false;
+  m_MinimumNumberOfLinesToSplit = 16384;
+  m_NumberOfSplitThreads = 1;
 }
 
 template< typename TImage, typename TLabelImage >
@@ -50,21 +82,23 @@ ShapeLabelMapFilter< TImage, TLabelImage >
 {
   Superclass::BeforeThreadedGenerateData();
 
-  // Generate the label image, if needed
-  if ( m_ComputeFeretDiameter )
+  // Find the label objects large enough to be split among the threads
+  this->GetMultiThreader()->SetNumberOfThreads( this->GetNumberOfThreads() );
+  m_NumberOfSplitThreads = this->GetMultiThreader()->GetNumberOfThreads();
+  m_SplitLabelObjects.clear();
+  if ( m_NumberOfSplitThreads > 1 )
     {
-    if ( !m_LabelImage )
+    typename ImageType::Iterator it( this->GetLabelMap() );
+    while ( !it.IsAtEnd() )
       {
-      // generate an image of the labelized image
-      typedef LabelMapToLabelImageFilter< TImage, LabelImageType > LCI2IType;
-      typename LCI2IType::Pointer lci2i = LCI2IType::New();
-      lci2i->SetInput( this->GetOutput() );
-      // Respect the number of threads of the filter
-      lci2i->SetNumberOfThreads( this->GetNumberOfThreads() );
-      lci2i->Update();
-      m_LabelImage = lci2i->GetOutput();
+      if ( this->IsSplitLabelObject( it.GetLabelObject() ) )
+        {
+        m_SplitLabelObjects.push_back( it.GetLabelObject() );
+        }
+      ++it;
       }
     }
+  m_SplitShapeMoments.assign( m_SplitLabelObjects.size() * m_NumberOfSplitThreads, ShapeMomentsType() );
 }
 
 template< typename TImage, typename TLabelImage >
@@ -72,7 +106,84 @@ void
 ShapeLabelMapFilter< TImage, TLabelImage >
 ::ThreadedProcessLabelObject(LabelObjectType *labelObject)
 {
-  ImageType *            output = this->GetOutput();
+  if ( this->IsSplitLabelObject(labelObject) )
+    {
+    // processed by all the threads in AfterThreadedGenerateData()
+    return;
+    }
+
+  ShapeMomentsType moments;
+  this->AccumulateShapeMoments(labelObject, 0, labelObject->GetNumberOfLines(), moments);
+  this->SetShapeAttributes(labelObject, moments);
+}
+
+template< typename TImage, typename TLabelImage >
+void
+ShapeLabelMapFilter< TImage, TLabelImage >
+::ThreadedProcessSplitLabelObjectLines(SizeValueType splitIndex, LabelObjectType *labelObject,
+                                       SizeValueType beginLine, SizeValueType endLine,
+                                       ThreadIdType threadId)
+{
+  this->AccumulateShapeMoments(labelObject, beginLine, endLine,
+                               m_SplitShapeMoments[splitIndex * m_NumberOfSplitThreads + threadId]);
+}
+
+template< typename TImage, typename TLabelImage >
+void
+ShapeLabelMapFilter< TImage, TLabelImage >
+::ThreadedFinalizeSplitLabelObject(SizeValueType splitIndex, LabelObjectType *labelObject)
+{
+  ShapeMomentsType moments;
+  for ( ThreadIdType t = 0; t < m_NumberOfSplitThreads; t++ )
+    {
+    moments.Merge( m_SplitShapeMoments[splitIndex * m_NumberOfSplitThreads + t] );
+    }
+  this->SetShapeAttributes(labelObject, moments);
+}
+
+template< typename TImage, typename TLabelImage >
+ITK_THREAD_RETURN_TYPE
+ShapeLabelMapFilter< TImage, TLabelImage >
+::SplitLabelObjectsThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  const ThreadIdType               threadId = info->ThreadID;
+  const ThreadIdType               numberOfThreads = info->NumberOfThreads;
+  SplitThreadStruct *              str = static_cast< SplitThreadStruct * >( info->UserData );
+  Self *                           filter = str->Filter;
+
+  const SizeValueType numberOfSplitLabelObjects = filter->m_SplitLabelObjects.size();
+  if ( str->Pass == 0 )
+    {
+    // each thread accumulates a part of the lines of each object
+    for ( SizeValueType i = 0; i < numberOfSplitLabelObjects; i++ )
+      {
+      LabelObjectType *   labelObject = filter->m_SplitLabelObjects[i];
+      const SizeValueType numberOfLines = labelObject->GetNumberOfLines();
+      filter->ThreadedProcessSplitLabelObjectLines(i, labelObject,
+                                                   numberOfLines * threadId / numberOfThreads,
+                                                   numberOfLines * ( threadId + 1 ) / numberOfThreads,
+                                                   threadId);
+      }
+    }
+  else
+    {
+    // and the objects are then finalized by different threads
+    for ( SizeValueType i = threadId; i < numberOfSplitLabelObjects; i += numberOfThreads )
+      {
+      filter->ThreadedFinalizeSplitLabelObject(i, filter->m_SplitLabelObjects[i]);
+      }
+    }
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< typename TImage, typename TLabelImage >
+void
+ShapeLabelMapFilter< TImage, TLabelImage >
+::AccumulateShapeMoments(const LabelObjectType *labelObject, SizeValueType beginLine,
+                         SizeValueType endLine, ShapeMomentsType & moments) const
+{
+  const ImageType * output = this->GetOutput();
 
   // Compute the size per pixel, to be used later
   double sizePerPixel = 1;
@@ -96,56 +207,45 @@ ShapeLabelMapFilter< TImage, TLabelImage >
     borderMax[i] += output->GetLargestPossibleRegion().GetSize()[i] - 1;
     }
 
-  // Init the vars
-  SizeValueType                             nbOfPixels = 0;
-  ContinuousIndex< double, ImageDimension > centroid;
-  centroid.Fill(0);
-  IndexType mins;
-  mins.Fill( NumericTraits< IndexValueType >::max() );
-  IndexType maxs;
-  maxs.Fill( NumericTraits< IndexValueType >::NonpositiveMin() );
-  SizeValueType nbOfPixelsOnBorder = 0;
-  double        perimeterOnBorder = 0;
-  MatrixType    centralMoments;
-  centralMoments.Fill(0);
+  // get the spacing - it is used several times later
+  const typename ImageType::SpacingType & spacing = output->GetSpacing();
 
   typedef typename LabelObjectType::LengthType  LengthType;
 
-  // Iterate over all the lines
-  typename LabelObjectType::ConstLineIterator lit( labelObject );
-  while( ! lit.IsAtEnd() )
+  // Iterate over the lines
+  for ( SizeValueType l = beginLine; l < endLine; l++ )
     {
-    const IndexType & idx = lit.GetLine().GetIndex();
-    LengthType     length = lit.GetLine().GetLength();
+    const IndexType & idx = labelObject->GetLine(l).GetIndex();
+    LengthType     length = labelObject->GetLine(l).GetLength();
 
     // Update the nbOfPixels
-    nbOfPixels += length;
+    moments.m_NumberOfPixels += length;
 
     // Update the centroid - and report the progress
     // First, update the axes that are not 0
     for ( unsigned int i = 1; i < ImageDimension; i++ )
       {
-      centroid[i] += (OffsetValueType)length * idx[i];
+      moments.m_Centroid[i] += (OffsetValueType)length * idx[i];
       }
     // Then, update the axis 0
-    centroid[0] += idx[0] * (OffsetValueType)length + ( length * ( length - 1 ) ) / 2.0;
+    moments.m_Centroid[0] += idx[0] * (OffsetValueType)length + ( length * ( length - 1 ) ) / 2.0;
 
     // Update the mins and maxs
     for ( unsigned int i = 0; i < ImageDimension; i++ )
       {
-      if ( idx[i] < mins[i] )
+      if ( idx[i] < moments.m_Mins[i] )
         {
-        mins[i] = idx[i];
+        moments.m_Mins[i] = idx[i];
         }
-      if ( idx[i] > maxs[i] )
+      if ( idx[i] > moments.m_Maxs[i] )
         {
-        maxs[i] = idx[i];
+        moments.m_Maxs[i] = idx[i];
         }
       }
     // Must fix the max for the axis 0
-    if ( idx[0] + (OffsetValueType)length > maxs[0] )
+    if ( idx[0] + (OffsetValueType)length > moments.m_Maxs[0] )
       {
-      maxs[0] = idx[0] + length - 1;
+      moments.m_Maxs[0] = idx[0] + length - 1;
       }
 
     // Object is on a border ?
@@ -162,7 +262,7 @@ ShapeLabelMapFilter< TImage, TLabelImage >
       {
       // The line touch a border on a dimension other than 0, so
       // all the line touch a border
-      nbOfPixelsOnBorder += length;
+      moments.m_NumberOfPixelsOnBorder += length;
       }
     else
       {
@@ -171,7 +271,7 @@ ShapeLabelMapFilter< TImage, TLabelImage >
       if ( idx[0] == borderMin[0] )
         {
         // One more pixel on the border
-        nbOfPixelsOnBorder++;
+        moments.m_NumberOfPixelsOnBorder++;
         isOnBorder0 = true;
         }
       if ( !isOnBorder0 || length > 1 )
@@ -180,7 +280,7 @@ ShapeLabelMapFilter< TImage, TLabelImage >
         if ( idx[0] + (OffsetValueType)length - 1 == borderMax[0] )
           {
           // One more pixel on the border
-          nbOfPixelsOnBorder++;
+          moments.m_NumberOfPixelsOnBorder++;
           }
         }
       }
@@ -190,12 +290,12 @@ ShapeLabelMapFilter< TImage, TLabelImage >
     if ( idx[0] == borderMin[0] )
       {
       // Fhe beginning of the line
-      perimeterOnBorder += sizePerPixelPerDimension[0];
+      moments.m_PerimeterOnBorder += sizePerPixelPerDimension[0];
       }
     if ( idx[0] + (OffsetValueType)length - 1 == borderMax[0] )
       {
       // And the end of the line
-      perimeterOnBorder += sizePerPixelPerDimension[0];
+      moments.m_PerimeterOnBorder += sizePerPixelPerDimension[0];
       }
     // Then the other dimensions
     for ( unsigned int i = 1; i < ImageDimension; i++ )
@@ -203,12 +303,12 @@ ShapeLabelMapFilter< TImage, TLabelImage >
       if ( idx[i] == borderMin[i] )
         {
         // one border
-        perimeterOnBorder += sizePerPixelPerDimension[i] * length;
+        moments.m_PerimeterOnBorder += sizePerPixelPerDimension[i] * length;
         }
       if ( idx[i] == borderMax[i] )
         {
         // and the other
-        perimeterOnBorder += sizePerPixelPerDimension[i] * length;
+        moments.m_PerimeterOnBorder += sizePerPixelPerDimension[i] * length;
         }
       }
 
@@ -228,7 +328,7 @@ ShapeLabelMapFilter< TImage, TLabelImage >
 //         {
 //         for(unsigned int j=0; j<ImageDimension; j++)
 //           {
-//           centralMoments[i][j] += pP[i] * pP[j];
+//           moments.m_CentralMoments[i][j] += pP[i] * pP[j];
 //           }
 //         }
 //       }
@@ -236,12 +336,11 @@ ShapeLabelMapFilter< TImage, TLabelImage >
     // later
     typename LabelObjectType::CentroidType physicalPosition;
     output->TransformIndexToPhysicalPoint(idx, physicalPosition);
-    const typename ImageType::SpacingType & spacing = output->GetSpacing();
     // the sum of x positions, also reused several times
     double sumX = length * ( physicalPosition[0] + ( spacing[0] * ( length - 1 ) ) / 2.0 );
     // the real job - the sum of square of x positions
     // that's the central moments for dims 0, 0
-    centralMoments[0][0] += length * ( physicalPosition[0] * physicalPosition[0]
+    moments.m_CentralMoments[0][0] += length * ( physicalPosition[0] * physicalPosition[0]
                                        + spacing[0]
                                        * ( length
                                            - 1 ) * ( ( spacing[0] * ( 2 * length - 1 ) ) / 6.0 + physicalPosition[0] ) );
@@ -250,7 +349,7 @@ ShapeLabelMapFilter< TImage, TLabelImage >
       {
       // do this one here to avoid the double assigment in the following loop
       // when i == j
-      centralMoments[i][i] += length * physicalPosition[i] * physicalPosition[i];
+      moments.m_CentralMoments[i][i] += length * physicalPosition[i] * physicalPosition[i];
       // central moments are symetrics, so avoid to compute them 2 times
       for ( unsigned int j = i + 1; j < ImageDimension; j++ )
         {
@@ -258,26 +357,46 @@ ShapeLabelMapFilter< TImage, TLabelImage >
         // 3
         // --> the tests should be in 3D at least
         double cm = length * physicalPosition[i] * physicalPosition[j];
-        centralMoments[i][j] += cm;
-        centralMoments[j][i] += cm;
+        moments.m_CentralMoments[i][j] += cm;
+        moments.m_CentralMoments[j][i] += cm;
         }
       // the last moments: the ones for the dimension 0
       double cm = sumX * physicalPosition[i];
-      centralMoments[i][0] += cm;
-      centralMoments[0][i] += cm;
+      moments.m_CentralMoments[i][0] += cm;
+      moments.m_CentralMoments[0][i] += cm;
       }
-    ++lit;
     }
+}
+
+template< typename TImage, typename TLabelImage >
+void
+ShapeLabelMapFilter< TImage, TLabelImage >
+::SetShapeAttributes(LabelObjectType *labelObject, const ShapeMomentsType & moments)
+{
+  ImageType * output = this->GetOutput();
+
+  // Compute the size per pixel, to be used later
+  double sizePerPixel = 1;
+
+  for ( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    sizePerPixel *= output->GetSpacing()[i];
+    }
+
+  ContinuousIndex< double, ImageDimension > centroid = moments.m_Centroid;
+  const IndexType &                         mins = moments.m_Mins;
+  const IndexType &                         maxs = moments.m_Maxs;
+  MatrixType                                centralMoments = moments.m_CentralMoments;
 
   // final computation
   typename LabelObjectType::RegionType::SizeType boundingBoxSize;
   for ( unsigned int i = 0; i < ImageDimension; i++ )
     {
-    centroid[i] /= nbOfPixels;
+    centroid[i] /= moments.m_NumberOfPixels;
     boundingBoxSize[i] = maxs[i] - mins[i] + 1;
     for ( unsigned int j = 0; j < ImageDimension; j++ )
       {
-      centralMoments[i][j] /= nbOfPixels;
+      centralMoments[i][j] /= moments.m_NumberOfPixels;
       }
     }
   typename LabelObjectType::RegionType boundingBox(mins, boundingBoxSize);
@@ -332,7 +451,7 @@ ShapeLabelMapFilter< TImage, TLabelImage >
     flatness = std::sqrt(principalMoments[1] / principalMoments[0]);
     }
 
-  double physicalSize = nbOfPixels * sizePerPixel;
+  double physicalSize = moments.m_NumberOfPixels * sizePerPixel;
   double equivalentRadius = GeometryUtilities::HyperSphereRadiusFromVolume(ImageDimension, physicalSize);
   double equivalentPerimeter = GeometryUtilities::HyperSpherePerimeter(ImageDimension, equivalentRadius);
 
@@ -357,12 +476,12 @@ ShapeLabelMapFilter< TImage, TLabelImage >
     }
 
   // Set the values in the object
-  labelObject->SetNumberOfPixels(nbOfPixels);
+  labelObject->SetNumberOfPixels(moments.m_NumberOfPixels);
   labelObject->SetPhysicalSize(physicalSize);
   labelObject->SetBoundingBox(boundingBox);
   labelObject->SetCentroid(physicalCentroid);
-  labelObject->SetNumberOfPixelsOnBorder(nbOfPixelsOnBorder);
-  labelObject->SetPerimeterOnBorder(perimeterOnBorder);
+  labelObject->SetNumberOfPixelsOnBorder(moments.m_NumberOfPixelsOnBorder);
+  labelObject->SetPerimeterOnBorder(moments.m_PerimeterOnBorder);
   labelObject->SetPrincipalMoments(principalMoments);
   labelObject->SetPrincipalAxes(principalAxes);
   labelObject->SetElongation(elongation);
@@ -392,73 +511,34 @@ void
 ShapeLabelMapFilter< TImage, TLabelImage >
 ::ComputeFeretDiameter(LabelObjectType *labelObject)
 {
-  const LabelPixelType & label = labelObject->GetLabel();
-
-  typedef typename std::deque< IndexType > IndexListType;
-  IndexListType idxList;
-
-  typedef typename itk::ConstNeighborhoodIterator< LabelImageType > NeighborIteratorType;
-  SizeType neighborHoodRadius;
-  neighborHoodRadius.Fill(1);
-  NeighborIteratorType                        it( neighborHoodRadius, m_LabelImage, m_LabelImage->GetBufferedRegion() );
-  ConstantBoundaryCondition< LabelImageType > lcbc;
-  // Use label + 1 to have a label different of the current label on the border
-  lcbc.SetConstant(label + 1);
-  it.OverrideBoundaryCondition(&lcbc);
-  it.GoToBegin();
-
-  typedef typename NeighborIteratorType::NeighborIndexType   NeighborIndexType;
-
-  // Iterate over all the indexes
-  typename LabelObjectType::ConstIndexIterator iit( labelObject );
-  while( ! iit.IsAtEnd() )
+  // The vertices of the convex hull of the object are at the ends of its
+  // lines, so only these pixels are given to the convex hull computation.
+  std::vector< OffsetValueType > points;
+  points.reserve( 2 * ImageDimension * labelObject->GetNumberOfLines() );
+  for ( SizeValueType i = 0; i < labelObject->GetNumberOfLines(); ++i )
     {
-    // Move the iterator to the new location
-    it += iit.GetIndex() - it.GetIndex();
-
-    // Push the pixel in the list if it is on the border of the object
-    for ( NeighborIndexType i = 0; i < it.Size(); i++ )
+    const typename LabelObjectType::LineType & line = labelObject->GetLine(i);
+    IndexType idx = line.GetIndex();
+    points.insert( points.end(), &idx[0], &idx[0] + ImageDimension );
+    if ( line.GetLength() > 1 )
       {
-      if ( it.GetPixel(i) != label )
-        {
-        idxList.push_back( iit.GetIndex() );
-        break;
-        }
+      idx[0] += line.GetLength() - 1;
+      points.insert( points.end(), &idx[0], &idx[0] + ImageDimension );
       }
-    ++iit;
     }
 
-  ImageType *output = this->GetOutput();
+  const typename ImageType::SpacingType & spacing = this->GetOutput()->GetSpacing();
 
-  const typename ImageType::SpacingType & spacing = output->GetSpacing();
-
-  // We can now search the feret diameter
-  double feretDiameter = 0;
-  for ( typename IndexListType::const_iterator iIt1 = idxList.begin();
-        iIt1 != idxList.end();
-        iIt1++ )
-    {
-    typename IndexListType::const_iterator iIt2 = iIt1;
-    for ( iIt2++; iIt2 != idxList.end(); iIt2++ )
-      {
-      // Compute the length between the 2 indexes
-      double length = 0;
-      for ( unsigned int i = 0; i < ImageDimension; i++ )
-        {
-        const OffsetValueType indexDifference = ( iIt1->operator[](i) - iIt2->operator[](i) );
-        length += std::pow(indexDifference * spacing[i], 2);
-        }
-      if ( feretDiameter < length )
-        {
-        feretDiameter = length;
-        }
-      }
-    }
-  // Final computation
-  feretDiameter = std::sqrt(feretDiameter);
+  double feretDiameter;
+  double minimumFeretDiameter;
+  double convexHullSize;
+  GeometryUtilities::ConvexHullFeretDiameters(ImageDimension, points, spacing.GetDataPointer(),
+                                              feretDiameter, minimumFeretDiameter, convexHullSize);
 
   // Finally put the values in the label object
   labelObject->SetFeretDiameter(feretDiameter);
+  labelObject->SetMinimumFeretDiameter(minimumFeretDiameter);
+  labelObject->SetConvexHullPhysicalSize(convexHullSize);
 }
 
 template< typename TImage, typename TLabelImage >
@@ -865,6 +945,23 @@ void
 ShapeLabelMapFilter< TImage, TLabelImage >
 ::AfterThreadedGenerateData()
 {
+  if ( !m_SplitLabelObjects.empty() )
+    {
+    // Two passes: the threads first accumulate their parts of the lines of
+    // all the split objects, then the partial results of each object are
+    // reduced by one thread
+    SplitThreadStruct str;
+    str.Filter = this;
+    this->GetMultiThreader()->SetNumberOfThreads(m_NumberOfSplitThreads);
+    this->GetMultiThreader()->SetSingleMethod(this->SplitLabelObjectsThreaderCallback, &str);
+    for ( str.Pass = 0; str.Pass < 2; str.Pass++ )
+      {
+      this->GetMultiThreader()->SingleMethodExecute();
+      }
+    m_SplitLabelObjects.clear();
+    m_SplitShapeMoments.clear();
+    }
+
   Superclass::AfterThreadedGenerateData();
 
   // Release the label image
@@ -881,6 +978,7 @@ ShapeLabelMapFilter< TImage, TLabelImage >
   os << indent << "ComputeFeretDiameter: " << m_ComputeFeretDiameter << std::endl;
   os << indent << "ComputePerimeter: " << m_ComputePerimeter << std::endl;
   os << indent << "ComputeOrientedBoundingBox: " << m_ComputeOrientedBoundingBox << std::endl;
+  os << indent << "MinimumNumberOfLinesToSplit: " << m_MinimumNumberOfLinesToSplit << std::endl;
 }
 
 } // end namespace itk
@@ -107,6 +107,18 @@ public:
     * because of its high computation. Its type is double.*/
   itkStaticConstMacro(FERET_DIAMETER, AttributeType, 108);
 
+  /** MinimumFeretDiameter is the smallest distance in physical units
+    * between two parallel planes enclosing the object, also called the width
+    * of the object. It is computed with the FeretDiameter, in 2D and 3D
+    * only. Its type is double.*/
+  itkStaticConstMacro(MINIMUM_FERET_DIAMETER, AttributeType, 121);
+
+  /** ConvexHullPhysicalSize is the size in physical units of the convex hull
+    * of the centers of the pixels of the object: an area in 2D and a volume
+    * in 3D. It is computed with the FeretDiameter, in 2D and 3D only.
+    * Its type is double.*/
+  itkStaticConstMacro(CONVEX_HULL_PHYSICAL_SIZE, AttributeType, 122);
+
   /** PrincipalMoments contains the principal moments.*/
   itkStaticConstMacro(PRINCIPAL_MOMENTS, AttributeType, 109);
 
@@ -187,6 +199,14 @@ public:
       {
       return FERET_DIAMETER;
       }
+    else if ( s == "MinimumFeretDiameter" )
+      {
+      return MINIMUM_FERET_DIAMETER;
+      }
+    else if ( s == "ConvexHullPhysicalSize" )
+      {
+      return CONVEX_HULL_PHYSICAL_SIZE;
+      }
     else if ( s == "PrincipalMoments" )
       {
       return PRINCIPAL_MOMENTS;
@@ -265,6 +285,12 @@ public:
       case FERET_DIAMETER:
         name = "FeretDiameter";
         break;
+      case MINIMUM_FERET_DIAMETER:
+        name = "MinimumFeretDiameter";
+        break;
+      case CONVEX_HULL_PHYSICAL_SIZE:
+        name = "ConvexHullPhysicalSize";
+        break;
       case PRINCIPAL_MOMENTS:
         name = "PrincipalMoments";
         break;
@@ -413,6 +439,26 @@ public:
     m_FeretDiameter = v;
   }
 
+  const double & GetMinimumFeretDiameter() const
+  {
+    return m_MinimumFeretDiameter;
+  }
+
+  void SetMinimumFeretDiameter(const double & v)
+  {
+    m_MinimumFeretDiameter = v;
+  }
+
+  const double & GetConvexHullPhysicalSize() const
+  {
+    return m_ConvexHullPhysicalSize;
+  }
+
+  void SetConvexHullPhysicalSize(const double & v)
+  {
+    m_ConvexHullPhysicalSize = v;
+  }
+
   const VectorType & GetPrincipalMoments() const
   {
     return m_PrincipalMoments;
@@ -656,6 +702,8 @@ public:
     m_NumberOfPixelsOnBorder = src->GetNumberOfPixelsOnBorder();
     m_PerimeterOnBorder = src->GetPerimeterOnBorder();
     m_FeretDiameter = src->GetFeretDiameter();
+    m_MinimumFeretDiameter = src->GetMinimumFeretDiameter();
+    m_ConvexHullPhysicalSize = src->GetConvexHullPhysicalSize();
     m_PrincipalMoments = src->GetPrincipalMoments();
     m_PrincipalAxes = src->GetPrincipalAxes();
     m_Elongation = src->GetElongation();
@@ -687,6 +735,8 @@ protected:
     m_NumberOfPixelsOnBorder = 0;
     m_PerimeterOnBorder = 0;
     m_FeretDiameter = 0;
+    m_MinimumFeretDiameter = 0;
+    m_ConvexHullPhysicalSize = 0;
     m_PrincipalMoments.Fill(0);
     m_PrincipalAxes.Fill(0);
     m_Elongation = 0;
@@ -723,6 +773,8 @@ protected:
     os << indent << "PrincipalMoments: " << m_PrincipalMoments << std::endl;
     os << indent << "PrincipalAxes: " << std::endl << m_PrincipalAxes;
     os << indent << "FeretDiameter: " << m_FeretDiameter << std::endl;
+    os << indent << "MinimumFeretDiameter: " << m_MinimumFeretDiameter << std::endl;
+    os << indent << "ConvexHullPhysicalSize: " << m_ConvexHullPhysicalSize << std::endl;
     os << indent << "m_OrientedBoundingBoxSize: " << m_OrientedBoundingBoxSize << std::endl;
     os << indent << "m_OrientedBoundingBoxOrigin: " << m_OrientedBoundingBoxOrigin << std::endl;
   }
@@ -737,6 +789,8 @@ private:
   SizeValueType m_NumberOfPixelsOnBorder;
   double        m_PerimeterOnBorder;
   double        m_FeretDiameter;
+  double        m_MinimumFeretDiameter;
+  double        m_ConvexHullPhysicalSize;
   VectorType    m_PrincipalMoments;
   MatrixType    m_PrincipalAxes;
   double        m_Elongation;
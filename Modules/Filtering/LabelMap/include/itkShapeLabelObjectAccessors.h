@@ -126,6 +126,32 @@ public:
   }
 };
 
+template< typename TLabelObject >
+class MinimumFeretDiameterLabelObjectAccessor
+{
+public:
+  typedef TLabelObject LabelObjectType;
+  typedef double       AttributeValueType;
+
+  inline AttributeValueType operator()(const LabelObjectType *labelObject) const
+  {
+    return labelObject->GetMinimumFeretDiameter();
+  }
+};
+
+template< typename TLabelObject >
+class ConvexHullPhysicalSizeLabelObjectAccessor
+{
+public:
+  typedef TLabelObject LabelObjectType;
+  typedef double       AttributeValueType;
+
+  inline AttributeValueType operator()(const LabelObjectType *labelObject) const
+  {
+    return labelObject->GetConvexHullPhysicalSize();
+  }
+};
+
 template< typename TLabelObject >
 class PrincipalMomentsLabelObjectAccessor
 {
@@ -19,6 +19,7 @@
 #define itkStatisticsLabelMapFilter_h
 
 #include "itkShapeLabelMapFilter.h"
+#include <vector>
 
 namespace itk
 {
@@ -138,15 +139,58 @@ protected:
 
   virtual void BeforeThreadedGenerateData() ITK_OVERRIDE;
 
+  virtual void ThreadedProcessSplitLabelObjectLines(SizeValueType splitIndex, LabelObjectType *labelObject,
+                                                    SizeValueType beginLine, SizeValueType endLine,
+                                                    ThreadIdType threadId) ITK_OVERRIDE;
+
+  virtual void ThreadedFinalizeSplitLabelObject(SizeValueType splitIndex, LabelObjectType *labelObject) ITK_OVERRIDE;
+
+  virtual void AfterThreadedGenerateData() ITK_OVERRIDE;
+
   void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
 
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(StatisticsLabelMapFilter);
 
+  typedef typename LabelObjectType::HistogramType       HistogramType;
+  typedef typename HistogramType::AbsoluteFrequencyType AbsoluteFrequencyType;
+
+  /** The sums accumulated over the pixels of a label object. */
+  struct StatisticsMomentsType
+  {
+    StatisticsMomentsType();
+    void Merge(const StatisticsMomentsType & other);
+
+    SizeValueType                        m_Count;
+    FeatureImagePixelType                m_Minimum;
+    FeatureImagePixelType                m_Maximum;
+    IndexType                            m_MinimumIndex;
+    IndexType                            m_MaximumIndex;
+    double                               m_Sum;
+    double                               m_Sum2;
+    double                               m_Sum3;
+    double                               m_Sum4;
+    PointType                            m_CenterOfGravity;
+    MatrixType                           m_CentralMoments;
+    std::vector< AbsoluteFrequencyType > m_Frequencies;
+  };
+
+  typename HistogramType::Pointer CreateHistogram() const;
+
+  void AccumulateStatisticsMoments(const LabelObjectType *labelObject, SizeValueType beginLine,
+                                   SizeValueType endLine, StatisticsMomentsType & moments);
+
+  void SetStatisticsAttributes(LabelObjectType *labelObject, const StatisticsMomentsType & moments) const;
+
   FeatureImagePixelType m_Minimum;
   FeatureImagePixelType m_Maximum;
   unsigned int          m_NumberOfBins;
   bool                  m_ComputeHistogram;
+
+  std::vector< StatisticsMomentsType > m_SplitStatisticsMoments;
+
+  // the bins of the histograms, shared read-only by the threads
+  typename HistogramType::Pointer m_BinsHistogram;
 }; // end of class
 } // end namespace itk
 
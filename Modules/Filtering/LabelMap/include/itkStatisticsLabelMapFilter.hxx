@@ -39,6 +39,67 @@ StatisticsLabelMapFilter< TImage, TFeatureImage >
   this->SetNumberOfRequiredInputs(2);
 }
 
+template< typename TImage, typename TFeatureImage >
+StatisticsLabelMapFilter< TImage, TFeatureImage >
+::StatisticsMomentsType::StatisticsMomentsType() :
+  m_Count(0),
+  m_Minimum( NumericTraits< FeatureImagePixelType >::max() ),
+  m_Maximum( NumericTraits< FeatureImagePixelType >::NonpositiveMin() ),
+  m_Sum(0),
+  m_Sum2(0),
+  m_Sum3(0),
+  m_Sum4(0)
+{
+  m_MinimumIndex.Fill(0);
+  m_MaximumIndex.Fill(0);
+  m_CenterOfGravity.Fill(0);
+  m_CentralMoments.Fill(0);
+}
+
+template< typename TImage, typename TFeatureImage >
+void
+StatisticsLabelMapFilter< TImage, TFeatureImage >
+::StatisticsMomentsType::Merge(const StatisticsMomentsType & other)
+{
+  if ( other.m_Count == 0 )
+    {
+    return;
+    }
+  // other comes after this one in the object: keep the last extremum found,
+  // like when the pixels are visited in order
+  if ( other.m_Minimum <= m_Minimum )
+    {
+    m_Minimum = other.m_Minimum;
+    m_MinimumIndex = other.m_MinimumIndex;
+    }
+  if ( other.m_Maximum >= m_Maximum )
+    {
+    m_Maximum = other.m_Maximum;
+    m_MaximumIndex = other.m_MaximumIndex;
+    }
+  m_Count += other.m_Count;
+  m_Sum += other.m_Sum;
+  m_Sum2 += other.m_Sum2;
+  m_Sum3 += other.m_Sum3;
+  m_Sum4 += other.m_Sum4;
+  for ( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    m_CenterOfGravity[i] += other.m_CenterOfGravity[i];
+    }
+  m_CentralMoments += other.m_CentralMoments;
+  if ( m_Frequencies.empty() )
+    {
+    m_Frequencies = other.m_Frequencies;
+    }
+  else
+    {
+    for ( SizeValueType i = 0; i < other.m_Frequencies.size(); i++ )
+      {
+      m_Frequencies[i] += other.m_Frequencies[i];
+      }
+    }
+}
+
 template< typename TImage, typename TFeatureImage >
 void
 StatisticsLabelMapFilter< TImage, TFeatureImage >
@@ -56,6 +117,12 @@ StatisticsLabelMapFilter< TImage, TFeatureImage >
 
   m_Minimum = minMax->GetMinimum();
   m_Maximum = minMax->GetMaximum();
+
+  // the bins are the same for all the label objects
+  m_BinsHistogram = this->CreateHistogram();
+
+  m_SplitStatisticsMoments.assign( this->GetNumberOfSplitLabelObjects() * this->GetNumberOfSplitThreads(),
+                                   StatisticsMomentsType() );
 }
 
 template< typename TImage, typename TFeatureImage >
@@ -65,13 +132,61 @@ StatisticsLabelMapFilter< TImage, TFeatureImage >
 {
   Superclass::ThreadedProcessLabelObject(labelObject);
 
-  ImageType *             output = this->GetOutput();
-  const FeatureImageType *featureImage = this->GetFeatureImage();
+  if ( this->IsSplitLabelObject(labelObject) )
+    {
+    return;
+    }
 
-  typedef typename LabelObjectType::HistogramType HistogramType;
+  StatisticsMomentsType moments;
+  this->AccumulateStatisticsMoments(labelObject, 0, labelObject->GetNumberOfLines(), moments);
+  this->SetStatisticsAttributes(labelObject, moments);
+}
 
-  typename HistogramType::IndexType             histogramIndex(1);
-  typename HistogramType::MeasurementVectorType mv(1);
+template< typename TImage, typename TFeatureImage >
+void
+StatisticsLabelMapFilter< TImage, TFeatureImage >
+::ThreadedProcessSplitLabelObjectLines(SizeValueType splitIndex, LabelObjectType *labelObject,
+                                       SizeValueType beginLine, SizeValueType endLine,
+                                       ThreadIdType threadId)
+{
+  Superclass::ThreadedProcessSplitLabelObjectLines(splitIndex, labelObject, beginLine, endLine, threadId);
+
+  this->AccumulateStatisticsMoments(labelObject, beginLine, endLine,
+                                    m_SplitStatisticsMoments[splitIndex * this->GetNumberOfSplitThreads() + threadId]);
+}
+
+template< typename TImage, typename TFeatureImage >
+void
+StatisticsLabelMapFilter< TImage, TFeatureImage >
+::ThreadedFinalizeSplitLabelObject(SizeValueType splitIndex, LabelObjectType *labelObject)
+{
+  Superclass::ThreadedFinalizeSplitLabelObject(splitIndex, labelObject);
+
+  const ThreadIdType    numberOfThreads = this->GetNumberOfSplitThreads();
+  StatisticsMomentsType moments;
+  for ( ThreadIdType t = 0; t < numberOfThreads; t++ )
+    {
+    moments.Merge( m_SplitStatisticsMoments[splitIndex * numberOfThreads + t] );
+    }
+  this->SetStatisticsAttributes(labelObject, moments);
+}
+
+template< typename TImage, typename TFeatureImage >
+void
+StatisticsLabelMapFilter< TImage, TFeatureImage >
+::AfterThreadedGenerateData()
+{
+  Superclass::AfterThreadedGenerateData();
+
+  m_SplitStatisticsMoments.clear();
+  m_BinsHistogram = ITK_NULLPTR;
+}
+
+template< typename TImage, typename TFeatureImage >
+typename StatisticsLabelMapFilter< TImage, TFeatureImage >::HistogramType::Pointer
+StatisticsLabelMapFilter< TImage, TFeatureImage >
+::CreateHistogram() const
+{
   typename HistogramType::SizeType              histogramSize(1);
   histogramSize.Fill(m_NumberOfBins);
 
@@ -85,74 +200,105 @@ StatisticsLabelMapFilter< TImage, TFeatureImage >
   histogram->SetMeasurementVectorSize(1);
   histogram->SetClipBinsAtEnds(false);
   histogram->Initialize(histogramSize, featureImageMin, featureImageMax);
+  return histogram;
+}
 
-  FeatureImagePixelType min = NumericTraits< FeatureImagePixelType >::max();
-  FeatureImagePixelType max = NumericTraits< FeatureImagePixelType >::NonpositiveMin();
-  double                sum = 0;
-  double                sum2 = 0;
-  double                sum3 = 0;
-  double                sum4 = 0;
-  IndexType             minIdx;
-  minIdx.Fill(0);
-  IndexType maxIdx;
-  maxIdx.Fill(0);
-  PointType centerOfGravity;
-  centerOfGravity.Fill(0);
-  MatrixType centralMoments;
-  centralMoments.Fill(0);
-  MatrixType principalAxes;
-  principalAxes.Fill(0);
-  VectorType principalMoments;
-  principalMoments.Fill(0);
+template< typename TImage, typename TFeatureImage >
+void
+StatisticsLabelMapFilter< TImage, TFeatureImage >
+::AccumulateStatisticsMoments(const LabelObjectType *labelObject, SizeValueType beginLine,
+                              SizeValueType endLine, StatisticsMomentsType & moments)
+{
+  const ImageType *        output = this->GetOutput();
+  const FeatureImageType * featureImage = this->GetFeatureImage();
 
+  // the histogram is only used to find the bins of the values
+  const HistogramType *                         histogram = m_BinsHistogram;
+  typename HistogramType::IndexType             histogramIndex(1);
+  typename HistogramType::MeasurementVectorType mv(1);
+  moments.m_Frequencies.resize(m_NumberOfBins, 0);
 
-  // iterate over all the indexes
-  typename LabelObjectType::ConstIndexIterator it( labelObject );
-  while( ! it.IsAtEnd() )
+  // iterate over all the indexes of the lines
+  for ( SizeValueType l = beginLine; l < endLine; l++ )
     {
-    const IndexType & idx = it.GetIndex();
-    const FeatureImagePixelType & v = featureImage->GetPixel(idx);
-    mv[0] = v;
-    histogram->GetIndex(mv, histogramIndex);
-    histogram->IncreaseFrequencyOfIndex(histogramIndex, 1);
-
-    // update min and max
-    if ( v <= min )
-      {
-      min = v;
-      minIdx = idx;
-      }
-    if ( v >= max )
+    const typename LabelObjectType::LineType & line = labelObject->GetLine(l);
+    IndexType                                  idx = line.GetIndex();
+    const IndexValueType                       endIdx0 = idx[0] + static_cast< IndexValueType >( line.GetLength() );
+    for ( ; idx[0] < endIdx0; idx[0]++ )
       {
-      max = v;
-      maxIdx = idx;
-      }
+      const FeatureImagePixelType & v = featureImage->GetPixel(idx);
+      mv[0] = v;
+      histogram->GetIndex(mv, histogramIndex);
+      moments.m_Frequencies[histogramIndex[0]]++;
 
-    //increase the sums
-    sum += v;
-    sum2 += std::pow( (double)v, 2 );
-    sum3 += std::pow( (double)v, 3 );
-    sum4 += std::pow( (double)v, 4 );
+      // update min and max
+      if ( v <= moments.m_Minimum )
+        {
+        moments.m_Minimum = v;
+        moments.m_MinimumIndex = idx;
+        }
+      if ( v >= moments.m_Maximum )
+        {
+        moments.m_Maximum = v;
+        moments.m_MaximumIndex = idx;
+        }
 
-    // moments
-    PointType physicalPosition;
-    output->TransformIndexToPhysicalPoint(idx, physicalPosition);
-    for ( unsigned int i = 0; i < ImageDimension; i++ )
-      {
-      centerOfGravity[i] += physicalPosition[i] * v;
-      centralMoments[i][i] += v * physicalPosition[i] * physicalPosition[i];
-      for ( unsigned int j = i + 1; j < ImageDimension; j++ )
+      //increase the sums
+      moments.m_Count++;
+      moments.m_Sum += v;
+      moments.m_Sum2 += std::pow( (double)v, 2 );
+      moments.m_Sum3 += std::pow( (double)v, 3 );
+      moments.m_Sum4 += std::pow( (double)v, 4 );
+
+      // moments
+      PointType physicalPosition;
+      output->TransformIndexToPhysicalPoint(idx, physicalPosition);
+      for ( unsigned int i = 0; i < ImageDimension; i++ )
         {
-        double weight = v * physicalPosition[i] * physicalPosition[j];
-        centralMoments[i][j] += weight;
-        centralMoments[j][i] += weight;
+        moments.m_CenterOfGravity[i] += physicalPosition[i] * v;
+        moments.m_CentralMoments[i][i] += v * physicalPosition[i] * physicalPosition[i];
+        for ( unsigned int j = i + 1; j < ImageDimension; j++ )
+          {
+          double weight = v * physicalPosition[i] * physicalPosition[j];
+          moments.m_CentralMoments[i][j] += weight;
+          moments.m_CentralMoments[j][i] += weight;
+          }
         }
       }
-    ++it;
     }
+}
+
+template< typename TImage, typename TFeatureImage >
+void
+StatisticsLabelMapFilter< TImage, TFeatureImage >
+::SetStatisticsAttributes(LabelObjectType *labelObject, const StatisticsMomentsType & moments) const
+{
+  const ImageType * output = this->GetOutput();
+
+  // the histogram of the label object is only created when it is kept
+  typename HistogramType::Pointer histogram;
+  if ( m_ComputeHistogram )
+    {
+    histogram = this->CreateHistogram();
+    for ( SizeValueType i = 0; i < moments.m_Frequencies.size(); i++ )
+      {
+      histogram->SetFrequency(i, moments.m_Frequencies[i]);
+      }
+    }
+
+  const double sum = moments.m_Sum;
+  const double sum2 = moments.m_Sum2;
+  const double sum3 = moments.m_Sum3;
+  const double sum4 = moments.m_Sum4;
+  PointType    centerOfGravity = moments.m_CenterOfGravity;
+  MatrixType   centralMoments = moments.m_CentralMoments;
+  MatrixType   principalAxes;
+  principalAxes.Fill(0);
+  VectorType   principalMoments;
+  principalMoments.Fill(0);
 
   // final computations
-  const typename HistogramType::AbsoluteFrequencyType & totalFreq = histogram->GetTotalFrequency();
+  const AbsoluteFrequencyType totalFreq = moments.m_Count;
   const double mean = sum / totalFreq;
   const double variance = ( sum2 - ( std::pow(sum, 2) / totalFreq ) ) / ( totalFreq - 1 );
   const double sigma = std::sqrt(variance);
@@ -181,13 +327,16 @@ StatisticsLabelMapFilter< TImage, TFeatureImage >
   // the median
   double median = 0;
   double count = 0;  // will not be fully set, so do not use later !
-  for ( SizeValueType i = 0; i < histogram->Size(); i++ )
+  for ( SizeValueType i = 0; i < moments.m_Frequencies.size(); i++ )
     {
-    count += histogram->GetFrequency(i);
+    count += moments.m_Frequencies[i];
 
     if ( count >= ( totalFreq / 2 ) )
       {
-      median = histogram->GetMeasurementVector(i)[0];
+      // the center of the bin, as Histogram::GetMeasurementVector()
+      const typename HistogramType::MeasurementType value =
+        m_BinsHistogram->GetBinMin(0, i) + m_BinsHistogram->GetBinMax(0, i);
+      median = static_cast< typename HistogramType::MeasurementType >( value / 2.0 );
       break;
       }
     }
@@ -278,15 +427,15 @@ StatisticsLabelMapFilter< TImage, TFeatureImage >
     }
 
   // finally put the values in the label object
-  labelObject->SetMinimum( (double)min );
-  labelObject->SetMaximum( (double)max );
+  labelObject->SetMinimum( (double)moments.m_Minimum );
+  labelObject->SetMaximum( (double)moments.m_Maximum );
   labelObject->SetSum(sum);
   labelObject->SetMean(mean);
   labelObject->SetMedian(median);
   labelObject->SetVariance(variance);
   labelObject->SetStandardDeviation(sigma);
-  labelObject->SetMinimumIndex(minIdx);
-  labelObject->SetMaximumIndex(maxIdx);
+  labelObject->SetMinimumIndex(moments.m_MinimumIndex);
+  labelObject->SetMaximumIndex(moments.m_MaximumIndex);
   labelObject->SetCenterOfGravity(centerOfGravity);
   labelObject->SetWeightedPrincipalAxes(principalAxes);
   labelObject->SetWeightedFlatness(flatness);
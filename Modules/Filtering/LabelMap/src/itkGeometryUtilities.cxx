@@ -17,6 +17,736 @@
  *=========================================================================*/
 #include "itkGeometryUtilities.h"
 #include "itkMath.h"
+#include "itkNumericTraits.h"
+#include <algorithm>
+
+namespace
+{
+typedef itk::OffsetValueType CoordinateType;
+
+/** A point with integer coordinates, in up to 3 dimensions. The unused
+ * coordinates are null. */
+struct HullPoint
+{
+  CoordinateType m_X[3];
+
+  bool operator<(const HullPoint & other) const
+  {
+    for ( unsigned int i = 0; i < 3; ++i )
+      {
+      if ( m_X[i] != other.m_X[i] )
+        {
+        return m_X[i] < other.m_X[i];
+        }
+      }
+    return false;
+  }
+
+  bool operator==(const HullPoint & other) const
+  {
+    return m_X[0] == other.m_X[0] && m_X[1] == other.m_X[1] && m_X[2] == other.m_X[2];
+  }
+};
+
+typedef std::vector< HullPoint > HullPointContainer;
+typedef std::vector< size_t >    HullIndexContainer;
+
+/** A triangular face of a 3D convex hull. The vertices are ordered
+ * counterclockwise when seen from the outside, and m_Neighbors[k] is the
+ * face on the other side of the edge (m_Vertices[k], m_Vertices[k+1]). The
+ * points of m_Outside are above the face and not yet in the hull. */
+struct HullFace
+{
+  size_t             m_Vertices[3];
+  size_t             m_Neighbors[3];
+  bool               m_Alive;
+  HullIndexContainer m_Outside;
+  size_t             m_Furthest;
+  CoordinateType     m_FurthestDistance;
+  size_t             m_Stamp;
+  bool               m_Visible;
+};
+
+typedef std::vector< HullFace > HullFaceContainer;
+
+/** Twice the signed area of the triangle (a, b, c) projected on the
+ * coordinates u and v. */
+inline CoordinateType
+Cross2D(const HullPoint & a, const HullPoint & b, const HullPoint & c, unsigned int u, unsigned int v)
+{
+  return ( b.m_X[u] - a.m_X[u] ) * ( c.m_X[v] - a.m_X[v] )
+         - ( b.m_X[v] - a.m_X[v] ) * ( c.m_X[u] - a.m_X[u] );
+}
+
+/** Six times the signed volume of the tetrahedron (a, b, c, d). It is
+ * positive when d is above the triangle (a, b, c), seen counterclockwise. */
+inline CoordinateType
+Orientation(const HullPoint & a, const HullPoint & b, const HullPoint & c, const HullPoint & d)
+{
+  const CoordinateType bx = b.m_X[0] - a.m_X[0];
+  const CoordinateType by = b.m_X[1] - a.m_X[1];
+  const CoordinateType bz = b.m_X[2] - a.m_X[2];
+  const CoordinateType cx = c.m_X[0] - a.m_X[0];
+  const CoordinateType cy = c.m_X[1] - a.m_X[1];
+  const CoordinateType cz = c.m_X[2] - a.m_X[2];
+  const CoordinateType dx = d.m_X[0] - a.m_X[0];
+  const CoordinateType dy = d.m_X[1] - a.m_X[1];
+  const CoordinateType dz = d.m_X[2] - a.m_X[2];
+
+  return bx * ( cy * dz - cz * dy ) - by * ( cx * dz - cz * dx ) + bz * ( cx * dy - cy * dx );
+}
+
+inline CoordinateType
+Orientation(const HullPointContainer & points, const HullFace & face, size_t d)
+{
+  return Orientation(points[face.m_Vertices[0]], points[face.m_Vertices[1]],
+                     points[face.m_Vertices[2]], points[d]);
+}
+
+inline double
+SquaredPhysicalDistance(const HullPoint & a, const HullPoint & b, const double *spacing, unsigned int dim)
+{
+  double distance = 0;
+  for ( unsigned int i = 0; i < dim; ++i )
+    {
+    const double difference = ( a.m_X[i] - b.m_X[i] ) * spacing[i];
+    distance += difference * difference;
+    }
+  return distance;
+}
+
+/** Orders the points on their coordinates u and v. */
+class ProjectedPointCompare
+{
+public:
+  ProjectedPointCompare(const HullPointContainer & points, unsigned int u, unsigned int v) :
+    m_Points(&points), m_U(u), m_V(v) {}
+
+  bool operator()(size_t a, size_t b) const
+  {
+    const HullPoint & pa = ( *m_Points )[a];
+    const HullPoint & pb = ( *m_Points )[b];
+    if ( pa.m_X[m_U] != pb.m_X[m_U] )
+      {
+      return pa.m_X[m_U] < pb.m_X[m_U];
+      }
+    return pa.m_X[m_V] < pb.m_X[m_V];
+  }
+
+private:
+  const HullPointContainer *m_Points;
+  unsigned int              m_U;
+  unsigned int              m_V;
+};
+
+/** Andrew's monotone chain: the vertices of the convex hull of the points
+ * projected on the coordinates u and v, counterclockwise, without the
+ * collinear points. The projection must be injective. */
+void
+MonotoneChain(const HullPointContainer & points, unsigned int u, unsigned int v, HullIndexContainer & hull)
+{
+  const size_t       n = points.size();
+  HullIndexContainer order(n);
+  for ( size_t i = 0; i < n; ++i )
+    {
+    order[i] = i;
+    }
+  std::sort( order.begin(), order.end(), ProjectedPointCompare(points, u, v) );
+
+  if ( n < 3 )
+    {
+    hull = order;
+    return;
+    }
+
+  hull.assign(2 * n, 0);
+  size_t k = 0;
+  for ( size_t i = 0; i < n; ++i )
+    {
+    while ( k >= 2 && Cross2D(points[hull[k - 2]], points[hull[k - 1]], points[order[i]], u, v) <= 0 )
+      {
+      --k;
+      }
+    hull[k++] = order[i];
+    }
+  for ( size_t i = n - 1, t = k + 1; i > 0; --i )
+    {
+    while ( k >= t && Cross2D(points[hull[k - 2]], points[hull[k - 1]], points[order[i - 1]], u, v) <= 0 )
+      {
+      --k;
+      }
+    hull[k++] = order[i - 1];
+    }
+  hull.resize(k - 1);
+}
+
+/** Maximum distance between the vertices of a hull, by brute force. */
+double
+MaximumDistance(const HullPointContainer & points, const HullIndexContainer & vertices,
+                const double *spacing, unsigned int dim)
+{
+  double maximum = 0;
+  for ( size_t i = 0; i < vertices.size(); ++i )
+    {
+    for ( size_t j = i + 1; j < vertices.size(); ++j )
+      {
+      maximum = std::max( maximum, SquaredPhysicalDistance(points[vertices[i]], points[vertices[j]], spacing, dim) );
+      }
+    }
+  return std::sqrt(maximum);
+}
+
+void
+FeretDiameters2D(const HullPointContainer & points, const double *spacing,
+                 double & maximumFeretDiameter, double & minimumFeretDiameter, double & convexHullSize)
+{
+  HullIndexContainer hull;
+  MonotoneChain(points, 0, 1, hull);
+
+  const size_t n = hull.size();
+  if ( n < 3 )
+    {
+    // a point or a segment
+    maximumFeretDiameter = MaximumDistance(points, hull, spacing, 2);
+    return;
+    }
+
+  // the area of the polygon, exactly
+  CoordinateType area = 0;
+  for ( size_t i = 1; i + 1 < n; ++i )
+    {
+    area += Cross2D(points[hull[0]], points[hull[i]], points[hull[i + 1]], 0, 1);
+    }
+  const double pixelArea = spacing[0] * spacing[1];
+  convexHullSize = 0.5 * area * pixelArea;
+
+  // Rotating calipers: for each edge, find the farthest vertex. Its
+  // distance to the edge is the width of the polygon in the direction
+  // normal to the edge, and the pairs made of this vertex and of the ends
+  // of the edge are the antipodal pairs, among which is the diameter.
+  // The scaling by the spacing preserves the ratios of the areas, so the
+  // farthest vertex can be searched with the exact integer areas.
+  double maximum = 0;
+  double minimum = itk::NumericTraits< double >::max();
+  size_t j = 1;
+  for ( size_t i = 0; i < n; ++i )
+    {
+    const HullPoint & a = points[hull[i]];
+    const HullPoint & b = points[hull[( i + 1 ) % n]];
+    while ( Cross2D(a, b, points[hull[( j + 1 ) % n]], 0, 1) > Cross2D(a, b, points[hull[j]], 0, 1) )
+      {
+      j = ( j + 1 ) % n;
+      }
+    const HullPoint & c = points[hull[j]];
+    const double      width = Cross2D(a, b, c, 0, 1) * pixelArea
+                              / std::sqrt( SquaredPhysicalDistance(a, b, spacing, 2) );
+    minimum = std::min(minimum, width);
+    maximum = std::max( maximum, SquaredPhysicalDistance(a, c, spacing, 2) );
+    maximum = std::max( maximum, SquaredPhysicalDistance(b, c, spacing, 2) );
+    }
+  maximumFeretDiameter = std::sqrt(maximum);
+  minimumFeretDiameter = minimum;
+}
+
+void
+AddHullPoint(HullFace & face, size_t point, CoordinateType distance)
+{
+  if ( face.m_Outside.empty() || distance > face.m_FurthestDistance )
+    {
+    face.m_Furthest = point;
+    face.m_FurthestDistance = distance;
+    }
+  face.m_Outside.push_back(point);
+}
+
+size_t
+AddHullFace(HullFaceContainer & faces, size_t a, size_t b, size_t c)
+{
+  HullFace face;
+  face.m_Vertices[0] = a;
+  face.m_Vertices[1] = b;
+  face.m_Vertices[2] = c;
+  face.m_Neighbors[0] = face.m_Neighbors[1] = face.m_Neighbors[2] = 0;
+  face.m_Alive = true;
+  face.m_Furthest = 0;
+  face.m_FurthestDistance = 0;
+  face.m_Stamp = 0;
+  face.m_Visible = false;
+  faces.push_back(face);
+  return faces.size() - 1;
+}
+
+/** Quickhull, from the tetrahedron (i0, i1, i2, i3) which must not be flat.
+ * The points strictly above a face are the only ones considered outside,
+ * so the points on the hull which are not vertices are dropped. */
+void
+QuickHull3D(const HullPointContainer & points, size_t i0, size_t i1, size_t i2, size_t i3,
+            HullFaceContainer & faces)
+{
+  const size_t tetrahedron[4][4] = { { i0, i1, i2, i3 }, { i0, i1, i3, i2 },
+                                     { i0, i2, i3, i1 }, { i1, i2, i3, i0 } };
+  for ( unsigned int f = 0; f < 4; ++f )
+    {
+    if ( Orientation(points[tetrahedron[f][0]], points[tetrahedron[f][1]],
+                     points[tetrahedron[f][2]], points[tetrahedron[f][3]]) > 0 )
+      {
+      AddHullFace(faces, tetrahedron[f][0], tetrahedron[f][2], tetrahedron[f][1]);
+      }
+    else
+      {
+      AddHullFace(faces, tetrahedron[f][0], tetrahedron[f][1], tetrahedron[f][2]);
+      }
+    }
+  for ( size_t f = 0; f < 4; ++f )
+    {
+    for ( unsigned int k = 0; k < 3; ++k )
+      {
+      const size_t a = faces[f].m_Vertices[k];
+      const size_t b = faces[f].m_Vertices[( k + 1 ) % 3];
+      for ( size_t g = 0; g < 4; ++g )
+        {
+        for ( unsigned int l = 0; l < 3; ++l )
+          {
+          if ( faces[g].m_Vertices[l] == b && faces[g].m_Vertices[( l + 1 ) % 3] == a )
+            {
+            faces[f].m_Neighbors[k] = g;
+            }
+          }
+        }
+      }
+    }
+
+  for ( size_t p = 0; p < points.size(); ++p )
+    {
+    if ( p == i0 || p == i1 || p == i2 || p == i3 )
+      {
+      continue;
+      }
+    for ( size_t f = 0; f < 4; ++f )
+      {
+      const CoordinateType distance = Orientation(points, faces[f], p);
+      if ( distance > 0 )
+        {
+        AddHullPoint(faces[f], p, distance);
+        break;
+        }
+      }
+    }
+
+  HullIndexContainer pending;
+  for ( size_t f = 0; f < 4; ++f )
+    {
+    pending.push_back(f);
+    }
+
+  typedef std::vector< std::pair< size_t, unsigned int > > HorizonType;
+  HullIndexContainer visible;
+  HorizonType        horizon;
+  HullIndexContainer newFaces;
+  HullIndexContainer startingAt( points.size() );
+  HullIndexContainer endingAt( points.size() );
+  size_t             stamp = 0;
+  while ( !pending.empty() )
+    {
+    const size_t current = pending.back();
+    pending.pop_back();
+    if ( !faces[current].m_Alive || faces[current].m_Outside.empty() )
+      {
+      continue;
+      }
+    const size_t eye = faces[current].m_Furthest;
+
+    // Find the faces visible from the new point, and the horizon: the
+    // edges between the visible and the hidden faces.
+    ++stamp;
+    visible.clear();
+    horizon.clear();
+    visible.push_back(current);
+    faces[current].m_Stamp = stamp;
+    faces[current].m_Visible = true;
+    for ( size_t v = 0; v < visible.size(); ++v )
+      {
+      const size_t face = visible[v];
+      for ( unsigned int k = 0; k < 3; ++k )
+        {
+        const size_t neighbor = faces[face].m_Neighbors[k];
+        if ( faces[neighbor].m_Stamp != stamp )
+          {
+          faces[neighbor].m_Stamp = stamp;
+          faces[neighbor].m_Visible = Orientation(points, faces[neighbor], eye) > 0;
+          if ( faces[neighbor].m_Visible )
+            {
+            visible.push_back(neighbor);
+            }
+          }
+        if ( !faces[neighbor].m_Visible )
+          {
+          horizon.push_back( std::make_pair(face, k) );
+          }
+        }
+      }
+
+    // Build a cone of new faces from the horizon to the new point
+    newFaces.clear();
+    for ( size_t h = 0; h < horizon.size(); ++h )
+      {
+      const size_t       face = horizon[h].first;
+      const unsigned int k = horizon[h].second;
+      const size_t       a = faces[face].m_Vertices[k];
+      const size_t       b = faces[face].m_Vertices[( k + 1 ) % 3];
+      const size_t       neighbor = faces[face].m_Neighbors[k];
+      const size_t       newFace = AddHullFace(faces, a, b, eye);
+      faces[newFace].m_Neighbors[0] = neighbor;
+      for ( unsigned int l = 0; l < 3; ++l )
+        {
+        if ( faces[neighbor].m_Vertices[l] == b && faces[neighbor].m_Vertices[( l + 1 ) % 3] == a )
+          {
+          faces[neighbor].m_Neighbors[l] = newFace;
+          }
+        }
+      startingAt[a] = newFace;
+      endingAt[b] = newFace;
+      newFaces.push_back(newFace);
+      }
+    for ( size_t n = 0; n < newFaces.size(); ++n )
+      {
+      HullFace & face = faces[newFaces[n]];
+      face.m_Neighbors[1] = startingAt[face.m_Vertices[1]];
+      face.m_Neighbors[2] = endingAt[face.m_Vertices[0]];
+      }
+
+    // Give the points outside of the removed faces to the new faces
+    for ( size_t v = 0; v < visible.size(); ++v )
+      {
+      HullFace & face = faces[visible[v]];
+      face.m_Alive = false;
+      for ( size_t o = 0; o < face.m_Outside.size(); ++o )
+        {
+        const size_t p = face.m_Outside[o];
+        if ( p == eye )
+          {
+          continue;
+          }
+        for ( size_t n = 0; n < newFaces.size(); ++n )
+          {
+          const CoordinateType distance = Orientation(points, faces[newFaces[n]], p);
+          if ( distance > 0 )
+            {
+            AddHullPoint(faces[newFaces[n]], p, distance);
+            break;
+            }
+          }
+        }
+      HullIndexContainer().swap(face.m_Outside);
+      }
+    for ( size_t n = 0; n < newFaces.size(); ++n )
+      {
+      if ( !faces[newFaces[n]].m_Outside.empty() )
+        {
+        pending.push_back(newFaces[n]);
+        }
+      }
+    }
+}
+
+/** An edge (m_A, m_B) of a 3D convex hull, with the third vertices of its
+ * two faces. */
+struct HullEdge
+{
+  size_t m_A;
+  size_t m_B;
+  size_t m_C[2];
+  // the arc of the directions normal to the supporting planes of the edge,
+  // as its middle direction and the cosine and sine of its half angle
+  double m_Normal[3];
+  double m_Cos;
+  double m_Sin;
+};
+
+/** The unit normal of a face, in index coordinates. */
+void
+UnitFaceNormal(const HullPointContainer & points, const HullFace & face, double *normal)
+{
+  const HullPoint & a = points[face.m_Vertices[0]];
+  const HullPoint & b = points[face.m_Vertices[1]];
+  const HullPoint & c = points[face.m_Vertices[2]];
+  double            norm = 0;
+  for ( unsigned int i = 0; i < 3; ++i )
+    {
+    const unsigned int u = ( i + 1 ) % 3;
+    const unsigned int v = ( i + 2 ) % 3;
+    normal[i] = static_cast< double >( Cross2D(a, b, c, u, v) );
+    norm += normal[i] * normal[i];
+    }
+  norm = std::sqrt(norm);
+  for ( unsigned int i = 0; i < 3; ++i )
+    {
+    normal[i] /= norm;
+    }
+}
+
+inline int
+Sign(CoordinateType value)
+{
+  return ( value > 0 ) - ( value < 0 );
+}
+
+/** The side of the plane containing the edge and the direction, normal to
+ * the plane, where the hull is: 1 or -1, or 0 if the plane cuts the hull
+ * or contains one of the faces of the edge. */
+int
+SupportingSide(const HullPointContainer & points, const HullEdge & edge, const CoordinateType *direction)
+{
+  const HullPoint & a = points[edge.m_A];
+  int               sides[2];
+  for ( unsigned int c = 0; c < 2; ++c )
+    {
+    const HullPoint & p = points[edge.m_C[c]];
+    sides[c] = Sign( direction[0] * ( p.m_X[0] - a.m_X[0] ) + direction[1] * ( p.m_X[1] - a.m_X[1] )
+                     + direction[2] * ( p.m_X[2] - a.m_X[2] ) );
+    }
+  return sides[0] == sides[1] ? sides[0] : 0;
+}
+
+void
+FeretDiameters3D(const HullPointContainer & points, const double *spacing,
+                 double & maximumFeretDiameter, double & minimumFeretDiameter, double & convexHullSize)
+{
+  // Find a non flat tetrahedron. The points are sorted, so the first one is
+  // an extremity of the set.
+  const size_t   i0 = 0;
+  size_t         i1 = 0;
+  CoordinateType bestDistance = 0;
+  for ( size_t p = 1; p < points.size(); ++p )
+    {
+    CoordinateType distance = 0;
+    for ( unsigned int i = 0; i < 3; ++i )
+      {
+      const CoordinateType difference = points[p].m_X[i] - points[i0].m_X[i];
+      distance += difference * difference;
+      }
+    if ( distance > bestDistance )
+      {
+      bestDistance = distance;
+      i1 = p;
+      }
+    }
+  if ( i1 == i0 )
+    {
+    // a single point
+    return;
+    }
+
+  size_t         i2 = i0;
+  double         bestArea = 0;
+  CoordinateType normal[3] = { 0, 0, 0 };
+  for ( size_t p = 1; p < points.size(); ++p )
+    {
+    CoordinateType cross[3];
+    double         area = 0;
+    for ( unsigned int i = 0; i < 3; ++i )
+      {
+      const unsigned int u = ( i + 1 ) % 3;
+      const unsigned int v = ( i + 2 ) % 3;
+      cross[i] = Cross2D(points[i0], points[i1], points[p], u, v);
+      area += static_cast< double >( cross[i] ) * static_cast< double >( cross[i] );
+      }
+    if ( area > bestArea )
+      {
+      bestArea = area;
+      i2 = p;
+      std::copy(cross, cross + 3, normal);
+      }
+    }
+  if ( i2 == i0 )
+    {
+    // all the points are on a line
+    maximumFeretDiameter = std::sqrt( SquaredPhysicalDistance(points[i0], points[i1], spacing, 3) );
+    return;
+    }
+
+  size_t         i3 = i0;
+  CoordinateType bestVolume = 0;
+  for ( size_t p = 1; p < points.size(); ++p )
+    {
+    const CoordinateType volume = itk::Math::abs( Orientation(points[i0], points[i1], points[i2], points[p]) );
+    if ( volume > bestVolume )
+      {
+      bestVolume = volume;
+      i3 = p;
+      }
+    }
+  if ( i3 == i0 )
+    {
+    // all the points are in a plane: compute the hull in the projection on
+    // the coordinate plane the most parallel to it
+    unsigned int w = 0;
+    for ( unsigned int i = 1; i < 3; ++i )
+      {
+      if ( itk::Math::abs(normal[i]) > itk::Math::abs(normal[w]) )
+        {
+        w = i;
+        }
+      }
+    HullIndexContainer hull;
+    MonotoneChain(points, ( w + 1 ) % 3, ( w + 2 ) % 3, hull);
+    maximumFeretDiameter = MaximumDistance(points, hull, spacing, 3);
+    return;
+    }
+
+  HullFaceContainer faces;
+  QuickHull3D(points, i0, i1, i2, i3, faces);
+
+  HullIndexContainer vertices;
+  CoordinateType     volume = 0;
+  for ( size_t f = 0; f < faces.size(); ++f )
+    {
+    if ( faces[f].m_Alive )
+      {
+      vertices.insert(vertices.end(), faces[f].m_Vertices, faces[f].m_Vertices + 3);
+      volume -= Orientation(points, faces[f], i0);
+      }
+    }
+  std::sort( vertices.begin(), vertices.end() );
+  vertices.erase( std::unique( vertices.begin(), vertices.end() ), vertices.end() );
+
+  convexHullSize = volume / 6.0 * spacing[0] * spacing[1] * spacing[2];
+  maximumFeretDiameter = MaximumDistance(points, vertices, spacing, 3);
+
+  // The width in the direction normal to each face
+  double minimum = itk::NumericTraits< double >::max();
+  for ( size_t f = 0; f < faces.size(); ++f )
+    {
+    if ( !faces[f].m_Alive )
+      {
+      continue;
+      }
+    double edge1[3];
+    double edge2[3];
+    double origin[3];
+    for ( unsigned int i = 0; i < 3; ++i )
+      {
+      origin[i] = points[faces[f].m_Vertices[0]].m_X[i] * spacing[i];
+      edge1[i] = points[faces[f].m_Vertices[1]].m_X[i] * spacing[i] - origin[i];
+      edge2[i] = points[faces[f].m_Vertices[2]].m_X[i] * spacing[i] - origin[i];
+      }
+    double faceNormal[3];
+    faceNormal[0] = edge1[1] * edge2[2] - edge1[2] * edge2[1];
+    faceNormal[1] = edge1[2] * edge2[0] - edge1[0] * edge2[2];
+    faceNormal[2] = edge1[0] * edge2[1] - edge1[1] * edge2[0];
+    const double norm = std::sqrt( faceNormal[0] * faceNormal[0] + faceNormal[1] * faceNormal[1]
+                                   + faceNormal[2] * faceNormal[2] );
+    double width = 0;
+    for ( size_t v = 0; v < vertices.size(); ++v )
+      {
+      double height = 0;
+      for ( unsigned int i = 0; i < 3; ++i )
+        {
+        height -= ( points[vertices[v]].m_X[i] * spacing[i] - origin[i] ) * faceNormal[i];
+        }
+      width = std::max(width, height);
+      }
+    minimum = std::min(minimum, width / norm);
+    }
+
+  // The width in the directions normal to two edges, when these edges are
+  // antipodal: the hull is between the parallel planes containing them.
+  // The antipodal pairs are found with the index coordinates, as they are
+  // preserved by the scaling by the spacing.
+  std::vector< HullEdge > edges;
+  for ( size_t f = 0; f < faces.size(); ++f )
+    {
+    if ( !faces[f].m_Alive )
+      {
+      continue;
+      }
+    for ( unsigned int k = 0; k < 3; ++k )
+      {
+      const size_t neighbor = faces[f].m_Neighbors[k];
+      if ( f < neighbor )
+        {
+        HullEdge edge;
+        edge.m_A = faces[f].m_Vertices[k];
+        edge.m_B = faces[f].m_Vertices[( k + 1 ) % 3];
+        edge.m_C[0] = faces[f].m_Vertices[( k + 2 ) % 3];
+        edge.m_C[1] = faces[neighbor].m_Vertices[0] + faces[neighbor].m_Vertices[1]
+                      + faces[neighbor].m_Vertices[2] - edge.m_A - edge.m_B;
+        double normal1[3];
+        double normal2[3];
+        UnitFaceNormal(points, faces[f], normal1);
+        UnitFaceNormal(points, faces[neighbor], normal2);
+        double norm = 0;
+        for ( unsigned int i = 0; i < 3; ++i )
+          {
+          edge.m_Normal[i] = normal1[i] + normal2[i];
+          norm += edge.m_Normal[i] * edge.m_Normal[i];
+          }
+        norm = std::sqrt(norm);
+        for ( unsigned int i = 0; i < 3; ++i )
+          {
+          edge.m_Normal[i] /= norm;
+          }
+        edge.m_Cos = 0.5 * norm;
+        edge.m_Sin = std::sqrt( std::max(0.0, 1.0 - edge.m_Cos * edge.m_Cos) );
+        edges.push_back(edge);
+        }
+      }
+    }
+  for ( size_t e1 = 0; e1 < edges.size(); ++e1 )
+    {
+    const HullPoint & a1 = points[edges[e1].m_A];
+    const HullPoint & b1 = points[edges[e1].m_B];
+    for ( size_t e2 = e1 + 1; e2 < edges.size(); ++e2 )
+      {
+      // The arcs of antipodal edges intersect once one of them is
+      // reversed: skip the pairs of arcs too far from each other.
+      const double angle = -( edges[e1].m_Normal[0] * edges[e2].m_Normal[0]
+                              + edges[e1].m_Normal[1] * edges[e2].m_Normal[1]
+                              + edges[e1].m_Normal[2] * edges[e2].m_Normal[2] );
+      if ( angle < edges[e1].m_Cos * edges[e2].m_Cos - edges[e1].m_Sin * edges[e2].m_Sin - 1e-6 )
+        {
+        continue;
+        }
+      const HullPoint & a2 = points[edges[e2].m_A];
+      const HullPoint & b2 = points[edges[e2].m_B];
+      CoordinateType    direction[3];
+      for ( unsigned int i = 0; i < 3; ++i )
+        {
+        const unsigned int u = ( i + 1 ) % 3;
+        const unsigned int v = ( i + 2 ) % 3;
+        direction[i] = ( b1.m_X[u] - a1.m_X[u] ) * ( b2.m_X[v] - a2.m_X[v] )
+                       - ( b1.m_X[v] - a1.m_X[v] ) * ( b2.m_X[u] - a2.m_X[u] );
+        }
+      if ( direction[0] == 0 && direction[1] == 0 && direction[2] == 0 )
+        {
+        continue;
+        }
+      const int side1 = SupportingSide(points, edges[e1], direction);
+      if ( side1 == 0 )
+        {
+        continue;
+        }
+      if ( SupportingSide(points, edges[e2], direction) != -side1 )
+        {
+        continue;
+        }
+      double physicalDirection[3];
+      double norm = 0;
+      double height = 0;
+      for ( unsigned int i = 0; i < 3; ++i )
+        {
+        const unsigned int u = ( i + 1 ) % 3;
+        const unsigned int v = ( i + 2 ) % 3;
+        physicalDirection[i] = direction[i] * spacing[u] * spacing[v];
+        norm += physicalDirection[i] * physicalDirection[i];
+        height += physicalDirection[i] * ( a2.m_X[i] - a1.m_X[i] ) * spacing[i];
+        }
+      minimum = std::min( minimum, itk::Math::abs(height) / std::sqrt(norm) );
+      }
+    }
+  minimumFeretDiameter = minimum;
+}
+} // end anonymous namespace
 
 namespace itk
 {
@@ -82,4 +812,73 @@ GeometryUtilities
   return std::pow(volume * GammaN2p1(dim) / std::pow(itk::Math::pi, dim * 0.5), 1.0 / dim);
 }
 
+void
+GeometryUtilities
+::ConvexHullFeretDiameters(const unsigned int dim,
+                           const std::vector< OffsetValueType > & points,
+                           const double *spacing,
+                           double & maximumFeretDiameter,
+                           double & minimumFeretDiameter,
+                           double & convexHullSize)
+{
+  maximumFeretDiameter = 0;
+  minimumFeretDiameter = 0;
+  convexHullSize = 0;
+  if ( dim == 0 )
+    {
+    return;
+    }
+  const size_t numberOfPoints = points.size() / dim;
+
+  if ( dim > 3 )
+    {
+    double maximum = 0;
+    for ( size_t p = 0; p < numberOfPoints; ++p )
+      {
+      for ( size_t q = p + 1; q < numberOfPoints; ++q )
+        {
+        double distance = 0;
+        for ( unsigned int i = 0; i < dim; ++i )
+          {
+          const double difference = ( points[p * dim + i] - points[q * dim + i] ) * spacing[i];
+          distance += difference * difference;
+          }
+        maximum = std::max(maximum, distance);
+        }
+      }
+    maximumFeretDiameter = std::sqrt(maximum);
+    return;
+    }
+
+  HullPointContainer hullPoints(numberOfPoints);
+  for ( size_t p = 0; p < numberOfPoints; ++p )
+    {
+    for ( unsigned int i = 0; i < 3; ++i )
+      {
+      hullPoints[p].m_X[i] = i < dim ? points[p * dim + i] : 0;
+      }
+    }
+  std::sort( hullPoints.begin(), hullPoints.end() );
+  hullPoints.erase( std::unique( hullPoints.begin(), hullPoints.end() ), hullPoints.end() );
+  if ( hullPoints.size() < 2 )
+    {
+    return;
+    }
+
+  if ( dim == 1 )
+    {
+    maximumFeretDiameter = ( hullPoints.back().m_X[0] - hullPoints.front().m_X[0] ) * spacing[0];
+    minimumFeretDiameter = maximumFeretDiameter;
+    convexHullSize = maximumFeretDiameter;
+    }
+  else if ( dim == 2 )
+    {
+    FeretDiameters2D(hullPoints, spacing, maximumFeretDiameter, minimumFeretDiameter, convexHullSize);
+    }
+  else
+    {
+    FeretDiameters3D(hullPoints, spacing, maximumFeretDiameter, minimumFeretDiameter, convexHullSize);
+    }
+}
+
 } // end of itk namespace
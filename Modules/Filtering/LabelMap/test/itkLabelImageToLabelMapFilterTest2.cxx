@@ -0,0 +1,126 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkLabelImageToLabelMapFilter.h"
+#include "itkLabelMapToLabelImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkTestingMacros.h"
+
+// Convert an image with many labels with several threads, and check that
+// the label objects have the same lines, in the same order, as with a
+// single thread, and that the label image can be restored.
+int itkLabelImageToLabelMapFilterTest2(int, char* [] )
+{
+  const unsigned int Dimension = 3;
+
+  typedef unsigned short                                  PixelType;
+  typedef itk::Image< PixelType, Dimension >              ImageType;
+  typedef itk::LabelObject< PixelType, Dimension >        LabelObjectType;
+  typedef itk::LabelMap< LabelObjectType >                LabelMapType;
+
+  typedef itk::LabelImageToLabelMapFilter< ImageType, LabelMapType > ConverterType;
+  typedef itk::LabelMapToLabelImageFilter< LabelMapType, ImageType > InverseConverterType;
+
+  ImageType::SizeType size;
+  size[0] = 31;
+  size[1] = 23;
+  size[2] = 17;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+
+  unsigned int seed = 2017;
+  itk::ImageRegionIterator< ImageType > it( image, image->GetLargestPossibleRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    seed = seed * 1103515245u + 12345u;
+    // short runs of 300 different labels, and some background
+    if ( ( seed >> 16 ) % 3 != 0 || it.GetIndex()[0] == 0 )
+      {
+      seed = seed * 1103515245u + 12345u;
+      it.Set( static_cast< PixelType >( 1 + ( seed >> 16 ) % 300 ) );
+      }
+    else
+      {
+      it.Set( 0 );
+      }
+    }
+
+  ConverterType::Pointer reference = ConverterType::New();
+  reference->SetInput( image );
+  reference->SetBackgroundValue( 0 );
+  reference->SetNumberOfThreads( 1 );
+  TRY_EXPECT_NO_EXCEPTION( reference->Update() );
+
+  ConverterType::Pointer converter = ConverterType::New();
+  converter->SetInput( image );
+  converter->SetBackgroundValue( 0 );
+  converter->SetNumberOfThreads( 7 );
+  TRY_EXPECT_NO_EXCEPTION( converter->Update() );
+
+  const LabelMapType * referenceMap = reference->GetOutput();
+  const LabelMapType * map = converter->GetOutput();
+  TEST_EXPECT_EQUAL( referenceMap->GetNumberOfLabelObjects(), map->GetNumberOfLabelObjects() );
+
+  LabelMapType::ConstIterator rit( referenceMap );
+  LabelMapType::ConstIterator mit( map );
+  for ( ; !rit.IsAtEnd(); ++rit, ++mit )
+    {
+    const LabelObjectType * ro = rit.GetLabelObject();
+    const LabelObjectType * mo = mit.GetLabelObject();
+    TEST_EXPECT_EQUAL( ro->GetLabel(), mo->GetLabel() );
+    TEST_EXPECT_EQUAL( ro->GetNumberOfLines(), mo->GetNumberOfLines() );
+    for ( itk::SizeValueType i = 0; i < ro->GetNumberOfLines(); ++i )
+      {
+      if ( ro->GetLine( i ).GetIndex() != mo->GetLine( i ).GetIndex()
+           || ro->GetLine( i ).GetLength() != mo->GetLine( i ).GetLength() )
+        {
+        std::cerr << "Label " << ro->GetLabel() << ": line " << i << " differs" << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  InverseConverterType::Pointer inverse = InverseConverterType::New();
+  inverse->SetInput( converter->GetOutput() );
+  TRY_EXPECT_NO_EXCEPTION( inverse->Update() );
+
+  itk::ImageRegionConstIterator< ImageType > oit( inverse->GetOutput(), image->GetLargestPossibleRegion() );
+  for ( it.GoToBegin(), oit.GoToBegin(); !it.IsAtEnd(); ++it, ++oit )
+    {
+    if ( it.Get() != oit.Get() )
+      {
+      std::cerr << "The restored label image differs at " << it.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  // the lines of an object can be reserved before they are added
+  LabelObjectType::Pointer labelObject = LabelObjectType::New();
+  labelObject->ReserveLines( 10 );
+  TEST_EXPECT_EQUAL( labelObject->GetNumberOfLines(), 0 );
+  LabelObjectType::IndexType idx;
+  idx.Fill( 3 );
+  labelObject->AddLine( idx, 4 );
+  labelObject->ReserveLines( 0 );
+  TEST_EXPECT_EQUAL( labelObject->GetNumberOfLines(), 1 );
+  TEST_EXPECT_EQUAL( labelObject->Size(), 4 );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,290 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkLabelImageToShapeLabelMapFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+// The maximum and, in 2D, the minimum Feret diameters of the pixels with
+// the given label, by brute force.
+template< typename TImage >
+void
+BruteForceFeretDiameters(const TImage * image, typename TImage::PixelType label,
+                         double & maximum, double & minimum)
+{
+  const unsigned int Dimension = TImage::ImageDimension;
+  typedef typename TImage::PointType PointType;
+
+  std::vector< PointType > points;
+  itk::ImageRegionConstIteratorWithIndex< TImage > it( image, image->GetLargestPossibleRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    if ( it.Get() == label )
+      {
+      PointType point;
+      for ( unsigned int d = 0; d < Dimension; ++d )
+        {
+        point[d] = it.GetIndex()[d] * image->GetSpacing()[d];
+        }
+      points.push_back( point );
+      }
+    }
+
+  maximum = 0;
+  minimum = itk::NumericTraits< double >::max();
+  for ( size_t i = 0; i < points.size(); ++i )
+    {
+    for ( size_t j = i + 1; j < points.size(); ++j )
+      {
+      maximum = std::max( maximum, points[i].EuclideanDistanceTo( points[j] ) );
+      if ( Dimension != 2 )
+        {
+        continue;
+        }
+      // the width in the direction normal to the line (i, j), if all the
+      // points are on the same side of the line
+      const double nx = points[i][1] - points[j][1];
+      const double ny = points[j][0] - points[i][0];
+      const double norm = std::sqrt( nx * nx + ny * ny );
+      double       low = 0;
+      double       high = 0;
+      for ( size_t k = 0; k < points.size(); ++k )
+        {
+        const double height = ( ( points[k][0] - points[i][0] ) * nx + ( points[k][1] - points[i][1] ) * ny ) / norm;
+        low = std::min( low, height );
+        high = std::max( high, height );
+        }
+      if ( low > -1e-9 || high < 1e-9 )
+        {
+        minimum = std::min( minimum, high - low );
+        }
+      }
+    }
+  if ( points.size() < 3 || minimum == itk::NumericTraits< double >::max() )
+    {
+    minimum = 0;
+    }
+}
+
+template< typename TImage >
+void
+FillBox(TImage * image, const typename TImage::IndexType & start, const typename TImage::SizeType & size,
+        typename TImage::PixelType label)
+{
+  itk::ImageRegionIterator< TImage > it( image, typename TImage::RegionType( start, size ) );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    it.Set( label );
+    }
+}
+
+bool
+CheckValue(const char * name, unsigned int label, double value, double expected)
+{
+  if ( itk::Math::abs( value - expected ) > 1e-6 * ( 1 + itk::Math::abs( expected ) ) )
+    {
+    std::cerr << name << " of the object " << label << ": " << value
+              << " instead of " << expected << std::endl;
+    return false;
+    }
+  return true;
+}
+
+}
+
+int itkShapeLabelMapFilterFeretDiameterTest(int, char* [] )
+{
+  bool success = true;
+
+  // 2D: random blobs compared to the brute force, and a rectangle
+  {
+  typedef itk::Image< unsigned char, 2 >                                ImageType;
+  typedef itk::ShapeLabelObject< unsigned char, 2 >                     LabelObjectType;
+  typedef itk::LabelMap< LabelObjectType >                              LabelMapType;
+  typedef itk::LabelImageToShapeLabelMapFilter< ImageType, LabelMapType > FilterType;
+
+  ImageType::SizeType size;
+  size[0] = 40;
+  size[1] = 30;
+  ImageType::SpacingType spacing;
+  spacing[0] = 0.7;
+  spacing[1] = 1.3;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->SetSpacing( spacing );
+  image->Allocate( true );
+
+  unsigned int seed = 1234;
+  for ( unsigned int label = 1; label <= 6; ++label )
+    {
+    // a random walk of small squares
+    ImageType::IndexType position;
+    position[0] = 5 + 6 * ( label - 1 );
+    position[1] = 15;
+    for ( unsigned int step = 0; step < 12; ++step )
+      {
+      ImageType::SizeType square;
+      square.Fill( 2 );
+      ImageType::RegionType region( position, square );
+      region.Crop( image->GetLargestPossibleRegion() );
+      FillBox< ImageType >( image, region.GetIndex(), region.GetSize(), label );
+      seed = seed * 1103515245u + 12345u;
+      position[0] += static_cast< int >( ( seed >> 8 ) % 3 ) - 1;
+      seed = seed * 1103515245u + 12345u;
+      position[1] += static_cast< int >( ( seed >> 8 ) % 5 ) - 2;
+      }
+    }
+  ImageType::IndexType start;
+  start[0] = 2;
+  start[1] = 1;
+  ImageType::SizeType rectangle;
+  rectangle[0] = 7;
+  rectangle[1] = 3;
+  FillBox< ImageType >( image, start, rectangle, 10 );
+  // a single pixel and a segment
+  start[0] = 38;
+  start[1] = 28;
+  rectangle[0] = 1;
+  rectangle[1] = 1;
+  FillBox< ImageType >( image, start, rectangle, 11 );
+  start[0] = 20;
+  start[1] = 2;
+  rectangle[0] = 1;
+  rectangle[1] = 5;
+  FillBox< ImageType >( image, start, rectangle, 12 );
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  filter->SetComputeFeretDiameter( true );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+
+  LabelMapType * labelMap = filter->GetOutput();
+  for ( unsigned int i = 0; i < labelMap->GetNumberOfLabelObjects(); ++i )
+    {
+    const LabelObjectType * labelObject = labelMap->GetNthLabelObject( i );
+    const unsigned int      label = labelObject->GetLabel();
+    double maximum;
+    double minimum;
+    BruteForceFeretDiameters< ImageType >( image, labelObject->GetLabel(), maximum, minimum );
+    success &= CheckValue( "FeretDiameter", label, labelObject->GetFeretDiameter(), maximum );
+    success &= CheckValue( "MinimumFeretDiameter", label, labelObject->GetMinimumFeretDiameter(), minimum );
+    }
+  success &= CheckValue( "ConvexHullPhysicalSize", 10,
+                         labelMap->GetLabelObject( 10 )->GetConvexHullPhysicalSize(), 6 * 0.7 * 2 * 1.3 );
+  success &= CheckValue( "ConvexHullPhysicalSize", 11,
+                         labelMap->GetLabelObject( 11 )->GetConvexHullPhysicalSize(), 0 );
+  success &= CheckValue( "ConvexHullPhysicalSize", 12,
+                         labelMap->GetLabelObject( 12 )->GetConvexHullPhysicalSize(), 0 );
+  success &= CheckValue( "FeretDiameter", 12, labelMap->GetLabelObject( 12 )->GetFeretDiameter(), 4 * 1.3 );
+  }
+
+  // 3D: a box, a flat object, a line and a ball
+  {
+  typedef itk::Image< unsigned char, 3 >                                ImageType;
+  typedef itk::ShapeLabelObject< unsigned char, 3 >                     LabelObjectType;
+  typedef itk::LabelMap< LabelObjectType >                              LabelMapType;
+  typedef itk::LabelImageToShapeLabelMapFilter< ImageType, LabelMapType > FilterType;
+
+  ImageType::SizeType size;
+  size.Fill( 24 );
+  ImageType::SpacingType spacing;
+  spacing[0] = 1.0;
+  spacing[1] = 2.0;
+  spacing[2] = 0.5;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->SetSpacing( spacing );
+  image->Allocate( true );
+
+  ImageType::IndexType start = { { 1, 1, 1 } };
+  ImageType::SizeType  box = { { 5, 4, 3 } };
+  FillBox< ImageType >( image, start, box, 1 );
+  ImageType::IndexType flatStart = { { 10, 1, 1 } };
+  ImageType::SizeType  flat = { { 6, 5, 1 } };
+  FillBox< ImageType >( image, flatStart, flat, 2 );
+  ImageType::IndexType lineStart = { { 1, 10, 20 } };
+  ImageType::SizeType  line = { { 1, 7, 1 } };
+  FillBox< ImageType >( image, lineStart, line, 3 );
+
+  itk::ImageRegionIteratorWithIndex< ImageType > it( image, image->GetLargestPossibleRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType & idx = it.GetIndex();
+    const double dx = idx[0] - 15.0;
+    const double dy = idx[1] - 15.0;
+    const double dz = idx[2] - 14.0;
+    if ( dx * dx + dy * dy + dz * dz <= 25.0 )
+      {
+      it.Set( 4 );
+      }
+    }
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  filter->SetComputeFeretDiameter( true );
+  TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+
+  LabelMapType * labelMap = filter->GetOutput();
+  for ( unsigned int i = 0; i < labelMap->GetNumberOfLabelObjects(); ++i )
+    {
+    const LabelObjectType * labelObject = labelMap->GetNthLabelObject( i );
+    double maximum;
+    double minimum;
+    BruteForceFeretDiameters< ImageType >( image, labelObject->GetLabel(), maximum, minimum );
+    success &= CheckValue( "FeretDiameter", labelObject->GetLabel(), labelObject->GetFeretDiameter(), maximum );
+    }
+
+  success &= CheckValue( "MinimumFeretDiameter", 1,
+                         labelMap->GetLabelObject( 1 )->GetMinimumFeretDiameter(), 2 * 0.5 );
+  success &= CheckValue( "ConvexHullPhysicalSize", 1,
+                         labelMap->GetLabelObject( 1 )->GetConvexHullPhysicalSize(), 4 * 1.0 * 3 * 2.0 * 2 * 0.5 );
+  success &= CheckValue( "MinimumFeretDiameter", 2, labelMap->GetLabelObject( 2 )->GetMinimumFeretDiameter(), 0 );
+  success &= CheckValue( "ConvexHullPhysicalSize", 2,
+                         labelMap->GetLabelObject( 2 )->GetConvexHullPhysicalSize(), 0 );
+  success &= CheckValue( "MinimumFeretDiameter", 3, labelMap->GetLabelObject( 3 )->GetMinimumFeretDiameter(), 0 );
+  // the ball: its width is at most its extent along the z axis
+  const LabelObjectType * ball = labelMap->GetLabelObject( 4 );
+  if ( ball->GetMinimumFeretDiameter() <= 0 || ball->GetMinimumFeretDiameter() > 10 * 0.5 + 1e-9
+       || ball->GetConvexHullPhysicalSize() <= 0
+       || ball->GetConvexHullPhysicalSize() > ball->GetPhysicalSize() )
+    {
+    std::cerr << "Wrong convex hull attributes for the ball: " << ball->GetMinimumFeretDiameter()
+              << " " << ball->GetConvexHullPhysicalSize() << std::endl;
+    success = false;
+    }
+
+  // copy the attributes, which are bound to references
+  const LabelObjectType::AttributeType minimumFeretDiameter = LabelObjectType::MINIMUM_FERET_DIAMETER;
+  const LabelObjectType::AttributeType convexHullPhysicalSize = LabelObjectType::CONVEX_HULL_PHYSICAL_SIZE;
+  TEST_SET_GET_VALUE( minimumFeretDiameter, LabelObjectType::GetAttributeFromName( "MinimumFeretDiameter" ) );
+  TEST_SET_GET_VALUE( std::string( "ConvexHullPhysicalSize" ),
+                      LabelObjectType::GetNameFromAttribute( convexHullPhysicalSize ) );
+  }
+
+  if ( !success )
+    {
+    return EXIT_FAILURE;
+    }
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,193 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkStatisticsLabelObject.h"
+#include "itkLabelImageToLabelMapFilter.h"
+#include "itkStatisticsLabelMapFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+bool
+Close(double value1, double value2, const char * name, unsigned long label)
+{
+  if ( std::abs( value1 - value2 ) > 1e-6 * ( 1.0 + std::abs( value1 ) ) )
+    {
+    std::cerr << "Label " << label << ": " << name << " differs: "
+              << value1 << " != " << value2 << std::endl;
+    return false;
+    }
+  return true;
+}
+
+}
+
+// Compute the attributes with the large objects split among the threads
+// and compare them to the ones computed one object per thread.
+int itkStatisticsLabelMapFilterSplitTest(int, char* [] )
+{
+  const unsigned int Dimension = 3;
+
+  typedef unsigned char                                           LabelPixelType;
+  typedef itk::Image< LabelPixelType, Dimension >                 LabelImageType;
+  typedef short                                                   FeaturePixelType;
+  typedef itk::Image< FeaturePixelType, Dimension >               FeatureImageType;
+  typedef itk::StatisticsLabelObject< LabelPixelType, Dimension > LabelObjectType;
+  typedef itk::LabelMap< LabelObjectType >                        LabelMapType;
+
+  typedef itk::LabelImageToLabelMapFilter< LabelImageType, LabelMapType > ConverterType;
+  typedef itk::StatisticsLabelMapFilter< LabelMapType, FeatureImageType > StatisticsType;
+
+  // A large ball touching the border of the image, and small boxes
+  LabelImageType::SizeType size;
+  size[0] = 47;
+  size[1] = 41;
+  size[2] = 37;
+  LabelImageType::Pointer labelImage = LabelImageType::New();
+  labelImage->SetRegions( size );
+  labelImage->Allocate();
+  labelImage->FillBuffer( 0 );
+  FeatureImageType::Pointer featureImage = FeatureImageType::New();
+  featureImage->SetRegions( size );
+  featureImage->Allocate();
+  LabelImageType::SpacingType spacing;
+  spacing[0] = 0.7;
+  spacing[1] = 1.0;
+  spacing[2] = 1.3;
+  labelImage->SetSpacing( spacing );
+  featureImage->SetSpacing( spacing );
+
+  unsigned int seed = 4321;
+  itk::ImageRegionIteratorWithIndex< LabelImageType > it( labelImage, labelImage->GetLargestPossibleRegion() );
+  itk::ImageRegionIteratorWithIndex< FeatureImageType > fit( featureImage, featureImage->GetLargestPossibleRegion() );
+  for ( it.GoToBegin(), fit.GoToBegin(); !it.IsAtEnd(); ++it, ++fit )
+    {
+    const LabelImageType::IndexType & idx = it.GetIndex();
+    const double x = idx[0] - 20.0;
+    const double y = idx[1] - 22.0;
+    const double z = idx[2] - 25.0;
+    if ( x * x + y * y + z * z < 400.0 )
+      {
+      it.Set( 1 );
+      }
+    else if ( idx[0] % 8 < 3 && idx[1] % 7 < 2 && idx[2] % 6 < 3 )
+      {
+      it.Set( static_cast< LabelPixelType >( 2 + ( idx[0] / 8 + idx[1] / 7 + idx[2] / 6 ) % 50 ) );
+      }
+    seed = seed * 1103515245u + 12345u;
+    fit.Set( static_cast< FeaturePixelType >( ( seed >> 16 ) % 200 ) - 100 );
+    }
+
+  ConverterType::Pointer converter = ConverterType::New();
+  converter->SetInput( labelImage );
+  TRY_EXPECT_NO_EXCEPTION( converter->Update() );
+
+  StatisticsType::Pointer reference = StatisticsType::New();
+  reference->SetInput( converter->GetOutput() );
+  reference->SetFeatureImage( featureImage );
+  reference->SetInPlace( false );
+  reference->SetComputeFeretDiameter( true );
+  reference->SetNumberOfThreads( 1 );
+  TRY_EXPECT_NO_EXCEPTION( reference->Update() );
+
+  StatisticsType::Pointer split = StatisticsType::New();
+  TEST_SET_GET_VALUE( 16384, split->GetMinimumNumberOfLinesToSplit() );
+  split->SetInput( converter->GetOutput() );
+  split->SetFeatureImage( featureImage );
+  split->SetInPlace( false );
+  split->SetComputeFeretDiameter( true );
+  split->SetNumberOfThreads( 4 );
+  split->SetMinimumNumberOfLinesToSplit( 100 );
+  TEST_SET_GET_VALUE( 100, split->GetMinimumNumberOfLinesToSplit() );
+  TRY_EXPECT_NO_EXCEPTION( split->Update() );
+
+  // without the histograms, the medians are computed from the same bins
+  StatisticsType::Pointer noHistogram = StatisticsType::New();
+  noHistogram->SetInput( converter->GetOutput() );
+  noHistogram->SetFeatureImage( featureImage );
+  noHistogram->SetInPlace( false );
+  noHistogram->SetNumberOfThreads( 4 );
+  noHistogram->SetMinimumNumberOfLinesToSplit( 100 );
+  noHistogram->ComputeHistogramOff();
+  TRY_EXPECT_NO_EXCEPTION( noHistogram->Update() );
+
+  const LabelMapType * referenceMap = reference->GetOutput();
+  const LabelMapType * splitMap = split->GetOutput();
+  const LabelMapType * noHistogramMap = noHistogram->GetOutput();
+  TEST_EXPECT_EQUAL( referenceMap->GetNumberOfLabelObjects(), splitMap->GetNumberOfLabelObjects() );
+  TEST_EXPECT_TRUE( referenceMap->GetLabelObject( 1 )->GetNumberOfLines() >= 100 );
+
+  bool passed = true;
+  for ( LabelMapType::ConstIterator lit( referenceMap ); !lit.IsAtEnd(); ++lit )
+    {
+    const LabelObjectType * o1 = lit.GetLabelObject();
+    const LabelObjectType * o2 = splitMap->GetLabelObject( o1->GetLabel() );
+    const unsigned long     label = o1->GetLabel();
+
+    if ( o1->GetNumberOfPixels() != o2->GetNumberOfPixels()
+         || o1->GetNumberOfPixelsOnBorder() != o2->GetNumberOfPixelsOnBorder()
+         || o1->GetBoundingBox() != o2->GetBoundingBox()
+         || o1->GetMinimumIndex() != o2->GetMinimumIndex()
+         || o1->GetMaximumIndex() != o2->GetMaximumIndex() )
+      {
+      std::cerr << "Label " << label << ": the counts, bounding box or extrema indices differ" << std::endl;
+      passed = false;
+      }
+    passed &= Close( o1->GetPhysicalSize(), o2->GetPhysicalSize(), "PhysicalSize", label );
+    passed &= Close( o1->GetPerimeterOnBorder(), o2->GetPerimeterOnBorder(), "PerimeterOnBorder", label );
+    passed &= Close( o1->GetPerimeter(), o2->GetPerimeter(), "Perimeter", label );
+    passed &= Close( o1->GetFeretDiameter(), o2->GetFeretDiameter(), "FeretDiameter", label );
+    passed &= Close( o1->GetElongation(), o2->GetElongation(), "Elongation", label );
+    passed &= Close( o1->GetMinimum(), o2->GetMinimum(), "Minimum", label );
+    passed &= Close( o1->GetMaximum(), o2->GetMaximum(), "Maximum", label );
+    passed &= Close( o1->GetMean(), o2->GetMean(), "Mean", label );
+    passed &= Close( o1->GetMedian(), o2->GetMedian(), "Median", label );
+    passed &= Close( o1->GetMedian(), noHistogramMap->GetLabelObject( label )->GetMedian(), "Median", label );
+    passed &= Close( o1->GetVariance(), o2->GetVariance(), "Variance", label );
+    passed &= Close( o1->GetSkewness(), o2->GetSkewness(), "Skewness", label );
+    passed &= Close( o1->GetKurtosis(), o2->GetKurtosis(), "Kurtosis", label );
+    for ( unsigned int d = 0; d < Dimension; ++d )
+      {
+      passed &= Close( o1->GetCentroid()[d], o2->GetCentroid()[d], "Centroid", label );
+      passed &= Close( o1->GetPrincipalMoments()[d], o2->GetPrincipalMoments()[d], "PrincipalMoments", label );
+      passed &= Close( o1->GetCenterOfGravity()[d], o2->GetCenterOfGravity()[d], "CenterOfGravity", label );
+      passed &= Close( o1->GetWeightedPrincipalMoments()[d], o2->GetWeightedPrincipalMoments()[d],
+                       "WeightedPrincipalMoments", label );
+      }
+    for ( unsigned int i = 0; i < o1->GetHistogram()->Size(); ++i )
+      {
+      if ( o1->GetHistogram()->GetFrequency( i ) != o2->GetHistogram()->GetFrequency( i ) )
+        {
+        std::cerr << "Label " << label << ": the histograms differ" << std::endl;
+        passed = false;
+        break;
+        }
+      }
+    }
+
+  if ( !passed )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -20,6 +20,8 @@
 
 #include <list>
 #include <map>
+#include <set>
+#include <vector>
 #include <algorithm>
 
 #include "itkQuadEdgeMeshEulerOperatorJoinVertexFunction.h"
@@ -34,6 +36,19 @@ namespace itk
 /**
  * \class EdgeDecimationQuadEdgeMeshFilter
  * \brief
+ *
+ * By default the edges are collapsed one by one, in the order of their
+ * measures. With UseIndependentSetCollapses on, they are collapsed in
+ * rounds: each round takes, in the order of their measures, edges whose
+ * neighborhoods (the points of the 1-rings of both points of the edge) do
+ * not overlap, so that the collapse of one of them does not modify the
+ * others. The measures of the edges, the new locations of the points of a
+ * round, and the measures of the edges its collapses modify are computed
+ * by the threads of the filter, then the collapses are applied in order.
+ * The result does not depend on the number of threads, but may differ
+ * from the one of the collapses one by one, since the edges of a round are
+ * not measured again after the collapses of the round.
+ *
  * \ingroup ITKQuadEdgeMeshFiltering
  */
 template< typename TInput, typename TOutput, typename TCriterion >
@@ -85,14 +100,32 @@ public:
   typedef QuadEdgeMeshEulerOperatorJoinVertexFunction< OutputMeshType, OutputQEType > OperatorType;
   typedef typename OperatorType::Pointer                                              OperatorPointer;
 
+  /** Collapse the edges in rounds of independent edges, computing the
+   * measures and the new locations of the points with several threads.
+   * Off by default. */
+  itkSetMacro(UseIndependentSetCollapses, bool);
+  itkGetConstMacro(UseIndependentSetCollapses, bool);
+  itkBooleanMacro(UseIndependentSetCollapses);
+
+  /** Set/Get the maximum number of collapses of a round. */
+  itkSetClampMacro(MaximumNumberOfCollapsesPerRound, SizeValueType, 1, NumericTraits< SizeValueType >::max());
+  itkGetConstMacro(MaximumNumberOfCollapsesPerRound, SizeValueType);
+
 protected:
 
   EdgeDecimationQuadEdgeMeshFilter();
   virtual ~EdgeDecimationQuadEdgeMeshFilter();
 
+  void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
+
+  void GenerateData() ITK_OVERRIDE;
+
   bool m_Relocate;
   bool m_CheckOrientation;
 
+  bool          m_UseIndependentSetCollapses;
+  SizeValueType m_MaximumNumberOfCollapsesPerRound;
+
   PriorityQueuePointer m_PriorityQueue;
   QueueMapType         m_QueueMapper;
   OutputQEType *       m_Element;
@@ -103,9 +136,39 @@ protected:
   * \brief Compute the measure value for iEdge
   * \param[in] iEdge
   * \return measure value
+  * \note With UseIndependentSetCollapses on, it is called by several
+  * threads at once, and must not modify the filter or the mesh.
   */
   virtual MeasureType MeasureEdge(OutputQEType *iEdge) = 0;
 
+  /**
+  * \brief Compute with several threads the measures (see MeasureEdge())
+  * and the new locations of the points (see Relocate()) of the given edges,
+  * each of them if its output is not ITK_NULLPTR
+  * \param[in] iEdges
+  * \param[out] oMeasures
+  * \param[out] oPoints
+  */
+  void ComputeMeasuresAndLocations(const std::vector< OutputQEType * > & iEdges,
+                                   std::vector< MeasureType > *oMeasures,
+                                   std::vector< OutputPointType > *oPoints);
+
+  /**
+  * \brief Collapse a round of independent edges
+  * \return true when the decimation is over
+  */
+  bool ProcessIndependentSet();
+
+  /**
+  * \brief Collapse m_Element, and update the measures of the edges around
+  * its points, or append these edges to oEdgesToBeUpdated if it is not
+  * ITK_NULLPTR
+  * \param[in] iPt the new location of the remaining point, if m_Relocate
+  * \param[out] oEdgesToBeUpdated
+  */
+  void CollapseElement(const OutputPointType & iPt,
+                       std::vector< OutputQEType * > *oEdgesToBeUpdated);
+
   /**
   * \brief Fill the priority queue
   */
@@ -145,6 +208,15 @@ protected:
   */
   virtual void PushOrUpdateElement(OutputQEType *iEdge);
 
+  /**
+  * \brief Push iEdge, whose origin is smaller than its destination, in the
+  * priority queue with the given measure if it is not already, else its
+  * corresponding priority value is updated.
+  * \param[in] iEdge
+  * \param[in] iMeasure
+  */
+  void PushOrUpdateMeasuredElement(OutputQEType *iEdge, const MeasureType & iMeasure);
+
   /**
   * \brief
   */
@@ -192,6 +264,8 @@ protected:
   * \brief
   * \param[in] iEdge (the one which will be merged)
   * \return the new location of merged points
+  * \note With UseIndependentSetCollapses on, it is called by several
+  * threads at once, and must not modify the filter or the mesh.
   */
   virtual OutputPointType Relocate(OutputQEType *iEdge) = 0;
 
@@ -302,6 +376,19 @@ private:
   EdgeDecimationQuadEdgeMeshFilter(const Self &);
   void operator=(const Self &);
 
+  /** Internal structure used for passing the edges to the threads. */
+  struct MeasureThreadStruct
+    {
+    Self *              Filter;
+    OutputQEType *const*Edges;
+    SizeValueType       NumberOfEdges;
+    MeasureType *       Measures;
+    OutputPointType *   Points;
+    };
+
+  /** Static function used as a "callback" by the MultiThreader. */
+  static ITK_THREAD_RETURN_TYPE MeasureThreaderCallback(void *arg);
+
 };
 }
 
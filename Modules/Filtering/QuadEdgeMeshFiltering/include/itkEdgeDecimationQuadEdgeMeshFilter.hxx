@@ -28,6 +28,8 @@ EdgeDecimationQuadEdgeMeshFilter() :
   Superclass(),
   m_Relocate(true),
   m_CheckOrientation(false),
+  m_UseIndependentSetCollapses(false),
+  m_MaximumNumberOfCollapsesPerRound(1024),
   m_Element(ITK_NULLPTR)
 
 {
@@ -52,6 +54,29 @@ EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::
     }
 }
 
+template< typename TInput, typename TOutput, typename TCriterion >
+void
+EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::GenerateData()
+{
+  if ( !m_UseIndependentSetCollapses )
+    {
+    Superclass::GenerateData();
+    return;
+    }
+
+  this->CopyInputMeshToOutputMesh();
+  this->m_OutputMesh = this->GetOutput();
+
+  this->Initialize();
+  this->FillPriorityQueue();
+  this->m_Iteration = 0;
+  while ( !this->ProcessIndependentSet() )
+    {
+    }
+
+  this->GetOutput()->SqueezePointsIds();
+}
+
 template< typename TInput, typename TOutput, typename TCriterion >
 void
 EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::FillPriorityQueue()
@@ -68,6 +93,30 @@ EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::FillPriorityQue
   // cache for use in MeasureEdge
   this->m_OutputMesh = this->GetOutput();
 
+  if ( m_UseIndependentSetCollapses )
+    {
+    std::vector< OutputQEType * > edges;
+    while ( it != end )
+      {
+      edge = dynamic_cast< OutputEdgeCellType * >( it.Value() );
+
+      if ( edge )
+        {
+        OutputQEType *qe = edge->GetQEGeom();
+        edges.push_back( ( qe->GetOrigin() < qe->GetDestination() ) ? qe : qe->GetSym() );
+        }
+      ++it;
+      }
+
+    std::vector< MeasureType > measures;
+    this->ComputeMeasuresAndLocations(edges, &measures, ITK_NULLPTR);
+    for ( size_t i = 0; i < edges.size(); ++i )
+      {
+      this->PushOrUpdateMeasuredElement(edges[i], measures[i]);
+      }
+    return;
+    }
+
   while ( it != end )
     {
     edge = dynamic_cast< OutputEdgeCellType * >( it.Value() );
@@ -212,26 +261,91 @@ EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::PushOrUpdateEle
     temp = temp->GetSym();
     }
 
-  QueueMapIterator map_it = m_QueueMapper.find(temp);
+  this->PushOrUpdateMeasuredElement( temp, MeasureEdge(temp) );
+}
+
+template< typename TInput, typename TOutput, typename TCriterion >
+void
+EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::PushOrUpdateMeasuredElement(OutputQEType *iEdge,
+                                                                                             const MeasureType & iMeasure)
+{
+  QueueMapIterator map_it = m_QueueMapper.find(iEdge);
 
-  MeasureType measure = MeasureEdge(temp);
   if ( map_it != m_QueueMapper.end() )
     {
     if ( !map_it->second->m_Priority.first )
       {
-      map_it->second->m_Priority.second = measure;
+      map_it->second->m_Priority.second = iMeasure;
       m_PriorityQueue->Update(map_it->second);
       }
     }
   else
     {
-    PriorityQueueItemType *qi = new PriorityQueueItemType( temp,
-                                                           PriorityType(false, measure) );
-    m_QueueMapper[temp] = qi;
+    PriorityQueueItemType *qi = new PriorityQueueItemType( iEdge,
+                                                           PriorityType(false, iMeasure) );
+    m_QueueMapper[iEdge] = qi;
     m_PriorityQueue->Push(qi);
     }
 }
 
+template< typename TInput, typename TOutput, typename TCriterion >
+void
+EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::ComputeMeasuresAndLocations(
+  const std::vector< OutputQEType * > & iEdges,
+  std::vector< MeasureType > *oMeasures,
+  std::vector< OutputPointType > *oPoints)
+{
+  const SizeValueType numberOfEdges = static_cast< SizeValueType >( iEdges.size() );
+  if ( oMeasures )
+    {
+    oMeasures->resize(numberOfEdges);
+    }
+  if ( oPoints )
+    {
+    oPoints->resize(numberOfEdges);
+    }
+  if ( numberOfEdges == 0 )
+    {
+    return;
+    }
+
+  MeasureThreadStruct str;
+  str.Filter = this;
+  str.Edges = &iEdges[0];
+  str.NumberOfEdges = numberOfEdges;
+  str.Measures = oMeasures ? &( *oMeasures )[0] : ITK_NULLPTR;
+  str.Points = oPoints ? &( *oPoints )[0] : ITK_NULLPTR;
+
+  this->GetMultiThreader()->SetNumberOfThreads( this->GetNumberOfThreads() );
+  this->GetMultiThreader()->SetSingleMethod( this->MeasureThreaderCallback, &str );
+  this->GetMultiThreader()->SingleMethodExecute();
+}
+
+template< typename TInput, typename TOutput, typename TCriterion >
+ITK_THREAD_RETURN_TYPE
+EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::MeasureThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  const MeasureThreadStruct *      str = static_cast< const MeasureThreadStruct * >( info->UserData );
+
+  // contiguous ranges of edges
+  const SizeValueType begin = str->NumberOfEdges * info->ThreadID / info->NumberOfThreads;
+  const SizeValueType end = str->NumberOfEdges * ( info->ThreadID + 1 ) / info->NumberOfThreads;
+  for ( SizeValueType i = begin; i < end; ++i )
+    {
+    if ( str->Measures )
+      {
+      str->Measures[i] = str->Filter->MeasureEdge( str->Edges[i] );
+      }
+    if ( str->Points )
+      {
+      str->Points[i] = str->Filter->Relocate( str->Edges[i] );
+      }
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
 template< typename TInput, typename TOutput, typename TCriterion >
 void
 EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::JoinVertexFailed()
@@ -331,6 +445,20 @@ EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::ProcessWithoutA
     return false;
     }
 
+  this->CollapseElement(pt, ITK_NULLPTR);
+  return false;
+}
+
+template< typename TInput, typename TOutput, typename TCriterion >
+void
+EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::CollapseElement(
+  const OutputPointType & iPt,
+  std::vector< OutputQEType * > *oEdgesToBeUpdated)
+{
+  OutputPointIdentifier id_org = m_Element->GetOrigin();
+  OutputPointIdentifier id_dest = m_Element->GetDestination();
+  OutputPointType       pt = iPt;
+
   std::list< OutputQEType * > list_qe_to_be_deleted;
   OutputQEType *              temp = m_Element->GetOnext();
 
@@ -362,7 +490,14 @@ EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::ProcessWithoutA
 
     while ( it != list_qe_to_be_deleted.end() )
       {
-      PushOrUpdateElement(*it);
+      if ( oEdgesToBeUpdated )
+        {
+        oEdgesToBeUpdated->push_back(*it);
+        }
+      else
+        {
+        PushOrUpdateElement(*it);
+        }
       ++it;
       }
 
@@ -379,7 +514,7 @@ EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::ProcessWithoutA
     if ( edge == ITK_NULLPTR )
       {
       itkDebugMacro("edge == 0, at iteration " << this->m_Iteration);
-      return false;
+      return;
       }
 
     if ( m_Relocate )
@@ -392,11 +527,150 @@ EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::ProcessWithoutA
 
     do
       {
-      PushOrUpdateElement(temp);
+      if ( oEdgesToBeUpdated )
+        {
+        oEdgesToBeUpdated->push_back(temp);
+        }
+      else
+        {
+        PushOrUpdateElement(temp);
+        }
       temp = temp->GetOnext();
       }
     while ( temp != edge );
     }
+}
+
+template< typename TInput, typename TOutput, typename TCriterion >
+bool
+EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::ProcessIndependentSet()
+{
+  // Take the edges in the order of their measures, the ones whose
+  // neighborhood overlaps the one of a previous edge of the round being
+  // left in the queue.
+  std::vector< OutputQEType * >          edges;
+  std::vector< PriorityType >            priorities;
+  std::vector< PriorityQueueItemType * > overlapping;
+  std::set< OutputPointIdentifier >      locked;
+  std::vector< OutputPointIdentifier >   neighborhood;
+
+  while ( !m_PriorityQueue->Empty() && edges.size() < m_MaximumNumberOfCollapsesPerRound )
+    {
+    PriorityQueueItemType *item = m_PriorityQueue->Peek();
+    if ( item->m_Priority.first )
+      {
+      // the remaining edges can not be processed
+      break;
+      }
+    m_PriorityQueue->Pop();
+    m_QueueMapper.erase(item->m_Element);
+
+    OutputQEType *qe = item->m_Element;
+    if ( !IsEdgeOKToBeProcessed(qe) )
+      {
+      delete item;
+      continue;
+      }
+
+    neighborhood.clear();
+    OutputQEType *qe_it = qe;
+    do
+      {
+      neighborhood.push_back( qe_it->GetDestination() );
+      qe_it = qe_it->GetOnext();
+      }
+    while ( qe_it != qe );
+    qe_it = qe->GetSym();
+    do
+      {
+      neighborhood.push_back( qe_it->GetDestination() );
+      qe_it = qe_it->GetOnext();
+      }
+    while ( qe_it != qe->GetSym() );
+
+    bool independent = true;
+    for ( size_t i = 0; i < neighborhood.size() && independent; ++i )
+      {
+      independent = ( locked.find(neighborhood[i]) == locked.end() );
+      }
+    if ( independent )
+      {
+      locked.insert( neighborhood.begin(), neighborhood.end() );
+      edges.push_back(qe);
+      priorities.push_back(item->m_Priority);
+      delete item;
+      }
+    else
+      {
+      overlapping.push_back(item);
+      }
+    }
+
+  // The overlapping edges are put back in the queue before the collapses,
+  // which may delete them.
+  for ( size_t i = 0; i < overlapping.size(); ++i )
+    {
+    m_QueueMapper[overlapping[i]->m_Element] = overlapping[i];
+    m_PriorityQueue->Push(overlapping[i]);
+    }
+
+  if ( edges.empty() )
+    {
+    return true;
+    }
+
+  std::vector< OutputPointType > points;
+  if ( m_Relocate )
+    {
+    this->ComputeMeasuresAndLocations(edges, ITK_NULLPTR, &points);
+    }
+
+  // The collapses do not modify the neighborhoods of the other edges of the
+  // round, nor the edges around the points of the other collapses.
+  std::vector< OutputQEType * > edgesToBeUpdated;
+  for ( size_t i = 0; i < edges.size(); ++i )
+    {
+    m_Element = edges[i];
+    m_Priority = priorities[i];
+
+    OutputPointType pt;
+    if ( m_Relocate )
+      {
+      pt = points[i];
+      }
+    this->CollapseElement(pt, &edgesToBeUpdated);
+    ++this->m_Iteration;
+
+    if ( this->m_Criterion->is_satisfied(this->m_OutputMesh, 0, m_Priority.second) )
+      {
+      return true;
+      }
+    }
+
+  // Measure the edges around the points of the round once, in the order of
+  // the collapses.
+  std::vector< OutputQEType * > uniqueEdges;
+  std::set< OutputQEType * >    inserted;
+  for ( size_t i = 0; i < edgesToBeUpdated.size(); ++i )
+    {
+    OutputQEType *temp = edgesToBeUpdated[i];
+    if ( temp->GetOrigin() > temp->GetDestination() )
+      {
+      temp = temp->GetSym();
+      }
+    if ( inserted.insert(temp).second )
+      {
+      uniqueEdges.push_back(temp);
+      }
+    }
+
+  std::vector< MeasureType > measures;
+  this->ComputeMeasuresAndLocations(uniqueEdges, &measures, ITK_NULLPTR);
+  for ( size_t i = 0; i < uniqueEdges.size(); ++i )
+    {
+    this->PushOrUpdateMeasuredElement(uniqueEdges[i], measures[i]);
+    }
+
   return false;
 }
 
@@ -599,5 +873,16 @@ EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::IsCriterionSati
     return this->m_Criterion->is_satisfied(this->GetOutput(), 0, m_Priority.second);
     }
 }
+
+template< typename TInput, typename TOutput, typename TCriterion >
+void
+EdgeDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "UseIndependentSetCollapses: "
+     << ( m_UseIndependentSetCollapses ? "On" : "Off" ) << std::endl;
+  os << indent << "MaximumNumberOfCollapsesPerRound: "
+     << m_MaximumNumberOfCollapsesPerRound << std::endl;
+}
 }
 #endif
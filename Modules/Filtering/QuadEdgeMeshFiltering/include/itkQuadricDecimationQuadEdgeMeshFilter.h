@@ -121,7 +121,7 @@ protected:
   {
     OutputPointIdentifier id_org = iEdge->GetOrigin();
     OutputPointIdentifier id_dest = iEdge->GetDestination();
-    QuadricElementType    Q = m_Quadric[id_org] + m_Quadric[id_dest];
+    QuadricElementType    Q = this->GetQuadric(id_org) + this->GetQuadric(id_dest);
 
     OutputPointType org = this->m_OutputMesh->GetPoint(id_org);
     OutputPointType dest = this->m_OutputMesh->GetPoint(id_dest);
@@ -150,10 +150,38 @@ protected:
   /** \brief Compute Quadric error for all edges */
   virtual void Initialize() ITK_OVERRIDE;
 
+  /** \brief Get the quadric of a point without inserting it in the map,
+   * since MeasureEdge and Relocate are called by several threads when
+   * UseIndependentSetCollapses is on
+   * \param[in] iId id of the point
+   */
+  const QuadricElementType & GetQuadric(const OutputPointIdentifier & iId) const
+  {
+    typename QuadricElementMapType::const_iterator it = m_Quadric.find(iId);
+    if ( it == m_Quadric.end() )
+      {
+      return m_NullQuadric;
+      }
+    return it->second;
+  }
+
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(QuadricDecimationQuadEdgeMeshFilter);
 
   QuadricElementMapType m_Quadric;
+  QuadricElementType    m_NullQuadric;
+
+  /** Internal structure used for passing the points to the threads. */
+  struct QuadricThreadStruct
+    {
+    Self *               Filter;
+    OutputQEType *const *Edges;
+    QuadricElementType **Quadrics;
+    SizeValueType        NumberOfPoints;
+    };
+
+  /** Static function used as a "callback" by the MultiThreader. */
+  static ITK_THREAD_RETURN_TYPE QuadricThreaderCallback(void *arg);
 };
 }
 #ifndef ITK_MANUAL_INSTANTIATION
@@ -46,6 +46,41 @@ QuadricDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >
   OutputQEType *                qe_it;
 
   OutputMeshType *outputMesh = this->GetOutput();
+
+  if ( this->GetUseIndependentSetCollapses() )
+    {
+    // The quadrics are inserted in the map before the threads add the
+    // triangles around the points to them.
+    std::vector< OutputQEType * >       edges;
+    std::vector< QuadricElementType * > quadrics;
+    while ( it != points->End() )
+      {
+      p_id = it->Index();
+
+      qe = output->FindEdge(p_id);
+      if ( qe != ITK_NULLPTR )
+        {
+        edges.push_back(qe);
+        quadrics.push_back( &m_Quadric[p_id] );
+        }
+      ++it;
+      }
+
+    if ( !edges.empty() )
+      {
+      QuadricThreadStruct str;
+      str.Filter = this;
+      str.Edges = &edges[0];
+      str.Quadrics = &quadrics[0];
+      str.NumberOfPoints = static_cast< SizeValueType >( edges.size() );
+
+      this->GetMultiThreader()->SetNumberOfThreads( this->GetNumberOfThreads() );
+      this->GetMultiThreader()->SetSingleMethod( this->QuadricThreaderCallback, &str );
+      this->GetMultiThreader()->SingleMethodExecute();
+      }
+    return;
+    }
+
   while ( it != points->End() )
     {
     p_id = it->Index();
@@ -65,6 +100,34 @@ QuadricDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >
     }
 }
 
+template< typename TInput, typename TOutput, typename TCriterion >
+ITK_THREAD_RETURN_TYPE
+QuadricDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >
+::QuadricThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  const QuadricThreadStruct *      str = static_cast< const QuadricThreadStruct * >( info->UserData );
+
+  OutputMeshType *outputMesh = str->Filter->m_OutputMesh;
+
+  // contiguous ranges of points
+  const SizeValueType begin = str->NumberOfPoints * info->ThreadID / info->NumberOfThreads;
+  const SizeValueType end = str->NumberOfPoints * ( info->ThreadID + 1 ) / info->NumberOfThreads;
+  for ( SizeValueType i = begin; i < end; ++i )
+    {
+    OutputQEType *qe = str->Edges[i];
+    OutputQEType *qe_it = qe;
+    do
+      {
+      str->Filter->QuadricAtOrigin(qe_it, *str->Quadrics[i], outputMesh);
+      qe_it = qe_it->GetOnext();
+      }
+    while ( qe_it != qe );
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
 template< typename TInput, typename TOutput, typename TCriterion >
 void
 QuadricDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >
@@ -87,12 +150,10 @@ QuadricDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >
 {
   OutputPointIdentifier id_org = iEdge->GetOrigin();
   OutputPointIdentifier id_dest = iEdge->GetDestination();
-  QuadricElementType    Q = m_Quadric[id_org] + m_Quadric[id_dest];
-
-  OutputMeshPointer output = this->GetOutput();
+  QuadricElementType    Q = this->GetQuadric(id_org) + this->GetQuadric(id_dest);
 
-  OutputPointType org = output->GetPoint(id_org);
-  OutputPointType dest = output->GetPoint(id_dest);
+  OutputPointType org = this->m_OutputMesh->GetPoint(id_org);
+  OutputPointType dest = this->m_OutputMesh->GetPoint(id_dest);
 
   OutputPointType mid;
 
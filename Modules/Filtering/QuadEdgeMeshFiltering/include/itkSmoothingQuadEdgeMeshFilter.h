@@ -42,6 +42,15 @@ namespace itk
  * This process is then repeated for m_NumberOfIterations (the more iterations,
  * the smoother the output mesh will be).
  *
+ * By default, the first iteration reads the locations of the input, and
+ * the next ones move the points in place, in the order of the points
+ * container: a point is moved toward locations already updated by the
+ * iteration (Gauss-Seidel iterations). When UseJacobiIterations is on,
+ * each iteration computes the new locations from the locations of the
+ * previous iteration only: the points are then processed by the threads of
+ * the filter, and the result does not depend on their number, but differs
+ * from the default one.
+ *
  * At each iteration, one can run DelaunayConformingQuadEdgeMeshFilter
  * resulting a more regular (in terms of connectivity) and smoother mesh.
  * Depending on the mesh size and configuration it could be an expensive
@@ -105,6 +114,13 @@ public:
   itkSetMacro(RelaxationFactor, OutputCoordType);
   itkGetConstMacro(RelaxationFactor, OutputCoordType);
 
+  /** Set/Get if each iteration only reads the locations of the previous
+   * one, and is computed by the threads of the filter. Default is false:
+   * the points are moved in place by a single thread. */
+  itkSetMacro(UseJacobiIterations, bool);
+  itkGetConstMacro(UseJacobiIterations, bool);
+  itkBooleanMacro(UseJacobiIterations);
+
 protected:
   SmoothingQuadEdgeMeshFilter();
   ~SmoothingQuadEdgeMeshFilter();
@@ -128,8 +144,31 @@ protected:
 
   OutputCoordType m_RelaxationFactor;
 
+  bool m_UseJacobiIterations;
+
   void GenerateData() ITK_OVERRIDE;
 
+  /** Compute the new locations of the points [begin, end) of the smoothing
+   * of the mesh. */
+  void SmoothPoints(const OutputMeshType *mesh,
+                    const OutputPointType * const *inputPoints,
+                    OutputPointType **outputPoints,
+                    SizeValueType begin, SizeValueType end) const;
+
+  /** Static function used as a "callback" by the MultiThreader. */
+  static ITK_THREAD_RETURN_TYPE SmoothPointsThreaderCallback(void *arg);
+
+  /** Internal structure used for passing the points of an iteration to
+   * the threads. */
+  struct SmoothingThreadStruct
+    {
+    const Self *                   Filter;
+    const OutputMeshType *         Mesh;
+    const OutputPointType * const *InputPoints;
+    OutputPointType **             OutputPoints;
+    SizeValueType                  NumberOfPoints;
+    };
+
 private:
   SmoothingQuadEdgeMeshFilter(const Self &);
   void operator=(const Self &);
@@ -31,6 +31,7 @@ SmoothingQuadEdgeMeshFilter< TInputMesh, TOutputMesh >
   this->m_DelaunayConforming = false;
   this->m_NumberOfIterations = 1;
   this->m_RelaxationFactor = static_cast< OutputCoordType >( 1.0 );
+  this->m_UseJacobiIterations = false;
 
   this->m_InputDelaunayFilter = InputOutputDelaunayConformingType::New();
   this->m_OutputDelaunayFilter = OutputDelaunayConformingType::New();
@@ -52,29 +53,20 @@ SetCoefficientsMethod(CoefficientsComputation *iMethod)
 template< typename TInputMesh, typename TOutputMesh >
 void SmoothingQuadEdgeMeshFilter< TInputMesh, TOutputMesh >::GenerateData()
 {
-  OutputPointIdentifier numberOfPoints = this->GetInput()->GetNumberOfPoints();
-
-  ProgressReporter progress( this, 0, m_NumberOfIterations * ( numberOfPoints + 1 ), 100 );
+  ProgressReporter progress( this, 0, m_NumberOfIterations + 1 );
 
   OutputMeshPointer mesh = OutputMeshType::New();
 
-  OutputPointsContainerPointer temp = OutputPointsContainer::New();
-  temp->Reserve( numberOfPoints );
-
-  OutputPointsContainerPointer  points;
-  OutputPointsContainerIterator it;
-
-  OutputPointType  p;
-  OutputPointType  q;
-  OutputPointType  r;
-  OutputVectorType v;
-
-  OutputCoordType coeff;
-  OutputCoordType sum_coeff;
-  OutputCoordType den;
+  // The new locations are written to the first container, or to the one of
+  // these containers which does not hold the locations of the previous
+  // iteration in the Jacobi iterations.
+  OutputPointsContainerPointer buffers[2];
+  buffers[0] = OutputPointsContainer::New();
+  buffers[1] = OutputPointsContainer::New();
 
-  OutputQEType *qe;
-  OutputQEType *qe_it;
+  std::vector< OutputPointIdentifier >   pointIds;
+  std::vector< const OutputPointType * > inputPoints;
+  std::vector< OutputPointType * >       outputPoints;
 
   if ( this->m_DelaunayConforming )
     {
@@ -102,46 +94,63 @@ void SmoothingQuadEdgeMeshFilter< TInputMesh, TOutputMesh >::GenerateData()
       CopyMeshToMesh(this->GetInput(), mesh.GetPointer());
       }
     }
+  progress.CompletedPixel();
 
   for ( unsigned int iter = 0; iter < m_NumberOfIterations; ++iter )
     {
-    points = mesh->GetPoints();
-
-    for ( it = points->Begin(); it != points->End(); ++it )
+    OutputPointsContainerPointer points = mesh->GetPoints();
+    OutputPointsContainerPointer temp = buffers[0];
+    if ( m_UseJacobiIterations )
       {
-      p = it.Value();
-      qe = p.GetEdge();
-      if ( qe != ITK_NULLPTR )
+      temp = buffers[iter % 2];
+      if ( temp == points )
         {
-        r = p;
-        v.Fill(0.0);
-        qe_it = qe;
-        sum_coeff = 0.;
-        do
-          {
-          q = mesh->GetPoint( qe_it->GetDestination() );
-
-          coeff = ( *m_CoefficientsMethod )( mesh, qe_it );
-          sum_coeff += coeff;
-
-          v += coeff * ( q - p );
-          qe_it = qe_it->GetOnext();
-          }
-        while ( qe_it != qe );
-
-        den = 1.0 / static_cast< OutputCoordType >( sum_coeff );
-        v *= den;
-
-        r += m_RelaxationFactor * v;
-        r.SetEdge(qe);
-        temp->SetElement(it.Index(), r);
-        }
-      else
-        {
-        temp->SetElement(it.Index(), p);
+        temp = buffers[( iter + 1 ) % 2];
         }
+      }
 
-      progress.CompletedPixel();
+    // Create the points of the new locations before taking their
+    // addresses, which may change when a point is created.
+    if ( temp->Size() != points->Size() )
+      {
+      temp->Initialize();
+      }
+    pointIds.clear();
+    inputPoints.clear();
+    for ( OutputPointsContainerIterator it = points->Begin(); it != points->End(); ++it )
+      {
+      pointIds.push_back( it.Index() );
+      inputPoints.push_back( &it.Value() );
+      temp->CreateElementAt( it.Index() );
+      }
+    outputPoints.resize( pointIds.size() );
+    for ( size_t i = 0; i < pointIds.size(); ++i )
+      {
+      outputPoints[i] = &temp->ElementAt( pointIds[i] );
+      }
+
+    if ( pointIds.empty() )
+      {
+      // nothing to smooth
+      }
+    else if ( !m_UseJacobiIterations )
+      {
+      // in place, in the order of the container, after the first iteration
+      this->SmoothPoints( mesh, &inputPoints[0], &outputPoints[0], 0,
+                          static_cast< SizeValueType >( pointIds.size() ) );
+      }
+    else
+      {
+      SmoothingThreadStruct str;
+      str.Filter = this;
+      str.Mesh = mesh;
+      str.InputPoints = &inputPoints[0];
+      str.OutputPoints = &outputPoints[0];
+      str.NumberOfPoints = static_cast< SizeValueType >( pointIds.size() );
+
+      this->GetMultiThreader()->SetNumberOfThreads( this->GetNumberOfThreads() );
+      this->GetMultiThreader()->SetSingleMethod( this->SmoothPointsThreaderCallback, &str );
+      this->GetMultiThreader()->SingleMethodExecute();
       }
 
     mesh->SetPoints(temp);
@@ -173,6 +182,77 @@ void SmoothingQuadEdgeMeshFilter< TInputMesh, TOutputMesh >::GenerateData()
     }
 }
 
+template< typename TInputMesh, typename TOutputMesh >
+void SmoothingQuadEdgeMeshFilter< TInputMesh, TOutputMesh >
+::SmoothPoints(const OutputMeshType *mesh,
+               const OutputPointType * const *inputPoints,
+               OutputPointType **outputPoints,
+               SizeValueType begin, SizeValueType end) const
+{
+  OutputPointType  p;
+  OutputPointType  q;
+  OutputPointType  r;
+  OutputVectorType v;
+
+  OutputCoordType coeff;
+  OutputCoordType sum_coeff;
+  OutputCoordType den;
+
+  OutputQEType *qe;
+  OutputQEType *qe_it;
+
+  for ( SizeValueType i = begin; i < end; ++i )
+    {
+    p = *inputPoints[i];
+    qe = p.GetEdge();
+    if ( qe != ITK_NULLPTR )
+      {
+      r = p;
+      v.Fill(0.0);
+      qe_it = qe;
+      sum_coeff = 0.;
+      do
+        {
+        q = mesh->GetPoint( qe_it->GetDestination() );
+
+        coeff = ( *m_CoefficientsMethod )( mesh, qe_it );
+        sum_coeff += coeff;
+
+        v += coeff * ( q - p );
+        qe_it = qe_it->GetOnext();
+        }
+      while ( qe_it != qe );
+
+      den = 1.0 / static_cast< OutputCoordType >( sum_coeff );
+      v *= den;
+
+      r += m_RelaxationFactor * v;
+      r.SetEdge(qe);
+      *outputPoints[i] = r;
+      }
+    else
+      {
+      *outputPoints[i] = p;
+      }
+    }
+}
+
+template< typename TInputMesh, typename TOutputMesh >
+ITK_THREAD_RETURN_TYPE
+SmoothingQuadEdgeMeshFilter< TInputMesh, TOutputMesh >
+::SmoothPointsThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  const SmoothingThreadStruct *    str = static_cast< const SmoothingThreadStruct * >( info->UserData );
+
+  // contiguous ranges of points
+  const SizeValueType begin = str->NumberOfPoints * info->ThreadID / info->NumberOfThreads;
+  const SizeValueType end = str->NumberOfPoints * ( info->ThreadID + 1 ) / info->NumberOfThreads;
+  str->Filter->SmoothPoints(str->Mesh, str->InputPoints, str->OutputPoints, begin, end);
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
 template< typename TInputMesh, typename TOutputMesh >
 void SmoothingQuadEdgeMeshFilter< TInputMesh, TOutputMesh >
 ::PrintSelf(std::ostream & os, Indent indent) const
@@ -185,6 +265,8 @@ void SmoothingQuadEdgeMeshFilter< TInputMesh, TOutputMesh >
      << m_NumberOfIterations << std::endl;
   os << indent << "RelaxationFactor: "
      << m_RelaxationFactor << std::endl;
+  os << indent << "UseJacobiIterations: "
+     << (m_UseJacobiIterations ? "On" : "Off") << std::endl;
 }
 }
 
@@ -38,14 +38,13 @@ SquaredEdgeLengthDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion
                                          >::OutputPointType
 SquaredEdgeLengthDecimationQuadEdgeMeshFilter< TInput, TOutput, TCriterion >::Relocate(OutputQEType *iEdge)
 {
-  OutputMeshPointer     output = this->GetOutput();
   OutputPointIdentifier id_org = iEdge->GetOrigin();
   OutputPointIdentifier id_dest = iEdge->GetDestination();
 
   OutputPointType oPt;
 
-  oPt.SetToMidPoint( output->GetPoint(id_org),
-                     output->GetPoint(id_dest) );
+  oPt.SetToMidPoint( this->m_OutputMesh->GetPoint(id_org),
+                     this->m_OutputMesh->GetPoint(id_dest) );
 
   return oPt;
 }
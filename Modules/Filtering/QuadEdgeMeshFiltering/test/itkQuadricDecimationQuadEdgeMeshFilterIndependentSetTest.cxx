@@ -0,0 +1,122 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkQuadEdgeMesh.h"
+#include "itkRegularSphereMeshSource.h"
+#include "itkQuadEdgeMeshDecimationCriteria.h"
+#include "itkQuadricDecimationQuadEdgeMeshFilter.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+typedef itk::QuadEdgeMesh< double, 3 >                  MeshType;
+typedef itk::NumberOfFacesCriterion< MeshType >         CriterionType;
+typedef itk::QuadricDecimationQuadEdgeMeshFilter< MeshType, MeshType, CriterionType >
+                                                        DecimationType;
+
+MeshType::Pointer
+Decimate( MeshType * mesh, unsigned int numberOfFaces, bool useIndependentSetCollapses,
+          unsigned int numberOfThreads, itk::SizeValueType maximumNumberOfCollapses )
+{
+  CriterionType::Pointer criterion = CriterionType::New();
+  criterion->SetTopologicalChange( true );
+  criterion->SetNumberOfElements( numberOfFaces );
+
+  DecimationType::Pointer decimate = DecimationType::New();
+  decimate->SetInput( mesh );
+  decimate->SetCriterion( criterion );
+  decimate->SetUseIndependentSetCollapses( useIndependentSetCollapses );
+  decimate->SetMaximumNumberOfCollapsesPerRound( maximumNumberOfCollapses );
+  decimate->SetNumberOfThreads( numberOfThreads );
+  decimate->Update();
+
+  MeshType::Pointer output = decimate->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+
+bool
+CheckDecimatedMesh( const MeshType * mesh, unsigned int numberOfFaces )
+{
+  // the sphere stays a closed surface of genus 0
+  const long eulerCharacteristic = static_cast< long >( mesh->GetNumberOfPoints() )
+    - static_cast< long >( mesh->GetNumberOfEdges() ) + static_cast< long >( mesh->GetNumberOfFaces() );
+  std::cout << mesh->GetNumberOfFaces() << " faces, " << mesh->GetNumberOfEdges() << " edges, "
+            << mesh->GetNumberOfPoints() << " points" << std::endl;
+  return mesh->GetNumberOfFaces() <= numberOfFaces && mesh->GetNumberOfFaces() + 2 > numberOfFaces
+         && eulerCharacteristic == 2;
+}
+
+bool
+SameMeshes( const MeshType * mesh1, const MeshType * mesh2 )
+{
+  if( mesh1->GetNumberOfPoints() != mesh2->GetNumberOfPoints()
+      || mesh1->GetNumberOfFaces() != mesh2->GetNumberOfFaces() )
+    {
+    return false;
+    }
+  MeshType::PointsContainer::ConstIterator it1 = mesh1->GetPoints()->Begin();
+  MeshType::PointsContainer::ConstIterator it2 = mesh2->GetPoints()->Begin();
+  for( ; it1 != mesh1->GetPoints()->End(); ++it1, ++it2 )
+    {
+    if( it1.Index() != it2.Index() || it1.Value() != it2.Value() )
+      {
+      return false;
+      }
+    }
+  return true;
+}
+}
+
+// Decimate a sphere with rounds of collapses of independent edges, and
+// check that the result does not depend on the number of threads.
+int itkQuadricDecimationQuadEdgeMeshFilterIndependentSetTest( int, char* [] )
+{
+  typedef itk::RegularSphereMeshSource< MeshType > SphereType;
+  SphereType::Pointer sphere = SphereType::New();
+  sphere->SetResolution( 3 );
+  sphere->Update();
+  MeshType::Pointer mesh = sphere->GetOutput();
+
+  DecimationType::Pointer decimate = DecimationType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( decimate, QuadricDecimationQuadEdgeMeshFilter,
+                                 EdgeDecimationQuadEdgeMeshFilter );
+  TEST_SET_GET_BOOLEAN( decimate, UseIndependentSetCollapses, false );
+  TEST_SET_GET_VALUE( 1024, decimate->GetMaximumNumberOfCollapsesPerRound() );
+  decimate->SetMaximumNumberOfCollapsesPerRound( 0 );
+  TEST_SET_GET_VALUE( 1, decimate->GetMaximumNumberOfCollapsesPerRound() );
+
+  const unsigned int numberOfFaces = 100;
+
+  MeshType::Pointer serial = Decimate( mesh, numberOfFaces, false, 1, 1024 );
+  TEST_EXPECT_TRUE( CheckDecimatedMesh( serial, numberOfFaces ) );
+
+  MeshType::Pointer oneThread = Decimate( mesh, numberOfFaces, true, 1, 1024 );
+  TEST_EXPECT_TRUE( CheckDecimatedMesh( oneThread, numberOfFaces ) );
+
+  MeshType::Pointer fourThreads = Decimate( mesh, numberOfFaces, true, 4, 1024 );
+  TEST_EXPECT_TRUE( CheckDecimatedMesh( fourThreads, numberOfFaces ) );
+  TEST_EXPECT_TRUE( SameMeshes( oneThread, fourThreads ) );
+
+  // small rounds
+  MeshType::Pointer smallRounds = Decimate( mesh, numberOfFaces, true, 4, 8 );
+  TEST_EXPECT_TRUE( CheckDecimatedMesh( smallRounds, numberOfFaces ) );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,153 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkQuadEdgeMesh.h"
+#include "itkRegularSphereMeshSource.h"
+#include "itkSmoothingQuadEdgeMeshFilter.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+
+namespace
+{
+typedef itk::QuadEdgeMesh< double, 3 >                         MeshType;
+typedef itk::SmoothingQuadEdgeMeshFilter< MeshType, MeshType > SmoothingType;
+
+const unsigned int NumberOfIterations = 3;
+const double       RelaxationFactor = 0.5;
+
+MeshType::Pointer
+Smooth( MeshType * mesh, bool useJacobiIterations, unsigned int numberOfThreads )
+{
+  itk::OnesMatrixCoefficients< MeshType > coefficients;
+
+  SmoothingType::Pointer filter = SmoothingType::New();
+  filter->SetInput( mesh );
+  filter->SetNumberOfIterations( NumberOfIterations );
+  filter->SetRelaxationFactor( RelaxationFactor );
+  filter->SetDelaunayConforming( false );
+  filter->SetCoefficientsMethod( &coefficients );
+  filter->SetUseJacobiIterations( useJacobiIterations );
+  filter->SetNumberOfThreads( numberOfThreads );
+  filter->Update();
+
+  MeshType::Pointer output = filter->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+
+// Move the points toward the centroids of their neighbors, reading the
+// locations of the previous iteration only, or the locations already
+// updated by the iteration after the first one.
+std::vector< MeshType::PointType >
+ExpectedLocations( MeshType * mesh, bool useJacobiIterations )
+{
+  const MeshType::PointIdentifier numberOfPoints = mesh->GetNumberOfPoints();
+
+  std::vector< MeshType::PointType > expected( numberOfPoints );
+  for( MeshType::PointIdentifier i = 0; i < numberOfPoints; ++i )
+    {
+    expected[i] = mesh->GetPoint( i );
+    }
+  for( unsigned int iter = 0; iter < NumberOfIterations; ++iter )
+    {
+    const std::vector< MeshType::PointType > previous = expected;
+    const std::vector< MeshType::PointType > & neighbors =
+      ( useJacobiIterations || iter == 0 ) ? previous : expected;
+    for( MeshType::PointIdentifier i = 0; i < numberOfPoints; ++i )
+      {
+      MeshType::QEType *    qe = mesh->FindEdge( i );
+      MeshType::QEType *    qe_it = qe;
+      MeshType::VectorType  v;
+      v.Fill( 0.0 );
+      unsigned int          numberOfNeighbors = 0;
+      do
+        {
+        v += neighbors[qe_it->GetDestination()] - expected[i];
+        ++numberOfNeighbors;
+        qe_it = qe_it->GetOnext();
+        }
+      while( qe_it != qe );
+      expected[i] = expected[i] + v * ( RelaxationFactor / numberOfNeighbors );
+      }
+    }
+  return expected;
+}
+}
+
+// Smooth a bumpy sphere with several threads, and compare the result to
+// the iterations computed here, where every point moves toward the
+// centroid of its neighbors: in place by default, and at the previous
+// iteration with the Jacobi iterations.
+int itkSmoothingQuadEdgeMeshFilterThreadedTest( int, char* [] )
+{
+  typedef itk::RegularSphereMeshSource< MeshType > SphereType;
+  SphereType::Pointer sphere = SphereType::New();
+  sphere->SetResolution( 2 );
+  sphere->Update();
+  MeshType::Pointer mesh = sphere->GetOutput();
+  mesh->DisconnectPipeline();
+
+  const MeshType::PointIdentifier numberOfPoints = mesh->GetNumberOfPoints();
+  for( MeshType::PointIdentifier i = 0; i < numberOfPoints; ++i )
+    {
+    MeshType::PointType & point = mesh->GetPoints()->ElementAt( i );
+    const double          bump = 1.0 + 0.2 * std::sin( 3.0 * i );
+    for( unsigned int d = 0; d < 3; ++d )
+      {
+      point[d] *= bump;
+      }
+    }
+
+  SmoothingType::Pointer filter = SmoothingType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( filter, SmoothingQuadEdgeMeshFilter, QuadEdgeMeshToQuadEdgeMeshFilter );
+  TEST_SET_GET_BOOLEAN( filter, UseJacobiIterations, false );
+
+  MeshType::Pointer oneThread;
+  for( unsigned int useJacobiIterations = 0; useJacobiIterations < 2; ++useJacobiIterations )
+    {
+    const std::vector< MeshType::PointType > expected = ExpectedLocations( mesh, useJacobiIterations );
+
+    oneThread = Smooth( mesh, useJacobiIterations, 1 );
+    MeshType::Pointer fourThreads = Smooth( mesh, useJacobiIterations, 4 );
+    TEST_EXPECT_EQUAL( numberOfPoints, oneThread->GetNumberOfPoints() );
+    TEST_EXPECT_EQUAL( numberOfPoints, fourThreads->GetNumberOfPoints() );
+
+    for( MeshType::PointIdentifier i = 0; i < numberOfPoints; ++i )
+      {
+      const MeshType::PointType p = oneThread->GetPoint( i );
+      if( p != fourThreads->GetPoint( i ) )
+        {
+        std::cerr << "The location of the point " << i << " depends on the number of threads" << std::endl;
+        return EXIT_FAILURE;
+        }
+      if( p.EuclideanDistanceTo( expected[i] ) > 1e-10 )
+        {
+        std::cerr << "UseJacobiIterations " << useJacobiIterations << ": wrong location of the point "
+                  << i << ": " << p << " instead of " << expected[i] << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  // the input is not modified
+  TEST_EXPECT_TRUE( mesh->GetPoint( 0 ).EuclideanDistanceTo( oneThread->GetPoint( 0 ) ) > 1e-6 );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,151 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkRecursiveGaussianImageFilter.h"
+#include "itkVectorImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+// Compare the line batched implementation of the recursive filter against
+// the line by line implementation, on a scalar image and, component by
+// component, on a vector image.
+int itkRecursiveGaussianImageFilterLineBatchTest(int, char* [] )
+{
+  const unsigned int Dimension = 3;
+  const unsigned int NumberOfComponents = 3;
+  const double       tolerance = 1e-4;
+
+  typedef itk::Image< float, Dimension >       ScalarImageType;
+  typedef itk::VectorImage< float, Dimension > VectorImageType;
+
+  typedef itk::RecursiveGaussianImageFilter< ScalarImageType, ScalarImageType > ScalarFilterType;
+  typedef itk::RecursiveGaussianImageFilter< VectorImageType, VectorImageType > VectorFilterType;
+
+  // Odd sizes, so that the number of lines is not a multiple of the batch
+  ScalarImageType::SizeType size;
+  size[0] = 17;
+  size[1] = 13;
+  size[2] = 11;
+  ScalarImageType::RegionType region( size );
+
+  std::vector< ScalarImageType::Pointer > componentImages;
+  for ( unsigned int c = 0; c < NumberOfComponents; ++c )
+    {
+    ScalarImageType::Pointer image = ScalarImageType::New();
+    image->SetRegions( region );
+    image->Allocate();
+    itk::ImageRegionIterator< ScalarImageType > it( image, region );
+    unsigned int n = 0;
+    for ( it.GoToBegin(); !it.IsAtEnd(); ++it, ++n )
+      {
+      it.Set( static_cast< float >( ( ( n * 7919u + c * 104729u ) % 1009u ) / 10.0 ) );
+      }
+    componentImages.push_back( image );
+    }
+
+  VectorImageType::Pointer vectorImage = VectorImageType::New();
+  vectorImage->SetRegions( region );
+  vectorImage->SetNumberOfComponentsPerPixel( NumberOfComponents );
+  vectorImage->Allocate();
+  itk::ImageRegionIterator< VectorImageType > vit( vectorImage, region );
+  VectorImageType::PixelType vectorPixel( NumberOfComponents );
+  for ( vit.GoToBegin(); !vit.IsAtEnd(); ++vit )
+    {
+    for ( unsigned int c = 0; c < NumberOfComponents; ++c )
+      {
+      vectorPixel[c] = componentImages[c]->GetPixel( vit.GetIndex() );
+      }
+    vit.Set( vectorPixel );
+    }
+
+  ScalarFilterType::Pointer filter = ScalarFilterType::New();
+  TEST_SET_GET_VALUE( 8u, filter->GetNumberOfLinesPerBatch() );
+  filter->SetNumberOfLinesPerBatch( 0 );
+  TEST_SET_GET_VALUE( 1u, filter->GetNumberOfLinesPerBatch() );
+
+  const ScalarFilterType::OrderEnumType orders[3] =
+    { ScalarFilterType::ZeroOrder, ScalarFilterType::FirstOrder, ScalarFilterType::SecondOrder };
+  const unsigned int batchSizes[3] = { 3, 8, 16 };
+
+  for ( unsigned int direction = 0; direction < Dimension; ++direction )
+    {
+    for ( unsigned int o = 0; o < 3; ++o )
+      {
+      std::vector< ScalarImageType::Pointer > references;
+      for ( unsigned int c = 0; c < NumberOfComponents; ++c )
+        {
+        ScalarFilterType::Pointer reference = ScalarFilterType::New();
+        reference->SetInput( componentImages[c] );
+        reference->SetDirection( direction );
+        reference->SetOrder( orders[o] );
+        reference->SetSigma( 2.0 );
+        reference->SetNumberOfLinesPerBatch( 1 );
+        TRY_EXPECT_NO_EXCEPTION( reference->Update() );
+        references.push_back( reference->GetOutput() );
+        }
+
+      for ( unsigned int b = 0; b < 3; ++b )
+        {
+        ScalarFilterType::Pointer scalarFilter = ScalarFilterType::New();
+        scalarFilter->SetInput( componentImages[0] );
+        scalarFilter->SetDirection( direction );
+        scalarFilter->SetOrder( orders[o] );
+        scalarFilter->SetSigma( 2.0 );
+        scalarFilter->SetNumberOfLinesPerBatch( batchSizes[b] );
+        TRY_EXPECT_NO_EXCEPTION( scalarFilter->Update() );
+
+        VectorFilterType::Pointer vectorFilter = VectorFilterType::New();
+        vectorFilter->SetInput( vectorImage );
+        vectorFilter->SetDirection( direction );
+        vectorFilter->SetOrder( static_cast< VectorFilterType::OrderEnumType >( orders[o] ) );
+        vectorFilter->SetSigma( 2.0 );
+        vectorFilter->SetNumberOfLinesPerBatch( batchSizes[b] );
+        TRY_EXPECT_NO_EXCEPTION( vectorFilter->Update() );
+
+        itk::ImageRegionConstIterator< VectorImageType > oit( vectorFilter->GetOutput(), region );
+        for ( oit.GoToBegin(); !oit.IsAtEnd(); ++oit )
+          {
+          const ScalarImageType::IndexType index = oit.GetIndex();
+          const double scalarDifference =
+            scalarFilter->GetOutput()->GetPixel( index ) - references[0]->GetPixel( index );
+          if ( itk::Math::abs( scalarDifference ) > tolerance )
+            {
+            std::cerr << "Scalar mismatch at " << index << " direction " << direction
+                      << " order " << o << " batch " << batchSizes[b] << std::endl;
+            return EXIT_FAILURE;
+            }
+          for ( unsigned int c = 0; c < NumberOfComponents; ++c )
+            {
+            const double vectorDifference = oit.Get()[c] - references[c]->GetPixel( index );
+            if ( itk::Math::abs( vectorDifference ) > tolerance )
+              {
+              std::cerr << "Vector mismatch at " << index << " component " << c
+                        << " direction " << direction << " order " << o
+                        << " batch " << batchSizes[b] << std::endl;
+              return EXIT_FAILURE;
+              }
+            }
+          }
+        }
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
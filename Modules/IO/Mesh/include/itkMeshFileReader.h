@@ -126,6 +126,14 @@ public:
   void  SetMeshIO(MeshIOBase *meshIO);
   itkGetModifiableObjectMacro(MeshIO, MeshIOBase);
 
+  /** Set/Get whether the cells are read into the flat arrays of the output
+   * mesh (see Mesh::SetCellsArrays()) instead of cell objects allocated one
+   * by one.  The cell identifiers are the same in both cases.  Defaults to
+   * false. */
+  itkSetMacro(UseCellsArrays, bool);
+  itkGetConstMacro(UseCellsArrays, bool);
+  itkBooleanMacro(UseCellsArrays);
+
   /** Prepare the allocation of the output mesh during the first back
    * propagation of the pipeline. */
   virtual void GenerateOutputInformation() ITK_OVERRIDE;
@@ -136,6 +144,9 @@ public:
   template< typename T >
   void ReadCells(T *buffer);
 
+  template< typename T >
+  void ReadCellsArrays(T *buffer);
+
   void ReadPointData();
 
   void ReadCellData();
@@ -166,6 +177,7 @@ protected:
   bool                m_UserSpecifiedMeshIO; // keep track whether the MeshIO is
                                              // user specified
   std::string m_FileName;                    // The file to be read
+  bool        m_UseCellsArrays;
 
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(MeshFileReader);
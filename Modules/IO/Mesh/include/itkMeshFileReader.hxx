@@ -29,6 +29,7 @@
 
 #include <itksys/SystemTools.hxx>
 #include <fstream>
+#include <algorithm>
 
 namespace itk
 {
@@ -39,6 +40,7 @@ MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
   m_MeshIO = ITK_NULLPTR;
   m_FileName = "";
   m_UserSpecifiedMeshIO = false;
+  m_UseCellsArrays = false;
 }
 
 template< typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits >
@@ -60,6 +62,7 @@ MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
 
   os << indent << "UserSpecifiedMeshIO flag: " << m_UserSpecifiedMeshIO << "\n";
   os << indent << "FileName: " << m_FileName << "\n";
+  os << indent << "UseCellsArrays: " << m_UseCellsArrays << "\n";
 }
 
 template< typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits >
@@ -140,6 +143,12 @@ void
 MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
 ::ReadCells(T *buffer)
 {
+  if ( m_UseCellsArrays )
+    {
+    this->ReadCellsArrays(buffer);
+    return;
+    }
+
   typename TOutputMesh::Pointer output = this->GetOutput();
 
   SizeValueType        index = NumericTraits< SizeValueType >::ZeroValue();
@@ -338,6 +347,106 @@ MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
     }
 }
 
+template< typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits >
+template< typename T >
+void
+MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
+::ReadCellsArrays(T *buffer)
+{
+  typedef typename OutputMeshType::CellTypesContainer        CellTypesContainer;
+  typedef typename OutputMeshType::CellOffsetsContainer      CellOffsetsContainer;
+  typedef typename OutputMeshType::CellConnectivityContainer CellConnectivityContainer;
+
+  typename CellTypesContainer::Pointer        typesContainer = CellTypesContainer::New();
+  typename CellOffsetsContainer::Pointer      offsetsContainer = CellOffsetsContainer::New();
+  typename CellConnectivityContainer::Pointer connectivityContainer = CellConnectivityContainer::New();
+
+  typename CellTypesContainer::STLContainerType &        types = typesContainer->CastToSTLContainer();
+  typename CellOffsetsContainer::STLContainerType &      offsets = offsetsContainer->CastToSTLContainer();
+  typename CellConnectivityContainer::STLContainerType & connectivity = connectivityContainer->CastToSTLContainer();
+
+  // The buffer holds the type and the number of points of each cell before
+  // its point identifiers.
+  const SizeValueType bufferSize = m_MeshIO->GetCellBufferSize();
+  types.reserve( m_MeshIO->GetNumberOfCells() );
+  offsets.reserve( m_MeshIO->GetNumberOfCells() + 1 );
+  connectivity.reserve( bufferSize - std::min( bufferSize, 2 * m_MeshIO->GetNumberOfCells() ) );
+
+  SizeValueType index = NumericTraits< SizeValueType >::ZeroValue();
+  while ( index < bufferSize )
+    {
+    MeshIOBase::CellGeometryType type = static_cast< MeshIOBase::CellGeometryType >( static_cast< int >( buffer[index++] ) );
+    const unsigned int numberOfPoints = static_cast< unsigned int >( buffer[index++] );
+    switch ( type )
+      {
+      case MeshIOBase::LINE_CELL:
+        {
+        // for polylines will be loaded as individual edges.
+        if ( numberOfPoints < 2 )
+          {
+          itkExceptionMacro(<< "Invalid Line Cell with number of points = " << numberOfPoints);
+          }
+        for ( unsigned int jj = 1; jj < numberOfPoints; ++jj )
+          {
+          types.push_back( static_cast< unsigned char >( OutputCellType::LINE_CELL ) );
+          offsets.push_back( connectivity.size() );
+          connectivity.push_back( static_cast< OutputPointIdentifier >( buffer[index + jj - 1] ) );
+          connectivity.push_back( static_cast< OutputPointIdentifier >( buffer[index + jj] ) );
+          }
+        index += numberOfPoints;
+        continue;
+        }
+      case MeshIOBase::VERTEX_CELL:
+        types.push_back( static_cast< unsigned char >( OutputCellType::VERTEX_CELL ) );
+        break;
+      case MeshIOBase::TRIANGLE_CELL:
+        types.push_back( static_cast< unsigned char >( OutputCellType::TRIANGLE_CELL ) );
+        break;
+      case MeshIOBase::QUADRILATERAL_CELL:
+        types.push_back( static_cast< unsigned char >( OutputCellType::QUADRILATERAL_CELL ) );
+        break;
+      case MeshIOBase::POLYGON_CELL:
+        // For polyhedron, if the number of points is 3, then we treat it as
+        // triangle cell
+        if ( numberOfPoints == OutputTriangleCellType::NumberOfPoints )
+          {
+          types.push_back( static_cast< unsigned char >( OutputCellType::TRIANGLE_CELL ) );
+          }
+        else
+          {
+          types.push_back( static_cast< unsigned char >( OutputCellType::POLYGON_CELL ) );
+          }
+        break;
+      case MeshIOBase::TETRAHEDRON_CELL:
+        types.push_back( static_cast< unsigned char >( OutputCellType::TETRAHEDRON_CELL ) );
+        break;
+      case MeshIOBase::HEXAHEDRON_CELL:
+        types.push_back( static_cast< unsigned char >( OutputCellType::HEXAHEDRON_CELL ) );
+        break;
+      case MeshIOBase::QUADRATIC_EDGE_CELL:
+        types.push_back( static_cast< unsigned char >( OutputCellType::QUADRATIC_EDGE_CELL ) );
+        break;
+      case MeshIOBase::QUADRATIC_TRIANGLE_CELL:
+        types.push_back( static_cast< unsigned char >( OutputCellType::QUADRATIC_TRIANGLE_CELL ) );
+        break;
+      default:
+        {
+        itkExceptionMacro(<< "Unknown cell type");
+        }
+      }
+
+    offsets.push_back( connectivity.size() );
+    for ( unsigned int jj = 0; jj < numberOfPoints; ++jj )
+      {
+      connectivity.push_back( static_cast< OutputPointIdentifier >( buffer[index++] ) );
+      }
+    }
+  offsets.push_back( connectivity.size() );
+
+  // The number of points of each cell is checked by the mesh.
+  this->GetOutput()->SetCellsArrays(typesContainer, offsetsContainer, connectivityContainer);
+}
+
 template< typename TOutputMesh, typename ConvertPointPixelTraits, typename ConvertCellPixelTraits >
 void
 MeshFileReader< TOutputMesh, ConvertPointPixelTraits, ConvertCellPixelTraits >
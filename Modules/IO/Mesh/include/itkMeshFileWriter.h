@@ -136,6 +136,11 @@ protected:
   template< typename Output >
   void CopyCellsToBuffer(Output *data);
 
+  /** Copy the type, the number of points and the point identifiers of a
+   * cell to the buffer. */
+  template< typename Output >
+  void CopyCellToBuffer(const typename InputMeshType::CellView & cell, Output *data, SizeValueType & index);
+
   template< typename Output >
   void CopyPointDataToBuffer(Output *data);
 
@@ -178,12 +178,19 @@ MeshFileWriter< TInputMesh >
     }
 
   // Whether write cells
-  if ( input->GetCells() && input->GetNumberOfCells() )
+  if ( ( input->HasCellsArrays() || input->GetCells() ) && input->GetNumberOfCells() )
     {
     SizeValueType cellsBufferSize = 2 * input->GetNumberOfCells();
-    for ( typename TInputMesh::CellsContainerConstIterator ct = input->GetCells()->Begin(); ct != input->GetCells()->End(); ++ct )
+    if ( input->HasCellsArrays() )
       {
-      cellsBufferSize += ct->Value()->GetNumberOfPoints();
+      cellsBufferSize += input->GetCellConnectivityContainer()->Size();
+      }
+    else
+      {
+      for ( typename TInputMesh::CellsContainerConstIterator ct = input->GetCells()->Begin(); ct != input->GetCells()->End(); ++ct )
+        {
+        cellsBufferSize += ct->Value()->GetNumberOfPoints();
+        }
       }
     m_MeshIO->SetCellBufferSize(cellsBufferSize);
     m_MeshIO->SetUpdateCells(true);
@@ -223,7 +230,7 @@ MeshFileWriter< TInputMesh >
     }
 
   // Write cells
-  if ( input->GetCells() && input->GetNumberOfCells() )
+  if ( ( input->HasCellsArrays() || input->GetCells() ) && input->GetNumberOfCells() )
     {
     WriteCells();
     }
@@ -355,65 +362,85 @@ MeshFileWriter< TInputMesh >
 ::CopyCellsToBuffer(Output *data)
 {
   // Get input mesh pointer
-  const typename InputMeshType::CellsContainer * cells = this->GetInput()->GetCells();
+  const InputMeshType *input = this->GetInput();
 
-  // Define required variables
-  typename TInputMesh::PointIdentifier const  *ptIds;
-  typename TInputMesh::CellType * cellPtr;
+  typedef typename InputMeshType::CellView       CellViewType;
+  typedef typename InputMeshType::CellIdentifier CellIdentifier;
 
   // For each cell
   SizeValueType index = NumericTraits< SizeValueType >::ZeroValue();
+  CellViewType  cell;
+  if ( input->HasCellsArrays() )
+    {
+    const CellIdentifier numberOfCells = input->GetNumberOfCells();
+    for ( CellIdentifier cellId = 0; cellId < numberOfCells; ++cellId )
+      {
+      input->GetCellView(cellId, cell);
+      this->CopyCellToBuffer(cell, data, index);
+      }
+    return;
+    }
+
+  const typename InputMeshType::CellsContainer * cells = input->GetCells();
   typename TInputMesh::CellsContainerConstIterator cter = cells->Begin();
   while ( cter != cells->End() )
     {
-    cellPtr = cter.Value();
+    const typename TInputMesh::CellType * cellPtr = cter.Value();
+    cell = CellViewType( cellPtr->GetType(), cellPtr->GetNumberOfPoints(), cellPtr->GetPointIds() );
+    this->CopyCellToBuffer(cell, data, index);
 
-    // Write the cell type
-    switch ( cellPtr->GetType() )
-      {
-      case InputMeshCellType::VERTEX_CELL:
-        data[index++] = static_cast< Output >( MeshIOBase::VERTEX_CELL );
-        break;
-      case InputMeshCellType::LINE_CELL:
-        data[index++] = static_cast< Output >( MeshIOBase::LINE_CELL );
-        break;
-      case InputMeshCellType::TRIANGLE_CELL:
-        data[index++] = static_cast< Output >( MeshIOBase::TRIANGLE_CELL );
-        break;
-      case InputMeshCellType::QUADRILATERAL_CELL:
-        data[index++] = static_cast< Output >( MeshIOBase::QUADRILATERAL_CELL );
-        break;
-      case InputMeshCellType::POLYGON_CELL:
-        data[index++] = static_cast< Output >( MeshIOBase::POLYGON_CELL );
-        break;
-      case InputMeshCellType::TETRAHEDRON_CELL:
-        data[index++] = static_cast< Output >( MeshIOBase::TETRAHEDRON_CELL );
-        break;
-      case InputMeshCellType::HEXAHEDRON_CELL:
-        data[index++] = static_cast< Output >( MeshIOBase::HEXAHEDRON_CELL );
-        break;
-      case InputMeshCellType::QUADRATIC_EDGE_CELL:
-        data[index++] = static_cast< Output >( MeshIOBase::QUADRATIC_EDGE_CELL );
-        break;
-      case InputMeshCellType::QUADRATIC_TRIANGLE_CELL:
-        data[index++] = static_cast< Output >( MeshIOBase::QUADRATIC_TRIANGLE_CELL );
-        break;
-      default:
-        itkExceptionMacro(<< "Unknown mesh cell");
-      }
+    ++cter;
+    }
+}
 
-    // The second element is number of points for each cell
-    data[index++] = cellPtr->GetNumberOfPoints();
+template< typename TInputMesh >
+template< typename Output >
+void
+MeshFileWriter< TInputMesh >
+::CopyCellToBuffer(const typename InputMeshType::CellView & cell, Output *data, SizeValueType & index)
+{
+  // Write the cell type
+  switch ( cell.GetType() )
+    {
+    case InputMeshCellType::VERTEX_CELL:
+      data[index++] = static_cast< Output >( MeshIOBase::VERTEX_CELL );
+      break;
+    case InputMeshCellType::LINE_CELL:
+      data[index++] = static_cast< Output >( MeshIOBase::LINE_CELL );
+      break;
+    case InputMeshCellType::TRIANGLE_CELL:
+      data[index++] = static_cast< Output >( MeshIOBase::TRIANGLE_CELL );
+      break;
+    case InputMeshCellType::QUADRILATERAL_CELL:
+      data[index++] = static_cast< Output >( MeshIOBase::QUADRILATERAL_CELL );
+      break;
+    case InputMeshCellType::POLYGON_CELL:
+      data[index++] = static_cast< Output >( MeshIOBase::POLYGON_CELL );
+      break;
+    case InputMeshCellType::TETRAHEDRON_CELL:
+      data[index++] = static_cast< Output >( MeshIOBase::TETRAHEDRON_CELL );
+      break;
+    case InputMeshCellType::HEXAHEDRON_CELL:
+      data[index++] = static_cast< Output >( MeshIOBase::HEXAHEDRON_CELL );
+      break;
+    case InputMeshCellType::QUADRATIC_EDGE_CELL:
+      data[index++] = static_cast< Output >( MeshIOBase::QUADRATIC_EDGE_CELL );
+      break;
+    case InputMeshCellType::QUADRATIC_TRIANGLE_CELL:
+      data[index++] = static_cast< Output >( MeshIOBase::QUADRATIC_TRIANGLE_CELL );
+      break;
+    default:
+      itkExceptionMacro(<< "Unknown mesh cell");
+    }
 
-    // Others are point identifiers in the cell
-    ptIds = cellPtr->GetPointIds();
-    unsigned int numberOfPoints = cellPtr->GetNumberOfPoints();
-    for ( unsigned int ii = 0; ii < numberOfPoints; ii++ )
-      {
-      data[index++] = static_cast< Output >( ptIds[ii] );
-      }
+  // The second element is number of points for each cell
+  data[index++] = cell.GetNumberOfPoints();
 
-    ++cter;
+  // Others are point identifiers in the cell
+  const unsigned int numberOfPoints = cell.GetNumberOfPoints();
+  for ( unsigned int ii = 0; ii < numberOfPoints; ii++ )
+    {
+    data[index++] = static_cast< Output >( cell.GetPointId(ii) );
     }
 }
 
@@ -20,7 +20,7 @@
 
 #include "itkHistogram.h"
 #include "itkImageTransformer.h"
-#include "itkBarrier.h"
+#include "itkStreamingReductionImageFilter.h"
 #include "itkSimpleDataObjectDecorator.h"
 #include "itkProgressReporter.h"
 
@@ -36,21 +36,35 @@ namespace Statistics
  *  an histogram from an image. Internally it creates a List that is feed into
  *  the SampleToHistogramFilter.
  *
+ *  The histogram of an image with a single component is counted directly
+ *  in an array of bins per thread: the bin of a pixel is computed from its
+ *  value, since the bins are uniformly spaced, or read in a table indexed
+ *  by the values of the 8 and 16 bits integer pixel types. The result is
+ *  the same as with Histogram::GetIndex().
+ *
+ *  With SetNumberOfStreamDivisions(), the filter reads its input piece by
+ *  piece instead of all at once. When the minimum and maximum of the
+ *  histogram are computed automatically, the input is read twice: once
+ *  to compute the range of the pixel values, and once to fill the
+ *  histogram.
+ *
+ * \sa StreamingReductionImageFilter
  * \ingroup ITKStatistics
  */
 
 template< typename TImage >
-class ITK_TEMPLATE_EXPORT ImageToHistogramFilter:public ImageTransformer<TImage>
+class ITK_TEMPLATE_EXPORT ImageToHistogramFilter:
+  public StreamingReductionImageFilter< TImage, ImageTransformer< TImage > >
 {
 public:
   /** Standard typedefs */
-  typedef ImageToHistogramFilter     Self;
-  typedef ImageTransformer<TImage>   Superclass;
-  typedef SmartPointer< Self >       Pointer;
-  typedef SmartPointer< const Self > ConstPointer;
+  typedef ImageToHistogramFilter                                            Self;
+  typedef StreamingReductionImageFilter< TImage, ImageTransformer< TImage > > Superclass;
+  typedef SmartPointer< Self >                                              Pointer;
+  typedef SmartPointer< const Self >                                        ConstPointer;
 
   /** Run-time type information (and related methods). */
-  itkTypeMacro(ImageToHistogramFilter, ImageTransformer);
+  itkTypeMacro(ImageToHistogramFilter, StreamingReductionImageFilter);
 
   /** standard New() method support */
   itkNewMacro(Self);
@@ -67,6 +81,8 @@ public:
   typedef typename HistogramType::SizeType              HistogramSizeType;
   typedef typename HistogramType::MeasurementType       HistogramMeasurementType;
   typedef typename HistogramType::MeasurementVectorType HistogramMeasurementVectorType;
+  typedef typename HistogramType::IndexValueType        HistogramIndexValueType;
+  typedef typename HistogramType::AbsoluteFrequencyType HistogramAbsoluteFrequencyType;
 
 public:
 
@@ -122,9 +138,13 @@ protected:
   virtual ~ImageToHistogramFilter() {}
   void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
 
-  void BeforeThreadedGenerateData(void) ITK_OVERRIDE;
-  void ThreadedGenerateData(const RegionType & inputRegionForThread, ThreadIdType threadId) ITK_OVERRIDE;
-  void AfterThreadedGenerateData(void) ITK_OVERRIDE;
+  /** Compute the range of the pixel values in a first pass when the
+   * minimum and maximum of the histogram are computed automatically. */
+  unsigned int GetNumberOfPasses() const ITK_OVERRIDE;
+
+  void BeforeStreamedGenerateData(void) ITK_OVERRIDE;
+  void ThreadedStreamedGenerateData(const RegionType & inputRegionForThread, ThreadIdType threadId) ITK_OVERRIDE;
+  void AfterStreamedGenerateData(void) ITK_OVERRIDE;
 
   /** Method that construct the outputs */
   typedef ProcessObject::DataObjectPointerArraySizeType DataObjectPointerArraySizeType;
@@ -138,12 +158,52 @@ protected:
   std::vector< HistogramMeasurementVectorType > m_Minimums;
   std::vector< HistogramMeasurementVectorType > m_Maximums;
 
+  /** Whether the pixels are counted in the scalar bins of the threads,
+   * instead of their histograms. */
+  bool UseScalarBins() const
+  {
+    return !m_ScalarBinCounts.empty();
+  }
+
+  /** Find the bin of a measurement of an image with a single component.
+   * Return false if the measurement is outside of the bins, and the
+   * histogram is clipped. */
+  bool GetScalarBin( HistogramMeasurementType measurement, HistogramIndexValueType & bin ) const;
+
+  /** The counts of the scalar bins, for each thread. */
+  std::vector< std::vector< HistogramAbsoluteFrequencyType > > m_ScalarBinCounts;
+
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(ImageToHistogramFilter);
 
   void ApplyMarginalScale( HistogramMeasurementVectorType & min, HistogramMeasurementVectorType & max, HistogramSizeType & size );
-  typename Barrier::Pointer                     m_Barrier;
 
+  /** Whether the minimum and maximum of the histogram are computed from
+   * the pixel values. */
+  bool IsAutoMinimumMaximum() const;
+
+  /** The histogram size given by the user, or the default one. */
+  HistogramSizeType GetHistogramSizeOrDefault() const;
+
+  /** Initialize the histograms of the threads with the same bins. */
+  void InitializeHistograms( const HistogramSizeType & size, HistogramMeasurementVectorType & min,
+                             HistogramMeasurementVectorType & max );
+
+  /** Prepare the scalar bins from the bins of the histograms, when the
+   * image has a single component and the bins are contiguous. */
+  void InitializeScalarBins();
+
+  /** Add the counts of the scalar bins of the threads to the output. */
+  void MergeScalarBins();
+
+  /** The edges of the scalar bins: bin i is [m_ScalarBinEdges[i],
+   * m_ScalarBinEdges[i+1]). */
+  std::vector< HistogramMeasurementType > m_ScalarBinEdges;
+  double                                  m_ScalarBinScale;
+
+  /** The bin of each value of the 8 and 16 bits integer pixel types, or -1
+   * when the value is clipped. */
+  std::vector< int >                      m_ScalarBinLookupTable;
 };
 } // end of namespace Statistics
 } // end of namespace itk
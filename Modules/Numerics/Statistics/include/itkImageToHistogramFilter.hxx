@@ -27,7 +27,8 @@ namespace Statistics
 {
 template< typename TImage >
 ImageToHistogramFilter< TImage >
-::ImageToHistogramFilter()
+::ImageToHistogramFilter() :
+  m_ScalarBinScale(1.0)
 {
   this->SetNumberOfRequiredInputs(1);
   this->SetNumberOfRequiredOutputs(1);
@@ -98,61 +99,28 @@ ImageToHistogramFilter< TImage >
 
 
 template< typename TImage >
-void
+bool
 ImageToHistogramFilter< TImage >
-::BeforeThreadedGenerateData()
+::IsAutoMinimumMaximum() const
 {
-  // find the actual number of threads
-  long nbOfThreads = this->GetNumberOfThreads();
-  if ( itk::MultiThreader::GetGlobalMaximumNumberOfThreads() != 0 )
-    {
-    nbOfThreads = std::min( this->GetNumberOfThreads(), itk::MultiThreader::GetGlobalMaximumNumberOfThreads() );
-    }
-  // number of threads can be constrained by the region size, so call the
-  // SplitRequestedRegion
-  // to get the real number of threads which will be used
-  RegionType splitRegion;  // dummy region - just to call the following method
-  nbOfThreads = this->SplitRequestedRegion(0, nbOfThreads, splitRegion);
-
-  // and allocate one histogram per thread
-  m_Histograms.resize(nbOfThreads);
-  m_Minimums.resize(nbOfThreads);
-  m_Maximums.resize(nbOfThreads);
-  m_Barrier = Barrier::New();
-  m_Barrier->Initialize(nbOfThreads);
+  return this->GetAutoMinimumMaximumInput() && this->GetAutoMinimumMaximum();
 }
 
-
 template< typename TImage >
-void
+unsigned int
 ImageToHistogramFilter< TImage >
-::ThreadedGenerateData(const RegionType & inputRegionForThread, ThreadIdType threadId)
+::GetNumberOfPasses() const
 {
-  long nbOfPixels = inputRegionForThread.GetNumberOfPixels();
-  if( this->GetAutoMinimumMaximumInput() && this->GetAutoMinimumMaximum() )
-    {
-    // we'll have to iterate over all the pixels 2 times
-    nbOfPixels *= 2;
-    }
-  ProgressReporter progress( this, threadId, nbOfPixels );
-
-  if( threadId == 0 )
-    {
-    // just use the main one
-    m_Histograms[threadId] = this->GetOutput();
-    }
-  else
-    {
-    m_Histograms[threadId] = HistogramType::New();
-    }
-  HistogramType * hist = m_Histograms[threadId];
-  hist->SetClipBinsAtEnds(true);
+  return this->IsAutoMinimumMaximum() ? 2 : 1;
+}
 
-  // the parameter needed to initialize the histogram
+template< typename TImage >
+typename ImageToHistogramFilter< TImage >::HistogramSizeType
+ImageToHistogramFilter< TImage >
+::GetHistogramSizeOrDefault() const
+{
   unsigned int nbOfComponents = this->GetInput()->GetNumberOfComponentsPerPixel();
   HistogramSizeType size( nbOfComponents );
-  HistogramMeasurementVectorType min( nbOfComponents );
-  HistogramMeasurementVectorType max( nbOfComponents );
   if( this->GetHistogramSizeInput() )
     {
     // user provided value
@@ -163,79 +131,265 @@ ImageToHistogramFilter< TImage >
     // use a default value, which must be computed at run time for the VectorImage
     size.Fill(256);
     }
+  return size;
+}
 
-  if( this->GetAutoMinimumMaximumInput() && this->GetAutoMinimumMaximum() )
+template< typename TImage >
+void
+ImageToHistogramFilter< TImage >
+::InitializeHistograms( const HistogramSizeType & size, HistogramMeasurementVectorType & min,
+                        HistogramMeasurementVectorType & max )
+{
+  unsigned int nbOfComponents = this->GetInput()->GetNumberOfComponentsPerPixel();
+  for( unsigned int i=0; i<m_Histograms.size(); i++ )
     {
-    // we have to compute the minimum and maximum values
-    this->ThreadedComputeMinimumAndMaximum( inputRegionForThread, threadId, progress );
+    m_Histograms[i]->SetMeasurementVectorSize( nbOfComponents );
+    m_Histograms[i]->Initialize( size, min, max );
+    }
+  this->InitializeScalarBins();
+}
+
+template< typename TImage >
+void
+ImageToHistogramFilter< TImage >
+::InitializeScalarBins()
+{
+  m_ScalarBinCounts.clear();
+  m_ScalarBinEdges.clear();
+  m_ScalarBinLookupTable.clear();
 
-    // wait for the other threads to complete their part
-    m_Barrier->Wait();
+  const HistogramType * histogram = m_Histograms[0];
+  if( this->GetInput()->GetNumberOfComponentsPerPixel() != 1 || histogram->GetSize(0) == 0 )
+    {
+    return;
+    }
 
-    // a non multithreaded part
-    if( threadId == 0 )
+  // the bins must be contiguous for the bin of a measurement to be found by
+  // its position between the edges
+  const SizeValueType size = histogram->GetSize(0);
+  m_ScalarBinEdges.resize( size + 1 );
+  for( SizeValueType b=0; b<size; b++ )
+    {
+    if( !( histogram->GetBinMin( 0, b ) < histogram->GetBinMax( 0, b ) )
+        || ( b + 1 < size && histogram->GetBinMax( 0, b ) != histogram->GetBinMin( 0, b + 1 ) ) )
       {
-      min = m_Minimums[0];
-      max = m_Maximums[0];
-      for( unsigned int t=1; t<m_Minimums.size(); t++ )
+      m_ScalarBinEdges.clear();
+      return;
+      }
+    m_ScalarBinEdges[b] = histogram->GetBinMin( 0, b );
+    }
+  m_ScalarBinEdges[size] = histogram->GetBinMax( 0, size - 1 );
+  m_ScalarBinScale = static_cast< double >( size )
+    / ( static_cast< double >( m_ScalarBinEdges[size] ) - static_cast< double >( m_ScalarBinEdges[0] ) );
+
+  // the values of the small integer types are binned once for all, when
+  // there are more pixels than values
+  if( NumericTraits< ValueType >::is_integer && sizeof( ValueType ) <= 2 )
+    {
+    const OffsetValueType valueMin = static_cast< OffsetValueType >( NumericTraits< ValueType >::NonpositiveMin() );
+    const SizeValueType   numberOfValues =
+      static_cast< SizeValueType >( static_cast< OffsetValueType >( NumericTraits< ValueType >::max() ) - valueMin + 1 );
+    if( this->GetInput()->GetRequestedRegion().GetNumberOfPixels() > numberOfValues )
+      {
+      std::vector< int > table( numberOfValues );
+      HistogramIndexValueType bin;
+      for( SizeValueType v=0; v<numberOfValues; v++ )
         {
-        for( unsigned int i=0; i<nbOfComponents; i++ )
-          {
-          min[i] = std::min( min[i], m_Minimums[t][i] );
-          max[i] = std::max( max[i], m_Maximums[t][i] );
-          }
+        const HistogramMeasurementType value =
+          static_cast< HistogramMeasurementType >( valueMin + static_cast< OffsetValueType >( v ) );
+        table[v] = this->GetScalarBin( value, bin ) ? static_cast< int >( bin ) : -1;
         }
-      this->ApplyMarginalScale( min, max, size );
-      // store the values so they can be retreived by the other threads
-      m_Minimums[0] = min;
-      m_Maximums[0] = max;
+      m_ScalarBinLookupTable.swap( table );
       }
+    }
 
-    // wait for all the threads to complete
-    m_Barrier->Wait();
+  m_ScalarBinCounts.assign( m_Histograms.size(), std::vector< HistogramAbsoluteFrequencyType >( size, 0 ) );
+}
 
-    // and get the values computed in the main thread
-    min = m_Minimums[0];
-    max = m_Maximums[0];
+template< typename TImage >
+bool
+ImageToHistogramFilter< TImage >
+::GetScalarBin( HistogramMeasurementType measurement, HistogramIndexValueType & bin ) const
+{
+  if( !m_ScalarBinLookupTable.empty() )
+    {
+    const int b = m_ScalarBinLookupTable[ static_cast< SizeValueType >(
+      static_cast< OffsetValueType >( measurement ) - static_cast< OffsetValueType >( NumericTraits< ValueType >::NonpositiveMin() ) ) ];
+    bin = b;
+    return b >= 0;
     }
-  else
+
+  // same rules as Histogram::GetIndex() for the measurements outside of
+  // the bins
+  const HistogramIndexValueType last = static_cast< HistogramIndexValueType >( m_ScalarBinEdges.size() ) - 2;
+  if( measurement < m_ScalarBinEdges[0] )
     {
-    if( this->GetHistogramBinMinimumInput() )
-      {
-      min = this->GetHistogramBinMinimum();
-      }
-    else
-      {
-      min.Fill( NumericTraits<ValueType>::NonpositiveMin() - 0.5 );
-      }
-    if( this->GetHistogramBinMaximumInput() )
-      {
-      max = this->GetHistogramBinMaximum();
-      }
-    else
+    bin = 0;
+    return !m_Histograms[0]->GetClipBinsAtEnds();
+    }
+  if( measurement >= m_ScalarBinEdges[last + 1] )
+    {
+    bin = last;
+    return !m_Histograms[0]->GetClipBinsAtEnds() || Math::AlmostEquals( measurement, m_ScalarBinEdges[last + 1] );
+    }
+  if( measurement != measurement )
+    {
+    // NaN is not ordered with the edges: let the histogram decide
+    HistogramMeasurementVectorType m( 1 );
+    m[0] = measurement;
+    typename HistogramType::IndexType index;
+    const bool inside = m_Histograms[0]->GetIndex( m, index );
+    bin = index[0];
+    return inside;
+    }
+
+  // the bins are uniformly spaced up to the rounding of their edges, so the
+  // computed bin is corrected with the actual edges
+  bin = static_cast< HistogramIndexValueType >(
+    ( static_cast< double >( measurement ) - static_cast< double >( m_ScalarBinEdges[0] ) ) * m_ScalarBinScale );
+  bin = std::max( HistogramIndexValueType( 0 ), std::min( bin, last ) );
+  while( measurement < m_ScalarBinEdges[bin] )
+    {
+    --bin;
+    }
+  while( measurement >= m_ScalarBinEdges[bin + 1] )
+    {
+    ++bin;
+    }
+  return true;
+}
+
+template< typename TImage >
+void
+ImageToHistogramFilter< TImage >
+::MergeScalarBins()
+{
+  HistogramType * hist = m_Histograms[0];
+  const SizeValueType size = m_ScalarBinEdges.size() - 1;
+  for( SizeValueType b=0; b<size; b++ )
+    {
+    HistogramAbsoluteFrequencyType count = 0;
+    for( unsigned int t=0; t<m_ScalarBinCounts.size(); t++ )
       {
-      max.Fill( NumericTraits<ValueType>::max() + 0.5 );
-      // this->ApplyMarginalScale( min, max, size );
+      count += m_ScalarBinCounts[t][b];
       }
+    hist->IncreaseFrequency( b, count );
+    }
+}
+
+template< typename TImage >
+void
+ImageToHistogramFilter< TImage >
+::BeforeStreamedGenerateData()
+{
+  if( this->GetCurrentPass() > 0 )
+    {
+    // the histograms have been initialized at the end of the pass which
+    // computed the minimum and maximum
+    return;
+    }
+
+  // find the actual number of threads
+  long nbOfThreads = this->GetNumberOfThreads();
+  if ( itk::MultiThreader::GetGlobalMaximumNumberOfThreads() != 0 )
+    {
+    nbOfThreads = std::min( this->GetNumberOfThreads(), itk::MultiThreader::GetGlobalMaximumNumberOfThreads() );
+    }
+
+  // allocate one histogram per thread, the first one being the output
+  unsigned int nbOfComponents = this->GetInput()->GetNumberOfComponentsPerPixel();
+  m_Histograms.resize(nbOfThreads);
+  m_Minimums.resize(nbOfThreads);
+  m_Maximums.resize(nbOfThreads);
+  for( long t=0; t<nbOfThreads; t++ )
+    {
+    m_Histograms[t] = t == 0 ? this->GetOutput() : HistogramType::New().GetPointer();
+    m_Histograms[t]->SetClipBinsAtEnds(true);
+    m_Minimums[t] = HistogramMeasurementVectorType( nbOfComponents );
+    m_Minimums[t].Fill( NumericTraits<ValueType>::max() );
+    m_Maximums[t] = HistogramMeasurementVectorType( nbOfComponents );
+    m_Maximums[t].Fill( NumericTraits<ValueType>::NonpositiveMin() );
+    }
+
+  if( this->IsAutoMinimumMaximum() )
+    {
+    // the minimum and maximum are computed in the first pass
+    return;
+    }
+
+  HistogramMeasurementVectorType min( nbOfComponents );
+  HistogramMeasurementVectorType max( nbOfComponents );
+  if( this->GetHistogramBinMinimumInput() )
+    {
+    min = this->GetHistogramBinMinimum();
     }
+  else
+    {
+    min.Fill( NumericTraits<ValueType>::NonpositiveMin() - 0.5 );
+    }
+  if( this->GetHistogramBinMaximumInput() )
+    {
+    max = this->GetHistogramBinMaximum();
+    }
+  else
+    {
+    max.Fill( NumericTraits<ValueType>::max() + 0.5 );
+    // this->ApplyMarginalScale( min, max, size );
+    }
+  this->InitializeHistograms( this->GetHistogramSizeOrDefault(), min, max );
+}
 
-  // finally, initialize the histogram
-  hist->SetMeasurementVectorSize( nbOfComponents );
-  hist->Initialize( size, min, max );
 
-  // now fill the histograms
-  this->ThreadedComputeHistogram( inputRegionForThread, threadId, progress );
+template< typename TImage >
+void
+ImageToHistogramFilter< TImage >
+::ThreadedStreamedGenerateData(const RegionType & inputRegionForThread, ThreadIdType threadId)
+{
+  ProgressReporter progress( this, threadId, inputRegionForThread.GetNumberOfPixels(), 100,
+                             this->GetPieceInitialProgress(), this->GetPieceProgressWeight() );
+
+  if( this->IsAutoMinimumMaximum() && this->GetCurrentPass() == 0 )
+    {
+    // we have to compute the minimum and maximum values
+    this->ThreadedComputeMinimumAndMaximum( inputRegionForThread, threadId, progress );
+    }
+  else
+    {
+    // fill the histograms
+    this->ThreadedComputeHistogram( inputRegionForThread, threadId, progress );
+    }
 }
 
 
 template< typename TImage >
 void
 ImageToHistogramFilter< TImage >
-::AfterThreadedGenerateData()
+::AfterStreamedGenerateData()
 {
-  // group the results in the output histogram
+  if( this->IsAutoMinimumMaximum() && this->GetCurrentPass() == 0 )
+    {
+    // find the minimum and maximum over all the threads, and initialize the
+    // histograms for the next pass
+    unsigned int nbOfComponents = this->GetInput()->GetNumberOfComponentsPerPixel();
+    HistogramMeasurementVectorType min = m_Minimums[0];
+    HistogramMeasurementVectorType max = m_Maximums[0];
+    for( unsigned int t=1; t<m_Minimums.size(); t++ )
+      {
+      for( unsigned int i=0; i<nbOfComponents; i++ )
+        {
+        min[i] = std::min( min[i], m_Minimums[t][i] );
+        max[i] = std::max( max[i], m_Maximums[t][i] );
+        }
+      }
+    HistogramSizeType size = this->GetHistogramSizeOrDefault();
+    this->ApplyMarginalScale( min, max, size );
+    this->InitializeHistograms( size, min, max );
+    return;
+    }
+
+  // group the results in the output histogram. All the histograms have the
+  // same bins.
   HistogramType * hist = m_Histograms[0];
-  typename HistogramType::IndexType index;
   for( unsigned int i=1; i<m_Histograms.size(); i++ )
     {
     typedef typename HistogramType::ConstIterator         HistogramIterator;
@@ -244,17 +398,22 @@ ImageToHistogramFilter< TImage >
     HistogramIterator end = m_Histograms[i]->End();
     while ( hit != end )
       {
-      hist->GetIndex( hit.GetMeasurementVector(), index);
-      hist->IncreaseFrequencyOfIndex( index, hit.GetFrequency() );
+      hist->IncreaseFrequency( hit.GetInstanceIdentifier(), hit.GetFrequency() );
       ++hit;
       }
     }
+  if( this->UseScalarBins() )
+    {
+    this->MergeScalarBins();
+    }
 
   // and drop the temporary histograms
   m_Histograms.clear();
   m_Minimums.clear();
   m_Maximums.clear();
-  m_Barrier = ITK_NULLPTR;
+  m_ScalarBinCounts.clear();
+  m_ScalarBinEdges.clear();
+  m_ScalarBinLookupTable.clear();
 }
 
 
@@ -271,8 +430,9 @@ ImageToHistogramFilter< TImage >
   inputIt.GoToBegin();
   HistogramMeasurementVectorType m( nbOfComponents );
 
-  min.Fill( NumericTraits<ValueType>::max() );
-  max.Fill( NumericTraits<ValueType>::NonpositiveMin() );
+  // continue the accumulation of the previous pieces of the input
+  min = m_Minimums[threadId];
+  max = m_Maximums[threadId];
   while ( !inputIt.IsAtEnd() )
     {
     const PixelType & p = inputIt.Get();
@@ -299,6 +459,23 @@ ImageToHistogramFilter< TImage >
   inputIt.GoToBegin();
   HistogramMeasurementVectorType m( nbOfComponents );
 
+  if( this->UseScalarBins() )
+    {
+    std::vector< HistogramAbsoluteFrequencyType > & counts = m_ScalarBinCounts[threadId];
+    HistogramIndexValueType bin;
+    while ( !inputIt.IsAtEnd() )
+      {
+      NumericTraits<PixelType>::AssignToArray( inputIt.Get(), m );
+      if( this->GetScalarBin( m[0], bin ) )
+        {
+        ++counts[bin];
+        }
+      ++inputIt;
+      progress.CompletedPixel();  // potential exception thrown here
+      }
+    return;
+    }
+
   typename HistogramType::IndexType index;
   while ( !inputIt.IsAtEnd() )
     {
@@ -66,6 +66,8 @@ public:
   typedef typename HistogramType::SizeType              HistogramSizeType;
   typedef typename HistogramType::MeasurementType       HistogramMeasurementType;
   typedef typename HistogramType::MeasurementVectorType HistogramMeasurementVectorType;
+  typedef typename HistogramType::IndexValueType        HistogramIndexValueType;
+  typedef typename HistogramType::AbsoluteFrequencyType HistogramAbsoluteFrequencyType;
 
   typedef TMaskImage                                     MaskImageType;
   typedef typename MaskImageType::PixelType              MaskPixelType;
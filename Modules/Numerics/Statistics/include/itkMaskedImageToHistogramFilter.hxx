@@ -51,8 +51,9 @@ MaskedImageToHistogramFilter< TImage, TMaskImage >
   maskIt.GoToBegin();
   HistogramMeasurementVectorType m( nbOfComponents );
 
-  min.Fill( NumericTraits<ValueType>::max() );
-  max.Fill( NumericTraits<ValueType>::NonpositiveMin() );
+  // continue the accumulation of the previous pieces of the input
+  min = this->m_Minimums[threadId];
+  max = this->m_Maximums[threadId];
   while ( !inputIt.IsAtEnd() )
     {
     if( maskIt.Get() == maskValue )
@@ -86,6 +87,27 @@ MaskedImageToHistogramFilter< TImage, TMaskImage >
   HistogramMeasurementVectorType m( nbOfComponents );
   MaskPixelType maskValue = this->GetMaskValue();
 
+  if( this->UseScalarBins() )
+    {
+    std::vector< HistogramAbsoluteFrequencyType > & counts = this->m_ScalarBinCounts[threadId];
+    HistogramIndexValueType bin;
+    while ( !inputIt.IsAtEnd() )
+      {
+      if( maskIt.Get() == maskValue )
+        {
+        NumericTraits<PixelType>::AssignToArray( inputIt.Get(), m );
+        if( this->GetScalarBin( m[0], bin ) )
+          {
+          ++counts[bin];
+          }
+        }
+      ++inputIt;
+      ++maskIt;
+      progress.CompletedPixel();  // potential exception thrown here
+      }
+    return;
+    }
+
   typename HistogramType::IndexType index;
   while ( !inputIt.IsAtEnd() )
     {
@@ -22,10 +22,10 @@
 
 #include "itkPoint.h"
 #include "itkIntTypes.h"
-#include "itkKdTree.h"
-#include "itkKdTreeGenerator.h"
 #include "itkVectorContainer.h"
-#include "itkVectorContainerToListSampleAdaptor.h"
+#include "itkMultiThreader.h"
+#include "itkAtomicInt.h"
+#include <vector>
 
 namespace itk
 {
@@ -36,6 +36,20 @@ namespace itk
  * This class accelerates the search for the closest point to a user-provided
  * point, by using constructing a Kd-Tree structure for the PointSetContainer.
  *
+ * The tree is stored in contiguous arrays: the coordinates of the points are
+ * copied in the order of the leaves, and each node keeps the bounding box of
+ * its points, its children being found from its position in the array.  The
+ * points are split at the median of the axis along which their bounding box
+ * is the largest, until at most BucketSize points remain.  When the points
+ * move without being added or removed, UpdatePointPositions() recomputes the
+ * bounding boxes in linear time instead of building the tree again.  The
+ * searches remain exact, but become slower when the points move far from
+ * their neighbors of the tree.
+ *
+ * The k nearest neighbors are returned sorted by increasing distance, the
+ * points at the same distance being sorted by identifier.  The searches
+ * given a container of query points are run by NumberOfThreads threads.
+ *
  * \ingroup ITKRegistrationCommon
  */
 template<
@@ -70,17 +84,10 @@ public:
   typedef typename PointsContainer::ConstIterator PointsContainerConstIterator;
   typedef typename PointsContainer::Iterator      PointsContainerIterator;
 
-  /** Type of the PointsContainer to List Adaptor. */
-  typedef Statistics::VectorContainerToListSampleAdaptor
-    <PointsContainer>                                   SampleAdaptorType;
-  typedef typename SampleAdaptorType::Pointer           SampleAdaptorPointer;
+  typedef typename PointType::ValueType CoordRepType;
 
-  /** Types fo the KdTreeGenerator */
-  typedef Statistics::KdTreeGenerator<SampleAdaptorType>    TreeGeneratorType;
-  typedef typename TreeGeneratorType::Pointer               TreeGeneratorPointer;
-  typedef typename TreeGeneratorType::KdTreeType            TreeType;
-  typedef typename TreeType::ConstPointer                   TreeConstPointer;
-  typedef typename TreeType::InstanceIdentifierVectorType   NeighborsIdentifierType;
+  /** Type of the identifiers of the neighbors found by a search. */
+  typedef std::vector< IdentifierType > NeighborsIdentifierType;
 
   /** Set/Get the points from which the bounding box should be computed. */
   itkSetObjectMacro( Points, PointsContainer );
@@ -88,9 +95,25 @@ public:
   /** Set/Get the points from which the bounding box should be computed. */
   itkGetModifiableObjectMacro(Points, PointsContainer );
 
+  /** Set/Get the largest number of points of the leaves of the tree.
+   * The tree keeps the bucket size it was built with: a new bucket size is
+   * used by the next Initialize() or UpdatePointPositions().  Defaults to
+   * 16. */
+  itkSetClampMacro( BucketSize, unsigned int, 1, NumericTraits< unsigned int >::max() );
+  itkGetConstMacro( BucketSize, unsigned int );
+
+  /** Set/Get the number of threads of the searches given a container of
+   * query points.  Defaults to the global default number of threads. */
+  itkSetClampMacro( NumberOfThreads, ThreadIdType, 1, ITK_MAX_THREADS );
+  itkGetConstMacro( NumberOfThreads, ThreadIdType );
+
   /** Compute the kd-tree that will facilitate the querying the points. */
   void Initialize();
 
+  /** Update the tree after the points moved.  The points must be as many as
+   * when the tree was built, otherwise the tree is built again. */
+  void UpdatePointPositions();
+
   /** Find the closest point */
   PointIdentifier FindClosestPoint( const PointType &query ) const;
 
@@ -109,6 +132,22 @@ public:
   void FindPointsWithinRadius( const PointType &, double,
     NeighborsIdentifierType & ) const;
 
+  /** Type of the results of the searches given a container of query
+   * points, in the order of the container. */
+  typedef std::vector< PointIdentifier >         PointIdentifierVectorType;
+  typedef std::vector< NeighborsIdentifierType > NeighborsIdentifierVectorType;
+
+  /** Find the closest point of each query point. */
+  void FindClosestPoints( const PointsContainer *, PointIdentifierVectorType & ) const;
+
+  /** Find the closest N points of each query point. */
+  void FindClosestNPoints( const PointsContainer *, unsigned int,
+    NeighborsIdentifierVectorType & ) const;
+
+  /** Find the points within a specified radius of each query point. */
+  void FindPointsWithinRadius( const PointsContainer *, double,
+    NeighborsIdentifierVectorType & ) const;
+
 protected:
   PointsLocator();
   ~PointsLocator();
@@ -117,10 +156,72 @@ protected:
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(PointsLocator);
 
+  /** A candidate neighbor: its squared distance and its position in the
+   * tree. */
+  typedef std::pair< double, SizeValueType > NeighborType;
+  typedef std::vector< NeighborType >        NeighborVectorType;
+
+  /** Copy the coordinates and the identifiers of the points in the order of
+   * the tree. */
+  void GatherPoints();
+
+  /** Build the subtree of a node over the points [begin, end) of the
+   * order of the tree. */
+  void BuildNode( SizeValueType node, SizeValueType begin, SizeValueType end,
+    const std::vector< CoordRepType > & coordinates );
+
+  /** Compute the bounding box of a node from the ones of its children. */
+  void ComputeNodeBounds( SizeValueType node, SizeValueType begin, SizeValueType end );
+
+  /** Squared distance from a point to the bounding box of a node. */
+  double GetSquaredDistanceToNode( const PointType & query, SizeValueType node ) const;
+
+  /** Squared distance from a point to the point at a position of the tree. */
+  double GetSquaredDistance( const PointType & query, SizeValueType position ) const;
+
+  void SearchNearestNeighbors( const PointType & query, unsigned int numberOfNeighbors,
+    SizeValueType node, SizeValueType begin, SizeValueType end,
+    NeighborVectorType & neighbors ) const;
+
+  void SearchRadius( const PointType & query, double squaredRadius,
+    SizeValueType node, SizeValueType begin, SizeValueType end,
+    NeighborsIdentifierType & identifiers ) const;
+
+  /** Searches given a container of query points. */
+  enum BatchSearchType { ClosestPointSearch, ClosestNPointsSearch, RadiusSearch };
+
+  struct BatchSearchStruct
+  {
+    const Self *                    Locator;
+    BatchSearchType                 Search;
+    std::vector< PointType >        Queries;
+    unsigned int                    NumberOfNeighbors;
+    double                          Radius;
+    PointIdentifierVectorType *     ClosestPoints;
+    NeighborsIdentifierVectorType * Neighbors;
+    AtomicInt< SizeValueType >      NextBlock;
+  };
+
+  void BatchSearch( BatchSearchStruct & batch ) const;
+
+  static ITK_THREAD_RETURN_TYPE BatchSearchThreaderCallback( void *arg );
+
   PointsContainerPointer   m_Points;
-  SampleAdaptorPointer     m_SampleAdaptor;
-  TreeGeneratorPointer     m_KdTreeGenerator;
-  TreeConstPointer         m_Tree;
+  unsigned int             m_BucketSize;
+  unsigned int             m_TreeBucketSize;
+  ThreadIdType             m_NumberOfThreads;
+
+  /** The coordinates and the identifiers of the points in the order of the
+   * tree, and, for each position of the tree, the rank of the point in the
+   * container. */
+  std::vector< CoordRepType >    m_Coordinates;
+  std::vector< PointIdentifier > m_Identifiers;
+  std::vector< SizeValueType >   m_Permutation;
+
+  /** The lower and upper corners of the bounding box of each node.  The
+   * children of node i are the nodes 2i+1 and 2i+2, which split the points
+   * of their parent in halves. */
+  std::vector< CoordRepType > m_NodeBounds;
 };
 
 } // end namespace itk
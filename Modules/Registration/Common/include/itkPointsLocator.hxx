@@ -18,16 +18,18 @@
 #ifndef itkPointsLocator_hxx
 #define itkPointsLocator_hxx
 #include "itkPointsLocator.h"
+#include <algorithm>
 
 namespace itk
 {
 
 template<typename TPointsContainer>
 PointsLocator<TPointsContainer>
-::PointsLocator()
+::PointsLocator() :
+  m_BucketSize( 16 ),
+  m_TreeBucketSize( 16 ),
+  m_NumberOfThreads( MultiThreader::GetGlobalDefaultNumberOfThreads() )
 {
-  this->m_SampleAdaptor = SampleAdaptorType::New();
-  this->m_KdTreeGenerator = TreeGeneratorType::New();
 }
 
 template<typename TPointsContainer>
@@ -50,21 +52,340 @@ PointsLocator<TPointsContainer>
     itkExceptionMacro( "The number of points is 0." );
     }
 
-  this->m_SampleAdaptor = SampleAdaptorType::New();
-  this->m_KdTreeGenerator = TreeGeneratorType::New();
+  const SizeValueType numberOfPoints = this->m_Points->Size();
 
-  // Lack of const-correctness in the PointSetAdaptor should be fixed.
-  this->m_SampleAdaptor->SetVectorContainer(
-    const_cast<PointsContainer *>( this->m_Points.GetPointer() ) );
+  // The leaves are at the depth where the largest node has at most
+  // BucketSize points.  The bucket size of the tree is kept, as the layout
+  // of the nodes depends on it.
+  this->m_TreeBucketSize = this->m_BucketSize;
+  SizeValueType numberOfNodes = 1;
+  SizeValueType largestNodeSize = numberOfPoints;
+  while( largestNodeSize > this->m_TreeBucketSize )
+    {
+    largestNodeSize = ( largestNodeSize + 1 ) / 2;
+    numberOfNodes = 2 * numberOfNodes + 1;
+    }
+  this->m_NodeBounds.assign( 2 * PointDimension * numberOfNodes, NumericTraits<CoordRepType>::ZeroValue() );
+
+  std::vector<CoordRepType> coordinates( numberOfPoints * PointDimension );
+  SizeValueType rank = 0;
+  for( PointsContainerConstIterator it = this->m_Points->Begin(); it != this->m_Points->End(); ++it, ++rank )
+    {
+    for( unsigned int d = 0; d < PointDimension; ++d )
+      {
+      coordinates[rank * PointDimension + d] = it.Value()[d];
+      }
+    }
 
-  this->m_SampleAdaptor->SetMeasurementVectorSize( PointDimension );
+  this->m_Permutation.resize( numberOfPoints );
+  for( SizeValueType i = 0; i < numberOfPoints; ++i )
+    {
+    this->m_Permutation[i] = i;
+    }
+  this->BuildNode( 0, 0, numberOfPoints, coordinates );
 
-  this->m_KdTreeGenerator->SetSample( this->m_SampleAdaptor );
-  this->m_KdTreeGenerator->SetBucketSize( 16 );
+  this->GatherPoints();
+  this->ComputeNodeBounds( 0, 0, numberOfPoints );
+}
 
-  this->m_KdTreeGenerator->Update();
+template<typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>
+::UpdatePointPositions()
+{
+  if( !this->m_Points )
+    {
+    itkExceptionMacro( "The points have not been set (m_Points == ITK_NULLPTR)" );
+    }
+  if( this->m_NodeBounds.empty() || this->m_Points->Size() != this->m_Permutation.size()
+      || this->m_BucketSize != this->m_TreeBucketSize )
+    {
+    this->Initialize();
+    return;
+    }
 
-  this->m_Tree = this->m_KdTreeGenerator->GetOutput();
+  this->GatherPoints();
+  this->ComputeNodeBounds( 0, 0, this->m_Permutation.size() );
+}
+
+template<typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>
+::GatherPoints()
+{
+  const SizeValueType numberOfPoints = this->m_Permutation.size();
+
+  // rank in the container -> position in the tree
+  std::vector<SizeValueType> positions( numberOfPoints );
+  for( SizeValueType i = 0; i < numberOfPoints; ++i )
+    {
+    positions[this->m_Permutation[i]] = i;
+    }
+
+  this->m_Coordinates.resize( numberOfPoints * PointDimension );
+  this->m_Identifiers.resize( numberOfPoints );
+  SizeValueType rank = 0;
+  for( PointsContainerConstIterator it = this->m_Points->Begin(); it != this->m_Points->End(); ++it, ++rank )
+    {
+    const SizeValueType position = positions[rank];
+    for( unsigned int d = 0; d < PointDimension; ++d )
+      {
+      this->m_Coordinates[position * PointDimension + d] = it.Value()[d];
+      }
+    this->m_Identifiers[position] = it.Index();
+    }
+}
+
+namespace
+{
+// Compare the ranks of two points by one of their coordinates.
+template<typename TCoordRep>
+class PointsLocatorCoordinateCompare
+{
+public:
+  PointsLocatorCoordinateCompare( const std::vector<TCoordRep> & coordinates,
+                                  unsigned int dimension, unsigned int axis ) :
+    m_Coordinates( coordinates ), m_Dimension( dimension ), m_Axis( axis )
+  {}
+
+  bool operator()( SizeValueType a, SizeValueType b ) const
+  {
+    return this->m_Coordinates[a * this->m_Dimension + this->m_Axis]
+      < this->m_Coordinates[b * this->m_Dimension + this->m_Axis];
+  }
+
+private:
+  const std::vector<TCoordRep> & m_Coordinates;
+  unsigned int                   m_Dimension;
+  unsigned int                   m_Axis;
+};
+}
+
+template<typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>
+::BuildNode( SizeValueType node, SizeValueType begin, SizeValueType end,
+  const std::vector<CoordRepType> & coordinates )
+{
+  if( end - begin <= this->m_TreeBucketSize )
+    {
+    return;
+    }
+
+  // split along the axis of largest extent
+  CoordRepType lower[PointDimension];
+  CoordRepType upper[PointDimension];
+  for( unsigned int d = 0; d < PointDimension; ++d )
+    {
+    lower[d] = upper[d] = coordinates[this->m_Permutation[begin] * PointDimension + d];
+    }
+  for( SizeValueType i = begin + 1; i < end; ++i )
+    {
+    for( unsigned int d = 0; d < PointDimension; ++d )
+      {
+      const CoordRepType value = coordinates[this->m_Permutation[i] * PointDimension + d];
+      lower[d] = std::min( lower[d], value );
+      upper[d] = std::max( upper[d], value );
+      }
+    }
+  unsigned int axis = 0;
+  for( unsigned int d = 1; d < PointDimension; ++d )
+    {
+    if( upper[d] - lower[d] > upper[axis] - lower[axis] )
+      {
+      axis = d;
+      }
+    }
+
+  const SizeValueType middle = begin + ( end - begin ) / 2;
+  std::nth_element( this->m_Permutation.begin() + begin, this->m_Permutation.begin() + middle,
+                    this->m_Permutation.begin() + end,
+                    PointsLocatorCoordinateCompare<CoordRepType>( coordinates, PointDimension, axis ) );
+
+  this->BuildNode( 2 * node + 1, begin, middle, coordinates );
+  this->BuildNode( 2 * node + 2, middle, end, coordinates );
+}
+
+template<typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>
+::ComputeNodeBounds( SizeValueType node, SizeValueType begin, SizeValueType end )
+{
+  CoordRepType *lower = &this->m_NodeBounds[2 * PointDimension * node];
+  CoordRepType *upper = lower + PointDimension;
+
+  if( end - begin <= this->m_TreeBucketSize )
+    {
+    for( unsigned int d = 0; d < PointDimension; ++d )
+      {
+      lower[d] = upper[d] = this->m_Coordinates[begin * PointDimension + d];
+      }
+    for( SizeValueType i = begin + 1; i < end; ++i )
+      {
+      for( unsigned int d = 0; d < PointDimension; ++d )
+        {
+        lower[d] = std::min( lower[d], this->m_Coordinates[i * PointDimension + d] );
+        upper[d] = std::max( upper[d], this->m_Coordinates[i * PointDimension + d] );
+        }
+      }
+    return;
+    }
+
+  const SizeValueType middle = begin + ( end - begin ) / 2;
+  this->ComputeNodeBounds( 2 * node + 1, begin, middle );
+  this->ComputeNodeBounds( 2 * node + 2, middle, end );
+
+  const CoordRepType *leftLower = &this->m_NodeBounds[2 * PointDimension * ( 2 * node + 1 )];
+  const CoordRepType *rightLower = &this->m_NodeBounds[2 * PointDimension * ( 2 * node + 2 )];
+  for( unsigned int d = 0; d < PointDimension; ++d )
+    {
+    lower[d] = std::min( leftLower[d], rightLower[d] );
+    upper[d] = std::max( leftLower[PointDimension + d], rightLower[PointDimension + d] );
+    }
+}
+
+template<typename TPointsContainer>
+double
+PointsLocator<TPointsContainer>
+::GetSquaredDistanceToNode( const PointType & query, SizeValueType node ) const
+{
+  const CoordRepType *lower = &this->m_NodeBounds[2 * PointDimension * node];
+  const CoordRepType *upper = lower + PointDimension;
+
+  double distance = 0.0;
+  for( unsigned int d = 0; d < PointDimension; ++d )
+    {
+    const double q = query[d];
+    if( q < lower[d] )
+      {
+      distance += itk::Math::sqr( lower[d] - q );
+      }
+    else if( q > upper[d] )
+      {
+      distance += itk::Math::sqr( q - upper[d] );
+      }
+    }
+  return distance;
+}
+
+template<typename TPointsContainer>
+double
+PointsLocator<TPointsContainer>
+::GetSquaredDistance( const PointType & query, SizeValueType position ) const
+{
+  const CoordRepType *point = &this->m_Coordinates[position * PointDimension];
+
+  double distance = 0.0;
+  for( unsigned int d = 0; d < PointDimension; ++d )
+    {
+    distance += itk::Math::sqr( static_cast<double>( query[d] ) - point[d] );
+    }
+  return distance;
+}
+
+namespace
+{
+// Order the candidate neighbors by distance, then by identifier.
+template<typename TIdentifier>
+class PointsLocatorNeighborCompare
+{
+public:
+  PointsLocatorNeighborCompare( const std::vector<TIdentifier> & identifiers ) :
+    m_Identifiers( identifiers )
+  {}
+
+  bool operator()( const std::pair<double, SizeValueType> & a,
+                   const std::pair<double, SizeValueType> & b ) const
+  {
+    return a.first < b.first
+      || ( a.first == b.first && this->m_Identifiers[a.second] < this->m_Identifiers[b.second] );
+  }
+
+private:
+  const std::vector<TIdentifier> & m_Identifiers;
+};
+}
+
+template<typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>
+::SearchNearestNeighbors( const PointType & query, unsigned int numberOfNeighbors,
+  SizeValueType node, SizeValueType begin, SizeValueType end,
+  NeighborVectorType & neighbors ) const
+{
+  // The neighbors are a heap whose front is the farthest one.
+  if( end - begin <= this->m_TreeBucketSize )
+    {
+    const PointsLocatorNeighborCompare<PointIdentifier> compare( this->m_Identifiers );
+    for( SizeValueType i = begin; i < end; ++i )
+      {
+      const NeighborType candidate( this->GetSquaredDistance( query, i ), i );
+      if( neighbors.size() < numberOfNeighbors )
+        {
+        neighbors.push_back( candidate );
+        std::push_heap( neighbors.begin(), neighbors.end(), compare );
+        }
+      else if( compare( candidate, neighbors.front() ) )
+        {
+        std::pop_heap( neighbors.begin(), neighbors.end(), compare );
+        neighbors.back() = candidate;
+        std::push_heap( neighbors.begin(), neighbors.end(), compare );
+        }
+      }
+    return;
+    }
+
+  // visit the closest child first
+  const SizeValueType middle = begin + ( end - begin ) / 2;
+  const double leftDistance = this->GetSquaredDistanceToNode( query, 2 * node + 1 );
+  const double rightDistance = this->GetSquaredDistanceToNode( query, 2 * node + 2 );
+  const bool leftFirst = leftDistance <= rightDistance;
+
+  for( unsigned int i = 0; i < 2; ++i )
+    {
+    const bool left = ( i == 0 ) == leftFirst;
+    const double distance = left ? leftDistance : rightDistance;
+    if( neighbors.size() < numberOfNeighbors || distance <= neighbors.front().first )
+      {
+      if( left )
+        {
+        this->SearchNearestNeighbors( query, numberOfNeighbors, 2 * node + 1, begin, middle, neighbors );
+        }
+      else
+        {
+        this->SearchNearestNeighbors( query, numberOfNeighbors, 2 * node + 2, middle, end, neighbors );
+        }
+      }
+    }
+}
+
+template<typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>
+::SearchRadius( const PointType & query, double squaredRadius,
+  SizeValueType node, SizeValueType begin, SizeValueType end,
+  NeighborsIdentifierType & identifiers ) const
+{
+  if( this->GetSquaredDistanceToNode( query, node ) > squaredRadius )
+    {
+    return;
+    }
+
+  if( end - begin <= this->m_TreeBucketSize )
+    {
+    for( SizeValueType i = begin; i < end; ++i )
+      {
+      if( this->GetSquaredDistance( query, i ) <= squaredRadius )
+        {
+        identifiers.push_back( this->m_Identifiers[i] );
+        }
+      }
+    return;
+    }
+
+  const SizeValueType middle = begin + ( end - begin ) / 2;
+  this->SearchRadius( query, squaredRadius, 2 * node + 1, begin, middle, identifiers );
+  this->SearchRadius( query, squaredRadius, 2 * node + 2, middle, end, identifiers );
 }
 
 template<typename TPointsContainer>
@@ -73,10 +394,16 @@ typename PointsLocator<TPointsContainer>
 PointsLocator<TPointsContainer>
 ::FindClosestPoint( const PointType &query ) const
 {
-  NeighborsIdentifierType identifiers;
-  this->m_Tree->Search( query, 1u, identifiers );
+  if( this->m_Identifiers.empty() )
+    {
+    itkExceptionMacro( "The points locator has not been initialized." );
+    }
 
-  return identifiers[0];
+  NeighborVectorType neighbors;
+  neighbors.reserve( 1 );
+  this->SearchNearestNeighbors( query, 1, 0, 0, this->m_Identifiers.size(), neighbors );
+
+  return this->m_Identifiers[neighbors[0].second];
 }
 
 template<
@@ -94,7 +421,24 @@ PointsLocator<TPointsContainer>
     itkWarningMacro( "The number of requested neighbors is greater than the "
      << "total number of points.  Only returning " << N << " points." );
     }
-  this->m_Tree->Search( query, N, identifiers );
+
+  identifiers.clear();
+  if( N == 0 || this->m_Identifiers.empty() )
+    {
+    return;
+    }
+
+  NeighborVectorType neighbors;
+  neighbors.reserve( N );
+  this->SearchNearestNeighbors( query, N, 0, 0, this->m_Identifiers.size(), neighbors );
+  std::sort_heap( neighbors.begin(), neighbors.end(),
+                  PointsLocatorNeighborCompare<PointIdentifier>( this->m_Identifiers ) );
+
+  identifiers.resize( neighbors.size() );
+  for( size_t i = 0; i < neighbors.size(); ++i )
+    {
+    identifiers[i] = this->m_Identifiers[neighbors[i].second];
+    }
 }
 
 template<
@@ -104,15 +448,7 @@ PointsLocator<TPointsContainer>
 ::FindClosestNPoints( const PointType &query, unsigned int
   numberOfNeighborsRequested, NeighborsIdentifierType &identifiers ) const
 {
-  unsigned int N = numberOfNeighborsRequested;
-  if( N > this->m_Points->Size() )
-    {
-    N = this->m_Points->Size();
-
-    itkWarningMacro( "The number of requested neighbors is greater than the "
-     << "total number of points.  Only returning " << N << " points." );
-    }
-  this->m_Tree->Search( query, N, identifiers );
+  this->Search( query, numberOfNeighborsRequested, identifiers );
 }
 
 template<
@@ -122,7 +458,12 @@ PointsLocator<TPointsContainer>
 ::Search( const PointType &query, double radius,
   NeighborsIdentifierType &identifiers ) const
 {
-  this->m_Tree->Search( query, radius, identifiers );
+  identifiers.clear();
+  if( this->m_Identifiers.empty() )
+    {
+    return;
+    }
+  this->SearchRadius( query, radius * radius, 0, 0, this->m_Identifiers.size(), identifiers );
 }
 
 template<
@@ -132,7 +473,138 @@ PointsLocator<TPointsContainer>
 ::FindPointsWithinRadius( const PointType &query, double radius,
   NeighborsIdentifierType &identifiers ) const
 {
-  this->m_Tree->Search( query, radius, identifiers );
+  this->Search( query, radius, identifiers );
+}
+
+template<typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>
+::FindClosestPoints( const PointsContainer *queries, PointIdentifierVectorType & closestPoints ) const
+{
+  BatchSearchStruct batch;
+  batch.Search = ClosestPointSearch;
+  batch.ClosestPoints = &closestPoints;
+  batch.Neighbors = ITK_NULLPTR;
+  batch.NumberOfNeighbors = 1;
+  batch.Radius = 0.0;
+  for( PointsContainerConstIterator it = queries->Begin(); it != queries->End(); ++it )
+    {
+    batch.Queries.push_back( it.Value() );
+    }
+  if( this->m_Identifiers.empty() && !batch.Queries.empty() )
+    {
+    itkExceptionMacro( "The points locator has not been initialized." );
+    }
+  closestPoints.resize( batch.Queries.size() );
+  this->BatchSearch( batch );
+}
+
+template<typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>
+::FindClosestNPoints( const PointsContainer *queries, unsigned int numberOfNeighborsRequested,
+  NeighborsIdentifierVectorType & neighbors ) const
+{
+  unsigned int N = numberOfNeighborsRequested;
+  if( N > this->m_Points->Size() )
+    {
+    N = this->m_Points->Size();
+
+    itkWarningMacro( "The number of requested neighbors is greater than the "
+     << "total number of points.  Only returning " << N << " points." );
+    }
+
+  BatchSearchStruct batch;
+  batch.Search = ClosestNPointsSearch;
+  batch.ClosestPoints = ITK_NULLPTR;
+  batch.Neighbors = &neighbors;
+  batch.NumberOfNeighbors = N;
+  batch.Radius = 0.0;
+  for( PointsContainerConstIterator it = queries->Begin(); it != queries->End(); ++it )
+    {
+    batch.Queries.push_back( it.Value() );
+    }
+  neighbors.resize( batch.Queries.size() );
+  this->BatchSearch( batch );
+}
+
+template<typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>
+::FindPointsWithinRadius( const PointsContainer *queries, double radius,
+  NeighborsIdentifierVectorType & neighbors ) const
+{
+  BatchSearchStruct batch;
+  batch.Search = RadiusSearch;
+  batch.ClosestPoints = ITK_NULLPTR;
+  batch.Neighbors = &neighbors;
+  batch.NumberOfNeighbors = 0;
+  batch.Radius = radius;
+  for( PointsContainerConstIterator it = queries->Begin(); it != queries->End(); ++it )
+    {
+    batch.Queries.push_back( it.Value() );
+    }
+  neighbors.resize( batch.Queries.size() );
+  this->BatchSearch( batch );
+}
+
+template<typename TPointsContainer>
+void
+PointsLocator<TPointsContainer>
+::BatchSearch( BatchSearchStruct & batch ) const
+{
+  const SizeValueType numberOfBlocks = ( batch.Queries.size() + 63 ) / 64;
+  if( numberOfBlocks == 0 )
+    {
+    return;
+    }
+
+  batch.Locator = this;
+  batch.NextBlock = 0;
+
+  MultiThreader::Pointer threader = MultiThreader::New();
+  threader->SetNumberOfThreads( std::min( this->m_NumberOfThreads,
+                                          static_cast<ThreadIdType>( numberOfBlocks ) ) );
+  threader->SetSingleMethod( this->BatchSearchThreaderCallback, &batch );
+  threader->SingleMethodExecute();
+}
+
+template<typename TPointsContainer>
+ITK_THREAD_RETURN_TYPE
+PointsLocator<TPointsContainer>
+::BatchSearchThreaderCallback( void *arg )
+{
+  BatchSearchStruct *batch = static_cast<BatchSearchStruct *>(
+    static_cast<MultiThreader::ThreadInfoStruct *>( arg )->UserData );
+  const Self *locator = batch->Locator;
+
+  // the queries are taken by blocks of 64
+  const SizeValueType numberOfQueries = batch->Queries.size();
+  while( true )
+    {
+    const SizeValueType first = 64 * ( batch->NextBlock++ );
+    if( first >= numberOfQueries )
+      {
+      break;
+      }
+    const SizeValueType last = std::min( first + 64, numberOfQueries );
+    for( SizeValueType i = first; i < last; ++i )
+      {
+      switch( batch->Search )
+        {
+        case ClosestPointSearch:
+          ( *batch->ClosestPoints )[i] = locator->FindClosestPoint( batch->Queries[i] );
+          break;
+        case ClosestNPointsSearch:
+          locator->Search( batch->Queries[i], batch->NumberOfNeighbors, ( *batch->Neighbors )[i] );
+          break;
+        case RadiusSearch:
+          locator->Search( batch->Queries[i], batch->Radius, ( *batch->Neighbors )[i] );
+          break;
+        }
+      }
+    }
+  return ITK_THREAD_RETURN_VALUE;
 }
 
 /**
@@ -145,6 +617,11 @@ PointsLocator<TPointsContainer>
 ::PrintSelf( std::ostream& os, Indent indent ) const
 {
   Superclass::PrintSelf( os, indent );
+  os << indent << "BucketSize: " << this->m_BucketSize << std::endl;
+  os << indent << "NumberOfThreads: " << this->m_NumberOfThreads << std::endl;
+  os << indent << "Number of points of the tree: " << this->m_Identifiers.size() << std::endl;
+  os << indent << "Number of nodes of the tree: "
+     << this->m_NodeBounds.size() / ( 2 * PointDimension ) << std::endl;
 }
 
 } // end namespace itk
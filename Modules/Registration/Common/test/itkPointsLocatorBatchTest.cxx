@@ -0,0 +1,234 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkPointsLocator.h"
+#include "itkMapContainer.h"
+#include "itkTestingMacros.h"
+#include <algorithm>
+
+namespace
+{
+const unsigned int PointDimension = 3;
+
+typedef itk::Point< float, PointDimension > PointType;
+
+// Points in a cube, half of them clustered around a corner.
+template< typename TPointsContainer >
+void
+FillPoints( TPointsContainer * points, unsigned int numberOfPoints, unsigned int & seed )
+{
+  points->Initialize();
+  for( unsigned int i = 0; i < numberOfPoints; ++i )
+    {
+    PointType point;
+    for( unsigned int d = 0; d < PointDimension; ++d )
+      {
+      seed = seed * 1103515245u + 12345u;
+      point[d] = static_cast< float >( ( seed >> 8 ) % 10000 ) / 100.0f;
+      if( i % 2 )
+        {
+        point[d] *= 0.05f;
+        }
+      }
+    // the identifiers are not contiguous for the map containers
+    points->InsertElement( 3 * i + 1, point );
+    }
+}
+
+// The identifiers of the k closest points, sorted by distance and then by
+// identifier, or of the points within a radius if k is 0.
+template< typename TPointsContainer >
+std::vector< typename TPointsContainer::ElementIdentifier >
+BruteForceSearch( const TPointsContainer * points, const PointType & query, unsigned int k, double radius )
+{
+  typedef typename TPointsContainer::ElementIdentifier IdentifierType;
+
+  std::vector< std::pair< double, IdentifierType > > distances;
+  for( typename TPointsContainer::ConstIterator it = points->Begin(); it != points->End(); ++it )
+    {
+    distances.push_back( std::make_pair( query.SquaredEuclideanDistanceTo( it.Value() ), it.Index() ) );
+    }
+  std::sort( distances.begin(), distances.end() );
+
+  std::vector< IdentifierType > identifiers;
+  for( size_t i = 0; i < distances.size(); ++i )
+    {
+    if( ( k > 0 && i < k ) || ( k == 0 && distances[i].first <= radius * radius ) )
+      {
+      identifiers.push_back( distances[i].second );
+      }
+    }
+  return identifiers;
+}
+
+template< typename TPointsContainer >
+bool
+CheckLocator( const typename itk::PointsLocator< TPointsContainer >::Pointer & locator,
+              const TPointsContainer * points, const TPointsContainer * queries )
+{
+  typedef itk::PointsLocator< TPointsContainer > LocatorType;
+  typedef typename LocatorType::NeighborsIdentifierType NeighborsIdentifierType;
+
+  const unsigned int k = 7;
+  const double       radius = 4.0;
+
+  typename LocatorType::PointIdentifierVectorType     closestPoints;
+  typename LocatorType::NeighborsIdentifierVectorType closestNPoints;
+  typename LocatorType::NeighborsIdentifierVectorType pointsWithinRadius;
+  locator->FindClosestPoints( queries, closestPoints );
+  locator->FindClosestNPoints( queries, k, closestNPoints );
+  locator->FindPointsWithinRadius( queries, radius, pointsWithinRadius );
+  if( closestPoints.size() != queries->Size() || closestNPoints.size() != queries->Size()
+      || pointsWithinRadius.size() != queries->Size() )
+    {
+    std::cerr << "The number of results differs from the number of queries." << std::endl;
+    return false;
+    }
+
+  size_t q = 0;
+  for( typename TPointsContainer::ConstIterator it = queries->Begin(); it != queries->End(); ++it, ++q )
+    {
+    const std::vector< typename TPointsContainer::ElementIdentifier > expectedNeighbors =
+      BruteForceSearch( points, it.Value(), k, 0.0 );
+    std::vector< typename TPointsContainer::ElementIdentifier > expectedPointsWithinRadius =
+      BruteForceSearch( points, it.Value(), 0, radius );
+    std::sort( expectedPointsWithinRadius.begin(), expectedPointsWithinRadius.end() );
+
+    NeighborsIdentifierType neighbors;
+    locator->FindClosestNPoints( it.Value(), k, neighbors );
+    NeighborsIdentifierType withinRadius;
+    locator->FindPointsWithinRadius( it.Value(), radius, withinRadius );
+    std::sort( withinRadius.begin(), withinRadius.end() );
+    std::sort( pointsWithinRadius[q].begin(), pointsWithinRadius[q].end() );
+
+    if( locator->FindClosestPoint( it.Value() ) != expectedNeighbors[0] || closestPoints[q] != expectedNeighbors[0] )
+      {
+      std::cerr << "Wrong closest point of the query " << it.Value() << std::endl;
+      return false;
+      }
+    if( !std::equal( expectedNeighbors.begin(), expectedNeighbors.end(), neighbors.begin() )
+        || !std::equal( expectedNeighbors.begin(), expectedNeighbors.end(), closestNPoints[q].begin() ) )
+      {
+      std::cerr << "Wrong closest points of the query " << it.Value() << std::endl;
+      return false;
+      }
+    if( withinRadius.size() != expectedPointsWithinRadius.size()
+        || pointsWithinRadius[q].size() != expectedPointsWithinRadius.size()
+        || !std::equal( expectedPointsWithinRadius.begin(), expectedPointsWithinRadius.end(), withinRadius.begin() )
+        || !std::equal( expectedPointsWithinRadius.begin(), expectedPointsWithinRadius.end(),
+                        pointsWithinRadius[q].begin() ) )
+      {
+      std::cerr << "Wrong points within the radius of the query " << it.Value() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+template< typename TPointsContainer >
+bool
+CheckContainer()
+{
+  typedef itk::PointsLocator< TPointsContainer > LocatorType;
+
+  unsigned int seed = 7;
+  typename TPointsContainer::Pointer points = TPointsContainer::New();
+  FillPoints( points.GetPointer(), 3000, seed );
+  typename TPointsContainer::Pointer queries = TPointsContainer::New();
+  FillPoints( queries.GetPointer(), 500, seed );
+
+  const unsigned int      bucketSizes[] = { 1, 16 };
+  const itk::ThreadIdType numberOfThreads[] = { 1, 4 };
+  for( unsigned int b = 0; b < 2; ++b )
+    {
+    for( unsigned int t = 0; t < 2; ++t )
+      {
+      typename LocatorType::Pointer locator = LocatorType::New();
+      locator->SetBucketSize( bucketSizes[b] );
+      locator->SetNumberOfThreads( numberOfThreads[t] );
+      locator->SetPoints( points );
+      locator->Initialize();
+      if( !CheckLocator< TPointsContainer >( locator, points, queries ) )
+        {
+        std::cerr << "Bucket size " << bucketSizes[b] << ", " << numberOfThreads[t] << " threads" << std::endl;
+        return false;
+        }
+
+      // a new bucket size is only used once the tree is built again
+      locator->SetBucketSize( bucketSizes[1 - b] );
+      if( !CheckLocator< TPointsContainer >( locator, points, queries ) )
+        {
+        std::cerr << "Bucket size " << bucketSizes[b] << ", " << numberOfThreads[t]
+                  << " threads, after changing the bucket size" << std::endl;
+        return false;
+        }
+      locator->SetBucketSize( bucketSizes[b] );
+
+      // move the points and update the tree
+      for( typename TPointsContainer::Iterator it = points->Begin(); it != points->End(); ++it )
+        {
+        PointType & point = it.Value();
+        point[0] = 100.0f - point[0];
+        point[1] += 0.2f * point[2];
+        }
+      locator->UpdatePointPositions();
+      if( !CheckLocator< TPointsContainer >( locator, points, queries ) )
+        {
+        std::cerr << "Bucket size " << bucketSizes[b] << ", " << numberOfThreads[t]
+                  << " threads, after moving the points" << std::endl;
+        return false;
+        }
+
+      // add a point: the tree is built again
+      PointType point;
+      point.Fill( 50.0f );
+      points->InsertElement( 1000000, point );
+      locator->UpdatePointPositions();
+      if( !CheckLocator< TPointsContainer >( locator, points, queries ) )
+        {
+        std::cerr << "Bucket size " << bucketSizes[b] << ", " << numberOfThreads[t]
+                  << " threads, after adding a point" << std::endl;
+        return false;
+        }
+      points->DeleteIndex( 1000000 );
+      }
+    }
+  return true;
+}
+}
+
+// Compare the searches of the points locator, one query at a time and given
+// a container of queries, to a brute force search.
+int itkPointsLocatorBatchTest( int, char* [] )
+{
+  typedef itk::MapContainer< unsigned int, PointType > MapContainerType;
+
+  typedef itk::PointsLocator< MapContainerType > LocatorType;
+  LocatorType::Pointer locator = LocatorType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( locator, PointsLocator, Object );
+  TEST_SET_GET_VALUE( 16, locator->GetBucketSize() );
+
+  MapContainerType::Pointer points = MapContainerType::New();
+  locator->SetPoints( points );
+  TRY_EXPECT_EXCEPTION( locator->Initialize() );
+
+  TEST_EXPECT_TRUE( CheckContainer< MapContainerType >() );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
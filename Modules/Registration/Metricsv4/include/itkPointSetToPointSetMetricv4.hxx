@@ -525,12 +525,19 @@ PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputation
       {
       itkExceptionMacro( "The fixed transformed point set does not exist." );
       }
+    // The transformed points keep their identifiers and their order, so the
+    // tree of an existing locator is only refitted to their new positions.
     if( ! this->m_FixedTransformedPointsLocator )
       {
       this->m_FixedTransformedPointsLocator = PointsLocatorType::New();
+      this->m_FixedTransformedPointsLocator->SetPoints( this->m_FixedTransformedPointSet->GetPoints() );
+      this->m_FixedTransformedPointsLocator->Initialize();
+      }
+    else
+      {
+      this->m_FixedTransformedPointsLocator->SetPoints( this->m_FixedTransformedPointSet->GetPoints() );
+      this->m_FixedTransformedPointsLocator->UpdatePointPositions();
       }
-    this->m_FixedTransformedPointsLocator->SetPoints( this->m_FixedTransformedPointSet->GetPoints() );
-    this->m_FixedTransformedPointsLocator->Initialize();
     }
 
   if( this->m_MovingTransformPointLocatorsNeedInitialization )
@@ -542,9 +549,14 @@ PointSetToPointSetMetricv4<TFixedPointSet, TMovingPointSet, TInternalComputation
     if( ! this->m_MovingTransformedPointsLocator )
       {
       this->m_MovingTransformedPointsLocator = PointsLocatorType::New();
+      this->m_MovingTransformedPointsLocator->SetPoints( this->m_MovingTransformedPointSet->GetPoints() );
+      this->m_MovingTransformedPointsLocator->Initialize();
+      }
+    else
+      {
+      this->m_MovingTransformedPointsLocator->SetPoints( this->m_MovingTransformedPointSet->GetPoints() );
+      this->m_MovingTransformedPointsLocator->UpdatePointPositions();
       }
-    this->m_MovingTransformedPointsLocator->SetPoints( this->m_MovingTransformedPointSet->GetPoints() );
-    this->m_MovingTransformedPointsLocator->Initialize();
     }
 }
 
@@ -22,6 +22,7 @@
 #include "itkImage.h"
 #include <vector>
 #include <map>
+#include <utility>
 #include "itkProgressReporter.h"
 #include "itkBarrier.h"
 
@@ -45,6 +46,14 @@ namespace itk
  *
  * After the filter is executed, ObjectCount holds the number of connected components.
  *
+ * The lines of the image are split between the threads. Each thread
+ * encodes its lines, numbers their runs and merges the runs connected
+ * within its lines. The runs connected across the boundary between two
+ * threads are only recorded, and merged once all the threads are done,
+ * so that the serial part of the algorithm is proportional to the size of
+ * the boundaries. The consecutive labels are then computed and written in
+ * parallel.
+ *
  * \sa ImageToImageFilter
  *
  * \ingroup SingleThreaded
@@ -238,13 +247,21 @@ public:
 
   void LinkLabels(const LabelType lab1, const LabelType lab2);
 
-  SizeValueType CreateConsecutive();
+  /** Find the root of the set of a label, without modifying the sets. */
+  LabelType FindRoot(LabelType label) const;
+
+  // pairs of labels of connected runs
+  typedef std::pair< LabelType, LabelType > LabelPairType;
+  typedef std::vector< LabelPairType >      LabelPairVectorType;
 
   //////////////////
   bool CheckNeighbors(const OutputIndexType & A,
                       const OutputIndexType & B);
 
-  void CompareLines(lineEncoding & current, const lineEncoding & Neighbour);
+  /** Link the labels of the connected runs of two neighbor lines, or only
+   * record their pairs in "pairs" if it is not null. */
+  void CompareLines(lineEncoding & current, const lineEncoding & Neighbour,
+                    LabelPairVectorType *pairs = ITK_NULLPTR);
 
   void FillOutput(const LineMapType & LineMap,
                   ProgressReporter & progress);
@@ -261,7 +278,11 @@ public:
   }
 
   typename std::vector< IdentifierType > m_NumberOfLabels;
-  typename std::vector< IdentifierType > m_FirstLineIdToJoin;
+  typename std::vector< IdentifierType > m_NumberOfObjects;
+
+  // the pairs of connected runs across the boundary between each thread
+  // and the previous one
+  std::vector< LabelPairVectorType > m_BoundaryPairs;
 
   typename Barrier::Pointer m_Barrier;
 
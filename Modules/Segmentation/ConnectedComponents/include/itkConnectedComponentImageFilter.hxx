@@ -27,6 +27,7 @@
 #include "itkImageRegionIterator.h"
 #include "itkMaskImageFilter.h"
 #include "itkConnectedComponentAlgorithm.h"
+#include <algorithm>
 
 namespace itk
 {
@@ -107,7 +108,10 @@ ConnectedComponentImageFilter< TInputImage, TOutputImage, TMaskImage >
   const SizeValueType xsize = output->GetRequestedRegion().GetSize()[0];
   const SizeValueType linecount = pixelcount / xsize;
   m_LineMap.resize(linecount);
-  m_FirstLineIdToJoin.resize(nbOfThreads - 1);
+  m_NumberOfObjects.clear();
+  m_NumberOfObjects.resize(nbOfThreads, 0);
+  m_BoundaryPairs.clear();
+  m_BoundaryPairs.resize(nbOfThreads);
 }
 
 template< typename TInputImage, typename TOutputImage, typename TMaskImage >
@@ -202,69 +206,72 @@ ConnectedComponentImageFilter< TInputImage, TOutputImage, TMaskImage >
   // wait for the other threads to complete that part
   this->Wait();
 
-  // compute the total number of labels
-  nbOfLabels = 0;
+  // The lines of the threads are consecutive, so the labels of the runs of
+  // this thread start after the ones of the previous threads and the
+  // labels still follow the raster order.
+  LabelType firstLabelForThread = 1;
+  LabelType totalNbOfLabels = 0;
   for ( ThreadIdType i = 0; i < nbOfThreads; i++ )
     {
-    nbOfLabels += m_NumberOfLabels[i];
+    if ( i < threadId )
+      {
+      firstLabelForThread += m_NumberOfLabels[i];
+      }
+    totalNbOfLabels += m_NumberOfLabels[i];
     }
+  const LabelType lastLabelForThread = firstLabelForThread + nbOfLabels;
 
   if ( threadId == 0 )
     {
     // set up the union find structure
-    InitUnion(nbOfLabels);
-    // insert all the labels into the structure -- an extra loop but
-    // saves complicating the ones that come later
-    typename LineMapType::iterator MapBegin = m_LineMap.begin();
-    typename LineMapType::iterator MapEnd = m_LineMap.end();
-    typename LineMapType::iterator LineIt = MapBegin;
-    SizeValueType label = 1;
-    for ( LineIt = MapBegin; LineIt != MapEnd; ++LineIt )
+    InitUnion(totalNbOfLabels);
+    m_Consecutive = UnionFindType( m_UnionFind.size() );
+    }
+
+  // wait for the other threads to complete that part
+  this->Wait();
+
+  const LineIdType lastLineIdForThread = firstLineIdForThread + linecountForThread;
+  LabelType        label = firstLabelForThread;
+  for ( LineIdType ThisIdx = firstLineIdForThread; ThisIdx < lastLineIdForThread; ++ThisIdx )
+    {
+    for ( typename lineEncoding::iterator cIt = m_LineMap[ThisIdx].begin(); cIt != m_LineMap[ThisIdx].end(); ++cIt )
       {
-      for ( typename lineEncoding::iterator cIt = LineIt->begin(); cIt != LineIt->end(); ++cIt )
-        {
-        cIt->label = label;
-        InsertSet(label);
-        label++;
-        }
+      cIt->label = label;
+      InsertSet(label);
+      label++;
       }
     }
 
-  // wait for the other threads to complete that part
+  // wait for the other threads to label their runs: the runs of the
+  // previous thread are read on the boundary
   this->Wait();
 
   // now process the map and make appropriate entries in an equivalence
-  // table
-  // itkAssertInDebugAndIgnoreInReleaseMacro( linecount == m_LineMap.size() );
+  // table. The lines of this thread are first compared to the ones of this
+  // thread only, so that only the sets of the labels of this thread are
+  // modified.
   const SizeValueType pixelcount = output->GetRequestedRegion().GetNumberOfPixels();
   const SizeValueType xsize = output->GetRequestedRegion().GetSize()[0];
   const SizeValueType linecount = pixelcount / xsize;
 
-  SizeValueType lastLineIdForThread =  linecount;
-  SizeValueType nbOfLineIdToJoin = 0;
-  if ( threadId != nbOfThreads - 1 )
+  OffsetValueType maxOffset = 0;
+  for ( typename OffsetVec::const_iterator I = LineOffsets.begin(); I != LineOffsets.end(); ++I )
     {
-    outputRegionForThreadSize = outputRegionForThread.GetSize();
-    outputRegionForThreadSize[splitAxis] -= 1;
-    lastLineIdForThread = firstLineIdForThread
-                          + RegionType(outputRegionIdx, outputRegionForThreadSize).GetNumberOfPixels() / xsizeForThread;
-    m_FirstLineIdToJoin[threadId] = lastLineIdForThread;
-    // found the number of line ids to join
-    nbOfLineIdToJoin =
-      RegionType( outputRegionIdx, outputRegionForThread.GetSize() ).GetNumberOfPixels() / xsizeForThread
-      - RegionType(outputRegionIdx, outputRegionForThreadSize).GetNumberOfPixels() / xsizeForThread;
+    maxOffset = std::max( maxOffset, -( *I ) );
     }
 
-  for ( SizeValueType ThisIdx = firstLineIdForThread; ThisIdx < lastLineIdForThread; ++ThisIdx )
+  for ( LineIdType ThisIdx = firstLineIdForThread; ThisIdx < lastLineIdForThread; ++ThisIdx )
     {
     if ( !m_LineMap[ThisIdx].empty() )
       {
       for ( typename OffsetVec::const_iterator I = LineOffsets.begin();
             I != LineOffsets.end(); ++I )
         {
-        const OffsetValueType NeighIdx = ( *I ) + ThisIdx;
-        // check if the neighbor is in the map
-        if ( NeighIdx >= 0 && NeighIdx < static_cast<OffsetValueType>( linecount ) && !m_LineMap[NeighIdx].empty() )
+        const OffsetValueType NeighIdx = ( *I ) + static_cast< OffsetValueType >( ThisIdx );
+        // check if the neighbor is in the map, and in the lines of this thread
+        if ( NeighIdx >= static_cast< OffsetValueType >( firstLineIdForThread )
+             && NeighIdx < static_cast< OffsetValueType >( linecount ) && !m_LineMap[NeighIdx].empty() )
           {
           // Now check whether they are really neighbors
           const bool areNeighbors =
@@ -279,65 +286,91 @@ ConnectedComponentImageFilter< TInputImage, TOutputImage, TMaskImage >
       }
     }
 
-  // wait for the other threads to complete that part
-  this->Wait();
-
-  while ( m_FirstLineIdToJoin.size() != 0 )
+  // The pairs of runs connected across the boundary with the previous
+  // thread are only recorded: the sets of the labels of the previous thread
+  // may be modified at the same time by that thread.
+  LabelPairVectorType & boundaryPairs = m_BoundaryPairs[threadId];
+  boundaryPairs.clear();
+  if ( threadId > 0 )
     {
-    if ( threadId * 2 < static_cast<ThreadIdType>( m_FirstLineIdToJoin.size() ) )
+    const LineIdType lastBoundaryLineId =
+      std::min( lastLineIdForThread, firstLineIdForThread + static_cast< LineIdType >( maxOffset ) );
+    for ( LineIdType ThisIdx = firstLineIdForThread; ThisIdx < lastBoundaryLineId; ++ThisIdx )
       {
-      for ( SizeValueType ThisIdx = m_FirstLineIdToJoin[threadId * 2];
-            ThisIdx < m_FirstLineIdToJoin[threadId * 2] + nbOfLineIdToJoin;
-            ++ThisIdx )
+      if ( !m_LineMap[ThisIdx].empty() )
         {
-        if ( !m_LineMap[ThisIdx].empty() )
+        for ( typename OffsetVec::const_iterator I = LineOffsets.begin();
+              I != LineOffsets.end(); ++I )
           {
-          for ( typename OffsetVec::const_iterator I = LineOffsets.begin();
-                I != LineOffsets.end(); ++I )
+          const OffsetValueType NeighIdx = ( *I ) + static_cast< OffsetValueType >( ThisIdx );
+          if ( NeighIdx >= 0 && NeighIdx < static_cast< OffsetValueType >( firstLineIdForThread )
+               && !m_LineMap[NeighIdx].empty() )
             {
-            const OffsetValueType NeighIdx = ( *I ) + ThisIdx;
-            // check if the neighbor is in the map
-            if ( NeighIdx >= 0 && NeighIdx < static_cast<OffsetValueType>( linecount ) && !m_LineMap[NeighIdx].empty() )
+            const bool areNeighbors =
+              CheckNeighbors(m_LineMap[ThisIdx][0].where, m_LineMap[NeighIdx][0].where);
+            if ( areNeighbors )
               {
-              // Now check whether they are really neighbors
-              const bool areNeighbors =
-                CheckNeighbors(m_LineMap[ThisIdx][0].where, m_LineMap[NeighIdx][0].where);
-              if ( areNeighbors )
-                {
-                // Compare the two lines
-                CompareLines(m_LineMap[ThisIdx], m_LineMap[NeighIdx]);
-                }
+              CompareLines(m_LineMap[ThisIdx], m_LineMap[NeighIdx], &boundaryPairs);
               }
             }
           }
         }
       }
+    }
 
-    this->Wait();
+  // wait for the other threads to complete that part
+  this->Wait();
 
-    if ( threadId == 0 )
+  if ( threadId == 0 )
+    {
+    // merge the sets across the thread boundaries. There are only as many
+    // pairs as connected runs on the boundaries.
+    for ( ThreadIdType i = 1; i < nbOfThreads; i++ )
       {
-      // remove the region already joined
-      typename std::vector< SizeValueType > newFirstLineIdToJoin;
-      for ( unsigned int i = 1; i < m_FirstLineIdToJoin.size(); i += 2 )
+      for ( typename LabelPairVectorType::const_iterator pIt = m_BoundaryPairs[i].begin();
+            pIt != m_BoundaryPairs[i].end(); ++pIt )
         {
-        newFirstLineIdToJoin.push_back(m_FirstLineIdToJoin[i]);
+        LinkLabels(pIt->first, pIt->second);
         }
-      m_FirstLineIdToJoin = newFirstLineIdToJoin;
       }
-
-    this->Wait();
     }
 
-  if ( threadId == 0 )
+  // wait for the other threads to complete that part
+  this->Wait();
+
+  // The root of a set is its smallest label. Count the sets whose root is
+  // in the labels of this thread, then give them consecutive labels in
+  // raster order.
+  SizeValueType nbOfObjects = 0;
+  for ( LabelType l = firstLabelForThread; l < lastLabelForThread; ++l )
     {
-    m_ObjectCount = CreateConsecutive();
+    if ( m_UnionFind[l] == l )
+      {
+      ++nbOfObjects;
+      }
     }
+  m_NumberOfObjects[threadId] = nbOfObjects;
 
+  // wait for the other threads to complete that part
   this->Wait();
 
+  SizeValueType firstObjectForThread = 0;
+  SizeValueType objectCount = 0;
+  for ( ThreadIdType i = 0; i < nbOfThreads; i++ )
+    {
+    if ( i < threadId )
+      {
+      firstObjectForThread += m_NumberOfObjects[i];
+      }
+    objectCount += m_NumberOfObjects[i];
+    }
+  if ( threadId == 0 )
+    {
+    m_ObjectCount = objectCount;
+    }
+
   // check for overflow exception here
-  if ( m_ObjectCount > static_cast< SizeValueType >(
+  if ( objectCount > static_cast< SizeValueType >(
          NumericTraits< OutputPixelType >::max() ) )
     {
     if ( threadId == 0 )
@@ -353,6 +386,21 @@ ConnectedComponentImageFilter< TInputImage, TOutputImage, TMaskImage >
       }
     }
 
+  // the background value is skipped
+  const SizeValueType backgroundValue = static_cast< SizeValueType >( m_BackgroundValue );
+  SizeValueType       object = firstObjectForThread;
+  for ( LabelType l = firstLabelForThread; l < lastLabelForThread; ++l )
+    {
+    if ( m_UnionFind[l] == l )
+      {
+      m_Consecutive[l] = ( object >= backgroundValue ) ? object + 1 : object;
+      ++object;
+      }
+    }
+
+  // wait for the other threads to complete that part
+  this->Wait();
+
   // create the output
   // A more complex version that is intended to minimize the number of
   // visits to the output image which should improve cache
@@ -368,17 +416,13 @@ ConnectedComponentImageFilter< TInputImage, TOutputImage, TMaskImage >
   ImageRegionIterator< OutputImageType > fend = oit;
   fend.GoToEnd();
 
-  lastLineIdForThread = firstLineIdForThread
-                        + RegionType( outputRegionIdx,
-                                      outputRegionForThread.GetSize() ).GetNumberOfPixels() / xsizeForThread;
-
-  for ( SizeValueType ThisIdx = firstLineIdForThread; ThisIdx < lastLineIdForThread; ThisIdx++ )
+  for ( LineIdType ThisIdx = firstLineIdForThread; ThisIdx < lastLineIdForThread; ThisIdx++ )
     {
     // now fill the labelled sections
     for ( typename lineEncoding::const_iterator cIt = m_LineMap[ThisIdx].begin(); cIt != m_LineMap[ThisIdx].end(); ++cIt )
       {
-      const SizeValueType   Ilab = LookupSet(cIt->label);
-      const OutputPixelType lab = m_Consecutive[Ilab];
+      const LabelType       Ilab = FindRoot(cIt->label);
+      const OutputPixelType lab = static_cast< OutputPixelType >( m_Consecutive[Ilab] );
       oit.SetIndex(cIt->where);
       // initialize the non labelled pixels
       for (; fstart != oit; ++fstart )
@@ -407,8 +451,12 @@ ConnectedComponentImageFilter< TInputImage, TOutputImage, TMaskImage >
 ::AfterThreadedGenerateData()
 {
   m_NumberOfLabels.clear();
+  m_NumberOfObjects.clear();
+  m_BoundaryPairs.clear();
   m_Barrier = ITK_NULLPTR;
   m_LineMap.clear();
+  UnionFindType().swap(m_UnionFind);
+  UnionFindType().swap(m_Consecutive);
   m_Input = ITK_NULLPTR;
 }
 
@@ -495,7 +543,8 @@ ConnectedComponentImageFilter< TInputImage, TOutputImage, TMaskImage >
 template< typename TInputImage, typename TOutputImage, typename TMaskImage >
 void
 ConnectedComponentImageFilter< TInputImage, TOutputImage, TMaskImage >
-::CompareLines(lineEncoding & current, const lineEncoding & Neighbour)
+::CompareLines(lineEncoding & current, const lineEncoding & Neighbour,
+               LabelPairVectorType *pairs)
 {
   long offset = 0;
 
@@ -570,7 +619,14 @@ ConnectedComponentImageFilter< TInputImage, TOutputImage, TMaskImage >
         }
       if ( eq )
         {
-        LinkLabels(nIt->label, cIt->label);
+        if ( pairs )
+          {
+          pairs->push_back( LabelPairType(nIt->label, cIt->label) );
+          }
+        else
+          {
+          LinkLabels(nIt->label, cIt->label);
+          }
         }
 
       if ( ee1 >= cLast )
@@ -594,29 +650,16 @@ ConnectedComponentImageFilter< TInputImage, TOutputImage, TMaskImage >
 }
 
 template< typename TInputImage, typename TOutputImage, typename TMaskImage >
-SizeValueType
+typename ConnectedComponentImageFilter< TInputImage, TOutputImage, TMaskImage >::LabelType
 ConnectedComponentImageFilter< TInputImage, TOutputImage, TMaskImage >
-::CreateConsecutive()
+::FindRoot(LabelType label) const
 {
-  m_Consecutive = UnionFindType( m_UnionFind.size() );
-
-  SizeValueType CLab = 0;
-  SizeValueType count = 0;
-  for ( SizeValueType I = 1; I < m_UnionFind.size(); I++ )
+  // no path compression: the sets may be read by several threads
+  while ( label != m_UnionFind[label] )
     {
-    SizeValueType L = m_UnionFind[I];
-    if ( L == I )
-      {
-      if ( CLab == static_cast< SizeValueType >( m_BackgroundValue ) )
-        {
-        ++CLab;
-        }
-      m_Consecutive[L] = CLab;
-      ++CLab;
-      ++count;
-      }
+    label = m_UnionFind[label];
     }
-  return count;
+  return label;
 }
 
 template< typename TInputImage, typename TOutputImage, typename TMaskImage >
@@ -0,0 +1,125 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkConnectedComponentImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkTestingMacros.h"
+
+// Check that the labels do not depend on the number of threads, in
+// particular for objects crossing the boundaries between the regions of
+// several threads, and that they are consecutive and in raster order.
+int itkConnectedComponentImageFilterThreadsTest(int, char* [] )
+{
+  const unsigned int Dimension = 3;
+
+  typedef unsigned char                            PixelType;
+  typedef unsigned short                           LabelPixelType;
+  typedef itk::Image< PixelType, Dimension >       ImageType;
+  typedef itk::Image< LabelPixelType, Dimension >  LabelImageType;
+
+  typedef itk::ConnectedComponentImageFilter< ImageType, LabelImageType > FilterType;
+
+  ImageType::SizeType size;
+  size[0] = 31;
+  size[1] = 27;
+  size[2] = 23;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+
+  // a random image dense enough to get objects spread over many slices
+  unsigned int seed = 1234;
+  itk::ImageRegionIterator< ImageType > it( image, image->GetLargestPossibleRegion() );
+  for ( it.GoToBegin(); !it.IsAtEnd(); ++it )
+    {
+    seed = seed * 1103515245u + 12345u;
+    it.Set( ( ( seed >> 16 ) % 100 ) < 40 ? 1 : 0 );
+    }
+
+  const itk::ThreadIdType numberOfThreads[4] = { 2, 3, 5, 8 };
+  const LabelPixelType    backgroundValues[2] = { 0, 3 };
+
+  for ( unsigned int fullyConnected = 0; fullyConnected < 2; ++fullyConnected )
+    {
+    for ( unsigned int b = 0; b < 2; ++b )
+      {
+      FilterType::Pointer reference = FilterType::New();
+      reference->SetInput( image );
+      reference->SetFullyConnected( fullyConnected != 0 );
+      reference->SetBackgroundValue( backgroundValues[b] );
+      reference->SetNumberOfThreads( 1 );
+      TRY_EXPECT_NO_EXCEPTION( reference->Update() );
+
+      // consecutive labels in raster order, skipping the background value
+      LabelPixelType nextLabel = ( backgroundValues[b] == 0 ) ? 1 : 0;
+      itk::ImageRegionConstIterator< LabelImageType > rit( reference->GetOutput(),
+                                                            reference->GetOutput()->GetLargestPossibleRegion() );
+      for ( rit.GoToBegin(); !rit.IsAtEnd(); ++rit )
+        {
+        if ( rit.Get() == nextLabel )
+          {
+          ++nextLabel;
+          if ( nextLabel == backgroundValues[b] )
+            {
+            ++nextLabel;
+            }
+          }
+        else if ( rit.Get() != backgroundValues[b] && rit.Get() > nextLabel )
+          {
+          std::cerr << "Label " << rit.Get() << " found before label " << nextLabel
+                    << " at " << rit.GetIndex() << std::endl;
+          return EXIT_FAILURE;
+          }
+        }
+      std::cout << "FullyConnected " << fullyConnected << ", BackgroundValue " << backgroundValues[b]
+                << ": " << reference->GetObjectCount() << " objects" << std::endl;
+      if ( reference->GetObjectCount() < 2 )
+        {
+        std::cerr << "Too few objects" << std::endl;
+        return EXIT_FAILURE;
+        }
+
+      for ( unsigned int t = 0; t < 4; ++t )
+        {
+        FilterType::Pointer filter = FilterType::New();
+        filter->SetInput( image );
+        filter->SetFullyConnected( fullyConnected != 0 );
+        filter->SetBackgroundValue( backgroundValues[b] );
+        filter->SetNumberOfThreads( numberOfThreads[t] );
+        TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+
+        TEST_EXPECT_EQUAL( filter->GetObjectCount(), reference->GetObjectCount() );
+
+        itk::ImageRegionConstIterator< LabelImageType > fit( filter->GetOutput(),
+                                                              filter->GetOutput()->GetLargestPossibleRegion() );
+        for ( rit.GoToBegin(), fit.GoToBegin(); !fit.IsAtEnd(); ++rit, ++fit )
+          {
+          if ( fit.Get() != rit.Get() )
+            {
+            std::cerr << "Mismatch with " << numberOfThreads[t] << " threads at " << fit.GetIndex()
+                      << ": " << fit.Get() << " instead of " << rit.Get() << std::endl;
+            return EXIT_FAILURE;
+            }
+          }
+        }
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -219,6 +219,12 @@ public:
   virtual void ReleaseGlobalDataPointer(void *GlobalData) const ITK_OVERRIDE
   { delete (GlobalDataStruct *)GlobalData; }
 
+  /** Merges the largest changes stored in a global data structure into
+   * another one, as if the calculations made with the second had been made
+   * with the first.  A solver which gives each of its threads its own global
+   * data uses this method to compute a single time step for all of them. */
+  virtual void MergeGlobalData(void *GlobalData, const void *OtherGlobalData) const;
+
   /**  */
   virtual ScalarValueType ComputeCurvatureTerm(const NeighborhoodType &,
                                                const FloatOffsetType &,
@@ -269,6 +269,19 @@ LevelSetFunction< TImageType >
   return dt;
 }
 
+template< typename TImageType >
+void
+LevelSetFunction< TImageType >
+::MergeGlobalData(void *GlobalData, const void *OtherGlobalData) const
+{
+  GlobalDataStruct *      d = (GlobalDataStruct *)GlobalData;
+  const GlobalDataStruct *o = (const GlobalDataStruct *)OtherGlobalData;
+
+  d->m_MaxAdvectionChange = std::max(d->m_MaxAdvectionChange, o->m_MaxAdvectionChange);
+  d->m_MaxPropagationChange = std::max(d->m_MaxPropagationChange, o->m_MaxPropagationChange);
+  d->m_MaxCurvatureChange = std::max(d->m_MaxCurvatureChange, o->m_MaxCurvatureChange);
+}
+
 template< typename TImageType >
 void
 LevelSetFunction< TImageType >
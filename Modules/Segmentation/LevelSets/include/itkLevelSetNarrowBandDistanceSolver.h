@@ -0,0 +1,199 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLevelSetNarrowBandDistanceSolver_h
+#define itkLevelSetNarrowBandDistanceSolver_h
+
+#include "itkLightProcessObject.h"
+#include "itkLevelSet.h"
+#include "itkFastIterativeBlockScheduler.h"
+#include <vector>
+
+namespace itk
+{
+/** \class LevelSetNarrowBandDistanceSolver
+ * \brief Compute the distances from a level set within a narrowband, with
+ * several threads.
+ *
+ * LevelSetNarrowBandDistanceSolver computes the same distances as a
+ * FastMarchingImageFilter with a unit speed, started from the trial points
+ * located by a LevelSetNeighborhoodExtractor and stopped at the
+ * StoppingValue.  The method Solve() fills the container of processed
+ * points with the pixels whose distance is not larger than the stopping
+ * value, sorted by increasing distance.
+ *
+ * The output region is divided in blocks of BlockSize pixels along each
+ * axis.  Only the blocks reached by the narrowband are allocated and
+ * updated, so that the work and the memory are proportional to the size
+ * of the narrowband instead of the size of the region.  The active blocks
+ * are updated in parallel with sweeps in alternating directions until
+ * their distances no longer decrease, and a block whose distances changed
+ * on a face activates the block on the other side of that face, if these
+ * distances are within the narrowband.  The blocks are scheduled by a
+ * FastIterativeBlockScheduler, as in the FastIterativeImageFilterBase, so
+ * that the result does not depend on the number of threads.  The iterations
+ * converge to the solution of the discrete equations solved by fast
+ * marching, so that the distances are equal up to the rounding errors.
+ *
+ * Based on W.-K. Jeong and R. T. Whitaker, "A Fast Iterative Method for
+ * Eikonal Equations", SIAM Journal on Scientific Computing, 30(5),
+ * 2512-2534, 2008.
+ *
+ * \sa ReinitializeLevelSetImageFilter
+ * \sa FastMarchingImageFilter
+ * \sa FastIterativeBlockScheduler
+ *
+ * \ingroup LevelSetSegmentation
+ * \ingroup ITKLevelSets
+ */
+template< typename TLevelSet >
+class ITK_TEMPLATE_EXPORT LevelSetNarrowBandDistanceSolver:
+  public LightProcessObject
+{
+public:
+  /** Standard class typdedefs. */
+  typedef LevelSetNarrowBandDistanceSolver Self;
+  typedef LightProcessObject               Superclass;
+  typedef SmartPointer< Self >             Pointer;
+  typedef SmartPointer< const Self >       ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(LevelSetNarrowBandDistanceSolver, LightProcessObject);
+
+  /** LevelSetType typedef support. */
+  typedef LevelSetTypeDefault< TLevelSet >            LevelSetType;
+  typedef typename LevelSetType::LevelSetImageType    LevelSetImageType;
+  typedef typename LevelSetType::PixelType            PixelType;
+  typedef typename LevelSetType::NodeType             NodeType;
+  typedef typename LevelSetType::NodeContainer        NodeContainer;
+  typedef typename LevelSetType::NodeContainerPointer NodeContainerPointer;
+
+  /** SetDimension enumeration. */
+  itkStaticConstMacro(SetDimension, unsigned int,
+                      LevelSetType::SetDimension);
+
+  /** Region, index and spacing typedef support. */
+  typedef typename LevelSetImageType::RegionType  RegionType;
+  typedef typename LevelSetImageType::IndexType   IndexType;
+  typedef typename LevelSetImageType::SpacingType SpacingType;
+
+  /** Set/Get the region over which the distances are computed. */
+  itkSetMacro(OutputRegion, RegionType);
+  itkGetConstReferenceMacro(OutputRegion, RegionType);
+
+  /** Set/Get the spacing of the pixels. */
+  itkSetMacro(OutputSpacing, SpacingType);
+  itkGetConstReferenceMacro(OutputSpacing, SpacingType);
+
+  /** Set/Get the trial points, whose distances are given. */
+  void SetTrialPoints(NodeContainer *ptr)
+  {
+    m_TrialPoints = ptr;
+    this->Modified();
+  }
+  itkGetModifiableObjectMacro(TrialPoints, NodeContainer);
+
+  /** Set/Get the largest distance of the narrowband. */
+  itkSetMacro(StoppingValue, double);
+  itkGetConstMacro(StoppingValue, double);
+
+  /** Set/Get the number of pixels of the blocks along each axis.  Defaults
+   * to 8. */
+  itkSetClampMacro( BlockSize, unsigned int, 1, NumericTraits< unsigned int >::max() );
+  itkGetConstMacro(BlockSize, unsigned int);
+
+  /** Set/Get the number of threads.  Defaults to the global default number
+   * of threads. */
+  itkSetClampMacro( NumberOfThreads, ThreadIdType, 1, ITK_MAX_THREADS );
+  itkGetConstMacro(NumberOfThreads, ThreadIdType);
+
+  /** Get the pixels of the narrowband with their distances, sorted by
+   * increasing distance. */
+  NodeContainerPointer GetProcessedPoints() const
+  { return m_ProcessedPoints; }
+
+  /** Get the number of blocks allocated by the last call to Solve(). */
+  itkGetConstMacro(NumberOfAllocatedBlocks, SizeValueType);
+
+  /** Compute the distances. */
+  void Solve();
+
+protected:
+  LevelSetNarrowBandDistanceSolver();
+  ~LevelSetNarrowBandDistanceSolver(){}
+  virtual void PrintSelf(std::ostream & os, Indent indent) const ITK_OVERRIDE;
+
+  virtual void GenerateData() ITK_OVERRIDE;
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(LevelSetNarrowBandDistanceSolver);
+
+  typedef FastIterativeBlockScheduler< SetDimension > SchedulerType;
+  friend class FastIterativeBlockScheduler< SetDimension >;
+
+  /** Allocate a block, with all its distances set to the large value. */
+  void AllocateBlock(SizeValueType block);
+
+  /** A block is allocated when it is activated. */
+  void BlockActivated(SizeValueType block)
+  { this->AllocateBlock(block); }
+
+  /** Update the pixels of a block until their distances no longer
+   * decrease, and return the faces of the block whose distances changed
+   * within the narrowband, as bits 2 * axis for the lower face and
+   * 2 * axis + 1 for the upper one. */
+  unsigned int UpdateBlock(SizeValueType block);
+
+  /** Get the distance of the neighbor of a pixel of a block along an axis,
+   * or the large value if the neighbor is outside the region or in a block
+   * which is not allocated. */
+  PixelType GetNeighborValue(SizeValueType block, SizeValueType localOffset,
+                             const IndexValueType position[], const SizeValueType local[],
+                             unsigned int axis, bool upper) const;
+
+  RegionType           m_OutputRegion;
+  SpacingType          m_OutputSpacing;
+  NodeContainerPointer m_TrialPoints;
+  NodeContainerPointer m_ProcessedPoints;
+  double               m_StoppingValue;
+  unsigned int         m_BlockSize;
+  ThreadIdType         m_NumberOfThreads;
+  PixelType            m_LargeValue;
+  SizeValueType        m_NumberOfAllocatedBlocks;
+
+  /** The grid of blocks, and the strides of the pixels in a block. */
+  SchedulerType m_Scheduler;
+  SizeValueType m_LocalStrides[SetDimension];
+  SizeValueType m_BlockVolume;
+
+  /** The distances of the pixels of each block, and whether they are trial
+   * points.  Both are empty for the blocks which are not allocated. */
+  std::vector< std::vector< PixelType > >     m_BlockValues;
+  std::vector< std::vector< unsigned char > > m_BlockTrialPoints;
+
+  MultiThreader::Pointer m_MultiThreader;
+};
+} // namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkLevelSetNarrowBandDistanceSolver.hxx"
+#endif
+
+#endif
@@ -0,0 +1,415 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkLevelSetNarrowBandDistanceSolver_hxx
+#define itkLevelSetNarrowBandDistanceSolver_hxx
+
+#include "itkLevelSetNarrowBandDistanceSolver.h"
+#include <algorithm>
+
+namespace itk
+{
+/**
+ * Default constructor.
+ */
+template< typename TLevelSet >
+LevelSetNarrowBandDistanceSolver< TLevelSet >
+::LevelSetNarrowBandDistanceSolver()
+{
+  m_OutputSpacing.Fill(1.0);
+  m_TrialPoints = ITK_NULLPTR;
+  m_ProcessedPoints = NodeContainer::New();
+  m_StoppingValue = static_cast< double >( NumericTraits< PixelType >::max() / 2.0 );
+  m_BlockSize = 8;
+  m_NumberOfThreads = MultiThreader::GetGlobalDefaultNumberOfThreads();
+  m_LargeValue = static_cast< PixelType >( NumericTraits< PixelType >::max() / 2.0 );
+  m_NumberOfAllocatedBlocks = 0;
+  m_BlockVolume = 0;
+  for ( unsigned int j = 0; j < SetDimension; j++ )
+    {
+    m_LocalStrides[j] = 0;
+    }
+  m_MultiThreader = MultiThreader::New();
+}
+
+/**
+ * PrintSelf method.
+ */
+template< typename TLevelSet >
+void
+LevelSetNarrowBandDistanceSolver< TLevelSet >
+::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Output region: " << m_OutputRegion << std::endl;
+  os << indent << "Output spacing: " << m_OutputSpacing << std::endl;
+  os << indent << "Trial points: " << m_TrialPoints.GetPointer() << std::endl;
+  os << indent << "Processed points: " << m_ProcessedPoints.GetPointer() << std::endl;
+  os << indent << "Stopping value: " << m_StoppingValue << std::endl;
+  os << indent << "Block size: " << m_BlockSize << std::endl;
+  os << indent << "Number of threads: " << m_NumberOfThreads << std::endl;
+  os << indent << "Number of allocated blocks: " << m_NumberOfAllocatedBlocks << std::endl;
+}
+
+template< typename TLevelSet >
+void
+LevelSetNarrowBandDistanceSolver< TLevelSet >
+::Solve()
+{
+  this->GenerateData();
+}
+
+template< typename TLevelSet >
+void
+LevelSetNarrowBandDistanceSolver< TLevelSet >
+::AllocateBlock(SizeValueType block)
+{
+  if ( m_BlockValues[block].empty() )
+    {
+    m_BlockValues[block].assign(m_BlockVolume, m_LargeValue);
+    m_BlockTrialPoints[block].assign(m_BlockVolume, 0);
+    ++m_NumberOfAllocatedBlocks;
+    }
+}
+
+/**
+ * Compute the distances.
+ */
+template< typename TLevelSet >
+void
+LevelSetNarrowBandDistanceSolver< TLevelSet >
+::GenerateData()
+{
+  m_ProcessedPoints = NodeContainer::New();
+
+  const typename RegionType::SizeType size = m_OutputRegion.GetSize();
+  const IndexType                     start = m_OutputRegion.GetIndex();
+
+  m_Scheduler.Initialize(size, m_BlockSize);
+  const SizeValueType numberOfBlocks = m_Scheduler.GetNumberOfBlocks();
+  m_BlockVolume = 1;
+  for ( unsigned int j = 0; j < SetDimension; j++ )
+    {
+    m_LocalStrides[j] = m_BlockVolume;
+    m_BlockVolume *= m_BlockSize;
+    }
+
+  // release the blocks of the last call
+  m_BlockValues.clear();
+  m_BlockTrialPoints.clear();
+  m_BlockValues.resize(numberOfBlocks);
+  m_BlockTrialPoints.resize(numberOfBlocks);
+  m_NumberOfAllocatedBlocks = 0;
+
+  if ( !m_TrialPoints || numberOfBlocks == 0 )
+    {
+    return;
+    }
+
+  // set the trial points in their blocks; the neighbors of a block are
+  // activated by the trial points on its faces
+  typename NodeContainer::ConstIterator pointsIt = m_TrialPoints->Begin();
+  typename NodeContainer::ConstIterator pointsEnd = m_TrialPoints->End();
+  for (; pointsIt != pointsEnd; ++pointsIt )
+    {
+    const NodeType & node = pointsIt.Value();
+    if ( !m_OutputRegion.IsInside( node.GetIndex() ) )
+      {
+      continue;
+      }
+
+    const SizeValueType block = m_Scheduler.GetBlock( node.GetIndex() - start );
+    SizeValueType       localOffset = 0;
+    for ( unsigned int j = 0; j < SetDimension; j++ )
+      {
+      const SizeValueType position = static_cast< SizeValueType >( node.GetIndex()[j] - start[j] );
+      localOffset += ( position % m_BlockSize ) * m_LocalStrides[j];
+      }
+
+    this->AllocateBlock(block);
+    m_BlockValues[block][localOffset] = node.GetValue();
+    m_BlockTrialPoints[block][localOffset] = 1;
+
+    std::vector< SizeValueType > blocksToActivate(1, block);
+    if ( static_cast< double >( node.GetValue() ) <= m_StoppingValue )
+      {
+      for ( unsigned int j = 0; j < SetDimension; j++ )
+        {
+        const SizeValueType local = ( localOffset / m_LocalStrides[j] ) % m_BlockSize;
+        const SizeValueType blockPosition = m_Scheduler.GetBlockPosition(block, j);
+        if ( local == 0 && blockPosition > 0 )
+          {
+          blocksToActivate.push_back( block - m_Scheduler.GetBlockStride(j) );
+          }
+        if ( local == m_BlockSize - 1 && blockPosition + 1 < m_Scheduler.GetNumberOfBlocks(j) )
+          {
+          blocksToActivate.push_back( block + m_Scheduler.GetBlockStride(j) );
+          }
+        }
+      }
+    for ( size_t i = 0; i < blocksToActivate.size(); i++ )
+      {
+      if ( m_Scheduler.ActivateBlock(blocksToActivate[i]) )
+        {
+        this->AllocateBlock(blocksToActivate[i]);
+        }
+      }
+    }
+
+  m_Scheduler.Run(this, m_MultiThreader, m_NumberOfThreads);
+  m_Scheduler.Clear();
+
+  // collect the pixels of the narrowband
+  std::vector< NodeType > nodes;
+  for ( SizeValueType block = 0; block < numberOfBlocks; block++ )
+    {
+    const std::vector< PixelType > & values = m_BlockValues[block];
+    if ( values.empty() )
+      {
+      continue;
+      }
+
+    IndexType     first;
+    SizeValueType extent[SetDimension];
+    for ( unsigned int j = 0; j < SetDimension; j++ )
+      {
+      const SizeValueType position = m_Scheduler.GetBlockPosition(block, j) * m_BlockSize;
+      first[j] = start[j] + static_cast< IndexValueType >( position );
+      extent[j] = std::min( static_cast< SizeValueType >( m_BlockSize ), size[j] - position );
+      }
+
+    for ( SizeValueType localOffset = 0; localOffset < m_BlockVolume; localOffset++ )
+      {
+      if ( static_cast< double >( values[localOffset] ) > m_StoppingValue )
+        {
+        continue;
+        }
+      NodeType node;
+      IndexType index;
+      bool      isInside = true;
+      for ( unsigned int j = 0; j < SetDimension; j++ )
+        {
+        const SizeValueType local = ( localOffset / m_LocalStrides[j] ) % m_BlockSize;
+        isInside = isInside && local < extent[j];
+        index[j] = first[j] + static_cast< IndexValueType >( local );
+        }
+      if ( isInside )
+        {
+        node.SetIndex(index);
+        node.SetValue(values[localOffset]);
+        nodes.push_back(node);
+        }
+      }
+    }
+
+  std::stable_sort( nodes.begin(), nodes.end() );
+  m_ProcessedPoints->Reserve( nodes.size() );
+  for ( size_t i = 0; i < nodes.size(); i++ )
+    {
+    m_ProcessedPoints->SetElement(i, nodes[i]);
+    }
+}
+
+template< typename TLevelSet >
+typename LevelSetNarrowBandDistanceSolver< TLevelSet >::PixelType
+LevelSetNarrowBandDistanceSolver< TLevelSet >
+::GetNeighborValue(SizeValueType block, SizeValueType localOffset,
+                   const IndexValueType position[], const SizeValueType local[],
+                   unsigned int axis, bool upper) const
+{
+  const SizeValueType lastLocal = m_BlockSize - 1;
+  if ( upper )
+    {
+    if ( position[axis] + 1 >= static_cast< IndexValueType >( m_OutputRegion.GetSize(axis) ) )
+      {
+      return m_LargeValue;
+      }
+    if ( local[axis] < lastLocal )
+      {
+      return m_BlockValues[block][localOffset + m_LocalStrides[axis]];
+      }
+    const std::vector< PixelType > & neighbor = m_BlockValues[block + m_Scheduler.GetBlockStride(axis)];
+    return neighbor.empty() ? m_LargeValue : neighbor[localOffset - lastLocal * m_LocalStrides[axis]];
+    }
+
+  if ( position[axis] == 0 )
+    {
+    return m_LargeValue;
+    }
+  if ( local[axis] > 0 )
+    {
+    return m_BlockValues[block][localOffset - m_LocalStrides[axis]];
+    }
+  const std::vector< PixelType > & neighbor = m_BlockValues[block - m_Scheduler.GetBlockStride(axis)];
+  return neighbor.empty() ? m_LargeValue : neighbor[localOffset + lastLocal * m_LocalStrides[axis]];
+}
+
+template< typename TLevelSet >
+unsigned int
+LevelSetNarrowBandDistanceSolver< TLevelSet >
+::UpdateBlock(SizeValueType block)
+{
+  std::vector< PixelType > &           values = m_BlockValues[block];
+  const std::vector< unsigned char > & trialPoints = m_BlockTrialPoints[block];
+
+  IndexValueType first[SetDimension];
+  SizeValueType  last[SetDimension];
+  for ( unsigned int j = 0; j < SetDimension; j++ )
+    {
+    const SizeValueType position = m_Scheduler.GetBlockPosition(block, j) * m_BlockSize;
+    first[j] = static_cast< IndexValueType >( position );
+    last[j] = std::min( static_cast< SizeValueType >( m_BlockSize ), m_OutputRegion.GetSize(j) - position ) - 1;
+    }
+
+  double spaceFactors[SetDimension];
+  for ( unsigned int j = 0; j < SetDimension; j++ )
+    {
+    spaceFactors[j] = itk::Math::sqr( 1.0 / m_OutputSpacing[j] );
+    }
+
+  unsigned int changedFaces = 0;
+  unsigned int sweep = 0;
+  bool         changed = true;
+  while ( changed )
+    {
+    changed = false;
+
+    // each sweep goes through the block in one of the 2^SetDimension
+    // directions
+    SizeValueType local[SetDimension];
+    for ( unsigned int j = 0; j < SetDimension; j++ )
+      {
+      local[j] = ( ( sweep >> j ) & 1 ) ? last[j] : 0;
+      }
+
+    unsigned int axis = 0;
+    while ( axis < SetDimension )
+      {
+      SizeValueType  localOffset = 0;
+      IndexValueType position[SetDimension];
+      for ( unsigned int j = 0; j < SetDimension; j++ )
+        {
+        localOffset += local[j] * m_LocalStrides[j];
+        position[j] = first[j] + static_cast< IndexValueType >( local[j] );
+        }
+
+      if ( !trialPoints[localOffset] )
+        {
+        // the smallest neighbor along each axis, sorted by value
+        double       neighborValues[SetDimension];
+        unsigned int neighborAxes[SetDimension];
+        bool         isReached = false;
+        for ( unsigned int j = 0; j < SetDimension; j++ )
+          {
+          const double value = static_cast< double >(
+            std::min( this->GetNeighborValue(block, localOffset, position, local, j, false),
+                      this->GetNeighborValue(block, localOffset, position, local, j, true) ) );
+          isReached = isReached || value < static_cast< double >( m_LargeValue );
+
+          unsigned int k = j;
+          while ( k > 0 && neighborValues[k - 1] > value )
+            {
+            neighborValues[k] = neighborValues[k - 1];
+            neighborAxes[k] = neighborAxes[k - 1];
+            --k;
+            }
+          neighborValues[k] = value;
+          neighborAxes[k] = j;
+          }
+
+        if ( isReached )
+          {
+          // solve the quadratic equation as FastMarchingImageFilter does
+          // with a unit speed
+          double solution = static_cast< double >( m_LargeValue );
+          double aa = 0.0;
+          double bb = 0.0;
+          double cc = -1.0;
+          for ( unsigned int j = 0; j < SetDimension; j++ )
+            {
+            const double value = neighborValues[j];
+            if ( solution < value )
+              {
+              break;
+              }
+            const double spaceFactor = spaceFactors[neighborAxes[j]];
+            aa += spaceFactor;
+            bb += value * spaceFactor;
+            cc += itk::Math::sqr(value) * spaceFactor;
+
+            const double discrim = itk::Math::sqr(bb) - aa * cc;
+            if ( discrim < 0.0 )
+              {
+              break;
+              }
+            solution = ( std::sqrt(discrim) + bb ) / aa;
+            }
+
+          const PixelType newValue = static_cast< PixelType >( solution );
+          if ( solution < static_cast< double >( m_LargeValue ) && newValue < values[localOffset] )
+            {
+            values[localOffset] = newValue;
+            changed = true;
+            if ( static_cast< double >( newValue ) <= m_StoppingValue )
+              {
+              for ( unsigned int j = 0; j < SetDimension; j++ )
+                {
+                if ( local[j] == 0 )
+                  {
+                  changedFaces |= 1u << ( 2 * j );
+                  }
+                if ( local[j] == m_BlockSize - 1 )
+                  {
+                  changedFaces |= 1u << ( 2 * j + 1 );
+                  }
+                }
+              }
+            }
+          }
+        }
+
+      // next pixel in the direction of the sweep
+      for ( axis = 0; axis < SetDimension; axis++ )
+        {
+        if ( ( sweep >> axis ) & 1 )
+          {
+          if ( local[axis] > 0 )
+            {
+            --local[axis];
+            break;
+            }
+          local[axis] = last[axis];
+          }
+        else
+          {
+          if ( local[axis] < last[axis] )
+            {
+            ++local[axis];
+            break;
+            }
+          local[axis] = 0;
+          }
+        }
+      }
+    ++sweep;
+    }
+
+  return changedFaces;
+}
+} // namespace itk
+
+#endif
@@ -20,6 +20,7 @@
 
 #include "itkLevelSetNeighborhoodExtractor.h"
 #include "itkFastMarchingImageFilter.h"
+#include "itkLevelSetNarrowBandDistanceSolver.h"
 
 namespace itk
 {
@@ -42,11 +43,15 @@ namespace itk
  * the algorithm will only locate the level set within the input narrowband.
  * For the output, the reinitialize level set is only valid for a distance
  * of OutputNarrowBandwidth / 2 of either side of the level set of interest.
+ * With UseNarrowBandDistanceSolver on, the distances of the narrowband are
+ * computed in parallel over the blocks reached by the narrowband.
  *
  * Implementation of this class is based on Chapter 11 of
  * "Level Set Methods and Fast Marching Methods", J.A. Sethian,
  * Cambridge Press, Second edition, 1999.
  *
+ * \sa LevelSetNarrowBandDistanceSolver
+ *
  * \ingroup LevelSetSegmentation
  *
  * \ingroup ITKLevelSets
@@ -121,6 +126,14 @@ public:
   NodeContainerPointer GetOutputNarrowBand() const
   { return m_OutputNarrowBand; }
 
+  /** Set/Get whether the distances of the narrowband are computed by a
+   * LevelSetNarrowBandDistanceSolver with the threads of this filter,
+   * instead of the fast marching.  The distances are equal up to the
+   * rounding errors.  By default, the fast marching is used. */
+  itkSetMacro(UseNarrowBandDistanceSolver, bool);
+  itkGetConstMacro(UseNarrowBandDistanceSolver, bool);
+  itkBooleanMacro(UseNarrowBandDistanceSolver);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro( LevelSetDoubleAdditiveOperatorsCheck,
@@ -139,6 +152,7 @@ protected:
   typedef Image< float, itkGetStaticConstMacro(SetDimension) > SpeedImageType;
   typedef LevelSetNeighborhoodExtractor< TLevelSet >           LocatorType;
   typedef FastMarchingImageFilter< TLevelSet, SpeedImageType > FastMarchingImageFilterType;
+  typedef LevelSetNarrowBandDistanceSolver< TLevelSet >        DistanceSolverType;
 
   void GenerateData() ITK_OVERRIDE;
 
@@ -164,11 +178,14 @@ private:
 
   typename FastMarchingImageFilterType::Pointer m_Marcher;
 
+  typename DistanceSolverType::Pointer m_DistanceSolver;
+
   bool                 m_NarrowBanding;
   double               m_InputNarrowBandwidth;
   double               m_OutputNarrowBandwidth;
   NodeContainerPointer m_InputNarrowBand;
   NodeContainerPointer m_OutputNarrowBand;
+  bool                 m_UseNarrowBandDistanceSolver;
 };
 } // namespace itk
 
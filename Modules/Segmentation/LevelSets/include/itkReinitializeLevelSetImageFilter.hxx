@@ -35,12 +35,14 @@ ReinitializeLevelSetImageFilter< TLevelSet >
 
   m_Locator = LocatorType::New();
   m_Marcher = FastMarchingImageFilterType::New();
+  m_DistanceSolver = DistanceSolverType::New();
 
   m_NarrowBanding = false;
   m_InputNarrowBandwidth = 12.0;
   m_OutputNarrowBandwidth = 12.0;
   m_InputNarrowBand = ITK_NULLPTR;
   m_OutputNarrowBand = ITK_NULLPTR;
+  m_UseNarrowBandDistanceSolver = false;
 }
 
 /*
@@ -78,6 +80,8 @@ ReinitializeLevelSetImageFilter< TLevelSet >
   os << std::endl;
   os << indent << "Output narrow band: " << m_OutputNarrowBand.GetPointer();
   os << std::endl;
+  os << indent << "Use narrow band distance solver: " << m_UseNarrowBandDistanceSolver;
+  os << std::endl;
 }
 
 /*
@@ -251,7 +255,6 @@ ReinitializeLevelSetImageFilter< TLevelSet >
 {
   LevelSetConstPointer inputPtr = this->GetInput();
   LevelSetPointer      outputPtr = this->GetOutput();
-  LevelSetPointer      tempLevelSet = m_Marcher->GetOutput();
 
   // define iterators
   typedef ImageRegionIterator< LevelSetImageType >      IteratorType;
@@ -315,12 +318,25 @@ ReinitializeLevelSetImageFilter< TLevelSet >
 
   // march outward
   double stoppingValue = ( m_OutputNarrowBandwidth / 2.0 ) + 2.0;
-  m_Marcher->SetStoppingValue(stoppingValue);
-  m_Marcher->CollectPointsOn();
-  m_Marcher->SetTrialPoints( m_Locator->GetOutsidePoints() );
-  m_Marcher->Update();
-
-  NodeContainerPointer procPoints = m_Marcher->GetProcessedPoints();
+  NodeContainerPointer procPoints;
+  if ( m_UseNarrowBandDistanceSolver )
+    {
+    m_DistanceSolver->SetOutputRegion( outputPtr->GetRequestedRegion() );
+    m_DistanceSolver->SetOutputSpacing( inputPtr->GetSpacing() );
+    m_DistanceSolver->SetStoppingValue(stoppingValue);
+    m_DistanceSolver->SetNumberOfThreads( this->GetNumberOfThreads() );
+    m_DistanceSolver->SetTrialPoints( m_Locator->GetOutsidePoints() );
+    m_DistanceSolver->Solve();
+    procPoints = m_DistanceSolver->GetProcessedPoints();
+    }
+  else
+    {
+    m_Marcher->SetStoppingValue(stoppingValue);
+    m_Marcher->CollectPointsOn();
+    m_Marcher->SetTrialPoints( m_Locator->GetOutsidePoints() );
+    m_Marcher->Update();
+    procPoints = m_Marcher->GetProcessedPoints();
+    }
 
   typename NodeContainer::ConstIterator pointsIt;
   typename NodeContainer::ConstIterator pointsEnd;
@@ -331,6 +347,7 @@ ReinitializeLevelSetImageFilter< TLevelSet >
   NodeType  node;
   PixelType inPixel;
 
+  // the value of a processed point is its distance
   for (; pointsIt != pointsEnd; ++pointsIt )
     {
     node = pointsIt.Value();
@@ -339,8 +356,7 @@ ReinitializeLevelSetImageFilter< TLevelSet >
     value = (double)inPixel;
     if ( value - m_LevelSetValue > 0 )
       {
-      inPixel = tempLevelSet->GetPixel( node.GetIndex() );
-      outputPtr->SetPixel(node.GetIndex(), inPixel);
+      outputPtr->SetPixel( node.GetIndex(), node.GetValue() );
       m_OutputNarrowBand->InsertElement(m_OutputNarrowBand->Size(), node);
       }
     } // end for loop
@@ -348,10 +364,19 @@ ReinitializeLevelSetImageFilter< TLevelSet >
   this->UpdateProgress(0.66);
 
   // march inward
-  m_Marcher->SetTrialPoints( m_Locator->GetInsidePoints() );
-  m_Marcher->Update();
+  if ( m_UseNarrowBandDistanceSolver )
+    {
+    m_DistanceSolver->SetTrialPoints( m_Locator->GetInsidePoints() );
+    m_DistanceSolver->Solve();
+    procPoints = m_DistanceSolver->GetProcessedPoints();
+    }
+  else
+    {
+    m_Marcher->SetTrialPoints( m_Locator->GetInsidePoints() );
+    m_Marcher->Update();
+    procPoints = m_Marcher->GetProcessedPoints();
+    }
 
-  procPoints = m_Marcher->GetProcessedPoints();
   pointsIt = procPoints->Begin();
   pointsEnd = procPoints->End();
 
@@ -363,8 +388,7 @@ ReinitializeLevelSetImageFilter< TLevelSet >
     value = (double)inPixel;
     if ( value - m_LevelSetValue <= 0 )
       {
-      inPixel = tempLevelSet->GetPixel( node.GetIndex() );
-      value = (double)inPixel;
+      value = (double)node.GetValue();
       inPixel =  -1.0 * value;
       outputPtr->SetPixel(node.GetIndex(), inPixel);
       node.SetValue(node.GetValue() * -1.0);
@@ -136,6 +136,9 @@ public:
   virtual void ReleaseGlobalDataPointer(void *GlobalData) const ITK_OVERRIDE
   { delete (ShapePriorGlobalDataStruct *)GlobalData; }
 
+  /** Merges the largest changes, including the shape prior one. */
+  virtual void MergeGlobalData(void *GlobalData, const void *OtherGlobalData) const ITK_OVERRIDE;
+
 protected:
   ShapePriorSegmentationLevelSetFunction();
   virtual ~ShapePriorSegmentationLevelSetFunction() {}
@@ -142,6 +142,19 @@ ShapePriorSegmentationLevelSetFunction< TImageType, TFeatureImageType >
 
   return dt;
 }
+
+template< typename TImageType, typename TFeatureImageType >
+void
+ShapePriorSegmentationLevelSetFunction< TImageType, TFeatureImageType >
+::MergeGlobalData(void *gd, const void *otherGd) const
+{
+  this->Superclass::MergeGlobalData(gd, otherGd);
+
+  ShapePriorGlobalDataStruct *      d = (ShapePriorGlobalDataStruct *)gd;
+  const ShapePriorGlobalDataStruct *o = (const ShapePriorGlobalDataStruct *)otherGd;
+
+  d->m_MaxShapePriorChange = std::max(d->m_MaxShapePriorChange, o->m_MaxShapePriorChange);
+}
 } // end namespace itk
 
 #endif
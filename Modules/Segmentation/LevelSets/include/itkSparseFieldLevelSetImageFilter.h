@@ -19,9 +19,11 @@
 #define itkSparseFieldLevelSetImageFilter_h
 
 #include "itkFiniteDifferenceImageFilter.h"
+#include "itkLevelSetFunction.h"
 #include "itkMultiThreader.h"
 #include "itkSparseFieldLayer.h"
 #include "itkObjectStore.h"
+#include "itkAtomicInt.h"
 #include <vector>
 #include "itkNeighborhoodIterator.h"
 
@@ -165,6 +167,16 @@ private:
  *  layers according to their neighbors.  At the very outer layers, add or
  *  remove indices which have come into or moved out of the sparse field.
  *
+ * \par THREADING
+ *  With UseParallelCalculateChange, step 1 is done by several threads on
+ *  chunks of the active layer, and the result is the same as with a single
+ *  thread.  Steps 2 and 3 (ApplyUpdate) are always done by a single
+ *  thread, in the order of the active layer list: an index which moves up
+ *  keeps its neighbors from moving down in the same iteration, so that
+ *  splitting the layers in tiles updated at the same time would change the
+ *  result.  For a solver which also updates the layers with several threads,
+ *  see ParallelSparseFieldLevelSetImageFilter.
+ *
  * \par HOW TO USE THIS CLASS
  *  Typically, this class should be subclassed with additional functionality
  *  for specific applications.  It is possible, however to use this solver as a
@@ -312,6 +324,27 @@ public:
   void InterpolateSurfaceLocationOff()
   { this->SetInterpolateSurfaceLocation(false); }
 
+  /** Set/Get whether the changes of the active layer are calculated by
+   * several threads.  The active layer is split into chunks of
+   * ActiveLayerChunkSize nodes, which the threads take one after the other.
+   * The largest advection, propagation and curvature terms found by the
+   * threads are merged into a single global data before the time step is
+   * computed, so that the result is the same as with a single thread.  This
+   * requires a difference function derived from LevelSetFunction; the
+   * changes of any other function are calculated by a single thread.  Only
+   * CalculateChange is threaded:
+   * ApplyUpdate, which moves the indices between the layers and propagates
+   * their values, stays serial (see THREADING in the class documentation).
+   * Turned off by default. */
+  itkSetMacro(UseParallelCalculateChange, bool);
+  itkGetConstMacro(UseParallelCalculateChange, bool);
+  itkBooleanMacro(UseParallelCalculateChange);
+
+  /** Set/Get the number of active layer nodes in the chunks taken by the
+   * threads.  Defaults to 1024. */
+  itkSetClampMacro( ActiveLayerChunkSize, SizeValueType, 1, NumericTraits< SizeValueType >::max() );
+  itkGetConstMacro(ActiveLayerChunkSize, SizeValueType);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro( OutputEqualityComparableCheck,
@@ -370,6 +403,12 @@ protected:
    *  indices to be applied in the current iteration. */
   TimeStepType CalculateChange() ITK_OVERRIDE;
 
+  /** Calculates the change at the active layer node of a neighborhood
+   * iterator.  minNorm is added to the squared norm of the gradient when
+   * the location of the surface is interpolated. */
+  ValueType CalculateChangeAtNode(NeighborhoodIterator< OutputImageType > & outputIt,
+                                  void *globalData, ValueType minNorm) const;
+
   /** Initializes a layer of the sparse field using a previously initialized
    * layer. Builds the list of nodes in m_Layer[to] using m_Layer[from].
    * Marks values in the m_StatusImage. */
@@ -500,6 +539,23 @@ private:
   /** This flag is true when methods need to check boundary conditions and
       false when methods do not need to check for boundary conditions. */
   bool m_BoundsCheckingActive;
+
+  /** Calculates the changes of the chunks of the active layer taken by a
+   * thread. */
+  static ITK_THREAD_RETURN_TYPE CalculateChangeThreaderCallback(void *arg);
+
+  void ThreadedCalculateChangeOnChunks(ThreadIdType threadId);
+
+  bool          m_UseParallelCalculateChange;
+  SizeValueType m_ActiveLayerChunkSize;
+
+  /** The active layer nodes in the order of the update buffer, the global
+   * data of each thread and the next chunk to be taken by a thread. */
+  std::vector< const LayerNodeType * > m_ActiveLayerNodes;
+  std::vector< void * >                m_ThreadGlobalData;
+  SizeValueType                        m_NumberOfChunks;
+  AtomicInt< SizeValueType >           m_NextChunk;
+  ValueType                            m_MinNorm;
 };
 } // end namespace itk
 
@@ -136,7 +136,11 @@ SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
   m_InterpolateSurfaceLocation(true),
   m_InputImage(ITK_NULLPTR),
   m_OutputImage(ITK_NULLPTR),
-  m_BoundsCheckingActive(false)
+  m_BoundsCheckingActive(false),
+  m_UseParallelCalculateChange(false),
+  m_ActiveLayerChunkSize(1024),
+  m_NumberOfChunks(0),
+  m_MinNorm(m_ValueZero)
 {
   m_LayerNodeStore = LayerNodeStorageType::New();
   m_LayerNodeStore->SetGrowthStrategyToExponential();
@@ -904,9 +908,6 @@ SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
 {
   const typename Superclass::FiniteDifferenceFunctionType::Pointer df =
     this->GetDifferenceFunction();
-  typename Superclass::FiniteDifferenceFunctionType::FloatOffsetType offset;
-  ValueType norm_grad_phi_squared, dx_forward, dx_backward, forwardValue,
-            backwardValue, centerValue;
   unsigned  i;
   ValueType MIN_NORM      = 1.0e-6;
   if ( this->GetUseImageSpacing() )
@@ -919,12 +920,67 @@ SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
     MIN_NORM *= minSpacing;
     }
 
+  TimeStepType timeStep;
+
+  // The global data of the threads can only be merged by a level set
+  // function.
+  typedef LevelSetFunction< OutputImageType > LevelSetFunctionType;
+  const LevelSetFunctionType *lsf =
+    dynamic_cast< const LevelSetFunctionType * >( df.GetPointer() );
+
+  if ( m_UseParallelCalculateChange && lsf && !m_Layers[0]->Empty() )
+    {
+    // Index the active layer nodes, so that the threads can take the chunks
+    // of the layer and store their updates in the update buffer.
+    typename LayerType::ConstIterator layerIt;
+    m_ActiveLayerNodes.clear();
+    m_ActiveLayerNodes.reserve( m_Layers[0]->Size() );
+    for ( layerIt = m_Layers[0]->Begin(); layerIt != m_Layers[0]->End(); ++layerIt )
+      {
+      m_ActiveLayerNodes.push_back( layerIt.GetPointer() );
+      }
+
+    const SizeValueType numberOfNodes = m_ActiveLayerNodes.size();
+    m_NumberOfChunks =
+      ( numberOfNodes + m_ActiveLayerChunkSize - 1 ) / m_ActiveLayerChunkSize;
+
+    const ThreadIdType numberOfThreads =
+      std::min( this->GetNumberOfThreads(), static_cast< ThreadIdType >( m_NumberOfChunks ) );
+
+    m_UpdateBuffer.resize(numberOfNodes);
+    m_ThreadGlobalData.resize(numberOfThreads);
+    for ( ThreadIdType t = 0; t < numberOfThreads; ++t )
+      {
+      m_ThreadGlobalData[t] = df->GetGlobalDataPointer();
+      }
+    m_MinNorm = MIN_NORM;
+    m_NextChunk = 0;
+
+    MultiThreader *threader = this->GetMultiThreader();
+    threader->SetNumberOfThreads(numberOfThreads);
+    threader->SetSingleMethod(this->CalculateChangeThreaderCallback, this);
+    threader->SingleMethodExecute();
+
+    // The time step is computed once, from the largest terms found by all
+    // the threads, as it is by the serial loop below.
+    for ( ThreadIdType t = 1; t < numberOfThreads; ++t )
+      {
+      lsf->MergeGlobalData(m_ThreadGlobalData[0], m_ThreadGlobalData[t]);
+      df->ReleaseGlobalDataPointer(m_ThreadGlobalData[t]);
+      }
+    timeStep = df->ComputeGlobalTimeStep(m_ThreadGlobalData[0]);
+    df->ReleaseGlobalDataPointer(m_ThreadGlobalData[0]);
+
+    m_ThreadGlobalData.clear();
+    m_ActiveLayerNodes.clear();
+    return timeStep;
+    }
+
   void *globalData = df->GetGlobalDataPointer();
 
   typename LayerType::ConstIterator layerIt;
   NeighborhoodIterator< OutputImageType > outputIt( df->GetRadius(),
                                                     this->m_OutputImage, this->m_OutputImage->GetRequestedRegion() );
-  TimeStepType timeStep;
 
   if ( m_BoundsCheckingActive == false )
     {
@@ -941,74 +997,140 @@ SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
   for ( layerIt = m_Layers[0]->Begin(); layerIt != m_Layers[0]->End(); ++layerIt )
     {
     outputIt.SetLocation(layerIt->m_Value);
+    m_UpdateBuffer.push_back( this->CalculateChangeAtNode(outputIt, globalData, MIN_NORM) );
+    }
 
-    // Calculate the offset to the surface from the center of this
-    // neighborhood.  This is used by some level set functions in sampling a
-    // speed, advection, or curvature term.
-    if ( this->GetInterpolateSurfaceLocation()
-         && ( centerValue = outputIt.GetCenterPixel() ) != 0.0 )
+  // Ask the finite difference function to compute the time step for
+  // this iteration.  We give it the global data pointer to use, then
+  // ask it to free the global data memory.
+  timeStep = df->ComputeGlobalTimeStep(globalData);
+
+  df->ReleaseGlobalDataPointer(globalData);
+
+  return timeStep;
+}
+
+template< typename TInputImage, typename TOutputImage >
+typename SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >::ValueType
+SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
+::CalculateChangeAtNode(NeighborhoodIterator< OutputImageType > & outputIt,
+                        void *globalData, ValueType minNorm) const
+{
+  const typename Superclass::FiniteDifferenceFunctionType::Pointer df =
+    this->GetDifferenceFunction();
+  typename Superclass::FiniteDifferenceFunctionType::FloatOffsetType offset;
+  ValueType norm_grad_phi_squared, dx_forward, dx_backward, forwardValue,
+            backwardValue, centerValue;
+  unsigned  i;
+
+  // Calculate the offset to the surface from the center of this
+  // neighborhood.  This is used by some level set functions in sampling a
+  // speed, advection, or curvature term.
+  if ( this->GetInterpolateSurfaceLocation()
+       && ( centerValue = outputIt.GetCenterPixel() ) != 0.0 )
+    {
+    // Surface is at the zero crossing, so distance to surface is:
+    // phi(x) / norm(grad(phi)), where phi(x) is the center of the
+    // neighborhood.  The location is therefore
+    // (i,j,k) - ( phi(x) * grad(phi(x)) ) / norm(grad(phi))^2
+    norm_grad_phi_squared = 0.0;
+    for ( i = 0; i < ImageDimension; ++i )
       {
-      // Surface is at the zero crossing, so distance to surface is:
-      // phi(x) / norm(grad(phi)), where phi(x) is the center of the
-      // neighborhood.  The location is therefore
-      // (i,j,k) - ( phi(x) * grad(phi(x)) ) / norm(grad(phi))^2
-      norm_grad_phi_squared = 0.0;
-      for ( i = 0; i < ImageDimension; ++i )
-        {
-        forwardValue  = outputIt.GetNext(i);
-        backwardValue = outputIt.GetPrevious(i);
+      forwardValue  = outputIt.GetNext(i);
+      backwardValue = outputIt.GetPrevious(i);
 
-        if ( forwardValue * backwardValue >= 0 )
-          { //  Neighbors are same sign OR at least one neighbor is zero.
-          dx_forward  = forwardValue - centerValue;
-          dx_backward = centerValue - backwardValue;
+      if ( forwardValue * backwardValue >= 0 )
+        { //  Neighbors are same sign OR at least one neighbor is zero.
+        dx_forward  = forwardValue - centerValue;
+        dx_backward = centerValue - backwardValue;
 
-          // Pick the larger magnitude derivative.
-          if ( ::itk::Math::abs(dx_forward) > ::itk::Math::abs(dx_backward) )
-            {
-            offset[i] = dx_forward;
-            }
-          else
-            {
-            offset[i] = dx_backward;
-            }
+        // Pick the larger magnitude derivative.
+        if ( ::itk::Math::abs(dx_forward) > ::itk::Math::abs(dx_backward) )
+          {
+          offset[i] = dx_forward;
           }
-        else //Neighbors are opposite sign, pick the direction of the 0 surface.
+        else
           {
-          if ( forwardValue * centerValue < 0 )
-            {
-            offset[i] = forwardValue - centerValue;
-            }
-          else
-            {
-            offset[i] = centerValue - backwardValue;
-            }
+          offset[i] = dx_backward;
           }
-
-        norm_grad_phi_squared += offset[i] * offset[i];
         }
-
-      for ( i = 0; i < ImageDimension; ++i )
+      else //Neighbors are opposite sign, pick the direction of the 0 surface.
         {
-        offset[i] = ( offset[i] * centerValue ) / ( norm_grad_phi_squared + MIN_NORM );
+        if ( forwardValue * centerValue < 0 )
+          {
+          offset[i] = forwardValue - centerValue;
+          }
+        else
+          {
+          offset[i] = centerValue - backwardValue;
+          }
         }
 
-      m_UpdateBuffer.push_back( df->ComputeUpdate(outputIt, globalData, offset) );
+      norm_grad_phi_squared += offset[i] * offset[i];
       }
-    else // Don't do interpolation
+
+    for ( i = 0; i < ImageDimension; ++i )
       {
-      m_UpdateBuffer.push_back( df->ComputeUpdate(outputIt, globalData) );
+      offset[i] = ( offset[i] * centerValue ) / ( norm_grad_phi_squared + minNorm );
       }
+
+    return df->ComputeUpdate(outputIt, globalData, offset);
+    }
+  else // Don't do interpolation
+    {
+    return df->ComputeUpdate(outputIt, globalData);
     }
+}
 
-  // Ask the finite difference function to compute the time step for
-  // this iteration.  We give it the global data pointer to use, then
-  // ask it to free the global data memory.
-  timeStep = df->ComputeGlobalTimeStep(globalData);
+template< typename TInputImage, typename TOutputImage >
+ITK_THREAD_RETURN_TYPE
+SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
+::CalculateChangeThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info =
+    static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  Self *filter = static_cast< Self * >( info->UserData );
 
-  df->ReleaseGlobalDataPointer(globalData);
+  filter->ThreadedCalculateChangeOnChunks(info->ThreadID);
 
-  return timeStep;
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< typename TInputImage, typename TOutputImage >
+void
+SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
+::ThreadedCalculateChangeOnChunks(ThreadIdType threadId)
+{
+  const typename Superclass::FiniteDifferenceFunctionType::Pointer df =
+    this->GetDifferenceFunction();
+
+  NeighborhoodIterator< OutputImageType > outputIt( df->GetRadius(),
+                                                    this->m_OutputImage, this->m_OutputImage->GetRequestedRegion() );
+
+  if ( m_BoundsCheckingActive == false )
+    {
+    outputIt.NeedToUseBoundaryConditionOff();
+    }
+
+  void *globalData = m_ThreadGlobalData[threadId];
+
+  const SizeValueType numberOfNodes = m_ActiveLayerNodes.size();
+  while ( true )
+    {
+    const SizeValueType chunk = ( m_NextChunk++ );
+    if ( chunk >= m_NumberOfChunks )
+      {
+      break;
+      }
+
+    const SizeValueType first = chunk * m_ActiveLayerChunkSize;
+    const SizeValueType last = std::min(first + m_ActiveLayerChunkSize, numberOfNodes);
+    for ( SizeValueType n = first; n < last; ++n )
+      {
+      outputIt.SetLocation(m_ActiveLayerNodes[n]->m_Value);
+      m_UpdateBuffer[n] = this->CalculateChangeAtNode(outputIt, globalData, m_MinNorm);
+      }
+    }
 }
 
 template< typename TInputImage, typename TOutputImage >
@@ -1196,7 +1318,9 @@ SparseFieldLevelSetImageFilter< TInputImage, TOutputImage >
   unsigned int i;
   os << indent << "m_IsoSurfaceValue: " << m_IsoSurfaceValue << std::endl;
   itkPrintSelfObjectMacro( LayerNodeStore );
-  os << indent << "m_BoundsCheckingActive: " << m_BoundsCheckingActive;
+  os << indent << "m_BoundsCheckingActive: " << m_BoundsCheckingActive << std::endl;
+  os << indent << "m_UseParallelCalculateChange: " << m_UseParallelCalculateChange << std::endl;
+  os << indent << "m_ActiveLayerChunkSize: " << m_ActiveLayerChunkSize << std::endl;
   for ( i = 0; i < m_Layers.size(); i++ )
     {
     os << indent << "m_Layers[" << i << "]: size="
@@ -0,0 +1,185 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkGeodesicActiveContourLevelSetImageFilter.h"
+#include "itkGradientMagnitudeRecursiveGaussianImageFilter.h"
+#include "itkSigmoidImageFilter.h"
+#include "itkFastMarchingImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+const unsigned int ImageDimension = 2;
+
+typedef float                                           InternalPixelType;
+typedef itk::Image< InternalPixelType, ImageDimension > InternalImageType;
+
+typedef itk::GeodesicActiveContourLevelSetImageFilter< InternalImageType, InternalImageType >
+  GeodesicActiveContourFilterType;
+
+InternalImageType::Pointer
+Segment( const InternalImageType * initialLevelSet, const InternalImageType * featureImage,
+         bool parallel, itk::ThreadIdType numberOfThreads, unsigned int & elapsedIterations )
+{
+  GeodesicActiveContourFilterType::Pointer geodesicActiveContour = GeodesicActiveContourFilterType::New();
+  geodesicActiveContour->SetInput( initialLevelSet );
+  geodesicActiveContour->SetFeatureImage( featureImage );
+  geodesicActiveContour->SetPropagationScaling( 1.0 );
+  geodesicActiveContour->SetCurvatureScaling( 0.1 );
+  geodesicActiveContour->SetAdvectionScaling( 0.5 );
+  geodesicActiveContour->SetMaximumRMSError( 0.01 );
+  geodesicActiveContour->SetNumberOfIterations( 150 );
+  geodesicActiveContour->SetUseParallelCalculateChange( parallel );
+  geodesicActiveContour->SetActiveLayerChunkSize( 37 );
+  geodesicActiveContour->SetNumberOfThreads( numberOfThreads );
+  geodesicActiveContour->Update();
+
+  elapsedIterations = geodesicActiveContour->GetElapsedIterations();
+
+  InternalImageType::Pointer output = geodesicActiveContour->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+
+// Number of pixels of the square inside the contour, and outside it.
+void
+CountPixels( const InternalImageType * levelSet, const InternalImageType::RegionType & squareRegion,
+             itk::SizeValueType & truePositives, itk::SizeValueType & falsePositives )
+{
+  truePositives = 0;
+  falsePositives = 0;
+  itk::ImageRegionConstIteratorWithIndex< InternalImageType > it( levelSet, levelSet->GetLargestPossibleRegion() );
+  for( ; !it.IsAtEnd(); ++it )
+    {
+    if( it.Get() <= 0.0f )
+      {
+      if( squareRegion.IsInside( it.GetIndex() ) )
+        {
+        ++truePositives;
+        }
+      else
+        {
+        ++falsePositives;
+        }
+      }
+    }
+}
+}
+
+// Segment a square with the changes of the active layer calculated by
+// several threads, and check that the result is the same as the serial one.
+int itkGeodesicActiveContourLevelSetImageFilterParallelTest( int, char * [] )
+{
+  InternalImageType::SizeType imageSize;
+  imageSize.Fill( 96 );
+
+  InternalImageType::Pointer inputImage = InternalImageType::New();
+  inputImage->SetRegions( imageSize );
+  inputImage->Allocate();
+  inputImage->FillBuffer( 0.0f );
+
+  InternalImageType::IndexType squareStart;
+  squareStart.Fill( 20 );
+  InternalImageType::SizeType squareSize;
+  squareSize.Fill( 50 );
+  InternalImageType::RegionType squareRegion( squareStart, squareSize );
+  itk::ImageRegionIterator< InternalImageType > it( inputImage, squareRegion );
+  for( ; !it.IsAtEnd(); ++it )
+    {
+    it.Set( 190.0f );
+    }
+
+  // edge potential map
+  typedef itk::GradientMagnitudeRecursiveGaussianImageFilter< InternalImageType, InternalImageType >
+    GradientImageType;
+  GradientImageType::Pointer gradMagnitude = GradientImageType::New();
+  gradMagnitude->SetInput( inputImage );
+  gradMagnitude->SetSigma( 1.0 );
+
+  typedef itk::SigmoidImageFilter< InternalImageType, InternalImageType > SigmoidFilterType;
+  SigmoidFilterType::Pointer sigmoid = SigmoidFilterType::New();
+  sigmoid->SetOutputMinimum( 0.0 );
+  sigmoid->SetOutputMaximum( 1.0 );
+  sigmoid->SetAlpha( -0.4 );
+  sigmoid->SetBeta( 2.5 );
+  sigmoid->SetInput( gradMagnitude->GetOutput() );
+  sigmoid->Update();
+
+  // initial level set: a disk inside the square
+  typedef itk::FastMarchingImageFilter< InternalImageType > FastMarchingFilterType;
+  FastMarchingFilterType::Pointer fastMarching = FastMarchingFilterType::New();
+  FastMarchingFilterType::NodeContainer::Pointer seeds = FastMarchingFilterType::NodeContainer::New();
+  FastMarchingFilterType::NodeType node;
+  InternalImageType::IndexType seedPosition;
+  seedPosition.Fill( 40 );
+  node.SetValue( -15.5 );
+  node.SetIndex( seedPosition );
+  seeds->InsertElement( 0, node );
+  fastMarching->SetTrialPoints( seeds );
+  fastMarching->SetSpeedConstant( 1.0 );
+  fastMarching->SetOutputSize( imageSize );
+  fastMarching->Update();
+
+  GeodesicActiveContourFilterType::Pointer filter = GeodesicActiveContourFilterType::New();
+  TEST_SET_GET_BOOLEAN( filter, UseParallelCalculateChange, false );
+  TEST_SET_GET_VALUE( 1024, filter->GetActiveLayerChunkSize() );
+
+  const itk::SizeValueType squareVolume = 50 * 50;
+  itk::SizeValueType       truePositives;
+  itk::SizeValueType       falsePositives;
+  unsigned int             elapsedIterations;
+
+  unsigned int serialIterations;
+  InternalImageType::Pointer serial =
+    Segment( fastMarching->GetOutput(), sigmoid->GetOutput(), false, 1, serialIterations );
+  CountPixels( serial, squareRegion, truePositives, falsePositives );
+  std::cout << "Serial: " << serialIterations << " iterations, " << truePositives << " pixels of "
+            << squareVolume << " inside, " << falsePositives << " outside" << std::endl;
+
+  // the contour stops at the edges of the square
+  TEST_EXPECT_TRUE( truePositives > 0.95 * squareVolume );
+  TEST_EXPECT_TRUE( falsePositives < 0.05 * squareVolume );
+
+  // The threads calculate the same changes and the same time step as the
+  // serial loop, so the level sets must be identical.
+  const itk::ThreadIdType numberOfThreads[] = { 1, 2, 5 };
+  for( unsigned int t = 0; t < 3; ++t )
+    {
+    InternalImageType::Pointer parallel =
+      Segment( fastMarching->GetOutput(), sigmoid->GetOutput(), true, numberOfThreads[t], elapsedIterations );
+    std::cout << numberOfThreads[t] << " threads: " << elapsedIterations << " iterations" << std::endl;
+
+    TEST_EXPECT_EQUAL( serialIterations, elapsedIterations );
+
+    itk::ImageRegionConstIterator< InternalImageType > sIt( serial, serial->GetLargestPossibleRegion() );
+    itk::ImageRegionConstIterator< InternalImageType > pIt( parallel, parallel->GetLargestPossibleRegion() );
+    for( ; !sIt.IsAtEnd(); ++sIt, ++pIt )
+      {
+      if( sIt.Get() != pIt.Get() )
+        {
+        std::cerr << "The level set of " << numberOfThreads[t] << " threads differs from the serial one at "
+                  << sIt.GetIndex() << ": " << sIt.Get() << " and " << pIt.Get() << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
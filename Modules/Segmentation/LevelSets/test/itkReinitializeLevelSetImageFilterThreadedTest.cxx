@@ -0,0 +1,190 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkReinitializeLevelSetImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+// The level set of two overlapping spheres, scaled so that it is not a
+// distance.
+template< typename TImage >
+typename TImage::Pointer
+CreateLevelSet( const typename TImage::SizeType & size, const typename TImage::SpacingType & spacing )
+{
+  typename TImage::Pointer image = TImage::New();
+  image->SetRegions( size );
+  image->SetSpacing( spacing );
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex< TImage > it( image, image->GetLargestPossibleRegion() );
+  for( ; !it.IsAtEnd(); ++it )
+    {
+    typename TImage::PointType point;
+    image->TransformIndexToPhysicalPoint( it.GetIndex(), point );
+    double distance1 = 0.0;
+    double distance2 = 0.0;
+    for( unsigned int j = 0; j < TImage::ImageDimension; ++j )
+      {
+      distance1 += itk::Math::sqr( point[j] - 0.35 * size[j] * spacing[j] );
+      distance2 += itk::Math::sqr( point[j] - 0.6 * size[j] * spacing[j] );
+      }
+    const double distance = std::min( std::sqrt( distance1 ) - 9.0, std::sqrt( distance2 ) - 6.5 );
+    it.Set( static_cast< typename TImage::PixelType >( 2.5 * distance ) );
+    }
+  return image;
+}
+
+template< typename TImage >
+typename TImage::Pointer
+Reinitialize( const TImage * input, bool useSolver, itk::ThreadIdType numberOfThreads,
+              itk::SizeValueType & bandSize )
+{
+  typedef itk::ReinitializeLevelSetImageFilter< TImage > FilterType;
+
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( input );
+  filter->NarrowBandingOn();
+  filter->SetOutputNarrowBandwidth( 10.0 );
+  filter->SetUseNarrowBandDistanceSolver( useSolver );
+  filter->SetNumberOfThreads( numberOfThreads );
+  filter->Update();
+
+  bandSize = filter->GetOutputNarrowBand()->Size();
+
+  typename TImage::Pointer output = filter->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+
+template< typename TImage >
+bool
+CheckSolver( const typename TImage::SizeType & size, const typename TImage::SpacingType & spacing )
+{
+  typedef typename TImage::PixelType PixelType;
+
+  typename TImage::Pointer input = CreateLevelSet< TImage >( size, spacing );
+
+  itk::SizeValueType       marcherBandSize = 0;
+  typename TImage::Pointer marched = Reinitialize< TImage >( input, false, 1, marcherBandSize );
+
+  itk::SizeValueType       bandSize1 = 0;
+  typename TImage::Pointer solved1 = Reinitialize< TImage >( input, true, 1, bandSize1 );
+  itk::SizeValueType       bandSize4 = 0;
+  typename TImage::Pointer solved4 = Reinitialize< TImage >( input, true, 4, bandSize4 );
+
+  std::cout << "Dimension " << TImage::ImageDimension << ": " << marcherBandSize
+            << " pixels in the band of the fast marching, " << bandSize1
+            << " in the band of the solver" << std::endl;
+  if( bandSize1 != bandSize4 )
+    {
+    std::cerr << "The size of the band depends on the number of threads: "
+              << bandSize1 << " and " << bandSize4 << std::endl;
+    return false;
+    }
+
+  const double stoppingValue = 10.0 / 2.0 + 2.0;
+  const double outside = itk::NumericTraits< PixelType >::max();
+  itk::SizeValueType numberOfDifferentPixels = 0;
+
+  itk::ImageRegionConstIterator< TImage > mIt( marched, marched->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< TImage > it1( solved1, solved1->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< TImage > it4( solved4, solved4->GetLargestPossibleRegion() );
+  for( ; !mIt.IsAtEnd(); ++mIt, ++it1, ++it4 )
+    {
+    if( it1.Get() != it4.Get() )
+      {
+      std::cerr << "The distance depends on the number of threads at " << it1.GetIndex()
+                << ": " << it1.Get() << " and " << it4.Get() << std::endl;
+      return false;
+      }
+
+    const double marchedValue = mIt.Get();
+    const double solvedValue = it1.Get();
+    const bool   marchedInBand = std::fabs( marchedValue ) < outside;
+    const bool   solvedInBand = std::fabs( solvedValue ) < outside;
+    if( marchedInBand && solvedInBand )
+      {
+      if( std::fabs( marchedValue - solvedValue ) > 1e-4 )
+        {
+        std::cerr << "The distances differ at " << mIt.GetIndex() << ": "
+                  << marchedValue << " and " << solvedValue << std::endl;
+        return false;
+        }
+      }
+    else if( marchedInBand != solvedInBand )
+      {
+      // only the rounding errors at the edge of the band may differ
+      const double inBandValue = marchedInBand ? marchedValue : solvedValue;
+      if( std::fabs( std::fabs( inBandValue ) - stoppingValue ) > 1e-4 )
+        {
+        std::cerr << "The bands differ at " << mIt.GetIndex() << ": "
+                  << marchedValue << " and " << solvedValue << std::endl;
+        return false;
+        }
+      ++numberOfDifferentPixels;
+      }
+    else if( marchedValue != solvedValue )
+      {
+      std::cerr << "The signs differ at " << mIt.GetIndex() << std::endl;
+      return false;
+      }
+    }
+
+  return marcherBandSize + numberOfDifferentPixels >= bandSize1
+    && bandSize1 + numberOfDifferentPixels >= marcherBandSize;
+}
+}
+
+// Compare the narrowband reinitialization with the distance solver to the
+// one with the fast marching, in 2D and 3D, with several numbers of threads.
+int itkReinitializeLevelSetImageFilterThreadedTest( int, char * [] )
+{
+  typedef itk::Image< float, 2 >  ImageType2D;
+  typedef itk::Image< double, 3 > ImageType3D;
+
+  typedef itk::ReinitializeLevelSetImageFilter< ImageType2D > FilterType;
+  FilterType::Pointer filter = FilterType::New();
+  TEST_SET_GET_BOOLEAN( filter, UseNarrowBandDistanceSolver, true );
+
+  typedef itk::LevelSetNarrowBandDistanceSolver< ImageType2D > SolverType;
+  SolverType::Pointer solver = SolverType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( solver, LevelSetNarrowBandDistanceSolver, LightProcessObject );
+  TEST_SET_GET_VALUE( 8, solver->GetBlockSize() );
+
+  ImageType2D::SizeType size2D;
+  size2D[0] = 70;
+  size2D[1] = 61;
+  ImageType2D::SpacingType spacing2D;
+  spacing2D.Fill( 1.0 );
+  TEST_EXPECT_TRUE( CheckSolver< ImageType2D >( size2D, spacing2D ) );
+
+  ImageType3D::SizeType size3D;
+  size3D[0] = 37;
+  size3D[1] = 33;
+  size3D[2] = 26;
+  ImageType3D::SpacingType spacing3D;
+  spacing3D[0] = 1.0;
+  spacing3D[1] = 0.8;
+  spacing3D[2] = 1.5;
+  TEST_EXPECT_TRUE( CheckSolver< ImageType3D >( size3D, spacing3D ) );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -231,6 +231,16 @@ public:
   /** Set the maximum number of threads to be used. */
   ThreadIdType GetNumberOfThreads() const;
 
+  /** Set/Get whether the level sets of the container are updated
+   * concurrently, each update filter running in its own thread. Each level
+   * set is then updated from the state of the other ones at the previous
+   * iteration, instead of the state left by the level sets updated before
+   * it, so that the result does not depend on the number of threads.
+   * Defaults to false. */
+  itkSetMacro( UpdateLevelSetsConcurrently, bool );
+  itkGetConstMacro( UpdateLevelSetsConcurrently, bool );
+  itkBooleanMacro( UpdateLevelSetsConcurrently );
+
 protected:
   LevelSetEvolution();
   ~LevelSetEvolution();
@@ -261,6 +271,14 @@ protected:
   typedef LevelSetEvolutionComputeIterationThreader< LevelSetType, SplitLevelSetPartitionerType, Self > SplitLevelSetComputeIterationThreaderType;
   typename SplitLevelSetComputeIterationThreaderType::Pointer m_SplitLevelSetComputeIterationThreader;
 
+  bool m_UpdateLevelSetsConcurrently;
+
+  std::vector< UpdateLevelSetFilterPointer > m_UpdateLevelSetFilters;
+
+  friend class LevelSetEvolutionUpdateLevelSetsThreader< LevelSetType, ThreadedIndexedContainerPartitioner, Self >;
+  typedef LevelSetEvolutionUpdateLevelSetsThreader< LevelSetType, ThreadedIndexedContainerPartitioner, Self > SplitLevelSetsUpdateLevelSetsThreaderType;
+  typename SplitLevelSetsUpdateLevelSetsThreaderType::Pointer m_SplitLevelSetsUpdateLevelSetsThreader;
+
 private:
   LevelSetEvolution( const Self& );
   void operator = ( const Self& );
@@ -332,6 +350,17 @@ public:
   typedef UpdateShiSparseLevelSet< ImageDimension, EquationContainerType >  UpdateLevelSetFilterType;
   typedef typename UpdateLevelSetFilterType::Pointer                        UpdateLevelSetFilterPointer;
 
+  /** Set the maximum number of threads to be used. */
+  void SetNumberOfThreads( const ThreadIdType threads );
+  /** Set the maximum number of threads to be used. */
+  ThreadIdType GetNumberOfThreads() const;
+
+  /** Set/Get whether the level sets of the container are updated
+   * concurrently. Defaults to false. */
+  itkSetMacro( UpdateLevelSetsConcurrently, bool );
+  itkGetConstMacro( UpdateLevelSetsConcurrently, bool );
+  itkBooleanMacro( UpdateLevelSetsConcurrently );
+
 protected:
   LevelSetEvolution();
   ~LevelSetEvolution();
@@ -342,6 +371,14 @@ protected:
   /** Update the equations at the end of 1 iteration */
   virtual void UpdateEquations() ITK_OVERRIDE;
 
+  bool m_UpdateLevelSetsConcurrently;
+
+  std::vector< UpdateLevelSetFilterPointer > m_UpdateLevelSetFilters;
+
+  friend class LevelSetEvolutionUpdateLevelSetsThreader< LevelSetType, ThreadedIndexedContainerPartitioner, Self >;
+  typedef LevelSetEvolutionUpdateLevelSetsThreader< LevelSetType, ThreadedIndexedContainerPartitioner, Self > SplitLevelSetsUpdateLevelSetsThreaderType;
+  typename SplitLevelSetsUpdateLevelSetsThreaderType::Pointer m_SplitLevelSetsUpdateLevelSetsThreader;
+
 private:
   LevelSetEvolution( const Self& );
   void operator = ( const Self& );
@@ -412,6 +449,17 @@ public:
   typedef UpdateMalcolmSparseLevelSet< ImageDimension, EquationContainerType > UpdateLevelSetFilterType;
   typedef typename UpdateLevelSetFilterType::Pointer UpdateLevelSetFilterPointer;
 
+  /** Set the maximum number of threads to be used. */
+  void SetNumberOfThreads( const ThreadIdType threads );
+  /** Set the maximum number of threads to be used. */
+  ThreadIdType GetNumberOfThreads() const;
+
+  /** Set/Get whether the level sets of the container are updated
+   * concurrently. Defaults to false. */
+  itkSetMacro( UpdateLevelSetsConcurrently, bool );
+  itkGetConstMacro( UpdateLevelSetsConcurrently, bool );
+  itkBooleanMacro( UpdateLevelSetsConcurrently );
+
 protected:
   LevelSetEvolution();
   virtual ~LevelSetEvolution();
@@ -420,6 +468,14 @@ protected:
 
   virtual void UpdateEquations() ITK_OVERRIDE;
 
+  bool m_UpdateLevelSetsConcurrently;
+
+  std::vector< UpdateLevelSetFilterPointer > m_UpdateLevelSetFilters;
+
+  friend class LevelSetEvolutionUpdateLevelSetsThreader< LevelSetType, ThreadedIndexedContainerPartitioner, Self >;
+  typedef LevelSetEvolutionUpdateLevelSetsThreader< LevelSetType, ThreadedIndexedContainerPartitioner, Self > SplitLevelSetsUpdateLevelSetsThreaderType;
+  typename SplitLevelSetsUpdateLevelSetsThreaderType::Pointer m_SplitLevelSetsUpdateLevelSetsThreader;
+
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(LevelSetEvolution);
 };
@@ -217,9 +217,11 @@ LevelSetEvolution< TEquationContainer, LevelSetDenseImage< TImage > >
 // Whitaker --------------------------------------------------------------------
 template< typename TEquationContainer, typename TOutput, unsigned int VDimension >
 LevelSetEvolution< TEquationContainer, WhitakerSparseLevelSetImage< TOutput, VDimension > >
-::LevelSetEvolution()
+::LevelSetEvolution() :
+  m_UpdateLevelSetsConcurrently( false )
 {
   this->m_SplitLevelSetComputeIterationThreader = SplitLevelSetComputeIterationThreaderType::New();
+  this->m_SplitLevelSetsUpdateLevelSetsThreader = SplitLevelSetsUpdateLevelSetsThreaderType::New();
 }
 
 template< typename TEquationContainer, typename TOutput, unsigned int VDimension >
@@ -240,6 +242,7 @@ LevelSetEvolution< TEquationContainer, WhitakerSparseLevelSetImage< TOutput, VDi
 ::SetNumberOfThreads( const ThreadIdType numberOfThreads)
 {
   this->m_SplitLevelSetComputeIterationThreader->SetMaximumNumberOfThreads( numberOfThreads );
+  this->m_SplitLevelSetsUpdateLevelSetsThreader->SetMaximumNumberOfThreads( numberOfThreads );
 }
 
 template< typename TEquationContainer, typename TOutput, unsigned int VDimension >
@@ -342,23 +345,44 @@ LevelSetEvolution< TEquationContainer, WhitakerSparseLevelSetImage< TOutput, VDi
   typename LevelSetContainerType::Iterator it = this->m_LevelSetContainer->Begin();
   while( it != this->m_LevelSetContainer->End() )
     {
-    typename LevelSetType::Pointer levelSet = it->GetLevelSet();
-
     UpdateLevelSetFilterPointer updateLevelSet = UpdateLevelSetFilterType::New();
-    updateLevelSet->SetInputLevelSet( levelSet );
+    updateLevelSet->SetInputLevelSet( it->GetLevelSet() );
     updateLevelSet->SetUpdate( * this->m_UpdateBuffer[it->GetIdentifier()] );
     updateLevelSet->SetEquationContainer( this->m_EquationContainer );
     updateLevelSet->SetTimeStep( this->m_Dt );
     updateLevelSet->SetCurrentLevelSetId( it->GetIdentifier() );
-    updateLevelSet->Update();
+    this->m_UpdateLevelSetFilters.push_back( updateLevelSet );
+    ++it;
+    }
 
-    levelSet->Graft( updateLevelSet->GetOutputLevelSet() );
+  const bool concurrently = this->m_UpdateLevelSetsConcurrently && ( this->m_UpdateLevelSetFilters.size() > 1 );
+  if( concurrently )
+    {
+    typename SplitLevelSetsUpdateLevelSetsThreaderType::DomainType levelSetRange;
+    levelSetRange[0] = 0;
+    levelSetRange[1] = this->m_UpdateLevelSetFilters.size() - 1;
+    this->m_SplitLevelSetsUpdateLevelSetsThreader->Execute( this, levelSetRange );
+    }
+
+  it = this->m_LevelSetContainer->Begin();
+  typename std::vector< UpdateLevelSetFilterPointer >::iterator filterIt = this->m_UpdateLevelSetFilters.begin();
+  while( it != this->m_LevelSetContainer->End() )
+    {
+    UpdateLevelSetFilterType * updateLevelSet = *filterIt;
+    if( !concurrently )
+      {
+      updateLevelSet->Update();
+      }
+
+    it->GetLevelSet()->Graft( updateLevelSet->GetOutputLevelSet() );
 
     this->m_RMSChangeAccumulator = updateLevelSet->GetRMSChangeAccumulator();
 
     this->m_UpdateBuffer[it->GetIdentifier()]->clear();
     ++it;
+    ++filterIt;
     }
+  this->m_UpdateLevelSetFilters.clear();
 }
 
 template< typename TEquationContainer, typename TOutput, unsigned int VDimension >
@@ -372,8 +396,10 @@ LevelSetEvolution< TEquationContainer, WhitakerSparseLevelSetImage< TOutput, VDi
 // Shi
 template< typename TEquationContainer, unsigned int VDimension >
 LevelSetEvolution< TEquationContainer, ShiSparseLevelSetImage< VDimension > >
-::LevelSetEvolution()
+::LevelSetEvolution() :
+  m_UpdateLevelSetsConcurrently( false )
 {
+  this->m_SplitLevelSetsUpdateLevelSetsThreader = SplitLevelSetsUpdateLevelSetsThreaderType::New();
 }
 
 template< typename TEquationContainer, unsigned int VDimension >
@@ -381,28 +407,69 @@ LevelSetEvolution< TEquationContainer, ShiSparseLevelSetImage< VDimension > >
 ::~LevelSetEvolution()
 {}
 
+template< typename TEquationContainer, unsigned int VDimension >
+void
+LevelSetEvolution< TEquationContainer, ShiSparseLevelSetImage< VDimension > >
+::SetNumberOfThreads( const ThreadIdType numberOfThreads )
+{
+  this->m_SplitLevelSetsUpdateLevelSetsThreader->SetMaximumNumberOfThreads( numberOfThreads );
+}
+
+template< typename TEquationContainer, unsigned int VDimension >
+ThreadIdType
+LevelSetEvolution< TEquationContainer, ShiSparseLevelSetImage< VDimension > >
+::GetNumberOfThreads() const
+{
+  return this->m_SplitLevelSetsUpdateLevelSetsThreader->GetMaximumNumberOfThreads();
+}
+
 template< typename TEquationContainer, unsigned int VDimension >
 void LevelSetEvolution< TEquationContainer, ShiSparseLevelSetImage< VDimension > >
 ::UpdateLevelSets()
 {
-  typename LevelSetContainerType::Iterator it = this->m_LevelSetContainer->Begin();
+  // when the level sets are updated concurrently, each filter runs in a
+  // single thread
+  const bool concurrently = this->m_UpdateLevelSetsConcurrently && ( this->m_LevelSetContainer->Size() > 1 );
+  const ThreadIdType numberOfThreads = concurrently ? 1 : this->GetNumberOfThreads();
 
+  typename LevelSetContainerType::Iterator it = this->m_LevelSetContainer->Begin();
   while( it != this->m_LevelSetContainer->End() )
     {
-    typename LevelSetType::Pointer levelSet = it->GetLevelSet();
-
     UpdateLevelSetFilterPointer updateLevelSet = UpdateLevelSetFilterType::New();
-    updateLevelSet->SetInputLevelSet( levelSet );
+    updateLevelSet->SetInputLevelSet( it->GetLevelSet() );
     updateLevelSet->SetCurrentLevelSetId( it->GetIdentifier() );
     updateLevelSet->SetEquationContainer( this->m_EquationContainer );
-    updateLevelSet->Update();
+    updateLevelSet->SetNumberOfThreads( numberOfThreads );
+    this->m_UpdateLevelSetFilters.push_back( updateLevelSet );
+    ++it;
+    }
 
-    levelSet->Graft( updateLevelSet->GetOutputLevelSet() );
+  if( concurrently )
+    {
+    typename SplitLevelSetsUpdateLevelSetsThreaderType::DomainType levelSetRange;
+    levelSetRange[0] = 0;
+    levelSetRange[1] = this->m_UpdateLevelSetFilters.size() - 1;
+    this->m_SplitLevelSetsUpdateLevelSetsThreader->Execute( this, levelSetRange );
+    }
+
+  it = this->m_LevelSetContainer->Begin();
+  typename std::vector< UpdateLevelSetFilterPointer >::iterator filterIt = this->m_UpdateLevelSetFilters.begin();
+  while( it != this->m_LevelSetContainer->End() )
+    {
+    UpdateLevelSetFilterType * updateLevelSet = *filterIt;
+    if( !concurrently )
+      {
+      updateLevelSet->Update();
+      }
+
+    it->GetLevelSet()->Graft( updateLevelSet->GetOutputLevelSet() );
 
     this->m_RMSChangeAccumulator = updateLevelSet->GetRMSChangeAccumulator();
 
     ++it;
+    ++filterIt;
     }
+  this->m_UpdateLevelSetFilters.clear();
 }
 
 template< typename TEquationContainer, unsigned int VDimension >
@@ -415,8 +482,10 @@ void LevelSetEvolution< TEquationContainer, ShiSparseLevelSetImage< VDimension >
 // Malcolm
 template< typename TEquationContainer, unsigned int VDimension >
 LevelSetEvolution< TEquationContainer, MalcolmSparseLevelSetImage< VDimension > >
-::LevelSetEvolution()
+::LevelSetEvolution() :
+  m_UpdateLevelSetsConcurrently( false )
 {
+  this->m_SplitLevelSetsUpdateLevelSetsThreader = SplitLevelSetsUpdateLevelSetsThreaderType::New();
 }
 
 template< typename TEquationContainer, unsigned int VDimension >
@@ -424,29 +493,69 @@ LevelSetEvolution< TEquationContainer, MalcolmSparseLevelSetImage< VDimension >
 ::~LevelSetEvolution()
 {}
 
+template< typename TEquationContainer, unsigned int VDimension >
+void
+LevelSetEvolution< TEquationContainer, MalcolmSparseLevelSetImage< VDimension > >
+::SetNumberOfThreads( const ThreadIdType numberOfThreads )
+{
+  this->m_SplitLevelSetsUpdateLevelSetsThreader->SetMaximumNumberOfThreads( numberOfThreads );
+}
+
+template< typename TEquationContainer, unsigned int VDimension >
+ThreadIdType
+LevelSetEvolution< TEquationContainer, MalcolmSparseLevelSetImage< VDimension > >
+::GetNumberOfThreads() const
+{
+  return this->m_SplitLevelSetsUpdateLevelSetsThreader->GetMaximumNumberOfThreads();
+}
+
 template< typename TEquationContainer, unsigned int VDimension >
 void LevelSetEvolution< TEquationContainer, MalcolmSparseLevelSetImage< VDimension > >
 ::UpdateLevelSets()
 {
-  typename LevelSetContainerType::Iterator it = this->m_LevelSetContainer->Begin();
+  // when the level sets are updated concurrently, each filter runs in a
+  // single thread
+  const bool concurrently = this->m_UpdateLevelSetsConcurrently && ( this->m_LevelSetContainer->Size() > 1 );
+  const ThreadIdType numberOfThreads = concurrently ? 1 : this->GetNumberOfThreads();
 
+  typename LevelSetContainerType::Iterator it = this->m_LevelSetContainer->Begin();
   while( it != this->m_LevelSetContainer->End() )
     {
-    typename LevelSetType::Pointer levelSet = it->GetLevelSet();
-    LevelSetIdentifierType       levelSetId = it->GetIdentifier();
-
     UpdateLevelSetFilterPointer updateLevelSet = UpdateLevelSetFilterType::New();
-    updateLevelSet->SetInputLevelSet( levelSet );
-    updateLevelSet->SetCurrentLevelSetId( levelSetId );
+    updateLevelSet->SetInputLevelSet( it->GetLevelSet() );
+    updateLevelSet->SetCurrentLevelSetId( it->GetIdentifier() );
     updateLevelSet->SetEquationContainer( this->m_EquationContainer );
-    updateLevelSet->Update();
+    updateLevelSet->SetNumberOfThreads( numberOfThreads );
+    this->m_UpdateLevelSetFilters.push_back( updateLevelSet );
+    ++it;
+    }
+
+  if( concurrently )
+    {
+    typename SplitLevelSetsUpdateLevelSetsThreaderType::DomainType levelSetRange;
+    levelSetRange[0] = 0;
+    levelSetRange[1] = this->m_UpdateLevelSetFilters.size() - 1;
+    this->m_SplitLevelSetsUpdateLevelSetsThreader->Execute( this, levelSetRange );
+    }
+
+  it = this->m_LevelSetContainer->Begin();
+  typename std::vector< UpdateLevelSetFilterPointer >::iterator filterIt = this->m_UpdateLevelSetFilters.begin();
+  while( it != this->m_LevelSetContainer->End() )
+    {
+    UpdateLevelSetFilterType * updateLevelSet = *filterIt;
+    if( !concurrently )
+      {
+      updateLevelSet->Update();
+      }
 
-    levelSet->Graft( updateLevelSet->GetOutputLevelSet() );
+    it->GetLevelSet()->Graft( updateLevelSet->GetOutputLevelSet() );
 
     this->m_RMSChangeAccumulator = updateLevelSet->GetRMSChangeAccumulator();
 
     ++it;
+    ++filterIt;
     }
+  this->m_UpdateLevelSetFilters.clear();
 }
 
 template< typename TEquationContainer, unsigned int VDimension >
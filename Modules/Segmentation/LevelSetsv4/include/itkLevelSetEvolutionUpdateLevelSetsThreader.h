@@ -22,6 +22,7 @@
 #include "itkDomainThreader.h"
 #include "itkLevelSetDenseImage.h"
 #include "itkThreadedImageRegionPartitioner.h"
+#include "itkThreadedIndexedContainerPartitioner.h"
 
 namespace itk
 {
@@ -84,6 +85,38 @@ private:
   ITK_DISALLOW_COPY_AND_ASSIGN(LevelSetEvolutionUpdateLevelSetsThreader);
 };
 
+// For sparse level sets: each thread runs the update filters of a range of
+// the level sets of the container.
+template< typename TLevelSet, typename TLevelSetEvolution >
+class ITK_TEMPLATE_EXPORT LevelSetEvolutionUpdateLevelSetsThreader< TLevelSet, ThreadedIndexedContainerPartitioner, TLevelSetEvolution >
+  : public DomainThreader< ThreadedIndexedContainerPartitioner, TLevelSetEvolution >
+{
+public:
+  /** Standard class typedefs. */
+  typedef LevelSetEvolutionUpdateLevelSetsThreader                                  Self;
+  typedef DomainThreader< ThreadedIndexedContainerPartitioner, TLevelSetEvolution > Superclass;
+  typedef SmartPointer< Self >                                                      Pointer;
+  typedef SmartPointer< const Self >                                                ConstPointer;
+
+  /** Run time type information. */
+  itkTypeMacro( LevelSetEvolutionUpdateLevelSetsThreader, DomainThreader );
+
+  /** Standard New macro. */
+  itkNewMacro( Self );
+
+  /** Superclass types. */
+  typedef typename Superclass::DomainType    DomainType;
+  typedef typename Superclass::AssociateType AssociateType;
+
+protected:
+  LevelSetEvolutionUpdateLevelSetsThreader();
+
+  virtual void ThreadedExecution( const DomainType & levelSetRange, const ThreadIdType threadId ) ITK_OVERRIDE;
+
+private:
+  ITK_DISALLOW_COPY_AND_ASSIGN(LevelSetEvolutionUpdateLevelSetsThreader);
+};
+
 } // end namespace itk
 
 #ifndef ITK_MANUAL_INSTANTIATION
@@ -89,6 +89,26 @@ LevelSetEvolutionUpdateLevelSetsThreader< LevelSetDenseImage< TImage >, Threaded
     }
 }
 
+template< typename TLevelSet, typename TLevelSetEvolution >
+LevelSetEvolutionUpdateLevelSetsThreader< TLevelSet, ThreadedIndexedContainerPartitioner, TLevelSetEvolution >
+::LevelSetEvolutionUpdateLevelSetsThreader()
+{
+}
+
+template< typename TLevelSet, typename TLevelSetEvolution >
+void
+LevelSetEvolutionUpdateLevelSetsThreader< TLevelSet, ThreadedIndexedContainerPartitioner, TLevelSetEvolution >
+::ThreadedExecution( const DomainType & levelSetRange,
+                     const ThreadIdType itkNotUsed(threadId) )
+{
+  // The filters only read the level sets of the container, which are grafted
+  // once all of them are updated.
+  for( IndexValueType ii = levelSetRange[0]; ii <= levelSetRange[1]; ++ii )
+    {
+    this->m_Associate->m_UpdateLevelSetFilters[ii]->Update();
+    }
+}
+
 } // end namespace itk
 
 #endif
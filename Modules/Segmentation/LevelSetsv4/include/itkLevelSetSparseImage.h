@@ -20,10 +20,12 @@
 #define itkLevelSetSparseImage_h
 
 #include "itkDiscreteLevelSetImage.h"
+#include "itkLevelSetSparseLayer.h"
 #include "itkObjectFactory.h"
 
 #include "itkLabelObject.h"
 #include "itkLabelMap.h"
+#include "itkImage.h"
 
 namespace itk
 {
@@ -70,8 +72,13 @@ public:
   typedef typename LabelMapType::Pointer      LabelMapPointer;
   typedef typename LabelMapType::RegionType   RegionType;
 
-  typedef std::map< InputType, OutputType,
-                    Functor::IndexLexicographicCompare< VDimension > >
+  typedef Image< LayerIdType, VDimension >    LabelImageType;
+  typedef typename LabelImageType::Pointer    LabelImagePointer;
+
+  /** The nodes of a layer, sorted in the lexicographic order of their
+   * indices. */
+  typedef LevelSetSparseLayer< InputType, OutputType,
+                               Functor::IndexLexicographicCompare< VDimension > >
                                                   LayerType;
   typedef typename LayerType::iterator            LayerIterator;
   typedef typename LayerType::const_iterator      LayerConstIterator;
@@ -89,13 +96,20 @@ public:
   /** Return the pointer to a layer map with given id  */
   LayerType& GetLayer( LayerIdType value );
 
-  /** Set a layer map with id to the given layer pointer */
+  /** Set a layer map with id to a copy of the given layer, without its
+   * erased nodes */
   void SetLayer( LayerIdType value, const LayerType& layer );
 
   /** Set/Get the label map for computing the sparse representation */
   virtual void SetLabelMap( LabelMapType* labelMap );
   itkGetModifiableObjectMacro(LabelMap, LabelMapType );
 
+  /** Set/Get an image of the labels of the label map, used instead of the
+   * label map to find the layer of a location. It must hold the same labels
+   * as the label map: it is removed when a new label map is set. */
+  virtual void SetLabelImage( LabelImageType* labelImage );
+  itkGetModifiableObjectMacro(LabelImage, LabelImageType );
+
   /** Graft data object as level set object */
   virtual void Graft( const DataObject* data ) ITK_OVERRIDE;
 
@@ -109,8 +123,14 @@ protected:
 
   LayerMapType      m_Layers;
   LabelMapPointer   m_LabelMap;
+  LabelImagePointer m_LabelImage;
   LayerIdListType   m_InternalLabelList;
 
+  /** Get the value at a location of the label map from the layer given by
+   * the label image, with a single lookup. Returns false when there is no
+   * label image. */
+  bool EvaluateWithLabelImage( const InputType& mapIndex, OutputType& value ) const;
+
   /** Initialize the sparse field layers */
   virtual void InitializeLayers() = 0;
 
@@ -42,10 +42,44 @@ LevelSetSparseImage< TOutput, VDimension >
 ::Status( const InputType& inputIndex ) const
 {
   InputType mapIndex = inputIndex - this->m_DomainOffset;
+  if( this->m_LabelImage.IsNotNull() )
+    {
+    return this->m_LabelImage->GetPixel( mapIndex );
+    }
   return this->m_LabelMap->GetPixel( mapIndex );
 }
 
 
+template< typename TOutput, unsigned int VDimension >
+bool
+LevelSetSparseImage< TOutput, VDimension >
+::EvaluateWithLabelImage( const InputType& mapIndex, OutputType& value ) const
+{
+  if( this->m_LabelImage.IsNull() )
+    {
+    return false;
+    }
+
+  const LayerIdType status = this->m_LabelImage->GetPixel( mapIndex );
+
+  LayerMapConstIterator layerIt = this->m_Layers.find( status );
+  if( layerIt == this->m_Layers.end() )
+    {
+    // out of the layers, the value is the label
+    value = static_cast< OutputType >( status );
+    return true;
+    }
+
+  LayerConstIterator it = ( layerIt->second ).find( mapIndex );
+  if( it == ( layerIt->second ).end() )
+    {
+    return false;
+    }
+  value = it->second;
+  return true;
+}
+
+
 template< typename TOutput, unsigned int VDimension >
 void
 LevelSetSparseImage< TOutput, VDimension >
@@ -62,10 +96,24 @@ LevelSetSparseImage< TOutput, VDimension >
     this->m_NeighborhoodScales[dim] =
         NumericTraits< OutputRealType >::OneValue() / static_cast< OutputRealType >( spacing[dim] );
     }
+  this->m_LabelImage = ITK_NULLPTR;
   this->Modified();
 }
 
 
+template< typename TOutput, unsigned int VDimension >
+void
+LevelSetSparseImage< TOutput, VDimension >
+::SetLabelImage( LabelImageType* labelImage )
+{
+  if( this->m_LabelImage != labelImage )
+    {
+    this->m_LabelImage = labelImage;
+    this->Modified();
+    }
+}
+
+
 template< typename TOutput, unsigned int VDimension >
 bool
 LevelSetSparseImage< TOutput, VDimension >
@@ -96,6 +144,7 @@ LevelSetSparseImage< TOutput, VDimension >
     }
 
   this->m_LabelMap->Graft( levelSet->m_LabelMap );
+  this->m_LabelImage = levelSet->m_LabelImage;
   if( &m_Layers != &(levelSet->m_Layers) )
     {
     m_Layers.clear();
@@ -139,7 +188,10 @@ LevelSetSparseImage< TOutput, VDimension >
   const LayerMapIterator it = m_Layers.find( value );
   if( it != m_Layers.end() )
     {
+    // the update filters start from a copy of the layers: it is the time to
+    // drop the nodes they erased
     it->second = layer;
+    it->second.Squeeze();
     }
   else
     {
@@ -156,6 +208,7 @@ LevelSetSparseImage< TOutput, VDimension >
   Superclass::Initialize();
 
   this->m_LabelMap = ITK_NULLPTR;
+  this->m_LabelImage = ITK_NULLPTR;
   this->InitializeLayers();
   this->InitializeInternalLabelList();
 }
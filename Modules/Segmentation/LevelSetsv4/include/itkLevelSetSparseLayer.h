@@ -0,0 +1,445 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkLevelSetSparseLayer_h
+#define itkLevelSetSparseLayer_h
+
+#include "itkIntTypes.h"
+#include "itkMacro.h"
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace itk
+{
+/**
+ *  \class LevelSetSparseLayer
+ *  \brief Sorted container of the nodes of a layer of a sparse level set.
+ *
+ *  The nodes, pairs of an index and a value, are kept in the order given by
+ *  TCompare in consecutive blocks of at most 2 * BlockSize nodes, so that a
+ *  lookup is a binary search in contiguous memory and an insertion only
+ *  moves the nodes of one block.
+ *
+ *  The container has the interface of the std::map it replaces, with the
+ *  following differences:
+ *  - erase() only marks the node as erased, so that it does not invalidate
+ *    the other iterators; the erased nodes of a block are removed when a node
+ *    is inserted in the block, or by Squeeze();
+ *  - insert() and Squeeze() invalidate all the iterators of the container;
+ *  - the iterators are random access: the distance between two iterators and
+ *    the advance of an iterator visit the blocks, not the nodes, so that the
+ *    layer can be split in contiguous ranges for the threads.
+ *
+ *  \ingroup ITKLevelSetsv4
+ */
+template< typename TKey, typename TValue, typename TCompare = std::less< TKey > >
+class ITK_TEMPLATE_EXPORT LevelSetSparseLayer
+{
+public:
+  typedef LevelSetSparseLayer Self;
+
+  typedef TKey                        key_type;
+  typedef TValue                      mapped_type;
+  typedef std::pair< TKey, TValue >   value_type;
+  typedef TCompare                    key_compare;
+  typedef std::size_t                 size_type;
+  typedef std::ptrdiff_t              difference_type;
+
+  /** Maximum number of nodes of a block after Squeeze(). A block is split in
+   * two when it has more than twice this number of nodes. */
+  itkStaticConstMacro( BlockSize, unsigned int, 256 );
+
+private:
+  struct NodeType
+  {
+    value_type m_Pair;
+    bool       m_Erased;
+  };
+
+  struct BlockType
+  {
+    BlockType() : m_NumberOfErased( 0 ) {}
+
+    std::vector< NodeType > m_Nodes;
+    size_type               m_NumberOfErased;
+  };
+
+  typedef std::vector< BlockType > BlockContainerType;
+
+public:
+  /** \class ConstIterator
+   * \brief Random access iterator on the nodes of a LevelSetSparseLayer,
+   * which skips the erased nodes.
+   * \ingroup ITKLevelSetsv4
+   */
+  class ConstIterator
+  {
+  public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef std::pair< TKey, TValue >       value_type;
+    typedef std::ptrdiff_t                  difference_type;
+    typedef const value_type *              pointer;
+    typedef const value_type &              reference;
+
+    ConstIterator() : m_Blocks( ITK_NULLPTR ), m_Block( 0 ), m_Node( 0 ) {}
+
+    reference operator*() const
+    { return ( *m_Blocks )[m_Block].m_Nodes[m_Node].m_Pair; }
+
+    pointer operator->() const
+    { return &( ( *m_Blocks )[m_Block].m_Nodes[m_Node].m_Pair ); }
+
+    reference operator[]( difference_type n ) const
+    { return *( *this + n ); }
+
+    ConstIterator & operator++()
+    {
+      ++m_Node;
+      this->SkipErasedNodes();
+      return *this;
+    }
+
+    ConstIterator operator++( int )
+    {
+      ConstIterator it = *this;
+      ++( *this );
+      return it;
+    }
+
+    ConstIterator & operator--()
+    {
+      do
+        {
+        if( m_Node == 0 )
+          {
+          --m_Block;
+          m_Node = ( *m_Blocks )[m_Block].m_Nodes.size();
+          }
+        --m_Node;
+        }
+      while( ( *m_Blocks )[m_Block].m_Nodes[m_Node].m_Erased );
+      return *this;
+    }
+
+    ConstIterator operator--( int )
+    {
+      ConstIterator it = *this;
+      --( *this );
+      return it;
+    }
+
+    ConstIterator & operator+=( difference_type n )
+    {
+      this->SetRank( this->GetRank() + n );
+      return *this;
+    }
+
+    ConstIterator & operator-=( difference_type n )
+    {
+      this->SetRank( this->GetRank() - n );
+      return *this;
+    }
+
+    ConstIterator operator+( difference_type n ) const
+    {
+      ConstIterator it = *this;
+      it += n;
+      return it;
+    }
+
+    ConstIterator operator-( difference_type n ) const
+    {
+      ConstIterator it = *this;
+      it -= n;
+      return it;
+    }
+
+    difference_type operator-( const ConstIterator & it ) const
+    { return this->GetRank() - it.GetRank(); }
+
+    bool operator==( const ConstIterator & it ) const
+    { return m_Block == it.m_Block && m_Node == it.m_Node; }
+
+    bool operator!=( const ConstIterator & it ) const
+    { return !( *this == it ); }
+
+    bool operator<( const ConstIterator & it ) const
+    { return m_Block < it.m_Block || ( m_Block == it.m_Block && m_Node < it.m_Node ); }
+
+    bool operator>( const ConstIterator & it ) const
+    { return it < *this; }
+
+    bool operator<=( const ConstIterator & it ) const
+    { return !( it < *this ); }
+
+    bool operator>=( const ConstIterator & it ) const
+    { return !( *this < it ); }
+
+  protected:
+    friend class LevelSetSparseLayer;
+
+    ConstIterator( const BlockContainerType *blocks, size_type block, size_type node ) :
+      m_Blocks( blocks ), m_Block( block ), m_Node( node ) {}
+
+    /** Move to the first node, from the current one, which is not erased. */
+    void SkipErasedNodes()
+    {
+      while( m_Block < m_Blocks->size() )
+        {
+        const std::vector< NodeType > & nodes = ( *m_Blocks )[m_Block].m_Nodes;
+        while( m_Node < nodes.size() && nodes[m_Node].m_Erased )
+          {
+          ++m_Node;
+          }
+        if( m_Node < nodes.size() )
+          {
+          return;
+          }
+        ++m_Block;
+        m_Node = 0;
+        }
+    }
+
+    /** Number of nodes, not erased, before the current one. */
+    difference_type GetRank() const
+    {
+      difference_type rank = 0;
+      for( size_type b = 0; b < m_Block; ++b )
+        {
+        rank += ( *m_Blocks )[b].m_Nodes.size() - ( *m_Blocks )[b].m_NumberOfErased;
+        }
+      if( m_Block < m_Blocks->size() )
+        {
+        const BlockType & block = ( *m_Blocks )[m_Block];
+        if( block.m_NumberOfErased == 0 )
+          {
+          rank += m_Node;
+          }
+        else
+          {
+          for( size_type n = 0; n < m_Node; ++n )
+            {
+            rank += block.m_Nodes[n].m_Erased ? 0 : 1;
+            }
+          }
+        }
+      return rank;
+    }
+
+    /** Move to the node which has rank nodes, not erased, before it. */
+    void SetRank( difference_type rank )
+    {
+      for( m_Block = 0; m_Block < m_Blocks->size(); ++m_Block )
+        {
+        const BlockType &     block = ( *m_Blocks )[m_Block];
+        const difference_type size = block.m_Nodes.size() - block.m_NumberOfErased;
+        if( rank < size )
+          {
+          if( block.m_NumberOfErased == 0 )
+            {
+            m_Node = rank;
+            return;
+            }
+          m_Node = 0;
+          this->SkipErasedNodes();
+          for( ; rank > 0; --rank )
+            {
+            ++m_Node;
+            this->SkipErasedNodes();
+            }
+          return;
+          }
+        rank -= size;
+        }
+      m_Node = 0;
+    }
+
+    const BlockContainerType *m_Blocks;
+    size_type                 m_Block;
+    size_type                 m_Node;
+  };
+
+  /** \class Iterator
+   * \brief The non-const version of LevelSetSparseLayer::ConstIterator.
+   * \ingroup ITKLevelSetsv4
+   */
+  class Iterator : public ConstIterator
+  {
+  public:
+    typedef ConstIterator               Superclass;
+    typedef std::pair< TKey, TValue >   value_type;
+    typedef value_type *                pointer;
+    typedef value_type &                reference;
+
+    using Superclass::operator-;
+
+    Iterator() {}
+
+    reference operator*() const
+    { return const_cast< reference >( Superclass::operator*() ); }
+
+    pointer operator->() const
+    { return const_cast< pointer >( Superclass::operator->() ); }
+
+    reference operator[]( difference_type n ) const
+    { return *( *this + n ); }
+
+    Iterator & operator++()
+    {
+      Superclass::operator++();
+      return *this;
+    }
+
+    Iterator operator++( int )
+    {
+      Iterator it = *this;
+      ++( *this );
+      return it;
+    }
+
+    Iterator & operator--()
+    {
+      Superclass::operator--();
+      return *this;
+    }
+
+    Iterator operator--( int )
+    {
+      Iterator it = *this;
+      --( *this );
+      return it;
+    }
+
+    Iterator & operator+=( difference_type n )
+    {
+      Superclass::operator+=( n );
+      return *this;
+    }
+
+    Iterator & operator-=( difference_type n )
+    {
+      Superclass::operator-=( n );
+      return *this;
+    }
+
+    Iterator operator+( difference_type n ) const
+    {
+      Iterator it = *this;
+      it += n;
+      return it;
+    }
+
+    Iterator operator-( difference_type n ) const
+    {
+      Iterator it = *this;
+      it -= n;
+      return it;
+    }
+
+  protected:
+    friend class LevelSetSparseLayer;
+
+    Iterator( const BlockContainerType *blocks, size_type block, size_type node ) :
+      Superclass( blocks, block, node ) {}
+  };
+
+  typedef Iterator      iterator;
+  typedef ConstIterator const_iterator;
+
+  LevelSetSparseLayer() : m_Size( 0 ) {}
+
+  iterator begin();
+  const_iterator begin() const;
+
+  iterator end()
+  { return Iterator( &m_Blocks, m_Blocks.size(), 0 ); }
+
+  const_iterator end() const
+  { return ConstIterator( &m_Blocks, m_Blocks.size(), 0 ); }
+
+  /** Number of nodes, not counting the erased ones. */
+  size_type size() const
+  { return m_Size; }
+
+  bool empty() const
+  { return m_Size == 0; }
+
+  void clear()
+  {
+    m_Blocks.clear();
+    m_Size = 0;
+  }
+
+  iterator find( const key_type & key );
+  const_iterator find( const key_type & key ) const;
+
+  size_type count( const key_type & key ) const
+  { return ( this->find( key ) == this->end() ) ? 0 : 1; }
+
+  /** Value of the node with the given key, inserted if needed. */
+  mapped_type & operator[]( const key_type & key )
+  { return this->insert( value_type( key, mapped_type() ) ).first->second; }
+
+  /** Insert a node, unless there already is a node with the same key. */
+  std::pair< iterator, bool > insert( const value_type & value );
+
+  /** Insert a node. The position is found by a binary search: the hint is
+   * only there for compatibility with std::map. */
+  iterator insert( const_iterator itkNotUsed( hint ), const value_type & value )
+  { return this->insert( value ).first; }
+
+  template< typename TInputIterator >
+  void insert( TInputIterator first, TInputIterator last )
+  {
+    for( ; first != last; ++first )
+      {
+      this->insert( *first );
+      }
+  }
+
+  /** Mark the node as erased. The other iterators remain valid. */
+  void erase( const_iterator position );
+
+  size_type erase( const key_type & key );
+
+  /** Remove the erased nodes and make blocks of BlockSize nodes. */
+  void Squeeze();
+
+private:
+  /** First block whose last node is not before the key. */
+  size_type FindBlock( const key_type & key ) const;
+
+  /** First node of the block which is not before the key. */
+  size_type FindNode( const BlockType & block, const key_type & key ) const;
+
+  /** Remove the erased nodes of a block. */
+  void SqueezeBlock( BlockType & block );
+
+  BlockContainerType m_Blocks;
+  size_type          m_Size;
+  key_compare        m_Compare;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#include "itkLevelSetSparseLayer.hxx"
+#endif
+
+#endif // itkLevelSetSparseLayer_h
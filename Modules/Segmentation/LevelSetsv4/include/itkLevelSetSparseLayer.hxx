@@ -0,0 +1,301 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#ifndef itkLevelSetSparseLayer_hxx
+#define itkLevelSetSparseLayer_hxx
+
+#include "itkLevelSetSparseLayer.h"
+
+namespace itk
+{
+
+template< typename TKey, typename TValue, typename TCompare >
+typename LevelSetSparseLayer< TKey, TValue, TCompare >::iterator
+LevelSetSparseLayer< TKey, TValue, TCompare >
+::begin()
+{
+  Iterator it( &m_Blocks, 0, 0 );
+  it.SkipErasedNodes();
+  return it;
+}
+
+
+template< typename TKey, typename TValue, typename TCompare >
+typename LevelSetSparseLayer< TKey, TValue, TCompare >::const_iterator
+LevelSetSparseLayer< TKey, TValue, TCompare >
+::begin() const
+{
+  ConstIterator it( &m_Blocks, 0, 0 );
+  it.SkipErasedNodes();
+  return it;
+}
+
+
+template< typename TKey, typename TValue, typename TCompare >
+typename LevelSetSparseLayer< TKey, TValue, TCompare >::iterator
+LevelSetSparseLayer< TKey, TValue, TCompare >
+::find( const key_type & key )
+{
+  const size_type b = this->FindBlock( key );
+  if( b < m_Blocks.size() )
+    {
+    const BlockType & block = m_Blocks[b];
+    const size_type n = this->FindNode( block, key );
+    if( !m_Compare( key, block.m_Nodes[n].m_Pair.first ) && !block.m_Nodes[n].m_Erased )
+      {
+      return Iterator( &m_Blocks, b, n );
+      }
+    }
+  return this->end();
+}
+
+
+template< typename TKey, typename TValue, typename TCompare >
+typename LevelSetSparseLayer< TKey, TValue, TCompare >::const_iterator
+LevelSetSparseLayer< TKey, TValue, TCompare >
+::find( const key_type & key ) const
+{
+  const size_type b = this->FindBlock( key );
+  if( b < m_Blocks.size() )
+    {
+    const BlockType & block = m_Blocks[b];
+    const size_type n = this->FindNode( block, key );
+    if( !m_Compare( key, block.m_Nodes[n].m_Pair.first ) && !block.m_Nodes[n].m_Erased )
+      {
+      return ConstIterator( &m_Blocks, b, n );
+      }
+    }
+  return this->end();
+}
+
+
+template< typename TKey, typename TValue, typename TCompare >
+std::pair< typename LevelSetSparseLayer< TKey, TValue, TCompare >::iterator, bool >
+LevelSetSparseLayer< TKey, TValue, TCompare >
+::insert( const value_type & value )
+{
+  const key_type & key = value.first;
+
+  NodeType node;
+  node.m_Pair = value;
+  node.m_Erased = false;
+
+  if( m_Blocks.empty() )
+    {
+    m_Blocks.push_back( BlockType() );
+    m_Blocks.back().m_Nodes.push_back( node );
+    m_Size = 1;
+    return std::make_pair( Iterator( &m_Blocks, 0, 0 ), true );
+    }
+
+  // a node after all the others goes at the end of the last block
+  size_type b = this->FindBlock( key );
+  if( b == m_Blocks.size() )
+    {
+    --b;
+    }
+
+  BlockType & block = m_Blocks[b];
+  size_type n = this->FindNode( block, key );
+
+  if( n < block.m_Nodes.size() && !m_Compare( key, block.m_Nodes[n].m_Pair.first ) )
+    {
+    NodeType & node = block.m_Nodes[n];
+    if( !node.m_Erased )
+      {
+      return std::make_pair( Iterator( &m_Blocks, b, n ), false );
+      }
+    node.m_Pair.second = value.second;
+    node.m_Erased = false;
+    --block.m_NumberOfErased;
+    ++m_Size;
+    return std::make_pair( Iterator( &m_Blocks, b, n ), true );
+    }
+
+  // An erased node just before or after the position of the key can take
+  // the new node without changing the order.
+  if( n > 0 && block.m_Nodes[n - 1].m_Erased )
+    {
+    --n;
+    }
+  if( n < block.m_Nodes.size() && block.m_Nodes[n].m_Erased )
+    {
+    block.m_Nodes[n].m_Pair = value;
+    block.m_Nodes[n].m_Erased = false;
+    --block.m_NumberOfErased;
+    ++m_Size;
+    return std::make_pair( Iterator( &m_Blocks, b, n ), true );
+    }
+
+  if( block.m_NumberOfErased > 0 )
+    {
+    this->SqueezeBlock( block );
+    n = this->FindNode( block, key );
+    }
+
+  block.m_Nodes.insert( block.m_Nodes.begin() + n, node );
+  ++m_Size;
+
+  const size_type blockSize = itkGetStaticConstMacro( BlockSize );
+  if( block.m_Nodes.size() > 2 * blockSize )
+    {
+    // Split the block in two, and move the next blocks by swapping them, so
+    // that their nodes are not copied.
+    m_Blocks.push_back( BlockType() );
+    for( size_type i = m_Blocks.size() - 1; i > b + 1; --i )
+      {
+      m_Blocks[i].m_Nodes.swap( m_Blocks[i - 1].m_Nodes );
+      std::swap( m_Blocks[i].m_NumberOfErased, m_Blocks[i - 1].m_NumberOfErased );
+      }
+    std::vector< NodeType > & first = m_Blocks[b].m_Nodes;
+    std::vector< NodeType > & second = m_Blocks[b + 1].m_Nodes;
+    const size_type half = first.size() / 2;
+    second.assign( first.begin() + half, first.end() );
+    first.erase( first.begin() + half, first.end() );
+    if( n >= half )
+      {
+      return std::make_pair( Iterator( &m_Blocks, b + 1, n - half ), true );
+      }
+    }
+  return std::make_pair( Iterator( &m_Blocks, b, n ), true );
+}
+
+
+template< typename TKey, typename TValue, typename TCompare >
+void
+LevelSetSparseLayer< TKey, TValue, TCompare >
+::erase( const_iterator position )
+{
+  BlockType & block = m_Blocks[position.m_Block];
+  block.m_Nodes[position.m_Node].m_Erased = true;
+  ++block.m_NumberOfErased;
+  --m_Size;
+}
+
+
+template< typename TKey, typename TValue, typename TCompare >
+typename LevelSetSparseLayer< TKey, TValue, TCompare >::size_type
+LevelSetSparseLayer< TKey, TValue, TCompare >
+::erase( const key_type & key )
+{
+  const_iterator it = this->find( key );
+  if( it == this->end() )
+    {
+    return 0;
+    }
+  this->erase( it );
+  return 1;
+}
+
+
+template< typename TKey, typename TValue, typename TCompare >
+void
+LevelSetSparseLayer< TKey, TValue, TCompare >
+::Squeeze()
+{
+  const size_type blockSize = itkGetStaticConstMacro( BlockSize );
+
+  BlockContainerType blocks;
+  blocks.reserve( ( m_Size + blockSize - 1 ) / blockSize );
+
+  for( const_iterator it = this->begin(); it != this->end(); ++it )
+    {
+    if( blocks.empty() || blocks.back().m_Nodes.size() == blockSize )
+      {
+      blocks.push_back( BlockType() );
+      blocks.back().m_Nodes.reserve( blockSize );
+      }
+    NodeType node;
+    node.m_Pair = *it;
+    node.m_Erased = false;
+    blocks.back().m_Nodes.push_back( node );
+    }
+  m_Blocks.swap( blocks );
+}
+
+
+template< typename TKey, typename TValue, typename TCompare >
+typename LevelSetSparseLayer< TKey, TValue, TCompare >::size_type
+LevelSetSparseLayer< TKey, TValue, TCompare >
+::FindBlock( const key_type & key ) const
+{
+  size_type first = 0;
+  size_type count = m_Blocks.size();
+  while( count > 0 )
+    {
+    const size_type step = count / 2;
+    const size_type middle = first + step;
+    if( m_Compare( m_Blocks[middle].m_Nodes.back().m_Pair.first, key ) )
+      {
+      first = middle + 1;
+      count -= step + 1;
+      }
+    else
+      {
+      count = step;
+      }
+    }
+  return first;
+}
+
+
+template< typename TKey, typename TValue, typename TCompare >
+typename LevelSetSparseLayer< TKey, TValue, TCompare >::size_type
+LevelSetSparseLayer< TKey, TValue, TCompare >
+::FindNode( const BlockType & block, const key_type & key ) const
+{
+  size_type first = 0;
+  size_type count = block.m_Nodes.size();
+  while( count > 0 )
+    {
+    const size_type step = count / 2;
+    const size_type middle = first + step;
+    if( m_Compare( block.m_Nodes[middle].m_Pair.first, key ) )
+      {
+      first = middle + 1;
+      count -= step + 1;
+      }
+    else
+      {
+      count = step;
+      }
+    }
+  return first;
+}
+
+
+template< typename TKey, typename TValue, typename TCompare >
+void
+LevelSetSparseLayer< TKey, TValue, TCompare >
+::SqueezeBlock( BlockType & block )
+{
+  size_type kept = 0;
+  for( size_type n = 0; n < block.m_Nodes.size(); ++n )
+    {
+    if( !block.m_Nodes[n].m_Erased )
+      {
+      block.m_Nodes[kept++] = block.m_Nodes[n];
+      }
+    }
+  block.m_Nodes.erase( block.m_Nodes.begin() + kept, block.m_Nodes.end() );
+  block.m_NumberOfErased = 0;
+}
+
+} // end namespace itk
+
+#endif // itkLevelSetSparseLayer_hxx
@@ -47,6 +47,13 @@ typename MalcolmSparseLevelSetImage< VDimension >::OutputType
 MalcolmSparseLevelSetImage< VDimension >::Evaluate( const InputType& inputPixel ) const
 {
   InputType mapIndex = inputPixel - this->m_DomainOffset;
+
+  OutputType rval;
+  if( this->EvaluateWithLabelImage( mapIndex, rval ) )
+    {
+    return rval;
+    }
+
   LayerMapConstIterator layerIt = this->m_Layers.begin();
 
   while( layerIt != this->m_Layers.end() )
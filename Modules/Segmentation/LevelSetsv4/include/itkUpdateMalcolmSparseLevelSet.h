@@ -27,6 +27,7 @@
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkLabelMapToLabelImageFilter.h"
 #include "itkLabelImageToLabelMapFilter.h"
+#include "itkMultiThreader.h"
 
 namespace itk
 {
@@ -34,6 +35,11 @@ namespace itk
  *  \class UpdateMalcolmSparseLevelSet
  *  \brief Base class for updating the Malcolm representation of level-set function
  *
+ *  The equation is evaluated on the zero layer in parallel, each thread
+ *  filling the updates of a range of the layer; the nodes are then moved
+ *  between the layers in the order of their indices, so that the result does
+ *  not depend on the number of threads.
+ *
  *  \tparam VDimension Dimension of the input space
  *  \tparam TEquationContainer Container of the system of levelset equations
  *  \ingroup ITKLevelSetsv4
@@ -103,6 +109,11 @@ public:
   itkSetMacro( CurrentLevelSetId, IdentifierType );
   itkGetMacro( CurrentLevelSetId, IdentifierType );
 
+  /** Set/Get the number of threads used to evaluate the equation on the
+   * zero layer. Defaults to the global default number of threads. */
+  itkSetClampMacro( NumberOfThreads, ThreadIdType, 1, ITK_MAX_THREADS );
+  itkGetConstMacro( NumberOfThreads, ThreadIdType );
+
 protected:
   UpdateMalcolmSparseLevelSet();
   virtual ~UpdateMalcolmSparseLevelSet();
@@ -152,6 +163,18 @@ private:
 
   typedef std::pair< LevelSetInputType, LevelSetOutputType > NodePairType;
 
+  /** Evaluate the equation on a range of the zero layer. */
+  void ThreadedFillUpdateContainer( ThreadIdType threadId );
+
+  static ITK_THREAD_RETURN_TYPE FillUpdateContainerThreaderCallback( void *arg );
+
+  ThreadIdType m_NumberOfThreads;
+
+  // the ranges of the zero layer processed by the threads, and the updates
+  // they compute, in the order of the layer
+  std::vector< LevelSetLayerConstIterator > m_LayerRanges;
+  std::vector< SizeValueType >              m_LayerRangeOffsets;
+  std::vector< LevelSetOutputType >         m_UpdateValues;
 };
 }
 
@@ -21,6 +21,7 @@
 
 #include "itkMath.h"
 #include "itkUpdateMalcolmSparseLevelSet.h"
+#include "itkImageAlgorithm.h"
 
 
 namespace itk
@@ -31,7 +32,8 @@ UpdateMalcolmSparseLevelSet< VDimension, TEquationContainer >
 ::UpdateMalcolmSparseLevelSet() :
   m_CurrentLevelSetId( NumericTraits< IdentifierType >::ZeroValue() ),
   m_RMSChangeAccumulator( NumericTraits< LevelSetOutputRealType >::ZeroValue() ),
-  m_IsUsingUnPhasedPropagation( true )
+  m_IsUsingUnPhasedPropagation( true ),
+  m_NumberOfThreads( MultiThreader::GetGlobalDefaultNumberOfThreads() )
 {
   this->m_Offset.Fill( 0 );
   this->m_OutputLevelSet = LevelSetType::New();
@@ -59,13 +61,28 @@ UpdateMalcolmSparseLevelSet< VDimension, TEquationContainer >
   this->m_OutputLevelSet->SetLabelMap( this->m_InputLevelSet->GetModifiableLabelMap() );
   this->m_OutputLevelSet->SetDomainOffset( this->m_Offset );
 
-  typedef LabelMapToLabelImageFilter<LevelSetLabelMapType, LabelImageType> LabelMapToLabelImageFilterType;
-  typename LabelMapToLabelImageFilterType::Pointer labelMapToLabelImageFilter = LabelMapToLabelImageFilterType::New();
-  labelMapToLabelImageFilter->SetInput( this->m_InputLevelSet->GetLabelMap() );
-  labelMapToLabelImageFilter->Update();
+  const LabelImageType* inputLabelImage = this->m_InputLevelSet->GetLabelImage();
+  if( inputLabelImage != ITK_NULLPTR )
+    {
+    // the labels left by the previous update, copied so that the input
+    // level set is not modified
+    this->m_InternalImage = LabelImageType::New();
+    this->m_InternalImage->CopyInformation( inputLabelImage );
+    this->m_InternalImage->SetRegions( inputLabelImage->GetBufferedRegion() );
+    this->m_InternalImage->Allocate();
+    ImageAlgorithm::Copy( inputLabelImage, this->m_InternalImage.GetPointer(),
+                          inputLabelImage->GetBufferedRegion(), inputLabelImage->GetBufferedRegion() );
+    }
+  else
+    {
+    typedef LabelMapToLabelImageFilter<LevelSetLabelMapType, LabelImageType> LabelMapToLabelImageFilterType;
+    typename LabelMapToLabelImageFilterType::Pointer labelMapToLabelImageFilter = LabelMapToLabelImageFilterType::New();
+    labelMapToLabelImageFilter->SetInput( this->m_InputLevelSet->GetLabelMap() );
+    labelMapToLabelImageFilter->Update();
 
-  this->m_InternalImage = labelMapToLabelImageFilter->GetOutput();
-  this->m_InternalImage->DisconnectPipeline();
+    this->m_InternalImage = labelMapToLabelImageFilter->GetOutput();
+    this->m_InternalImage->DisconnectPipeline();
+    }
 
   this->FillUpdateContainer();
 
@@ -125,8 +142,12 @@ UpdateMalcolmSparseLevelSet< VDimension, TEquationContainer >
   labelImageToLabelMapFilter->SetBackgroundValue( LevelSetType::PlusOneLayer() );
   labelImageToLabelMapFilter->Update();
 
-  LevelSetLabelMapPointer outputLabelMap = this->m_OutputLevelSet->GetModifiableLabelMap( );
-  outputLabelMap->Graft( labelImageToLabelMapFilter->GetOutput() );
+  // the output gets its own label map, so that the input level set is not
+  // modified before it is grafted
+  LevelSetLabelMapPointer outputLabelMap = labelImageToLabelMapFilter->GetOutput();
+  outputLabelMap->DisconnectPipeline();
+  this->m_OutputLevelSet->SetLabelMap( outputLabelMap );
+  this->m_OutputLevelSet->SetLabelImage( this->m_InternalImage );
 }
 
 template< unsigned int VDimension,
@@ -135,18 +156,95 @@ void
 UpdateMalcolmSparseLevelSet< VDimension, TEquationContainer >
 ::FillUpdateContainer()
 {
-  LevelSetLayerType levelZero = this->m_OutputLevelSet->GetLayer( LevelSetType::ZeroLayer() );
+  const LevelSetLayerType & levelZero = this->m_OutputLevelSet->GetLayer( LevelSetType::ZeroLayer() );
+  if( levelZero.empty() )
+    {
+    return;
+    }
 
-  LevelSetLayerIterator nodeIt = levelZero.begin();
-  LevelSetLayerIterator nodeEnd = levelZero.end();
+  // split the layer in contiguous ranges, one per thread
+  const SizeValueType numberOfNodes = static_cast< SizeValueType >( levelZero.size() );
+  ThreadIdType numberOfThreads = this->m_NumberOfThreads;
+  if( numberOfNodes < numberOfThreads )
+    {
+    numberOfThreads = static_cast< ThreadIdType >( numberOfNodes );
+    }
 
+  this->m_LayerRanges.resize( numberOfThreads + 1 );
+  this->m_LayerRangeOffsets.resize( numberOfThreads + 1 );
+  LevelSetLayerConstIterator nodeIt = levelZero.begin();
+  SizeValueType node = 0;
+  for( ThreadIdType threadId = 0; threadId < numberOfThreads; ++threadId )
+    {
+    const SizeValueType rangeBegin = numberOfNodes * threadId / numberOfThreads;
+    for( ; node < rangeBegin; ++node )
+      {
+      ++nodeIt;
+      }
+    this->m_LayerRanges[threadId] = nodeIt;
+    this->m_LayerRangeOffsets[threadId] = rangeBegin;
+    }
+  this->m_LayerRanges[numberOfThreads] = levelZero.end();
+  this->m_LayerRangeOffsets[numberOfThreads] = numberOfNodes;
+
+  this->m_UpdateValues.resize( numberOfNodes );
+
+  if( numberOfThreads == 1 )
+    {
+    this->ThreadedFillUpdateContainer( 0 );
+    }
+  else
+    {
+    MultiThreader::Pointer threader = MultiThreader::New();
+    threader->SetNumberOfThreads( numberOfThreads );
+    threader->SetSingleMethod( this->FillUpdateContainerThreaderCallback, this );
+    threader->SingleMethodExecute();
+    }
+
+  // the updates are in the order of the layer, so that the hinted insertions
+  // are done in constant time
+  node = 0;
+  for( nodeIt = levelZero.begin(); nodeIt != levelZero.end(); ++nodeIt, ++node )
+    {
+    this->m_Update.insert( this->m_Update.end(), NodePairType( nodeIt->first, this->m_UpdateValues[node] ) );
+    }
+
+  this->m_LayerRanges.clear();
+  this->m_LayerRangeOffsets.clear();
+  this->m_UpdateValues.clear();
+}
+
+template< unsigned int VDimension,
+          typename TEquationContainer >
+ITK_THREAD_RETURN_TYPE
+UpdateMalcolmSparseLevelSet< VDimension, TEquationContainer >
+::FillUpdateContainerThreaderCallback( void *arg )
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  Self *self = static_cast< Self * >( info->UserData );
+
+  if( info->ThreadID + 1 < self->m_LayerRanges.size() )
+    {
+    self->ThreadedFillUpdateContainer( info->ThreadID );
+    }
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< unsigned int VDimension,
+          typename TEquationContainer >
+void
+UpdateMalcolmSparseLevelSet< VDimension, TEquationContainer >
+::ThreadedFillUpdateContainer( ThreadIdType threadId )
+{
   TermContainerPointer termContainer = this->m_EquationContainer->GetEquation( this->m_CurrentLevelSetId );
 
-  LevelSetInputType inputIndex;
+  LevelSetLayerConstIterator nodeIt = this->m_LayerRanges[threadId];
+  LevelSetLayerConstIterator nodeEnd = this->m_LayerRanges[threadId + 1];
+  SizeValueType node = this->m_LayerRangeOffsets[threadId];
+
   while( nodeIt != nodeEnd )
     {
-    const LevelSetInputType currentIndex = nodeIt->first;
-    inputIndex = currentIndex + this->m_Offset;
+    const LevelSetInputType inputIndex = nodeIt->first + this->m_Offset;
 
     const LevelSetOutputRealType update = termContainer->Evaluate( inputIndex );
 
@@ -161,9 +259,10 @@ UpdateMalcolmSparseLevelSet< VDimension, TEquationContainer >
       value = - NumericTraits< LevelSetOutputType >::OneValue();
       }
 
-    this->m_Update.insert( NodePairType( currentIndex, value ) );
+    this->m_UpdateValues[node] = value;
 
     ++nodeIt;
+    ++node;
     }
 }
 
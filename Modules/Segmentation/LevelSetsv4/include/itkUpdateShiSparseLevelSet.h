@@ -27,6 +27,7 @@
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkLabelMapToLabelImageFilter.h"
 #include "itkLabelImageToLabelMapFilter.h"
+#include "itkMultiThreader.h"
 
 namespace itk
 {
@@ -34,6 +35,13 @@ namespace itk
  *  \class UpdateShiSparseLevelSet
  *  \brief Base class for updating the Shi representation of level-set function
  *
+ *  The nodes of the +1 and -1 layers which move to the opposite layer are
+ *  found in parallel: each thread evaluates the equation on a range of the
+ *  layer and records the nodes it moves, and the neighbors entering the band,
+ *  in its own lists. These lists are merged in the order of the indices
+ *  before the label image and the equation terms are updated, so that the
+ *  result does not depend on the number of threads.
+ *
  *  \tparam VDimension Dimension of the input space
  *  \tparam TEquationContainer Container of the system of levelset equations
  *  \ingroup ITKLevelSetsv4
@@ -103,6 +111,11 @@ public:
   itkSetMacro( CurrentLevelSetId, IdentifierType );
   itkGetMacro( CurrentLevelSetId, IdentifierType );
 
+  /** Set/Get the number of threads used to find the nodes moving between
+   * the layers. Defaults to the global default number of threads. */
+  itkSetClampMacro( NumberOfThreads, ThreadIdType, 1, ITK_MAX_THREADS );
+  itkGetConstMacro( NumberOfThreads, ThreadIdType );
+
 protected:
   UpdateShiSparseLevelSet();
   virtual ~UpdateShiSparseLevelSet();
@@ -135,6 +148,14 @@ protected:
             const LevelSetOutputType& currentStatus,
             const LevelSetOutputRealType& currentUpdate ) const;
 
+  /** Find the nodes of the layer of the given status (+1 or -1) which move
+   * to the opposite layer, and the neighbors at -3 or +3 which then enter
+   * the layer of the given status. */
+  void FindLayerMoves( const LevelSetLayerType & layer,
+                       const LevelSetOutputType & status,
+                       LevelSetLayerType & movedNodes,
+                       LevelSetLayerType & addedNodes );
+
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(UpdateShiSparseLevelSet);
 
@@ -143,6 +164,20 @@ private:
   LevelSetOffsetType m_Offset;
 
   typedef std::pair< LevelSetInputType, LevelSetOutputType > NodePairType;
+
+  /** Find the moves of the nodes of a range of the layer. */
+  void ThreadedFindLayerMoves( ThreadIdType threadId );
+
+  static ITK_THREAD_RETURN_TYPE FindLayerMovesThreaderCallback( void *arg );
+
+  ThreadIdType m_NumberOfThreads;
+
+  // the ranges of the layer processed by the threads, and the nodes they
+  // move and add
+  std::vector< LevelSetLayerConstIterator > m_LayerRanges;
+  LevelSetOutputType                        m_LayerStatus;
+  std::vector< LevelSetLayerType >          m_MovedNodesPerThread;
+  std::vector< LevelSetLayerType >          m_AddedNodesPerThread;
 };
 }
 
@@ -20,6 +20,7 @@
 #define itkUpdateShiSparseLevelSet_hxx
 
 #include "itkUpdateShiSparseLevelSet.h"
+#include "itkImageAlgorithm.h"
 
 namespace itk
 {
@@ -28,7 +29,9 @@ template< unsigned int VDimension, typename TEquationContainer >
 UpdateShiSparseLevelSet< VDimension, TEquationContainer >
 ::UpdateShiSparseLevelSet() :
   m_CurrentLevelSetId( NumericTraits< IdentifierType >::ZeroValue() ),
-  m_RMSChangeAccumulator( NumericTraits< LevelSetOutputRealType >::ZeroValue() )
+  m_RMSChangeAccumulator( NumericTraits< LevelSetOutputRealType >::ZeroValue() ),
+  m_NumberOfThreads( MultiThreader::GetGlobalDefaultNumberOfThreads() ),
+  m_LayerStatus( LevelSetType::PlusOneLayer() )
 {
   this->m_Offset.Fill( 0 );
   this->m_OutputLevelSet = LevelSetType::New();
@@ -61,13 +64,28 @@ UpdateShiSparseLevelSet< VDimension, TEquationContainer >
   this->m_OutputLevelSet->SetLabelMap( this->m_InputLevelSet->GetModifiableLabelMap() );
   this->m_OutputLevelSet->SetDomainOffset( this->m_Offset );
 
-  typedef LabelMapToLabelImageFilter<LevelSetLabelMapType, LabelImageType> LabelMapToLabelImageFilterType;
-  typename LabelMapToLabelImageFilterType::Pointer labelMapToLabelImageFilter = LabelMapToLabelImageFilterType::New();
-  labelMapToLabelImageFilter->SetInput( this->m_InputLevelSet->GetLabelMap() );
-  labelMapToLabelImageFilter->Update();
+  const LabelImageType* inputLabelImage = this->m_InputLevelSet->GetLabelImage();
+  if( inputLabelImage != ITK_NULLPTR )
+    {
+    // the labels left by the previous update, copied so that the input
+    // level set is not modified
+    this->m_InternalImage = LabelImageType::New();
+    this->m_InternalImage->CopyInformation( inputLabelImage );
+    this->m_InternalImage->SetRegions( inputLabelImage->GetBufferedRegion() );
+    this->m_InternalImage->Allocate();
+    ImageAlgorithm::Copy( inputLabelImage, this->m_InternalImage.GetPointer(),
+                          inputLabelImage->GetBufferedRegion(), inputLabelImage->GetBufferedRegion() );
+    }
+  else
+    {
+    typedef LabelMapToLabelImageFilter<LevelSetLabelMapType, LabelImageType> LabelMapToLabelImageFilterType;
+    typename LabelMapToLabelImageFilterType::Pointer labelMapToLabelImageFilter = LabelMapToLabelImageFilterType::New();
+    labelMapToLabelImageFilter->SetInput( this->m_InputLevelSet->GetLabelMap() );
+    labelMapToLabelImageFilter->Update();
 
-  this->m_InternalImage = labelMapToLabelImageFilter->GetOutput();
-  this->m_InternalImage->DisconnectPipeline();
+    this->m_InternalImage = labelMapToLabelImageFilter->GetOutput();
+    this->m_InternalImage->DisconnectPipeline();
+    }
 
   // neighborhood iterator
   ZeroFluxNeumannBoundaryCondition< LabelImageType > spNBC;
@@ -190,8 +208,12 @@ UpdateShiSparseLevelSet< VDimension, TEquationContainer >
   labelImageToLabelMapFilter->SetBackgroundValue( LevelSetType::PlusThreeLayer() );
   labelImageToLabelMapFilter->Update();
 
-  LevelSetLabelMapPointer outputLabelMap = this->m_OutputLevelSet->GetModifiableLabelMap( );
-  outputLabelMap->Graft( labelImageToLabelMapFilter->GetOutput() );
+  // the output gets its own label map, so that the input level set is not
+  // modified before it is grafted
+  LevelSetLabelMapPointer outputLabelMap = labelImageToLabelMapFilter->GetOutput();
+  outputLabelMap->DisconnectPipeline();
+  this->m_OutputLevelSet->SetLabelMap( outputLabelMap );
+  this->m_OutputLevelSet->SetLabelImage( this->m_InternalImage );
 }
 
 template< unsigned int VDimension, typename TEquationContainer >
@@ -204,83 +226,19 @@ UpdateShiSparseLevelSet< VDimension, TEquationContainer >
   LevelSetLayerType & listOut  = this->m_OutputLevelSet->GetLayer( LevelSetType::PlusOneLayer() );
   LevelSetLayerType & listIn   = this->m_OutputLevelSet->GetLayer( LevelSetType::MinusOneLayer() );
 
-  ZeroFluxNeumannBoundaryCondition< LabelImageType > spNBC;
-
-  typename NeighborhoodIteratorType::RadiusType radius;
-  radius.Fill( 1 );
-
-  NeighborhoodIteratorType neighIt( radius, this->m_InternalImage,
-                                    this->m_InternalImage->GetLargestPossibleRegion() );
-
-  neighIt.OverrideBoundaryCondition( &spNBC );
-
-  typename NeighborhoodIteratorType::OffsetType sparseOffset;
-  sparseOffset.Fill( 0 );
-
-  for( unsigned int dim = 0; dim < ImageDimension; dim++ )
-    {
-    sparseOffset[dim] = -1;
-    neighIt.ActivateOffset( sparseOffset );
-    sparseOffset[dim] = 1;
-    neighIt.ActivateOffset( sparseOffset );
-    sparseOffset[dim] = 0;
-    }
-
   LevelSetLayerType insertListIn;
   LevelSetLayerType insertListOut;
 
-  LevelSetLayerIterator nodeIt   = listOut.begin();
-  LevelSetLayerIterator nodeEnd  = listOut.end();
+  this->FindLayerMoves( listOut, LevelSetType::PlusOneLayer(), insertListIn, insertListOut );
 
-  LevelSetInputType inputIndex;
+  LevelSetLayerIterator nodeIt   = insertListIn.begin();
+  LevelSetLayerIterator nodeEnd  = insertListIn.end();
 
-  // for each point in Lz
+  // CheckIn
   while( nodeIt != nodeEnd )
     {
-    bool erased = false;
-    const LevelSetInputType   currentIndex = nodeIt->first;
-    const LevelSetOutputType  currentValue = nodeIt->second;
-    inputIndex = currentIndex + this->m_Offset;
-
-    // update the level set
-    LevelSetOutputRealType update = termContainer->Evaluate( inputIndex );
-
-    if( update < NumericTraits< LevelSetOutputRealType >::ZeroValue() )
-      {
-      if( Con( currentIndex, currentValue , update ) )
-        {
-        // CheckIn
-        insertListIn.insert(
-              NodePairType( currentIndex, LevelSetType::MinusOneLayer() ) );
-
-        LevelSetLayerIterator tempIt = nodeIt;
-        ++nodeIt;
-        listOut.erase( tempIt );
-        erased = true;
-
-        neighIt.SetLocation( currentIndex );
-
-        for( typename NeighborhoodIteratorType::Iterator
-            i = neighIt.Begin();
-            !i.IsAtEnd(); ++i )
-          {
-          LevelSetOutputType tempValue = i.Get();
-
-          if ( tempValue == LevelSetType::PlusThreeLayer() )
-            {
-            LevelSetInputType tempIndex =
-                neighIt.GetIndex( i.GetNeighborhoodOffset() );
-
-            insertListOut.insert(
-                  NodePairType( tempIndex, LevelSetType::PlusOneLayer() ) );
-            }
-          }
-        }
-      }
-    if( !erased )
-      {
-      ++nodeIt;
-      }
+    listOut.erase( nodeIt->first );
+    ++nodeIt;
     }
 
   nodeIt   = insertListOut.begin();
@@ -320,13 +278,138 @@ UpdateShiSparseLevelSet< VDimension, TEquationContainer >
   LevelSetLayerType & listOut  = this->m_OutputLevelSet->GetLayer( LevelSetType::PlusOneLayer() );
   LevelSetLayerType & listIn   = this->m_OutputLevelSet->GetLayer( LevelSetType::MinusOneLayer() );
 
+  LevelSetLayerType insertListIn;
+  LevelSetLayerType insertListOut;
+
+  this->FindLayerMoves( listIn, LevelSetType::MinusOneLayer(), insertListOut, insertListIn );
+
+  LevelSetLayerIterator nodeIt   = insertListOut.begin();
+  LevelSetLayerIterator nodeEnd  = insertListOut.end();
+
+  // CheckOut
+  while( nodeIt != nodeEnd )
+    {
+    listIn.erase( nodeIt->first );
+    ++nodeIt;
+    }
+
+  nodeIt   = insertListIn.begin();
+  nodeEnd  = insertListIn.end();
+
+  // for each point in insertListIn
+  while( nodeIt != nodeEnd )
+    {
+    listIn.insert( *nodeIt );
+    this->m_InternalImage->SetPixel( nodeIt->first, LevelSetType::MinusOneLayer() );
+    termContainer->UpdatePixel( nodeIt->first + this->m_Offset, LevelSetType::MinusThreeLayer(), LevelSetType::MinusOneLayer() );
+    ++nodeIt;
+    }
+
+  nodeIt   = insertListOut.begin();
+  nodeEnd  = insertListOut.end();
+
+  // for each point in insertListOut
+  while( nodeIt != nodeEnd )
+    {
+    listOut.insert( *nodeIt );
+    this->m_InternalImage->SetPixel( nodeIt->first, LevelSetType::PlusOneLayer() );
+    termContainer->UpdatePixel( nodeIt->first + this->m_Offset, LevelSetType::MinusOneLayer(), LevelSetType::PlusOneLayer() );
+    ++nodeIt;
+    }
+}
+
+template< unsigned int VDimension, typename TEquationContainer >
+void
+UpdateShiSparseLevelSet< VDimension, TEquationContainer >
+::FindLayerMoves( const LevelSetLayerType & layer,
+                  const LevelSetOutputType & status,
+                  LevelSetLayerType & movedNodes,
+                  LevelSetLayerType & addedNodes )
+{
+  if( layer.empty() )
+    {
+    return;
+    }
+
+  // split the layer in contiguous ranges, one per thread
+  const SizeValueType numberOfNodes = static_cast< SizeValueType >( layer.size() );
+  ThreadIdType numberOfThreads = this->m_NumberOfThreads;
+  if( numberOfNodes < numberOfThreads )
+    {
+    numberOfThreads = static_cast< ThreadIdType >( numberOfNodes );
+    }
+
+  this->m_LayerRanges.resize( numberOfThreads + 1 );
+  this->m_LayerRanges[0] = layer.begin();
+  LevelSetLayerConstIterator nodeIt = layer.begin();
+  SizeValueType node = 0;
+  for( ThreadIdType threadId = 1; threadId < numberOfThreads; ++threadId )
+    {
+    const SizeValueType rangeBegin = numberOfNodes * threadId / numberOfThreads;
+    for( ; node < rangeBegin; ++node )
+      {
+      ++nodeIt;
+      }
+    this->m_LayerRanges[threadId] = nodeIt;
+    }
+  this->m_LayerRanges[numberOfThreads] = layer.end();
+
+  this->m_LayerStatus = status;
+  this->m_MovedNodesPerThread.assign( numberOfThreads, LevelSetLayerType() );
+  this->m_AddedNodesPerThread.assign( numberOfThreads, LevelSetLayerType() );
+
+  if( numberOfThreads == 1 )
+    {
+    this->ThreadedFindLayerMoves( 0 );
+    }
+  else
+    {
+    MultiThreader::Pointer threader = MultiThreader::New();
+    threader->SetNumberOfThreads( numberOfThreads );
+    threader->SetSingleMethod( this->FindLayerMovesThreaderCallback, this );
+    threader->SingleMethodExecute();
+    }
+
+  // the lists are sorted by index, so that the merged lists do not depend on
+  // the number of threads
+  for( ThreadIdType threadId = 0; threadId < numberOfThreads; ++threadId )
+    {
+    movedNodes.insert( this->m_MovedNodesPerThread[threadId].begin(), this->m_MovedNodesPerThread[threadId].end() );
+    addedNodes.insert( this->m_AddedNodesPerThread[threadId].begin(), this->m_AddedNodesPerThread[threadId].end() );
+    }
+  this->m_LayerRanges.clear();
+  this->m_MovedNodesPerThread.clear();
+  this->m_AddedNodesPerThread.clear();
+}
+
+template< unsigned int VDimension, typename TEquationContainer >
+ITK_THREAD_RETURN_TYPE
+UpdateShiSparseLevelSet< VDimension, TEquationContainer >
+::FindLayerMovesThreaderCallback( void *arg )
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  Self *self = static_cast< Self * >( info->UserData );
+
+  if( info->ThreadID < self->m_MovedNodesPerThread.size() )
+    {
+    self->ThreadedFindLayerMoves( info->ThreadID );
+    }
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template< unsigned int VDimension, typename TEquationContainer >
+void
+UpdateShiSparseLevelSet< VDimension, TEquationContainer >
+::ThreadedFindLayerMoves( ThreadIdType threadId )
+{
+  TermContainerPointer termContainer = this->m_EquationContainer->GetEquation( this->m_CurrentLevelSetId );
+
   ZeroFluxNeumannBoundaryCondition< LabelImageType > spNBC;
 
   typename NeighborhoodIteratorType::RadiusType radius;
   radius.Fill( 1 );
 
-  NeighborhoodIteratorType neighIt( radius,
-                                    this->m_InternalImage,
+  NeighborhoodIteratorType neighIt( radius, this->m_InternalImage,
                                     this->m_InternalImage->GetLargestPossibleRegion() );
 
   neighIt.OverrideBoundaryCondition( &spNBC );
@@ -343,85 +426,46 @@ UpdateShiSparseLevelSet< VDimension, TEquationContainer >
     sparseOffset[dim] = 0;
     }
 
-  LevelSetLayerType insertListIn;
-  LevelSetLayerType insertListOut;
+  const LevelSetOutputType status = this->m_LayerStatus;
+  const LevelSetOutputType oppositeStatus = ( status == LevelSetType::PlusOneLayer() ) ?
+        LevelSetType::MinusOneLayer() : LevelSetType::PlusOneLayer();
+  const LevelSetOutputType outsideStatus = ( status == LevelSetType::PlusOneLayer() ) ?
+        LevelSetType::PlusThreeLayer() : LevelSetType::MinusThreeLayer();
 
-  LevelSetLayerIterator nodeIt   = listIn.begin();
-  LevelSetLayerIterator nodeEnd  = listIn.end();
+  LevelSetLayerType & movedNodes = this->m_MovedNodesPerThread[threadId];
+  LevelSetLayerType & addedNodes = this->m_AddedNodesPerThread[threadId];
 
-  // for each point in Lz
+  // the label image is not modified here, so that the moves do not depend on
+  // the order of the nodes
+  LevelSetLayerConstIterator nodeIt  = this->m_LayerRanges[threadId];
+  LevelSetLayerConstIterator nodeEnd = this->m_LayerRanges[threadId + 1];
   while( nodeIt != nodeEnd )
     {
-    bool erased = false;
     const LevelSetInputType   currentIndex = nodeIt->first;
     const LevelSetOutputType  currentValue = nodeIt->second;
-    const LevelSetInputType inputIndex = currentIndex + this->m_Offset;
 
-    // update for the current level set
-    LevelSetOutputRealType update = termContainer->Evaluate( inputIndex );
+    // update the level set
+    const LevelSetOutputRealType update = termContainer->Evaluate( currentIndex + this->m_Offset );
 
-    if( update > NumericTraits< LevelSetOutputRealType >::ZeroValue() )
+    if( update * status < NumericTraits< LevelSetOutputRealType >::ZeroValue() &&
+        Con( currentIndex, currentValue, update ) )
       {
-      if( Con( currentIndex, currentValue , update ) )
-        {
-        // CheckOut
-        insertListOut.insert(
-              NodePairType( currentIndex, LevelSetType::PlusOneLayer() ) );
-
-        LevelSetLayerIterator tempIt = nodeIt;
-        ++nodeIt;
-        listIn.erase( tempIt );
-
-        erased = true;
+      movedNodes.insert( movedNodes.end(), NodePairType( currentIndex, oppositeStatus ) );
 
-        neighIt.SetLocation( currentIndex );
+      neighIt.SetLocation( currentIndex );
 
-        for( typename NeighborhoodIteratorType::Iterator
-            i = neighIt.Begin(); !i.IsAtEnd(); ++i )
+      for( typename NeighborhoodIteratorType::Iterator i = neighIt.Begin(); !i.IsAtEnd(); ++i )
+        {
+        if ( i.Get() == outsideStatus )
           {
-          LevelSetOutputType tempValue = i.Get();
-
-          if ( tempValue == LevelSetType::MinusThreeLayer() )
-            {
-            LevelSetInputType tempIndex = neighIt.GetIndex( i.GetNeighborhoodOffset() );
-
-            insertListIn.insert( NodePairType( tempIndex, LevelSetType::MinusOneLayer() ) );
-            }
+          addedNodes.insert( NodePairType( neighIt.GetIndex( i.GetNeighborhoodOffset() ), status ) );
           }
         }
       }
-    if( !erased )
-      {
-      ++nodeIt;
-      }
-    }
-
-  nodeIt   = insertListIn.begin();
-  nodeEnd  = insertListIn.end();
-
-  // for each point in insertListIn
-  while( nodeIt != nodeEnd )
-    {
-    listIn.insert( *nodeIt );
-    this->m_InternalImage->SetPixel( nodeIt->first, LevelSetType::MinusOneLayer() );
-    termContainer->UpdatePixel( nodeIt->first + this->m_Offset, LevelSetType::MinusThreeLayer(), LevelSetType::MinusOneLayer() );
-    ++nodeIt;
-    }
-
-  nodeIt   = insertListOut.begin();
-  nodeEnd  = insertListOut.end();
-
-  // for each point in insertListOut
-  while( nodeIt != nodeEnd )
-    {
-    listOut.insert( *nodeIt );
-    this->m_InternalImage->SetPixel( nodeIt->first, LevelSetType::PlusOneLayer() );
-    termContainer->UpdatePixel( nodeIt->first + this->m_Offset, LevelSetType::MinusOneLayer(), LevelSetType::PlusOneLayer() );
     ++nodeIt;
     }
 }
 
-
 template< unsigned int VDimension, typename TEquationContainer >
 bool
 UpdateShiSparseLevelSet< VDimension, TEquationContainer >
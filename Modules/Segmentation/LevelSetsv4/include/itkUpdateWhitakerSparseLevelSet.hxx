@@ -20,6 +20,7 @@
 #define itkUpdateWhitakerSparseLevelSet_hxx
 
 #include "itkUpdateWhitakerSparseLevelSet.h"
+#include "itkImageAlgorithm.h"
 
 namespace itk
 {
@@ -84,12 +85,27 @@ void UpdateWhitakerSparseLevelSet< VDimension, TLevelSetValueType, TEquationCont
 
   this->m_OutputLevelSet->SetLabelMap( this->m_InputLevelSet->GetModifiableLabelMap() );
 
-  typename LabelMapToLabelImageFilterType::Pointer labelMapToLabelImageFilter = LabelMapToLabelImageFilterType::New();
-  labelMapToLabelImageFilter->SetInput( this->m_InputLevelSet->GetLabelMap() );
-  labelMapToLabelImageFilter->Update();
+  const LabelImageType* inputLabelImage = this->m_InputLevelSet->GetLabelImage();
+  if( inputLabelImage != ITK_NULLPTR )
+    {
+    // the labels left by the previous update, copied so that the input
+    // level set is not modified
+    this->m_InternalImage = LabelImageType::New();
+    this->m_InternalImage->CopyInformation( inputLabelImage );
+    this->m_InternalImage->SetRegions( inputLabelImage->GetBufferedRegion() );
+    this->m_InternalImage->Allocate();
+    ImageAlgorithm::Copy( inputLabelImage, this->m_InternalImage.GetPointer(),
+                          inputLabelImage->GetBufferedRegion(), inputLabelImage->GetBufferedRegion() );
+    }
+  else
+    {
+    typename LabelMapToLabelImageFilterType::Pointer labelMapToLabelImageFilter = LabelMapToLabelImageFilterType::New();
+    labelMapToLabelImageFilter->SetInput( this->m_InputLevelSet->GetLabelMap() );
+    labelMapToLabelImageFilter->Update();
 
-  this->m_InternalImage = labelMapToLabelImageFilter->GetOutput();
-  this->m_InternalImage->DisconnectPipeline();
+    this->m_InternalImage = labelMapToLabelImageFilter->GetOutput();
+    this->m_InternalImage->DisconnectPipeline();
+    }
 
   this->m_TempPhi.clear();
 
@@ -194,7 +210,12 @@ void UpdateWhitakerSparseLevelSet< VDimension, TLevelSetValueType, TEquationCont
   labelImageToLabelMapFilter->SetBackgroundValue( LevelSetType::PlusThreeLayer() );
   labelImageToLabelMapFilter->Update();
 
-  this->m_OutputLevelSet->GetModifiableLabelMap( )->Graft( labelImageToLabelMapFilter->GetOutput() );
+  // the output gets its own label map, so that the input level set is not
+  // modified before it is grafted
+  LevelSetLabelMapPointer outputLabelMap = labelImageToLabelMapFilter->GetOutput();
+  outputLabelMap->DisconnectPipeline();
+  this->m_OutputLevelSet->SetLabelMap( outputLabelMap );
+  this->m_OutputLevelSet->SetLabelImage( this->m_InternalImage );
   this->m_TempPhi.clear();
 }
 
@@ -46,9 +46,14 @@ WhitakerSparseLevelSetImage< TOutput, VDimension >
 ::Evaluate( const InputType& inputIndex ) const
 {
   InputType mapIndex = inputIndex - this->m_DomainOffset;
-  LayerMapConstIterator layerIt = this->m_Layers.begin();
 
   OutputType rval = static_cast<OutputType>(ZeroLayer());
+  if( this->EvaluateWithLabelImage( mapIndex, rval ) )
+    {
+    return rval;
+    }
+
+  LayerMapConstIterator layerIt = this->m_Layers.begin();
 
   while( layerIt != this->m_Layers.end() )
     {
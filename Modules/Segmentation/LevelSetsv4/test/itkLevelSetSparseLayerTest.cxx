@@ -0,0 +1,458 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkLevelSetSparseLayer.h"
+#include "itkWhitakerSparseLevelSetImage.h"
+#include "itkShiSparseLevelSetImage.h"
+#include "itkMalcolmSparseLevelSetImage.h"
+#include "itkLevelSetContainer.h"
+#include "itkLevelSetEquationChanAndVeseInternalTerm.h"
+#include "itkLevelSetEquationChanAndVeseExternalTerm.h"
+#include "itkLevelSetEquationTermContainer.h"
+#include "itkLevelSetEquationContainer.h"
+#include "itkLevelSetEvolution.h"
+#include "itkLevelSetEvolutionNumberOfIterationsStoppingCriterion.h"
+#include "itkBinaryImageToLevelSetImageAdaptor.h"
+#include "itkSinRegularizedHeavisideStepFunction.h"
+#include "itkThreadedIteratorRangePartitioner.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+const unsigned int Dimension = 2;
+
+typedef itk::Index< Dimension >                          IndexType;
+typedef itk::Functor::IndexLexicographicCompare< Dimension > CompareType;
+typedef itk::LevelSetSparseLayer< IndexType, double, CompareType > LayerType;
+typedef std::map< IndexType, double, CompareType >       MapType;
+
+unsigned int seed = 11;
+
+unsigned int
+Random( unsigned int range )
+{
+  seed = seed * 1103515245u + 12345u;
+  return ( seed >> 16 ) % range;
+}
+
+IndexType
+RandomIndex()
+{
+  IndexType index;
+  index[0] = Random( 60 );
+  index[1] = Random( 60 );
+  return index;
+}
+
+// Check that the layer holds the nodes of the map, in the same order, and
+// that its iterators can be moved like the ones of a vector.
+bool
+SameNodes( const LayerType & layer, const MapType & map )
+{
+  if( layer.size() != map.size() || layer.empty() != map.empty() )
+    {
+    std::cerr << "The layer has " << layer.size() << " nodes, the map " << map.size() << std::endl;
+    return false;
+    }
+
+  LayerType::const_iterator lIt = layer.begin();
+  MapType::const_iterator   mIt = map.begin();
+  LayerType::difference_type rank = 0;
+  for( ; mIt != map.end(); ++mIt, ++lIt, ++rank )
+    {
+    if( lIt == layer.end() || lIt->first != mIt->first || lIt->second != mIt->second )
+      {
+      std::cerr << "The layer differs from the map at " << mIt->first << std::endl;
+      return false;
+      }
+    if( lIt - layer.begin() != rank || layer.begin() + rank != lIt
+        || layer.end() - lIt != static_cast< LayerType::difference_type >( map.size() ) - rank )
+      {
+      std::cerr << "Wrong rank at " << mIt->first << std::endl;
+      return false;
+      }
+    }
+  if( lIt != layer.end() || std::distance( layer.begin(), layer.end() ) != static_cast< LayerType::difference_type >( map.size() ) )
+    {
+    std::cerr << "The layer has more nodes than the map" << std::endl;
+    return false;
+    }
+
+  // backwards
+  MapType::const_reverse_iterator rIt = map.rbegin();
+  for( ; rIt != map.rend(); ++rIt )
+    {
+    --lIt;
+    if( lIt->first != rIt->first )
+      {
+      std::cerr << "The layer differs from the map backwards at " << rIt->first << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// Apply the same operations to a layer and to a map.
+bool
+CheckLayerOperations()
+{
+  LayerType layer;
+  MapType   map;
+
+  if( !SameNodes( layer, map ) || layer.find( RandomIndex() ) != layer.end() )
+    {
+    return false;
+    }
+
+  for( unsigned int round = 0; round < 4; ++round )
+    {
+    // insertions, in a random order
+    for( unsigned int i = 0; i < 1500; ++i )
+      {
+      const std::pair< IndexType, double > node( RandomIndex(), Random( 1000 ) / 1000.0 );
+      const std::pair< LayerType::iterator, bool > lResult = layer.insert( node );
+      const std::pair< MapType::iterator, bool >   mResult = map.insert( node );
+      if( lResult.second != mResult.second || lResult.first->first != node.first
+          || lResult.first->second != mResult.first->second )
+        {
+        std::cerr << "Wrong insertion of " << node.first << std::endl;
+        return false;
+        }
+      }
+    if( !SameNodes( layer, map ) )
+      {
+      return false;
+      }
+
+    // erase the current node while iterating, as the update filters do
+    LayerType::iterator lIt = layer.begin();
+    const LayerType::iterator lEnd = layer.end();
+    while( lIt != lEnd )
+      {
+      LayerType::iterator tempIt = lIt;
+      ++lIt;
+      if( tempIt->second < 0.4 )
+        {
+        map.erase( tempIt->first );
+        layer.erase( tempIt );
+        }
+      else
+        {
+        tempIt->second += 1.0;
+        map[tempIt->first] += 1.0;
+        }
+      }
+    if( !SameNodes( layer, map ) )
+      {
+      return false;
+      }
+
+    // erase and look up by index
+    for( unsigned int i = 0; i < 500; ++i )
+      {
+      const IndexType index = RandomIndex();
+      if( layer.erase( index ) != map.erase( index ) )
+        {
+        std::cerr << "Wrong erasure of " << index << std::endl;
+        return false;
+        }
+      const IndexType other = RandomIndex();
+      const LayerType & constLayer = layer;
+      LayerType::const_iterator lFound = constLayer.find( other );
+      MapType::const_iterator   mFound = map.find( other );
+      if( ( lFound == constLayer.end() ) != ( mFound == map.end() ) || layer.count( other ) != map.count( other )
+          || ( mFound != map.end() && lFound->second != mFound->second ) )
+        {
+        std::cerr << "Wrong lookup of " << other << std::endl;
+        return false;
+        }
+      }
+    if( !SameNodes( layer, map ) )
+      {
+      return false;
+      }
+
+    // an insertion in a copy leaves the layer unchanged
+    LayerType copy = layer;
+    copy.insert( copy.end(), std::make_pair( RandomIndex(), 2.0 ) );
+    if( round % 2 == 1 )
+      {
+      layer.Squeeze();
+      }
+    if( !SameNodes( layer, map ) )
+      {
+      return false;
+      }
+    }
+
+  // nodes added at the end, in order
+  LayerType sorted;
+  MapType   sortedMap;
+  sorted.insert( map.begin(), map.end() );
+  for( MapType::const_iterator mIt = map.begin(); mIt != map.end(); ++mIt )
+    {
+    sortedMap.insert( sortedMap.end(), *mIt );
+    }
+  if( !SameNodes( sorted, sortedMap ) )
+    {
+    return false;
+    }
+
+  layer.clear();
+  map.clear();
+  return SameNodes( layer, map );
+}
+
+// Check that the threads get contiguous ranges which cover the layer.
+bool
+CheckPartitions( const LayerType & layer )
+{
+  typedef itk::ThreadedIteratorRangePartitioner< LayerType::const_iterator > PartitionerType;
+  PartitionerType::Pointer partitioner = PartitionerType::New();
+
+  PartitionerType::DomainType completeDomain( layer.begin(), layer.end() );
+  for( itk::ThreadIdType requested = 1; requested < 8; ++requested )
+    {
+    LayerType::const_iterator next = layer.begin();
+    PartitionerType::DomainType firstDomain;
+    const itk::ThreadIdType total = partitioner->PartitionDomain( 0, requested, completeDomain, firstDomain );
+    for( itk::ThreadIdType threadId = 0; threadId < total; ++threadId )
+      {
+      PartitionerType::DomainType subDomain;
+      partitioner->PartitionDomain( threadId, requested, completeDomain, subDomain );
+      if( subDomain.Begin() != next )
+        {
+        std::cerr << "The range of thread " << threadId << " of " << total << " is not contiguous" << std::endl;
+        return false;
+        }
+      next = subDomain.End();
+      }
+    if( next != layer.end() )
+      {
+      std::cerr << "The ranges of " << total << " threads do not cover the layer" << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+typedef unsigned short                          InputPixelType;
+typedef itk::Image< InputPixelType, Dimension > InputImageType;
+
+// A bright square on a dark background, with some noise.
+InputImageType::Pointer
+CreateInput()
+{
+  InputImageType::SizeType size;
+  size.Fill( 48 );
+  InputImageType::Pointer input = InputImageType::New();
+  input->SetRegions( size );
+  input->Allocate();
+
+  itk::ImageRegionIteratorWithIndex< InputImageType > it( input, input->GetLargestPossibleRegion() );
+  for( ; !it.IsAtEnd(); ++it )
+    {
+    const InputImageType::IndexType & index = it.GetIndex();
+    InputPixelType value = static_cast< InputPixelType >( Random( 20 ) );
+    if( index[0] >= 8 && index[0] < 30 && index[1] >= 12 && index[1] < 38 )
+      {
+      value += 100;
+      }
+    it.Set( value );
+    }
+  return input;
+}
+
+// Evolve a level set with the Chan and Vese terms.
+template< typename TLevelSet >
+typename TLevelSet::Pointer
+Evolve( InputImageType * input )
+{
+  typedef TLevelSet                                                      LevelSetType;
+  typedef typename LevelSetType::OutputRealType                          LevelSetOutputRealType;
+  typedef itk::IdentifierType                                            IdentifierType;
+  typedef itk::LevelSetContainer< IdentifierType, LevelSetType >         LevelSetContainerType;
+  typedef itk::BinaryImageToLevelSetImageAdaptor< InputImageType, LevelSetType >
+                                                                         BinaryToSparseAdaptorType;
+  typedef itk::LevelSetEquationChanAndVeseInternalTerm< InputImageType, LevelSetContainerType >
+                                                                         ChanAndVeseInternalTermType;
+  typedef itk::LevelSetEquationChanAndVeseExternalTerm< InputImageType, LevelSetContainerType >
+                                                                         ChanAndVeseExternalTermType;
+  typedef itk::LevelSetEquationTermContainer< InputImageType, LevelSetContainerType >
+                                                                         TermContainerType;
+  typedef itk::LevelSetEquationContainer< TermContainerType >            EquationContainerType;
+  typedef itk::LevelSetEvolution< EquationContainerType, LevelSetType >  LevelSetEvolutionType;
+  typedef itk::SinRegularizedHeavisideStepFunction< LevelSetOutputRealType, LevelSetOutputRealType >
+                                                                         HeavisideFunctionBaseType;
+  typedef itk::LevelSetEvolutionNumberOfIterationsStoppingCriterion< LevelSetContainerType >
+                                                                         StoppingCriterionType;
+
+  InputImageType::Pointer binary = InputImageType::New();
+  binary->SetRegions( input->GetLargestPossibleRegion() );
+  binary->Allocate();
+  binary->FillBuffer( itk::NumericTraits< InputPixelType >::ZeroValue() );
+  InputImageType::IndexType start;
+  start.Fill( 14 );
+  InputImageType::SizeType size;
+  size.Fill( 12 );
+  itk::ImageRegionIterator< InputImageType > bIt( binary, InputImageType::RegionType( start, size ) );
+  for( ; !bIt.IsAtEnd(); ++bIt )
+    {
+    bIt.Set( itk::NumericTraits< InputPixelType >::OneValue() );
+    }
+
+  typename BinaryToSparseAdaptorType::Pointer adaptor = BinaryToSparseAdaptorType::New();
+  adaptor->SetInputImage( binary );
+  adaptor->Initialize();
+  typename LevelSetType::Pointer levelSet = adaptor->GetModifiableLevelSet();
+
+  typename HeavisideFunctionBaseType::Pointer heaviside = HeavisideFunctionBaseType::New();
+  heaviside->SetEpsilon( 2.0 );
+
+  typename LevelSetContainerType::Pointer lscontainer = LevelSetContainerType::New();
+  lscontainer->SetHeaviside( heaviside );
+  lscontainer->AddLevelSet( 0, levelSet, false );
+
+  typename ChanAndVeseInternalTermType::Pointer cvInternalTerm = ChanAndVeseInternalTermType::New();
+  cvInternalTerm->SetInput( input );
+  cvInternalTerm->SetCoefficient( 1.0 );
+
+  typename ChanAndVeseExternalTermType::Pointer cvExternalTerm = ChanAndVeseExternalTermType::New();
+  cvExternalTerm->SetInput( input );
+  cvExternalTerm->SetCoefficient( 1.0 );
+
+  typename TermContainerType::Pointer termContainer = TermContainerType::New();
+  termContainer->SetInput( input );
+  termContainer->SetCurrentLevelSetId( 0 );
+  termContainer->SetLevelSetContainer( lscontainer );
+  termContainer->AddTerm( 0, cvInternalTerm );
+  termContainer->AddTerm( 1, cvExternalTerm );
+
+  typename EquationContainerType::Pointer equationContainer = EquationContainerType::New();
+  equationContainer->SetLevelSetContainer( lscontainer );
+  equationContainer->AddEquation( 0, termContainer );
+
+  typename StoppingCriterionType::Pointer criterion = StoppingCriterionType::New();
+  criterion->SetNumberOfIterations( 10 );
+
+  typename LevelSetEvolutionType::Pointer evolution = LevelSetEvolutionType::New();
+  evolution->SetEquationContainer( equationContainer );
+  evolution->SetStoppingCriterion( criterion );
+  evolution->SetLevelSetContainer( lscontainer );
+  evolution->Update();
+
+  return levelSet;
+}
+
+// Compare Evaluate with the value found in std::map copies of the layers,
+// or the status of the node out of the layers.
+template< typename TLevelSet >
+bool
+CheckEvaluate( const InputImageType * input, TLevelSet * levelSet, const char * name )
+{
+  typedef typename TLevelSet::InputType  LevelSetInputType;
+  typedef typename TLevelSet::OutputType LevelSetOutputType;
+  typedef std::map< LevelSetInputType, LevelSetOutputType, CompareType > LevelSetMapType;
+  typedef std::map< typename TLevelSet::LayerIdType, LevelSetMapType >   LevelSetMapsType;
+
+  LevelSetMapsType maps;
+  const typename TLevelSet::LayerIdType layerIds[] = { -2, -1, 0, 1, 2 };
+  for( unsigned int l = 0; l < 5; ++l )
+    {
+    try
+      {
+      const typename TLevelSet::LayerType & layer = levelSet->GetLayer( layerIds[l] );
+      maps[layerIds[l]].insert( layer.begin(), layer.end() );
+      }
+    catch( itk::ExceptionObject & )
+      {
+      // not a layer of this level set
+      }
+    }
+
+  // with the label image, then with the label map only
+  for( unsigned int pass = 0; pass < 2; ++pass )
+    {
+    if( pass == 1 )
+      {
+      levelSet->SetLabelMap( levelSet->GetModifiableLabelMap() );
+      }
+    itk::ImageRegionConstIteratorWithIndex< InputImageType > it( input, input->GetLargestPossibleRegion() );
+    for( ; !it.IsAtEnd(); ++it )
+      {
+      const LevelSetInputType index = it.GetIndex();
+      LevelSetOutputType expected = static_cast< LevelSetOutputType >( levelSet->Status( index ) );
+      for( typename LevelSetMapsType::const_iterator mIt = maps.begin(); mIt != maps.end(); ++mIt )
+        {
+        typename LevelSetMapType::const_iterator found = mIt->second.find( index );
+        if( found != mIt->second.end() )
+          {
+          expected = found->second;
+          }
+        }
+      if( levelSet->Evaluate( index ) != expected )
+        {
+        std::cerr << name << ": Evaluate( " << index << " ) is " << levelSet->Evaluate( index )
+                  << " instead of " << expected << ( pass == 0 ? " with" : " without" )
+                  << " the label image" << std::endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+int itkLevelSetSparseLayerTest( int, char* [] )
+{
+  TEST_EXPECT_TRUE( CheckLayerOperations() );
+
+  LayerType layer;
+  for( unsigned int i = 0; i < 2000; ++i )
+    {
+    layer.insert( std::make_pair( RandomIndex(), 0.0 ) );
+    }
+  TEST_EXPECT_TRUE( CheckPartitions( layer ) );
+  unsigned int n = 0;
+  for( LayerType::iterator it = layer.begin(); it != layer.end(); ++n )
+    {
+    LayerType::iterator tempIt = it;
+    ++it;
+    if( n % 3 == 0 )
+      {
+      layer.erase( tempIt );
+      }
+    }
+  TEST_EXPECT_TRUE( CheckPartitions( layer ) );
+
+  InputImageType::Pointer input = CreateInput();
+
+  typedef itk::WhitakerSparseLevelSetImage< double, Dimension > WhitakerLevelSetType;
+  typedef itk::ShiSparseLevelSetImage< Dimension >              ShiLevelSetType;
+  typedef itk::MalcolmSparseLevelSetImage< Dimension >          MalcolmLevelSetType;
+
+  WhitakerLevelSetType::Pointer whitaker = Evolve< WhitakerLevelSetType >( input );
+  TEST_EXPECT_TRUE( CheckEvaluate< WhitakerLevelSetType >( input, whitaker, "Whitaker" ) );
+  ShiLevelSetType::Pointer shi = Evolve< ShiLevelSetType >( input );
+  TEST_EXPECT_TRUE( CheckEvaluate< ShiLevelSetType >( input, shi, "Shi" ) );
+  MalcolmLevelSetType::Pointer malcolm = Evolve< MalcolmLevelSetType >( input );
+  TEST_EXPECT_TRUE( CheckEvaluate< MalcolmLevelSetType >( input, malcolm, "Malcolm" ) );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,267 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWhitakerSparseLevelSetImage.h"
+#include "itkShiSparseLevelSetImage.h"
+#include "itkMalcolmSparseLevelSetImage.h"
+#include "itkLevelSetContainer.h"
+#include "itkLevelSetEquationChanAndVeseInternalTerm.h"
+#include "itkLevelSetEquationChanAndVeseExternalTerm.h"
+#include "itkLevelSetEquationTermContainer.h"
+#include "itkLevelSetEquationContainer.h"
+#include "itkLevelSetEvolution.h"
+#include "itkLevelSetEvolutionNumberOfIterationsStoppingCriterion.h"
+#include "itkBinaryImageToLevelSetImageAdaptor.h"
+#include "itkSinRegularizedHeavisideStepFunction.h"
+#include "itkLevelSetDomainMapImageFilter.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+const unsigned int Dimension = 2;
+
+typedef unsigned short                          InputPixelType;
+typedef itk::Image< InputPixelType, Dimension > InputImageType;
+typedef itk::Image< float, Dimension >          OutputImageType;
+
+// The input: two bright squares on a dark background, with some noise.
+InputImageType::Pointer
+CreateInput()
+{
+  InputImageType::SizeType size;
+  size.Fill( 64 );
+  InputImageType::Pointer input = InputImageType::New();
+  input->SetRegions( size );
+  input->Allocate();
+
+  unsigned int seed = 7;
+  itk::ImageRegionIteratorWithIndex< InputImageType > it( input, input->GetLargestPossibleRegion() );
+  for( ; !it.IsAtEnd(); ++it )
+    {
+    seed = seed * 1103515245u + 12345u;
+    const InputImageType::IndexType & index = it.GetIndex();
+    InputPixelType value = static_cast< InputPixelType >( ( seed >> 16 ) % 20 );
+    if( ( index[0] >= 8 && index[0] < 28 && index[1] >= 10 && index[1] < 34 ) ||
+        ( index[0] >= 36 && index[0] < 56 && index[1] >= 30 && index[1] < 52 ) )
+      {
+      value += 100;
+      }
+    it.Set( value );
+    }
+  return input;
+}
+
+// A binary square.
+InputImageType::Pointer
+CreateBinary( const InputImageType * input, itk::IndexValueType start, itk::SizeValueType length )
+{
+  InputImageType::Pointer binary = InputImageType::New();
+  binary->SetRegions( input->GetLargestPossibleRegion() );
+  binary->CopyInformation( input );
+  binary->Allocate();
+  binary->FillBuffer( itk::NumericTraits< InputPixelType >::ZeroValue() );
+
+  InputImageType::RegionType region;
+  InputImageType::IndexType index;
+  index.Fill( start );
+  InputImageType::SizeType size;
+  size.Fill( length );
+  region.SetIndex( index );
+  region.SetSize( size );
+
+  itk::ImageRegionIterator< InputImageType > it( binary, region );
+  for( ; !it.IsAtEnd(); ++it )
+    {
+    it.Set( itk::NumericTraits< InputPixelType >::OneValue() );
+    }
+  return binary;
+}
+
+// Evolve two level sets with the Chan and Vese terms, and return the values
+// of both level sets side by side.
+template< typename TLevelSet >
+OutputImageType::Pointer
+Evolve( InputImageType * input, itk::ThreadIdType numberOfThreads, bool concurrently )
+{
+  typedef TLevelSet                                                      LevelSetType;
+  typedef typename LevelSetType::OutputRealType                          LevelSetOutputRealType;
+  typedef itk::IdentifierType                                            IdentifierType;
+  typedef itk::LevelSetContainer< IdentifierType, LevelSetType >         LevelSetContainerType;
+  typedef itk::BinaryImageToLevelSetImageAdaptor< InputImageType, LevelSetType >
+                                                                         BinaryToSparseAdaptorType;
+  typedef itk::LevelSetEquationChanAndVeseInternalTerm< InputImageType, LevelSetContainerType >
+                                                                         ChanAndVeseInternalTermType;
+  typedef itk::LevelSetEquationChanAndVeseExternalTerm< InputImageType, LevelSetContainerType >
+                                                                         ChanAndVeseExternalTermType;
+  typedef itk::LevelSetEquationTermContainer< InputImageType, LevelSetContainerType >
+                                                                         TermContainerType;
+  typedef itk::LevelSetEquationContainer< TermContainerType >            EquationContainerType;
+  typedef itk::LevelSetEvolution< EquationContainerType, LevelSetType >  LevelSetEvolutionType;
+  typedef itk::SinRegularizedHeavisideStepFunction< LevelSetOutputRealType, LevelSetOutputRealType >
+                                                                         HeavisideFunctionBaseType;
+  typedef std::list< IdentifierType >                                    IdListType;
+  typedef itk::Image< IdListType, Dimension >                            IdListImageType;
+  typedef itk::Image< short, Dimension >                                 CacheImageType;
+  typedef itk::LevelSetDomainMapImageFilter< IdListImageType, CacheImageType >
+                                                                         DomainMapImageFilterType;
+  typedef itk::LevelSetEvolutionNumberOfIterationsStoppingCriterion< LevelSetContainerType >
+                                                                         StoppingCriterionType;
+
+  typename BinaryToSparseAdaptorType::Pointer adaptor0 = BinaryToSparseAdaptorType::New();
+  adaptor0->SetInputImage( CreateBinary( input, 12, 14 ) );
+  adaptor0->Initialize();
+  typename LevelSetType::Pointer levelSet0 = adaptor0->GetModifiableLevelSet();
+
+  typename BinaryToSparseAdaptorType::Pointer adaptor1 = BinaryToSparseAdaptorType::New();
+  adaptor1->SetInputImage( CreateBinary( input, 30, 20 ) );
+  adaptor1->Initialize();
+  typename LevelSetType::Pointer levelSet1 = adaptor1->GetModifiableLevelSet();
+
+  IdListType listIds;
+  listIds.push_back( 1 );
+  listIds.push_back( 2 );
+
+  typename IdListImageType::Pointer idImage = IdListImageType::New();
+  idImage->SetRegions( input->GetLargestPossibleRegion() );
+  idImage->Allocate();
+  idImage->FillBuffer( listIds );
+
+  typename DomainMapImageFilterType::Pointer domainMapFilter = DomainMapImageFilterType::New();
+  domainMapFilter->SetInput( idImage );
+  domainMapFilter->Update();
+
+  typename HeavisideFunctionBaseType::Pointer heaviside = HeavisideFunctionBaseType::New();
+  heaviside->SetEpsilon( 2.0 );
+
+  typename LevelSetContainerType::Pointer lscontainer = LevelSetContainerType::New();
+  lscontainer->SetHeaviside( heaviside );
+  lscontainer->SetDomainMapFilter( domainMapFilter );
+  lscontainer->AddLevelSet( 0, levelSet0, false );
+  lscontainer->AddLevelSet( 1, levelSet1, false );
+
+  typename EquationContainerType::Pointer equationContainer = EquationContainerType::New();
+  equationContainer->SetLevelSetContainer( lscontainer );
+  for( IdentifierType id = 0; id < 2; ++id )
+    {
+    typename ChanAndVeseInternalTermType::Pointer cvInternalTerm = ChanAndVeseInternalTermType::New();
+    cvInternalTerm->SetInput( input );
+    cvInternalTerm->SetCoefficient( 1.0 );
+
+    typename ChanAndVeseExternalTermType::Pointer cvExternalTerm = ChanAndVeseExternalTermType::New();
+    cvExternalTerm->SetInput( input );
+    cvExternalTerm->SetCoefficient( 1.0 );
+
+    typename TermContainerType::Pointer termContainer = TermContainerType::New();
+    termContainer->SetInput( input );
+    termContainer->SetCurrentLevelSetId( id );
+    termContainer->SetLevelSetContainer( lscontainer );
+    termContainer->AddTerm( 0, cvInternalTerm );
+    termContainer->AddTerm( 1, cvExternalTerm );
+
+    equationContainer->AddEquation( id, termContainer );
+    }
+
+  typename StoppingCriterionType::Pointer criterion = StoppingCriterionType::New();
+  criterion->SetNumberOfIterations( 15 );
+
+  typename LevelSetEvolutionType::Pointer evolution = LevelSetEvolutionType::New();
+  evolution->SetEquationContainer( equationContainer );
+  evolution->SetStoppingCriterion( criterion );
+  evolution->SetLevelSetContainer( lscontainer );
+  evolution->SetNumberOfThreads( numberOfThreads );
+  evolution->SetUpdateLevelSetsConcurrently( concurrently );
+  evolution->Update();
+
+  OutputImageType::SizeType size = input->GetLargestPossibleRegion().GetSize();
+  size[0] *= 2;
+  OutputImageType::Pointer output = OutputImageType::New();
+  output->SetRegions( size );
+  output->Allocate();
+
+  itk::ImageRegionIteratorWithIndex< InputImageType > it( input, input->GetLargestPossibleRegion() );
+  for( ; !it.IsAtEnd(); ++it )
+    {
+    OutputImageType::IndexType index = it.GetIndex();
+    output->SetPixel( index, static_cast< float >( levelSet0->Evaluate( it.GetIndex() ) ) );
+    index[0] += input->GetLargestPossibleRegion().GetSize()[0];
+    output->SetPixel( index, static_cast< float >( levelSet1->Evaluate( it.GetIndex() ) ) );
+    }
+  return output;
+}
+
+bool
+SameImages( const OutputImageType * image1, const OutputImageType * image2 )
+{
+  itk::ImageRegionConstIterator< OutputImageType > it1( image1, image1->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< OutputImageType > it2( image2, image2->GetLargestPossibleRegion() );
+  for( ; !it1.IsAtEnd(); ++it1, ++it2 )
+    {
+    if( it1.Get() != it2.Get() )
+      {
+      std::cerr << "The level sets differ at " << it1.GetIndex() << ": "
+                << it1.Get() << " and " << it2.Get() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+// Check that the evolution of the level sets, one after the other or
+// concurrently, does not depend on the number of threads.
+template< typename TLevelSet >
+bool
+CheckThreads( InputImageType * input, const char * name )
+{
+  for( unsigned int concurrently = 0; concurrently < 2; ++concurrently )
+    {
+    OutputImageType::Pointer reference = Evolve< TLevelSet >( input, 1, concurrently );
+    const itk::ThreadIdType numberOfThreads[] = { 2, 5 };
+    for( unsigned int t = 0; t < 2; ++t )
+      {
+      OutputImageType::Pointer output = Evolve< TLevelSet >( input, numberOfThreads[t], concurrently );
+      if( !SameImages( reference, output ) )
+        {
+        std::cerr << name << ", concurrently: " << concurrently
+                  << ", threads: " << numberOfThreads[t] << std::endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+}
+
+int itkMultiLevelSetSparseEvolutionThreadsTest( int, char* [] )
+{
+  InputImageType::Pointer input = CreateInput();
+
+  typedef itk::WhitakerSparseLevelSetImage< double, Dimension > WhitakerLevelSetType;
+  typedef itk::ShiSparseLevelSetImage< Dimension >              ShiLevelSetType;
+  typedef itk::MalcolmSparseLevelSetImage< Dimension >          MalcolmLevelSetType;
+
+  bool success = true;
+  TRY_EXPECT_NO_EXCEPTION( success = CheckThreads< WhitakerLevelSetType >( input, "Whitaker" ) );
+  TEST_EXPECT_TRUE( success );
+  TRY_EXPECT_NO_EXCEPTION( success = CheckThreads< ShiLevelSetType >( input, "Shi" ) );
+  TEST_EXPECT_TRUE( success );
+  TRY_EXPECT_NO_EXCEPTION( success = CheckThreads< MalcolmLevelSetType >( input, "Malcolm" ) );
+  TEST_EXPECT_TRUE( success );
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -19,6 +19,11 @@
 #define itkMorphologicalWatershedFromMarkersImageFilter_h
 
 #include "itkImageToImageFilter.h"
+#include "itkMultiThreader.h"
+#include "itkAtomicInt.h"
+#include <map>
+#include <queue>
+#include <vector>
 
 namespace itk
 {
@@ -60,6 +65,28 @@ namespace itk
  * the markers. The labels of the output image are the label of the marker
  * image.
  *
+ * The pixels are flooded in the order of their values with a hierarchical
+ * queue. For the 8 and 16 bits integer pixel types, the queue is a
+ * BucketPriorityQueue with a bucket per value, which adds and removes a
+ * pixel in a constant time.
+ *
+ * When a TileSize is given, the image is divided in tiles which are flooded
+ * in parallel. Each tile is flooded with its markers and with the pixels
+ * around it, which are flooded at the levels and with the labels found by
+ * the neighbor tiles. The tiles are flooded again until the borders of the
+ * tiles no longer change, and only the tiles whose neighbors changed are
+ * flooded again. The output is then the same as the one computed at once,
+ * except where several markers reach the same pixel at the same level: a
+ * pixel of a plateau may then be given another of these labels. The number
+ * of rounds is bounded by MaximumNumberOfTileRounds, because the labels of
+ * a plateau could be exchanged forever between the tiles: when the bound is
+ * reached before the borders are stable, a warning is emitted and the whole
+ * image is flooded at once, so that the output is always a watershed of the
+ * input. The output
+ * requested region is not enlarged in this mode, and only the tiles which
+ * intersect it are written to the output; the borders of all the tiles are
+ * kept, instead of a whole label image.
+ *
  * The morphological watershed transform algorithm is described in
  * Chapter 9.2 of Pierre Soille's book "Morphological Image Analysis:
  * Principles and Applications", Second Edition, Springer, 2003.
@@ -101,6 +128,7 @@ public:
   typedef typename LabelImageType::PixelType    LabelImagePixelType;
 
   typedef typename LabelImageType::IndexType IndexType;
+  typedef typename LabelImageType::SizeType  SizeType;
 
   /** ImageDimension constants */
   itkStaticConstMacro(ImageDimension, unsigned int,
@@ -157,6 +185,27 @@ public:
   itkGetConstReferenceMacro(MarkWatershedLine, bool);
   itkBooleanMacro(MarkWatershedLine);
 
+  /**
+   * Set/Get the size of the tiles flooded in parallel. An axis with a 0
+   * size is not divided. Default is 0 along all the axes: the image is
+   * flooded at once, by a single thread.
+   */
+  itkSetMacro(TileSize, SizeType);
+  itkGetConstReferenceMacro(TileSize, SizeType);
+
+  /** Get the number of times the tiles have been flooded, before the last
+   * flooding of the tiles of the output, by the last update in the tiled
+   * mode. */
+  itkGetConstMacro(NumberOfTileRounds, SizeValueType);
+
+  /**
+   * Set/Get the maximum number of times the tiles are flooded before the
+   * image is flooded at once. Default is 0: twice the number of tiles,
+   * plus 2.
+   */
+  itkSetMacro(MaximumNumberOfTileRounds, SizeValueType);
+  itkGetConstMacro(MaximumNumberOfTileRounds, SizeValueType);
+
 protected:
   MorphologicalWatershedFromMarkersImageFilter();
   ~MorphologicalWatershedFromMarkersImageFilter() {}
@@ -168,19 +217,151 @@ protected:
   void GenerateInputRequestedRegion() ITK_OVERRIDE;
 
   /** This filter will enlarge the output requested region to produce
-   * all of the output.
+   * all of the output, unless the image is flooded by tiles.
    * \sa ProcessObject::EnlargeOutputRequestedRegion() */
   void EnlargeOutputRequestedRegion( DataObject *itkNotUsed(output) ) ITK_OVERRIDE;
 
-  /** The filter is single threaded. */
+  /** The filter is single threaded, unless a tile size is given. */
   void GenerateData() ITK_OVERRIDE;
 
 private:
   ITK_DISALLOW_COPY_AND_ASSIGN(MorphologicalWatershedFromMarkersImageFilter);
 
+  /** Flood the input with the given hierarchical queue of pixels. */
+  template< typename TQueue >
+  void GenerateDataWithQueue( TQueue & fah );
+
+  typedef typename LabelImageType::OffsetValueType OffsetValueType;
+
+  /** The label of a pixel on the border of a tile, and the level at which
+   * it has been flooded. */
+  struct TileBorderPixel
+  {
+    LabelImagePixelType m_Label;
+    InputImagePixelType m_Level;
+
+    bool operator==(const TileBorderPixel & other) const
+    {
+      return m_Label == other.m_Label && m_Level == other.m_Level;
+    }
+  };
+  typedef std::vector< TileBorderPixel > TileBorderType;
+
+  template< typename TQueue >
+  struct TileThreadStruct
+  {
+    Self *         Filter;
+    const TQueue * Queue;
+  };
+
+  bool IsTiled() const;
+
+  /** Flood the tiles until their borders no longer change, then flood the
+   * tiles of the output requested region. The queue is copied by each
+   * thread. */
+  template< typename TQueue >
+  void GenerateDataByTiles( const TQueue & fah );
+
+  template< typename TQueue >
+  static ITK_THREAD_RETURN_TYPE FloodTilesThreaderCallback(void *arg);
+
+  /** Flood a tile and the pixels around it, in buffers of the tile padded
+   * by one pixel, and store the new border of the tile. */
+  template< typename TQueue >
+  void FloodTile( SizeValueType tile, TQueue & fah,
+                  std::vector< LabelImagePixelType > & labels,
+                  std::vector< InputImagePixelType > & values,
+                  std::vector< InputImagePixelType > & levels,
+                  std::vector< unsigned char > & status );
+
+  LabelImageRegionType GetTileRegion( SizeValueType tile ) const;
+
+  /** Get the tile of a pixel of the image. */
+  SizeValueType GetTileOfIndex( const IndexType & idx ) const;
+
+  /** Get the position of a pixel in the border of a tile. */
+  SizeValueType GetTileBorderOffset( const LabelImageRegionType & tileRegion, unsigned int face,
+                                     const IndexType & idx ) const;
+
+  /** Hierarchical queue with a queue of pixels per value, for the pixel
+   * types which can't index a BucketPriorityQueue. The pixels added below
+   * the current value are added to the current value. */
+  template< typename TElement >
+  class HierarchicalQueue
+  {
+  public:
+    HierarchicalQueue() :
+      m_Current( NumericTraits< InputImagePixelType >::NonpositiveMin() ),
+      m_Size( 0 )
+    {}
+
+    void Push( const TElement & idx, const InputImagePixelType & value )
+    {
+      m_Queues[ value < m_Current ? m_Current : value ].push( idx );
+      ++m_Size;
+    }
+
+    const TElement & Front()
+    {
+      while ( m_Queues.begin()->second.empty() )
+        {
+        m_Queues.erase( m_Queues.begin() );
+        }
+      m_Current = m_Queues.begin()->first;
+      return m_Queues.begin()->second.front();
+    }
+
+    void Pop()
+    {
+      this->Front();
+      m_Queues.begin()->second.pop();
+      --m_Size;
+    }
+
+    InputImagePixelType GetFrontPriority()
+    {
+      this->Front();
+      return m_Current;
+    }
+
+    bool Empty() const
+    {
+      return m_Size == 0;
+    }
+
+    void Clear()
+    {
+      m_Queues.clear();
+      m_Current = NumericTraits< InputImagePixelType >::NonpositiveMin();
+      m_Size = 0;
+    }
+
+  private:
+    typedef std::map< InputImagePixelType, std::queue< TElement > > MapType;
+
+    MapType             m_Queues;
+    InputImagePixelType m_Current;
+    SizeValueType       m_Size;
+  };
+
   bool m_FullyConnected;
 
   bool m_MarkWatershedLine;
+
+  SizeType      m_TileSize;
+  SizeValueType m_NumberOfTileRounds;
+  SizeValueType m_MaximumNumberOfTileRounds;
+
+  // the tiles of the image, and their borders in the last round and the
+  // current one
+  LabelImageRegionType          m_TiledRegion;
+  SizeType                      m_NumberOfTiles;
+  SizeType                      m_TileStrides;
+  std::vector< TileBorderType > m_TileBorders;
+  std::vector< TileBorderType > m_NewTileBorders;
+  std::vector< SizeValueType >  m_TilesToFlood;
+  AtomicInt< SizeValueType >    m_NextTile;
+  bool                          m_WriteTiles;
 }; // end of class
 } // end namespace itk
 
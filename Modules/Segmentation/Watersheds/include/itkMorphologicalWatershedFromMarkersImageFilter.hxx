@@ -24,11 +24,14 @@
 #include "itkMorphologicalWatershedFromMarkersImageFilter.h"
 #include "itkProgressReporter.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkConstShapedNeighborhoodIterator.h"
 #include "itkConstantBoundaryCondition.h"
 #include "itkSize.h"
 #include "itkConnectedComponentAlgorithm.h"
+#include "itkBucketPriorityQueue.h"
+#include "itkImageAlgorithm.h"
 
 namespace itk
 {
@@ -37,10 +40,15 @@ template< typename TInputImage, typename TLabelImage >
 MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
 ::MorphologicalWatershedFromMarkersImageFilter():
   m_FullyConnected( false ),
-  m_MarkWatershedLine( true )
-
+  m_MarkWatershedLine( true ),
+  m_NumberOfTileRounds( 0 ),
+  m_MaximumNumberOfTileRounds( 0 ),
+  m_WriteTiles( false )
 {
   this->SetNumberOfRequiredInputs(2);
+  m_TileSize.Fill(0);
+  m_NumberOfTiles.Fill(0);
+  m_TileStrides.Fill(0);
 }
 
 
@@ -77,15 +85,77 @@ void
 MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
 ::EnlargeOutputRequestedRegion(DataObject *)
 {
+  // the tiles of the requested region can be flooded alone
+  if ( this->IsTiled() )
+    {
+    return;
+    }
   LabelImageType * output = this->GetOutput();
   output->SetRequestedRegion( output->GetLargestPossibleRegion() );
 }
 
 
+template< typename TInputImage, typename TLabelImage >
+bool
+MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
+::IsTiled() const
+{
+  for ( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    if ( m_TileSize[i] != 0 )
+      {
+      return true;
+      }
+    }
+  return false;
+}
+
+
 template< typename TInputImage, typename TLabelImage >
 void
 MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
 ::GenerateData()
+{
+  // the pixels of the small integer types are flooded with a queue indexed
+  // by their values, the other ones with a map of queues. Both process the
+  // pixels in the same order.
+  if ( NumericTraits< InputImagePixelType >::is_integer && sizeof( InputImagePixelType ) <= 2 )
+    {
+    const SizeValueType numberOfValues = static_cast< SizeValueType >(
+      static_cast< OffsetValueType >( NumericTraits< InputImagePixelType >::max() )
+      - static_cast< OffsetValueType >( NumericTraits< InputImagePixelType >::NonpositiveMin() ) + 1 );
+    if ( this->IsTiled() )
+      {
+      BucketPriorityQueue< OffsetValueType, InputImagePixelType > fah( 1.0, numberOfValues );
+      this->GenerateDataByTiles( fah );
+      }
+    else
+      {
+      BucketPriorityQueue< IndexType, InputImagePixelType > fah( 1.0, numberOfValues );
+      this->GenerateDataWithQueue( fah );
+      }
+    }
+  else
+    {
+    if ( this->IsTiled() )
+      {
+      HierarchicalQueue< OffsetValueType > fah;
+      this->GenerateDataByTiles( fah );
+      }
+    else
+      {
+      HierarchicalQueue< IndexType > fah;
+      this->GenerateDataWithQueue( fah );
+      }
+    }
+}
+
+
+template< typename TInputImage, typename TLabelImage >
+template< typename TQueue >
+void
+MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
+::GenerateDataWithQueue( TQueue & fah )
 {
   // there is 2 possible cases: with or without watershed lines.
   // the algorithm with watershed lines is from Meyer
@@ -122,10 +192,7 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
     itkExceptionMacro(<< "Marker and input must have the same size.");
     }
 
-  // FAH (in french: File d'Attente Hierarchique)
-  typedef std::queue< IndexType >                    QueueType;
-  typedef std::map< InputImagePixelType, QueueType > MapType;
-  MapType fah;
+  // fah is the FAH (in french: File d'Attente Hierarchique)
 
   // the radius which will be used for all the shaped iterators
   Size< ImageDimension > radius;
@@ -230,8 +297,8 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
             {
             // this neighbor is a background pixel and is not already
             // processed; add its index to fah
-            fah[niIt.Get()].push( markerIt.GetIndex()
-                                  + nmIt.GetNeighborhoodOffset() );
+            fah.Push( markerIt.GetIndex() + nmIt.GetNeighborhoodOffset(),
+                      niIt.Get() );
             // mark it as already in the fah to avoid adding it several times
             nsIt.Set(true);
             }
@@ -261,74 +328,59 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
     inputIt.GoToBegin();
 
     // and start flooding
-    while ( !fah.empty() )
+    while ( !fah.Empty() )
       {
-      // store the current vars
-      InputImagePixelType currentValue = fah.begin()->first;
-      QueueType           currentQueue = fah.begin()->second;
-      // and remove them from the fah
-      fah.erase( fah.begin() );
-
-      while ( !currentQueue.empty() )
-        {
-        IndexType idx = currentQueue.front();
-        currentQueue.pop();
+      // the pixels of a level are processed in the order in which they have
+      // been added to the fah, including the ones added while processing
+      // the level, and the ones below the level
+      IndexType idx = fah.Front();
+      fah.Pop();
 
-        // move the iterators to the right place
-        OffsetType shift = idx - outputIt.GetIndex();
-        outputIt += shift;
-        statusIt += shift;
-        inputIt += shift;
+      // move the iterators to the right place
+      OffsetType shift = idx - outputIt.GetIndex();
+      outputIt += shift;
+      statusIt += shift;
+      inputIt += shift;
 
-        // iterate over the neighbors. If there is only one marker value, give
-        // that value to the pixel, else keep it as is (watershed line)
-        LabelImagePixelType marker = wsLabel;
-        bool                collision = false;
-        for ( noIt = outputIt.Begin(); noIt != outputIt.End(); noIt++ )
+      // iterate over the neighbors. If there is only one marker value, give
+      // that value to the pixel, else keep it as is (watershed line)
+      LabelImagePixelType marker = wsLabel;
+      bool                collision = false;
+      for ( noIt = outputIt.Begin(); noIt != outputIt.End(); noIt++ )
+        {
+        LabelImagePixelType o = noIt.Get();
+        if ( o != wsLabel )
           {
-          LabelImagePixelType o = noIt.Get();
-          if ( o != wsLabel )
+          if ( marker != wsLabel && o != marker )
             {
-            if ( marker != wsLabel && o != marker )
-              {
-              collision = true;
-              break;
-              }
-            else
-                  { marker = o; }
+            collision = true;
+            break;
             }
+          else
+                { marker = o; }
           }
-        if ( !collision )
+        }
+      if ( !collision )
+        {
+        // set the marker value
+        outputIt.SetCenterPixel(marker);
+        // and propagate to the neighbors
+        for ( niIt = inputIt.Begin(), nsIt = statusIt.Begin();
+              niIt != inputIt.End();
+              niIt++, nsIt++ )
           {
-          // set the marker value
-          outputIt.SetCenterPixel(marker);
-          // and propagate to the neighbors
-          for ( niIt = inputIt.Begin(), nsIt = statusIt.Begin();
-                niIt != inputIt.End();
-                niIt++, nsIt++ )
+          if ( !nsIt.Get() )
             {
-            if ( !nsIt.Get() )
-              {
-              // the pixel is not yet processed. add it to the fah
-              InputImagePixelType GrayVal = niIt.Get();
-              if ( GrayVal <= currentValue )
-                {
-                currentQueue.push( inputIt.GetIndex()
-                                   + niIt.GetNeighborhoodOffset() );
-                }
-              else
-                {
-                fah[GrayVal].push( inputIt.GetIndex()
-                                   + niIt.GetNeighborhoodOffset() );
-                }
-              // mark it as already in the fah
-              nsIt.Set(true);
-              }
+            // the pixel is not yet processed. add it to the fah
+            fah.Push( inputIt.GetIndex() + niIt.GetNeighborhoodOffset(),
+                      niIt.Get() );
+            // mark it as already in the fah
+            nsIt.Set(true);
             }
           }
-        // one more pixel in the flooding stage
-        progress.CompletedPixel();
         }
+      // one more pixel in the flooding stage
+      progress.CompletedPixel();
       }
     }
 
@@ -375,7 +427,7 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
         if ( haveBgNeighbor )
           {
           // there is a background pixel in the neighborhood; add to fah
-          fah[inputIt.GetCenterPixel()].push( markerIt.GetIndex() );
+          fah.Push( markerIt.GetIndex(), inputIt.GetCenterPixel() );
           }
         else
           {
@@ -398,53 +450,617 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
     inputIt.GoToBegin();
 
     // and start flooding
-    while ( !fah.empty() )
+    while ( !fah.Empty() )
       {
-      // store the current vars
-      InputImagePixelType currentValue = fah.begin()->first;
-      QueueType           currentQueue = fah.begin()->second;
-      // and remove them from the fah
-      fah.erase( fah.begin() );
+      // the pixels of a level are processed in the order in which they have
+      // been added to the fah, including the ones added while processing
+      // the level, and the ones below the level
+      IndexType idx = fah.Front();
+      fah.Pop();
+
+      // move the iterators to the right place
+      OffsetType shift = idx - outputIt.GetIndex();
+      outputIt += shift;
+      inputIt += shift;
 
-      while ( !currentQueue.empty() )
+      LabelImagePixelType currentMarker = outputIt.GetCenterPixel();
+      // get the current value of the pixel
+      // iterate over neighbors to propagate the marker
+      for ( noIt = outputIt.Begin(), niIt = inputIt.Begin();
+            noIt != outputIt.End();
+            noIt++, niIt++ )
         {
-        IndexType idx = currentQueue.front();
-        currentQueue.pop();
+        if ( noIt.Get() == wsLabel )
+          {
+          // the pixel is not yet processed. It can be labeled with the
+          // current label
+          noIt.Set(currentMarker);
+          fah.Push( inputIt.GetIndex() + noIt.GetNeighborhoodOffset(),
+                    niIt.Get() );
+          progress.CompletedPixel();
+          }
+        }
+      }
+    }
+}
 
-        // move the iterators to the right place
-        OffsetType shift = idx - outputIt.GetIndex();
-        outputIt += shift;
-        inputIt += shift;
 
-        LabelImagePixelType currentMarker = outputIt.GetCenterPixel();
-        // get the current value of the pixel
-        // iterate over neighbors to propagate the marker
-        for ( noIt = outputIt.Begin(), niIt = inputIt.Begin();
-              noIt != outputIt.End();
-              noIt++, niIt++ )
+template< typename TInputImage, typename TLabelImage >
+template< typename TQueue >
+void
+MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
+::GenerateDataByTiles( const TQueue & fah )
+{
+  this->AllocateOutputs();
+
+  const LabelImageType * markerImage = this->GetMarkerImage();
+  const InputImageType * inputImage = this->GetInput();
+
+  // mask and marker must have the same size
+  if ( markerImage->GetRequestedRegion().GetSize() != inputImage->GetRequestedRegion().GetSize() )
+    {
+    itkExceptionMacro(<< "Marker and input must have the same size.");
+    }
+
+  // divide the image in tiles
+  m_TiledRegion = markerImage->GetRequestedRegion();
+  SizeValueType numberOfTiles = 1;
+  for ( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    const SizeValueType size = m_TiledRegion.GetSize()[i];
+    const SizeValueType tileSize = ( m_TileSize[i] != 0 ) ? m_TileSize[i] : size;
+    m_NumberOfTiles[i] = ( size + tileSize - 1 ) / tileSize;
+    m_TileStrides[i] = numberOfTiles;
+    numberOfTiles *= m_NumberOfTiles[i];
+    }
+
+  // the borders are not flooded before the first round
+  TileBorderPixel notFlooded;
+  notFlooded.m_Label = NumericTraits< LabelImagePixelType >::ZeroValue();
+  notFlooded.m_Level = NumericTraits< InputImagePixelType >::max();
+  m_TileBorders.resize(numberOfTiles);
+  m_NewTileBorders.resize(numberOfTiles);
+  for ( SizeValueType tile = 0; tile < numberOfTiles; tile++ )
+    {
+    const LabelImageRegionType tileRegion = this->GetTileRegion(tile);
+    const SizeValueType        borderSize = this->GetTileBorderOffset( tileRegion, 2 * ImageDimension,
+                                                                       tileRegion.GetIndex() );
+    m_TileBorders[tile].assign(borderSize, notFlooded);
+    m_NewTileBorders[tile].assign(borderSize, notFlooded);
+    }
+
+  TileThreadStruct< TQueue > str;
+  str.Filter = this;
+  str.Queue = &fah;
+  MultiThreader *multithreader = this->GetMultiThreader();
+  multithreader->SetSingleMethod(&Self::template FloodTilesThreaderCallback< TQueue >, &str);
+
+  // A tile flooded with the same borders around it gives the same result,
+  // so only the tiles whose neighbors changed are flooded again. All the
+  // tiles of a round read the borders of the previous round, so that the
+  // result does not depend on the number of threads. The number of rounds
+  // is bounded for the plateaus where the labels could be exchanged
+  // forever.
+  std::vector< unsigned char > toFlood(numberOfTiles, 1);
+  const SizeValueType          maximumNumberOfRounds = ( m_MaximumNumberOfTileRounds != 0 )
+                                                       ? m_MaximumNumberOfTileRounds : 2 * numberOfTiles + 2;
+  unsigned int                 numberOfNeighbors = 1;
+  for ( unsigned int i = 0; i < ImageDimension; i++ )
+    {
+    numberOfNeighbors *= 3;
+    }
+
+  m_NumberOfTileRounds = 0;
+  m_WriteTiles = false;
+  while ( m_NumberOfTileRounds < maximumNumberOfRounds )
+    {
+    m_TilesToFlood.clear();
+    for ( SizeValueType tile = 0; tile < numberOfTiles; tile++ )
+      {
+      if ( toFlood[tile] )
+        {
+        m_TilesToFlood.push_back(tile);
+        toFlood[tile] = 0;
+        }
+      }
+    if ( m_TilesToFlood.empty() )
+      {
+      break;
+      }
+
+    m_NextTile = 0;
+    multithreader->SetNumberOfThreads( std::min( this->GetNumberOfThreads(),
+                                                 static_cast< ThreadIdType >( m_TilesToFlood.size() ) ) );
+    multithreader->SingleMethodExecute();
+    ++m_NumberOfTileRounds;
+
+    for ( SizeValueType i = 0; i < m_TilesToFlood.size(); i++ )
+      {
+      const SizeValueType tile = m_TilesToFlood[i];
+      if ( m_NewTileBorders[tile] == m_TileBorders[tile] )
+        {
+        continue;
+        }
+      m_TileBorders[tile].swap( m_NewTileBorders[tile] );
+
+      // flood again all the tiles around this one
+      for ( unsigned int n = 0; n < numberOfNeighbors; n++ )
+        {
+        SizeValueType neighbor = 0;
+        bool          isInside = true;
+        unsigned int  code = n;
+        for ( unsigned int j = 0; j < ImageDimension; j++, code /= 3 )
+          {
+          const OffsetValueType c = static_cast< OffsetValueType >( ( tile / m_TileStrides[j] ) % m_NumberOfTiles[j] )
+            + static_cast< OffsetValueType >( code % 3 ) - 1;
+          if ( c < 0 || c >= static_cast< OffsetValueType >( m_NumberOfTiles[j] ) )
+            {
+            isInside = false;
+            break;
+            }
+          neighbor += c * m_TileStrides[j];
+          }
+        if ( isInside && neighbor != tile )
+          {
+          toFlood[neighbor] = 1;
+          }
+        }
+      }
+    }
+  const LabelImageRegionType & outputRegion = this->GetOutput()->GetRequestedRegion();
+  if ( std::find( toFlood.begin(), toFlood.end(), 1 ) != toFlood.end() )
+    {
+    itkWarningMacro(<< "The borders of the tiles are not stable after " << m_NumberOfTileRounds
+                    << " rounds: the image is flooded at once.");
+    m_TileBorders.clear();
+    m_NewTileBorders.clear();
+    m_TilesToFlood.clear();
+
+    // flood copies of the inputs, so that the pipeline of this filter is
+    // not updated again
+    InputImagePointer input = InputImageType::New();
+    input->Graft( inputImage );
+    LabelImagePointer markers = LabelImageType::New();
+    markers->Graft( markerImage );
+    Pointer whole = Self::New();
+    whole->SetInput( input );
+    whole->SetMarkerImage( markers );
+    whole->SetFullyConnected( m_FullyConnected );
+    whole->SetMarkWatershedLine( m_MarkWatershedLine );
+    whole->Update();
+    ImageAlgorithm::Copy( whole->GetOutput(), this->GetOutput(), outputRegion, outputRegion );
+    return;
+    }
+  itkDebugMacro(<< "Tiles flooded in " << m_NumberOfTileRounds << " rounds");
+
+  // flood the tiles of the output
+  m_TilesToFlood.clear();
+  for ( SizeValueType tile = 0; tile < numberOfTiles; tile++ )
+    {
+    LabelImageRegionType tileRegion = this->GetTileRegion(tile);
+    if ( tileRegion.Crop(outputRegion) )
+      {
+      m_TilesToFlood.push_back(tile);
+      }
+    }
+  m_WriteTiles = true;
+  m_NextTile = 0;
+  multithreader->SetNumberOfThreads( std::min( this->GetNumberOfThreads(),
+                                               static_cast< ThreadIdType >( m_TilesToFlood.size() ) ) );
+  multithreader->SingleMethodExecute();
+  m_WriteTiles = false;
+
+  m_TileBorders.clear();
+  m_NewTileBorders.clear();
+  m_TilesToFlood.clear();
+}
+
+
+template< typename TInputImage, typename TLabelImage >
+template< typename TQueue >
+ITK_THREAD_RETURN_TYPE
+MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
+::FloodTilesThreaderCallback(void *arg)
+{
+  TileThreadStruct< TQueue > *str = static_cast< TileThreadStruct< TQueue > * >(
+    static_cast< MultiThreader::ThreadInfoStruct * >( arg )->UserData );
+  Self *filter = str->Filter;
+
+  // the queue and the buffers are reused for all the tiles of the thread
+  TQueue                             fah( *str->Queue );
+  std::vector< LabelImagePixelType > labels;
+  std::vector< InputImagePixelType > values;
+  std::vector< InputImagePixelType > levels;
+  std::vector< unsigned char >       status;
+
+  const SizeValueType numberOfTiles = filter->m_TilesToFlood.size();
+  while ( true )
+    {
+    const SizeValueType i = ( filter->m_NextTile++ );
+    if ( i >= numberOfTiles )
+      {
+      break;
+      }
+    fah.Clear();
+    filter->FloodTile(filter->m_TilesToFlood[i], fah, labels, values, levels, status);
+    }
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+
+template< typename TInputImage, typename TLabelImage >
+template< typename TQueue >
+void
+MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
+::FloodTile( SizeValueType tile, TQueue & fah,
+             std::vector< LabelImagePixelType > & labels,
+             std::vector< InputImagePixelType > & values,
+             std::vector< InputImagePixelType > & levels,
+             std::vector< unsigned char > & status )
+{
+  static const LabelImagePixelType bgLabel =
+    NumericTraits< LabelImagePixelType >::ZeroValue();
+  static const LabelImagePixelType wsLabel =
+    NumericTraits< LabelImagePixelType >::ZeroValue();
+
+  // the status of the pixels in the buffers
+  static const unsigned char Free = 0;     // a pixel of the tile not yet
+                                           // in the queue
+  static const unsigned char Queued = 1;   // a pixel of the tile already
+                                           // in the queue or flooded
+  static const unsigned char Around = 2;   // a pixel of a neighbor tile,
+                                           // not yet flooded
+  static const unsigned char Flooded = 3;  // a pixel of a neighbor tile,
+                                           // flooded
+  static const unsigned char Outside = 4;  // a pixel which is never flooded
+
+  const LabelImageType * markerImage = this->GetMarkerImage();
+  const InputImageType * inputImage = this->GetInput();
+
+  // The buffers hold the tile padded by two pixels: the first layer holds
+  // the pixels of the neighbor tiles, and the second one lets their
+  // neighbors be read without checking the bounds.
+  const LabelImageRegionType tileRegion = this->GetTileRegion(tile);
+  LabelImageRegionType       aroundRegion = tileRegion;
+  aroundRegion.PadByRadius(1);
+  LabelImageRegionType paddedRegion = tileRegion;
+  paddedRegion.PadByRadius(2);
+  const IndexType & paddedIndex = paddedRegion.GetIndex();
+  const SizeType &  paddedSize = paddedRegion.GetSize();
+
+  OffsetValueType strides[ImageDimension];
+  SizeValueType   numberOfPixels = 1;
+  for ( unsigned int j = 0; j < ImageDimension; j++ )
+    {
+    strides[j] = static_cast< OffsetValueType >( numberOfPixels );
+    numberOfPixels *= paddedSize[j];
+    }
+  labels.resize(numberOfPixels);
+  values.resize(numberOfPixels);
+  levels.resize(numberOfPixels);
+  status.resize(numberOfPixels);
+
+  // the offsets of the neighbors in the buffers
+  std::vector< OffsetValueType > neighbors;
+  unsigned int                   numberOfNeighbors = 1;
+  for ( unsigned int j = 0; j < ImageDimension; j++ )
+    {
+    numberOfNeighbors *= 3;
+    }
+  for ( unsigned int n = 0; n < numberOfNeighbors; n++ )
+    {
+    OffsetValueType offset = 0;
+    unsigned int    numberOfShifts = 0;
+    unsigned int    code = n;
+    for ( unsigned int j = 0; j < ImageDimension; j++, code /= 3 )
+      {
+      const OffsetValueType shift = static_cast< OffsetValueType >( code % 3 ) - 1;
+      offset += shift * strides[j];
+      numberOfShifts += ( shift != 0 );
+      }
+    if ( numberOfShifts != 0 && ( m_FullyConnected || numberOfShifts == 1 ) )
+      {
+      neighbors.push_back(offset);
+      }
+    }
+  const typename std::vector< OffsetValueType >::const_iterator neighborsEnd = neighbors.end();
+  typename std::vector< OffsetValueType >::const_iterator       nIt;
+
+  // first stage: read the pixels of the tile, and the ones of the neighbor
+  // tiles from their borders. The pixels of the neighbor tiles are added
+  // to the fah at the level they have been flooded.
+  IndexType idx = paddedIndex;
+  for ( SizeValueType o = 0; o < numberOfPixels; o++ )
+    {
+    levels[o] = NumericTraits< InputImagePixelType >::max();
+    if ( tileRegion.IsInside(idx) )
+      {
+      values[o] = inputImage->GetPixel(idx);
+      labels[o] = markerImage->GetPixel(idx);
+      if ( labels[o] != bgLabel )
+        {
+        status[o] = Queued;
+        if ( m_MarkWatershedLine )
+          {
+          // the markers are flooded before all the other pixels
+          levels[o] = NumericTraits< InputImagePixelType >::NonpositiveMin();
+          }
+        else
+          {
+          fah.Push(o, values[o]);
+          }
+        }
+      else
+        {
+        status[o] = Free;
+        }
+      }
+    else if ( aroundRegion.IsInside(idx) && m_TiledRegion.IsInside(idx) )
+      {
+      const SizeValueType        neighborTile = this->GetTileOfIndex(idx);
+      const LabelImageRegionType neighborRegion = this->GetTileRegion(neighborTile);
+      unsigned int               face = 0;
+      for ( unsigned int j = 0; j < ImageDimension; j++ )
+        {
+        if ( idx[j] < tileRegion.GetIndex()[j] )
+          {
+          // on the upper face of the neighbor tile
+          face = 2 * j + 1;
+          break;
+          }
+        if ( idx[j] >= tileRegion.GetIndex()[j] + static_cast< OffsetValueType >( tileRegion.GetSize()[j] ) )
+          {
+          face = 2 * j;
+          break;
+          }
+        }
+      const TileBorderPixel & border =
+        m_TileBorders[neighborTile][this->GetTileBorderOffset(neighborRegion, face, idx)];
+      status[o] = Around;
+      labels[o] = border.m_Label;
+      levels[o] = border.m_Level;
+      if ( border.m_Label != wsLabel )
+        {
+        fah.Push(o, border.m_Level);
+        }
+      }
+    else
+      {
+      status[o] = Outside;
+      labels[o] = wsLabel;
+      }
+
+    for ( unsigned int j = 0; j < ImageDimension; j++ )
+      {
+      if ( ++idx[j] < paddedIndex[j] + static_cast< OffsetValueType >( paddedSize[j] ) )
+        {
+        break;
+        }
+      idx[j] = paddedIndex[j];
+      }
+    }
+
+  if ( m_MarkWatershedLine )
+    {
+    // add the background neighbors of the markers to the fah
+    for ( SizeValueType o = 0; o < numberOfPixels; o++ )
+      {
+      if ( status[o] == Queued && labels[o] != wsLabel )
+        {
+        for ( nIt = neighbors.begin(); nIt != neighborsEnd; ++nIt )
+          {
+          const SizeValueType p = o + *nIt;
+          if ( status[p] == Free )
+            {
+            fah.Push(p, values[p]);
+            status[p] = Queued;
+            }
+          }
+        }
+      }
+    }
+
+  // flooding, as in GenerateDataWithQueue()
+  while ( !fah.Empty() )
+    {
+    const InputImagePixelType level = fah.GetFrontPriority();
+    const SizeValueType       o = fah.Front();
+    fah.Pop();
+
+    if ( status[o] == Around )
+      {
+      // the pixel of the neighbor tile is flooded: it can now flood the
+      // tile
+      status[o] = Flooded;
+      for ( nIt = neighbors.begin(); nIt != neighborsEnd; ++nIt )
+        {
+        const SizeValueType p = o + *nIt;
+        if ( status[p] == Free )
+          {
+          if ( !m_MarkWatershedLine )
+            {
+            labels[p] = labels[o];
+            }
+          fah.Push(p, values[p]);
+          status[p] = Queued;
+          }
+        }
+      continue;
+      }
+
+    levels[o] = level;
+    if ( m_MarkWatershedLine )
+      {
+      // Meyer's algorithm
+      LabelImagePixelType marker = wsLabel;
+      bool                collision = false;
+      for ( nIt = neighbors.begin(); nIt != neighborsEnd; ++nIt )
+        {
+        const SizeValueType       p = o + *nIt;
+        const LabelImagePixelType l = ( status[p] == Around ) ? wsLabel : labels[p];
+        if ( l != wsLabel )
+          {
+          if ( marker != wsLabel && l != marker )
+            {
+            collision = true;
+            break;
+            }
+          marker = l;
+          }
+        }
+      if ( !collision )
+        {
+        labels[o] = marker;
+        for ( nIt = neighbors.begin(); nIt != neighborsEnd; ++nIt )
           {
-          if ( noIt.Get() == wsLabel )
+          const SizeValueType p = o + *nIt;
+          if ( status[p] == Free )
             {
-            // the pixel is not yet processed. It can be labeled with the
-            // current label
-            noIt.Set(currentMarker);
-            InputImagePixelType GrayVal = niIt.Get();
-            if ( GrayVal <= currentValue )
-              {
-              currentQueue.push( inputIt.GetIndex()
-                                 + noIt.GetNeighborhoodOffset() );
-              }
-            else
-              {
-              fah[GrayVal].push( inputIt.GetIndex()
-                                 + noIt.GetNeighborhoodOffset() );
-              }
-            progress.CompletedPixel();
+            fah.Push(p, values[p]);
+            status[p] = Queued;
             }
           }
         }
       }
+    else
+      {
+      // Beucher's algorithm
+      const LabelImagePixelType currentMarker = labels[o];
+      for ( nIt = neighbors.begin(); nIt != neighborsEnd; ++nIt )
+        {
+        const SizeValueType p = o + *nIt;
+        if ( status[p] == Free )
+          {
+          labels[p] = currentMarker;
+          fah.Push(p, values[p]);
+          status[p] = Queued;
+          }
+        }
+      }
+    }
+
+  // store the new border of the tile, face by face
+  TileBorderType & border = m_NewTileBorders[tile];
+  SizeValueType    b = 0;
+  for ( unsigned int face = 0; face < 2 * ImageDimension; face++ )
+    {
+    const unsigned int   axis = face / 2;
+    LabelImageRegionType faceRegion = tileRegion;
+    faceRegion.SetSize(axis, 1);
+    if ( face % 2 )
+      {
+      faceRegion.SetIndex( axis, tileRegion.GetIndex()[axis] + tileRegion.GetSize()[axis] - 1 );
+      }
+    const SizeValueType faceSize = faceRegion.GetNumberOfPixels();
+    idx = faceRegion.GetIndex();
+    for ( SizeValueType i = 0; i < faceSize; i++, b++ )
+      {
+      OffsetValueType o = 0;
+      for ( unsigned int j = 0; j < ImageDimension; j++ )
+        {
+        o += ( idx[j] - paddedIndex[j] ) * strides[j];
+        }
+      border[b].m_Label = labels[o];
+      border[b].m_Level = levels[o];
+
+      for ( unsigned int j = 0; j < ImageDimension; j++ )
+        {
+        if ( ++idx[j] < faceRegion.GetIndex()[j] + static_cast< OffsetValueType >( faceRegion.GetSize()[j] ) )
+          {
+          break;
+          }
+        idx[j] = faceRegion.GetIndex()[j];
+        }
+      }
+    }
+
+  if ( m_WriteTiles )
+    {
+    LabelImageType *     outputImage = this->GetOutput();
+    LabelImageRegionType outputRegion = tileRegion;
+    if ( outputRegion.Crop( outputImage->GetRequestedRegion() ) )
+      {
+      ImageRegionIteratorWithIndex< LabelImageType > oIt(outputImage, outputRegion);
+      for ( ; !oIt.IsAtEnd(); ++oIt )
+        {
+        OffsetValueType o = 0;
+        for ( unsigned int j = 0; j < ImageDimension; j++ )
+          {
+          o += ( oIt.GetIndex()[j] - paddedIndex[j] ) * strides[j];
+          }
+        oIt.Set(labels[o]);
+        }
+      }
+    }
+}
+
+
+template< typename TInputImage, typename TLabelImage >
+typename MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >::LabelImageRegionType
+MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
+::GetTileRegion( SizeValueType tile ) const
+{
+  IndexType index = m_TiledRegion.GetIndex();
+  SizeType  size;
+  for ( unsigned int j = 0; j < ImageDimension; j++ )
+    {
+    const SizeValueType regionSize = m_TiledRegion.GetSize()[j];
+    const SizeValueType tileSize = ( m_TileSize[j] != 0 ) ? m_TileSize[j] : regionSize;
+    const SizeValueType first = ( ( tile / m_TileStrides[j] ) % m_NumberOfTiles[j] ) * tileSize;
+    index[j] += static_cast< OffsetValueType >( first );
+    size[j] = std::min( tileSize, regionSize - first );
+    }
+  return LabelImageRegionType(index, size);
+}
+
+
+template< typename TInputImage, typename TLabelImage >
+SizeValueType
+MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
+::GetTileOfIndex( const IndexType & idx ) const
+{
+  SizeValueType tile = 0;
+  for ( unsigned int j = 0; j < ImageDimension; j++ )
+    {
+    const SizeValueType regionSize = m_TiledRegion.GetSize()[j];
+    const SizeValueType tileSize = ( m_TileSize[j] != 0 ) ? m_TileSize[j] : regionSize;
+    tile += ( static_cast< SizeValueType >( idx[j] - m_TiledRegion.GetIndex()[j] ) / tileSize ) * m_TileStrides[j];
+    }
+  return tile;
+}
+
+
+template< typename TInputImage, typename TLabelImage >
+SizeValueType
+MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
+::GetTileBorderOffset( const LabelImageRegionType & tileRegion, unsigned int face,
+                       const IndexType & idx ) const
+{
+  // the faces are stored one after the other, in the order of the axes,
+  // lower face first
+  const SizeType &    size = tileRegion.GetSize();
+  const SizeValueType numberOfPixels = tileRegion.GetNumberOfPixels();
+  SizeValueType       offset = 0;
+  for ( unsigned int f = 0; f < face; f++ )
+    {
+    offset += numberOfPixels / size[f / 2];
+    }
+  if ( face >= 2 * ImageDimension )
+    {
+    return offset;
+    }
+
+  const unsigned int axis = face / 2;
+  SizeValueType      stride = 1;
+  for ( unsigned int j = 0; j < ImageDimension; j++ )
+    {
+    if ( j != axis )
+      {
+      offset += static_cast< SizeValueType >( idx[j] - tileRegion.GetIndex()[j] ) * stride;
+      stride *= size[j];
+      }
     }
+  return offset;
 }
 
 
@@ -457,6 +1073,9 @@ MorphologicalWatershedFromMarkersImageFilter< TInputImage, TLabelImage >
 
   os << indent << "FullyConnected: "  << m_FullyConnected << std::endl;
   os << indent << "MarkWatershedLine: "  << m_MarkWatershedLine << std::endl;
+  os << indent << "TileSize: "  << m_TileSize << std::endl;
+  os << indent << "NumberOfTileRounds: "  << m_NumberOfTileRounds << std::endl;
+  os << indent << "MaximumNumberOfTileRounds: "  << m_MaximumNumberOfTileRounds << std::endl;
 }
 
 } // end namespace itk
@@ -70,6 +70,7 @@ public:
   typedef typename OutputImageType::ConstPointer OutputImageConstPointer;
   typedef typename OutputImageType::RegionType   OutputImageRegionType;
   typedef typename OutputImageType::PixelType    OutputImagePixelType;
+  typedef typename OutputImageType::SizeType     SizeType;
 
   /** ImageDimension constants */
   itkStaticConstMacro(InputImageDimension, unsigned int,
@@ -107,6 +108,14 @@ public:
   itkSetMacro(Level, InputImagePixelType);
   itkGetConstMacro(Level, InputImagePixelType);
 
+  /**
+   * Set/Get the size of the tiles flooded in parallel, as in
+   * MorphologicalWatershedFromMarkersImageFilter. Default is 0 along all
+   * the axes: the image is flooded at once.
+   */
+  itkSetMacro(TileSize, SizeType);
+  itkGetConstReferenceMacro(TileSize, SizeType);
+
 protected:
   MorphologicalWatershedImageFilter();
   ~MorphologicalWatershedImageFilter() {}
@@ -132,6 +141,8 @@ private:
   bool m_MarkWatershedLine;
 
   InputImagePixelType m_Level;
+
+  SizeType m_TileSize;
 }; // end of class
 } // end namespace itk
 
@@ -35,6 +35,7 @@ MorphologicalWatershedImageFilter< TInputImage, TOutputImage >
   m_MarkWatershedLine( true ),
   m_Level( NumericTraits< InputImagePixelType >::ZeroValue() )
 {
+  m_TileSize.Fill(0);
 }
 
 
@@ -109,6 +110,8 @@ MorphologicalWatershedImageFilter< TInputImage, TOutputImage >
   wshed->SetMarkerImage( label->GetOutput() );
   wshed->SetFullyConnected(m_FullyConnected);
   wshed->SetMarkWatershedLine(m_MarkWatershedLine);
+  wshed->SetTileSize(m_TileSize);
+  wshed->SetNumberOfThreads( this->GetNumberOfThreads() );
 
   if ( m_Level != NumericTraits< InputImagePixelType >::ZeroValue() )
     {
@@ -160,6 +163,7 @@ MorphologicalWatershedImageFilter< TInputImage, TOutputImage >
   os << indent << "Level: "
      << static_cast< typename NumericTraits< InputImagePixelType >::PrintType >( m_Level )
      << std::endl;
+  os << indent << "TileSize: " << m_TileSize << std::endl;
 }
 
 } // end namespace itk
@@ -20,6 +20,7 @@
 
 #include "itkWatershedSegmentTree.h"
 #include "itkWatershedSegmenter.h"
+#include "itkMultiThreader.h"
 
 namespace itk
 {
@@ -54,6 +55,12 @@ namespace watershed
  * image.  FloodLevel controls which level in the segmentation hierarchy to
  * produce on the output.
  *
+ * \par
+ * The merges of the tree are applied in order, and the ones applied for a
+ * flood level are kept for the next execution: when only the flood level
+ * increases, the tree is not read again from its beginning.  The image is
+ * relabeled by several threads.
+ *
  * \ingroup WatershedSegmentation
  * \sa itk::WatershedImageFilter
  * \sa itk::EquivalencyTable
@@ -150,6 +157,17 @@ protected:
   virtual void GenerateOutputRequestedRegion(DataObject *output) ITK_OVERRIDE;
 
   virtual void GenerateInputRequestedRegion() ITK_OVERRIDE;
+
+private:
+  static ITK_THREAD_RETURN_TYPE RelabelThreaderCallback(void *arg);
+
+  // the equivalencies of the merges already applied, and the tree they
+  // come from
+  EquivalencyTable::Pointer m_Equivalencies;
+  SizeValueType             m_NumberOfAppliedMerges;
+  ScalarType                m_MaximumAppliedSaliency;
+  TimeStamp                 m_EquivalenciesTime;
+  const SegmentTreeType *   m_EquivalenciesTree;
 };
 } // end namespace watershed
 } // end namespace itk
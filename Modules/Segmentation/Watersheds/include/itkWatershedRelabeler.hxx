@@ -19,6 +19,7 @@
 #define itkWatershedRelabeler_hxx
 
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionSplitterSlowDimension.h"
 #include "itkWatershedRelabeler.h"
 
 namespace itk
@@ -26,8 +27,12 @@ namespace itk
 namespace watershed
 {
 template< typename TScalar, unsigned int TImageDimension >
-Relabeler< TScalar, TImageDimension >::Relabeler():m_FloodLevel(0.0)
+Relabeler< TScalar, TImageDimension >::Relabeler():m_FloodLevel(0.0),
+  m_NumberOfAppliedMerges(0),
+  m_MaximumAppliedSaliency( NumericTraits< ScalarType >::NonpositiveMin() ),
+  m_EquivalenciesTree(ITK_NULLPTR)
 {
+  m_Equivalencies = EquivalencyTable::New();
   typename ImageType::Pointer img =
     static_cast< ImageType * >( this->MakeOutput(0).GetPointer() );
   this->SetNumberOfRequiredOutputs(1);
@@ -47,54 +52,106 @@ void Relabeler< TScalar, TImageDimension >
 ::GenerateData()
 {
   this->UpdateProgress(0.0);
-  typename ImageType::Pointer input  = this->GetInputImage();
   typename ImageType::Pointer output  = this->GetOutputImage();
 
   typename SegmentTreeType::Pointer tree = this->GetInputSegmentTree();
   typename SegmentTreeType::Iterator it;
-  EquivalencyTable::Pointer eqT = EquivalencyTable::New();
 
   output->SetBufferedRegion( output->GetRequestedRegion() );
   output->Allocate();
+
   //
-  // Copy input to output
+  // Extract the merges up the requested level
   //
-  ImageRegionIterator< ImageType > it_a( input, output->GetRequestedRegion() );
-  ImageRegionIterator< ImageType > it_b( output, output->GetRequestedRegion() );
-  it_a.GoToBegin();
-  it_b.GoToBegin();
-  while ( !it_a.IsAtEnd() )
+  if ( tree.GetPointer() != m_EquivalenciesTree || tree->GetMTime() > m_EquivalenciesTime.GetMTime() )
     {
-    it_b.Set( it_a.Get() );
-    ++it_a;
-    ++it_b;
+    // another tree, or a modified one
+    m_Equivalencies->Clear();
+    m_NumberOfAppliedMerges = 0;
+    m_EquivalenciesTree = tree;
     }
 
-  this->UpdateProgress(0.1);
-  //
-  // Extract the merges up the requested level
-  //
-  if ( tree->Empty() == true )
+  if ( tree->Empty() == false )
     {
-    // itkWarningMacro("Empty input.  No relabeling was done.");
-    return;
+    ScalarType max = tree->Back().saliency;
+    ScalarType mergeLimit = static_cast< ScalarType >( m_FloodLevel * max );
+
+    // The merges already applied are kept when they are all below the
+    // limit, otherwise the merges are applied again from the beginning of
+    // the tree.
+    if ( m_NumberOfAppliedMerges > 0 && mergeLimit < m_MaximumAppliedSaliency )
+      {
+      m_Equivalencies->Clear();
+      m_NumberOfAppliedMerges = 0;
+      }
+    if ( m_NumberOfAppliedMerges == 0 )
+      {
+      m_MaximumAppliedSaliency = NumericTraits< ScalarType >::NonpositiveMin();
+      }
+    for ( it = tree->Begin() + m_NumberOfAppliedMerges; it != tree->End() && ( *it ).saliency <= mergeLimit;
+          ++it, ++m_NumberOfAppliedMerges )
+      {
+      m_Equivalencies->Add( ( *it ).from, ( *it ).to );
+      m_MaximumAppliedSaliency = std::max( m_MaximumAppliedSaliency, ( *it ).saliency );
+      }
     }
-  ScalarType max = tree->Back().saliency;
-  ScalarType mergeLimit = static_cast< ScalarType >( m_FloodLevel * max );
+  m_Equivalencies->Flatten();
+  m_EquivalenciesTime.Modified();
 
   this->UpdateProgress(0.5);
 
-  it = tree->Begin();
-  while ( it != tree->End() && ( *it ).saliency <= mergeLimit )
-    {
-    eqT->Add( ( *it ).from, ( *it ).to );
-    it++;
-    }
+  //
+  // Copy the relabeled input to the output
+  //
+  MultiThreader *multithreader = this->GetMultiThreader();
+  multithreader->SetNumberOfThreads( this->GetNumberOfThreads() );
+  multithreader->SetSingleMethod(this->RelabelThreaderCallback, this);
+  multithreader->SingleMethodExecute();
 
-  SegmenterType::RelabelImage(output, output->GetRequestedRegion(), eqT);
   this->UpdateProgress(1.0);
 }
 
+template< typename TScalar, unsigned int TImageDimension >
+ITK_THREAD_RETURN_TYPE
+Relabeler< TScalar, TImageDimension >
+::RelabelThreaderCallback(void *arg)
+{
+  MultiThreader::ThreadInfoStruct *info = static_cast< MultiThreader::ThreadInfoStruct * >( arg );
+  Self *filter = static_cast< Self * >( info->UserData );
+
+  typename ImageType::Pointer input  = filter->GetInputImage();
+  typename ImageType::Pointer output  = filter->GetOutputImage();
+
+  typedef typename ImageType::RegionType RegionType;
+  RegionType region = output->GetRequestedRegion();
+  ImageRegionSplitterSlowDimension::Pointer splitter = ImageRegionSplitterSlowDimension::New();
+  const unsigned int numberOfSplits = splitter->GetNumberOfSplits(region, info->NumberOfThreads);
+  if ( info->ThreadID >= numberOfSplits )
+    {
+    return ITK_THREAD_RETURN_VALUE;
+    }
+  splitter->GetSplit(info->ThreadID, numberOfSplits, region);
+
+  // The neighbor pixels mostly have the same label: the last one is kept
+  // to avoid looking it up again.
+  const EquivalencyTable *eqT = filter->m_Equivalencies;
+  ImageRegionConstIterator< ImageType > it_a( input, region );
+  ImageRegionIterator< ImageType >      it_b( output, region );
+  IdentifierType lastLabel = it_a.Get();
+  IdentifierType lastNewLabel = eqT->Lookup(lastLabel);
+  for ( ; !it_a.IsAtEnd(); ++it_a, ++it_b )
+    {
+    const IdentifierType label = it_a.Get();
+    if ( label != lastLabel )
+      {
+      lastLabel = label;
+      lastNewLabel = eqT->Lookup(label);
+      }
+    it_b.Set(lastNewLabel);
+    }
+  return ITK_THREAD_RETURN_VALUE;
+}
+
 template< typename TScalar, unsigned int VImageDimension >
 void Relabeler< TScalar, VImageDimension >
 ::GenerateInputRequestedRegion()
@@ -21,9 +21,12 @@
 #include "itkWatershedSegmentTable.h"
 #include "itkWatershedSegmentTree.h"
 #include "itkEquivalencyTable.h"
+#include "itkMultiThreader.h"
+#include "itkAtomicInt.h"
 
 #include <algorithm>
 #include <utility>
+#include <vector>
 
 namespace itk
 {
@@ -70,6 +73,12 @@ namespace watershed
  * marked as equivalent in the EquivalencyTable.  This is only useful for
  * streaming applications and is turned off by default.  (TRUE == merge, FALSE
  * == do not merge).
+ *
+ * \par
+ * The edge lists of the segments are sorted and pruned, and the initial
+ * merges are found, by several threads.  The merges are then extracted
+ * in the order of their saliency by a single thread, so that the tree does
+ * not depend on the number of threads.
  * \sa itk::WatershedImageFilter
  * \ingroup WatershedSegmentation
  * \ingroup ITKWatersheds
@@ -209,12 +218,24 @@ protected:
 
   void MergeEquivalencies();
 
+  /** Sorts the edge lists of all the segments in parallel. */
+  void SortEdgeLists(SegmentTableTypePointer);
+
   /** Methods required by the itk pipeline */
   virtual void GenerateOutputRequestedRegion(DataObject *output) ITK_OVERRIDE;
 
   virtual void GenerateInputRequestedRegion() ITK_OVERRIDE;
 
 private:
+  typedef typename SegmentTableType::ValueType SegmentType;
+  typedef typename SegmentTreeType::merge_t    MergeType;
+
+  /** Processes the segments of m_Segments in parallel: sorts their edge
+   * lists, or prunes them and finds the first merge of each segment. */
+  void ProcessSegments(SegmentTableTypePointer, bool compileMerges);
+
+  static ITK_THREAD_RETURN_TYPE ProcessSegmentsThreaderCallback(void *arg);
+
   bool   m_Merge;
   double m_FloodLevel;
   bool   m_ConsumeInput;
@@ -224,6 +245,14 @@ private:
 
   OneWayEquivalencyTableType::Pointer m_MergedSegmentsTable;
 
+  // the segments processed in parallel, and their first merges
+  std::vector< SegmentType * > m_Segments;
+  std::vector< MergeType >     m_SegmentMerges;
+  std::vector< unsigned char > m_HasSegmentMerge;
+  bool                         m_CompileMerges;
+  ScalarType                   m_Threshold;
+  AtomicInt< SizeValueType >   m_NextSegment;
+
   /** This value keeps track of the highest level this filter has been
    *  calculated.  m_FloodLevel can be manipulated anywhere below this
    *  level without re-executing the filter, preventing unnecessary
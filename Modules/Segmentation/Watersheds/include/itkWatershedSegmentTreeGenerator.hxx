@@ -29,7 +29,8 @@ namespace watershed
 template< typename TScalar >
 SegmentTreeGenerator< TScalar >
 ::SegmentTreeGenerator():m_Merge(false), m_FloodLevel(0.0),
-  m_ConsumeInput(false), m_HighestCalculatedFloodLevel(0.0)
+  m_ConsumeInput(false), m_HighestCalculatedFloodLevel(0.0),
+  m_CompileMerges(false), m_Threshold(NumericTraits< ScalarType >::ZeroValue())
 {
   typename SegmentTreeType::Pointer st =
     static_cast< SegmentTreeType * >( this->MakeOutput(0).GetPointer() );
@@ -81,7 +82,7 @@ void SegmentTreeGenerator< TScalar >
   if ( m_ConsumeInput == true ) // do not copy input
     {
     input->Modified();
-    input->SortEdgeLists();
+    this->SortEdgeLists(input);
 
     if ( m_Merge == true )   {      this->MergeEquivalencies();    }
 
@@ -91,7 +92,7 @@ void SegmentTreeGenerator< TScalar >
   else
     {
     seg->Copy(*input); // copy the input
-    seg->SortEdgeLists();
+    this->SortEdgeLists(seg);
     if ( m_Merge == true )   {      this->MergeEquivalencies();    }
     this->CompileMergeList(seg, mergeList);
     this->ExtractMergeHierarchy(seg, mergeList);
@@ -141,53 +142,129 @@ void SegmentTreeGenerator< TScalar >
 ::CompileMergeList(SegmentTableTypePointer segments,
                    SegmentTreeTypePointer mergeList)
 {
-  typename SegmentTreeType::merge_t tempMerge;
-
   // Region A will flood Region B (B will merge with A) at a flood level L
   // when all of the following conditions are true:
   // 1) Depth of B < L
   // 2) A is across the lowest edge of B
-  typename SegmentTableType::Iterator segment_ptr;
-  IdentifierType labelFROM;
-  IdentifierType labelTO;
-  ScalarType    threshold = static_cast< ScalarType >( m_FloodLevel * segments->GetMaximumDepth() );
+  m_Threshold = static_cast< ScalarType >( m_FloodLevel * segments->GetMaximumDepth() );
   m_MergedSegmentsTable->Flatten();
 
-  segments->PruneEdgeLists(threshold);
-
-  for ( segment_ptr = segments->Begin(); segment_ptr != segments->End();
-        ++segment_ptr )
+  // The merges are found in parallel, then added to the list in the order
+  // of the table.
+  this->ProcessSegments(segments, true);
+  for ( SizeValueType i = 0; i < m_Segments.size(); ++i )
     {
-    labelFROM = ( *segment_ptr ).first;
-
-    // Must take into account any equivalencies that have already been
-    // recorded.
-    labelTO =
-      m_MergedSegmentsTable->RecursiveLookup( ( *segment_ptr ).second.edge_list.front().label );
-    while ( labelTO == labelFROM ) // Pop off any bogus merges with ourself
-      {                            // that may have been left in this list.
-      ( *segment_ptr ).second.edge_list.pop_front();
-      labelTO =
-        m_MergedSegmentsTable->RecursiveLookup( ( *segment_ptr ).second.edge_list.front().label );
-      }
-
-    // Add this merge to our list if its saliency is below
-    // the threshold.
-    tempMerge.from     = labelFROM;
-    tempMerge.to       = labelTO;
-    tempMerge.saliency = ( *segment_ptr ).second.edge_list.front().height
-                         - ( *segment_ptr ).second.min;
-    if ( tempMerge.saliency < threshold )
+    if ( m_HasSegmentMerge[i] )
       {
-      mergeList->PushBack(tempMerge);
+      mergeList->PushBack(m_SegmentMerges[i]);
       }
     }
+  m_Segments.clear();
+  m_SegmentMerges.clear();
+  m_HasSegmentMerge.clear();
 
   // Heapsort the list
   typedef typename SegmentTreeType::merge_comp MergeComparison;
   std::make_heap( mergeList->Begin(), mergeList->End(), MergeComparison() );
 }
 
+template< typename TScalar >
+void SegmentTreeGenerator< TScalar >
+::SortEdgeLists(SegmentTableTypePointer segments)
+{
+  this->ProcessSegments(segments, false);
+  m_Segments.clear();
+}
+
+template< typename TScalar >
+void SegmentTreeGenerator< TScalar >
+::ProcessSegments(SegmentTableTypePointer segments, bool compileMerges)
+{
+  m_Segments.clear();
+  m_Segments.reserve( segments->Size() );
+  for ( typename SegmentTableType::Iterator it = segments->Begin(); it != segments->End(); ++it )
+    {
+    m_Segments.push_back( &( *it ) );
+    }
+  m_CompileMerges = compileMerges;
+  if ( compileMerges )
+    {
+    m_SegmentMerges.resize( m_Segments.size() );
+    m_HasSegmentMerge.assign(m_Segments.size(), 0);
+    }
+
+  m_NextSegment = 0;
+  MultiThreader *multithreader = this->GetMultiThreader();
+  multithreader->SetNumberOfThreads( this->GetNumberOfThreads() );
+  multithreader->SetSingleMethod(this->ProcessSegmentsThreaderCallback, this);
+  multithreader->SingleMethodExecute();
+}
+
+template< typename TScalar >
+ITK_THREAD_RETURN_TYPE
+SegmentTreeGenerator< TScalar >
+::ProcessSegmentsThreaderCallback(void *arg)
+{
+  Self *filter = static_cast< Self * >(
+    static_cast< MultiThreader::ThreadInfoStruct * >( arg )->UserData );
+
+  // Each segment only changes its own edge list, and the equivalency table
+  // is only read, so the segments are processed in chunks by any thread.
+  const SizeValueType chunkSize = 256;
+  const SizeValueType numberOfSegments = filter->m_Segments.size();
+  while ( true )
+    {
+    const SizeValueType begin = ( filter->m_NextSegment++ ) * chunkSize;
+    if ( begin >= numberOfSegments )
+      {
+      break;
+      }
+    const SizeValueType end = std::min( begin + chunkSize, numberOfSegments );
+    for ( SizeValueType i = begin; i < end; ++i )
+      {
+      const IdentifierType                 labelFROM = filter->m_Segments[i]->first;
+      typename SegmentTableType::DataType & segment = filter->m_Segments[i]->second;
+      if ( !filter->m_CompileMerges )
+        {
+        segment.edge_list.sort();
+        continue;
+        }
+
+      // Remove the edges above the threshold, keeping the first one of them
+      typename SegmentTableType::edge_list_t::iterator e;
+      for ( e = segment.edge_list.begin(); e != segment.edge_list.end(); e++ )
+        {
+        if ( ( e->height - segment.min ) > filter->m_Threshold )
+          {
+          e++;
+          segment.edge_list.erase( e, segment.edge_list.end() );
+          break;
+          }
+        }
+
+      // Must take into account any equivalencies that have already been
+      // recorded.
+      IdentifierType labelTO =
+        filter->m_MergedSegmentsTable->RecursiveLookup( segment.edge_list.front().label );
+      while ( labelTO == labelFROM ) // Pop off any bogus merges with ourself
+        {                            // that may have been left in this list.
+        segment.edge_list.pop_front();
+        labelTO =
+          filter->m_MergedSegmentsTable->RecursiveLookup( segment.edge_list.front().label );
+        }
+
+      // Add this merge to our list if its saliency is below
+      // the threshold.
+      MergeType & tempMerge = filter->m_SegmentMerges[i];
+      tempMerge.from     = labelFROM;
+      tempMerge.to       = labelTO;
+      tempMerge.saliency = segment.edge_list.front().height - segment.min;
+      filter->m_HasSegmentMerge[i] = ( tempMerge.saliency < filter->m_Threshold );
+      }
+    }
+  return ITK_THREAD_RETURN_VALUE;
+}
+
 template< typename TScalar >
 void SegmentTreeGenerator< TScalar >
 ::ExtractMergeHierarchy(SegmentTableTypePointer segments,
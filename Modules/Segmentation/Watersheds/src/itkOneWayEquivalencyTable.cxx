@@ -44,10 +44,26 @@ bool OneWayEquivalencyTable::Add(unsigned long a, unsigned long b)
 void OneWayEquivalencyTable::Flatten()
 {
   Iterator it = this->Begin();
+  Iterator next;
+  Iterator hashEnd = this->End();
 
-  while ( it != this->End() )
+  while ( it != hashEnd )
     {
-    ( *it ).second = this->RecursiveLookup( ( *it ).first );
+    const unsigned long ans = this->RecursiveLookup( ( *it ).first );
+
+    // Compress the path to ans, so that the other entries of the same
+    // chain are resolved with a single lookup.  The entries of a cycle
+    // are left as they are.
+    if ( m_HashMap.find(ans) == hashEnd )
+      {
+      unsigned long a = ( *it ).second;
+      while ( a != ans && ( next = m_HashMap.find(a) ) != hashEnd )
+        {
+        a = ( *next ).second;
+        ( *next ).second = ans;
+        }
+      }
+    ( *it ).second = ans;
     it++;
     }
 }
@@ -0,0 +1,131 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMorphologicalWatershedFromMarkersImageFilter.h"
+#include "itkCastImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkTestingMacros.h"
+
+namespace
+{
+
+const unsigned int Dimension = 2;
+
+typedef unsigned char                           LabelPixelType;
+typedef itk::Image< LabelPixelType, Dimension > LabelImageType;
+
+// Flood an image converted to the pixel type TPixel
+template< typename TPixel >
+LabelImageType::Pointer
+Flood( const itk::Image< unsigned char, Dimension > * image, const LabelImageType * markers,
+       bool markWatershedLine, bool fullyConnected )
+{
+  typedef itk::Image< TPixel, Dimension >                                  ImageType;
+  typedef itk::CastImageFilter< itk::Image< unsigned char, Dimension >, ImageType > CastType;
+  typedef itk::MorphologicalWatershedFromMarkersImageFilter< ImageType, LabelImageType >
+                                                                           FilterType;
+
+  typename CastType::Pointer cast = CastType::New();
+  cast->SetInput( image );
+
+  typename FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( cast->GetOutput() );
+  filter->SetMarkerImage( markers );
+  filter->SetMarkWatershedLine( markWatershedLine );
+  filter->SetFullyConnected( fullyConnected );
+  filter->Update();
+
+  LabelImageType::Pointer output = filter->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+
+bool
+SameImages( const LabelImageType * image1, const LabelImageType * image2 )
+{
+  itk::ImageRegionConstIterator< LabelImageType > it1( image1, image1->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< LabelImageType > it2( image2, image2->GetLargestPossibleRegion() );
+  for ( ; !it1.IsAtEnd(); ++it1, ++it2 )
+    {
+    if ( it1.Get() != it2.Get() )
+      {
+      std::cerr << "The labels differ at " << it1.GetIndex() << ": "
+                << static_cast< int >( it1.Get() ) << " and " << static_cast< int >( it2.Get() ) << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+}
+
+// Flood the same image with the bucket queue of the small integer pixel
+// types and the map of queues of the other ones, and check that the pixels
+// are flooded in the same order.
+int itkMorphologicalWatershedFromMarkersImageFilterTest2( int, char * [] )
+{
+  typedef itk::Image< unsigned char, Dimension > ImageType;
+
+  ImageType::SizeType size;
+  size[0] = 71;
+  size[1] = 53;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  LabelImageType::Pointer markers = LabelImageType::New();
+  markers->SetRegions( size );
+  markers->Allocate( true );
+
+  // a few levels, so that many pixels are flooded at the same level, and
+  // some markers
+  unsigned int seed = 42;
+  itk::ImageRegionIterator< ImageType >      it( image, image->GetLargestPossibleRegion() );
+  itk::ImageRegionIterator< LabelImageType > mit( markers, markers->GetLargestPossibleRegion() );
+  for ( ; !it.IsAtEnd(); ++it, ++mit )
+    {
+    seed = seed * 1103515245u + 12345u;
+    const ImageType::IndexType & idx = it.GetIndex();
+    it.Set( static_cast< unsigned char >( ( idx[0] * idx[1] + ( ( seed >> 16 ) % 40 ) ) % 9 * 25 ) );
+    if ( ( seed >> 8 ) % 97 == 0 )
+      {
+      mit.Set( static_cast< LabelPixelType >( 1 + ( seed >> 20 ) % 7 ) );
+      }
+    }
+
+  for ( unsigned int markWatershedLine = 0; markWatershedLine < 2; ++markWatershedLine )
+    {
+    for ( unsigned int fullyConnected = 0; fullyConnected < 2; ++fullyConnected )
+      {
+      LabelImageType::Pointer byBuckets;
+      LabelImageType::Pointer byShortBuckets;
+      LabelImageType::Pointer byMap;
+      TRY_EXPECT_NO_EXCEPTION( byBuckets = Flood< unsigned char >( image, markers, markWatershedLine, fullyConnected ) );
+      TRY_EXPECT_NO_EXCEPTION( byShortBuckets = Flood< short >( image, markers, markWatershedLine, fullyConnected ) );
+      TRY_EXPECT_NO_EXCEPTION( byMap = Flood< float >( image, markers, markWatershedLine, fullyConnected ) );
+      if ( !SameImages( byBuckets, byMap ) || !SameImages( byShortBuckets, byMap ) )
+        {
+        std::cerr << "MarkWatershedLine: " << markWatershedLine
+                  << ", FullyConnected: " << fullyConnected << std::endl;
+        return EXIT_FAILURE;
+        }
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,195 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMorphologicalWatershedFromMarkersImageFilter.h"
+#include "itkConstNeighborhoodIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkTestingMacros.h"
+#include <cmath>
+
+namespace
+{
+
+const unsigned int Dimension = 2;
+
+typedef float                                    PixelType;
+typedef itk::Image< PixelType, Dimension >       ImageType;
+typedef unsigned short                           LabelPixelType;
+typedef itk::Image< LabelPixelType, Dimension >  LabelImageType;
+
+typedef itk::MorphologicalWatershedFromMarkersImageFilter< ImageType, LabelImageType > FilterType;
+
+// Label the pixels lower than all their neighbors
+LabelImageType::Pointer
+LabelMinima( const ImageType * image, bool fullyConnected )
+{
+  LabelImageType::Pointer markers = LabelImageType::New();
+  markers->SetRegions( image->GetLargestPossibleRegion() );
+  markers->Allocate( true );
+
+  itk::ConstNeighborhoodIterator< ImageType >::RadiusType radius;
+  radius.Fill( 1 );
+  itk::ConstNeighborhoodIterator< ImageType > nIt( radius, image, image->GetLargestPossibleRegion() );
+  itk::ImageRegionIterator< LabelImageType >  mIt( markers, markers->GetLargestPossibleRegion() );
+  LabelPixelType label = 0;
+  for ( ; !nIt.IsAtEnd(); ++nIt, ++mIt )
+    {
+    bool isMinimum = true;
+    for ( unsigned int i = 0; i < nIt.Size() && isMinimum; ++i )
+      {
+      const ImageType::OffsetType offset = nIt.GetOffset( i );
+      const unsigned int          numberOfShifts = ( offset[0] != 0 ) + ( offset[1] != 0 );
+      if ( numberOfShifts == 0 || ( numberOfShifts == 2 && !fullyConnected ) )
+        {
+        continue;
+        }
+      bool isInBounds;
+      const PixelType value = nIt.GetPixel( i, isInBounds );
+      isMinimum = !isInBounds || value > nIt.GetCenterPixel();
+      }
+    if ( isMinimum )
+      {
+      mIt.Set( ++label );
+      }
+    }
+  return markers;
+}
+
+LabelImageType::Pointer
+Flood( const ImageType * image, const LabelImageType * markers, bool markWatershedLine,
+       bool fullyConnected, unsigned int tileSize, unsigned int numberOfThreads )
+{
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  filter->SetMarkerImage( markers );
+  filter->SetMarkWatershedLine( markWatershedLine );
+  filter->SetFullyConnected( fullyConnected );
+  FilterType::SizeType size;
+  size.Fill( tileSize );
+  filter->SetTileSize( size );
+  filter->SetNumberOfThreads( numberOfThreads );
+  filter->Update();
+  if ( tileSize != 0 )
+    {
+    std::cout << "Tile size " << tileSize << ", " << numberOfThreads << " threads: "
+              << filter->GetNumberOfTileRounds() << " rounds" << std::endl;
+    }
+
+  LabelImageType::Pointer output = filter->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+
+bool
+SameImages( const LabelImageType * image1, const LabelImageType * image2 )
+{
+  itk::ImageRegionConstIterator< LabelImageType > it1( image1, image1->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< LabelImageType > it2( image2, image2->GetLargestPossibleRegion() );
+  for ( ; !it1.IsAtEnd(); ++it1, ++it2 )
+    {
+    if ( it1.Get() != it2.Get() )
+      {
+      std::cerr << "The labels differ at " << it1.GetIndex() << ": "
+                << it1.Get() << " and " << it2.Get() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+}
+
+// Flood an image by tiles, and check that the result is the one of the
+// whole image when the pixels have distinct values and the markers are the
+// minima of the image, and when the number of rounds is too small to
+// stabilize the borders of the tiles.
+int itkMorphologicalWatershedFromMarkersImageFilterTest3( int, char * [] )
+{
+  ImageType::SizeType size;
+  size[0] = 67;
+  size[1] = 49;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  itk::ImageRegionIterator< ImageType > it( image, image->GetLargestPossibleRegion() );
+  for ( unsigned int i = 0; !it.IsAtEnd(); ++it, ++i )
+    {
+    const ImageType::IndexType & idx = it.GetIndex();
+    it.Set( static_cast< PixelType >( std::sin( 0.31 * idx[0] ) * std::cos( 0.23 * idx[1] )
+                                      + 0.4 * std::sin( 0.11 * ( idx[0] + 2 * idx[1] ) ) + 1e-5 * i ) );
+    }
+
+  FilterType::Pointer filter = FilterType::New();
+  EXERCISE_BASIC_OBJECT_METHODS( filter, MorphologicalWatershedFromMarkersImageFilter, ImageToImageFilter );
+
+  const unsigned int tileSizes[] = { 1, 7, 16, 40 };
+  const unsigned int numberOfThreads[] = { 1, 4 };
+  for ( unsigned int fullyConnected = 0; fullyConnected < 2; ++fullyConnected )
+    {
+    LabelImageType::Pointer markers = LabelMinima( image, fullyConnected );
+    for ( unsigned int markWatershedLine = 0; markWatershedLine < 2; ++markWatershedLine )
+      {
+      LabelImageType::Pointer whole;
+      TRY_EXPECT_NO_EXCEPTION( whole = Flood( image, markers, markWatershedLine, fullyConnected, 0, 1 ) );
+      for ( unsigned int s = 0; s < 4; ++s )
+        {
+        for ( unsigned int t = 0; t < 2; ++t )
+          {
+          LabelImageType::Pointer byTiles;
+          TRY_EXPECT_NO_EXCEPTION( byTiles = Flood( image, markers, markWatershedLine, fullyConnected,
+                                                    tileSizes[s], numberOfThreads[t] ) );
+          if ( !SameImages( whole, byTiles ) )
+            {
+            std::cerr << "MarkWatershedLine: " << markWatershedLine
+                      << ", FullyConnected: " << fullyConnected << std::endl;
+            return EXIT_FAILURE;
+            }
+          }
+        }
+      }
+    }
+
+  // stop the tiles after a single round: the image is then flooded at once
+  LabelImageType::Pointer markers = LabelMinima( image, false );
+  for ( unsigned int markWatershedLine = 0; markWatershedLine < 2; ++markWatershedLine )
+    {
+    LabelImageType::Pointer whole;
+    TRY_EXPECT_NO_EXCEPTION( whole = Flood( image, markers, markWatershedLine, false, 0, 1 ) );
+
+    filter->SetInput( image );
+    filter->SetMarkerImage( markers );
+    filter->SetMarkWatershedLine( markWatershedLine );
+    filter->SetFullyConnected( false );
+    FilterType::SizeType tileSize;
+    tileSize.Fill( 7 );
+    filter->SetTileSize( tileSize );
+    filter->SetMaximumNumberOfTileRounds( 1 );
+    TEST_SET_GET_VALUE( 1, filter->GetMaximumNumberOfTileRounds() );
+    filter->SetNumberOfThreads( 4 );
+    TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+    TEST_EXPECT_EQUAL( filter->GetNumberOfTileRounds(), 1u );
+    if ( !SameImages( whole, filter->GetOutput() ) )
+      {
+      std::cerr << "Stopped tiles, MarkWatershedLine: " << markWatershedLine << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,179 @@
+/*=========================================================================
+ *
+ *  Copyright Insight Software Consortium
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkWatershedImageFilter.h"
+#include "itkWatershedRelabeler.h"
+#include "itkImageRegionIterator.h"
+#include "itkTestingMacros.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+const unsigned int Dimension = 2;
+
+typedef float                                   PixelType;
+typedef itk::Image< PixelType, Dimension >      ImageType;
+typedef itk::WatershedImageFilter< ImageType >  FilterType;
+typedef FilterType::OutputImageType             LabelImageType;
+
+bool
+SameImages( const LabelImageType * image1, const LabelImageType * image2 )
+{
+  itk::ImageRegionConstIterator< LabelImageType > it1( image1, image1->GetLargestPossibleRegion() );
+  itk::ImageRegionConstIterator< LabelImageType > it2( image2, image2->GetLargestPossibleRegion() );
+  for ( ; !it1.IsAtEnd(); ++it1, ++it2 )
+    {
+    if ( it1.Get() != it2.Get() )
+      {
+      std::cerr << "The labels differ at " << it1.GetIndex() << ": "
+                << it1.Get() << " and " << it2.Get() << std::endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+typedef itk::watershed::Relabeler< PixelType, Dimension > RelabelerType;
+typedef RelabelerType::SegmentTreeType                    SegmentTreeType;
+
+SegmentTreeType::Pointer
+MakeSegmentTree( itk::IdentifierType from, itk::IdentifierType to )
+{
+  SegmentTreeType::Pointer   tree = SegmentTreeType::New();
+  SegmentTreeType::ValueType merge;
+  merge.from = from;
+  merge.to = to;
+  merge.saliency = 1.0;
+  tree->PushBack( merge );
+  return tree;
+}
+
+// Relabel an image with two trees in turn, the second one being older than
+// the merges of the first one, and check that the merges of the current
+// tree are applied.
+bool
+TestRelabelerTrees()
+{
+  RelabelerType::ImageType::SizeType size;
+  size.Fill( 2 );
+  RelabelerType::ImageType::Pointer labels = RelabelerType::ImageType::New();
+  labels->SetRegions( size );
+  labels->Allocate();
+  itk::ImageRegionIterator< RelabelerType::ImageType > it( labels, labels->GetLargestPossibleRegion() );
+  for ( itk::IdentifierType label = 1; !it.IsAtEnd(); ++it, ++label )
+    {
+    it.Set( label );
+    }
+
+  SegmentTreeType::Pointer olderTree = MakeSegmentTree( 3, 4 );
+  SegmentTreeType::Pointer newerTree = MakeSegmentTree( 1, 2 );
+
+  RelabelerType::Pointer relabeler = RelabelerType::New();
+  relabeler->SetInputImage( labels );
+  relabeler->SetFloodLevel( 1.0 );
+
+  SegmentTreeType * trees[] = { newerTree, olderTree, newerTree };
+  for ( unsigned int t = 0; t < 3; ++t )
+    {
+    relabeler->SetInputSegmentTree( trees[t] );
+    relabeler->Update();
+
+    // the merged labels are given the lowest one
+    const itk::IdentifierType merged = std::max( trees[t]->Front().from, trees[t]->Front().to );
+    const itk::IdentifierType kept = std::min( trees[t]->Front().from, trees[t]->Front().to );
+    itk::ImageRegionConstIterator< RelabelerType::ImageType > lIt( labels, labels->GetLargestPossibleRegion() );
+    itk::ImageRegionConstIterator< RelabelerType::ImageType > oIt( relabeler->GetOutputImage(),
+                                                                   labels->GetLargestPossibleRegion() );
+    for ( ; !lIt.IsAtEnd(); ++lIt, ++oIt )
+      {
+      const itk::IdentifierType expected = ( lIt.Get() == merged ) ? kept : lIt.Get();
+      if ( oIt.Get() != expected )
+        {
+        std::cerr << "Tree " << t << ": label " << lIt.Get() << " relabeled " << oIt.Get()
+                  << " instead of " << expected << std::endl;
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+}
+
+// Change the flood level of a filter up and down, and check that its
+// output is the one of a new filter run by a single thread. Then change the
+// tree of a relabeler.
+int itkWatershedImageFilterTest2( int, char * [] )
+{
+  ImageType::SizeType size;
+  size[0] = 151;
+  size[1] = 127;
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions( size );
+  image->Allocate();
+  itk::ImageRegionIterator< ImageType > it( image, image->GetLargestPossibleRegion() );
+  for ( ; !it.IsAtEnd(); ++it )
+    {
+    const ImageType::IndexType & idx = it.GetIndex();
+    it.Set( static_cast< PixelType >( std::sin( 0.13 * idx[0] ) * std::cos( 0.17 * idx[1] )
+                                      + 0.5 * std::sin( 0.051 * ( idx[0] + idx[1] ) )
+                                      + 0.3 * std::cos( 0.26 * idx[0] + 0.29 * idx[1] ) ) );
+    }
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput( image );
+  filter->SetThreshold( 0.001 );
+  filter->SetNumberOfThreads( 4 );
+
+  // The merge tree is only computed again when the level increases above
+  // the highest one, so that the reference filter is first run at that
+  // level.
+  const double levels[] = { 0.2, 0.6, 0.1, 0.4, 0.4, 0.0, 0.9, 0.3 };
+  double       highestLevel = 0.0;
+  for ( unsigned int l = 0; l < 8; ++l )
+    {
+    filter->SetLevel( levels[l] );
+    TRY_EXPECT_NO_EXCEPTION( filter->Update() );
+    highestLevel = std::max( highestLevel, levels[l] );
+
+    FilterType::Pointer reference = FilterType::New();
+    reference->SetInput( image );
+    reference->SetThreshold( 0.001 );
+    reference->SetNumberOfThreads( 1 );
+    reference->SetLevel( highestLevel );
+    TRY_EXPECT_NO_EXCEPTION( reference->Update() );
+    reference->SetLevel( levels[l] );
+    TRY_EXPECT_NO_EXCEPTION( reference->Update() );
+
+    if ( !SameImages( reference->GetOutput(), filter->GetOutput() ) )
+      {
+      std::cerr << "Level: " << levels[l] << std::endl;
+      return EXIT_FAILURE;
+      }
+    }
+
+  if ( !TestRelabelerTrees() )
+    {
+    return EXIT_FAILURE;
+    }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}